@@ -189,6 +189,12 @@ typedef struct SColumnDataAgg {
 } SColumnDataAgg;
 #pragma pack(pop)
 
+// per-column bloom filter of a data file block, probed by the block-level filter for equal and in predicates
+typedef struct SColumnDataBloom {
+  int16_t              colId;
+  struct SBloomFilter *pBloom;
+} SColumnDataBloom;
+
 typedef struct SBlockID {
   // The uid of table, from which current data block comes. And it is always 0, if current block is the
   // result of calculation.
@@ -383,12 +389,25 @@ typedef struct SSortExecInfo {
   int32_t loops;       // loop count
   int32_t writeBytes;  // write io bytes
   int32_t readBytes;   // read io bytes
+  int64_t rawBytes;    // write bytes before page compression
+  int64_t cmprTime;    // page compress and decompress time in us
 } SSortExecInfo;
 
 typedef struct SNonSortExecInfo {
   int32_t blkNums;
 } SNonSortExecInfo;
 
+typedef struct SHashJoinExecInfo {
+  int32_t spilled;     // build side partitioned to disk or not
+  int32_t partitions;  // joined partition pairs
+  int32_t levels;      // max repartition level
+  int64_t spillRows;   // rows written to partitions
+  int64_t writeBytes;  // write io bytes
+  int64_t readBytes;   // read io bytes
+  int64_t rawBytes;    // write bytes before page compression
+  int64_t cmprTime;    // page compress and decompress time in us
+} SHashJoinExecInfo;
+
 typedef struct STUidTagInfo {
   char*    name;
   uint64_t uid;
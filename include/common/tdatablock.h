@@ -35,6 +35,9 @@ typedef struct SBlockOrderInfo {
 #define BLOCK_VERSION_1          1
 #define BLOCK_VERSION_2          2
 
+// set in the flag segment of an encoded block if its columns are compressed by blockCompressEncoded
+#define BLOCK_COMPRESSED_FLAG    (1 << 30)
+
 #define NBIT                     (3u)
 #define BitPos(_n)               ((_n) & ((1 << NBIT) - 1))
 #define CharPos(r_)              ((r_) >> NBIT)
@@ -229,6 +232,10 @@ double blockDataGetSerialRowSize(const SSDataBlock* pBlock);
 size_t blockDataGetSerialMetaSize(uint32_t numOfCols);
 
 int32_t blockDataSort(SSDataBlock* pDataBlock, SArray* pOrderInfo);
+/**
+ * @brief move the rows of block into the order of index, the i-th row of the result is the row index[i]
+ */
+int32_t blockDataReorder(SSDataBlock* pDataBlock, const int32_t* index);
 /**
  * @brief find how many rows already in order start from first row
  */
@@ -268,6 +275,12 @@ int32_t blockGetEncodeSize(const SSDataBlock* pBlock);
 int32_t blockEncode(const SSDataBlock* pBlock, char* data, int32_t numOfCols);
 const char* blockDecode(SSDataBlock* pBlock, const char* pData);
 
+int32_t blockCompressBufSize(int32_t len, int32_t numOfCols);
+int32_t blockCompressEncoded(const char* pData, char* pOut, int32_t capacity);
+bool    blockIsEncodedCompressed(const char* pData);
+int32_t blockGetDecompressedSize(const char* pData);
+int32_t blockDecompressEncoded(const char* pData, char* pOut, int32_t capacity);
+
 // for debug
 char* dumpBlockData(SSDataBlock* pDataBlock, const char* flag, char** dumpBuf, const char* taskIdStr);
 
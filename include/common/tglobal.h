@@ -72,6 +72,7 @@ extern int32_t tsNumOfRpcThreads;
 extern int32_t tsNumOfRpcSessions;
 extern int32_t tsTimeToGetAvailableConn;
 extern int32_t tsKeepAliveIdle;
+extern bool    tsTransLocalEnable;
 extern int32_t tsNumOfCommitThreads;
 extern int32_t tsNumOfTaskQueueThreads;
 extern int32_t tsNumOfMnodeQueryThreads;
@@ -81,6 +82,8 @@ extern int32_t tsNumOfVnodeQueryThreads;
 extern float   tsRatioOfVnodeStreamThreads;
 extern int32_t tsNumOfVnodeFetchThreads;
 extern int32_t tsNumOfVnodeRsmaThreads;
+extern int32_t tsNumOfVnodeInsertThreads;
+extern int32_t tsTdbCacheShards;
 extern int32_t tsNumOfQnodeQueryThreads;
 extern int32_t tsNumOfQnodeFetchThreads;
 extern int32_t tsNumOfSnodeStreamThreads;
@@ -92,6 +95,7 @@ extern int32_t tsElectInterval;
 extern int32_t tsHeartbeatInterval;
 extern int32_t tsHeartbeatTimeout;
 extern int32_t tsSnapReplMaxWaitN;
+extern int32_t tsSyncLogReplBatchNum;
 
 // arbitrator
 extern int32_t tsArbHeartBeatIntervalSec;
@@ -153,6 +157,9 @@ extern char    *tsSvrCrashReportUri;
 // query buffer management
 extern int32_t tsQueryBufferSize;  // maximum allowed usage buffer size in MB for each data node during query processing
 extern int64_t tsQueryBufferSizeBytes;    // maximum allowed usage buffer size in byte for each data node
+extern int32_t tsHashJoinBufSize;         // build side buffer size in MB of a hash join before it spills to disk
+extern int32_t tsNumOfSortThreads;        // threads sorting the runs of an external sort, 0 for the query thread
+extern bool    tsGroupByBatchAgg;         // aggregate the blocks of an unsorted group by in batch
 extern int32_t tsCacheLazyLoadThreshold;  // cost threshold for last/last_row loading cache as much as possible
 
 // query client
@@ -164,7 +171,9 @@ extern int32_t tsQueryRsmaTolerance;
 extern bool    tsQueryPlannerTrace;
 extern int32_t tsQueryNodeChunkSize;
 extern bool    tsQueryUseNodeAllocator;
+extern bool    tsQueryResultCompress;
 extern bool    tsKeepColumnName;
+extern bool    tsQueryFollowerRead;
 extern bool    tsEnableQueryHb;
 extern bool    tsEnableScience;
 extern bool    tsTtlChangeOnWrite;
@@ -215,6 +224,7 @@ extern char tsSmlChildTableName[];
 extern char tsSmlAutoChildTableNameDelimiter[];
 extern char tsSmlTagName[];
 extern bool tsSmlDot2Underline;
+extern int32_t tsSmlWriteThreads;
 extern char tsSmlTsDefaultName[];
 // extern bool    tsSmlDataFormat;
 // extern int32_t tsSmlBatchSize;
@@ -227,6 +237,14 @@ extern int64_t tsmaDataDeleteMark;
 
 // wal
 extern int64_t tsWalFsyncDataSizeLimit;
+extern bool    tsWalGroupCommit;
+extern int32_t tsWalGroupCommitLatency;
+extern int32_t tsWalGroupCommitBufSize;
+
+// tsdb
+extern bool    tsTsdbBloomFilter;
+extern int32_t tsTsdbMergeAdmitRate;
+extern int32_t tsTsdbReadAhead;
 
 // internal
 extern int32_t tsTransPullupInterval;
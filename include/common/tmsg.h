@@ -2550,6 +2550,7 @@ typedef struct {
   uint64_t        taskId;
   int32_t         execId;
   SOperatorParam* pOpParam;
+  int8_t          compressRes;  // the fetcher accepts result blocks compressed by columns
 } SResFetchReq;
 
 int32_t tSerializeSResFetchReq(void* buf, int32_t bufLen, SResFetchReq* pReq);
@@ -358,6 +358,8 @@
   TD_DEF_MSG_TYPE(TDMT_SYNC_UNUSED_CODE, "sync-unused", NULL, NULL)
   TD_DEF_MSG_TYPE(TDMT_SYNC_FORCE_FOLLOWER, "sync-force-become-follower", NULL, NULL)
   TD_DEF_MSG_TYPE(TDMT_SYNC_SET_ASSIGNED_LEADER, "sync-set-assigned-leader", NULL, NULL)
+  TD_DEF_MSG_TYPE(TDMT_SYNC_READ_INDEX, "sync-read-index", NULL, NULL)
+  TD_DEF_MSG_TYPE(TDMT_SYNC_READ_INDEX_REPLY, "sync-read-index-reply", NULL, NULL)
   TD_DEF_MSG_TYPE(TDMT_SYNC_MAX_MSG, "sync-max", NULL, NULL)
   TD_CLOSE_MSG_SEG(TDMT_END_SYNC_MSG)
 
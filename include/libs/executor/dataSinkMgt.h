@@ -70,6 +70,8 @@ typedef struct SOutputData {
   int64_t numOfRows; // int32_t changed to int64_t
   int32_t numOfCols;
   int8_t  compressed;
+  bool    compressReq;  // the fetcher accepts the blocks compressed by columns
+  int32_t dataLen;      // length of the data copied to pData
   char*   pData;
   bool    queryEnd;
   int32_t bufStatus;
@@ -130,6 +130,18 @@ bool   qIsDynamicExecTask(qTaskInfo_t tinfo);
 
 void   qUpdateOperatorParam(qTaskInfo_t tinfo, void* pParam);
 
+/**
+ * Init the resources shared by all exec tasks of the process, the sort threads for now. Called by every node that runs
+ * exec tasks, only the first call creates them.
+ * @return
+ */
+int32_t qExecutorInit();
+
+/**
+ * Release the resources created by qExecutorInit once every node that called it has, after all exec tasks are destroyed.
+ */
+void qExecutorCleanup();
+
 /**
  * Create the exec task object according to task json
  * @param readHandle
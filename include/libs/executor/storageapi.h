@@ -178,6 +178,7 @@ typedef struct TsdReader {
   int32_t      (*tsdNextDataBlock)();
 
   int32_t      (*tsdReaderRetrieveBlockSMAInfo)();
+  int32_t      (*tsdReaderRetrieveBlockBloom)();
   SSDataBlock *(*tsdReaderRetrieveDataBlock)();
 
   void         (*tsdReaderReleaseDataBlock)();
@@ -254,6 +255,7 @@ typedef struct SStoreMeta {
 
   int32_t (*getTableTags)(void* pVnode, uint64_t suid, SArray* uidList);
   int32_t (*getTableTagsByUid)(void* pVnode, int64_t suid, SArray* uidList);
+  int32_t (*getTableTagCols)(void* pVnode, uint64_t suid, SArray* uidList, SSDataBlock* pBlock, bool* acquired);
   const void* (*extractTagVal)(const void* tag, int16_t type, STagVal* tagVal);  // todo remove it
 
   int32_t (*getTableUidByName)(void* pVnode, char* tbName, uint64_t* uid);
@@ -59,6 +59,8 @@ extern int32_t filterConverNcharColumns(SFilterInfo *pFilterInfo, int32_t rows,
 extern int32_t filterFreeNcharColumns(SFilterInfo *pFilterInfo);
 extern void    filterFreeInfo(SFilterInfo *info);
 extern bool    filterRangeExecute(SFilterInfo *info, SColumnDataAgg **pColsAgg, int32_t numOfCols, int32_t numOfRows);
+extern bool    filterBloomExecute(SFilterInfo *info, SColumnDataBloom *pBlooms, int32_t numOfBlooms);
+extern bool    filterBloomApplicable(SFilterInfo *info);
 
 /* condition split interface */
 int32_t filterPartitionCond(SNode **pCondition, SNode **pPrimaryKeyCond, SNode **pTagIndexCond, SNode **pTagCond,
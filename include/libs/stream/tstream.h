@@ -320,6 +320,8 @@ typedef struct SDispatchMsgInfo {
   int32_t             transId;     // transId for current checkpoint
   int16_t             msgType;     // dispatch msg type
   int32_t             retryCount;  // retry send data count
+  int8_t              blockedRsp;  // a downstream inputQ is full in the current dispatch round
+  int32_t             blockedCount;  // dispatch rounds in a row refused by a full downstream inputQ
   int64_t             startTs;     // dispatch start time, record total elapsed time for dispatch
   SArray*             pRetryList;  // current dispatch successfully completed node of downstream
   void*               pTimer;      // used to dispatch data after a given time duration
@@ -360,7 +362,10 @@ typedef struct STaskExecStatisInfo {
   int64_t       processDataSize;
   int32_t       dispatch;
   int64_t       dispatchDataSize;
+  int64_t       dispatchEl;      // total time from sending the dispatch msg to all rsp received, in ms
   int32_t       checkpoint;
+  int64_t       checkpointEl;    // time cost of the latest checkpoint, in ms
+  int64_t       checkpointSize;  // bytes written by the latest checkpoint
   SSinkRecorder sink;
 } STaskExecStatisInfo;
 
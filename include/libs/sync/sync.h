@@ -41,6 +41,8 @@ extern "C" {
 
 #define SYNC_MAX_RETRY_BACKOFF         5
 #define SYNC_LOG_REPL_RETRY_WAIT_MS    100
+#define SYNC_LOG_REPL_BATCH_MAX_NUM    64
+#define SYNC_LOG_REPL_BATCH_MAX_BYTES  (1024 * 1024)
 #define SYNC_APPEND_ENTRIES_TIMEOUT_MS 10000
 #define SYNC_HEART_TIMEOUT_MS          1000 * 15
 
@@ -228,6 +230,8 @@ typedef struct SSyncLogStore {
   int32_t (*syncLogAppendEntry)(struct SSyncLogStore* pLogStore, SSyncRaftEntry* pEntry, bool forcSync);
   int32_t (*syncLogGetEntry)(struct SSyncLogStore* pLogStore, SyncIndex index, SSyncRaftEntry** ppEntry);
   int32_t (*syncLogTruncate)(struct SSyncLogStore* pLogStore, SyncIndex fromIndex);
+  int32_t (*syncLogFlush)(struct SSyncLogStore* pLogStore, bool forceSync);
+  SyncIndex (*syncLogFlushedIndex)(struct SSyncLogStore* pLogStore);
 
 } SSyncLogStore;
 
@@ -283,6 +287,7 @@ int32_t   syncEndSnapshot(int64_t rid);
 int32_t   syncLeaderTransfer(int64_t rid);
 int32_t   syncStepDown(int64_t rid, SyncTerm newTerm);
 bool      syncIsReadyForRead(int64_t rid);
+int32_t   syncReadIndex(int64_t rid, int32_t timeoutMs, SyncIndex* pIndex);
 bool      syncSnapshotSending(int64_t rid);
 bool      syncSnapshotRecving(int64_t rid);
 int32_t   syncSendTimeoutRsp(int64_t rid, int64_t seq);
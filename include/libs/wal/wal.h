@@ -100,6 +100,33 @@ typedef struct {
 } SWalCkHead;
 #pragma pack(pop)
 
+typedef struct {
+  int64_t groups;      // number of flushed groups
+  int64_t entries;     // number of entries flushed in groups
+  int64_t maxEntries;  // largest group ever flushed
+  int64_t bytes;       // bytes written to log files by group flushes
+  int64_t fsyncs;      // fsyncs issued by group flushes
+  int64_t flushUs;     // accumulated flush latency
+  int64_t maxFlushUs;  // max flush latency
+} SWalGroupStat;
+
+// group commit: appended entries are staged here and written to the idx and log
+// files with one write per file, followed by at most one fsync per group
+typedef struct {
+  int8_t        enable;
+  int8_t        needFsync;
+  int32_t       latencyMs;
+  int32_t       numOfEntries;
+  int32_t       idxCap;    // in entries
+  int64_t       startVer;  // first version staged, -1 if the group is empty
+  int64_t       startUs;
+  int64_t       logSize;
+  int64_t       logCap;
+  char         *pLogBuf;
+  char         *pIdxBuf;
+  SWalGroupStat stat;
+} SWalGroup;
+
 typedef struct SWal {
   // cfg
   SWalCfg cfg;
@@ -122,6 +149,8 @@ typedef struct SWal {
   SHashObj *pRefHash;  // refId -> SWalRef
   // path
   char path[WAL_PATH_LEN];
+  // group commit
+  SWalGroup group;
   // reusable write head
   SWalCkHead writeHead;
 } SWal;
@@ -153,6 +182,7 @@ struct SWalReader {
   int64_t        curVersion;
   int64_t        skipToVersion; // skip data and jump to destination version, usually used by stream resume ignoring untreated data
   int64_t        capacity;
+  int8_t         inGroup;  // at an entry staged by group commit, read from the group buffer, the files not positioned
   TdThreadMutex  mutex;
   SWalFilterCond cond;
   SWalCkHead *pHead;
@@ -181,6 +211,12 @@ int64_t walAppendLog(SWal *, int64_t index, tmsg_t msgType, SWalSyncInfo syncMet
 
 void walFsync(SWal *, bool force);
 
+// flush the staged group of entries, a no-op if group commit is disabled
+int32_t walGroupFlush(SWal *, bool forceFsync);
+void    walGetGroupStat(SWal *, SWalGroupStat *pStat);
+// last version written to the files, entries still staged by group commit excluded
+int64_t walGetFlushedVer(SWal *);
+
 // apis for lifecycle management
 int32_t walCommit(SWal *, int64_t ver);
 int32_t walRollback(SWal *, int64_t ver);
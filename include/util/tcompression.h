@@ -45,6 +45,8 @@ extern "C" {
 #define INT32MASK(_x) (((uint32_t)1 << _x) - 1)
 #define INT8MASK(_x)  (((uint8_t)1 << _x) - 1)
 
+#define SIMPLE8B_MAX_INT64 ((uint64_t)1152921504606846974LL)
+
 #define ZIGZAG_ENCODE(T, v) (((u##T)((v) >> (sizeof(T) * 8 - 1))) ^ (((u##T)(v)) << 1))  // zigzag encode
 #define ZIGZAG_DECODE(T, v) (((v) >> 1) ^ -((T)((v)&1)))                                 // zigzag decode
 
@@ -159,6 +161,11 @@ int32_t tsDecompressTimestampAvx512(const char *const input, const int32_t nelem
                                     bool bigEndian);
 int32_t tsDecompressTimestampAvx2(const char *const input, const int32_t nelements, char *const output, bool bigEndian);
 
+int32_t tsCompressIntImpl_Hw(const char *const input, const int32_t nelements, char *const output, const char type);
+int32_t tsCompressTimestampImpl_Hw(const char *const input, const int32_t nelements, char *const output);
+int32_t tsCompressDoubleImpl_Hw(const char *const input, const int32_t nelements, char *const output);
+int32_t tsCompressFloatImpl_Hw(const char *const input, const int32_t nelements, char *const output);
+
 /*************************************************************************
  *                  REGULAR COMPRESSION 2
  *************************************************************************/
@@ -32,13 +32,24 @@ typedef struct SFilePage {
   char    data[];
 } SFilePage;
 
+// compression algorithm applied to the pages flushed to disk
+typedef enum EDBufCompressAlg {
+  DBUF_COMPRESS_NONE = 0,
+  DBUF_COMPRESS_LZ4,
+  DBUF_COMPRESS_ZSTD,
+} EDBufCompressAlg;
+
 typedef struct SDiskbasedBufStatis {
-  int64_t flushBytes;
+  int64_t flushBytes;      // on disk bytes
   int64_t loadBytes;
   int32_t loadPages;
   int32_t getPages;
   int32_t releasePages;
   int32_t flushPages;
+  int32_t compPages;       // pages stored in compressed format
+  int64_t rawFlushBytes;   // flushed bytes before compression
+  int64_t compressTime;    // us
+  int64_t decompressTime;  // us
 } SDiskbasedBufStatis;
 
 /**
@@ -48,10 +59,11 @@ typedef struct SDiskbasedBufStatis {
  * @param pagesize
  * @param inMemPages
  * @param handle
+ * @param compAlg  compress algorithm of the pages flushed to disk
  * @return
  */
 int32_t createDiskbasedBuf(SDiskbasedBuf** pBuf, int32_t pagesize, int32_t inMemBufSize, const char* id,
-                           const char* dir);
+                           const char* dir, EDBufCompressAlg compAlg);
 
 /**
  *
@@ -146,7 +158,8 @@ bool isAllDataInMemBuf(const SDiskbasedBuf* pBuf);
 void setBufPageDirty(void* pPage, bool dirty);
 
 /**
- * Set the compress/ no-compress flag for paged buffer, when flushing data in disk.
+ * Set the compress/ no-compress flag for paged buffer, when flushing data in disk. LZ4 is used if no compress
+ * algorithm is assigned when the buffer is created.
  * @param pBuf
  */
 void setBufPageCompressOnDisk(SDiskbasedBuf* pBuf, bool comp);
@@ -199,6 +199,10 @@ typedef struct SReqResultInfo {
   bool           convertUcs4;
   int32_t        payloadLen;
   char*          convertJson;
+  char*          decompBuf;  // the result block decompressed from the rsp
+  int32_t        decompBufSize;
+  uint64_t       wireBytes;  // bytes of the result received from the server
+  uint64_t       rawBytes;   // bytes of the result after decompressed
 } SReqResultInfo;
 
 typedef struct SRequestSendRecvBody {
@@ -362,6 +366,7 @@ int taos_options_imp(TSDB_OPTION option, const char* str);
 
 void* openTransporter(const char* user, const char* auth, int32_t numOfThreads);
 void tscStopCrashReport();
+void smlStopWorkerPool();
 
 typedef struct AsyncArg {
   SRpcMsg msg;
@@ -222,7 +222,7 @@ int64_t       smlGetTimeValue(const char *value, int32_t len, uint8_t fromPrecis
 SSmlTableInfo*    smlBuildTableInfo(int numRows, const char* measure, int32_t measureLen);
 SSmlSTableMeta*   smlBuildSTableMeta(bool isDataFormat);
 int32_t           smlSetCTableName(SSmlTableInfo *oneTable);
-void              getTableUid(SSmlHandle *info, SSmlLineInfo *currElement, SSmlTableInfo *tinfo);
+void              getTableUid(SSmlHandle *info, const char *measure, int32_t measureLen, SSmlTableInfo *tinfo);
 STableMeta*       smlGetMeta(SSmlHandle *info, const void* measure, int32_t measureLen);
 int32_t           is_same_child_table_telnet(const void *a, const void *b);
 int64_t           smlParseOpenTsdbTime(SSmlHandle *info, const char *data, int32_t len);
@@ -235,6 +235,8 @@ void    freeSSmlKv(void* data);
 int32_t smlParseInfluxString(SSmlHandle *info, char *sql, char *sqlEnd, SSmlLineInfo *elements);
 int32_t smlParseTelnetString(SSmlHandle *info, char *sql, char *sqlEnd, SSmlLineInfo *elements);
 int32_t smlParseJSON(SSmlHandle *info, char *payload);
+int32_t smlParseLineParallel(SSmlHandle *info, char *lines[], char *rawLine, char *rawLineEnd, int numLines,
+                             int32_t numOfTasks);
 
 SSmlSTableMeta* smlBuildSuperTableInfo(SSmlHandle *info, SSmlLineInfo *currElement);
 bool            isSmlTagAligned(SSmlHandle *info, int cnt, SSmlKv *kv);
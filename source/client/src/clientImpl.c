@@ -2187,6 +2187,28 @@ void resetConnectDB(STscObj* pTscObj) {
   taosThreadMutexUnlock(&pTscObj->mutex);
 }
 
+// the server compresses the result block by columns if the client asks for it, see blockCompressEncoded
+static int32_t doDecompressResult(SReqResultInfo* pResultInfo) {
+  int32_t len = blockGetDecompressedSize(pResultInfo->pData);
+  if (pResultInfo->decompBufSize < len) {
+    char* p = taosMemoryRealloc(pResultInfo->decompBuf, len);
+    if (p == NULL) {
+      return TSDB_CODE_OUT_OF_MEMORY;
+    }
+    pResultInfo->decompBuf = p;
+    pResultInfo->decompBufSize = len;
+  }
+
+  if (blockDecompressEncoded(pResultInfo->pData, pResultInfo->decompBuf, pResultInfo->decompBufSize) < 0) {
+    tscError("failed to decompress result block, len:%d", pResultInfo->payloadLen);
+    return TSDB_CODE_TSC_INTERNAL_ERROR;
+  }
+
+  pResultInfo->pData = pResultInfo->decompBuf;
+  pResultInfo->rawBytes += len;
+  return TSDB_CODE_SUCCESS;
+}
+
 int32_t setQueryResultFromRsp(SReqResultInfo* pResultInfo, const SRetrieveTableRsp* pRsp, bool convertUcs4) {
   if (pResultInfo == NULL || pRsp == NULL) {
     tscError("setQueryResultFromRsp paras is null");
@@ -2201,8 +2223,17 @@ int32_t setQueryResultFromRsp(SReqResultInfo* pResultInfo, const SRetrieveTableR
   pResultInfo->completed = (pRsp->completed == 1);
   pResultInfo->payloadLen = htonl(pRsp->compLen);
   pResultInfo->precision = pRsp->precision;
+  pResultInfo->wireBytes += pResultInfo->payloadLen;
+
+  if (pRsp->compressed && pResultInfo->payloadLen > 0 && blockIsEncodedCompressed(pResultInfo->pData)) {
+    int32_t code = doDecompressResult(pResultInfo);
+    if (code != TSDB_CODE_SUCCESS) {
+      return code;
+    }
+  } else {
+    pResultInfo->rawBytes += pResultInfo->payloadLen;
+  }
 
-  // TODO handle the compressed case
   pResultInfo->totalRows += pResultInfo->numOfRows;
   return setResultDataPtr(pResultInfo, pResultInfo->fields, pResultInfo->numOfCols, pResultInfo->numOfRows,
                           convertUcs4);
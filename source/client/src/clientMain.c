@@ -56,6 +56,7 @@ void taos_cleanup(void) {
   }
 
   tscStopCrashReport();
+  smlStopWorkerPool();
 
   hbMgrCleanUp();
 
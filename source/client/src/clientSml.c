@@ -19,6 +19,7 @@
 #include <string.h>
 
 #include "clientSml.h"
+#include "tworker.h"
 
 #define RETURN_FALSE                                 \
   smlBuildInvalidDataMsg(msg, "invalid data", pVal); \
@@ -38,7 +39,7 @@
 
 #define SET_BIGINT                                                                                       \
   errno = 0;                                                                                             \
-  int64_t tmp = taosStr2Int64(pVal, &endptr, 10);                                                        \
+  int64_t tmp = isInteger ? integer : taosStr2Int64(pVal, &endptr, 10);                                  \
   if (errno == ERANGE) {                                                                                 \
     smlBuildInvalidDataMsg(msg, "big int out of range[-9223372036854775808,9223372036854775807]", pVal); \
     return false;                                                                                        \
@@ -64,7 +65,7 @@
 
 #define SET_UBIGINT                                                                             \
   errno = 0;                                                                                    \
-  uint64_t tmp = taosStr2UInt64(pVal, &endptr, 10);                                             \
+  uint64_t tmp = isInteger ? (uint64_t)integer : taosStr2UInt64(pVal, &endptr, 10);            \
   if (errno == ERANGE || result < 0) {                                                          \
     smlBuildInvalidDataMsg(msg, "unsigned big int out of range[0,18446744073709551615]", pVal); \
     return false;                                                                               \
@@ -367,7 +368,7 @@ int32_t smlProcessChildTable(SSmlHandle *info, SSmlLineInfo *elements) {
     }
 
     smlSetCTableName(tinfo);
-    getTableUid(info, elements, tinfo);
+    getTableUid(info, elements->measure, elements->measureLen, tinfo);
     if (info->dataFormat) {
       info->currSTableMeta->uid = tinfo->uid;
       tinfo->tableDataCtx = smlInitTableDataCtx(info->pQuery, info->currSTableMeta);
@@ -504,20 +505,19 @@ int32_t smlSetCTableName(SSmlTableInfo *oneTable) {
   return TSDB_CODE_SUCCESS;
 }
 
-void getTableUid(SSmlHandle *info, SSmlLineInfo *currElement, SSmlTableInfo *tinfo) {
+void getTableUid(SSmlHandle *info, const char *measure, int32_t measureLen, SSmlTableInfo *tinfo) {
   char   key[TSDB_TABLE_NAME_LEN * 2 + 1] = {0};
   size_t nLen = strlen(tinfo->childTableName);
-  memcpy(key, currElement->measure, currElement->measureLen);
+  memcpy(key, measure, measureLen);
   if (tsSmlDot2Underline) {
-    smlStrReplace(key, currElement->measureLen);
+    smlStrReplace(key, measureLen);
   }
-  memcpy(key + currElement->measureLen + 1, tinfo->childTableName, nLen);
-  void *uid =
-      taosHashGet(info->tableUids, key,
-                  currElement->measureLen + 1 + nLen);  // use \0 as separator for stable name and child table name
+  memcpy(key + measureLen + 1, tinfo->childTableName, nLen);
+  void *uid = taosHashGet(info->tableUids, key,
+                          measureLen + 1 + nLen);  // use \0 as separator for stable name and child table name
   if (uid == NULL) {
     tinfo->uid = info->uid++;
-    taosHashPut(info->tableUids, key, currElement->measureLen + 1 + nLen, &tinfo->uid, sizeof(uint64_t));
+    taosHashPut(info->tableUids, key, measureLen + 1 + nLen, &tinfo->uid, sizeof(uint64_t));
   } else {
     tinfo->uid = *(uint64_t *)uid;
   }
@@ -571,11 +571,74 @@ cleanup:
   return NULL;
 }
 
+#define SML_FAST_MAX_DIGITS   18
+#define SML_FAST_MAX_MANTISSA (1LL << 53)
+
+static const double smlPow10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                  1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+// Parse the plain decimals like 123, -45.67 without strtod. The mantissa and the power of ten are both exact in a
+// double, so the quotient is rounded the same as strtod does. Return false for the others(exponent, hex, inf/nan,
+// too many digits) and let the caller fall back to taosStr2Double.
+static FORCE_INLINE bool smlFastStr2Double(const char *pVal, int32_t len, double *result, char **endptr,
+                                           bool *isInteger, int64_t *integer) {
+  const char *p = pVal;
+  const char *end = pVal + len;
+  bool        neg = false;
+  if (p < end && *p == '-') {
+    neg = true;
+    p++;
+  }
+
+  int64_t mantissa = 0;
+  int32_t digits = 0;
+  int32_t fracDigits = 0;
+  while (p < end && *p >= '0' && *p <= '9') {
+    mantissa = mantissa * 10 + (*p++ - '0');
+    digits++;
+  }
+  bool hasDot = (p < end && *p == '.');
+  if (hasDot) {
+    p++;
+    while (p < end && *p >= '0' && *p <= '9') {
+      mantissa = mantissa * 10 + (*p++ - '0');
+      digits++;
+      fracDigits++;
+    }
+  }
+
+  if (digits == 0 || digits > SML_FAST_MAX_DIGITS) {
+    return false;
+  }
+  if (p < end && (*p == 'e' || *p == 'E' || *p == 'x' || *p == 'X')) {
+    return false;
+  }
+  if (fracDigits > 0 && mantissa > SML_FAST_MAX_MANTISSA) {
+    return false;
+  }
+
+  double d = (double)mantissa;
+  if (fracDigits > 0) {
+    d /= smlPow10[fracDigits];
+  }
+  *result = neg ? -d : d;
+  *endptr = (char *)p;
+  *isInteger = !hasDot;
+  *integer = neg ? -mantissa : mantissa;
+  return true;
+}
+
 bool smlParseNumber(SSmlKv *kvVal, SSmlMsgBuf *msg) {
   const char *pVal = kvVal->value;
   int32_t     len = kvVal->length;
   char       *endptr = NULL;
-  double      result = taosStr2Double(pVal, &endptr);
+  double      result = 0;
+  bool        isInteger = false;
+  int64_t     integer = 0;
+  if (!smlFastStr2Double(pVal, len, &result, &endptr, &isInteger, &integer)) {
+    isInteger = false;
+    result = taosStr2Double(pVal, &endptr);
+  }
   if (pVal == endptr) {
     RETURN_FALSE
   }
@@ -1566,6 +1629,212 @@ static int32_t smlParseLineBottom(SSmlHandle *info) {
   return TSDB_CODE_SUCCESS;
 }
 
+#define SML_PARALLEL_MIN_LINES 2000  // a batch is split into tasks of at least these lines
+
+typedef struct {
+  void (*fp)(void *param);
+  void  *param;
+  bool   dispatched;
+  tsem_t done;
+} SSmlWorkerTask;
+
+typedef struct {
+  SSmlHandle *info;  // private handle of the task, the child tables found are merged into the batch handle
+  char      **lines;
+  int32_t    *lens;
+  int32_t     start;
+  int32_t     num;
+  int32_t     code;
+  char        msg[ERROR_MSG_BUF_DEFAULT_SIZE];
+} SSmlParseTask;
+
+typedef struct {
+  SSmlTableInfo  *tableData;
+  SSmlSTableMeta *sTableMeta;
+  int32_t         vgId;
+  char           *measure;
+  int32_t         measureLen;
+} SSmlBindItem;
+
+typedef struct {
+  SSmlHandle *info;
+  SArray     *items;   // SSmlBindItem
+  SQuery     *pQuery;  // private query of the task, the table data are moved into the query of the batch
+  int32_t     code;
+  char        msg[ERROR_MSG_BUF_DEFAULT_SIZE];
+} SSmlBindTask;
+
+static SQWorkerPool smlWorkerPool = {0};
+static STaosQueue  *smlWorkerQueue = NULL;
+static TdThreadOnce smlWorkerPoolInit = PTHREAD_ONCE_INIT;
+
+static void smlProcessWorkerTask(SQueueInfo *pInfo, void *pItem) {
+  SSmlWorkerTask *pTask = *(SSmlWorkerTask **)pItem;
+  taosFreeQitem(pItem);
+  pTask->fp(pTask->param);
+  tsem_post(&pTask->done);
+}
+
+static void smlInitWorkerPool() {
+  smlWorkerPool.name = "sml-write";
+  smlWorkerPool.min = tsSmlWriteThreads;
+  smlWorkerPool.max = tsSmlWriteThreads;
+  if (tQWorkerInit(&smlWorkerPool) != 0) {
+    uError("SML:failed to init worker pool since %s", terrstr());
+    return;
+  }
+
+  smlWorkerQueue = tQWorkerAllocQueue(&smlWorkerPool, NULL, smlProcessWorkerTask);
+  if (smlWorkerQueue == NULL) {
+    uError("SML:failed to alloc worker queue since %s", terrstr());
+    tQWorkerCleanup(&smlWorkerPool);
+  }
+}
+
+void smlStopWorkerPool() {
+  if (smlWorkerQueue == NULL) {
+    return;
+  }
+  tQWorkerFreeQueue(&smlWorkerPool, smlWorkerQueue);
+  tQWorkerCleanup(&smlWorkerPool);
+  smlWorkerQueue = NULL;
+}
+
+// number of tasks a batch of numLines lines is split into, 1 means the calling thread does all the work
+static int32_t smlGetNumOfTasks(SSmlHandle *info, int32_t numLines) {
+  if (tsSmlWriteThreads <= 0 || info->protocol == TSDB_SML_JSON_PROTOCOL) {
+    return 1;
+  }
+  return TMAX(TMIN(tsSmlWriteThreads + 1, numLines / SML_PARALLEL_MIN_LINES), 1);
+}
+
+// run the first task on the calling thread and the others on the worker pool, return after all of them are done
+static void smlRunTasks(SSmlWorkerTask *pTasks, int32_t numOfTasks) {
+  taosThreadOnce(&smlWorkerPoolInit, smlInitWorkerPool);
+
+  for (int32_t i = 1; i < numOfTasks; ++i) {
+    SSmlWorkerTask *pTask = pTasks + i;
+    pTask->dispatched = false;
+    if (smlWorkerQueue == NULL) {
+      continue;
+    }
+
+    SSmlWorkerTask **pItem = taosAllocateQitem(sizeof(SSmlWorkerTask *), DEF_QITEM, 0);
+    if (pItem == NULL) {
+      continue;
+    }
+    *pItem = pTask;
+    tsem_init(&pTask->done, 0, 0);
+    if (taosWriteQitem(smlWorkerQueue, pItem) != 0) {
+      tsem_destroy(&pTask->done);
+      taosFreeQitem(pItem);
+      continue;
+    }
+    pTask->dispatched = true;
+  }
+
+  pTasks[0].fp(pTasks[0].param);
+  for (int32_t i = 1; i < numOfTasks; ++i) {
+    SSmlWorkerTask *pTask = pTasks + i;
+    if (pTask->dispatched) {
+      tsem_wait(&pTask->done);
+      tsem_destroy(&pTask->done);
+    } else {
+      pTask->fp(pTask->param);
+    }
+  }
+}
+
+static void smlDestroyBindItem(void *p) { taosMemoryFree(((SSmlBindItem *)p)->measure); }
+
+static void smlBindTaskFp(void *param) {
+  SSmlBindTask *pTask = param;
+  SSmlHandle   *info = pTask->info;
+  for (int32_t i = 0; i < taosArrayGetSize(pTask->items); ++i) {
+    SSmlBindItem *pItem = taosArrayGet(pTask->items, i);
+
+    // the meta of the super table carries the vgroup and uid of the child table, each task binds with its own copy
+    STableMeta *pTableMeta = NULL;
+    pTask->code = cloneTableMeta(pItem->sTableMeta->tableMeta, &pTableMeta);
+    if (pTask->code != TSDB_CODE_SUCCESS) {
+      return;
+    }
+    pTableMeta->vgId = pItem->vgId;
+    pTableMeta->uid = pItem->tableData->uid;
+
+    pTask->code = smlBindData(pTask->pQuery, false, pItem->tableData->tags, pItem->sTableMeta->cols,
+                              pItem->tableData->cols, pTableMeta, pItem->tableData->childTableName, pItem->measure,
+                              pItem->measureLen, info->ttl, pTask->msg, sizeof(pTask->msg));
+    taosMemoryFree(pTableMeta);
+    if (pTask->code != TSDB_CODE_SUCCESS) {
+      uError("SML:0x%" PRIx64 " smlBindData failed, table:%s", info->id, pItem->tableData->childTableName);
+      return;
+    }
+  }
+}
+
+// bind the child tables on the worker pool, the tables of the same uid are bound by the same task since they share
+// one table data
+static int32_t smlBindDataParallel(SSmlHandle *info, SArray *pItems) {
+  int32_t numOfTasks = TMIN(smlGetNumOfTasks(info, info->lineNum), taosArrayGetSize(pItems));
+  numOfTasks = TMAX(numOfTasks, 1);
+
+  SSmlBindTask   *pBinds = taosMemoryCalloc(numOfTasks, sizeof(SSmlBindTask));
+  SSmlWorkerTask *pTasks = taosMemoryCalloc(numOfTasks, sizeof(SSmlWorkerTask));
+  int32_t         code = TSDB_CODE_SUCCESS;
+  if (pBinds == NULL || pTasks == NULL) {
+    code = TSDB_CODE_OUT_OF_MEMORY;
+    goto _end;
+  }
+
+  for (int32_t i = 0; i < numOfTasks; ++i) {
+    pBinds[i].info = info;
+    pBinds[i].items = taosArrayInit(taosArrayGetSize(pItems) / numOfTasks + 1, sizeof(SSmlBindItem));
+    pBinds[i].pQuery = smlInitHandle();
+    if (pBinds[i].items == NULL || pBinds[i].pQuery == NULL) {
+      code = TSDB_CODE_OUT_OF_MEMORY;
+      goto _end;
+    }
+    pTasks[i].fp = smlBindTaskFp;
+    pTasks[i].param = pBinds + i;
+  }
+
+  for (int32_t i = 0; i < taosArrayGetSize(pItems); ++i) {
+    SSmlBindItem *pItem = taosArrayGet(pItems, i);
+    taosArrayPush(pBinds[pItem->tableData->uid % numOfTasks].items, pItem);
+  }
+
+  smlRunTasks(pTasks, numOfTasks);
+
+  SHashObj *pDst = ((SVnodeModifyOpStmt *)(info->pQuery->pRoot))->pTableBlockHashObj;
+  for (int32_t i = 0; i < numOfTasks; ++i) {
+    if (code == TSDB_CODE_SUCCESS && pBinds[i].code != TSDB_CODE_SUCCESS) {
+      code = pBinds[i].code;
+      tstrncpy(info->msgBuf.buf, pBinds[i].msg, info->msgBuf.len);
+    }
+
+    // the table data are owned by the query of the batch from now on
+    SHashObj       *pSrc = ((SVnodeModifyOpStmt *)(pBinds[i].pQuery->pRoot))->pTableBlockHashObj;
+    STableDataCxt **ppCxt = taosHashIterate(pSrc, NULL);
+    while (ppCxt) {
+      size_t keyLen = 0;
+      void  *key = taosHashGetKey(ppCxt, &keyLen);
+      taosHashPut(pDst, key, keyLen, ppCxt, POINTER_BYTES);
+      ppCxt = taosHashIterate(pSrc, ppCxt);
+    }
+    taosHashClear(pSrc);
+  }
+
+_end:
+  for (int32_t i = 0; pBinds != NULL && i < numOfTasks; ++i) {
+    taosArrayDestroy(pBinds[i].items);
+    qDestroyQuery(pBinds[i].pQuery);
+  }
+  taosMemoryFree(pBinds);
+  taosMemoryFree(pTasks);
+  return code;
+}
+
 static int32_t smlInsertData(SSmlHandle *info) {
   int32_t code = TSDB_CODE_SUCCESS;
   uDebug("SML:0x%" PRIx64 " smlInsertData start, format:%d", info->id, info->dataFormat);
@@ -1578,6 +1847,11 @@ static int32_t smlInsertData(SSmlHandle *info) {
   tstrncpy(pName.dbname, info->pRequest->pDb, sizeof(pName.dbname));
   tNameGetFullDbName(&pName, data);
 
+  SArray *pItems = NULL;
+  if (!info->dataFormat && smlGetNumOfTasks(info, info->lineNum) > 1) {
+    pItems = taosArrayInit(taosHashGetSize(info->childTables), sizeof(SSmlBindItem));
+  }
+
   SSmlTableInfo **oneTable = (SSmlTableInfo **)taosHashIterate(info->childTables, NULL);
   while (oneTable) {
     SSmlTableInfo *tableData = *oneTable;
@@ -1607,6 +1881,7 @@ static int32_t smlInsertData(SSmlHandle *info) {
     if (code != TSDB_CODE_SUCCESS) {
       taosMemoryFree(measure);
       taosHashCancelIterate(info->childTables, oneTable);
+      taosArrayDestroyEx(pItems, smlDestroyBindItem);
       return code;
     }
 
@@ -1616,6 +1891,7 @@ static int32_t smlInsertData(SSmlHandle *info) {
       uError("SML:0x%" PRIx64 " catalogGetTableHashVgroup failed. table name: %s", info->id, tableData->childTableName);
       taosMemoryFree(measure);
       taosHashCancelIterate(info->childTables, oneTable);
+      taosArrayDestroyEx(pItems, smlDestroyBindItem);
       return code;
     }
     taosHashPut(info->pVgHash, (const char *)&vg.vgId, sizeof(vg.vgId), (char *)&vg, sizeof(vg));
@@ -1626,6 +1902,7 @@ static int32_t smlInsertData(SSmlHandle *info) {
       uError("SML:0x%" PRIx64 " NULL == pMeta. table name: %s", info->id, tableData->childTableName);
       taosMemoryFree(measure);
       taosHashCancelIterate(info->childTables, oneTable);
+      taosArrayDestroyEx(pItems, smlDestroyBindItem);
       return TSDB_CODE_SML_INTERNAL_ERROR;
     }
 
@@ -1635,6 +1912,17 @@ static int32_t smlInsertData(SSmlHandle *info) {
     uDebug("SML:0x%" PRIx64 " smlInsertData table:%s, uid:%" PRIu64 ", format:%d", info->id, pName.tname,
            tableData->uid, info->dataFormat);
 
+    if (pItems != NULL) {
+      SSmlBindItem item = {.tableData = tableData,
+                           .sTableMeta = *pMeta,
+                           .vgId = vg.vgId,
+                           .measure = measure,
+                           .measureLen = measureLen};
+      taosArrayPush(pItems, &item);
+      oneTable = (SSmlTableInfo **)taosHashIterate(info->childTables, oneTable);
+      continue;
+    }
+
     code = smlBindData(info->pQuery, info->dataFormat, tableData->tags, (*pMeta)->cols, tableData->cols,
                        (*pMeta)->tableMeta, tableData->childTableName, measure, measureLen, info->ttl, info->msgBuf.buf,
                        info->msgBuf.len);
@@ -1647,6 +1935,15 @@ static int32_t smlInsertData(SSmlHandle *info) {
     oneTable = (SSmlTableInfo **)taosHashIterate(info->childTables, oneTable);
   }
 
+  if (pItems != NULL) {
+    code = smlBindDataParallel(info, pItems);
+    taosArrayDestroyEx(pItems, smlDestroyBindItem);
+    if (code != TSDB_CODE_SUCCESS) {
+      uError("SML:0x%" PRIx64 " smlBindDataParallel failed", info->id);
+      return code;
+    }
+  }
+
   code = smlBuildOutput(info->pQuery, info->pVgHash);
   if (code != TSDB_CODE_SUCCESS) {
     uError("SML:0x%" PRIx64 " smlBuildOutput failed", info->id);
@@ -1802,13 +2099,145 @@ static int32_t smlParseLine(SSmlHandle *info, char *lines[], char *rawLine, char
   return code;
 }
 
+static void smlParseTaskFp(void *param) {
+  SSmlParseTask *pTask = param;
+  SSmlHandle    *info = pTask->info;
+  for (int32_t i = 0; i < pTask->num; ++i) {
+    char   *tmp = pTask->lines[i];
+    int32_t len = pTask->lens[i];
+    if (info->protocol == TSDB_SML_LINE_PROTOCOL) {
+      pTask->code = smlParseInfluxString(info, tmp, tmp + len, info->lines + i);
+    } else {
+      pTask->code = smlParseTelnetString(info, tmp, tmp + len, info->lines + i);
+    }
+    if (pTask->code != TSDB_CODE_SUCCESS) {
+      uError("SML:0x%" PRIx64 " smlParseLine failed. line %d : %.*s", info->id, pTask->start + i, len, tmp);
+      return;
+    }
+  }
+}
+
+// move the child tables found by a task into the batch handle, the uid is assigned again by the batch handle since
+// the tasks number the tables independently
+static int32_t smlMergeChildTables(SSmlHandle *info, SSmlHandle *pTaskInfo) {
+  int32_t code = TSDB_CODE_SUCCESS;
+  taosHashSetFreeFp(pTaskInfo->childTables, NULL);
+
+  SSmlTableInfo **oneTable = (SSmlTableInfo **)taosHashIterate(pTaskInfo->childTables, NULL);
+  while (oneTable) {
+    SSmlTableInfo *tinfo = *oneTable;
+    size_t         keyLen = 0;
+    void          *key = taosHashGetKey(oneTable, &keyLen);
+    if (code != TSDB_CODE_SUCCESS || taosHashGet(info->childTables, key, keyLen) != NULL) {
+      smlDestroyTableInfo(&tinfo);
+    } else {
+      getTableUid(info, tinfo->sTableName, tinfo->sTableNameLen, tinfo);
+      code = taosHashPut(info->childTables, key, keyLen, &tinfo, POINTER_BYTES);
+      if (code != TSDB_CODE_SUCCESS) {
+        smlDestroyTableInfo(&tinfo);
+      }
+    }
+    oneTable = (SSmlTableInfo **)taosHashIterate(pTaskInfo->childTables, oneTable);
+  }
+  taosHashClear(pTaskInfo->childTables);
+  return code;
+}
+
+// split the lines of a batch into tasks parsed on the worker pool, each task parses into its slice of info->lines
+// with a private handle. The child tables are merged afterwards so that the schema is checked and changed once.
+int32_t smlParseLineParallel(SSmlHandle *info, char *lines[], char *rawLine, char *rawLineEnd, int numLines,
+                             int32_t numOfTasks) {
+  uDebug("SML:0x%" PRIx64 " smlParseLineParallel start, tasks:%d", info->id, numOfTasks);
+  int32_t code = TSDB_CODE_SUCCESS;
+
+  info->dataFormat = false;
+  info->lines = (SSmlLineInfo *)taosMemoryCalloc(numLines, sizeof(SSmlLineInfo));
+  char          **pLines = taosMemoryCalloc(numLines, POINTER_BYTES);
+  int32_t        *pLens = taosMemoryCalloc(numLines, sizeof(int32_t));
+  SSmlParseTask  *pParses = taosMemoryCalloc(numOfTasks, sizeof(SSmlParseTask));
+  SSmlWorkerTask *pTasks = taosMemoryCalloc(numOfTasks, sizeof(SSmlWorkerTask));
+  if (info->lines == NULL || pLines == NULL || pLens == NULL || pParses == NULL || pTasks == NULL) {
+    code = TSDB_CODE_OUT_OF_MEMORY;
+    goto _end;
+  }
+
+  int32_t i = 0;
+  while (i < numLines) {
+    char *tmp = NULL;
+    int   len = 0;
+    if (!getLine(info, lines, &rawLine, rawLineEnd, numLines, i, &tmp, &len)) {
+      continue;
+    }
+    pLines[i] = tmp;
+    pLens[i] = len;
+    i++;
+  }
+
+  int32_t step = numLines / numOfTasks;
+  for (int32_t t = 0; t < numOfTasks; ++t) {
+    SSmlParseTask *pParse = pParses + t;
+    pParse->start = t * step;
+    pParse->num = (t == numOfTasks - 1) ? numLines - pParse->start : step;
+    pParse->lines = pLines + pParse->start;
+    pParse->lens = pLens + pParse->start;
+    pParse->info = smlBuildSmlInfo(NULL);
+    if (pParse->info == NULL) {
+      code = TSDB_CODE_OUT_OF_MEMORY;
+      goto _end;
+    }
+    pParse->info->id = info->id;
+    pParse->info->protocol = info->protocol;
+    pParse->info->precision = info->precision;
+    pParse->info->dataFormat = false;
+    pParse->info->msgBuf.buf = pParse->msg;
+    pParse->info->msgBuf.len = sizeof(pParse->msg);
+    pParse->info->lines = info->lines + pParse->start;
+
+    pTasks[t].fp = smlParseTaskFp;
+    pTasks[t].param = pParse;
+  }
+
+  smlRunTasks(pTasks, numOfTasks);
+
+  for (int32_t t = 0; t < numOfTasks; ++t) {
+    if (code == TSDB_CODE_SUCCESS && pParses[t].code != TSDB_CODE_SUCCESS) {
+      code = pParses[t].code;
+      tstrncpy(info->msgBuf.buf, pParses[t].msg, info->msgBuf.len);
+    }
+    int32_t ret = smlMergeChildTables(info, pParses[t].info);
+    if (code == TSDB_CODE_SUCCESS) {
+      code = ret;
+    }
+  }
+
+_end:
+  for (int32_t t = 0; pParses != NULL && t < numOfTasks; ++t) {
+    if (pParses[t].info != NULL) {
+      pParses[t].info->lines = NULL;  // owned by the batch handle
+      pParses[t].info->lineNum = 0;
+      smlDestroyInfo(pParses[t].info);
+    }
+  }
+  taosMemoryFree(pLines);
+  taosMemoryFree(pLens);
+  taosMemoryFree(pParses);
+  taosMemoryFree(pTasks);
+  uDebug("SML:0x%" PRIx64 " smlParseLineParallel end, code:%d", info->id, code);
+  return code;
+}
+
 static int smlProcess(SSmlHandle *info, char *lines[], char *rawLine, char *rawLineEnd, int numLines) {
   int32_t code = TSDB_CODE_SUCCESS;
   int32_t retryNum = 0;
 
   info->cost.parseTime = taosGetTimestampUs();
 
-  code = smlParseLine(info, lines, rawLine, rawLineEnd, numLines);
+  int32_t numOfTasks = smlGetNumOfTasks(info, numLines);
+  if (numOfTasks > 1) {
+    code = smlParseLineParallel(info, lines, rawLine, rawLineEnd, numLines, numOfTasks);
+  } else {
+    code = smlParseLine(info, lines, rawLine, rawLineEnd, numLines);
+  }
   if (code != 0) {
     uError("SML:0x%" PRIx64 " smlParseLine error : %s", info->id, tstrerror(code));
     return code;
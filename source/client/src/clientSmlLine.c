@@ -48,6 +48,47 @@
 #define BINARY_ADD_LEN (sizeof("\"\"")-1)    // "binary"   2 means length of ("")
 #define NCHAR_ADD_LEN  (sizeof("L\"\"")-1)   // L"nchar"   3 means length of (L"")
 
+#define SML_ONES_8               0x0101010101010101ULL
+#define SML_HAS_ZERO_BYTE(v)     (((v)-SML_ONES_8) & ~(v) & (SML_ONES_8 << 7))
+#define SML_HAS_BYTE(v, c)       SML_HAS_ZERO_BYTE((v) ^ (SML_ONES_8 * (uint8_t)(c)))
+
+// Return the first byte in [p, end) equal to one of c0..c3, or end if there is none. The parse loops below only act
+// on the separators, quotes and escapes, so the plain bytes between them are skipped 32(avx2) or 8 bytes a time.
+static FORCE_INLINE const char *smlSkipPlain(const char *p, const char *end, char c0, char c1, char c2, char c3) {
+#if __AVX2__
+  if (tsAVX2Enable && tsSIMDEnable) {
+    __m256i v0 = _mm256_set1_epi8(c0);
+    __m256i v1 = _mm256_set1_epi8(c1);
+    __m256i v2 = _mm256_set1_epi8(c2);
+    __m256i v3 = _mm256_set1_epi8(c3);
+    while (end - p >= 32) {
+      __m256i  data = _mm256_loadu_si256((const __m256i *)p);
+      __m256i  hit = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(data, v0), _mm256_cmpeq_epi8(data, v1)),
+                                     _mm256_or_si256(_mm256_cmpeq_epi8(data, v2), _mm256_cmpeq_epi8(data, v3)));
+      uint32_t mask = (uint32_t)_mm256_movemask_epi8(hit);
+      if (mask != 0) {
+        return p + BUILDIN_CTZ(mask);
+      }
+      p += 32;
+    }
+  }
+#endif
+
+  while (end - p >= 8) {
+    uint64_t v;
+    memcpy(&v, p, sizeof(v));
+    if (SML_HAS_BYTE(v, c0) | SML_HAS_BYTE(v, c1) | SML_HAS_BYTE(v, c2) | SML_HAS_BYTE(v, c3)) {
+      break;
+    }
+    p += 8;
+  }
+
+  while (p < end && *p != c0 && *p != c1 && *p != c2 && *p != c3) {
+    p++;
+  }
+  return p;
+}
+
 uint8_t smlPrecisionConvert[] = {TSDB_TIME_PRECISION_NANO,    TSDB_TIME_PRECISION_HOURS, TSDB_TIME_PRECISION_MINUTES,
                                   TSDB_TIME_PRECISION_SECONDS, TSDB_TIME_PRECISION_MILLI, TSDB_TIME_PRECISION_MICRO,
                                   TSDB_TIME_PRECISION_NANO};
@@ -210,6 +251,10 @@ static int32_t smlProcessTagLine(SSmlHandle *info, char **sql, char *sqlEnd){
     const char *escapeChar = NULL;
 
     while (*sql < sqlEnd) {
+      *sql = (char *)smlSkipPlain(*sql, sqlEnd, COMMA, SPACE, EQUAL, SLASH);
+      if (unlikely(*sql >= sqlEnd)) {
+        break;
+      }
       if (unlikely(IS_SPACE(*sql,escapeChar) || IS_COMMA(*sql,escapeChar))) {
         smlBuildInvalidDataMsg(&info->msgBuf, "invalid data", *sql);
         terrno = TSDB_CODE_SML_INVALID_DATA;
@@ -241,6 +286,10 @@ static int32_t smlProcessTagLine(SSmlHandle *info, char **sql, char *sqlEnd){
     size_t      valueLenEscaped = 0;
     while (*sql < sqlEnd) {
       // parse value
+      *sql = (char *)smlSkipPlain(*sql, sqlEnd, COMMA, SPACE, EQUAL, SLASH);
+      if (unlikely(*sql >= sqlEnd)) {
+        break;
+      }
       if (unlikely(IS_SPACE(*sql,escapeChar) || IS_COMMA(*sql,escapeChar))) {
         break;
       } else if (unlikely(IS_EQUAL(*sql,escapeChar))) {
@@ -341,6 +390,10 @@ static int32_t smlParseColLine(SSmlHandle *info, char **sql, char *sqlEnd, SSmlL
     size_t      keyLenEscaped = 0;
     const char *escapeChar = NULL;
     while (*sql < sqlEnd) {
+      *sql = (char *)smlSkipPlain(*sql, sqlEnd, COMMA, SPACE, EQUAL, SLASH);
+      if (unlikely(*sql >= sqlEnd)) {
+        break;
+      }
       if (unlikely(IS_SPACE(*sql,escapeChar) || IS_COMMA(*sql,escapeChar))) {
         smlBuildInvalidDataMsg(&info->msgBuf, "invalid data", *sql);
         return TSDB_CODE_SML_INVALID_DATA;
@@ -371,6 +424,10 @@ static int32_t smlParseColLine(SSmlHandle *info, char **sql, char *sqlEnd, SSmlL
     int         quoteNum = 0;
     while (*sql < sqlEnd) {
       // parse value
+      *sql = (char *)smlSkipPlain(*sql, sqlEnd, QUOTE, SPACE, COMMA, SLASH);
+      if (unlikely(*sql >= sqlEnd)) {
+        break;
+      }
       if (unlikely(*(*sql) == QUOTE && (*(*sql - 1) != SLASH || (*sql - 1) == escapeChar))) {
         quoteNum++;
         (*sql)++;
@@ -460,6 +517,10 @@ int32_t smlParseInfluxString(SSmlHandle *info, char *sql, char *sqlEnd, SSmlLine
   size_t measureLenEscaped = 0;
   const char *escapeChar = NULL;
   while (sql < sqlEnd) {
+    sql = (char *)smlSkipPlain(sql, sqlEnd, COMMA, SPACE, SLASH, SLASH);
+    if (unlikely(sql >= sqlEnd)) {
+      break;
+    }
     if (unlikely(IS_COMMA(sql,escapeChar) || IS_SPACE(sql,escapeChar))) {
       break;
     }
@@ -482,6 +543,10 @@ int32_t smlParseInfluxString(SSmlHandle *info, char *sql, char *sqlEnd, SSmlLine
   // to get measureTagsLen before
   const char *tmp = sql;
   while (tmp < sqlEnd) {
+    tmp = smlSkipPlain(tmp, sqlEnd, SPACE, COMMA, EQUAL, SLASH);
+    if (unlikely(tmp >= sqlEnd)) {
+      break;
+    }
     if (unlikely(IS_SPACE(tmp,escapeChar))) {
       break;
     }
@@ -581,4 +581,131 @@ TEST(testCase, smlParseNumber_performance_Test) {
     printf("smlParseNumberOld:%s cost:%" PRId64, str[i], taosGetTimestampUs() - t2);
     printf("\n\n");
   }
-}
\ No newline at end of file
+}
+
+typedef struct SSmlParseBenchRes {
+  int64_t elapsedUs;
+  int64_t numOfCols;
+  int64_t totalLen;
+} SSmlParseBenchRes;
+
+static SSmlParseBenchRes smlParseCorpus(SSmlHandle *info, char **lines, int32_t numOfLines) {
+  SSmlParseBenchRes res = {0};
+  SSmlLineInfo      elements = {0};
+
+  int64_t st = taosGetTimestampUs();
+  for (int32_t i = 0; i < numOfLines; ++i) {
+    memset(&elements, 0, sizeof(SSmlLineInfo));
+    int ret = smlParseInfluxString(info, lines[i], lines[i] + strlen(lines[i]), &elements);
+    EXPECT_EQ(ret, 0);
+    res.numOfCols += taosArrayGetSize(elements.colArray);
+    res.totalLen += elements.measureTagsLen + elements.colsLen + elements.timestampLen;
+    taosArrayDestroy(elements.colArray);
+  }
+  res.elapsedUs = TMAX(taosGetTimestampUs() - st, 1);
+  return res;
+}
+
+TEST(testCase, smlParseInfluxString_performance_Test) {
+  // a tsbs cpu-only like corpus with a log message column, 100 hosts
+  const int32_t numOfLines = 200000;
+  char        **lines = (char **)taosMemoryCalloc(numOfLines, POINTER_BYTES);
+  int64_t       bytes = 0;
+  for (int32_t i = 0; i < numOfLines; ++i) {
+    lines[i] = (char *)taosMemoryCalloc(1024, 1);
+    bytes += snprintf(lines[i], 1024,
+                      "cpu,hostname=host_%d,region=ap-southeast-%d,datacenter=ap-southeast-%dc,rack=%d,"
+                      "os=Ubuntu16.04LTS,arch=x64,team=SF,service=%d,service_version=1,service_environment=test "
+                      "usage_user=%di64,usage_system=%di64,usage_idle=%d.%02d,usage_nice=%df64,usage_iowait=%d.5,"
+                      "usage_irq=%du32,online=%s,message=\"kernel: eth0 link is up, 1000Mbps full duplex, flow control "
+                      "rx/tx\" %" PRId64,
+                      i % 100, i % 3, i % 3, i % 100, i % 20, i % 100, (i * 7) % 100, i % 100, i % 97, i % 13, i % 50,
+                      i % 1000, (i % 2) ? "true" : "false", 1451606400000000000LL + (int64_t)i * 10000000000LL);
+  }
+
+  taosGetCpuInstructions(&tsSSE42Enable, &tsAVXEnable, &tsAVX2Enable, &tsFMAEnable, &tsAVX512Enable);
+  char simdEnable = tsSIMDEnable;
+
+  SSmlParseBenchRes res[2] = {0};
+  for (int32_t i = 0; i < 2; ++i) {
+    SSmlHandle *info = smlBuildSmlInfo(NULL);
+    info->protocol = TSDB_SML_LINE_PROTOCOL;
+    info->dataFormat = false;
+    tsSIMDEnable = i;
+    res[i] = smlParseCorpus(info, lines, numOfLines);
+    smlDestroyInfo(info);
+  }
+  tsSIMDEnable = simdEnable;
+
+  ASSERT_EQ(res[0].numOfCols, res[1].numOfCols);
+  ASSERT_EQ(res[0].totalLen, res[1].totalLen);
+  ASSERT_EQ(res[0].numOfCols, (int64_t)numOfLines * 9);
+  printf("smlParseInfluxString lines:%d, bytes:%" PRId64 ", swar:%.1f MB/s, simd(avx2:%d):%.1f MB/s\n", numOfLines,
+         bytes, (double)bytes / res[0].elapsedUs, tsAVX2Enable, (double)bytes / res[1].elapsedUs);
+
+  for (int32_t i = 0; i < numOfLines; ++i) {
+    taosMemoryFree(lines[i]);
+  }
+  taosMemoryFree(lines);
+}
+
+TEST(testCase, smlParseLineParallel_Test) {
+  // 64 child tables, each of them appears in all the tasks
+  const int32_t numOfLines = 20000;
+  const int32_t numOfTables = 64;
+  char        **lines = (char **)taosMemoryCalloc(numOfLines, POINTER_BYTES);
+  for (int32_t i = 0; i < numOfLines; ++i) {
+    lines[i] = (char *)taosMemoryCalloc(256, 1);
+    snprintf(lines[i], 256, "st_%d,host=host_%d,region=r\\ %d c1=%di64,c2=%d.5,c3=\"v%d\" %" PRId64, i % 2,
+             i % numOfTables, i % 4, i, i, i, 1626006833639000000LL + i);
+  }
+
+  int32_t threads = tsSmlWriteThreads;
+  tsSmlWriteThreads = 3;
+
+  SSmlHandle *info = smlBuildSmlInfo(NULL);
+  info->protocol = TSDB_SML_LINE_PROTOCOL;
+  info->lineNum = numOfLines;
+  int32_t ret = smlParseLineParallel(info, lines, NULL, NULL, numOfLines, 4);
+  ASSERT_EQ(ret, 0);
+  ASSERT_EQ(info->dataFormat, false);
+  ASSERT_EQ(taosHashGetSize(info->childTables), numOfTables);
+
+  // the uids are assigned by the batch handle, one for each child table
+  SHashObj       *uids = taosHashInit(numOfTables, taosGetDefaultHashFunction(TSDB_DATA_TYPE_UBIGINT), false, HASH_NO_LOCK);
+  SSmlTableInfo **oneTable = (SSmlTableInfo **)taosHashIterate(info->childTables, NULL);
+  while (oneTable) {
+    ASSERT_LT((*oneTable)->uid, (uint64_t)numOfTables);
+    taosHashPut(uids, &(*oneTable)->uid, sizeof(uint64_t), NULL, 0);
+    oneTable = (SSmlTableInfo **)taosHashIterate(info->childTables, oneTable);
+  }
+  ASSERT_EQ(taosHashGetSize(uids), numOfTables);
+  taosHashCleanup(uids);
+
+  for (int32_t i = 0; i < numOfLines; ++i) {
+    SSmlLineInfo *elements = info->lines + i;
+    ASSERT_EQ(elements->measure, lines[i]);
+    ASSERT_EQ(taosArrayGetSize(elements->colArray), 4);
+    ASSERT_NE(taosHashGet(info->childTables, elements->measure, elements->measureTagsLen), nullptr);
+  }
+
+  // a bad line in the last task fails the batch
+  lines[numOfLines - 1][0] = ',';
+  SSmlHandle *info2 = smlBuildSmlInfo(NULL);
+  char        msg[256] = {0};
+  info2->protocol = TSDB_SML_LINE_PROTOCOL;
+  info2->lineNum = numOfLines;
+  info2->msgBuf.buf = msg;
+  info2->msgBuf.len = sizeof(msg);
+  ret = smlParseLineParallel(info2, lines, NULL, NULL, numOfLines, 4);
+  ASSERT_NE(ret, 0);
+
+  smlDestroyInfo(info);
+  smlDestroyInfo(info2);
+  smlStopWorkerPool();
+  tsSmlWriteThreads = threads;
+  for (int32_t i = 0; i < numOfLines; ++i) {
+    taosMemoryFree(lines[i]);
+  }
+  taosMemoryFree(lines);
+}
@@ -1349,6 +1349,22 @@ int32_t blockDataSort(SSDataBlock* pDataBlock, SArray* pOrderInfo) {
   return TSDB_CODE_SUCCESS;
 }
 
+int32_t blockDataReorder(SSDataBlock* pDataBlock, const int32_t* index) {
+  if (pDataBlock->info.rows <= 1) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  SColumnInfoData* pCols = createHelpColInfoData(pDataBlock);
+  if (pCols == NULL) {
+    terrno = TSDB_CODE_OUT_OF_MEMORY;
+    return terrno;
+  }
+
+  blockDataAssign(pCols, pDataBlock, index);
+  copyBackToBlock(pDataBlock, pCols);
+  return TSDB_CODE_SUCCESS;
+}
+
 void blockDataCleanup(SSDataBlock* pDataBlock) {
   blockDataEmpty(pDataBlock);
   SDataBlockInfo* pInfo = &pDataBlock->info;
@@ -2689,6 +2705,207 @@ const char* blockDecode(SSDataBlock* pBlock, const char* pData) {
   return pStart;
 }
 
+// clang-format off
+// A block encoded by blockEncode may be compressed column by column to be sent to the client. The header is kept,
+// with the total length replaced by the compressed length and BLOCK_COMPRESSED_FLAG set in the flag segment. Both
+// the offset/bitmap part and the data part of each column are stored as a segment:
+// +-----------------+-------------------+---------+
+// | algorithm       | length            | payload |
+// | sizeof(int8_t)  | sizeof(int32_t)   |         |
+// +-----------------+-------------------+---------+
+// The algorithm is NO_COMPRESSION if the segment does not get smaller by the codec of its type.
+// clang-format on
+#define BLOCK_SEG_HEAD_SIZE (sizeof(int8_t) + sizeof(int32_t))
+
+typedef struct SEncodedBlockInfo {
+  int32_t        version;
+  int32_t        numOfRows;
+  int32_t        numOfCols;
+  int32_t        headLen;
+  const char*    pSchema;
+  const int32_t* colSizes;
+} SEncodedBlockInfo;
+
+static void blockGetEncodedInfo(const char* pData, SEncodedBlockInfo* pInfo) {
+  pInfo->version = *(int32_t*)pData;
+  pInfo->numOfRows = *(int32_t*)(pData + sizeof(int32_t) * 2);
+  pInfo->numOfCols = *(int32_t*)(pData + sizeof(int32_t) * 3);
+  // the blank fill flag is at the end of the block
+  pInfo->headLen = blockDataGetSerialMetaSize(pInfo->numOfCols) - sizeof(bool);
+  pInfo->pSchema = pData + sizeof(int32_t) * 5 + sizeof(uint64_t);
+  pInfo->colSizes = (const int32_t*)(pData + pInfo->headLen - sizeof(int32_t) * pInfo->numOfCols);
+}
+
+// the codec types of the offset/bitmap part and the data part of a column
+static void blockGetEncodedCol(const SEncodedBlockInfo* pInfo, int32_t i, int8_t* metaType, int32_t* metaLen,
+                               int8_t* dataType, int32_t* colLen) {
+  int8_t type = *(int8_t*)(pInfo->pSchema + i * (sizeof(int8_t) + sizeof(int32_t)));
+  if (IS_VAR_DATA_TYPE(type)) {
+    *metaType = TSDB_DATA_TYPE_INT;
+    *metaLen = pInfo->numOfRows * sizeof(int32_t);
+    *dataType = TSDB_DATA_TYPE_VARCHAR;
+  } else {
+    *metaType = TSDB_DATA_TYPE_VARCHAR;
+    *metaLen = BitmapLen(pInfo->numOfRows);
+    // the bool codec rejects the garbage left in null rows
+    *dataType = (type == TSDB_DATA_TYPE_BOOL) ? TSDB_DATA_TYPE_TINYINT : type;
+  }
+  *colLen = (pInfo->version == BLOCK_VERSION_1) ? htonl(pInfo->colSizes[i]) : pInfo->colSizes[i];
+}
+
+static bool blockSegCompressible(int8_t type) {
+#ifdef TD_TSZ
+  // the result should not be lossy
+  if ((type == TSDB_DATA_TYPE_FLOAT && lossyFloat) || (type == TSDB_DATA_TYPE_DOUBLE && lossyDouble)) {
+    return false;
+  }
+#endif
+  return tDataTypes[type].compFunc != NULL;
+}
+
+static char* blockCompressSeg(const char* pIn, int32_t len, int8_t type, char* pOut) {
+  int8_t*  alg = (int8_t*)pOut;
+  int32_t* segLen = (int32_t*)(pOut + sizeof(int8_t));
+  char*    pPayload = pOut + BLOCK_SEG_HEAD_SIZE;
+
+  if (len > 0 && blockSegCompressible(type)) {
+    SCompressInfo info = {.dataType = type, .cmprAlg = ONE_STAGE_COMP, .originalSize = len};
+    if (tCompressData((void*)pIn, &info, pPayload, len + COMP_OVERFLOW_BYTES, NULL) == 0 && info.compressedSize > 0 &&
+        info.compressedSize < len) {
+      *alg = ONE_STAGE_COMP;
+      *segLen = info.compressedSize;
+      return pPayload + info.compressedSize;
+    }
+  }
+
+  *alg = NO_COMPRESSION;
+  *segLen = len;
+  if (len > 0) {
+    memcpy(pPayload, pIn, len);
+  }
+  return pPayload + len;
+}
+
+static const char* blockDecompressSeg(const char* pIn, int32_t len, int8_t type, char* pOut) {
+  int8_t      alg = *(int8_t*)pIn;
+  int32_t     segLen = *(int32_t*)(pIn + sizeof(int8_t));
+  const char* pPayload = pIn + BLOCK_SEG_HEAD_SIZE;
+
+  if (alg == NO_COMPRESSION) {
+    if (segLen != len) {
+      return NULL;
+    }
+    if (len > 0) {
+      memcpy(pOut, pPayload, len);
+    }
+  } else {
+    SCompressInfo info = {.dataType = type, .cmprAlg = alg, .originalSize = len, .compressedSize = segLen};
+    if (tDecompressData((void*)pPayload, &info, pOut, len, NULL) != 0) {
+      return NULL;
+    }
+  }
+  return pPayload + segLen;
+}
+
+int32_t blockCompressBufSize(int32_t len, int32_t numOfCols) {
+  return len + numOfCols * 2 * (BLOCK_SEG_HEAD_SIZE + COMP_OVERFLOW_BYTES);
+}
+
+// Compress the columns of a block encoded by blockEncode into pOut with the codecs of their types: delta for
+// timestamp, simple8b for integer, xor for float and lz4 for var data. The capacity of pOut should be no less than
+// blockCompressBufSize. Return the compressed length, or -1 if the block does not get smaller.
+int32_t blockCompressEncoded(const char* pData, char* pOut, int32_t capacity) {
+  SEncodedBlockInfo info = {0};
+  blockGetEncodedInfo(pData, &info);
+
+  int32_t len = *(int32_t*)(pData + sizeof(int32_t));
+  if (capacity < blockCompressBufSize(len, info.numOfCols)) {
+    return -1;
+  }
+
+  memcpy(pOut, pData, info.headLen);
+
+  const char* pStart = pData + info.headLen;
+  char*       p = pOut + info.headLen;
+  for (int32_t i = 0; i < info.numOfCols; ++i) {
+    int8_t  metaType = 0, dataType = 0;
+    int32_t metaLen = 0, colLen = 0;
+    blockGetEncodedCol(&info, i, &metaType, &metaLen, &dataType, &colLen);
+
+    p = blockCompressSeg(pStart, metaLen, metaType, p);
+    p = blockCompressSeg(pStart + metaLen, colLen, dataType, p);
+    pStart += metaLen + colLen;
+  }
+
+  *(bool*)p = *(bool*)pStart;
+  p += sizeof(bool);
+
+  int32_t compLen = p - pOut;
+  if (compLen >= len) {
+    return -1;
+  }
+
+  *(int32_t*)(pOut + sizeof(int32_t)) = compLen;
+  *(int32_t*)(pOut + sizeof(int32_t) * 4) |= BLOCK_COMPRESSED_FLAG;
+  return compLen;
+}
+
+bool blockIsEncodedCompressed(const char* pData) {
+  return (*(int32_t*)(pData + sizeof(int32_t) * 4) & BLOCK_COMPRESSED_FLAG) != 0;
+}
+
+int32_t blockGetDecompressedSize(const char* pData) {
+  SEncodedBlockInfo info = {0};
+  blockGetEncodedInfo(pData, &info);
+
+  int32_t len = info.headLen + sizeof(bool);
+  for (int32_t i = 0; i < info.numOfCols; ++i) {
+    int8_t  metaType = 0, dataType = 0;
+    int32_t metaLen = 0, colLen = 0;
+    blockGetEncodedCol(&info, i, &metaType, &metaLen, &dataType, &colLen);
+    len += metaLen + colLen;
+  }
+  return len;
+}
+
+// Restore a block compressed by blockCompressEncoded to the layout of blockEncode. Return the length of the block,
+// or -1 if failed.
+int32_t blockDecompressEncoded(const char* pData, char* pOut, int32_t capacity) {
+  SEncodedBlockInfo info = {0};
+  blockGetEncodedInfo(pData, &info);
+
+  int32_t len = blockGetDecompressedSize(pData);
+  if (capacity < len) {
+    return -1;
+  }
+
+  memcpy(pOut, pData, info.headLen);
+
+  const char* pStart = pData + info.headLen;
+  char*       p = pOut + info.headLen;
+  for (int32_t i = 0; i < info.numOfCols && pStart != NULL; ++i) {
+    int8_t  metaType = 0, dataType = 0;
+    int32_t metaLen = 0, colLen = 0;
+    blockGetEncodedCol(&info, i, &metaType, &metaLen, &dataType, &colLen);
+
+    pStart = blockDecompressSeg(pStart, metaLen, metaType, p);
+    if (pStart != NULL) {
+      pStart = blockDecompressSeg(pStart, colLen, dataType, p + metaLen);
+    }
+    p += metaLen + colLen;
+  }
+
+  if (pStart == NULL) {
+    return -1;
+  }
+
+  *(bool*)p = *(bool*)pStart;
+
+  *(int32_t*)(pOut + sizeof(int32_t)) = len;
+  *(int32_t*)(pOut + sizeof(int32_t) * 4) &= ~BLOCK_COMPRESSED_FLAG;
+  return len;
+}
+
 void trimDataBlock(SSDataBlock* pBlock, int32_t totalRows, const bool* pBoolList) {
   //  int32_t totalRows = pBlock->info.rows;
   int32_t bmLen = BitmapLen(totalRows);
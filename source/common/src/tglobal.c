@@ -58,6 +58,7 @@ int32_t tsNumOfRpcThreads = 1;
 int32_t tsNumOfRpcSessions = 30000;
 int32_t tsTimeToGetAvailableConn = 500000;
 int32_t tsKeepAliveIdle = 60;
+bool    tsTransLocalEnable = true;  // talk to the server on the same host through a unix domain socket
 
 int32_t tsNumOfCommitThreads = 2;
 int32_t tsNumOfTaskQueueThreads = 16;
@@ -68,6 +69,8 @@ int32_t tsNumOfVnodeQueryThreads = 16;
 float   tsRatioOfVnodeStreamThreads = 0.5F;
 int32_t tsNumOfVnodeFetchThreads = 4;
 int32_t tsNumOfVnodeRsmaThreads = 2;
+int32_t tsNumOfVnodeInsertThreads = 1;  // threads a vnode inserts the tables of one submit request with, 1 for serial
+int32_t tsTdbCacheShards = 0;           // page cache shards of the meta/tq tdb of a vnode, 0 for by the cache size
 int32_t tsNumOfQnodeQueryThreads = 16;
 int32_t tsNumOfQnodeFetchThreads = 1;
 int32_t tsNumOfSnodeStreamThreads = 4;
@@ -80,6 +83,7 @@ int32_t tsElectInterval = 25 * 1000;
 int32_t tsHeartbeatInterval = 1000;
 int32_t tsHeartbeatTimeout = 20 * 1000;
 int32_t tsSnapReplMaxWaitN = 128;
+int32_t tsSyncLogReplBatchNum = 1;  // max raft entries sent in one append entries msg, 1 for no batching
 
 // mnode
 int64_t tsMndSdbWriteDelta = 200;
@@ -139,6 +143,7 @@ char *tsSvrCrashReportUri = "/dcrashreport";
 
 // schemaless
 bool tsSmlDot2Underline = true;
+int32_t tsSmlWriteThreads = 0;  // threads parsing and binding a large schemaless batch, 0 for the calling thread only
 char tsSmlTsDefaultName[TSDB_COL_NAME_LEN] = "_ts";
 char tsSmlTagName[TSDB_COL_NAME_LEN] = "_tag_null";
 char tsSmlChildTableName[TSDB_TABLE_NAME_LEN] = "";  // user defined child table name can be specified in tag value.
@@ -171,7 +176,9 @@ int32_t tsQueryRsmaTolerance = 1000;  // the tolerance time (ms) to judge from w
 bool    tsQueryPlannerTrace = false;
 int32_t tsQueryNodeChunkSize = 32 * 1024;
 bool    tsQueryUseNodeAllocator = true;
+bool    tsQueryResultCompress = true;  // ask the server to compress the query result by columns
 bool    tsKeepColumnName = false;
+bool    tsQueryFollowerRead = false;  // spread query tasks over all replicas, followers serve them after a read index
 int32_t tsRedirectPeriod = 10;
 int32_t tsRedirectFactor = 2;
 int32_t tsRedirectMaxPeriod = 1000;
@@ -215,6 +222,17 @@ char    tsTagFilterCache = 0;
 // positive value (in MB)
 int32_t tsQueryBufferSize = -1;
 int64_t tsQueryBufferSizeBytes = -1;
+
+// the build side buffer size of a hash join operator, beyond which both sides are partitioned to disk.
+// non-positive value follows queryBufferSize
+// positive value (in MB)
+int32_t tsHashJoinBufSize = -1;
+
+// the number of threads generating the sorted runs of an external sort in parallel, 0 means in the query thread
+int32_t tsNumOfSortThreads = 0;
+
+// aggregate the blocks of a group by in batch when the group keys of adjacent rows rarely repeat
+bool    tsGroupByBatchAgg = true;
 int32_t tsCacheLazyLoadThreshold = 500;
 
 int32_t  tsDiskCfgNum = 0;
@@ -259,6 +277,14 @@ bool    tsStartUdfd = true;
 
 // wal
 int64_t tsWalFsyncDataSizeLimit = (100 * 1024 * 1024L);
+bool    tsWalGroupCommit = false;       // stage appends and flush them to the wal files in groups
+int32_t tsWalGroupCommitLatency = 2;    // ms, max time an entry may stay in the staging buffer
+int32_t tsWalGroupCommitBufSize = 4096; // KB, size of the staging buffer of each wal
+
+// tsdb
+bool    tsTsdbBloomFilter = false;  // build per-column bloom filters for data file blocks
+int32_t tsTsdbMergeAdmitRate = 0;   // stt merge input admitted in MB/s on average, dnode wide, 0 for unlimited
+int32_t tsTsdbReadAhead = 1;        // file block read-ahead of readers, 0: off, 1: blocks to be loaded, 2: all blocks
 
 // ttl
 bool    tsTtlChangeOnWrite = false;  // if true, ttl delete time changes on last write
@@ -516,7 +542,10 @@ static int32_t taosAddClientCfg(SConfig *pCfg) {
     return -1;
   if (cfgAddBool(pCfg, "queryUseNodeAllocator", tsQueryUseNodeAllocator, CFG_SCOPE_CLIENT, CFG_DYN_CLIENT) != 0)
     return -1;
+  if (cfgAddBool(pCfg, "queryResultCompress", tsQueryResultCompress, CFG_SCOPE_CLIENT, CFG_DYN_CLIENT) != 0)
+    return -1;
   if (cfgAddBool(pCfg, "keepColumnName", tsKeepColumnName, CFG_SCOPE_CLIENT, CFG_DYN_CLIENT) != 0) return -1;
+  if (cfgAddBool(pCfg, "queryFollowerRead", tsQueryFollowerRead, CFG_SCOPE_BOTH, CFG_DYN_NONE) != 0) return -1;
   if (cfgAddString(pCfg, "smlChildTableName", tsSmlChildTableName, CFG_SCOPE_CLIENT, CFG_DYN_CLIENT) != 0) return -1;
   if (cfgAddString(pCfg, "smlAutoChildTableNameDelimiter", tsSmlAutoChildTableNameDelimiter, CFG_SCOPE_CLIENT,
                    CFG_DYN_CLIENT) != 0)
@@ -524,6 +553,7 @@ static int32_t taosAddClientCfg(SConfig *pCfg) {
   if (cfgAddString(pCfg, "smlTagName", tsSmlTagName, CFG_SCOPE_CLIENT, CFG_DYN_CLIENT) != 0) return -1;
   if (cfgAddString(pCfg, "smlTsDefaultName", tsSmlTsDefaultName, CFG_SCOPE_CLIENT, CFG_DYN_CLIENT) != 0) return -1;
   if (cfgAddBool(pCfg, "smlDot2Underline", tsSmlDot2Underline, CFG_SCOPE_CLIENT, CFG_DYN_CLIENT) != 0) return -1;
+  if (cfgAddInt32(pCfg, "smlWriteThreads", tsSmlWriteThreads, 0, 64, CFG_SCOPE_CLIENT, CFG_DYN_NONE) != 0) return -1;
   //  if (cfgAddBool(pCfg, "smlDataFormat", tsSmlDataFormat, CFG_SCOPE_CLIENT, CFG_DYN_NONE) != 0) return -1;
   //  if (cfgAddInt32(pCfg, "smlBatchSize", tsSmlBatchSize, 1, INT32_MAX, CFG_SCOPE_CLIENT, CFG_DYN_NONE) != 0)
   //  return -1;
@@ -559,6 +589,7 @@ static int32_t taosAddClientCfg(SConfig *pCfg) {
 
   tsKeepAliveIdle = TRANGE(tsKeepAliveIdle, 1, 72000);
   if (cfgAddInt32(pCfg, "keepAliveIdle", tsKeepAliveIdle, 1, 7200000, CFG_SCOPE_BOTH, CFG_DYN_ENT_BOTH) != 0) return -1;
+  if (cfgAddBool(pCfg, "transLocalEnable", tsTransLocalEnable, CFG_SCOPE_BOTH, CFG_DYN_NONE) != 0) return -1;
 
   tsNumOfTaskQueueThreads = tsNumOfCores;
   tsNumOfTaskQueueThreads = TMAX(tsNumOfTaskQueueThreads, 16);
@@ -641,6 +672,13 @@ static int32_t taosAddServerCfg(SConfig *pCfg) {
 
   if (cfgAddInt32(pCfg, "queryBufferSize", tsQueryBufferSize, -1, 500000000000, CFG_SCOPE_SERVER, CFG_DYN_NONE) != 0)
     return -1;
+  if (cfgAddInt32(pCfg, "hashJoinBufSize", tsHashJoinBufSize, -1, 1048576, CFG_SCOPE_SERVER, CFG_DYN_NONE) != 0)
+    return -1;
+
+  if (cfgAddInt32(pCfg, "numOfSortThreads", tsNumOfSortThreads, 0, 1024, CFG_SCOPE_SERVER, CFG_DYN_NONE) != 0)
+    return -1;
+  if (cfgAddBool(pCfg, "groupByBatchAgg", tsGroupByBatchAgg, CFG_SCOPE_SERVER, CFG_DYN_NONE) != 0) return -1;
+
   if (cfgAddInt32(pCfg, "queryRspPolicy", tsQueryRspPolicy, 0, 1, CFG_SCOPE_SERVER, CFG_DYN_ENT_SERVER) != 0) return -1;
 
   tsNumOfCommitThreads = tsNumOfCores / 2;
@@ -674,6 +712,11 @@ static int32_t taosAddServerCfg(SConfig *pCfg) {
   if (cfgAddInt32(pCfg, "numOfVnodeRsmaThreads", tsNumOfVnodeRsmaThreads, 1, 1024, CFG_SCOPE_SERVER, CFG_DYN_NONE) != 0)
     return -1;
 
+  if (cfgAddInt32(pCfg, "numOfVnodeInsertThreads", tsNumOfVnodeInsertThreads, 1, 64, CFG_SCOPE_SERVER, CFG_DYN_NONE) !=
+      0)
+    return -1;
+  if (cfgAddInt32(pCfg, "tdbCacheShards", tsTdbCacheShards, 0, 16, CFG_SCOPE_SERVER, CFG_DYN_NONE) != 0) return -1;
+
   tsNumOfQnodeQueryThreads = tsNumOfCores * 2;
   tsNumOfQnodeQueryThreads = TMAX(tsNumOfQnodeQueryThreads, 16);
   if (cfgAddInt32(pCfg, "numOfQnodeQueryThreads", tsNumOfQnodeQueryThreads, 4, 1024, CFG_SCOPE_SERVER, CFG_DYN_NONE) !=
@@ -714,6 +757,8 @@ static int32_t taosAddServerCfg(SConfig *pCfg) {
   if (cfgAddInt32(pCfg, "syncSnapReplMaxWaitN", tsSnapReplMaxWaitN, 16, (TSDB_SYNC_SNAP_BUFFER_SIZE >> 2),
                   CFG_SCOPE_SERVER, CFG_DYN_NONE) != 0)
     return -1;
+  if (cfgAddInt32(pCfg, "syncLogReplBatchNum", tsSyncLogReplBatchNum, 1, 64, CFG_SCOPE_SERVER, CFG_DYN_NONE) != 0)
+    return -1;
 
   if (cfgAddInt32(pCfg, "arbHeartBeatIntervalSec", tsArbHeartBeatIntervalSec, 1, 60 * 24 * 2, CFG_SCOPE_SERVER,
                   CFG_DYN_NONE) != 0)
@@ -796,6 +841,18 @@ static int32_t taosAddServerCfg(SConfig *pCfg) {
   if (cfgAddInt64(pCfg, "walFsyncDataSizeLimit", tsWalFsyncDataSizeLimit, 100 * 1024 * 1024, INT64_MAX,
                   CFG_SCOPE_SERVER, CFG_DYN_NONE) != 0)
     return -1;
+  if (cfgAddBool(pCfg, "walGroupCommit", tsWalGroupCommit, CFG_SCOPE_SERVER, CFG_DYN_NONE) != 0) return -1;
+  if (cfgAddInt32(pCfg, "walGroupCommitLatency", tsWalGroupCommitLatency, 0, 1000, CFG_SCOPE_SERVER, CFG_DYN_NONE) !=
+      0)
+    return -1;
+  if (cfgAddInt32(pCfg, "walGroupCommitBufSize", tsWalGroupCommitBufSize, 64, 1024 * 1024, CFG_SCOPE_SERVER,
+                  CFG_DYN_NONE) != 0)
+    return -1;
+  if (cfgAddBool(pCfg, "tsdbBloomFilter", tsTsdbBloomFilter, CFG_SCOPE_SERVER, CFG_DYN_NONE) != 0) return -1;
+  if (cfgAddInt32(pCfg, "tsdbMergeAdmitRate", tsTsdbMergeAdmitRate, 0, 1024 * 1024, CFG_SCOPE_SERVER,
+                  CFG_DYN_ENT_SERVER) != 0)
+    return -1;
+  if (cfgAddInt32(pCfg, "tsdbReadAhead", tsTsdbReadAhead, 0, 2, CFG_SCOPE_SERVER, CFG_DYN_ENT_SERVER) != 0) return -1;
 
   if (cfgAddBool(pCfg, "udf", tsStartUdfd, CFG_SCOPE_SERVER, CFG_DYN_NONE) != 0) return -1;
   if (cfgAddString(pCfg, "udfdResFuncs", tsUdfdResFuncs, CFG_SCOPE_SERVER, CFG_DYN_NONE) != 0) return -1;
@@ -1111,6 +1168,7 @@ static int32_t taosSetClientCfg(SConfig *pCfg) {
   tstrncpy(tsSmlTagName, cfgGetItem(pCfg, "smlTagName")->str, TSDB_COL_NAME_LEN);
   tstrncpy(tsSmlTsDefaultName, cfgGetItem(pCfg, "smlTsDefaultName")->str, TSDB_COL_NAME_LEN);
   tsSmlDot2Underline = cfgGetItem(pCfg, "smlDot2Underline")->bval;
+  tsSmlWriteThreads = cfgGetItem(pCfg, "smlWriteThreads")->i32;
   //  tsSmlDataFormat = cfgGetItem(pCfg, "smlDataFormat")->bval;
 
   //  tsSmlBatchSize = cfgGetItem(pCfg, "smlBatchSize")->i32;
@@ -1126,7 +1184,9 @@ static int32_t taosSetClientCfg(SConfig *pCfg) {
   tsQueryPlannerTrace = cfgGetItem(pCfg, "queryPlannerTrace")->bval;
   tsQueryNodeChunkSize = cfgGetItem(pCfg, "queryNodeChunkSize")->i32;
   tsQueryUseNodeAllocator = cfgGetItem(pCfg, "queryUseNodeAllocator")->bval;
+  tsQueryResultCompress = cfgGetItem(pCfg, "queryResultCompress")->bval;
   tsKeepColumnName = cfgGetItem(pCfg, "keepColumnName")->bval;
+  tsQueryFollowerRead = cfgGetItem(pCfg, "queryFollowerRead")->bval;
   tsUseAdapter = cfgGetItem(pCfg, "useAdapter")->bval;
   tsEnableCrashReport = cfgGetItem(pCfg, "crashReporting")->bval;
   tsQueryMaxConcurrentTables = cfgGetItem(pCfg, "queryMaxConcurrentTables")->i64;
@@ -1147,6 +1207,7 @@ static int32_t taosSetClientCfg(SConfig *pCfg) {
   tsTimeToGetAvailableConn = cfgGetItem(pCfg, "timeToGetAvailableConn")->i32;
 
   tsKeepAliveIdle = cfgGetItem(pCfg, "keepAliveIdle")->i32;
+  tsTransLocalEnable = cfgGetItem(pCfg, "transLocalEnable")->bval;
 
   tsExperimental = cfgGetItem(pCfg, "experimental")->bval;
 
@@ -1186,6 +1247,9 @@ static int32_t taosSetServerCfg(SConfig *pCfg) {
   tsMinSlidingTime = cfgGetItem(pCfg, "minSlidingTime")->i32;
   tsMinIntervalTime = cfgGetItem(pCfg, "minIntervalTime")->i32;
   tsQueryBufferSize = cfgGetItem(pCfg, "queryBufferSize")->i32;
+  tsHashJoinBufSize = cfgGetItem(pCfg, "hashJoinBufSize")->i32;
+  tsNumOfSortThreads = cfgGetItem(pCfg, "numOfSortThreads")->i32;
+  tsGroupByBatchAgg = cfgGetItem(pCfg, "groupByBatchAgg")->bval;
   tstrncpy(tsEncryptAlgorithm, cfgGetItem(pCfg, "encryptAlgorithm")->str, 16);
   tstrncpy(tsEncryptScope, cfgGetItem(pCfg, "encryptScope")->str, 100);
   // tstrncpy(tsAuthCode, cfgGetItem(pCfg, "authCode")->str, 100);
@@ -1200,6 +1264,8 @@ static int32_t taosSetServerCfg(SConfig *pCfg) {
   tsRatioOfVnodeStreamThreads = cfgGetItem(pCfg, "ratioOfVnodeStreamThreads")->fval;
   tsNumOfVnodeFetchThreads = cfgGetItem(pCfg, "numOfVnodeFetchThreads")->i32;
   tsNumOfVnodeRsmaThreads = cfgGetItem(pCfg, "numOfVnodeRsmaThreads")->i32;
+  tsNumOfVnodeInsertThreads = cfgGetItem(pCfg, "numOfVnodeInsertThreads")->i32;
+  tsTdbCacheShards = cfgGetItem(pCfg, "tdbCacheShards")->i32;
   tsNumOfQnodeQueryThreads = cfgGetItem(pCfg, "numOfQnodeQueryThreads")->i32;
   //  tsNumOfQnodeFetchThreads = cfgGetItem(pCfg, "numOfQnodeFetchTereads")->i32;
   tsNumOfSnodeStreamThreads = cfgGetItem(pCfg, "numOfSnodeSharedThreads")->i32;
@@ -1251,11 +1317,18 @@ static int32_t taosSetServerCfg(SConfig *pCfg) {
   tsTimeSeriesThreshold = cfgGetItem(pCfg, "timeseriesThreshold")->i32;
 
   tsWalFsyncDataSizeLimit = cfgGetItem(pCfg, "walFsyncDataSizeLimit")->i64;
+  tsWalGroupCommit = cfgGetItem(pCfg, "walGroupCommit")->bval;
+  tsWalGroupCommitLatency = cfgGetItem(pCfg, "walGroupCommitLatency")->i32;
+  tsWalGroupCommitBufSize = cfgGetItem(pCfg, "walGroupCommitBufSize")->i32;
+  tsTsdbBloomFilter = cfgGetItem(pCfg, "tsdbBloomFilter")->bval;
+  tsTsdbMergeAdmitRate = cfgGetItem(pCfg, "tsdbMergeAdmitRate")->i32;
+  tsTsdbReadAhead = cfgGetItem(pCfg, "tsdbReadAhead")->i32;
 
   tsElectInterval = cfgGetItem(pCfg, "syncElectInterval")->i32;
   tsHeartbeatInterval = cfgGetItem(pCfg, "syncHeartbeatInterval")->i32;
   tsHeartbeatTimeout = cfgGetItem(pCfg, "syncHeartbeatTimeout")->i32;
   tsSnapReplMaxWaitN = cfgGetItem(pCfg, "syncSnapReplMaxWaitN")->i32;
+  tsSyncLogReplBatchNum = cfgGetItem(pCfg, "syncLogReplBatchNum")->i32;
 
   tsArbHeartBeatIntervalSec = cfgGetItem(pCfg, "arbHeartBeatIntervalSec")->i32;
   tsArbCheckSyncIntervalSec = cfgGetItem(pCfg, "arbCheckSyncIntervalSec")->i32;
@@ -1608,6 +1681,8 @@ static int32_t taosCfgDynamicOptionsForServer(SConfig *pCfg, const char *name) {
                                          {"ttlBatchDropNum", &tsTtlBatchDropNum},
                                          {"ttlFlushThreshold", &tsTtlFlushThreshold},
                                          {"ttlPushInterval", &tsTtlPushIntervalSec},
+                                         {"tsdbMergeAdmitRate", &tsTsdbMergeAdmitRate},
+                                         {"tsdbReadAhead", &tsTsdbReadAhead},
                                          {"s3MigrateIntervalSec", &tsS3MigrateIntervalSec},
                                          {"s3MigrateEnabled", &tsS3MigrateEnabled},
                                          //{"s3BlockSize", &tsS3BlockSize},
@@ -1841,6 +1916,7 @@ static int32_t taosCfgDynamicOptionsForClient(SConfig *pCfg, const char *name) {
                                          {"queryPlannerTrace", &tsQueryPlannerTrace},
                                          {"queryNodeChunkSize", &tsQueryNodeChunkSize},
                                          {"queryUseNodeAllocator", &tsQueryUseNodeAllocator},
+                                         {"queryResultCompress", &tsQueryResultCompress},
                                          {"smlDot2Underline", &tsSmlDot2Underline},
                                          {"shellActivityTimer", &tsShellActivityTimer},
                                          {"slowLogThreshold", &tsSlowLogThreshold},
@@ -7145,6 +7145,7 @@ int32_t tSerializeSResFetchReq(void *buf, int32_t bufLen, SResFetchReq *pReq) {
   } else {
     if (tEncodeI32(&encoder, 0) < 0) return -1;
   }
+  if (tEncodeI8(&encoder, pReq->compressRes) < 0) return -1;
 
   tEndEncode(&encoder);
 
@@ -7184,6 +7185,9 @@ int32_t tDeserializeSResFetchReq(void *buf, int32_t bufLen, SResFetchReq *pReq)
     if (NULL == pReq->pOpParam) return -1;
     if (tDeserializeSOperatorParam(&decoder, pReq->pOpParam) < 0) return -1;
   }
+  if (!tDecodeIsEnd(&decoder)) {
+    if (tDecodeI8(&decoder, &pReq->compressRes) < 0) return -1;
+  }
 
   tEndDecode(&decoder);
 
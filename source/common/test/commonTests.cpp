@@ -408,6 +408,64 @@ TEST(testCase, var_dataBlock_split_test) {
   }
 }
 
+TEST(testCase, compress_dataBlock_test) {
+  int32_t numOfRows = 4096;
+
+  SSDataBlock* b = createDataBlock();
+
+  SColumnInfoData ts = createColumnInfoData(TSDB_DATA_TYPE_TIMESTAMP, 8, 1);
+  SColumnInfoData val = createColumnInfoData(TSDB_DATA_TYPE_DOUBLE, 8, 2);
+  SColumnInfoData flag = createColumnInfoData(TSDB_DATA_TYPE_BOOL, 1, 3);
+  SColumnInfoData name = createColumnInfoData(TSDB_DATA_TYPE_BINARY, 40, 4);
+  blockDataAppendColInfo(b, &ts);
+  blockDataAppendColInfo(b, &val);
+  blockDataAppendColInfo(b, &flag);
+  blockDataAppendColInfo(b, &name);
+  blockDataEnsureCapacity(b, numOfRows);
+
+  char buf[41] = {0};
+  for (int32_t i = 0; i < numOfRows; ++i) {
+    int64_t k = 1700000000000 + i * 1000;
+    double  v = i % 100 * 0.5;
+    bool    f = i % 2;
+    colDataSetVal((SColumnInfoData*)taosArrayGet(b->pDataBlock, 0), i, (const char*)&k, false);
+    if (i % 10 == 0) {
+      colDataSetNULL((SColumnInfoData*)taosArrayGet(b->pDataBlock, 1), i);
+      colDataSetNULL((SColumnInfoData*)taosArrayGet(b->pDataBlock, 2), i);
+      colDataSetNULL((SColumnInfoData*)taosArrayGet(b->pDataBlock, 3), i);
+    } else {
+      colDataSetVal((SColumnInfoData*)taosArrayGet(b->pDataBlock, 1), i, (const char*)&v, false);
+      colDataSetVal((SColumnInfoData*)taosArrayGet(b->pDataBlock, 2), i, (const char*)&f, false);
+      int32_t len = sprintf(varDataVal(buf), "device_%d", i % 16);
+      varDataSetLen(buf, len);
+      colDataSetVal((SColumnInfoData*)taosArrayGet(b->pDataBlock, 3), i, buf, false);
+    }
+    b->info.rows++;
+  }
+
+  char*   pEncoded = (char*)taosMemoryCalloc(1, blockGetEncodeSize(b));
+  int32_t len = blockEncode(b, pEncoded, 4);
+
+  int32_t capacity = blockCompressBufSize(len, 4);
+  char*   pCompressed = (char*)taosMemoryCalloc(1, capacity);
+  int32_t compLen = blockCompressEncoded(pEncoded, pCompressed, capacity);
+  ASSERT_GT(compLen, 0);
+  ASSERT_LE(compLen, capacity);
+  ASSERT_LT(compLen, len);
+  ASSERT_TRUE(blockIsEncodedCompressed(pCompressed));
+  ASSERT_FALSE(blockIsEncodedCompressed(pEncoded));
+  ASSERT_EQ(blockGetDecompressedSize(pCompressed), len);
+
+  char* pDecompressed = (char*)taosMemoryCalloc(1, len);
+  ASSERT_EQ(blockDecompressEncoded(pCompressed, pDecompressed, len), len);
+  ASSERT_EQ(memcmp(pEncoded, pDecompressed, len), 0);
+
+  taosMemoryFree(pDecompressed);
+  taosMemoryFree(pCompressed);
+  taosMemoryFree(pEncoded);
+  blockDataDestroy(b);
+}
+
 void check_tm(const STm* tm, int32_t y, int32_t mon, int32_t d, int32_t h, int32_t m, int32_t s, int64_t fsec) {
   ASSERT_EQ(tm->tm.tm_year, y);
   ASSERT_EQ(tm->tm.tm_mon, mon);
@@ -51,7 +51,8 @@ int32_t dmProcessNodeMsg(SMgmtWrapper *pWrapper, SRpcMsg *pMsg) {
 
 static bool dmFailFastFp(tmsg_t msgType) {
   // add more msg type later
-  return msgType == TDMT_SYNC_HEARTBEAT || msgType == TDMT_SYNC_APPEND_ENTRIES;
+  return msgType == TDMT_SYNC_HEARTBEAT || msgType == TDMT_SYNC_APPEND_ENTRIES ||
+         msgType == TDMT_SYNC_APPEND_ENTRIES_BATCH;
 }
 
 static void dmConvertErrCode(tmsg_t msgType) {
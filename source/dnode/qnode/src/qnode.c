@@ -25,7 +25,14 @@ SQnode *qndOpen(const SQnodeOpt *pOption) {
     return NULL;
   }
 
+  // a dnode without vnodes starts the sort threads of the executor here
+  if (qExecutorInit() != 0) {
+    taosMemoryFreeClear(pQnode);
+    return NULL;
+  }
+
   if (qWorkerInit(NODE_TYPE_QNODE, pQnode->qndId, (void **)&pQnode->pQuery, &pOption->msgCb)) {
+    qExecutorCleanup();
     taosMemoryFreeClear(pQnode);
     return NULL;
   }
@@ -36,6 +43,7 @@ SQnode *qndOpen(const SQnodeOpt *pOption) {
 
 void qndClose(SQnode *pQnode) {
   qWorkerDestroy((void **)&pQnode->pQuery);
+  qExecutorCleanup();
   taosMemoryFree(pQnode);
 }
 
@@ -27,6 +27,7 @@ extern "C" {
 typedef struct SMetaIdx   SMetaIdx;
 typedef struct SMetaDB    SMetaDB;
 typedef struct SMetaCache SMetaCache;
+typedef struct SMetaTagStore SMetaTagStore;
 
 // metaDebug ==================
 // clang-format off
@@ -74,6 +75,15 @@ int32_t metaStatsCacheGet(SMeta* pMeta, int64_t uid, SMetaStbStats* pInfo);
 void    metaUpdateStbStats(SMeta* pMeta, int64_t uid, int64_t deltaCtb, int32_t deltaCol);
 int32_t metaUidFilterCacheGet(SMeta* pMeta, uint64_t suid, const void* pKey, int32_t keyLen, LRUHandle** pHandle);
 
+// columnar tag store of a super table, the rows of child tables not in the store are appended to pMissRows
+SMetaTagStore* metaTagStoreCreate(const SSchemaWrapper* pTagSchema);
+void           metaTagStoreDestroy(SMetaTagStore* pStore);
+int32_t        metaTagStorePutRow(SMetaTagStore* pStore, tb_uid_t uid, const STag* pTag);
+void           metaTagStoreRemoveRow(SMetaTagStore* pStore, tb_uid_t uid);
+int32_t        metaTagStoreFillBlock(SMetaTagStore* pStore, SArray* pUidTagInfo, SSDataBlock* pBlock, SArray* pMissRows,
+                                     bool* acquired);
+int64_t        metaTagStoreMemSize(const SMetaTagStore* pStore);
+
 struct SMeta {
   TdThreadRwlock lock;
 
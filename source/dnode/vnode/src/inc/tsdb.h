@@ -175,6 +175,8 @@ void    tBlockDataDestroy(SBlockData *pBlockData);
 int32_t tBlockDataInit(SBlockData *pBlockData, TABLEID *pId, STSchema *pTSchema, int16_t *aCid, int32_t nCid);
 void    tBlockDataReset(SBlockData *pBlockData);
 int32_t tBlockDataAppendRow(SBlockData *pBlockData, TSDBROW *pRow, STSchema *pTSchema, int64_t uid);
+int32_t tBlockDataAppendBlockRows(SBlockData *pBlockData, SBlockData *pBlockDataFrom, int32_t iRow, int32_t nRow,
+                                  int64_t uid);
 int32_t tBlockDataUpdateRow(SBlockData *pBlockData, TSDBROW *pRow, STSchema *pTSchema);
 int32_t tBlockDataTryUpsertRow(SBlockData *pBlockData, TSDBROW *pRow, int64_t uid);
 int32_t tBlockDataUpsertRow(SBlockData *pBlockData, TSDBROW *pRow, STSchema *pTSchema, int64_t uid);
@@ -217,6 +219,10 @@ int32_t tsdbFidLevel(int32_t fid, STsdbKeepCfg *pKeepCfg, int64_t nowSec);
 int32_t tsdbBuildDeleteSkyline(SArray *aDelData, int32_t sidx, int32_t eidx, SArray *aSkyline);
 int32_t tPutColumnDataAgg(SBuffer *buffer, SColumnDataAgg *pColAgg);
 int32_t tGetColumnDataAgg(SBufferReader *br, SColumnDataAgg *pColAgg);
+bool    tColDataBloomSupported(int8_t type);
+int32_t tPutColumnDataBloom(SBuffer *buffer, SColData *pColData);
+int32_t tGetColumnDataBloom(SBufferReader *br, SColumnDataBloom *pColBloom);
+void    tColumnDataBloomClear(void *pColBloom);
 int32_t tRowInfoCmprFn(const void *p1, const void *p2);
 // tsdbMemTable ==============================================================================================
 // SMemTable
@@ -226,6 +232,7 @@ STbData *tsdbGetTbDataFromMemTable(SMemTable *pMemTable, tb_uid_t suid, tb_uid_t
 int32_t  tsdbRefMemTable(SMemTable *pMemTable, SQueryNode *pQNode);
 int32_t  tsdbUnrefMemTable(SMemTable *pMemTable, SQueryNode *pNode, bool proactive);
 SArray * tsdbMemTableGetTbDataArray(SMemTable *pMemTable);
+int32_t  tsdbMemTableGetTSchema(SMemTable *pMemTable, tb_uid_t suid, tb_uid_t uid, int32_t sver, STSchema **ppTSchema);
 // STbDataIter
 int32_t tsdbTbDataIterCreate(STbData *pTbData, STsdbRowKey *pFrom, int8_t backward, STbDataIter **ppIter);
 void *  tsdbTbDataIterDestroy(STbDataIter *pIter);
@@ -286,6 +293,8 @@ typedef struct {
 } SMergeArg;
 
 int32_t tsdbMerge(void *arg);
+void    tsdbMergeAdmitCharge(int64_t size, int64_t nowUs);
+int64_t tsdbMergeAdmitDelay(int64_t nowUs);
 
 // tsdbDataIter.c ==============================================================================================
 #define TSDB_MEM_TABLE_DATA_ITER 0
@@ -374,6 +383,14 @@ typedef struct SMemSkipList {
   SMemSkipListNode *pTail;
 } SMemSkipList;
 
+// append-only tail of the rows with increasing keys, kept column by column without skiplist nodes
+typedef struct SMemTailChunk SMemTailChunk;
+typedef struct SMemTail {
+  int64_t        size;
+  SMemTailChunk *pHead;
+  SMemTailChunk *pTail;
+} SMemTail;
+
 struct STbData {
   tb_uid_t     suid;
   tb_uid_t     uid;
@@ -383,6 +400,7 @@ struct STbData {
   SDelData *   pHead;
   SDelData *   pTail;
   SMemSkipList sl;
+  SMemTail     tail;
   STbData *    next;
   SRBTreeNode  rbtn[1];
 };
@@ -402,8 +420,16 @@ struct SMemTable {
   int32_t          nBucket;
   STbData **       aBucket;
   SRBTree          tbDataTree[1];
+  SRWLatch         skmLatch;
+  SSHashObj *      pSkmCache;  // SMemSkmKey -> STSchema * in the buffer pool, schemas of the tail chunks
 };
 
+typedef struct SMemSkmKey {
+  tb_uid_t uid;  // suid of a child table, uid of a normal table
+  int32_t  sver;
+  int32_t  reserved;
+} SMemSkmKey;
+
 struct TSDBROW {
   int8_t type;  // TSDBROW_ROW_FMT for row from tsRow, TSDBROW_COL_FMT for row from block data
   union {
@@ -522,10 +548,24 @@ struct TABLEID {
   tb_uid_t uid;
 };
 
+// the columns of a chunk hold capacity rows each, the rows not written yet read as none
+struct SMemTailChunk {
+  SMemTailChunk *prev;
+  SMemTailChunk *next;
+  int32_t        capacity;
+  int32_t        nRow;      // rows published to readers
+  STSchema *     pTSchema;  // schema of the rows, in the buffer pool
+  int32_t *      aVarCap;   // size of the var data area of each column
+  SBlockData     bData;
+};
+
 struct STbDataIter {
   STbData *         pTbData;
   int8_t            backward;
   SMemSkipListNode *pNode;
+  SMemTailChunk *   pChunk;  // cursor in the tail
+  int32_t           iRow;
+  int8_t            fromTail;  // current row comes from the tail
   TSDBROW *         pRow;
   TSDBROW           row;
 };
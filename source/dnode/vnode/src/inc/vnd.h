@@ -68,12 +68,14 @@ int32_t vnodeAsync(SVAsync* async, EVAPriority priority, int32_t (*execute)(void
                    int64_t* taskId);
 int32_t vnodeAsyncC(SVAsync* async, int64_t channelId, EVAPriority priority, int32_t (*execute)(void*),
                     void (*complete)(void*), void* arg, int64_t* taskId);
+int32_t vnodeAsyncCDelay(SVAsync* async, int64_t channelId, EVAPriority priority, int64_t delayMs,
+                         int32_t (*execute)(void*), void (*complete)(void*), void* arg, int64_t* taskId);
 int32_t vnodeAWait(SVAsync* async, int64_t taskId);
 int32_t vnodeACancel(SVAsync* async, int64_t taskId);
 int32_t vnodeAsyncSetWorkers(SVAsync* async, int32_t numWorkers);
 
 // vnodeModule.c
-extern SVAsync* vnodeAsyncHandle[2];
+extern SVAsync* vnodeAsyncHandle[4];
 
 // vnodeBufPool.c
 typedef struct SVBufPoolNode SVBufPoolNode;
@@ -133,6 +135,10 @@ int32_t vnodeSyncCommit(SVnode* pVnode);
 int32_t vnodeAsyncCommit(SVnode* pVnode);
 bool    vnodeShouldRollback(SVnode* pVnode);
 
+// vnodeSvr.c
+int32_t vnodeInsertSubmitTbDataParallel(STsdb* pTsdb, int64_t ver, SArray* aSubmitTbData, int32_t nShard,
+                                        int32_t* affectedRows);
+
 // vnodeSync.c
 int64_t vnodeClusterId(SVnode* pVnode);
 int32_t vnodeNodeId(SVnode* pVnode);
@@ -144,6 +150,7 @@ void    vnodeSyncClose(SVnode* pVnode);
 void    vnodeRedirectRpcMsg(SVnode* pVnode, SRpcMsg* pMsg, int32_t code);
 bool    vnodeIsLeader(SVnode* pVnode);
 bool    vnodeIsRoleLeader(SVnode* pVnode);
+int32_t vnodeSyncWaitReadIndex(SVnode* pVnode);
 
 #ifdef __cplusplus
 }
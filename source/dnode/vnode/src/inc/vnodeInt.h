@@ -188,6 +188,9 @@ int             metaAlterCache(SMeta* pMeta, int32_t nPage);
 
 int32_t metaUidCacheClear(SMeta* pMeta, uint64_t suid);
 int32_t metaTbGroupCacheClear(SMeta* pMeta, uint64_t suid);
+int32_t metaTagStorePut(SMeta* pMeta, uint64_t suid, tb_uid_t uid, const STag* pTag);
+void    metaTagStoreDel(SMeta* pMeta, uint64_t suid, tb_uid_t uid);
+void    metaTagStoreClear(SMeta* pMeta, uint64_t suid);
 
 int metaAddIndexToSTable(SMeta* pMeta, int64_t version, SVCreateStbReq* pReq);
 int metaDropIndexFromSTable(SMeta* pMeta, int64_t version, SDropIndexReq* pReq);
@@ -243,6 +246,7 @@ int32_t tsdbS3Migrate(STsdb* tsdb, int64_t now, int32_t sync);
 int     tsdbScanAndConvertSubmitMsg(STsdb* pTsdb, SSubmitReq2* pMsg);
 int     tsdbInsertData(STsdb* pTsdb, int64_t version, SSubmitReq2* pMsg, SSubmitRsp2* pRsp);
 int32_t tsdbInsertTableData(STsdb* pTsdb, int64_t version, SSubmitTbData* pSubmitTbData, int32_t* affectedRows);
+int32_t tsdbPrepareTableData(STsdb* pTsdb, tb_uid_t suid, tb_uid_t uid);
 int32_t tsdbDeleteTableData(STsdb* pTsdb, int64_t version, tb_uid_t suid, tb_uid_t uid, TSKEY sKey, TSKEY eKey);
 int32_t tsdbSetKeepCfg(STsdb* pTsdb, STsdbCfg* pCfg);
 
@@ -505,6 +509,9 @@ struct SVnode {
   bool          blocked;
   bool          restored;
   tsem_t        syncSem;
+  TdThreadMutex applyMutex;
+  TdThreadCond  applyCond;  // signaled on apply while followers wait for a read index
+  int32_t       applyWaiters;
   int32_t       blockSec;
   int64_t       blockSeq;
   SQHandle*     pQuery;
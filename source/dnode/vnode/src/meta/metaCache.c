@@ -25,6 +25,13 @@ extern const int   tkAuditStbNum;
 #define META_CACHE_BASE_BUCKET  1024
 #define META_CACHE_STATS_BUCKET 16
 
+// the columnar tag store is only built for super tables with at least this number of child tables
+#define META_TAG_STORE_MIN_TABLES 1000
+// the memory of the tag stores of a vnode, a store not fitting in is built for the query and released afterwards
+#define META_TAG_STORE_MAX_SIZE (64 * 1024 * 1024)
+// estimated bytes of the uid array and uid index per row
+#define META_TAG_STORE_ROW_SIZE (sizeof(tb_uid_t) * 2 + sizeof(int32_t) + 16)
+
 // (uid , suid) : child table
 // (uid,     0) : normal table
 // (suid, suid) : super table
@@ -44,6 +51,26 @@ typedef struct STagFilterResEntry {
   uint32_t hitTimes;  // queried times for current super table
 } STagFilterResEntry;
 
+// one tag column of the columnar tag store, var type values are dictionary encoded
+typedef struct SMetaTagCol {
+  col_id_t  cid;
+  int8_t    type;
+  SArray*   pVals;      // int64_t, the tag value or the dictionary code of var type tags
+  SArray*   pNulls;     // int8_t
+  SArray*   pDict;      // char*, distinct values of var type tags in varstr format
+  SHashObj* pDictIdx;   // value -> dictionary code
+  int32_t   emptyCode;  // dictionary code of the empty string, -1 if not exists
+} SMetaTagCol;
+
+// tags of all child tables of a super table, row i is the child table pUids[i]
+struct SMetaTagStore {
+  SArray*      pUids;    // tb_uid_t
+  SHashObj*    pUidIdx;  // uid -> row
+  int32_t      nCols;
+  SMetaTagCol* pCols;
+  int64_t      memSize;  // estimated, not reduced by removed rows
+};
+
 struct SMetaCache {
   // child, normal, super, table entry cache
   struct SEntryCache {
@@ -78,6 +105,13 @@ struct SMetaCache {
     SHashObj* pStb;
     SHashObj* pStbName;
   } STbFilterCache;
+
+  // columnar tag store, built on the first tag query of a super table
+  struct STagStoreCache {
+    TdThreadMutex lock;
+    SHashObj*     pStb;     // suid -> SMetaTagStore*
+    int64_t       memSize;  // of all stores in pStb
+  } sTagStore;
 };
 
 static void entryCacheClose(SMeta* pMeta) {
@@ -116,6 +150,8 @@ static void freeCacheEntryFp(void* param) {
   taosMemoryFreeClear(*p);
 }
 
+static void freeTagStoreFp(void* param) { metaTagStoreDestroy(*(SMetaTagStore**)param); }
+
 int32_t metaCacheOpen(SMeta* pMeta) {
   int32_t     code = 0;
   SMetaCache* pCache = NULL;
@@ -193,6 +229,15 @@ int32_t metaCacheOpen(SMeta* pMeta) {
     goto _err2;
   }
 
+  pCache->sTagStore.pStb = taosHashInit(16, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BIGINT), false, HASH_NO_LOCK);
+  if (pCache->sTagStore.pStb == NULL) {
+    code = TSDB_CODE_OUT_OF_MEMORY;
+    goto _err2;
+  }
+
+  taosHashSetFreeFp(pCache->sTagStore.pStb, freeTagStoreFp);
+  taosThreadMutexInit(&pCache->sTagStore.lock, NULL);
+
   pMeta->pCache = pCache;
   return code;
 
@@ -221,6 +266,9 @@ void metaCacheClose(SMeta* pMeta) {
     taosHashCleanup(pMeta->pCache->STbFilterCache.pStb);
     taosHashCleanup(pMeta->pCache->STbFilterCache.pStbName);
 
+    taosThreadMutexDestroy(&pMeta->pCache->sTagStore.lock);
+    taosHashCleanup(pMeta->pCache->sTagStore.pStb);
+
     taosMemoryFree(pMeta->pCache);
     pMeta->pCache = NULL;
   }
@@ -965,3 +1013,493 @@ int32_t metaInitTbFilterCache(SMeta* pMeta) {
 #endif
   return 0;
 }
+
+void metaTagStoreDestroy(SMetaTagStore* pStore) {
+  if (pStore == NULL) {
+    return;
+  }
+
+  for (int32_t i = 0; i < pStore->nCols; ++i) {
+    SMetaTagCol* pCol = &pStore->pCols[i];
+    taosArrayDestroy(pCol->pVals);
+    taosArrayDestroy(pCol->pNulls);
+    taosArrayDestroyP(pCol->pDict, taosMemoryFree);
+    taosHashCleanup(pCol->pDictIdx);
+  }
+
+  taosMemoryFree(pStore->pCols);
+  taosArrayDestroy(pStore->pUids);
+  taosHashCleanup(pStore->pUidIdx);
+  taosMemoryFree(pStore);
+}
+
+SMetaTagStore* metaTagStoreCreate(const SSchemaWrapper* pTagSchema) {
+  SMetaTagStore* pStore = taosMemoryCalloc(1, sizeof(SMetaTagStore));
+  if (pStore == NULL) {
+    return NULL;
+  }
+
+  pStore->nCols = pTagSchema->nCols;
+  pStore->pCols = taosMemoryCalloc(pStore->nCols, sizeof(SMetaTagCol));
+  pStore->pUids = taosArrayInit(1024, sizeof(tb_uid_t));
+  pStore->pUidIdx = taosHashInit(1024, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BIGINT), false, HASH_NO_LOCK);
+  if (pStore->pCols == NULL || pStore->pUids == NULL || pStore->pUidIdx == NULL) {
+    goto _err;
+  }
+
+  for (int32_t i = 0; i < pStore->nCols; ++i) {
+    SMetaTagCol* pCol = &pStore->pCols[i];
+    pCol->cid = pTagSchema->pSchema[i].colId;
+    pCol->type = pTagSchema->pSchema[i].type;
+    pCol->emptyCode = -1;
+    pCol->pVals = taosArrayInit(1024, sizeof(int64_t));
+    pCol->pNulls = taosArrayInit(1024, sizeof(int8_t));
+    if (pCol->pVals == NULL || pCol->pNulls == NULL) {
+      goto _err;
+    }
+
+    if (IS_VAR_DATA_TYPE(pCol->type)) {
+      pCol->pDict = taosArrayInit(64, POINTER_BYTES);
+      pCol->pDictIdx = taosHashInit(64, taosGetDefaultHashFunction(TSDB_DATA_TYPE_VARCHAR), false, HASH_NO_LOCK);
+      if (pCol->pDict == NULL || pCol->pDictIdx == NULL) {
+        goto _err;
+      }
+    }
+  }
+
+  return pStore;
+
+_err:
+  metaTagStoreDestroy(pStore);
+  return NULL;
+}
+
+int64_t metaTagStoreMemSize(const SMetaTagStore* pStore) { return pStore->memSize; }
+
+static int32_t tagColDictEncode(SMetaTagStore* pStore, SMetaTagCol* pCol, const STagVal* pTagVal, int64_t* pCode) {
+  int32_t* pExist = NULL;
+  if (pTagVal->nData == 0) {
+    pExist = (pCol->emptyCode >= 0) ? &pCol->emptyCode : NULL;
+  } else {
+    pExist = taosHashGet(pCol->pDictIdx, pTagVal->pData, pTagVal->nData);
+  }
+
+  if (pExist != NULL) {
+    *pCode = *pExist;
+    return TSDB_CODE_SUCCESS;
+  }
+
+  int32_t code = taosArrayGetSize(pCol->pDict);
+  char*   p = taosMemoryMalloc(pTagVal->nData + VARSTR_HEADER_SIZE);
+  if (p == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  varDataSetLen(p, pTagVal->nData);
+  memcpy(varDataVal(p), pTagVal->pData, pTagVal->nData);
+  if (taosArrayPush(pCol->pDict, &p) == NULL) {
+    taosMemoryFree(p);
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  if (pTagVal->nData == 0) {
+    pCol->emptyCode = code;
+  } else if (taosHashPut(pCol->pDictIdx, pTagVal->pData, pTagVal->nData, &code, sizeof(int32_t)) != 0) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  // the value in the dictionary and the key of the dictionary index
+  pStore->memSize += pTagVal->nData * 2 + VARSTR_HEADER_SIZE + POINTER_BYTES + sizeof(int32_t);
+
+  *pCode = code;
+  return TSDB_CODE_SUCCESS;
+}
+
+// set the tags of a child table into the given row, a new row is appended if row equals the number of rows.
+// Values no longer referenced stay in the dictionary until the store is rebuilt.
+static int32_t tagStoreSetRow(SMetaTagStore* pStore, int32_t row, const STag* pTag) {
+  bool append = (row == taosArrayGetSize(pStore->pUids));
+
+  for (int32_t i = 0; i < pStore->nCols; ++i) {
+    SMetaTagCol* pCol = &pStore->pCols[i];
+    STagVal      tagVal = {.cid = pCol->cid};
+    int8_t       isNull = !tTagGet(pTag, &tagVal);
+    int64_t      val = 0;
+
+    if (!isNull) {
+      if (IS_VAR_DATA_TYPE(pCol->type)) {
+        int32_t code = tagColDictEncode(pStore, pCol, &tagVal, &val);
+        if (code != TSDB_CODE_SUCCESS) {
+          return code;
+        }
+      } else {
+        val = tagVal.i64;
+      }
+    }
+
+    if (append) {
+      if (taosArrayPush(pCol->pVals, &val) == NULL || taosArrayPush(pCol->pNulls, &isNull) == NULL) {
+        return TSDB_CODE_OUT_OF_MEMORY;
+      }
+    } else {
+      taosArraySet(pCol->pVals, row, &val);
+      taosArraySet(pCol->pNulls, row, &isNull);
+    }
+  }
+
+  return TSDB_CODE_SUCCESS;
+}
+
+int32_t metaTagStorePutRow(SMetaTagStore* pStore, tb_uid_t uid, const STag* pTag) {
+  int32_t* pRow = taosHashGet(pStore->pUidIdx, &uid, sizeof(uid));
+  int32_t  row = (pRow != NULL) ? *pRow : (int32_t)taosArrayGetSize(pStore->pUids);
+
+  int32_t code = tagStoreSetRow(pStore, row, pTag);
+  if (code != TSDB_CODE_SUCCESS || pRow != NULL) {
+    return code;
+  }
+
+  if (taosArrayPush(pStore->pUids, &uid) == NULL ||
+      taosHashPut(pStore->pUidIdx, &uid, sizeof(uid), &row, sizeof(row)) != 0) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  pStore->memSize += META_TAG_STORE_ROW_SIZE + pStore->nCols * (sizeof(int64_t) + sizeof(int8_t));
+  return TSDB_CODE_SUCCESS;
+}
+
+// move the last row into the removed one, so that rows stay dense
+void metaTagStoreRemoveRow(SMetaTagStore* pStore, tb_uid_t uid) {
+  int32_t* pRow = taosHashGet(pStore->pUidIdx, &uid, sizeof(uid));
+  if (pRow == NULL) {
+    return;
+  }
+
+  int32_t row = *pRow;
+  int32_t last = taosArrayGetSize(pStore->pUids) - 1;
+  if (row != last) {
+    tb_uid_t lastUid = *(tb_uid_t*)taosArrayGet(pStore->pUids, last);
+    taosArraySet(pStore->pUids, row, &lastUid);
+    for (int32_t i = 0; i < pStore->nCols; ++i) {
+      SMetaTagCol* pCol = &pStore->pCols[i];
+      taosArraySet(pCol->pVals, row, taosArrayGet(pCol->pVals, last));
+      taosArraySet(pCol->pNulls, row, taosArrayGet(pCol->pNulls, last));
+    }
+    taosHashPut(pStore->pUidIdx, &lastUid, sizeof(lastUid), &row, sizeof(row));
+  }
+
+  taosArrayPop(pStore->pUids);
+  for (int32_t i = 0; i < pStore->nCols; ++i) {
+    taosArrayPop(pStore->pCols[i].pVals);
+    taosArrayPop(pStore->pCols[i].pNulls);
+  }
+
+  taosHashRemove(pStore->pUidIdx, &uid, sizeof(uid));
+}
+
+// load the tags of all child tables from ctb.idx, the caller holds the meta read lock
+static SMetaTagStore* tagStoreBuild(SMeta* pMeta, tb_uid_t suid) {
+  SMetaTagStore* pStore = NULL;
+  SMetaReader    mr = {0};
+
+  metaReaderDoInit(&mr, pMeta, META_READER_NOLOCK);
+  if (metaReaderGetTableEntryByUid(&mr, suid) != 0 || mr.me.type != TSDB_SUPER_TABLE) {
+    metaReaderClear(&mr);
+    return NULL;
+  }
+
+  // json tags are not dictionary encoded, filter them with the row tags instead
+  SSchemaWrapper* pTagSchema = &mr.me.stbEntry.schemaTag;
+  if (pTagSchema->nCols == 1 && pTagSchema->pSchema[0].type == TSDB_DATA_TYPE_JSON) {
+    metaReaderClear(&mr);
+    return NULL;
+  }
+
+  pStore = metaTagStoreCreate(pTagSchema);
+  metaReaderClear(&mr);
+  if (pStore == NULL) {
+    return NULL;
+  }
+
+  SMCtbCursor* pCur = metaOpenCtbCursor(pMeta->pVnode, suid, 0);
+  if (pCur == NULL) {
+    metaTagStoreDestroy(pStore);
+    return NULL;
+  }
+
+  while (1) {
+    tb_uid_t uid = metaCtbCursorNext(pCur);
+    if (uid == 0) {
+      break;
+    }
+
+    if (metaTagStorePutRow(pStore, uid, pCur->pVal) != TSDB_CODE_SUCCESS) {
+      metaTagStoreDestroy(pStore);
+      pStore = NULL;
+      break;
+    }
+  }
+
+  metaCloseCtbCursor(pCur);
+  return pStore;
+}
+
+int32_t metaTagStoreFillBlock(SMetaTagStore* pStore, SArray* pUidTagInfo, SSDataBlock* pBlock, SArray* pMissRows,
+                              bool* acquired) {
+  int32_t       code = TSDB_CODE_SUCCESS;
+  int32_t       numOfCols = taosArrayGetSize(pBlock->pDataBlock);
+  bool          all = (taosArrayGetSize(pUidTagInfo) == 0);
+  int32_t       rows = all ? taosArrayGetSize(pStore->pUids) : taosArrayGetSize(pUidTagInfo);
+  int32_t*      pRowIdx = NULL;
+  SMetaTagCol** pCols = taosMemoryCalloc(numOfCols, POINTER_BYTES);
+  if (pCols == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  for (int32_t j = 0; j < numOfCols; ++j) {
+    SColumnInfoData* pColInfo = taosArrayGet(pBlock->pDataBlock, j);
+    for (int32_t k = 0; k < pStore->nCols; ++k) {
+      if (pStore->pCols[k].cid == pColInfo->info.colId && pStore->pCols[k].type == pColInfo->info.type) {
+        pCols[j] = &pStore->pCols[k];
+        break;
+      }
+    }
+
+    // not a tag of current schema, let the caller decode the row tags
+    if (pCols[j] == NULL) {
+      goto _end;
+    }
+  }
+
+  if (!all) {
+    pRowIdx = taosMemoryMalloc(rows * sizeof(int32_t));
+    if (pRowIdx == NULL) {
+      code = TSDB_CODE_OUT_OF_MEMORY;
+      goto _end;
+    }
+
+    for (int32_t i = 0; i < rows; ++i) {
+      STUidTagInfo* pInfo = taosArrayGet(pUidTagInfo, i);
+      int32_t*      pRow = taosHashGet(pStore->pUidIdx, &pInfo->uid, sizeof(pInfo->uid));
+      pRowIdx[i] = (pRow != NULL) ? *pRow : -1;
+      if (pRow == NULL && pMissRows != NULL && taosArrayPush(pMissRows, &i) == NULL) {
+        code = TSDB_CODE_OUT_OF_MEMORY;
+        goto _end;
+      }
+    }
+  }
+
+  code = blockDataEnsureCapacity(pBlock, rows);
+  if (code != TSDB_CODE_SUCCESS) {
+    goto _end;
+  }
+
+  for (int32_t j = 0; j < numOfCols; ++j) {
+    SColumnInfoData* pColInfo = taosArrayGet(pBlock->pDataBlock, j);
+    SMetaTagCol*     pCol = pCols[j];
+    const int64_t*   pVals = TARRAY_DATA(pCol->pVals);
+    const int8_t*    pNulls = TARRAY_DATA(pCol->pNulls);
+    bool             isVar = IS_VAR_DATA_TYPE(pCol->type);
+
+    for (int32_t i = 0; i < rows; ++i) {
+      int32_t r = all ? i : pRowIdx[i];
+      if (r < 0 || pNulls[r]) {
+        colDataSetNULL(pColInfo, i);
+        continue;
+      }
+
+      const char* p = isVar ? taosArrayGetP(pCol->pDict, pVals[r]) : (const char*)&pVals[r];
+      code = colDataSetVal(pColInfo, i, p, false);
+      if (code != TSDB_CODE_SUCCESS) {
+        goto _end;
+      }
+    }
+  }
+
+  if (all) {
+    taosArrayEnsureCap(pUidTagInfo, rows);
+    for (int32_t i = 0; i < rows; ++i) {
+      STUidTagInfo info = {.uid = *(tb_uid_t*)taosArrayGet(pStore->pUids, i)};
+      taosArrayPush(pUidTagInfo, &info);
+    }
+  }
+
+  pBlock->info.rows = rows;
+  *acquired = true;
+
+_end:
+  taosMemoryFree(pRowIdx);
+  taosMemoryFree(pCols);
+  return code;
+}
+
+// the tables created after the store was built by another query are not in it, read their tags from ctb.idx
+static int32_t tagStoreFillMissRows(SMeta* pMeta, uint64_t suid, SArray* pUidTagInfo, SSDataBlock* pBlock,
+                                    SArray* pMissRows) {
+  int32_t code = TSDB_CODE_SUCCESS;
+  int32_t numOfCols = taosArrayGetSize(pBlock->pDataBlock);
+
+  for (int32_t i = 0; i < taosArrayGetSize(pMissRows); ++i) {
+    int32_t       row = *(int32_t*)taosArrayGet(pMissRows, i);
+    STUidTagInfo* pInfo = taosArrayGet(pUidTagInfo, row);
+    SCtbIdxKey    ctbIdxKey = {.suid = suid, .uid = pInfo->uid};
+    void*         pTag = NULL;
+    int32_t       len = 0;
+
+    // the table is dropped, its tags stay null
+    if (tdbTbGet(pMeta->pCtbIdx, &ctbIdxKey, sizeof(ctbIdxKey), &pTag, &len) != 0) {
+      continue;
+    }
+
+    for (int32_t j = 0; j < numOfCols && code == TSDB_CODE_SUCCESS; ++j) {
+      SColumnInfoData* pColInfo = taosArrayGet(pBlock->pDataBlock, j);
+      STagVal          tagVal = {.cid = pColInfo->info.colId};
+      if (!tTagGet((const STag*)pTag, &tagVal)) {
+        continue;
+      }
+
+      if (IS_VAR_DATA_TYPE(pColInfo->info.type)) {
+        char* p = taosMemoryMalloc(tagVal.nData + VARSTR_HEADER_SIZE);
+        if (p == NULL) {
+          code = TSDB_CODE_OUT_OF_MEMORY;
+          break;
+        }
+        varDataSetLen(p, tagVal.nData);
+        memcpy(varDataVal(p), tagVal.pData, tagVal.nData);
+        code = colDataSetVal(pColInfo, row, p, false);
+        taosMemoryFree(p);
+      } else {
+        code = colDataSetVal(pColInfo, row, (const char*)&tagVal.i64, false);
+      }
+    }
+
+    tdbFree(pTag);
+    if (code != TSDB_CODE_SUCCESS) {
+      break;
+    }
+  }
+
+  return code;
+}
+
+static void tagStoreCacheRemove(SMetaCache* pCache, uint64_t suid) {
+  SMetaTagStore** ppStore = taosHashGet(pCache->sTagStore.pStb, &suid, sizeof(suid));
+  if (ppStore != NULL) {
+    pCache->sTagStore.memSize -= (*ppStore)->memSize;
+    taosHashRemove(pCache->sTagStore.pStb, &suid, sizeof(suid));
+  }
+}
+
+// fill the tags of the child tables into pBlock, of which the columns are the required tags. *acquired is false if
+// the tag store is not used, and the caller should decode the tags of each table instead.
+int32_t metaGetTableTagCols(void* pVnode, uint64_t suid, SArray* pUidTagInfo, SSDataBlock* pBlock, bool* acquired) {
+  SMeta*         pMeta = ((SVnode*)pVnode)->pMeta;
+  SMetaCache*    pCache = pMeta->pCache;
+  TdThreadMutex* pLock = &pCache->sTagStore.lock;
+  int32_t        code = TSDB_CODE_SUCCESS;
+  int64_t        numOfTables = 0;
+  SMetaTagStore* pBuilt = NULL;
+  SArray*        pMissRows = NULL;
+
+  *acquired = false;
+  metaGetStbStats(pVnode, suid, &numOfTables, NULL);
+  if (numOfTables < META_TAG_STORE_MIN_TABLES) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  pMissRows = taosArrayInit(4, sizeof(int32_t));
+  if (pMissRows == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  // the meta read lock keeps the writers, which update the stores, out until the block is filled
+  metaRLock(pMeta);
+
+  taosThreadMutexLock(pLock);
+  SMetaTagStore** ppStore = taosHashGet(pCache->sTagStore.pStb, &suid, sizeof(suid));
+  if (ppStore != NULL) {
+    code = metaTagStoreFillBlock(*ppStore, pUidTagInfo, pBlock, pMissRows, acquired);
+    taosThreadMutexUnlock(pLock);
+    goto _end;
+  }
+  taosThreadMutexUnlock(pLock);
+
+  // build without the store lock, so that the queries of other super tables are not blocked
+  int64_t st = taosGetTimestampUs();
+  pBuilt = tagStoreBuild(pMeta, suid);
+  if (pBuilt == NULL) {
+    goto _end;
+  }
+
+  metaDebug("vgId:%d, suid:%" PRIu64 " tag store built, tables:%d, size:%" PRId64 ", elapsed time:%.2f ms",
+            TD_VID(pMeta->pVnode), suid, (int32_t)taosArrayGetSize(pBuilt->pUids), pBuilt->memSize,
+            (taosGetTimestampUs() - st) / 1000.0);
+
+  taosThreadMutexLock(pLock);
+  ppStore = taosHashGet(pCache->sTagStore.pStb, &suid, sizeof(suid));
+  if (ppStore != NULL) {  // built by another query meanwhile
+    code = metaTagStoreFillBlock(*ppStore, pUidTagInfo, pBlock, pMissRows, acquired);
+  } else if (pCache->sTagStore.memSize + pBuilt->memSize <= META_TAG_STORE_MAX_SIZE &&
+             taosHashPut(pCache->sTagStore.pStb, &suid, sizeof(suid), &pBuilt, POINTER_BYTES) == 0) {
+    pCache->sTagStore.memSize += pBuilt->memSize;
+    code = metaTagStoreFillBlock(pBuilt, pUidTagInfo, pBlock, pMissRows, acquired);
+    pBuilt = NULL;
+  } else {
+    metaDebug("vgId:%d, suid:%" PRIu64 " tag store not kept, size:%" PRId64 ", total:%" PRId64,
+              TD_VID(pMeta->pVnode), suid, pBuilt->memSize, pCache->sTagStore.memSize);
+    code = metaTagStoreFillBlock(pBuilt, pUidTagInfo, pBlock, pMissRows, acquired);
+  }
+  taosThreadMutexUnlock(pLock);
+
+_end:
+  if (code == TSDB_CODE_SUCCESS && *acquired && taosArrayGetSize(pMissRows) > 0) {
+    code = tagStoreFillMissRows(pMeta, suid, pUidTagInfo, pBlock, pMissRows);
+  }
+
+  metaULock(pMeta);
+  metaTagStoreDestroy(pBuilt);
+  taosArrayDestroy(pMissRows);
+  return code;
+}
+
+// following functions are invoked with the meta write lock held
+int32_t metaTagStorePut(SMeta* pMeta, uint64_t suid, tb_uid_t uid, const STag* pTag) {
+  SMetaCache*    pCache = pMeta->pCache;
+  TdThreadMutex* pLock = &pCache->sTagStore.lock;
+  int32_t        code = TSDB_CODE_SUCCESS;
+
+  taosThreadMutexLock(pLock);
+  SMetaTagStore** ppStore = taosHashGet(pCache->sTagStore.pStb, &suid, sizeof(suid));
+  if (ppStore != NULL) {
+    int64_t size = (*ppStore)->memSize;
+    code = metaTagStorePutRow(*ppStore, uid, pTag);
+    pCache->sTagStore.memSize += (*ppStore)->memSize - size;
+
+    // the store is out of sync or too large, rebuild it on next query
+    if (code != TSDB_CODE_SUCCESS || pCache->sTagStore.memSize > META_TAG_STORE_MAX_SIZE) {
+      tagStoreCacheRemove(pCache, suid);
+    }
+  }
+  taosThreadMutexUnlock(pLock);
+
+  return code;
+}
+
+void metaTagStoreDel(SMeta* pMeta, uint64_t suid, tb_uid_t uid) {
+  TdThreadMutex* pLock = &pMeta->pCache->sTagStore.lock;
+
+  taosThreadMutexLock(pLock);
+  SMetaTagStore** ppStore = taosHashGet(pMeta->pCache->sTagStore.pStb, &suid, sizeof(suid));
+  if (ppStore != NULL) {
+    metaTagStoreRemoveRow(*ppStore, uid);
+  }
+  taosThreadMutexUnlock(pLock);
+}
+
+void metaTagStoreClear(SMeta* pMeta, uint64_t suid) {
+  TdThreadMutex* pLock = &pMeta->pCache->sTagStore.lock;
+
+  taosThreadMutexLock(pLock);
+  tagStoreCacheRemove(pMeta->pCache, suid);
+  taosThreadMutexUnlock(pLock);
+}
@@ -107,11 +107,36 @@ static int32_t tsdbCommitCloseWriter(SCommitter2 *committer) {
   return tsdbFSetWriterClose(&committer->writer, 0, committer->fopArray);
 }
 
+// the rows of one block in a row with increasing keys, as the rows of the memtable tail, are written in one run
+static bool tsdbCommitRunExtends(const SRowInfo *run, int32_t nRunRow, const SRowInfo *row) {
+  if (nRunRow == 0 || row->row.type != TSDBROW_COL_FMT || row->uid != run->uid ||
+      row->row.pBlockData != run->row.pBlockData || row->row.iRow != run->row.iRow + nRunRow) {
+    return false;
+  }
+
+  TSDBROW prev = tsdbRowFromBlockData(row->row.pBlockData, row->row.iRow - 1);
+  return tsdbRowCompareWithoutVersion(&prev, &row->row) < 0;
+}
+
+static int32_t tsdbCommitWriteRun(SCommitter2 *committer, SRowInfo *run, int32_t *nRunRow) {
+  int32_t code = 0;
+
+  if (*nRunRow == 1) {
+    code = tsdbFSetWriteRow(committer->writer, run);
+  } else if (*nRunRow > 1) {
+    code = tsdbFSetWriteBlockRows(committer->writer, run, *nRunRow);
+  }
+  *nRunRow = 0;
+  return code;
+}
+
 static int32_t tsdbCommitTSData(SCommitter2 *committer) {
   int32_t   code = 0;
   int32_t   lino = 0;
   int64_t   numOfRow = 0;
   SMetaInfo info;
+  SRowInfo  run[1] = {0};
+  int32_t   nRunRow = 0;
 
   committer->ctx->hasTSData = false;
 
@@ -141,13 +166,28 @@ static int32_t tsdbCommitTSData(SCommitter2 *committer) {
     committer->ctx->hasTSData = true;
     numOfRow++;
 
-    code = tsdbFSetWriteRow(committer->writer, row);
-    TSDB_CHECK_CODE(code, lino, _exit);
+    if (tsdbCommitRunExtends(run, nRunRow, row)) {
+      nRunRow++;
+    } else {
+      code = tsdbCommitWriteRun(committer, run, &nRunRow);
+      TSDB_CHECK_CODE(code, lino, _exit);
+
+      if (row->row.type == TSDBROW_COL_FMT) {
+        run[0] = *row;
+        nRunRow = 1;
+      } else {
+        code = tsdbFSetWriteRow(committer->writer, row);
+        TSDB_CHECK_CODE(code, lino, _exit);
+      }
+    }
 
     code = tsdbIterMergerNext(committer->dataIterMerger);
     TSDB_CHECK_CODE(code, lino, _exit);
   }
 
+  code = tsdbCommitWriteRun(committer, run, &nRunRow);
+  TSDB_CHECK_CODE(code, lino, _exit);
+
 _exit:
   if (code) {
     TSDB_ERROR_LOG(TD_VID(committer->tsdb->pVnode), lino, code);
@@ -16,6 +16,18 @@
 #include "tsdbDataFileRW.h"
 #include "meta.h"
 
+/*
+ * A .sma block holds the column aggs, optionally followed by the marker and the column bloom filters. Column ids
+ * start from 1, so the marker never collides with the column id that leads an agg.
+ */
+#define TSDB_SMA_BLOOM_MARKER 0
+
+static bool tsdbSmaAtBloomMarker(const SBufferReader *br) {
+  SBufferReader peek = *br;
+  int16_t       cid;
+  return tBufferGetI16v(&peek, &cid) == 0 && cid == TSDB_SMA_BLOOM_MARKER;
+}
+
 // SDataFileReader =============================================
 struct SDataFileReader {
   SDataFileReaderConfig config[1];
@@ -511,12 +523,13 @@ _exit:
 }
 
 int32_t tsdbDataFileReadBlockSma(SDataFileReader *reader, const SBrinRecord *record,
-                                 TColumnDataAggArray *columnDataAggArray) {
+                                 TColumnDataAggArray *columnDataAggArray, SBuffer *bloomBuffer) {
   int32_t  code = 0;
   int32_t  lino = 0;
   SBuffer *buffer = reader->buffers + 0;
 
-  TARRAY2_CLEAR(columnDataAggArray, NULL);
+  if (columnDataAggArray) TARRAY2_CLEAR(columnDataAggArray, NULL);
+  if (bloomBuffer) tBufferClear(bloomBuffer);
   if (record->smaSize > 0) {
     tBufferClear(buffer);
     int32_t encryptAlgorithm = reader->config->tsdb->pVnode->config.tsdbCfg.encryptAlgorithm;
@@ -527,16 +540,28 @@ int32_t tsdbDataFileReadBlockSma(SDataFileReader *reader, const SBrinRecord *rec
 
     // decode sma data
     SBufferReader br = BUFFER_READER_INITIALIZER(0, buffer);
-    while (br.offset < record->smaSize) {
+    while (br.offset < record->smaSize && !tsdbSmaAtBloomMarker(&br)) {
       SColumnDataAgg sma[1];
 
       code = tGetColumnDataAgg(&br, sma);
       TSDB_CHECK_CODE(code, lino, _exit);
 
-      code = TARRAY2_APPEND_PTR(columnDataAggArray, sma);
+      if (columnDataAggArray) {
+        code = TARRAY2_APPEND_PTR(columnDataAggArray, sma);
+        TSDB_CHECK_CODE(code, lino, _exit);
+      }
+    }
+    ASSERT(br.offset <= record->smaSize);
+
+    // keep the encoded bloom filters behind the marker, they are only decoded when a filter probes them
+    if (bloomBuffer && br.offset < record->smaSize) {
+      int16_t marker;
+      code = tBufferGetI16v(&br, &marker);
+      TSDB_CHECK_CODE(code, lino, _exit);
+
+      code = tBufferPut(bloomBuffer, BR_PTR(&br), record->smaSize - br.offset);
       TSDB_CHECK_CODE(code, lino, _exit);
     }
-    ASSERT(br.offset == record->smaSize);
   }
 
 _exit:
@@ -546,6 +571,31 @@ _exit:
   return code;
 }
 
+int32_t tsdbDataFileDecodeBlockBloom(SBuffer *bloomBuffer, TColumnDataBloomArray *columnDataBloomArray) {
+  int32_t code = 0;
+
+  TARRAY2_CLEAR(columnDataBloomArray, tColumnDataBloomClear);
+
+  SBufferReader br = BUFFER_READER_INITIALIZER(0, bloomBuffer);
+  while (br.offset < bloomBuffer->size) {
+    SColumnDataBloom bloom[1];
+
+    code = tGetColumnDataBloom(&br, bloom);
+    if (code) break;
+
+    code = TARRAY2_APPEND_PTR(columnDataBloomArray, bloom);
+    if (code) {
+      tColumnDataBloomClear(bloom);
+      break;
+    }
+  }
+
+  if (code) {
+    TARRAY2_CLEAR(columnDataBloomArray, tColumnDataBloomClear);
+  }
+  return code;
+}
+
 int32_t tsdbDataFileReadTombBlk(SDataFileReader *reader, const TTombBlkArray **tombBlkArray) {
   int32_t code = 0;
   int32_t lino = 0;
@@ -1061,6 +1111,25 @@ static int32_t tsdbDataFileDoWriteBlockData(SDataFileWriter *writer, SBlockData
     code = tPutColumnDataAgg(&buffers[0], sma);
     TSDB_CHECK_CODE(code, lino, _exit);
   }
+  if (tsTsdbBloomFilter) {
+    bool hasBloom = false;
+    for (int32_t i = 0; i < bData->nColData; ++i) {
+      SColData *colData = bData->aColData + i;
+      if (colData->cid == PRIMARYKEY_TIMESTAMP_COL_ID || ((colData->flag & HAS_VALUE) == 0) ||
+          !tColDataBloomSupported(colData->type)) {
+        continue;
+      }
+
+      if (!hasBloom) {
+        code = tBufferPutI16v(&buffers[0], TSDB_SMA_BLOOM_MARKER);
+        TSDB_CHECK_CODE(code, lino, _exit);
+        hasBloom = true;
+      }
+
+      code = tPutColumnDataBloom(&buffers[0], colData);
+      TSDB_CHECK_CODE(code, lino, _exit);
+    }
+  }
   record->smaSize = buffers[0].size;
 
   if (record->smaSize > 0) {
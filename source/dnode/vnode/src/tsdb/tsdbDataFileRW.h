@@ -26,6 +26,7 @@ extern "C" {
 #endif
 
 typedef TARRAY2(SColumnDataAgg) TColumnDataAggArray;
+typedef TARRAY2(SColumnDataBloom) TColumnDataBloomArray;
 
 typedef struct {
   SFDataPtr brinBlkPtr[1];
@@ -61,7 +62,8 @@ int32_t tsdbDataFileReadBlockDataByColumn(SDataFileReader *reader, const SBrinRe
                                           STSchema *pTSchema, int16_t cids[], int32_t ncid);
 // .sma
 int32_t tsdbDataFileReadBlockSma(SDataFileReader *reader, const SBrinRecord *record,
-                                 TColumnDataAggArray *columnDataAggArray);
+                                 TColumnDataAggArray *columnDataAggArray, SBuffer *bloomBuffer);
+int32_t tsdbDataFileDecodeBlockBloom(SBuffer *bloomBuffer, TColumnDataBloomArray *columnDataBloomArray);
 // .tomb
 int32_t tsdbDataFileReadTombBlk(SDataFileReader *reader, const TTombBlkArray **tombBlkArray);
 int32_t tsdbDataFileReadTombBlock(SDataFileReader *reader, const STombBlk *tombBlk, STombBlock *tData);
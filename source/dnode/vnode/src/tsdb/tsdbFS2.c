@@ -782,6 +782,7 @@ int32_t tsdbDisableAndCancelAllBgTask(STsdb *pTsdb) {
       fset->bgTaskChannel = 0;
     }
     fset->mergeScheduled = false;
+    fset->mergeDeferTask = 0;
     tsdbFSSetBlockCommit(fset, false);
   }
 
@@ -919,6 +920,15 @@ int32_t tsdbFSEditCommit(STFileSystem *fs) {
 
       // bool    skipMerge = false;
       int32_t numFile = TARRAY2_SIZE(lvl->fobjArr);
+
+      // commits are about to wait on the merge, do not let it wait on the admission rate
+      if (numFile >= sttTrigger * BLOCK_COMMIT_FACTOR && VNODE_ASYNC_VALID_TASK_ID(fset->mergeDeferTask)) {
+        if (vnodeACancel(vnodeAsyncHandle[1], fset->mergeDeferTask) == 0) {
+          fset->mergeScheduled = false;
+        }
+        fset->mergeDeferTask = 0;
+      }
+
       if (numFile >= sttTrigger && (!fset->mergeScheduled)) {
         code = tsdbTFileSetOpenChannel(fset);
         TSDB_CHECK_CODE(code, lino, _exit);
@@ -932,8 +942,9 @@ int32_t tsdbFSEditCommit(STFileSystem *fs) {
         arg->tsdb = fs->tsdb;
         arg->fid = fset->fid;
 
-        code = vnodeAsyncC(vnodeAsyncHandle[1], fset->bgTaskChannel, EVA_PRIORITY_HIGH, tsdbMerge, taosMemoryFree, arg,
-                           NULL);
+        // merges that commits are about to wait on go first
+        EVAPriority priority = numFile >= sttTrigger * BLOCK_COMMIT_FACTOR ? EVA_PRIORITY_HIGH : EVA_PRIORITY_NORMAL;
+        code = vnodeAsyncC(vnodeAsyncHandle[1], fset->bgTaskChannel, priority, tsdbMerge, taosMemoryFree, arg, NULL);
         TSDB_CHECK_CODE(code, lino, _exit);
         fset->mergeScheduled = true;
       }
@@ -458,6 +458,7 @@ int32_t tsdbTFileSetInit(int32_t fid, STFileSet **fset) {
   // background task queue
   fset[0]->bgTaskChannel = 0;
   fset[0]->mergeScheduled = false;
+  fset[0]->mergeDeferTask = 0;
 
   // block commit variables
   taosThreadCondInit(&fset[0]->canCommit, NULL);
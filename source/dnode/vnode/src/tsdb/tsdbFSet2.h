@@ -93,6 +93,7 @@ struct STFileSet {
   // background task channel
   int64_t bgTaskChannel;
   bool    mergeScheduled;
+  int64_t mergeDeferTask;  // merge waiting on the admission rate
 
   // block commit variables
   TdThreadCond canCommit;
@@ -283,6 +283,29 @@ _exit:
   return code;
 }
 
+// nRow rows of one table in a block with increasing keys, from row->row on
+int32_t tsdbFSetWriteBlockRows(SFSetWriter *writer, SRowInfo *row, int32_t nRow) {
+  int32_t code = 0;
+  int32_t lino = 0;
+
+  if (writer->config->toSttOnly) {
+    code = tsdbSttFileWriteBlockRows(writer->sttWriter, row, nRow);
+    TSDB_CHECK_CODE(code, lino, _exit);
+  } else {
+    SRowInfo rowInfo = *row;
+    for (int32_t i = 0; i < nRow; i++, rowInfo.row.iRow++) {
+      code = tsdbFSetWriteRow(writer, &rowInfo);
+      TSDB_CHECK_CODE(code, lino, _exit);
+    }
+  }
+
+_exit:
+  if (code) {
+    TSDB_ERROR_LOG(TD_VID(writer->config->tsdb->pVnode), lino, code);
+  }
+  return code;
+}
+
 int32_t tsdbFSetWriteTombRecord(SFSetWriter *writer, const STombRecord *tombRecord) {
   int32_t code = 0;
   int32_t lino = 0;
@@ -31,7 +31,12 @@
 #define SL_MOVE_BACKWARD 0x1
 #define SL_MOVE_FROM_POS 0x2
 
+#define MEM_TAIL_MIN_CHUNK    8
+#define MEM_TAIL_MAX_CHUNK    1024
+#define MEM_TAIL_MIN_VAR_SIZE 16  // var data bytes reserved per row at least
+
 static void    tbDataMovePosTo(STbData *pTbData, SMemSkipListNode **pos, STsdbRowKey *pKey, int32_t flags);
+static void    tbDataTailMoveTo(STbData *pTbData, STsdbRowKey *pKey, int8_t backward, STbDataIter *pIter);
 static int32_t tsdbGetOrCreateTbData(SMemTable *pMemTable, tb_uid_t suid, tb_uid_t uid, STbData **ppTbData);
 static int32_t tsdbInsertRowDataToTable(SMemTable *pMemTable, STbData *pTbData, int64_t version,
                                         SSubmitTbData *pSubmitTbData, int32_t *affectedRows);
@@ -75,6 +80,14 @@ int32_t tsdbMemTableCreate(STsdb *pTsdb, SMemTable **ppMemTable) {
     taosMemoryFree(pMemTable);
     goto _err;
   }
+  taosInitRWLatch(&pMemTable->skmLatch);
+  pMemTable->pSkmCache = tSimpleHashInit(16, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BINARY));
+  if (pMemTable->pSkmCache == NULL) {
+    code = TSDB_CODE_OUT_OF_MEMORY;
+    taosMemoryFree(pMemTable->aBucket);
+    taosMemoryFree(pMemTable);
+    goto _err;
+  }
   vnodeBufPoolRef(pMemTable->pPool);
   tRBTreeCreate(pMemTable->tbDataTree, tTbDataCmprFn);
 
@@ -89,6 +102,7 @@ _err:
 void tsdbMemTableDestroy(SMemTable *pMemTable, bool proactive) {
   if (pMemTable) {
     vnodeBufPoolUnRef(pMemTable->pPool, proactive);
+    tSimpleHashCleanup(pMemTable->pSkmCache);
     taosMemoryFree(pMemTable->aBucket);
     taosMemoryFree(pMemTable);
   }
@@ -115,12 +129,23 @@ STbData *tsdbGetTbDataFromMemTable(SMemTable *pMemTable, tb_uid_t suid, tb_uid_t
   return pTbData;
 }
 
+int32_t tsdbPrepareTableData(STsdb *pTsdb, tb_uid_t suid, tb_uid_t uid) {
+  STbData *pTbData = NULL;
+
+  int32_t code = tsdbGetOrCreateTbData(pTsdb->mem, suid, uid, &pTbData);
+  if (code) {
+    terrno = code;
+  }
+  return code;
+}
+
 int32_t tsdbInsertTableData(STsdb *pTsdb, int64_t version, SSubmitTbData *pSubmitTbData, int32_t *affectedRows) {
   int32_t    code = 0;
   SMemTable *pMemTable = pTsdb->mem;
   STbData   *pTbData = NULL;
   tb_uid_t   suid = pSubmitTbData->suid;
   tb_uid_t   uid = pSubmitTbData->uid;
+  int32_t    nRow = 0;
 
   // create/get STbData to op
   code = tsdbGetOrCreateTbData(pMemTable, suid, uid, &pTbData);
@@ -130,16 +155,22 @@ int32_t tsdbInsertTableData(STsdb *pTsdb, int64_t version, SSubmitTbData *pSubmi
 
   // do insert impl
   if (pSubmitTbData->flags & SUBMIT_REQ_COLUMN_DATA_FORMAT) {
-    code = tsdbInsertColDataToTable(pMemTable, pTbData, version, pSubmitTbData, affectedRows);
+    code = tsdbInsertColDataToTable(pMemTable, pTbData, version, pSubmitTbData, &nRow);
   } else {
-    code = tsdbInsertRowDataToTable(pMemTable, pTbData, version, pSubmitTbData, affectedRows);
+    code = tsdbInsertRowDataToTable(pMemTable, pTbData, version, pSubmitTbData, &nRow);
   }
   if (code) goto _err;
 
-  // update
+  // update, the tables of one submit request may be inserted by several threads
+  taosWLockLatch(&pMemTable->latch);
+  pMemTable->minKey = TMIN(pMemTable->minKey, pTbData->minKey);
+  pMemTable->maxKey = TMAX(pMemTable->maxKey, pTbData->maxKey);
+  pMemTable->nRow += nRow;
   pMemTable->minVer = TMIN(pMemTable->minVer, version);
   pMemTable->maxVer = TMAX(pMemTable->maxVer, version);
+  taosWUnLockLatch(&pMemTable->latch);
 
+  if (affectedRows) *affectedRows = nRow;
   return code;
 
 _err:
@@ -241,6 +272,7 @@ void tsdbTbDataIterOpen(STbData *pTbData, STsdbRowKey *pFrom, int8_t backward, S
   pIter->pTbData = pTbData;
   pIter->backward = backward;
   pIter->pRow = NULL;
+  pIter->fromTail = 0;
   if (pFrom == NULL) {
     // create from head or tail
     if (backward) {
@@ -258,40 +290,65 @@ void tsdbTbDataIterOpen(STbData *pTbData, STsdbRowKey *pFrom, int8_t backward, S
       pIter->pNode = SL_GET_NODE_FORWARD(pos[0], 0);
     }
   }
+
+  tbDataTailMoveTo(pTbData, pFrom, backward, pIter);
 }
 
-bool tsdbTbDataIterNext(STbDataIter *pIter) {
-  pIter->pRow = NULL;
+static FORCE_INLINE TSDBROW *tbDataIterSlRow(STbDataIter *pIter) {
   if (pIter->backward) {
-    ASSERT(pIter->pNode != pIter->pTbData->sl.pTail);
+    if (pIter->pNode == pIter->pTbData->sl.pHead) return NULL;
+  } else {
+    if (pIter->pNode == pIter->pTbData->sl.pTail) return NULL;
+  }
+  return &pIter->pNode->row;
+}
 
-    if (pIter->pNode == pIter->pTbData->sl.pHead) {
-      return false;
-    }
+static FORCE_INLINE bool tbDataIterTailRow(STbDataIter *pIter, TSDBROW *pRow) {
+  SMemTailChunk *pChunk = pIter->pChunk;
+  if (pChunk == NULL) return false;
 
-    pIter->pNode = SL_GET_NODE_BACKWARD(pIter->pNode, 0);
-    if (pIter->pNode == pIter->pTbData->sl.pHead) {
-      return false;
+  if (pIter->backward) {
+    while (pIter->iRow < 0) {
+      pChunk = pChunk->prev;
+      pIter->pChunk = pChunk;
+      if (pChunk == NULL) return false;
+      pIter->iRow = atomic_load_32(&pChunk->nRow) - 1;
     }
   } else {
-    ASSERT(pIter->pNode != pIter->pTbData->sl.pHead);
-
-    if (pIter->pNode == pIter->pTbData->sl.pTail) {
-      return false;
+    while (pIter->iRow >= atomic_load_32(&pChunk->nRow)) {
+      // rows appended after the iterator is opened are visible as well
+      SMemTailChunk *pNext = (SMemTailChunk *)atomic_load_ptr(&pChunk->next);
+      if (pNext == NULL) return false;
+      pChunk = pNext;
+      pIter->pChunk = pChunk;
+      pIter->iRow = 0;
     }
+  }
+
+  *pRow = tsdbRowFromBlockData(&pChunk->bData, pIter->iRow);
+  return true;
+}
+
+bool tsdbTbDataIterNext(STbDataIter *pIter) {
+  if (pIter->pRow == NULL && tsdbTbDataIterGet(pIter) == NULL) {
+    return false;
+  }
 
+  pIter->pRow = NULL;
+  if (pIter->fromTail) {
+    pIter->iRow += (pIter->backward ? -1 : 1);
+  } else if (pIter->backward) {
+    pIter->pNode = SL_GET_NODE_BACKWARD(pIter->pNode, 0);
+  } else {
     pIter->pNode = SL_GET_NODE_FORWARD(pIter->pNode, 0);
-    if (pIter->pNode == pIter->pTbData->sl.pTail) {
-      return false;
-    }
   }
 
-  return true;
+  return tsdbTbDataIterGet(pIter) != NULL;
 }
 
 int64_t tsdbCountTbDataRows(STbData *pTbData) {
   SMemSkipListNode *pNode = pTbData->sl.pHead;
-  int64_t           rowsNum = 0;
+  int64_t           rowsNum = pTbData->tail.size;
 
   while (NULL != pNode) {
     pNode = SL_GET_NODE_FORWARD(pNode, 0);
@@ -386,6 +443,9 @@ static int32_t tsdbGetOrCreateTbData(SMemTable *pMemTable, tb_uid_t suid, tb_uid
   pTbData->sl.pTail = (SMemSkipListNode *)POINTER_SHIFT(pTbData->sl.pHead, SL_NODE_SIZE(maxLevel));
   pTbData->sl.pHead->level = maxLevel;
   pTbData->sl.pTail->level = maxLevel;
+  pTbData->tail.size = 0;
+  pTbData->tail.pHead = NULL;
+  pTbData->tail.pTail = NULL;
   for (int8_t iLevel = 0; iLevel < maxLevel; iLevel++) {
     SL_NODE_FORWARD(pTbData->sl.pHead, iLevel) = pTbData->sl.pTail;
     SL_NODE_BACKWARD(pTbData->sl.pTail, iLevel) = pTbData->sl.pHead;
@@ -491,6 +551,374 @@ static void tbDataMovePosTo(STbData *pTbData, SMemSkipListNode **pos, STsdbRowKe
   }
 }
 
+static FORCE_INLINE void tbDataTailGetKey(SMemTailChunk *pChunk, int32_t iRow, STsdbRowKey *pKey) {
+  TSDBROW row = tsdbRowFromBlockData(&pChunk->bData, iRow);
+  tsdbRowGetKey(&row, pKey);
+}
+
+static void tbDataTailMoveTo(STbData *pTbData, STsdbRowKey *pKey, int8_t backward, STbDataIter *pIter) {
+  SMemTailChunk *pChunk;
+  STsdbRowKey    tKey;
+
+  pIter->pChunk = NULL;
+  pIter->iRow = 0;
+
+  if (backward) {
+    // last row with key <= pKey
+    for (pChunk = (SMemTailChunk *)atomic_load_ptr(&pTbData->tail.pTail); pChunk; pChunk = pChunk->prev) {
+      int32_t nRow = atomic_load_32(&pChunk->nRow);
+      if (nRow == 0) continue;
+
+      int32_t lidx = nRow - 1;
+      if (pKey) {
+        tbDataTailGetKey(pChunk, 0, &tKey);
+        if (tsdbRowKeyCmpr(&tKey, pKey) > 0) continue;
+
+        int32_t ridx = nRow - 1;
+        lidx = 0;
+        while (lidx < ridx) {
+          int32_t midx = (lidx + ridx + 1) >> 1;
+          tbDataTailGetKey(pChunk, midx, &tKey);
+          if (tsdbRowKeyCmpr(&tKey, pKey) <= 0) {
+            lidx = midx;
+          } else {
+            ridx = midx - 1;
+          }
+        }
+      }
+
+      pIter->pChunk = pChunk;
+      pIter->iRow = lidx;
+      return;
+    }
+  } else {
+    // first row with key >= pKey
+    SMemTailChunk *pLast = NULL;
+    for (pChunk = (SMemTailChunk *)atomic_load_ptr(&pTbData->tail.pHead); pChunk;
+         pChunk = (SMemTailChunk *)atomic_load_ptr(&pChunk->next)) {
+      int32_t nRow = atomic_load_32(&pChunk->nRow);
+      pLast = pChunk;
+
+      if (pKey == NULL) {
+        pIter->pChunk = pChunk;
+        return;
+      }
+
+      if (nRow == 0) continue;
+      tbDataTailGetKey(pChunk, nRow - 1, &tKey);
+      if (tsdbRowKeyCmpr(&tKey, pKey) < 0) continue;
+
+      int32_t lidx = 0;
+      int32_t ridx = nRow - 1;
+      while (lidx < ridx) {
+        int32_t midx = (lidx + ridx) >> 1;
+        tbDataTailGetKey(pChunk, midx, &tKey);
+        if (tsdbRowKeyCmpr(&tKey, pKey) >= 0) {
+          ridx = midx;
+        } else {
+          lidx = midx + 1;
+        }
+      }
+
+      pIter->pChunk = pChunk;
+      pIter->iRow = lidx;
+      return;
+    }
+
+    // all rows are smaller, stay at the end
+    if (pLast) {
+      pIter->pChunk = pLast;
+      pIter->iRow = atomic_load_32(&pLast->nRow);
+    }
+  }
+}
+
+// the key of the last row, either from the tail or from the skiplist
+static bool tbDataGetLastKey(STbData *pTbData, STsdbRowKey *pKey) {
+  SMemTailChunk *pChunk = pTbData->tail.pTail;
+  if (pChunk) {
+    // a chunk is linked with its first row
+    tbDataTailGetKey(pChunk, pChunk->nRow - 1, pKey);
+    return true;
+  }
+
+  SMemSkipListNode *pNode = SL_NODE_BACKWARD(pTbData->sl.pTail, 0);
+  if (pNode != pTbData->sl.pHead) {
+    tsdbRowGetKey(&pNode->row, pKey);
+    return true;
+  }
+
+  return false;
+}
+
+int32_t tsdbMemTableGetTSchema(SMemTable *pMemTable, tb_uid_t suid, tb_uid_t uid, int32_t sver, STSchema **ppTSchema) {
+  int32_t    code = 0;
+  SMemSkmKey key = {.uid = suid ? suid : uid, .sver = sver, .reserved = 0};
+  STSchema **ppCached = NULL;
+  STSchema  *pTSchema = NULL;
+  STSchema  *pCopy = NULL;
+
+  // the child tables of a super table share one schema
+  taosRLockLatch(&pMemTable->skmLatch);
+  ppCached = (STSchema **)tSimpleHashGet(pMemTable->pSkmCache, &key, sizeof(key));
+  if (ppCached) pCopy = *ppCached;
+  taosRUnLockLatch(&pMemTable->skmLatch);
+  if (pCopy) {
+    *ppTSchema = pCopy;
+    return 0;
+  }
+
+  code = metaGetTbTSchemaEx(pMemTable->pTsdb->pVnode->pMeta, suid, uid, sver, &pTSchema);
+  if (code) return code;
+
+  // kept in the buffer pool as long as the rows of the schema
+  int32_t size = sizeof(STSchema) + sizeof(STColumn) * pTSchema->numOfCols;
+  pCopy = (STSchema *)vnodeBufPoolMallocAligned(pMemTable->pTsdb->pVnode->inUse, size);
+  if (pCopy == NULL) {
+    tDestroyTSchema(pTSchema);
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+  memcpy(pCopy, pTSchema, size);
+  tDestroyTSchema(pTSchema);
+
+  // tables of one submit are inserted by several threads
+  taosWLockLatch(&pMemTable->skmLatch);
+  ppCached = (STSchema **)tSimpleHashGet(pMemTable->pSkmCache, &key, sizeof(key));
+  if (ppCached) {
+    pCopy = *ppCached;
+  } else {
+    code = tSimpleHashPut(pMemTable->pSkmCache, &key, sizeof(key), &pCopy, sizeof(pCopy));
+  }
+  taosWUnLockLatch(&pMemTable->skmLatch);
+
+  if (code == 0) *ppTSchema = pCopy;
+  return code;
+}
+
+// bytes of var data taken by the first nRow rows of a column
+static FORCE_INLINE int32_t tbDataTailVarSize(SMemTailChunk *pChunk, SColData *pColData, int32_t nRow) {
+  if (nRow == 0) return 0;
+  return (nRow < pChunk->capacity) ? pColData->aOffset[nRow] : pColData->nData;
+}
+
+static bool tbDataTailFits(SMemTailChunk *pChunk, SColVal *aColVal) {
+  for (int32_t iColData = 0; iColData < pChunk->bData.nColData; iColData++) {
+    SColData *pColData = &pChunk->bData.aColData[iColData];
+    if (IS_VAR_DATA_TYPE(pColData->type) && COL_VAL_IS_VALUE(&aColVal[iColData]) &&
+        tbDataTailVarSize(pChunk, pColData, pChunk->nRow) + aColVal[iColData].value.nData >
+            pChunk->aVarCap[iColData]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static int32_t tbDataTailNewChunk(SVBufPool *pPool, STbData *pTbData, STSchema *pTSchema, SColVal *aColVal) {
+  SMemTailChunk *pLast = pTbData->tail.pTail;
+  int32_t        capacity = pLast ? TMIN(pLast->capacity << 1, MEM_TAIL_MAX_CHUNK) : MEM_TAIL_MIN_CHUNK;
+  int32_t        nColData = pTSchema->numOfCols - 1;
+
+  SMemTailChunk *pChunk = (SMemTailChunk *)vnodeBufPoolMallocAligned(pPool, sizeof(*pChunk));
+  if (pChunk == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+  pChunk->prev = pLast;
+  pChunk->next = NULL;
+  pChunk->capacity = capacity;
+  pChunk->nRow = 0;
+  pChunk->pTSchema = pTSchema;
+  pChunk->aVarCap = (int32_t *)vnodeBufPoolMalloc(pPool, sizeof(int32_t) * nColData);
+
+  SBlockData *pBlockData = &pChunk->bData;
+  pBlockData->suid = pTbData->suid;
+  pBlockData->uid = pTbData->uid;
+  pBlockData->nRow = 0;
+  pBlockData->aUid = NULL;
+  pBlockData->aVersion = (int64_t *)vnodeBufPoolMalloc(pPool, sizeof(int64_t) * capacity);
+  pBlockData->aTSKEY = (TSKEY *)vnodeBufPoolMalloc(pPool, sizeof(TSKEY) * capacity);
+  pBlockData->nColData = nColData;
+  pBlockData->aColData = (SColData *)vnodeBufPoolMalloc(pPool, sizeof(SColData) * nColData);
+  if (pChunk->aVarCap == NULL || pBlockData->aVersion == NULL || pBlockData->aTSKEY == NULL ||
+      pBlockData->aColData == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  for (int32_t iColData = 0; iColData < nColData; iColData++) {
+    STColumn *pTColumn = &pTSchema->columns[iColData + 1];
+    SColData *pColData = &pBlockData->aColData[iColData];
+
+    // every row has its 2 bits, so a row is published by the count of rows alone
+    tColDataInit(pColData, pTColumn->colId, pTColumn->type, pTColumn->flags);
+    pColData->flag = HAS_VALUE | HAS_NULL | HAS_NONE;
+    pColData->nVal = capacity;
+    pColData->pBitMap = (uint8_t *)vnodeBufPoolMalloc(pPool, BIT2_SIZE(capacity));
+    if (pColData->pBitMap == NULL) {
+      return TSDB_CODE_OUT_OF_MEMORY;
+    }
+    memset(pColData->pBitMap, 0, BIT2_SIZE(capacity));
+
+    if (IS_VAR_DATA_TYPE(pTColumn->type)) {
+      // as much per row as the last chunk took, and the value at hand at least
+      int32_t size = MEM_TAIL_MIN_VAR_SIZE;
+      if (pLast && pLast->pTSchema == pTSchema) {
+        size = TMAX(size, tbDataTailVarSize(pLast, &pLast->bData.aColData[iColData], pLast->nRow) / pLast->nRow + 1);
+      }
+      pChunk->aVarCap[iColData] = size * capacity;
+      if (COL_VAL_IS_VALUE(&aColVal[iColData])) {
+        pChunk->aVarCap[iColData] = TMAX(pChunk->aVarCap[iColData], aColVal[iColData].value.nData);
+      }
+
+      pColData->aOffset = (int32_t *)vnodeBufPoolMalloc(pPool, sizeof(int32_t) * capacity);
+      pColData->pData = (uint8_t *)vnodeBufPoolMalloc(pPool, pChunk->aVarCap[iColData]);
+      if (pColData->aOffset == NULL || pColData->pData == NULL) {
+        return TSDB_CODE_OUT_OF_MEMORY;
+      }
+      pColData->aOffset[0] = 0;
+      pColData->nData = 0;
+    } else {
+      pChunk->aVarCap[iColData] = 0;
+      pColData->nData = tDataTypes[pTColumn->type].bytes * capacity;
+      pColData->pData = (uint8_t *)vnodeBufPoolMalloc(pPool, pColData->nData);
+      if (pColData->pData == NULL) {
+        return TSDB_CODE_OUT_OF_MEMORY;
+      }
+    }
+  }
+
+  if (pLast) {
+    atomic_store_ptr(&pLast->next, pChunk);
+  } else {
+    atomic_store_ptr(&pTbData->tail.pHead, pChunk);
+  }
+  atomic_store_ptr(&pTbData->tail.pTail, pChunk);
+
+  return 0;
+}
+
+// aColVal holds the values of the columns after the timestamp, in the order of the schema
+static int32_t tbDataTailPut(SMemTable *pMemTable, STbData *pTbData, STSchema *pTSchema, int64_t version, TSKEY ts,
+                             SColVal *aColVal) {
+  int32_t        code = 0;
+  SMemTailChunk *pChunk = pTbData->tail.pTail;
+
+  if (pChunk == NULL || pChunk->nRow >= pChunk->capacity || pChunk->pTSchema != pTSchema ||
+      !tbDataTailFits(pChunk, aColVal)) {
+    code = tbDataTailNewChunk(pMemTable->pTsdb->pVnode->inUse, pTbData, pTSchema, aColVal);
+    if (code) return code;
+    pChunk = pTbData->tail.pTail;
+  }
+
+  SBlockData *pBlockData = &pChunk->bData;
+  int32_t     iRow = pChunk->nRow;
+
+  pBlockData->aVersion[iRow] = version;
+  pBlockData->aTSKEY[iRow] = ts;
+  for (int32_t iColData = 0; iColData < pBlockData->nColData; iColData++) {
+    SColData *pColData = &pBlockData->aColData[iColData];
+    SColVal  *pColVal = &aColVal[iColData];
+
+    if (COL_VAL_IS_VALUE(pColVal)) {
+      SET_BIT2(pColData->pBitMap, iRow, 2);
+    } else if (COL_VAL_IS_NULL(pColVal)) {
+      SET_BIT2(pColData->pBitMap, iRow, 1);
+    }
+
+    if (IS_VAR_DATA_TYPE(pColData->type)) {
+      int32_t offset = pColData->aOffset[iRow];
+      if (COL_VAL_IS_VALUE(pColVal) && pColVal->value.nData > 0) {
+        memcpy(pColData->pData + offset, pColVal->value.pData, pColVal->value.nData);
+        offset += pColVal->value.nData;
+      }
+      // the end of the value is set before the row is published
+      if (iRow + 1 < pChunk->capacity) {
+        pColData->aOffset[iRow + 1] = offset;
+      } else {
+        pColData->nData = offset;
+      }
+    } else if (COL_VAL_IS_VALUE(pColVal)) {
+      int32_t bytes = tDataTypes[pColData->type].bytes;
+      memcpy(pColData->pData + bytes * iRow, &pColVal->value.val, bytes);
+    }
+  }
+
+  // publish the row to readers
+  pBlockData->nRow = iRow + 1;
+  atomic_store_32(&pChunk->nRow, iRow + 1);
+  pTbData->tail.size++;
+
+  return code;
+}
+
+// rows of a row format submit, from iRow on
+static int32_t tbDataTailPutRows(SMemTable *pMemTable, STbData *pTbData, int64_t version, int32_t sver, SRow **aRow,
+                                 int32_t iRow, int32_t nRow) {
+  int32_t   code = 0;
+  STSchema *pTSchema = NULL;
+  SColVal  *aColVal = NULL;
+
+  code = tsdbMemTableGetTSchema(pMemTable, pTbData->suid, pTbData->uid, sver, &pTSchema);
+  if (code) return code;
+
+  aColVal = (SColVal *)taosMemoryMalloc(sizeof(SColVal) * pTSchema->numOfCols);
+  if (aColVal == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  for (; iRow < nRow; iRow++) {
+    for (int32_t iCol = 1; iCol < pTSchema->numOfCols; iCol++) {
+      tRowGet(aRow[iRow], pTSchema, iCol, &aColVal[iCol - 1]);
+    }
+    code = tbDataTailPut(pMemTable, pTbData, pTSchema, version, aRow[iRow]->ts, aColVal);
+    if (code) break;
+  }
+
+  taosMemoryFree(aColVal);
+  return code;
+}
+
+// rows of a column format submit, from iRow on, the columns of the submit are a subset of the schema
+static int32_t tbDataTailPutCols(SMemTable *pMemTable, STbData *pTbData, int32_t sver, SBlockData *pBlockData,
+                                 int32_t iRow) {
+  int32_t   code = 0;
+  STSchema *pTSchema = NULL;
+  SColVal  *aColVal = NULL;
+  int32_t  *aColDataIdx = NULL;
+
+  code = tsdbMemTableGetTSchema(pMemTable, pTbData->suid, pTbData->uid, sver, &pTSchema);
+  if (code) return code;
+
+  aColVal = (SColVal *)taosMemoryMalloc((sizeof(SColVal) + sizeof(int32_t)) * pTSchema->numOfCols);
+  if (aColVal == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+  aColDataIdx = (int32_t *)(aColVal + pTSchema->numOfCols);
+
+  // both in the order of cid
+  for (int32_t iCol = 1, iColData = 0; iCol < pTSchema->numOfCols; iCol++) {
+    int16_t cid = pTSchema->columns[iCol].colId;
+    while (iColData < pBlockData->nColData && pBlockData->aColData[iColData].cid < cid) {
+      iColData++;
+    }
+    aColDataIdx[iCol - 1] =
+        (iColData < pBlockData->nColData && pBlockData->aColData[iColData].cid == cid) ? iColData : -1;
+  }
+
+  for (; iRow < pBlockData->nRow; iRow++) {
+    for (int32_t iCol = 1; iCol < pTSchema->numOfCols; iCol++) {
+      if (aColDataIdx[iCol - 1] < 0) {
+        aColVal[iCol - 1] = COL_VAL_NONE(pTSchema->columns[iCol].colId, pTSchema->columns[iCol].type);
+      } else {
+        tColDataGetValue(&pBlockData->aColData[aColDataIdx[iCol - 1]], iRow, &aColVal[iCol - 1]);
+      }
+    }
+    code = tbDataTailPut(pMemTable, pTbData, pTSchema, pBlockData->aVersion[iRow], pBlockData->aTSKEY[iRow], aColVal);
+    if (code) break;
+  }
+
+  taosMemoryFree(aColVal);
+  return code;
+}
+
 static FORCE_INLINE int8_t tsdbMemSkipListRandLevel(SMemSkipList *pSl) {
   int8_t level = 1;
   int8_t tlevel = TMIN(pSl->maxLevel, pSl->level + 1);
@@ -581,97 +1009,133 @@ static int32_t tsdbInsertColDataToTable(SMemTable *pMemTable, STbData *pTbData,
   SVBufPool *pPool = pMemTable->pTsdb->pVnode->inUse;
   int32_t    nColData = TARRAY_SIZE(pSubmitTbData->aCol);
   SColData  *aColData = (SColData *)TARRAY_DATA(pSubmitTbData->aCol);
+  SBlockData blockData = {0};
 
   ASSERT(aColData[0].cid == PRIMARYKEY_TIMESTAMP_COL_ID);
   ASSERT(aColData[0].type == TSDB_DATA_TYPE_TIMESTAMP);
   ASSERT(aColData[0].flag == HAS_VALUE);
 
-  // copy and construct block data
-  SBlockData *pBlockData = vnodeBufPoolMalloc(pPool, sizeof(*pBlockData));
-  if (pBlockData == NULL) {
-    code = TSDB_CODE_OUT_OF_MEMORY;
-    goto _exit;
-  }
-
-  pBlockData->suid = pTbData->suid;
-  pBlockData->uid = pTbData->uid;
-  pBlockData->nRow = aColData[0].nVal;
-  pBlockData->aUid = NULL;
-  pBlockData->aVersion = vnodeBufPoolMalloc(pPool, aColData[0].nData);
-  if (pBlockData->aVersion == NULL) {
+  // the submit columns as block data, the tail copies the values out of it
+  blockData.suid = pTbData->suid;
+  blockData.uid = pTbData->uid;
+  blockData.nRow = aColData[0].nVal;
+  blockData.aUid = NULL;
+  blockData.aVersion = taosMemoryMalloc(aColData[0].nData);
+  if (blockData.aVersion == NULL) {
     code = TSDB_CODE_OUT_OF_MEMORY;
     goto _exit;
   }
-  for (int32_t i = 0; i < pBlockData->nRow; i++) {  // todo: here can be optimized
-    pBlockData->aVersion[i] = version;
+  for (int32_t i = 0; i < blockData.nRow; i++) {
+    blockData.aVersion[i] = version;
   }
+  blockData.aTSKEY = (TSKEY *)aColData[0].pData;
+  blockData.nColData = nColData - 1;
+  blockData.aColData = aColData + 1;
 
-  pBlockData->aTSKEY = vnodeBufPoolMalloc(pPool, aColData[0].nData);
-  if (pBlockData->aTSKEY == NULL) {
-    code = TSDB_CODE_OUT_OF_MEMORY;
-    goto _exit;
-  }
-  memcpy(pBlockData->aTSKEY, aColData[0].pData, aColData[0].nData);
+  // rows are in key order, those after all existing rows are appended to the tail, the rest go to the skiplist
+  SMemSkipListNode *pos[SL_MAX_LEVEL];
+  TSDBROW           tRow = tsdbRowFromBlockData(&blockData, 0);
+  STsdbRowKey       key;
+  STsdbRowKey       lastKey;
+  int32_t           nSlRow = 0;
 
-  pBlockData->nColData = nColData - 1;
-  pBlockData->aColData = vnodeBufPoolMalloc(pPool, sizeof(SColData) * pBlockData->nColData);
-  if (pBlockData->aColData == NULL) {
-    code = TSDB_CODE_OUT_OF_MEMORY;
-    goto _exit;
+  if (tbDataGetLastKey(pTbData, &lastKey)) {
+    for (; nSlRow < blockData.nRow; nSlRow++) {
+      tRow.iRow = nSlRow;
+      tsdbRowGetKey(&tRow, &key);
+      if (tsdbRowKeyCmpr(&key, &lastKey) > 0) break;
+    }
   }
 
-  for (int32_t iColData = 0; iColData < pBlockData->nColData; ++iColData) {
-    code = tColDataCopy(&aColData[iColData + 1], &pBlockData->aColData[iColData], (xMallocFn)vnodeBufPoolMalloc, pPool);
-    if (code) goto _exit;
-  }
+  if (nSlRow > 0) {
+    // copy and construct block data, the skiplist nodes refer to its rows
+    SBlockData *pBlockData = vnodeBufPoolMalloc(pPool, sizeof(*pBlockData));
+    if (pBlockData == NULL) {
+      code = TSDB_CODE_OUT_OF_MEMORY;
+      goto _exit;
+    }
 
-  // loop to add each row to the skiplist
-  SMemSkipListNode *pos[SL_MAX_LEVEL];
-  TSDBROW           tRow = tsdbRowFromBlockData(pBlockData, 0);
-  STsdbRowKey       key;
+    pBlockData->suid = pTbData->suid;
+    pBlockData->uid = pTbData->uid;
+    pBlockData->nRow = blockData.nRow;
+    pBlockData->aUid = NULL;
+    pBlockData->aVersion = vnodeBufPoolMalloc(pPool, aColData[0].nData);
+    if (pBlockData->aVersion == NULL) {
+      code = TSDB_CODE_OUT_OF_MEMORY;
+      goto _exit;
+    }
+    memcpy(pBlockData->aVersion, blockData.aVersion, aColData[0].nData);
 
-  // first row
-  tsdbRowGetKey(&tRow, &key);
-  tbDataMovePosTo(pTbData, pos, &key, SL_MOVE_BACKWARD);
-  if ((code = tbDataDoPut(pMemTable, pTbData, pos, &tRow, 0))) goto _exit;
-  pTbData->minKey = TMIN(pTbData->minKey, key.key.ts);
+    pBlockData->aTSKEY = vnodeBufPoolMalloc(pPool, aColData[0].nData);
+    if (pBlockData->aTSKEY == NULL) {
+      code = TSDB_CODE_OUT_OF_MEMORY;
+      goto _exit;
+    }
+    memcpy(pBlockData->aTSKEY, aColData[0].pData, aColData[0].nData);
 
-  // remain row
-  ++tRow.iRow;
-  if (tRow.iRow < pBlockData->nRow) {
-    for (int8_t iLevel = pos[0]->level; iLevel < pTbData->sl.maxLevel; iLevel++) {
-      pos[iLevel] = SL_NODE_BACKWARD(pos[iLevel], iLevel);
+    pBlockData->nColData = nColData - 1;
+    pBlockData->aColData = vnodeBufPoolMalloc(pPool, sizeof(SColData) * pBlockData->nColData);
+    if (pBlockData->aColData == NULL) {
+      code = TSDB_CODE_OUT_OF_MEMORY;
+      goto _exit;
     }
 
-    while (tRow.iRow < pBlockData->nRow) {
-      tsdbRowGetKey(&tRow, &key);
+    for (int32_t iColData = 0; iColData < pBlockData->nColData; ++iColData) {
+      code =
+          tColDataCopy(&aColData[iColData + 1], &pBlockData->aColData[iColData], (xMallocFn)vnodeBufPoolMalloc, pPool);
+      if (code) goto _exit;
+    }
 
-      if (SL_NODE_FORWARD(pos[0], 0) != pTbData->sl.pTail) {
-        tbDataMovePosTo(pTbData, pos, &key, SL_MOVE_FROM_POS);
+    // first row
+    tRow = tsdbRowFromBlockData(pBlockData, 0);
+    tsdbRowGetKey(&tRow, &key);
+    tbDataMovePosTo(pTbData, pos, &key, SL_MOVE_BACKWARD);
+    if ((code = tbDataDoPut(pMemTable, pTbData, pos, &tRow, 0))) goto _exit;
+
+    // remain row
+    ++tRow.iRow;
+    if (tRow.iRow < nSlRow) {
+      for (int8_t iLevel = pos[0]->level; iLevel < pTbData->sl.maxLevel; iLevel++) {
+        pos[iLevel] = SL_NODE_BACKWARD(pos[iLevel], iLevel);
       }
 
-      if ((code = tbDataDoPut(pMemTable, pTbData, pos, &tRow, 1))) goto _exit;
+      while (tRow.iRow < nSlRow) {
+        tsdbRowGetKey(&tRow, &key);
+
+        if (SL_NODE_FORWARD(pos[0], 0) != pTbData->sl.pTail) {
+          tbDataMovePosTo(pTbData, pos, &key, SL_MOVE_FROM_POS);
+        }
+
+        if ((code = tbDataDoPut(pMemTable, pTbData, pos, &tRow, 1))) goto _exit;
 
-      ++tRow.iRow;
+        ++tRow.iRow;
+      }
     }
   }
 
+  if (nSlRow < blockData.nRow) {
+    code = tbDataTailPutCols(pMemTable, pTbData, pSubmitTbData->sver, &blockData, nSlRow);
+    if (code) goto _exit;
+  }
+
+  tRow = tsdbRowFromBlockData(&blockData, 0);
+  tsdbRowGetKey(&tRow, &key);
+  pTbData->minKey = TMIN(pTbData->minKey, key.key.ts);
+
+  tRow.iRow = blockData.nRow - 1;
+  tsdbRowGetKey(&tRow, &key);
   if (key.key.ts >= pTbData->maxKey) {
     pTbData->maxKey = key.key.ts;
   }
 
   if (!TSDB_CACHE_NO(pMemTable->pTsdb->pVnode->config)) {
-    tsdbCacheColFormatUpdate(pMemTable->pTsdb, pTbData->suid, pTbData->uid, pBlockData);
+    tsdbCacheColFormatUpdate(pMemTable->pTsdb, pTbData->suid, pTbData->uid, &blockData);
   }
 
-  // SMemTable
-  pMemTable->minKey = TMIN(pMemTable->minKey, pTbData->minKey);
-  pMemTable->maxKey = TMAX(pMemTable->maxKey, pTbData->maxKey);
-  pMemTable->nRow += pBlockData->nRow;
-
-  if (affectedRows) *affectedRows = pBlockData->nRow;
+  *affectedRows = blockData.nRow;
 
 _exit:
+  taosMemoryFree(blockData.aVersion);
   return code;
 }
 
@@ -682,40 +1146,62 @@ static int32_t tsdbInsertRowDataToTable(SMemTable *pMemTable, STbData *pTbData,
   int32_t           nRow = TARRAY_SIZE(pSubmitTbData->aRowP);
   SRow            **aRow = (SRow **)TARRAY_DATA(pSubmitTbData->aRowP);
   STsdbRowKey       key;
+  STsdbRowKey       lastKey;
   SMemSkipListNode *pos[SL_MAX_LEVEL];
   TSDBROW           tRow = {.type = TSDBROW_ROW_FMT, .version = version};
   int32_t           iRow = 0;
+  int32_t           nSlRow = 0;
 
-  // backward put first data
-  tRow.pTSRow = aRow[iRow++];
-  tsdbRowGetKey(&tRow, &key);
-  tbDataMovePosTo(pTbData, pos, &key, SL_MOVE_BACKWARD);
-  code = tbDataDoPut(pMemTable, pTbData, pos, &tRow, 0);
-  if (code) goto _exit;
-
-  pTbData->minKey = TMIN(pTbData->minKey, key.key.ts);
-
-  // forward put rest data
-  if (iRow < nRow) {
-    for (int8_t iLevel = pos[0]->level; iLevel < pTbData->sl.maxLevel; iLevel++) {
-      pos[iLevel] = SL_NODE_BACKWARD(pos[iLevel], iLevel);
+  // rows are in key order, those after all existing rows are appended to the tail, the rest go to the skiplist
+  if (tbDataGetLastKey(pTbData, &lastKey)) {
+    for (; nSlRow < nRow; nSlRow++) {
+      tRow.pTSRow = aRow[nSlRow];
+      tsdbRowGetKey(&tRow, &key);
+      if (tsdbRowKeyCmpr(&key, &lastKey) > 0) break;
     }
+  }
 
-    while (iRow < nRow) {
-      tRow.pTSRow = aRow[iRow];
-      tsdbRowGetKey(&tRow, &key);
+  if (nSlRow > 0) {
+    // backward put first data
+    tRow.pTSRow = aRow[iRow++];
+    tsdbRowGetKey(&tRow, &key);
+    tbDataMovePosTo(pTbData, pos, &key, SL_MOVE_BACKWARD);
+    code = tbDataDoPut(pMemTable, pTbData, pos, &tRow, 0);
+    if (code) goto _exit;
 
-      if (SL_NODE_FORWARD(pos[0], 0) != pTbData->sl.pTail) {
-        tbDataMovePosTo(pTbData, pos, &key, SL_MOVE_FROM_POS);
+    // forward put rest data
+    if (iRow < nSlRow) {
+      for (int8_t iLevel = pos[0]->level; iLevel < pTbData->sl.maxLevel; iLevel++) {
+        pos[iLevel] = SL_NODE_BACKWARD(pos[iLevel], iLevel);
       }
 
-      code = tbDataDoPut(pMemTable, pTbData, pos, &tRow, 1);
-      if (code) goto _exit;
+      while (iRow < nSlRow) {
+        tRow.pTSRow = aRow[iRow];
+        tsdbRowGetKey(&tRow, &key);
+
+        if (SL_NODE_FORWARD(pos[0], 0) != pTbData->sl.pTail) {
+          tbDataMovePosTo(pTbData, pos, &key, SL_MOVE_FROM_POS);
+        }
+
+        code = tbDataDoPut(pMemTable, pTbData, pos, &tRow, 1);
+        if (code) goto _exit;
 
-      iRow++;
+        iRow++;
+      }
     }
   }
 
+  if (nSlRow < nRow) {
+    code = tbDataTailPutRows(pMemTable, pTbData, version, pSubmitTbData->sver, aRow, nSlRow, nRow);
+    if (code) goto _exit;
+  }
+
+  tRow.pTSRow = aRow[0];
+  tsdbRowGetKey(&tRow, &key);
+  pTbData->minKey = TMIN(pTbData->minKey, key.key.ts);
+
+  tRow.pTSRow = aRow[nRow - 1];
+  tsdbRowGetKey(&tRow, &key);
   if (key.key.ts >= pTbData->maxKey) {
     pTbData->maxKey = key.key.ts;
   }
@@ -723,18 +1209,13 @@ static int32_t tsdbInsertRowDataToTable(SMemTable *pMemTable, STbData *pTbData,
     tsdbCacheRowFormatUpdate(pMemTable->pTsdb, pTbData->suid, pTbData->uid, version, nRow, aRow);
   }
 
-  // SMemTable
-  pMemTable->minKey = TMIN(pMemTable->minKey, pTbData->minKey);
-  pMemTable->maxKey = TMAX(pMemTable->maxKey, pTbData->maxKey);
-  pMemTable->nRow += nRow;
-
-  if (affectedRows) *affectedRows = nRow;
+  *affectedRows = nRow;
 
 _exit:
   return code;
 }
 
-int32_t tsdbGetNRowsInTbData(STbData *pTbData) { return pTbData->sl.size; }
+int32_t tsdbGetNRowsInTbData(STbData *pTbData) { return pTbData->sl.size + pTbData->tail.size; }
 
 int32_t tsdbRefMemTable(SMemTable *pMemTable, SQueryNode *pQNode) {
   int32_t code = 0;
@@ -807,18 +1288,27 @@ TSDBROW *tsdbTbDataIterGet(STbDataIter *pIter) {
     return pIter->pRow;
   }
 
-  if (pIter->backward) {
-    if (pIter->pNode == pIter->pTbData->sl.pHead) {
-      return NULL;
-    }
+  // merge the skiplist and the tail
+  TSDBROW  tailRow;
+  TSDBROW *pSlRow = tbDataIterSlRow(pIter);
+  TSDBROW *pTailRow = tbDataIterTailRow(pIter, &tailRow) ? &tailRow : NULL;
+  if (pSlRow == NULL && pTailRow == NULL) {
+    return NULL;
+  }
+
+  if (pSlRow && pTailRow) {
+    STsdbRowKey slKey, tailKey;
+    tsdbRowGetKey(pSlRow, &slKey);
+    tsdbRowGetKey(pTailRow, &tailKey);
+
+    int32_t c = tsdbRowKeyCmpr(&tailKey, &slKey);
+    pIter->fromTail = pIter->backward ? (c > 0) : (c < 0);
   } else {
-    if (pIter->pNode == pIter->pTbData->sl.pTail) {
-      return NULL;
-    }
+    pIter->fromTail = (pSlRow == NULL);
   }
 
   pIter->pRow = &pIter->row;
-  pIter->row = pIter->pNode->row;
+  pIter->row = pIter->fromTail ? *pTailRow : *pSlRow;
 
   return pIter->pRow;
 }
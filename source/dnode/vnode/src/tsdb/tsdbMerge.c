@@ -14,9 +14,14 @@
  */
 
 #include "tsdbMerge.h"
+#include "tglobal.h"
+#include "vnd.h"
 
 #define TSDB_MAX_LEVEL 2  // means max level is 3
 
+#define TSDB_MERGE_ADMIT_CHARGE_ROWS 4096
+#define TSDB_MERGE_ADMIT_BURST_US    100000
+
 typedef struct {
   STsdb     *tsdb;
   int32_t    fid;
@@ -40,6 +45,14 @@ typedef struct {
     TABLEID    tbid[1];
   } ctx[1];
 
+  // progress
+  struct {
+    int64_t inputSize;
+    int64_t nInputRow;
+    int64_t nMergedRow;
+    int64_t nChargedRow;
+  } stat[1];
+
   TFileOpArray fopArr[1];
 
   // reader
@@ -53,6 +66,49 @@ typedef struct {
   SFSetWriter *writer;
 } SMerger;
 
+// Admission control of stt merges, dnode wide and shared by the merges of all vnodes. Each merge books the time its
+// input takes at tsdbMergeAdmitRate on a virtual clock as it goes, and a merge that commits are not waiting on is not
+// started while the clock runs ahead of now. A started merge runs at full speed, so the rate bounds the merge input
+// on average over time, not the I/O rate at any moment. Idle time is kept for a short burst at most.
+static int64_t tsdbMergeAdmitNextUs = 0;
+static int32_t tsdbMergeAdmitClockRate = 0;
+
+// the clock is booked at one rate, start it over when the rate changes
+static void tsdbMergeAdmitSyncRate(int32_t rate) {
+  int32_t clockRate = atomic_load_32(&tsdbMergeAdmitClockRate);
+  if (clockRate != rate && atomic_val_compare_exchange_32(&tsdbMergeAdmitClockRate, clockRate, rate) == clockRate) {
+    atomic_store_64(&tsdbMergeAdmitNextUs, 0);
+  }
+}
+
+void tsdbMergeAdmitCharge(int64_t size, int64_t nowUs) {
+  int32_t rate = tsTsdbMergeAdmitRate;
+  tsdbMergeAdmitSyncRate(rate);
+  if (rate <= 0 || size <= 0) return;
+
+  int64_t costUs = size * 1000000 / ((int64_t)rate << 20);
+  int64_t nextUs, startUs;
+  do {
+    nextUs = atomic_load_64(&tsdbMergeAdmitNextUs);
+    startUs = TMAX(nextUs, nowUs - TSDB_MERGE_ADMIT_BURST_US);
+  } while (atomic_val_compare_exchange_64(&tsdbMergeAdmitNextUs, nextUs, startUs + costUs) != nextUs);
+}
+
+int64_t tsdbMergeAdmitDelay(int64_t nowUs) {
+  int32_t rate = tsTsdbMergeAdmitRate;
+  tsdbMergeAdmitSyncRate(rate);
+  if (rate <= 0) return 0;
+  return TMAX(atomic_load_64(&tsdbMergeAdmitNextUs) - nowUs, 0);
+}
+
+static void tsdbMergeAdmitChargeRows(SMerger *merger) {
+  int64_t nRow = merger->stat->nMergedRow - merger->stat->nChargedRow;
+  merger->stat->nChargedRow = merger->stat->nMergedRow;
+
+  if (merger->stat->nInputRow <= 0) return;
+  tsdbMergeAdmitCharge(merger->stat->inputSize * nRow / merger->stat->nInputRow, taosGetTimestampUs());
+}
+
 static int32_t tsdbMergerOpen(SMerger *merger) {
   merger->ctx->now = taosGetTimestampSec();
   merger->maxRow = merger->tsdb->pVnode->config.tsdbCfg.maxRows;
@@ -237,6 +293,37 @@ _exit:
   return code;
 }
 
+static int32_t tsdbMergeFileSetBeginInitStat(SMerger *merger) {
+  int32_t         code = 0;
+  int32_t         lino = 0;
+  STFileOp       *op;
+  SSttFileReader *reader;
+
+  memset(merger->stat, 0, sizeof(merger->stat));
+
+  TARRAY2_FOREACH_PTR(merger->fopArr, op) {
+    if (op->optype == TSDB_FOP_REMOVE) {
+      merger->stat->inputSize += op->of.size;
+    }
+  }
+
+  TARRAY2_FOREACH(merger->sttReaderArr, reader) {
+    const TSttBlkArray *sttBlkArray;
+    const SSttBlk      *sttBlk;
+
+    code = tsdbSttFileReadSttBlk(reader, &sttBlkArray);
+    TSDB_CHECK_CODE(code, lino, _exit);
+
+    TARRAY2_FOREACH_PTR(sttBlkArray, sttBlk) { merger->stat->nInputRow += sttBlk->nRow; }
+  }
+
+_exit:
+  if (code) {
+    TSDB_ERROR_LOG(TD_VID(merger->tsdb->pVnode), lino, code);
+  }
+  return code;
+}
+
 static int32_t tsdbMergeFileSetBeginOpenIter(SMerger *merger) {
   int32_t code = 0;
   int32_t lino = 0;
@@ -348,6 +435,9 @@ static int32_t tsdbMergeFileSetBegin(SMerger *merger) {
   code = tsdbMergeFileSetBeginOpenReader(merger);
   TSDB_CHECK_CODE(code, lino, _exit);
 
+  code = tsdbMergeFileSetBeginInitStat(merger);
+  TSDB_CHECK_CODE(code, lino, _exit);
+
   // open iterator
   code = tsdbMergeFileSetBeginOpenIter(merger);
   TSDB_CHECK_CODE(code, lino, _exit);
@@ -442,7 +532,12 @@ static int32_t tsdbMergeFileSet(SMerger *merger, STFileSet *fset) {
 
     code = tsdbIterMergerNext(merger->dataIterMerger);
     TSDB_CHECK_CODE(code, lino, _exit);
+
+    if (++merger->stat->nMergedRow - merger->stat->nChargedRow >= TSDB_MERGE_ADMIT_CHARGE_ROWS) {
+      tsdbMergeAdmitChargeRows(merger);
+    }
   }
+  tsdbMergeAdmitChargeRows(merger);
 
   // tomb
   merger->ctx->tbid->suid = 0;
@@ -472,7 +567,9 @@ _exit:
   if (code) {
     tsdbError("vgId:%d %s failed at line %d since %s", TD_VID(merger->tsdb->pVnode), __func__, lino, tstrerror(code));
   } else {
-    tsdbDebug("vgId:%d %s done, fid:%d", TD_VID(merger->tsdb->pVnode), __func__, fset->fid);
+    tsdbDebug("vgId:%d %s done, fid:%d input size:%" PRId64 " rows:%" PRId64 " merged rows:%" PRId64,
+              TD_VID(merger->tsdb->pVnode), __func__, fset->fid, merger->stat->inputSize, merger->stat->nInputRow,
+              merger->stat->nMergedRow);
   }
   return code;
 }
@@ -504,6 +601,28 @@ _exit:
   return code;
 }
 
+// put the merge back on the channel of the file set, to start once the admission clock catches up
+// IMPORTANT: the caller must hold tsdb->mutex
+static int32_t tsdbMergeDefer(STsdb *tsdb, STFileSet *fset, int64_t delayUs) {
+  if (tsdb->bgTaskDisabled || !VNODE_ASYNC_VALID_CHANNEL_ID(fset->bgTaskChannel)) return 0;
+
+  SMergeArg *arg = taosMemoryMalloc(sizeof(*arg));
+  if (arg == NULL) return TSDB_CODE_OUT_OF_MEMORY;
+
+  arg->tsdb = tsdb;
+  arg->fid = fset->fid;
+
+  int32_t code = vnodeAsyncCDelay(vnodeAsyncHandle[1], fset->bgTaskChannel, EVA_PRIORITY_NORMAL, (delayUs + 999) / 1000,
+                                  tsdbMerge, taosMemoryFree, arg, &fset->mergeDeferTask);
+  if (code) {
+    taosMemoryFree(arg);
+    return code;
+  }
+
+  fset->mergeScheduled = true;
+  return 0;
+}
+
 static int32_t tsdbMergeGetFSet(SMerger *merger) {
   STFileSet *fset;
 
@@ -515,6 +634,23 @@ static int32_t tsdbMergeGetFSet(SMerger *merger) {
   }
 
   fset->mergeScheduled = false;
+  fset->mergeDeferTask = 0;
+
+  // give the worker back instead of waiting for admission, the merge is requeued to run when it is admitted
+  int64_t delayUs = fset->blockCommit ? 0 : tsdbMergeAdmitDelay(taosGetTimestampUs());
+  if (delayUs > 0) {
+    int32_t code = tsdbMergeDefer(merger->tsdb, fset, delayUs);
+    taosThreadMutexUnlock(&merger->tsdb->mutex);
+    if (code) {
+      // the next commit edit schedules the merge again
+      tsdbError("vgId:%d failed to defer merge, fid:%d since %s", TD_VID(merger->tsdb->pVnode), merger->fid,
+                tstrerror(code));
+    } else {
+      tsdbDebug("vgId:%d merge deferred by the merge admission rate for %" PRId64 "us, fid:%d",
+                TD_VID(merger->tsdb->pVnode), delayUs, merger->fid);
+    }
+    return 0;
+  }
 
   int32_t code = tsdbTFileSetInitCopy(merger->tsdb, fset, &merger->fset);
   if (code) {
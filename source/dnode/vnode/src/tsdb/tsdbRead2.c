@@ -21,6 +21,7 @@
 #include "tsdbReadUtil.h"
 #include "tsdbUtil2.h"
 #include "tsimplehash.h"
+#include "vnd.h"
 
 #define ASCENDING_TRAVERSE(o)       (o == TSDB_ORDER_ASC)
 #define getCurrentKeyInSttBlock(_r) (&((_r)->currentKey))
@@ -72,6 +73,7 @@ static void          initBlockDumpInfo(STsdbReader* pReader, SDataBlockIter* pBl
 static int32_t       getInitialDelIndex(const SArray* pDelSkyline, int32_t order);
 static void          resetTableListIndex(SReaderStatus* pStatus);
 static void          getMemTableTimeRange(STsdbReader* pReader, int64_t* pMaxKey, int64_t* pMinKey);
+static void          stopBlockPrefetch(STsdbReader* pReader);
 static void          updateComposedBlockInfo(STsdbReader* pReader, double el, STableBlockScanInfo* pBlockScanInfo);
 static int32_t       buildFromPreFilesetBuffer(STsdbReader* pReader);
 
@@ -277,6 +279,34 @@ static int32_t initFilesetIterator(SFilesetIter* pIter, TFileSetArray* pFileSetA
   return TSDB_CODE_SUCCESS;
 }
 
+static void initDataFileReaderConf(STsdbReader* pReader, STFileSet* pFileset, SDataFileReaderConfig* pConf,
+                                   const char** filesName) {
+  STFileObj** pFileObj = pFileset->farr;
+
+  pConf->tsdb = pReader->pTsdb;
+  pConf->szPage = pReader->pTsdb->pVnode->config.tsdbPageSize;
+
+  if (pFileObj[0] != NULL) {
+    pConf->files[0].file = *pFileObj[0]->f;
+    pConf->files[0].exist = true;
+    filesName[0] = pFileObj[0]->fname;
+
+    pConf->files[1].file = *pFileObj[1]->f;
+    pConf->files[1].exist = true;
+    filesName[1] = pFileObj[1]->fname;
+
+    pConf->files[2].file = *pFileObj[2]->f;
+    pConf->files[2].exist = true;
+    filesName[2] = pFileObj[2]->fname;
+  }
+
+  if (pFileObj[3] != NULL) {
+    pConf->files[3].exist = true;
+    pConf->files[3].file = *pFileObj[3]->f;
+    filesName[3] = pFileObj[3]->fname;
+  }
+}
+
 static int32_t filesetIteratorNext(SFilesetIter* pIter, STsdbReader* pReader, bool* hasNext) {
   bool    asc = ASCENDING_TRAVERSE(pIter->order);
   int32_t step = asc ? 1 : -1;
@@ -299,6 +329,7 @@ static int32_t filesetIteratorNext(SFilesetIter* pIter, STsdbReader* pReader, bo
   STimeWindow win = {0};
 
   while (1) {
+    stopBlockPrefetch(pReader);
     if (pReader->pFileReader != NULL) {
       tsdbDataFileReaderClose(&pReader->pFileReader);
     }
@@ -307,30 +338,10 @@ static int32_t filesetIteratorNext(SFilesetIter* pIter, STsdbReader* pReader, bo
 
     STFileObj** pFileObj = pReader->status.pCurrentFileset->farr;
     if (pFileObj[0] != NULL || pFileObj[3] != NULL) {
-      SDataFileReaderConfig conf = {.tsdb = pReader->pTsdb, .szPage = pReader->pTsdb->pVnode->config.tsdbPageSize};
-
-      const char* filesName[4] = {0};
-
-      if (pFileObj[0] != NULL) {
-        conf.files[0].file = *pFileObj[0]->f;
-        conf.files[0].exist = true;
-        filesName[0] = pFileObj[0]->fname;
-
-        conf.files[1].file = *pFileObj[1]->f;
-        conf.files[1].exist = true;
-        filesName[1] = pFileObj[1]->fname;
-
-        conf.files[2].file = *pFileObj[2]->f;
-        conf.files[2].exist = true;
-        filesName[2] = pFileObj[2]->fname;
-      }
-
-      if (pFileObj[3] != NULL) {
-        conf.files[3].exist = true;
-        conf.files[3].file = *pFileObj[3]->f;
-        filesName[3] = pFileObj[3]->fname;
-      }
+      SDataFileReaderConfig conf = {0};
+      const char*           filesName[4] = {0};
 
+      initDataFileReaderConf(pReader, pReader->status.pCurrentFileset, &conf, filesName);
       code = tsdbDataFileReaderOpen(filesName, &conf, &pReader->pFileReader);
       if (code != TSDB_CODE_SUCCESS) {
         goto _err;
@@ -1303,6 +1314,228 @@ static FORCE_INLINE STSchema* getTableSchemaImpl(STsdbReader* pReader, uint64_t
   return pReader->info.pSchema;
 }
 
+static int32_t doPrefetchBlockTask(void* param) {
+  SBlockPrefetchSlot* pSlot = param;
+  STsdbReader*        pReader = pSlot->pReader;
+  SBlockLoadSuppInfo* pSup = &pReader->suppInfo;
+
+  pSlot->code = tsdbDataFileReadBlockDataByColumn(pReader->prefetch.pFileReader, &pSlot->record, &pSlot->data,
+                                                  pSlot->pSchema, &pSup->colId[1], pSup->numOfCols - 1);
+  return pSlot->code;
+}
+
+static void releasePrefetchSlot(SBlockPrefetchSlot* pSlot) {
+  if (!pSlot->used) {
+    return;
+  }
+
+  // cancel it if not started yet, otherwise wait for it
+  (void)vnodeACancel(vnodeAsyncHandle[2], pSlot->taskId);
+  (void)vnodeAWait(vnodeAsyncHandle[2], pSlot->taskId);
+  pSlot->used = false;
+}
+
+// all blocks issued are dropped, called before the file reader of the query thread is closed.
+static void stopBlockPrefetch(STsdbReader* pReader) {
+  SBlockPrefetch* pPrefetch = &pReader->prefetch;
+  for (int32_t i = 0; i < TSDB_PREFETCH_MAX_DEPTH; ++i) {
+    releasePrefetchSlot(&pPrefetch->slots[i]);
+  }
+
+  if (pPrefetch->pFileReader != NULL) {
+    tsdbDataFileReaderClose(&pPrefetch->pFileReader);
+  }
+}
+
+static void destroyBlockPrefetch(STsdbReader* pReader) {
+  SBlockPrefetch* pPrefetch = &pReader->prefetch;
+  stopBlockPrefetch(pReader);
+
+  if (VNODE_ASYNC_VALID_CHANNEL_ID(pPrefetch->channel)) {
+    (void)vnodeAChannelDestroy(vnodeAsyncHandle[2], pPrefetch->channel, true);
+    pPrefetch->channel = 0;
+  }
+
+  for (int32_t i = 0; i < TSDB_PREFETCH_MAX_DEPTH; ++i) {
+    if (pPrefetch->slots[i].created) {
+      tBlockDataDestroy(&pPrefetch->slots[i].data);
+      pPrefetch->slots[i].created = false;
+    }
+  }
+}
+
+static SBlockPrefetchSlot* getPrefetchSlot(SBlockPrefetch* pPrefetch, SFileDataBlockInfo* pBlockInfo) {
+  for (int32_t i = 0; i < TSDB_PREFETCH_MAX_DEPTH; ++i) {
+    SBlockPrefetchSlot* pSlot = &pPrefetch->slots[i];
+    if (pSlot->used && pSlot->record.uid == pBlockInfo->uid &&
+        pSlot->record.blockOffset == pBlockInfo->blockOffset) {
+      return pSlot;
+    }
+  }
+
+  return NULL;
+}
+
+static int32_t issueBlockPrefetch(STsdbReader* pReader, SDataBlockIter* pBlockIter, SBlockPrefetchSlot* pSlot,
+                                  int32_t index) {
+  SBlockPrefetch*     pPrefetch = &pReader->prefetch;
+  SFileDataBlockInfo* pBlockInfo = taosArrayGet(pBlockIter->blockList, index);
+
+  int32_t code = 0;
+  if (!pSlot->created) {
+    code = tBlockDataCreate(&pSlot->data);
+    if (code != TSDB_CODE_SUCCESS) {
+      return code;
+    }
+    pSlot->created = true;
+  }
+
+  if (!VNODE_ASYNC_VALID_CHANNEL_ID(pPrefetch->channel)) {
+    code = vnodeAChannelInit(vnodeAsyncHandle[2], &pPrefetch->channel);
+    if (code != TSDB_CODE_SUCCESS) {
+      return code;
+    }
+  }
+
+  if (pPrefetch->pFileReader == NULL) {
+    SDataFileReaderConfig conf = {0};
+    const char*           filesName[4] = {0};
+
+    initDataFileReaderConf(pReader, pReader->status.pCurrentFileset, &conf, filesName);
+    code = tsdbDataFileReaderOpen(filesName, &conf, &pPrefetch->pFileReader);
+    if (code != TSDB_CODE_SUCCESS) {
+      return code;
+    }
+  }
+
+  blockInfoToRecord(&pSlot->record, pBlockInfo, &pReader->suppInfo);
+  pSlot->index = index;
+  pSlot->code = TSDB_CODE_SUCCESS;
+  pSlot->pSchema = pReader->info.pSchema;
+  pSlot->pReader = pReader;
+
+  code = vnodeAsyncC(vnodeAsyncHandle[2], pPrefetch->channel, EVA_PRIORITY_NORMAL, doPrefetchBlockTask, NULL, pSlot,
+                     &pSlot->taskId);
+  if (code == TSDB_CODE_SUCCESS) {
+    pSlot->used = true;
+    pReader->cost.prefetchBlocks += 1;
+  }
+
+  return code;
+}
+
+// a block that may be answered by its SMA is left to be loaded on demand, unless all blocks are read ahead
+static bool fileBlockNeedReadAhead(STsdbReader* pReader, SDataBlockIter* pBlockIter, SFileDataBlockInfo* pBlockInfo,
+                                   int32_t readAhead) {
+  if (readAhead == TSDB_READ_AHEAD_ALL) {
+    return true;
+  }
+
+  STableBlockScanInfo* pScanInfo = getTableBlockScanInfo(pReader->status.pTableMap, pBlockInfo->uid, pReader->idStr);
+  if (pScanInfo == NULL) {
+    return false;
+  }
+
+  SFileDataBlockInfo* pNeighbor = NULL;
+  int32_t             neighborIdx = pBlockInfo->tbBlockIdx + (ASCENDING_TRAVERSE(pReader->info.order) ? 1 : -1);
+  if (neighborIdx >= 0 && neighborIdx < taosArrayGetSize(pScanInfo->pBlockIdxList)) {
+    STableDataBlockIdx* pIdx = taosArrayGet(pScanInfo->pBlockIdxList, neighborIdx);
+    pNeighbor = taosArrayGet(pBlockIter->blockList, pIdx->globalIndex);
+  }
+
+  return !fileBlockMayUseSma(pBlockInfo, pNeighbor, &pReader->info.window, &pReader->info.verRange,
+                             pReader->resBlockInfo.capacity, pReader->info.order);
+}
+
+// drop the prefetched blocks that have been skipped, and issue the following ones up to the current depth
+static void doBlockPrefetch(STsdbReader* pReader, SDataBlockIter* pBlockIter, SBlockPrefetchSlot* pCurrent) {
+  SBlockPrefetch* pPrefetch = &pReader->prefetch;
+  bool            asc = ASCENDING_TRAVERSE(pBlockIter->order);
+  int32_t         step = asc ? 1 : -1;
+  int32_t         index = pBlockIter->index;
+  int32_t         readAhead = atomic_load_32(&tsTsdbReadAhead);
+
+  if (vnodeAsyncHandle[2] == NULL || pReader->info.pSchema == NULL) {
+    return;
+  }
+
+  if (pPrefetch->depth == 0) {
+    pPrefetch->depth = TSDB_PREFETCH_INIT_DEPTH;
+  }
+
+  for (int32_t i = 0; i < TSDB_PREFETCH_MAX_DEPTH; ++i) {
+    SBlockPrefetchSlot* pSlot = &pPrefetch->slots[i];
+    if (pSlot == pCurrent || !pSlot->used) {
+      continue;
+    }
+
+    if ((asc && pSlot->index <= index) || (!asc && pSlot->index >= index)) {
+      releasePrefetchSlot(pSlot);
+      pPrefetch->depth = TMAX(pPrefetch->depth / 2, 1);
+    }
+  }
+
+  if (readAhead == TSDB_READ_AHEAD_OFF) {
+    return;
+  }
+
+  for (int32_t k = 1; k <= pPrefetch->depth; ++k) {
+    int32_t next = index + step * k;
+    if (next < 0 || next >= pBlockIter->numOfBlocks) {
+      break;
+    }
+
+    SFileDataBlockInfo* pNext = taosArrayGet(pBlockIter->blockList, next);
+    if (getPrefetchSlot(pPrefetch, pNext) != NULL || !fileBlockNeedReadAhead(pReader, pBlockIter, pNext, readAhead)) {
+      continue;
+    }
+
+    SBlockPrefetchSlot* pFree = NULL;
+    for (int32_t i = 0; i < TSDB_PREFETCH_MAX_DEPTH; ++i) {
+      if (!pPrefetch->slots[i].used && &pPrefetch->slots[i] != pCurrent) {
+        pFree = &pPrefetch->slots[i];
+        break;
+      }
+    }
+
+    if (pFree == NULL) {
+      break;
+    }
+
+    int32_t code = issueBlockPrefetch(pReader, pBlockIter, pFree, next);
+    if (code != TSDB_CODE_SUCCESS) {
+      tsdbWarn("%p failed to prefetch file block, global index:%d, code:%s %s", pReader, next, tstrerror(code),
+               pReader->idStr);
+      break;
+    }
+  }
+}
+
+// take over the block loaded in background if it is the one required, return false if not prefetched or failed
+static bool getPrefetchedBlockData(STsdbReader* pReader, SBlockPrefetchSlot* pSlot, SBlockData* pBlockData) {
+  SBlockPrefetch* pPrefetch = &pReader->prefetch;
+  int64_t         st = taosGetTimestampUs();
+
+  (void)vnodeAWait(vnodeAsyncHandle[2], pSlot->taskId);
+  pReader->cost.prefetchWaitTime += (taosGetTimestampUs() - st) / 1000.0;
+  pSlot->used = false;
+
+  if (pSlot->code != TSDB_CODE_SUCCESS || pSlot->pSchema != pReader->info.pSchema) {
+    tsdbDebug("%p prefetched file block is discarded, offset:%" PRId64 ", code:%s %s", pReader,
+              pSlot->record.blockOffset, tstrerror(pSlot->code), pReader->idStr);
+    return false;
+  }
+
+  SBlockData tmp = *pBlockData;
+  *pBlockData = pSlot->data;
+  pSlot->data = tmp;
+
+  pPrefetch->depth = TMIN(pPrefetch->depth + 1, TSDB_PREFETCH_MAX_DEPTH);
+  pReader->cost.prefetchDepth = TMAX(pReader->cost.prefetchDepth, pPrefetch->depth);
+  pReader->cost.prefetchHits += 1;
+  return true;
+}
+
 static int32_t doLoadFileBlockData(STsdbReader* pReader, SDataBlockIter* pBlockIter, SBlockData* pBlockData,
                                    uint64_t uid) {
   int32_t   code = 0;
@@ -1326,8 +1559,16 @@ static int32_t doLoadFileBlockData(STsdbReader* pReader, SDataBlockIter* pBlockI
   SBrinRecord tmp;
   blockInfoToRecord(&tmp, pBlockInfo, pSup);
   SBrinRecord* pRecord = &tmp;
-  code = tsdbDataFileReadBlockDataByColumn(pReader->pFileReader, pRecord, pBlockData, pSchema, &pSup->colId[1],
-                                           pSup->numOfCols - 1);
+
+  // the following blocks are read in background while this one is being loaded and consumed
+  SBlockPrefetchSlot* pSlot = getPrefetchSlot(&pReader->prefetch, pBlockInfo);
+  doBlockPrefetch(pReader, pBlockIter, pSlot);
+
+  if (pSlot == NULL || !getPrefetchedBlockData(pReader, pSlot, pBlockData)) {
+    code = tsdbDataFileReadBlockDataByColumn(pReader->pFileReader, pRecord, pBlockData, pSchema, &pSup->colId[1],
+                                             pSup->numOfCols - 1);
+  }
+
   if (code != TSDB_CODE_SUCCESS) {
     tsdbError("%p error occurs in loading file block, global index:%d, table index:%d, brange:%" PRId64 "-%" PRId64
               ", rows:%d, code:%s %s",
@@ -1352,13 +1593,6 @@ static int32_t doLoadFileBlockData(STsdbReader* pReader, SDataBlockIter* pBlockI
 /**
  * This is an two rectangles overlap cases.
  */
-static int32_t dataBlockPartiallyRequired(STimeWindow* pWindow, SVersionRange* pVerRange, SFileDataBlockInfo* pBlock) {
-  return (pWindow->ekey < pBlock->lastKey && pWindow->ekey >= pBlock->firstKey) ||
-         (pWindow->skey > pBlock->firstKey && pWindow->skey <= pBlock->lastKey) ||
-         (pVerRange->minVer > pBlock->minVer && pVerRange->minVer <= pBlock->maxVer) ||
-         (pVerRange->maxVer < pBlock->maxVer && pVerRange->maxVer >= pBlock->minVer);
-}
-
 static bool getNeighborBlockOfTable(SDataBlockIter* pBlockIter, SFileDataBlockInfo* pBlockInfo,
                                     STableBlockScanInfo* pScanInfo, int32_t* nextIndex, int32_t order,
                                     SBrinRecord* pRecord, SBlockLoadSuppInfo* pSupInfo) {
@@ -4385,6 +4619,8 @@ void tsdbReaderClose2(STsdbReader* pReader) {
 
   SBlockLoadSuppInfo* pSupInfo = &pReader->suppInfo;
   TARRAY2_DESTROY(&pSupInfo->colAggArray, NULL);
+  TARRAY2_DESTROY(&pSupInfo->colBloomArray, tColumnDataBloomClear);
+  tBufferDestroy(&pSupInfo->bloomBuf);
   for (int32_t i = 0; i < pSupInfo->numOfCols; ++i) {
     if (pSupInfo->buildBuf[i] != NULL) {
       taosMemoryFreeClear(pSupInfo->buildBuf[i]);
@@ -4406,6 +4642,7 @@ void tsdbReaderClose2(STsdbReader* pReader) {
   }
   clearBlockScanInfoBuf(&pReader->blockInfoBuf);
 
+  destroyBlockPrefetch(pReader);
   if (pReader->pFileReader != NULL) {
     tsdbDataFileReaderClose(&pReader->pFileReader);
   }
@@ -4440,12 +4677,14 @@ void tsdbReaderClose2(STsdbReader* pReader) {
       "build in-memory-block-time:%.2f ms, sttBlocks:%" PRId64 ", sttBlocks-time:%.2f ms, sttStatisBlock:%" PRId64
       ", stt-statis-Block-time:%.2f ms, composed-blocks:%" PRId64
       ", composed-blocks-time:%.2fms, STableBlockScanInfo size:%.2f Kb, createTime:%.2f ms,createSkylineIterTime:%.2f "
-      "ms, initSttBlockReader:%.2fms, %s",
+      "ms, initSttBlockReader:%.2fms, prefetchBlocks:%" PRId64 ", prefetchHits:%" PRId64
+      ", prefetch-wait-time:%.2f ms, prefetchDepth:%d, %s",
       pReader, pCost->headFileLoad, pCost->headFileLoadTime, pCost->smaDataLoad, pCost->smaLoadTime, pCost->numOfBlocks,
       pCost->blockLoadTime, pCost->buildmemBlock, pCost->sttCost.loadBlocks, pCost->sttCost.blockElapsedTime,
       pCost->sttCost.loadStatisBlocks, pCost->sttCost.statisElapsedTime, pCost->composedBlocks,
       pCost->buildComposedBlockTime, numOfTables * sizeof(STableBlockScanInfo) / 1000.0, pCost->createScanInfoList,
-      pCost->createSkylineIterTime, pCost->initSttBlockReader, pReader->idStr);
+      pCost->createSkylineIterTime, pCost->initSttBlockReader, pCost->prefetchBlocks, pCost->prefetchHits,
+      pCost->prefetchWaitTime, pCost->prefetchDepth, pReader->idStr);
 
   taosMemoryFree(pReader->idStr);
 
@@ -4460,6 +4699,7 @@ static int32_t doSuspendCurrentReader(STsdbReader* pCurrentReader) {
   SReaderStatus* pStatus = &pCurrentReader->status;
 
   if (pStatus->loadFromFile) {
+    stopBlockPrefetch(pCurrentReader);
     tsdbDataFileReaderClose(&pCurrentReader->pFileReader);
 
     SReadCostSummary* pCost = &pCurrentReader->cost;
@@ -4887,6 +5127,19 @@ static void doFillNullColSMA(SBlockLoadSuppInfo* pSup, int32_t numOfRows, int32_
   }
 }
 
+static void setBlockSmaLoaded(SBlockLoadSuppInfo* pSup, const SBrinRecord* pRecord, bool loaded) {
+  pSup->smaKey.loaded = loaded;
+  pSup->smaKey.bloomDecoded = false;
+  pSup->smaKey.uid = pRecord->uid;
+  pSup->smaKey.offset = pRecord->smaOffset;
+  pSup->smaKey.minVer = pRecord->minVer;
+}
+
+static bool isBlockSmaLoaded(const SBlockLoadSuppInfo* pSup, const SBrinRecord* pRecord) {
+  return pSup->smaKey.loaded && pSup->smaKey.uid == pRecord->uid && pSup->smaKey.offset == pRecord->smaOffset &&
+         pSup->smaKey.minVer == pRecord->minVer;
+}
+
 int32_t tsdbRetrieveDatablockSMA2(STsdbReader* pReader, SSDataBlock* pDataBlock, bool* allHave, bool* hasNullSMA) {
   SColumnDataAgg*** pBlockSMA = &pDataBlock->pBlockAgg;
 
@@ -4916,7 +5169,8 @@ int32_t tsdbRetrieveDatablockSMA2(STsdbReader* pReader, SSDataBlock* pDataBlock,
 
   SBrinRecord pRecord;
   blockInfoToRecord(&pRecord, pBlockInfo, pSup);
-  code = tsdbDataFileReadBlockSma(pReader->pFileReader, &pRecord, &pSup->colAggArray);
+  code = tsdbDataFileReadBlockSma(pReader->pFileReader, &pRecord, &pSup->colAggArray, &pSup->bloomBuf);
+  setBlockSmaLoaded(pSup, &pRecord, code == TSDB_CODE_SUCCESS);
   if (code != TSDB_CODE_SUCCESS) {
     tsdbDebug("vgId:%d, failed to load block SMA for uid %" PRIu64 ", code:%s, %s", 0, pBlockInfo->uid, tstrerror(code),
               pReader->idStr);
@@ -4977,6 +5231,65 @@ int32_t tsdbRetrieveDatablockSMA2(STsdbReader* pReader, SSDataBlock* pDataBlock,
   return code;
 }
 
+int32_t tsdbRetrieveDatablockBloom2(STsdbReader* pReader, SColumnDataBloom** pBlooms, int32_t* numOfBlooms) {
+  *pBlooms = NULL;
+  *numOfBlooms = 0;
+
+  if (pReader->type == TIMEWINDOW_RANGE_EXTERNAL) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  // the bloom filter only covers the rows of a file block
+  if (pReader->status.composedDataBlock) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  SFileDataBlockInfo* pBlockInfo = getCurrentBlockInfo(&pReader->status.blockIter);
+  SBlockLoadSuppInfo* pSup = &pReader->suppInfo;
+
+  if (pReader->resBlockInfo.pResBlock->info.id.uid != pBlockInfo->uid) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  int32_t     code = TSDB_CODE_SUCCESS;
+  SBrinRecord record;
+  blockInfoToRecord(&record, pBlockInfo, pSup);
+
+  // the bloom filters come along with the block SMA, which is usually loaded for the block filter already
+  if (!isBlockSmaLoaded(pSup, &record)) {
+    // blocks are written without bloom filters unless enabled, do not read the .sma block again only to find none
+    if (!tsTsdbBloomFilter) {
+      return TSDB_CODE_SUCCESS;
+    }
+
+    code = tsdbDataFileReadBlockSma(pReader->pFileReader, &record, NULL, &pSup->bloomBuf);
+    setBlockSmaLoaded(pSup, &record, code == TSDB_CODE_SUCCESS);
+    if (code != TSDB_CODE_SUCCESS) {
+      tsdbDebug("vgId:%d, failed to load block bloom filter for uid %" PRIu64 ", code:%s, %s", 0, pBlockInfo->uid,
+                tstrerror(code), pReader->idStr);
+      return code;
+    }
+  }
+
+  if (tBufferGetSize(&pSup->bloomBuf) == 0) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  if (!pSup->smaKey.bloomDecoded) {
+    code = tsdbDataFileDecodeBlockBloom(&pSup->bloomBuf, &pSup->colBloomArray);
+    if (code != TSDB_CODE_SUCCESS) {
+      tsdbDebug("vgId:%d, failed to decode block bloom filter for uid %" PRIu64 ", code:%s, %s", 0, pBlockInfo->uid,
+                tstrerror(code), pReader->idStr);
+      return code;
+    }
+    pSup->smaKey.bloomDecoded = true;
+  }
+
+  *pBlooms = TARRAY2_DATA(&pSup->colBloomArray);
+  *numOfBlooms = TARRAY2_SIZE(&pSup->colBloomArray);
+  return code;
+}
+
 static SSDataBlock* doRetrieveDataBlock(STsdbReader* pReader) {
   SReaderStatus*      pStatus = &pReader->status;
   int32_t             code = TSDB_CODE_SUCCESS;
@@ -5071,6 +5384,7 @@ int32_t tsdbReaderReset2(STsdbReader* pReader, SQueryTableDataCond* pCond) {
   memset(&pReader->suppInfo.tsColAgg, 0, sizeof(SColumnDataAgg));
 
   pReader->suppInfo.tsColAgg.colId = PRIMARYKEY_TIMESTAMP_COL_ID;
+  stopBlockPrefetch(pReader);
   tsdbDataFileReaderClose(&pReader->pFileReader);
 
   int32_t numOfTables = tSimpleHashGetSize(pStatus->pTableMap);
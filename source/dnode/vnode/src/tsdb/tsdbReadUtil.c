@@ -1094,6 +1094,33 @@ bool isCleanSttBlock(SArray* pKeyRangeList, STimeWindow* pQueryWindow, STableBlo
   return true;
 }
 
+int32_t dataBlockPartiallyRequired(const STimeWindow* pWindow, const SVersionRange* pVerRange,
+                                   const SFileDataBlockInfo* pBlock) {
+  return (pWindow->ekey < pBlock->lastKey && pWindow->ekey >= pBlock->firstKey) ||
+         (pWindow->skey > pBlock->firstKey && pWindow->skey <= pBlock->lastKey) ||
+         (pVerRange->minVer > pBlock->minVer && pVerRange->minVer <= pBlock->maxVer) ||
+         (pVerRange->maxVer < pBlock->maxVer && pVerRange->maxVer >= pBlock->minVer);
+}
+
+// the file block may be returned as a whole without being loaded, and answered by its SMA. Only the static attributes
+// are checked, a block overlapping with the stt, the buffer or the delete data may still need to be loaded.
+bool fileBlockMayUseSma(const SFileDataBlockInfo* pBlock, const SFileDataBlockInfo* pNeighbor,
+                        const STimeWindow* pWindow, const SVersionRange* pVerRange, int32_t capacity, int32_t order) {
+  if ((pBlock->numRow > pBlock->count) || (pBlock->count <= 0) || (pBlock->numRow > capacity) ||
+      dataBlockPartiallyRequired(pWindow, pVerRange, pBlock)) {
+    return false;
+  }
+
+  if (pNeighbor != NULL) {
+    if (ASCENDING_TRAVERSE(order) ? (pBlock->lastKey >= pNeighbor->firstKey)
+                                  : (pBlock->firstKey <= pNeighbor->lastKey)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
 static bool doCheckDatablockOverlap(STableBlockScanInfo* pBlockScanInfo, const SBrinRecord* pRecord,
                                     int32_t startIndex) {
   size_t num = taosArrayGetSize(pBlockScanInfo->delSkyline);
@@ -147,6 +147,10 @@ typedef struct SReadCostSummary {
   double  createScanInfoList;
   double  createSkylineIterTime;
   double  initSttBlockReader;
+  int64_t prefetchBlocks;    // file blocks loaded by the read-ahead
+  int64_t prefetchHits;      // prefetched file blocks that are consumed
+  double  prefetchWaitTime;  // time waiting for the prefetched blocks
+  int32_t prefetchDepth;     // max read-ahead depth reached
 } SReadCostSummary;
 
 typedef struct STableUidList {
@@ -172,9 +176,20 @@ typedef struct SBlockOrderSupporter {
   int32_t              numOfTables;
 } SBlockOrderSupporter;
 
+typedef struct SBlockSmaKey {
+  bool     loaded;
+  bool     bloomDecoded;
+  uint64_t uid;
+  int64_t  offset;
+  int64_t  minVer;
+} SBlockSmaKey;
+
 typedef struct SBlockLoadSuppInfo {
-  TColumnDataAggArray colAggArray;
-  SColumnDataAgg      tsColAgg;
+  TColumnDataAggArray   colAggArray;
+  TColumnDataBloomArray colBloomArray;
+  SBuffer               bloomBuf;  // encoded bloom filters of the .sma block loaded last, decoded on the first probe
+  SBlockSmaKey          smaKey;    // the .sma block loaded last
+  SColumnDataAgg        tsColAgg;
   int16_t*            colId;
   int16_t*            slotId;
   char**              buildBuf;  // build string tmp buffer, todo remove it later after all string format being updated.
@@ -275,6 +290,35 @@ typedef struct SReaderStatus {
   STableBlockScanInfo** pProcMemTableIter;
 } SReaderStatus;
 
+#define TSDB_PREFETCH_INIT_DEPTH 2
+#define TSDB_PREFETCH_MAX_DEPTH  8
+
+// values of tsTsdbReadAhead
+#define TSDB_READ_AHEAD_OFF  0
+#define TSDB_READ_AHEAD_LOAD 1  // only the blocks that can not be answered by SMA
+#define TSDB_READ_AHEAD_ALL  2
+
+typedef struct SBlockPrefetchSlot {
+  bool         used;
+  bool         created;
+  int32_t      index;  // position in SDataBlockIter when it is issued
+  int64_t      taskId;
+  int32_t      code;
+  STSchema*    pSchema;
+  SBrinRecord  record;
+  SBlockData   data;
+  STsdbReader* pReader;
+} SBlockPrefetchSlot;
+
+// read-ahead of the file blocks following the current one in SDataBlockIter, loaded and decompressed in the
+// vnode-read pool. The depth grows when the prefetched blocks are consumed and shrinks when they are skipped.
+typedef struct SBlockPrefetch {
+  int32_t            depth;
+  int64_t            channel;      // tasks of one reader run one by one, since they share the file reader
+  SDataFileReader*   pFileReader;  // file reader of the current fileset used by the background tasks only
+  SBlockPrefetchSlot slots[TSDB_PREFETCH_MAX_DEPTH];
+} SBlockPrefetch;
+
 struct STsdbReader {
   STsdb*             pTsdb;
   STsdbReaderInfo    info;
@@ -292,6 +336,7 @@ struct STsdbReader {
   SHashObj**         pIgnoreTables;
   SSHashObj*         pSchemaMap;   // keep the retrieved schema info, to avoid the overhead by repeatly load schema
   SDataFileReader*   pFileReader;  // the file reader
+  SBlockPrefetch     prefetch;
   SBlockInfoBuf      blockInfoBuf;
   EContentData       step;
   STsdbReader*       innerReader[2];
@@ -350,6 +395,10 @@ int32_t tsdbGetRowsInSttFiles(STFileSet* pFileSet, SArray* pSttFileBlockIterArra
                               const char* pstr);
 bool    isCleanSttBlock(SArray* pTimewindowList, STimeWindow* pQueryWindow, STableBlockScanInfo* pScanInfo, int32_t order);
 bool    overlapWithDelSkyline(STableBlockScanInfo* pBlockScanInfo, const SBrinRecord* pRecord, int32_t order);
+int32_t dataBlockPartiallyRequired(const STimeWindow* pWindow, const SVersionRange* pVerRange,
+                                   const SFileDataBlockInfo* pBlock);
+bool    fileBlockMayUseSma(const SFileDataBlockInfo* pBlock, const SFileDataBlockInfo* pNeighbor,
+                           const STimeWindow* pWindow, const SVersionRange* pVerRange, int32_t capacity, int32_t order);
 int32_t pkCompEx(SRowKey* p1, SRowKey* p2);
 int32_t initRowKey(SRowKey* pKey, int64_t ts, int32_t numOfPks, int32_t type, int32_t len, bool asc);
 void    clearRowKey(SRowKey* pKey);
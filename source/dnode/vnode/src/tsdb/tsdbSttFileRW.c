@@ -933,6 +933,29 @@ _exit:
   return code;
 }
 
+static int32_t tsdbSttFilePutStatis(SSttFileWriter *writer, SRowInfo *row) {
+  int32_t code = 0;
+  int32_t lino = 0;
+
+  for (;;) {
+    code = tStatisBlockPut(writer->staticBlock, row, writer->config->maxRow);
+    if (code == TSDB_CODE_INVALID_PARA) {
+      code = tsdbSttFileDoWriteStatisBlock(writer);
+      TSDB_CHECK_CODE(code, lino, _exit);
+      continue;
+    } else {
+      TSDB_CHECK_CODE(code, lino, _exit);
+    }
+    break;
+  }
+
+_exit:
+  if (code) {
+    TSDB_ERROR_LOG(TD_VID(writer->config->tsdb->pVnode), lino, code);
+  }
+  return code;
+}
+
 int32_t tsdbSttFileWriteRow(SSttFileWriter *writer, SRowInfo *row) {
   int32_t code = 0;
   int32_t lino = 0;
@@ -962,17 +985,8 @@ int32_t tsdbSttFileWriteRow(SSttFileWriter *writer, SRowInfo *row) {
   STsdbRowKey key;
   tsdbRowGetKey(&row->row, &key);
 
-  for (;;) {
-    code = tStatisBlockPut(writer->staticBlock, row, writer->config->maxRow);
-    if (code == TSDB_CODE_INVALID_PARA) {
-      code = tsdbSttFileDoWriteStatisBlock(writer);
-      TSDB_CHECK_CODE(code, lino, _exit);
-      continue;
-    } else {
-      TSDB_CHECK_CODE(code, lino, _exit);
-    }
-    break;
-  }
+  code = tsdbSttFilePutStatis(writer, row);
+  TSDB_CHECK_CODE(code, lino, _exit);
 
   if (row->row.type == TSDBROW_ROW_FMT) {
     code = tsdbUpdateSkmRow(writer->config->tsdb, writer->ctx->tbid,  //
@@ -1008,6 +1022,46 @@ _exit:
   return code;
 }
 
+// nRow rows of one table in a block, from row->row on and with increasing keys, copied column by column
+int32_t tsdbSttFileWriteBlockRows(SSttFileWriter *writer, SRowInfo *row, int32_t nRow) {
+  int32_t code = 0;
+  int32_t lino = 0;
+
+  ASSERT(row->row.type == TSDBROW_COL_FMT);
+
+  // the first row opens the file, switches the schema and merges with the last row written
+  code = tsdbSttFileWriteRow(writer, row);
+  TSDB_CHECK_CODE(code, lino, _exit);
+
+  SBlockData *pBlockDataFrom = row->row.pBlockData;
+  int32_t     iRow = row->row.iRow + 1;
+  int32_t     eRow = row->row.iRow + nRow;
+
+  SRowInfo rowInfo = *row;
+  for (rowInfo.row.iRow = iRow; rowInfo.row.iRow < eRow; rowInfo.row.iRow++) {
+    code = tsdbSttFilePutStatis(writer, &rowInfo);
+    TSDB_CHECK_CODE(code, lino, _exit);
+  }
+
+  while (iRow < eRow) {
+    if (writer->blockData->nRow >= writer->config->maxRow) {
+      code = tsdbSttFileDoWriteBlockData(writer);
+      TSDB_CHECK_CODE(code, lino, _exit);
+    }
+
+    int32_t n = TMIN(eRow - iRow, writer->config->maxRow - writer->blockData->nRow);
+    code = tBlockDataAppendBlockRows(writer->blockData, pBlockDataFrom, iRow, n, row->uid);
+    TSDB_CHECK_CODE(code, lino, _exit);
+    iRow += n;
+  }
+
+_exit:
+  if (code) {
+    TSDB_ERROR_LOG(TD_VID(writer->config->tsdb->pVnode), lino, code);
+  }
+  return code;
+}
+
 int32_t tsdbSttFileWriteBlockData(SSttFileWriter *writer, SBlockData *bdata) {
   int32_t code = 0;
   int32_t lino = 0;
@@ -13,6 +13,7 @@
  * along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include "tbloomfilter.h"
 #include "tcompression.h"
 #include "tdataformat.h"
 #include "tsdb.h"
@@ -1346,6 +1347,67 @@ int32_t tBlockDataAppendRow(SBlockData *pBlockData, TSDBROW *pRow, STSchema *pTS
 _exit:
   return code;
 }
+
+// rows [iRow, iRow + nRow) of one table appended column by column, in key order after the rows of pBlockData
+int32_t tBlockDataAppendBlockRows(SBlockData *pBlockData, SBlockData *pBlockDataFrom, int32_t iRow, int32_t nRow,
+                                  int64_t uid) {
+  int32_t code = 0;
+
+  ASSERT(pBlockData->suid || pBlockData->uid);
+  ASSERT(iRow >= 0 && iRow + nRow <= pBlockDataFrom->nRow);
+
+  if (nRow <= 0) goto _exit;
+
+  // uid
+  if (pBlockData->uid == 0) {
+    ASSERT(uid);
+    code = tRealloc((uint8_t **)&pBlockData->aUid, sizeof(int64_t) * (pBlockData->nRow + nRow));
+    if (code) goto _exit;
+    for (int32_t i = 0; i < nRow; i++) {
+      pBlockData->aUid[pBlockData->nRow + i] = uid;
+    }
+  }
+  // version
+  code = tRealloc((uint8_t **)&pBlockData->aVersion, sizeof(int64_t) * (pBlockData->nRow + nRow));
+  if (code) goto _exit;
+  memcpy(pBlockData->aVersion + pBlockData->nRow, pBlockDataFrom->aVersion + iRow, sizeof(int64_t) * nRow);
+  // timestamp
+  code = tRealloc((uint8_t **)&pBlockData->aTSKEY, sizeof(TSKEY) * (pBlockData->nRow + nRow));
+  if (code) goto _exit;
+  memcpy(pBlockData->aTSKEY + pBlockData->nRow, pBlockDataFrom->aTSKEY + iRow, sizeof(TSKEY) * nRow);
+
+  // other columns
+  SColVal   cv = {0};
+  int32_t   iColDataFrom = 0;
+  SColData *pColDataFrom = (iColDataFrom < pBlockDataFrom->nColData) ? &pBlockDataFrom->aColData[iColDataFrom] : NULL;
+
+  for (int32_t iColDataTo = 0; iColDataTo < pBlockData->nColData; iColDataTo++) {
+    SColData *pColDataTo = &pBlockData->aColData[iColDataTo];
+
+    while (pColDataFrom && pColDataFrom->cid < pColDataTo->cid) {
+      pColDataFrom = (++iColDataFrom < pBlockDataFrom->nColData) ? &pBlockDataFrom->aColData[iColDataFrom] : NULL;
+    }
+
+    if (pColDataFrom == NULL || pColDataFrom->cid > pColDataTo->cid) {
+      cv = COL_VAL_NONE(pColDataTo->cid, pColDataTo->type);
+      for (int32_t i = 0; i < nRow; i++) {
+        if ((code = tColDataAppendValue(pColDataTo, &cv))) goto _exit;
+      }
+    } else {
+      for (int32_t i = iRow; i < iRow + nRow; i++) {
+        tColDataGetValue(pColDataFrom, i, &cv);
+        if ((code = tColDataAppendValue(pColDataTo, &cv))) goto _exit;
+      }
+
+      pColDataFrom = (++iColDataFrom < pBlockDataFrom->nColData) ? &pBlockDataFrom->aColData[iColDataFrom] : NULL;
+    }
+  }
+  pBlockData->nRow += nRow;
+
+_exit:
+  return code;
+}
+
 int32_t tBlockDataUpdateRow(SBlockData *pBlockData, TSDBROW *pRow, STSchema *pTSchema) {
   int32_t code = 0;
 
@@ -1622,6 +1684,154 @@ int32_t tGetColumnDataAgg(SBufferReader *br, SColumnDataAgg *pColAgg) {
   return 0;
 }
 
+// SColumnDataBloom ======================================================
+#define TSDB_BLOOM_ERROR_RATE 0.01
+
+typedef struct {
+  uint64_t h1;
+  uint64_t h2;
+} SBloomHash;
+
+static int32_t tBloomHashCmprFn(const void *p1, const void *p2) {
+  const SBloomHash *pHash1 = (const SBloomHash *)p1;
+  const SBloomHash *pHash2 = (const SBloomHash *)p2;
+
+  if (pHash1->h1 < pHash2->h1) return -1;
+  if (pHash1->h1 > pHash2->h1) return 1;
+  if (pHash1->h2 < pHash2->h2) return -1;
+  if (pHash1->h2 > pHash2->h2) return 1;
+  return 0;
+}
+
+bool tColDataBloomSupported(int8_t type) {
+  // float/double are left out since equal values may differ in bytes (+0/-0)
+  switch (type) {
+    case TSDB_DATA_TYPE_BOOL:
+    case TSDB_DATA_TYPE_TINYINT:
+    case TSDB_DATA_TYPE_SMALLINT:
+    case TSDB_DATA_TYPE_INT:
+    case TSDB_DATA_TYPE_BIGINT:
+    case TSDB_DATA_TYPE_TIMESTAMP:
+    case TSDB_DATA_TYPE_UTINYINT:
+    case TSDB_DATA_TYPE_USMALLINT:
+    case TSDB_DATA_TYPE_UINT:
+    case TSDB_DATA_TYPE_UBIGINT:
+    case TSDB_DATA_TYPE_VARCHAR:
+    case TSDB_DATA_TYPE_VARBINARY:
+    case TSDB_DATA_TYPE_NCHAR:
+      return true;
+    default:
+      return false;
+  }
+}
+
+/*
+ * Build a bloom filter over the values of the column and put it to the buffer. The filter is sized by the number of
+ * distinct values so that low cardinality columns get a small one. The key of a value is its raw bytes, without the
+ * var-data header, which is the same key the block filter probes with.
+ */
+int32_t tPutColumnDataBloom(SBuffer *buffer, SColData *pColData) {
+  int32_t       code = 0;
+  int32_t       nHash = 0;
+  SBloomHash   *aHash = NULL;
+  SBloomFilter *pBF = NULL;
+
+  aHash = taosMemoryMalloc(sizeof(SBloomHash) * pColData->nVal);
+  if (aHash == NULL) {
+    code = TSDB_CODE_OUT_OF_MEMORY;
+    goto _exit;
+  }
+
+  for (int32_t iVal = 0; iVal < pColData->nVal; ++iVal) {
+    SColVal cv;
+    tColDataGetValue(pColData, iVal, &cv);
+    if (!COL_VAL_IS_VALUE(&cv)) continue;
+
+    const char *key;
+    uint32_t    len;
+    if (IS_VAR_DATA_TYPE(pColData->type)) {
+      key = (const char *)cv.value.pData;
+      len = cv.value.nData;
+    } else {
+      key = (const char *)&cv.value.val;
+      len = tDataTypes[pColData->type].bytes;
+    }
+
+    aHash[nHash].h1 = HASH_FUNCTION_1(key, len);
+    aHash[nHash].h2 = HASH_FUNCTION_2(key, len);
+    nHash++;
+  }
+  if (nHash == 0) goto _exit;
+
+  taosSort(aHash, nHash, sizeof(SBloomHash), tBloomHashCmprFn);
+
+  int32_t nDistinct = 1;
+  for (int32_t i = 1; i < nHash; ++i) {
+    if (tBloomHashCmprFn(&aHash[i - 1], &aHash[i]) != 0) {
+      aHash[nDistinct++] = aHash[i];
+    }
+  }
+
+  pBF = tBloomFilterInit(nDistinct, TSDB_BLOOM_ERROR_RATE);
+  if (pBF == NULL) {
+    code = TSDB_CODE_OUT_OF_MEMORY;
+    goto _exit;
+  }
+  for (int32_t i = 0; i < nDistinct; ++i) {
+    tBloomFilterPutHash(pBF, aHash[i].h1, aHash[i].h2);
+  }
+
+  if ((code = tBufferPutI16v(buffer, pColData->cid))) goto _exit;
+  if ((code = tBufferPutU32v(buffer, pBF->hashFunctions))) goto _exit;
+  if ((code = tBufferPutU32v(buffer, (uint32_t)pBF->numUnits))) goto _exit;
+  if ((code = tBufferPut(buffer, pBF->buffer, sizeof(uint64_t) * pBF->numUnits))) goto _exit;
+
+_exit:
+  tBloomFilterDestroy(pBF);
+  taosMemoryFree(aHash);
+  return code;
+}
+
+int32_t tGetColumnDataBloom(SBufferReader *br, SColumnDataBloom *pColBloom) {
+  int32_t  code;
+  uint32_t hashFunctions;
+  uint32_t numUnits;
+
+  pColBloom->pBloom = NULL;
+  if ((code = tBufferGetI16v(br, &pColBloom->colId))) return code;
+  if ((code = tBufferGetU32v(br, &hashFunctions))) return code;
+  if ((code = tBufferGetU32v(br, &numUnits))) return code;
+  if (hashFunctions == 0 || numUnits == 0) return TSDB_CODE_FILE_CORRUPTED;
+
+  SBloomFilter *pBF = taosMemoryCalloc(1, sizeof(*pBF));
+  if (pBF == NULL) return TSDB_CODE_OUT_OF_MEMORY;
+
+  pBF->hashFunctions = hashFunctions;
+  pBF->numUnits = numUnits;
+  pBF->numBits = (uint64_t)numUnits * 64;
+  pBF->hashFn1 = HASH_FUNCTION_1;
+  pBF->hashFn2 = HASH_FUNCTION_2;
+  pBF->errorRate = TSDB_BLOOM_ERROR_RATE;
+  pBF->buffer = taosMemoryMalloc(sizeof(uint64_t) * numUnits);
+  if (pBF->buffer == NULL) {
+    tBloomFilterDestroy(pBF);
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+  if ((code = tBufferGet(br, sizeof(uint64_t) * numUnits, pBF->buffer))) {
+    tBloomFilterDestroy(pBF);
+    return code;
+  }
+
+  pColBloom->pBloom = pBF;
+  return 0;
+}
+
+void tColumnDataBloomClear(void *pColBloom) {
+  SColumnDataBloom *p = (SColumnDataBloom *)pColBloom;
+  tBloomFilterDestroy(p->pBloom);
+  p->pBloom = NULL;
+}
+
 static int32_t tBlockDataCompressKeyPart(SBlockData *bData, SDiskDataHdr *hdr, SBuffer *buffer, SBuffer *assist,
                                          SColCompressInfo *compressInfo) {
   int32_t       code = 0;
@@ -57,6 +57,7 @@ struct SVATask {
   void (*complete)(void *);
   void        *arg;
   EVATaskState state;
+  int64_t      startTimeMs;  // not run before it, 0 to run at once
 
   // wait
   int32_t      numWait;
@@ -109,9 +110,38 @@ struct SVAsync {
   int64_t      nextTaskId;
   int32_t      numTasks;
   SVATask      queue[EVA_PRIORITY_MAX];
+  SVATask      delayQueue;  // tasks not due yet, moved to queue by the workers
   SVHashTable *taskTable;
 };
 
+static void vnodeAsyncEnqueue(SVAsync *async, SVATask *task, int32_t priority) {
+  SVATask *queue = task->startTimeMs > taosGetTimestampMs() ? &async->delayQueue : &async->queue[priority];
+  task->next = queue;
+  task->prev = queue->prev;
+  task->next->prev = task;
+  task->prev->next = task;
+}
+
+// move the due tasks to the priority queues, return the start time of the first task not due yet or 0 if none
+static int64_t vnodeAsyncMoveDueTasks(SVAsync *async) {
+  int64_t  nextTimeMs = 0;
+  int64_t  nowMs = taosGetTimestampMs();
+  SVATask *task = async->delayQueue.next;
+  while (task != &async->delayQueue) {
+    SVATask *next = task->next;
+    if (task->startTimeMs <= nowMs) {
+      task->prev->next = task->next;
+      task->next->prev = task->prev;
+      task->startTimeMs = 0;
+      vnodeAsyncEnqueue(async, task, VATASK_PIORITY(task));
+    } else if (nextTimeMs == 0 || task->startTimeMs < nextTimeMs) {
+      nextTimeMs = task->startTimeMs;
+    }
+    task = next;
+  }
+  return nextTimeMs;
+}
+
 static int32_t vnodeAsyncTaskDone(SVAsync *async, SVATask *task) {
   int32_t ret;
 
@@ -145,11 +175,7 @@ static int32_t vnodeAsyncTaskDone(SVAsync *async, SVATask *task) {
       }
 
       if (task->channel->scheduled != NULL) {
-        int32_t priority = VATASK_PIORITY(task->channel->scheduled);
-        task->channel->scheduled->next = &async->queue[priority];
-        task->channel->scheduled->prev = async->queue[priority].prev;
-        task->channel->scheduled->next->prev = task->channel->scheduled;
-        task->channel->scheduled->prev->next = task->channel->scheduled;
+        vnodeAsyncEnqueue(async, task->channel->scheduled, VATASK_PIORITY(task->channel->scheduled));
       }
     }
   }
@@ -178,7 +204,13 @@ static int32_t vnodeAsyncTaskDone(SVAsync *async, SVATask *task) {
 
 static int32_t vnodeAsyncCancelAllTasks(SVAsync *async) {
   while (async->queue[0].next != &async->queue[0] || async->queue[1].next != &async->queue[1] ||
-         async->queue[2].next != &async->queue[2]) {
+         async->queue[2].next != &async->queue[2] || async->delayQueue.next != &async->delayQueue) {
+    while (async->delayQueue.next != &async->delayQueue) {
+      SVATask *task = async->delayQueue.next;
+      task->prev->next = task->next;
+      task->next->prev = task->prev;
+      vnodeAsyncTaskDone(async, task);
+    }
     for (int32_t i = 0; i < EVA_PRIORITY_MAX; i++) {
       while (async->queue[i].next != &async->queue[i]) {
         SVATask *task = async->queue[i].next;
@@ -217,6 +249,8 @@ static void *vnodeAsyncLoop(void *arg) {
         return NULL;
       }
 
+      int64_t nextTimeMs = vnodeAsyncMoveDueTasks(async);
+
       for (int32_t i = 0; i < EVA_PRIORITY_MAX; i++) {
         SVATask *task = async->queue[i].next;
         if (task != &async->queue[i]) {
@@ -244,7 +278,12 @@ static void *vnodeAsyncLoop(void *arg) {
       if (worker->runningTask == NULL) {
         worker->state = EVA_WORKER_STATE_IDLE;
         async->numIdleWorkers++;
-        taosThreadCondWait(&async->hasTask, &async->mutex);
+        if (nextTimeMs > 0) {
+          struct timespec ts = {.tv_sec = nextTimeMs / 1000, .tv_nsec = (nextTimeMs % 1000) * 1000000};
+          taosThreadCondTimedWait(&async->hasTask, &async->mutex, &ts);
+        } else {
+          taosThreadCondWait(&async->hasTask, &async->mutex);
+        }
         async->numIdleWorkers--;
         worker->state = EVA_WORKER_STATE_ACTIVE;
       } else {
@@ -348,6 +387,8 @@ int32_t vnodeAsyncInit(SVAsync **async, char *label) {
     (*async)->queue[i].next = &(*async)->queue[i];
     (*async)->queue[i].prev = &(*async)->queue[i];
   }
+  (*async)->delayQueue.next = &(*async)->delayQueue;
+  (*async)->delayQueue.prev = &(*async)->delayQueue;
   ret = vHashInit(&(*async)->taskTable, vnodeAsyncTaskHash, vnodeAsyncTaskCompare);
   if (ret != 0) {
     vHashDestroy(&(*async)->channelTable);
@@ -442,7 +483,12 @@ int32_t vnodeAsync(SVAsync *async, EVAPriority priority, int32_t (*execute)(void
 
 int32_t vnodeAsyncC(SVAsync *async, int64_t channelId, EVAPriority priority, int32_t (*execute)(void *),
                     void (*complete)(void *), void *arg, int64_t *taskId) {
-  if (async == NULL || execute == NULL || channelId < 0) {
+  return vnodeAsyncCDelay(async, channelId, priority, 0, execute, complete, arg, taskId);
+}
+
+int32_t vnodeAsyncCDelay(SVAsync *async, int64_t channelId, EVAPriority priority, int64_t delayMs,
+                         int32_t (*execute)(void *), void (*complete)(void *), void *arg, int64_t *taskId) {
+  if (async == NULL || execute == NULL || channelId < 0 || delayMs < 0) {
     return TSDB_CODE_INVALID_PARA;
   }
 
@@ -460,6 +506,7 @@ int32_t vnodeAsyncC(SVAsync *async, int64_t channelId, EVAPriority priority, int
   task->complete = complete;
   task->arg = arg;
   task->state = EVA_TASK_STATE_WAITTING;
+  task->startTimeMs = delayMs > 0 ? taosGetTimestampMs() + delayMs : 0;
   task->numWait = 0;
   taosThreadCondInit(&task->waitCond, NULL);
 
@@ -499,12 +546,9 @@ int32_t vnodeAsyncC(SVAsync *async, int64_t channelId, EVAPriority priority, int
       task->channel->scheduled = task;
     }
 
-    task->next = &async->queue[priority];
-    task->prev = async->queue[priority].prev;
-    task->next->prev = task;
-    task->prev->next = task;
+    vnodeAsyncEnqueue(async, task, priority);
 
-    // signal worker or launch new worker
+    // signal worker or launch new worker, a delayed task needs an idle worker waiting for it as well
     if (async->numIdleWorkers > 0) {
       taosThreadCondSignal(&(async->hasTask));
     } else if (async->numLaunchWorkers < async->numWorkers) {
@@ -532,10 +576,12 @@ int32_t vnodeAsyncC(SVAsync *async, int64_t channelId, EVAPriority priority, int
 
     // add task to queue
     task->channel->scheduled = task;
-    task->next = &async->queue[priority];
-    task->prev = async->queue[priority].prev;
-    task->next->prev = task;
-    task->prev->next = task;
+    vnodeAsyncEnqueue(async, task, priority);
+    if (async->numIdleWorkers > 0) {
+      taosThreadCondSignal(&(async->hasTask));
+    } else if (async->numLaunchWorkers < async->numWorkers) {
+      vnodeAsyncLaunchWorker(async);
+    }
   }
 
   taosThreadMutexUnlock(&async->mutex);
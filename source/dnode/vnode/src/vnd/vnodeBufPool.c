@@ -40,7 +40,8 @@ static int vnodeBufPoolCreate(SVnode *pVnode, int32_t id, int64_t size, SVBufPoo
   pPool->node.pnext = &pPool->pTail;
   pPool->node.size = size;
 
-  if (VND_IS_RSMA(pVnode)) {
+  // the tables of one submit request may be inserted by several threads, see vnodeInsertTableDataParallel
+  if (VND_IS_RSMA(pVnode) || tsNumOfVnodeInsertThreads > 1) {
     pPool->lock = taosMemoryMalloc(sizeof(TdThreadSpinlock));
     if (!pPool->lock) {
       taosMemoryFree(pPool);
@@ -51,6 +51,7 @@ void initTsdbReaderAPI(TsdReader* pReader) {
   pReader->tsdReaderReleaseDataBlock = tsdbReleaseDataBlock2;
 
   pReader->tsdReaderRetrieveBlockSMAInfo = tsdbRetrieveDatablockSMA2;
+  pReader->tsdReaderRetrieveBlockBloom = tsdbRetrieveDatablockBloom2;
 
   pReader->tsdReaderNotifyClosing = tsdbReaderSetCloseFlag;
   pReader->tsdReaderResetStatus = tsdbReaderReset2;
@@ -86,6 +87,7 @@ void initMetadataAPI(SStoreMeta* pMeta) {
   pMeta->extractTagVal = (const void* (*)(const void*, int16_t, STagVal*))metaGetTableTagVal;
   pMeta->getTableTags = metaGetTableTags;
   pMeta->getTableTagsByUid = metaGetTableTagsByUids;
+  pMeta->getTableTagCols = metaGetTableTagCols;
 
   pMeta->getTableUidByName = metaGetTableUidByName;
   pMeta->getTableTypeByName = metaGetTableTypeByName;
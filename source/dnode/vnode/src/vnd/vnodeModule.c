@@ -18,7 +18,7 @@
 
 static volatile int32_t VINIT = 0;
 
-SVAsync* vnodeAsyncHandle[2];
+SVAsync* vnodeAsyncHandle[4];
 
 int vnodeInit(int nthreads) {
   int32_t init;
@@ -36,10 +36,26 @@ int vnodeInit(int nthreads) {
   vnodeAsyncInit(&vnodeAsyncHandle[1], "vnode-merge");
   vnodeAsyncSetWorkers(vnodeAsyncHandle[1], nthreads);
 
+  // vnode-read, file block read-ahead of tsdb readers
+  vnodeAsyncInit(&vnodeAsyncHandle[2], "vnode-read");
+  vnodeAsyncSetWorkers(vnodeAsyncHandle[2], nthreads);
+
+  // vnode-insert, memtable inserts of the tables of a submit request
+  vnodeAsyncInit(&vnodeAsyncHandle[3], "vnode-insert");
+  vnodeAsyncSetWorkers(vnodeAsyncHandle[3], tsNumOfVnodeInsertThreads);
+
+  // page cache shards of the tdb opened by the vnodes from now on
+  tdbSetPCacheShards(tsTdbCacheShards);
+
   if (walInit() < 0) {
     return -1;
   }
 
+  // sort threads of the executor
+  if (qExecutorInit() != 0) {
+    return -1;
+  }
+
   return 0;
 }
 
@@ -50,7 +66,10 @@ void vnodeCleanup() {
   // set stop
   vnodeAsyncDestroy(&vnodeAsyncHandle[0]);
   vnodeAsyncDestroy(&vnodeAsyncHandle[1]);
+  vnodeAsyncDestroy(&vnodeAsyncHandle[2]);
+  vnodeAsyncDestroy(&vnodeAsyncHandle[3]);
 
+  qExecutorCleanup();
   walCleanUp();
   smaCleanUp();
 }
@@ -396,6 +396,8 @@ SVnode *vnodeOpen(const char *path, int32_t diskPrimary, STfs *pTfs, SMsgCb msgC
   pVnode->blocked = false;
 
   tsem_init(&pVnode->syncSem, 0, 0);
+  taosThreadMutexInit(&pVnode->applyMutex, NULL);
+  taosThreadCondInit(&pVnode->applyCond, NULL);
   taosThreadMutexInit(&pVnode->mutex, NULL);
   taosThreadCondInit(&pVnode->poolNotEmpty, NULL);
 
@@ -540,6 +542,8 @@ void vnodeClose(SVnode *pVnode) {
 
     // destroy handle
     tsem_destroy(&pVnode->syncSem);
+    taosThreadCondDestroy(&pVnode->applyCond);
+    taosThreadMutexDestroy(&pVnode->applyMutex);
     taosThreadCondDestroy(&pVnode->poolNotEmpty);
     taosThreadMutexDestroy(&pVnode->mutex);
     taosThreadMutexDestroy(&pVnode->lock);
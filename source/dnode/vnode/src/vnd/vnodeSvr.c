@@ -535,6 +535,13 @@ int32_t vnodeProcessWriteMsg(SVnode *pVnode, SRpcMsg *pMsg, int64_t ver, SRpcMsg
   atomic_store_64(&pVnode->state.applied, ver);
   atomic_store_64(&pVnode->state.applyTerm, pMsg->info.conn.applyTerm);
 
+  // waiters register before they check the applied version, so none of them misses this one
+  if (atomic_load_32(&pVnode->applyWaiters) > 0) {
+    taosThreadMutexLock(&pVnode->applyMutex);
+    taosThreadCondBroadcast(&pVnode->applyCond);
+    taosThreadMutexUnlock(&pVnode->applyMutex);
+  }
+
   if (!syncUtilUserCommit(pMsg->msgType)) goto _exit;
 
   // skip header
@@ -733,8 +740,11 @@ int32_t vnodeProcessQueryMsg(SVnode *pVnode, SRpcMsg *pMsg) {
   if ((pMsg->msgType == TDMT_SCH_QUERY || pMsg->msgType == TDMT_VND_TMQ_CONSUME ||
        pMsg->msgType == TDMT_VND_TMQ_CONSUME_PUSH) &&
       !syncIsReadyForRead(pVnode->sync)) {
-    vnodeRedirectRpcMsg(pVnode, pMsg, terrno);
-    return 0;
+    int32_t code = terrno;
+    if (pMsg->msgType != TDMT_SCH_QUERY || !tsQueryFollowerRead || vnodeSyncWaitReadIndex(pVnode) != 0) {
+      vnodeRedirectRpcMsg(pVnode, pMsg, code);
+      return 0;
+    }
   }
 
   if (pMsg->msgType == TDMT_VND_TMQ_CONSUME && !pVnode->restored) {
@@ -765,7 +775,7 @@ int32_t vnodeProcessFetchMsg(SVnode *pVnode, SRpcMsg *pMsg, SQueueInfo *pInfo) {
   vTrace("vgId:%d, msg:%p in fetch queue is processing", pVnode->config.vgId, pMsg);
   if ((pMsg->msgType == TDMT_SCH_FETCH || pMsg->msgType == TDMT_VND_TABLE_META || pMsg->msgType == TDMT_VND_TABLE_CFG ||
        pMsg->msgType == TDMT_VND_BATCH_META) &&
-      !syncIsReadyForRead(pVnode->sync)) {
+      !(pMsg->msgType == TDMT_SCH_FETCH && tsQueryFollowerRead) && !syncIsReadyForRead(pVnode->sync)) {
     vnodeRedirectRpcMsg(pVnode, pMsg, terrno);
     return 0;
   }
@@ -1610,6 +1620,125 @@ static int32_t vnodeRebuildSubmitReqMsg(SSubmitReq2 *pSubmitReq, void **ppMsg) {
   return code;
 }
 
+#define VNODE_PARALLEL_INSERT_MIN_ROWS 4096
+
+typedef struct {
+  STsdb  *pTsdb;
+  int64_t ver;
+  SArray *aSubmitTbData;
+  int32_t idx;
+  int32_t nShard;
+  int32_t affectedRows;
+  int32_t code;
+} SVnodeInsertTask;
+
+static int32_t vnodeGetNumOfInsertShards(SSubmitReq2 *pSubmitReq) {
+  int32_t nTbData = TARRAY_SIZE(pSubmitReq->aSubmitTbData);
+  if (tsNumOfVnodeInsertThreads <= 1 || nTbData < 2 || vnodeAsyncHandle[3] == NULL) {
+    return 1;
+  }
+
+  int64_t nRow = 0;
+  for (int32_t i = 0; i < nTbData; ++i) {
+    SSubmitTbData *pSubmitTbData = taosArrayGet(pSubmitReq->aSubmitTbData, i);
+    if (pSubmitTbData->flags & SUBMIT_REQ_COLUMN_DATA_FORMAT) {
+      nRow += ((SColData *)TARRAY_DATA(pSubmitTbData->aCol))[0].nVal;
+    } else {
+      nRow += TARRAY_SIZE(pSubmitTbData->aRowP);
+    }
+  }
+
+  return (nRow < VNODE_PARALLEL_INSERT_MIN_ROWS) ? 1 : TMIN(tsNumOfVnodeInsertThreads, nTbData);
+}
+
+static int32_t vnodeDoInsertTask(void *arg) {
+  SVnodeInsertTask *pTask = arg;
+
+  for (int32_t i = 0; i < TARRAY_SIZE(pTask->aSubmitTbData); ++i) {
+    SSubmitTbData *pSubmitTbData = taosArrayGet(pTask->aSubmitTbData, i);
+    if (TABS(pSubmitTbData->uid) % pTask->nShard != pTask->idx) {
+      continue;
+    }
+
+    int32_t affectedRows = 0;
+    pTask->code = tsdbInsertTableData(pTask->pTsdb, pTask->ver, pSubmitTbData, &affectedRows);
+    if (pTask->code) {
+      break;
+    }
+    pTask->affectedRows += affectedRows;
+  }
+
+  return pTask->code;
+}
+
+// The tables of a submit request are independent of each other, so they are sharded by uid and inserted into the
+// memtable by several threads, the calling thread takes the first shard. The STbData of all tables are created before,
+// so that each thread only touches the tables of its own shard. All shards are done before it returns, the version of
+// the rows is the same as a serial insert.
+int32_t vnodeInsertSubmitTbDataParallel(STsdb *pTsdb, int64_t ver, SArray *aSubmitTbData, int32_t nShard,
+                                        int32_t *affectedRows) {
+  int32_t           code = 0;
+  SVnodeInsertTask *aTask = NULL;
+  int64_t          *aTaskId = NULL;
+
+  for (int32_t i = 0; i < TARRAY_SIZE(aSubmitTbData); ++i) {
+    SSubmitTbData *pSubmitTbData = taosArrayGet(aSubmitTbData, i);
+    code = tsdbPrepareTableData(pTsdb, pSubmitTbData->suid, pSubmitTbData->uid);
+    if (code) goto _exit;
+  }
+
+  aTask = taosMemoryCalloc(nShard, sizeof(SVnodeInsertTask));
+  aTaskId = taosMemoryCalloc(nShard, sizeof(int64_t));
+  if (aTask == NULL || aTaskId == NULL) {
+    code = TSDB_CODE_OUT_OF_MEMORY;
+    goto _exit;
+  }
+
+  for (int32_t i = 0; i < nShard; ++i) {
+    aTask[i] = (SVnodeInsertTask){
+        .pTsdb = pTsdb, .ver = ver, .aSubmitTbData = aSubmitTbData, .idx = i, .nShard = nShard};
+    if (i > 0 && vnodeAsyncC(vnodeAsyncHandle[3], 0, EVA_PRIORITY_HIGH, vnodeDoInsertTask, NULL, &aTask[i],
+                             &aTaskId[i]) != 0) {
+      aTaskId[i] = 0;
+    }
+  }
+
+  (void)vnodeDoInsertTask(&aTask[0]);
+  for (int32_t i = 1; i < nShard; ++i) {
+    if (VNODE_ASYNC_VALID_TASK_ID(aTaskId[i])) {
+      (void)vnodeAWait(vnodeAsyncHandle[3], aTaskId[i]);
+    } else {  // failed to schedule, insert it in the write thread
+      (void)vnodeDoInsertTask(&aTask[i]);
+    }
+  }
+
+  for (int32_t i = 0; i < nShard; ++i) {
+    if (code == 0) {
+      code = aTask[i].code;
+    }
+    *affectedRows += aTask[i].affectedRows;
+  }
+
+_exit:
+  taosMemoryFree(aTask);
+  taosMemoryFree(aTaskId);
+  return code;
+}
+
+static int32_t vnodeInsertTableDataParallel(SVnode *pVnode, int64_t ver, SSubmitReq2 *pSubmitReq, int32_t nShard,
+                                            int32_t *affectedRows) {
+  int32_t code = vnodeInsertSubmitTbDataParallel(pVnode->pTsdb, ver, pSubmitReq->aSubmitTbData, nShard, affectedRows);
+
+  for (int32_t i = 0; code == 0 && i < TARRAY_SIZE(pSubmitReq->aSubmitTbData); ++i) {
+    SSubmitTbData *pSubmitTbData = taosArrayGet(pSubmitReq->aSubmitTbData, i);
+    code = metaUpdateChangeTimeWithLock(pVnode->pMeta, pSubmitTbData->uid, pSubmitTbData->ctimeMs);
+  }
+
+  vDebug("vgId:%d, submit of %d tables inserted in %d shards, version:%" PRId64, TD_VID(pVnode),
+         (int32_t)TARRAY_SIZE(pSubmitReq->aSubmitTbData), nShard, ver);
+  return code;
+}
+
 static int32_t vnodeProcessSubmitReq(SVnode *pVnode, int64_t ver, void *pReq, int32_t len, SRpcMsg *pRsp,
                                      SRpcMsg *pOriginalMsg) {
   int32_t code = 0;
@@ -1763,6 +1892,8 @@ static int32_t vnodeProcessSubmitReq(SVnode *pVnode, int64_t ver, void *pReq, in
 
   vDebug("vgId:%d, submit block size %d", TD_VID(pVnode), (int32_t)taosArrayGetSize(pSubmitReq->aSubmitTbData));
 
+  int32_t nShard = vnodeGetNumOfInsertShards(pSubmitReq);
+
   // loop to handle
   for (int32_t i = 0; i < TARRAY_SIZE(pSubmitReq->aSubmitTbData); ++i) {
     SSubmitTbData *pSubmitTbData = taosArrayGet(pSubmitReq->aSubmitTbData, i);
@@ -1806,6 +1937,11 @@ static int32_t vnodeProcessSubmitReq(SVnode *pVnode, int64_t ver, void *pReq, in
       }
     }
 
+    // the data is inserted in parallel after all tables are created
+    if (nShard > 1) {
+      continue;
+    }
+
     // insert data
     int32_t affectedRows;
     code = tsdbInsertTableData(pVnode->pTsdb, ver, pSubmitTbData, &affectedRows);
@@ -1817,6 +1953,11 @@ static int32_t vnodeProcessSubmitReq(SVnode *pVnode, int64_t ver, void *pReq, in
     pSubmitRsp->affectedRows += affectedRows;
   }
 
+  if (nShard > 1) {
+    code = vnodeInsertTableDataParallel(pVnode, ver, pSubmitReq, nShard, &pSubmitRsp->affectedRows);
+    if (code) goto _exit;
+  }
+
   // update the affected table uid list
   if (taosArrayGetSize(newTbUids) > 0) {
     vDebug("vgId:%d, add %d table into query table list in handling submit", TD_VID(pVnode),
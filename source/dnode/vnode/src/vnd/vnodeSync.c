@@ -21,6 +21,7 @@
 #include "vnd.h"
 
 #define BATCH_ENABLE 0
+#define VNODE_READ_INDEX_TIMEOUT_MS 1000
 
 static inline bool vnodeIsMsgWeak(tmsg_t type) { return false; }
 
@@ -791,6 +792,46 @@ void vnodeSyncCheckTimeout(SVnode *pVnode) {
   taosThreadMutexUnlock(&pVnode->lock);
 }
 
+// Let a follower serve a query: get the commit index of the leader and wait until it is applied locally, so the
+// query sees every write acknowledged before it arrived.
+int32_t vnodeSyncWaitReadIndex(SVnode *pVnode) {
+  SyncIndex readIndex = SYNC_INDEX_INVALID;
+  int64_t   deadline = taosGetTimestampMs() + VNODE_READ_INDEX_TIMEOUT_MS;
+
+  if (!pVnode->restored) {
+    terrno = TSDB_CODE_SYN_RESTORING;
+    return -1;
+  }
+
+  if (syncReadIndex(pVnode->sync, VNODE_READ_INDEX_TIMEOUT_MS, &readIndex) != 0) {
+    vDebug("vgId:%d, failed to get read index since %s", pVnode->config.vgId, terrstr());
+    return -1;
+  }
+
+  if (atomic_load_64(&pVnode->state.applied) >= readIndex) {
+    return 0;
+  }
+
+  int32_t code = 0;
+  taosThreadMutexLock(&pVnode->applyMutex);
+  atomic_add_fetch_32(&pVnode->applyWaiters, 1);
+  while (atomic_load_64(&pVnode->state.applied) < readIndex) {
+    if (taosGetTimestampMs() >= deadline) {
+      vDebug("vgId:%d, wait for read index:%" PRId64 " timeout, applied:%" PRId64, pVnode->config.vgId, readIndex,
+             atomic_load_64(&pVnode->state.applied));
+      terrno = TSDB_CODE_SYN_TIMEOUT;
+      code = -1;
+      break;
+    }
+    struct timespec ts = {.tv_sec = deadline / 1000, .tv_nsec = (deadline % 1000) * 1000000};
+    taosThreadCondTimedWait(&pVnode->applyCond, &pVnode->applyMutex, &ts);
+  }
+  atomic_sub_fetch_32(&pVnode->applyWaiters, 1);
+  taosThreadMutexUnlock(&pVnode->applyMutex);
+
+  return code;
+}
+
 bool vnodeIsRoleLeader(SVnode *pVnode) {
   SSyncState state = syncGetState(pVnode->sync);
   return state.state == TAOS_SYNC_STATE_LEADER;
@@ -0,0 +1,247 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "meta.h"
+#include "tdatablock.h"
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wwrite-strings"
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#pragma GCC diagnostic ignored "-Wsign-compare"
+
+namespace {
+
+#define TS_INT_CID    2
+#define TS_BINARY_CID 3
+#define TS_BINARY_LEN 32
+
+// tags (t_int int, t_binary binary(32))
+class MetaTagStoreTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    memset(schema, 0, sizeof(schema));
+    schema[0].type = TSDB_DATA_TYPE_INT;
+    schema[0].colId = TS_INT_CID;
+    schema[0].bytes = sizeof(int32_t);
+    schema[1].type = TSDB_DATA_TYPE_BINARY;
+    schema[1].colId = TS_BINARY_CID;
+    schema[1].bytes = TS_BINARY_LEN + VARSTR_HEADER_SIZE;
+
+    SSchemaWrapper tagSchema = {0};
+    tagSchema.nCols = 2;
+    tagSchema.pSchema = schema;
+    pStore = metaTagStoreCreate(&tagSchema);
+    ASSERT_NE(pStore, nullptr);
+  }
+
+  void TearDown() override { metaTagStoreDestroy(pStore); }
+
+  // a null argument leaves the tag out of the STag, which reads as null
+  void putRow(tb_uid_t uid, const int32_t* pInt, const char* str) {
+    SArray* pTagVals = taosArrayInit(2, sizeof(STagVal));
+    if (pInt != NULL) {
+      STagVal tagVal = {0};
+      tagVal.cid = TS_INT_CID;
+      tagVal.type = TSDB_DATA_TYPE_INT;
+      tagVal.i64 = *pInt;
+      taosArrayPush(pTagVals, &tagVal);
+    }
+    if (str != NULL) {
+      STagVal tagVal = {0};
+      tagVal.cid = TS_BINARY_CID;
+      tagVal.type = TSDB_DATA_TYPE_BINARY;
+      tagVal.nData = strlen(str);
+      tagVal.pData = (uint8_t*)str;
+      taosArrayPush(pTagVals, &tagVal);
+    }
+
+    STag* pTag = NULL;
+    ASSERT_EQ(tTagNew(pTagVals, 1, 0, &pTag), 0);
+    ASSERT_EQ(metaTagStorePutRow(pStore, uid, pTag), TSDB_CODE_SUCCESS);
+    tTagFree(pTag);
+    taosArrayDestroy(pTagVals);
+  }
+
+  SSDataBlock* createTagBlock() {
+    SSDataBlock*    pBlock = createDataBlock();
+    SColumnInfoData intCol = createColumnInfoData(TSDB_DATA_TYPE_INT, sizeof(int32_t), TS_INT_CID);
+    SColumnInfoData binaryCol =
+        createColumnInfoData(TSDB_DATA_TYPE_BINARY, TS_BINARY_LEN + VARSTR_HEADER_SIZE, TS_BINARY_CID);
+    blockDataAppendColInfo(pBlock, &intCol);
+    blockDataAppendColInfo(pBlock, &binaryCol);
+    return pBlock;
+  }
+
+  SArray* createUidList(const std::vector<tb_uid_t>& uids) {
+    SArray* pList = taosArrayInit(uids.size(), sizeof(STUidTagInfo));
+    for (size_t i = 0; i < uids.size(); ++i) {
+      STUidTagInfo info = {0};
+      info.uid = uids[i];
+      taosArrayPush(pList, &info);
+    }
+    return pList;
+  }
+
+  void checkRow(SSDataBlock* pBlock, int32_t row, const int32_t* pInt, const char* str) {
+    SColumnInfoData* pIntCol = (SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 0);
+    SColumnInfoData* pBinaryCol = (SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 1);
+    if (pInt == NULL) {
+      ASSERT_TRUE(colDataIsNull_s(pIntCol, row)) << "row " << row;
+    } else {
+      ASSERT_FALSE(colDataIsNull_s(pIntCol, row)) << "row " << row;
+      ASSERT_EQ(*(int32_t*)colDataGetData(pIntCol, row), *pInt) << "row " << row;
+    }
+    if (str == NULL) {
+      ASSERT_TRUE(colDataIsNull_s(pBinaryCol, row)) << "row " << row;
+    } else {
+      ASSERT_FALSE(colDataIsNull_s(pBinaryCol, row)) << "row " << row;
+      char* p = colDataGetData(pBinaryCol, row);
+      ASSERT_EQ(std::string(varDataVal(p), varDataLen(p)), std::string(str)) << "row " << row;
+    }
+  }
+
+  SSchema        schema[2];
+  SMetaTagStore* pStore = nullptr;
+};
+
+}  // namespace
+
+TEST_F(MetaTagStoreTest, fillAllRows) {
+  int32_t v1 = 1, v2 = 2;
+  putRow(101, &v1, "beijing");
+  putRow(102, &v2, "shanghai");
+  putRow(103, NULL, "");
+  putRow(104, &v1, NULL);
+
+  SSDataBlock* pBlock = createTagBlock();
+  SArray*      pUidList = taosArrayInit(4, sizeof(STUidTagInfo));
+  SArray*      pMissRows = taosArrayInit(4, sizeof(int32_t));
+  bool         acquired = false;
+  ASSERT_EQ(metaTagStoreFillBlock(pStore, pUidList, pBlock, pMissRows, &acquired), TSDB_CODE_SUCCESS);
+  ASSERT_TRUE(acquired);
+  ASSERT_EQ(pBlock->info.rows, 4);
+  ASSERT_EQ(taosArrayGetSize(pUidList), 4);
+  ASSERT_EQ(taosArrayGetSize(pMissRows), 0);
+
+  ASSERT_EQ(((STUidTagInfo*)taosArrayGet(pUidList, 0))->uid, 101);
+  checkRow(pBlock, 0, &v1, "beijing");
+  checkRow(pBlock, 1, &v2, "shanghai");
+  checkRow(pBlock, 2, NULL, "");
+  checkRow(pBlock, 3, &v1, NULL);
+
+  taosArrayDestroy(pMissRows);
+  taosArrayDestroy(pUidList);
+  blockDataDestroy(pBlock);
+}
+
+TEST_F(MetaTagStoreTest, updateAndRemoveRows) {
+  int32_t v1 = 1, v2 = 2, v3 = 3;
+  putRow(101, &v1, "beijing");
+  putRow(102, &v2, "shanghai");
+  putRow(103, &v3, "shenzhen");
+
+  // update in place, then move the last row into the removed one
+  putRow(101, &v3, "hangzhou");
+  metaTagStoreRemoveRow(pStore, 102);
+  metaTagStoreRemoveRow(pStore, 999);
+
+  SSDataBlock* pBlock = createTagBlock();
+  SArray*      pUidList = taosArrayInit(4, sizeof(STUidTagInfo));
+  bool         acquired = false;
+  ASSERT_EQ(metaTagStoreFillBlock(pStore, pUidList, pBlock, NULL, &acquired), TSDB_CODE_SUCCESS);
+  ASSERT_TRUE(acquired);
+  ASSERT_EQ(pBlock->info.rows, 2);
+  ASSERT_EQ(((STUidTagInfo*)taosArrayGet(pUidList, 0))->uid, 101);
+  ASSERT_EQ(((STUidTagInfo*)taosArrayGet(pUidList, 1))->uid, 103);
+  checkRow(pBlock, 0, &v3, "hangzhou");
+  checkRow(pBlock, 1, &v3, "shenzhen");
+
+  taosArrayDestroy(pUidList);
+  blockDataDestroy(pBlock);
+}
+
+TEST_F(MetaTagStoreTest, missingUidsAreReported) {
+  int32_t v1 = 1, v2 = 2;
+  putRow(101, &v1, "beijing");
+  putRow(102, &v2, "shanghai");
+
+  SSDataBlock* pBlock = createTagBlock();
+  SArray*      pUidList = createUidList({102, 201, 101, 202});
+  SArray*      pMissRows = taosArrayInit(4, sizeof(int32_t));
+  bool         acquired = false;
+  ASSERT_EQ(metaTagStoreFillBlock(pStore, pUidList, pBlock, pMissRows, &acquired), TSDB_CODE_SUCCESS);
+  ASSERT_TRUE(acquired);
+  ASSERT_EQ(pBlock->info.rows, 4);
+
+  // the missing rows are left null for the meta lookup of the caller
+  ASSERT_EQ(taosArrayGetSize(pMissRows), 2);
+  ASSERT_EQ(*(int32_t*)taosArrayGet(pMissRows, 0), 1);
+  ASSERT_EQ(*(int32_t*)taosArrayGet(pMissRows, 1), 3);
+  checkRow(pBlock, 0, &v2, "shanghai");
+  checkRow(pBlock, 1, NULL, NULL);
+  checkRow(pBlock, 2, &v1, "beijing");
+  checkRow(pBlock, 3, NULL, NULL);
+
+  taosArrayDestroy(pMissRows);
+  taosArrayDestroy(pUidList);
+  blockDataDestroy(pBlock);
+}
+
+TEST_F(MetaTagStoreTest, unknownTagIsNotAcquired) {
+  int32_t v1 = 1;
+  putRow(101, &v1, "beijing");
+
+  SSDataBlock*    pBlock = createDataBlock();
+  SColumnInfoData col = createColumnInfoData(TSDB_DATA_TYPE_BIGINT, sizeof(int64_t), TS_BINARY_CID + 1);
+  blockDataAppendColInfo(pBlock, &col);
+
+  SArray* pUidList = taosArrayInit(1, sizeof(STUidTagInfo));
+  bool    acquired = false;
+  ASSERT_EQ(metaTagStoreFillBlock(pStore, pUidList, pBlock, NULL, &acquired), TSDB_CODE_SUCCESS);
+  ASSERT_FALSE(acquired);
+  ASSERT_EQ(taosArrayGetSize(pUidList), 0);
+
+  taosArrayDestroy(pUidList);
+  blockDataDestroy(pBlock);
+}
+
+TEST_F(MetaTagStoreTest, memSizeCountsDistinctValues) {
+  int64_t size = metaTagStoreMemSize(pStore);
+  int32_t v1 = 1;
+
+  putRow(101, &v1, "a_long_city_name_of_the_tag");
+  int64_t firstRow = metaTagStoreMemSize(pStore) - size;
+  ASSERT_GT(firstRow, 0);
+
+  // the repeated value is encoded with the dictionary
+  size = metaTagStoreMemSize(pStore);
+  putRow(102, &v1, "a_long_city_name_of_the_tag");
+  int64_t repeatedRow = metaTagStoreMemSize(pStore) - size;
+  ASSERT_GT(repeatedRow, 0);
+  ASSERT_LT(repeatedRow, firstRow);
+
+  // updating a row with a known value adds nothing
+  size = metaTagStoreMemSize(pStore);
+  putRow(101, &v1, "a_long_city_name_of_the_tag");
+  ASSERT_EQ(metaTagStoreMemSize(pStore), size);
+}
+
+#pragma GCC diagnostic pop
@@ -0,0 +1,681 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "tsdb.h"
+#include "vnd.h"
+#include "vnodeInt.h"
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wwrite-strings"
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#pragma GCC diagnostic ignored "-Wsign-compare"
+
+namespace {
+
+typedef std::pair<int64_t, int64_t> TsVer;  // (ts, version) of a row in the memtable
+
+TSDBROW *nextRow(STbDataIter *pIter) { return tsdbTbDataIterNext(pIter) ? tsdbTbDataIterGet(pIter) : NULL; }
+
+class TsdbMemTableTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    pVnode = (SVnode *)taosMemoryCalloc(1, sizeof(SVnode));
+    ASSERT_NE(pVnode, nullptr);
+    pVnode->config.vgId = 2;
+    pVnode->config.szBuf = 16 * 1024 * 1024;
+    pVnode->config.tsdbCfg.slLevel = 5;
+    taosThreadMutexInit(&pVnode->mutex, NULL);
+    taosThreadCondInit(&pVnode->poolNotEmpty, NULL);
+    ASSERT_EQ(vnodeOpenBufPool(pVnode), 0);
+
+    pVnode->inUse = pVnode->freeList;
+    pVnode->inUse->nRef = 1;
+    pVnode->freeList = pVnode->inUse->freeNext;
+    pVnode->inUse->freeNext = NULL;
+
+    pTsdb = (STsdb *)taosMemoryCalloc(1, sizeof(STsdb));
+    ASSERT_NE(pTsdb, nullptr);
+    pTsdb->pVnode = pVnode;
+    ASSERT_EQ(tsdbMemTableCreate(pTsdb, &pTsdb->mem), 0);
+
+    SSchema aSchema[] = {
+        {.type = TSDB_DATA_TYPE_TIMESTAMP, .flags = 0, .colId = 1, .bytes = 8, .name = "ts"},
+        {.type = TSDB_DATA_TYPE_BIGINT, .flags = 0, .colId = 2, .bytes = 8, .name = "v"},
+    };
+    pTSchema = tBuildTSchema(aSchema, 2, 1);
+    ASSERT_NE(pTSchema, nullptr);
+  }
+
+  void TearDown() override {
+    tsdbMemTableDestroy(pTsdb->mem, false);
+    taosMemoryFree(pTsdb);
+    vnodeCloseBufPool(pVnode);
+    taosThreadCondDestroy(&pVnode->poolNotEmpty);
+    taosThreadMutexDestroy(&pVnode->mutex);
+    taosMemoryFree(pVnode);
+    tDestroyTSchema(pTSchema);
+  }
+
+  // there is no meta, the tail takes the schema from the cache of the memtable
+  void cacheSchema(tb_uid_t uid, STSchema *pSchema) {
+    SMemSkmKey key = {0};
+    key.uid = uid;
+    key.sver = pSchema->version;
+    ASSERT_EQ(tSimpleHashPut(pTsdb->mem->pSkmCache, &key, sizeof(key), &pSchema, sizeof(pSchema)), 0);
+  }
+
+  // build a row format submit of the given keys, the value column holds the version
+  SSubmitTbData *buildSubmitTbData(tb_uid_t uid, const std::vector<int64_t> &keys, int64_t version) {
+    cacheSchema(uid, pTSchema);
+
+    SSubmitTbData *pSubmitTbData = (SSubmitTbData *)taosMemoryCalloc(1, sizeof(SSubmitTbData));
+    pSubmitTbData->suid = 0;
+    pSubmitTbData->uid = uid;
+    pSubmitTbData->sver = 1;
+    pSubmitTbData->aRowP = taosArrayInit(keys.size(), sizeof(SRow *));
+
+    SArray *aColVal = taosArrayInit(2, sizeof(SColVal));
+    for (int64_t ts : keys) {
+      taosArrayClear(aColVal);
+      SValue tsVal = {0};
+      tsVal.type = TSDB_DATA_TYPE_TIMESTAMP;
+      tsVal.val = ts;
+      SValue vVal = {0};
+      vVal.type = TSDB_DATA_TYPE_BIGINT;
+      vVal.val = version;
+
+      SColVal cv = COL_VAL_VALUE(1, tsVal);
+      taosArrayPush(aColVal, &cv);
+      cv = COL_VAL_VALUE(2, vVal);
+      taosArrayPush(aColVal, &cv);
+
+      SRow *pRow = NULL;
+      EXPECT_EQ(tRowBuild(aColVal, pTSchema, &pRow), 0);
+      taosArrayPush(pSubmitTbData->aRowP, &pRow);
+    }
+    taosArrayDestroy(aColVal);
+
+    return pSubmitTbData;
+  }
+
+  void destroySubmitTbData(SSubmitTbData *pSubmitTbData) {
+    if (pSubmitTbData->flags & SUBMIT_REQ_COLUMN_DATA_FORMAT) {
+      taosArrayDestroyEx(pSubmitTbData->aCol, tColDataDestroy);
+    } else {
+      for (int32_t i = 0; i < taosArrayGetSize(pSubmitTbData->aRowP); i++) {
+        tRowDestroy(*(SRow **)taosArrayGet(pSubmitTbData->aRowP, i));
+      }
+      taosArrayDestroy(pSubmitTbData->aRowP);
+    }
+    taosMemoryFree(pSubmitTbData);
+  }
+
+  // build a column format submit of the given keys, the value column holds the version
+  SSubmitTbData *buildColSubmitTbData(tb_uid_t uid, const std::vector<int64_t> &keys, int64_t version) {
+    cacheSchema(uid, pTSchema);
+
+    SSubmitTbData *pSubmitTbData = (SSubmitTbData *)taosMemoryCalloc(1, sizeof(SSubmitTbData));
+    pSubmitTbData->flags = SUBMIT_REQ_COLUMN_DATA_FORMAT;
+    pSubmitTbData->suid = 0;
+    pSubmitTbData->uid = uid;
+    pSubmitTbData->sver = 1;
+    pSubmitTbData->aCol = taosArrayInit(2, sizeof(SColData));
+
+    SColData aColData[2] = {0};
+    tColDataInit(&aColData[0], 1, TSDB_DATA_TYPE_TIMESTAMP, 0);
+    tColDataInit(&aColData[1], 2, TSDB_DATA_TYPE_BIGINT, 0);
+    for (int64_t ts : keys) {
+      SValue tsVal = {0};
+      tsVal.type = TSDB_DATA_TYPE_TIMESTAMP;
+      tsVal.val = ts;
+      SValue vVal = {0};
+      vVal.type = TSDB_DATA_TYPE_BIGINT;
+      vVal.val = version;
+
+      SColVal cv = COL_VAL_VALUE(1, tsVal);
+      EXPECT_EQ(tColDataAppendValue(&aColData[0], &cv), 0);
+      cv = COL_VAL_VALUE(2, vVal);
+      EXPECT_EQ(tColDataAppendValue(&aColData[1], &cv), 0);
+    }
+    taosArrayPush(pSubmitTbData->aCol, &aColData[0]);
+    taosArrayPush(pSubmitTbData->aCol, &aColData[1]);
+
+    return pSubmitTbData;
+  }
+
+  // submit rows are sorted by key in a request
+  void insert(tb_uid_t uid, std::vector<int64_t> keys, int64_t version, bool colFormat = false) {
+    std::sort(keys.begin(), keys.end());
+    SSubmitTbData *pSubmitTbData =
+        colFormat ? buildColSubmitTbData(uid, keys, version) : buildSubmitTbData(uid, keys, version);
+    int32_t        affectedRows = 0;
+    ASSERT_EQ(tsdbInsertTableData(pTsdb, version, pSubmitTbData, &affectedRows), 0);
+    ASSERT_EQ(affectedRows, (int32_t)keys.size());
+    destroySubmitTbData(pSubmitTbData);
+
+    for (int64_t ts : keys) {
+      expected[uid].push_back(TsVer(ts, version));
+    }
+  }
+
+  // the value column of every row holds the version of the row
+  std::vector<TsVer> scan(tb_uid_t uid, STsdbRowKey *pFrom, int8_t backward) {
+    std::vector<TsVer> rows;
+    STbData           *pTbData = tsdbGetTbDataFromMemTable(pTsdb->mem, 0, uid);
+    if (pTbData == NULL) return rows;
+
+    STbDataIter iter = {0};
+    tsdbTbDataIterOpen(pTbData, pFrom, backward, &iter);
+    for (TSDBROW *pRow = tsdbTbDataIterGet(&iter); pRow; pRow = nextRow(&iter)) {
+      STsdbRowKey key;
+      SColVal     cv;
+      tsdbRowGetKey(pRow, &key);
+      tsdbRowGetColVal(pRow, pTSchema, 1, &cv);
+      EXPECT_TRUE(COL_VAL_IS_VALUE(&cv));
+      EXPECT_EQ(cv.value.val, key.version);
+      rows.push_back(TsVer(key.key.ts, key.version));
+    }
+    return rows;
+  }
+
+  std::vector<TsVer> sortedExpected(tb_uid_t uid, bool backward) {
+    std::vector<TsVer> rows = expected[uid];
+    std::sort(rows.begin(), rows.end());
+    if (backward) std::reverse(rows.begin(), rows.end());
+    return rows;
+  }
+
+  SVnode                                 *pVnode = nullptr;
+  STsdb                                  *pTsdb = nullptr;
+  STSchema                               *pTSchema = nullptr;
+  std::map<tb_uid_t, std::vector<TsVer> > expected;
+};
+
+// the buffer pools take their lock and the insert pool is started only with several insert threads
+class TsdbMemTableParallelTest : public TsdbMemTableTest {
+ protected:
+  void SetUp() override {
+    insertThreads = tsNumOfVnodeInsertThreads;
+    tsNumOfVnodeInsertThreads = 4;
+    TsdbMemTableTest::SetUp();
+    ASSERT_EQ(vnodeAsyncInit(&vnodeAsyncHandle[3], (char *)"vnode-insert"), 0);
+    ASSERT_EQ(vnodeAsyncSetWorkers(vnodeAsyncHandle[3], tsNumOfVnodeInsertThreads), 0);
+  }
+
+  void TearDown() override {
+    vnodeAsyncDestroy(&vnodeAsyncHandle[3]);
+    TsdbMemTableTest::TearDown();
+    tsNumOfVnodeInsertThreads = insertThreads;
+  }
+
+  void addTbData(SArray *aSubmitTbData, tb_uid_t uid, const std::vector<int64_t> &keys, int64_t version) {
+    SSubmitTbData *pSubmitTbData = buildSubmitTbData(uid, keys, version);
+    taosArrayPush(aSubmitTbData, pSubmitTbData);
+    taosMemoryFree(pSubmitTbData);
+
+    for (int64_t ts : keys) {
+      expected[uid].push_back(TsVer(ts, version));
+    }
+  }
+
+  void destroyTbDataArray(SArray *aSubmitTbData) {
+    for (int32_t i = 0; i < taosArrayGetSize(aSubmitTbData); i++) {
+      SSubmitTbData *pSubmitTbData = (SSubmitTbData *)taosArrayGet(aSubmitTbData, i);
+      for (int32_t j = 0; j < taosArrayGetSize(pSubmitTbData->aRowP); j++) {
+        tRowDestroy(*(SRow **)taosArrayGet(pSubmitTbData->aRowP, j));
+      }
+      taosArrayDestroy(pSubmitTbData->aRowP);
+    }
+    taosArrayDestroy(aSubmitTbData);
+  }
+
+  int32_t insertThreads = 1;
+};
+
+STsdbRowKey rowKey(int64_t ts, int64_t version) {
+  STsdbRowKey key = {0};
+  key.key.ts = ts;
+  key.key.numOfPKs = 0;
+  key.version = version;
+  return key;
+}
+
+}  // namespace
+
+TEST_F(TsdbMemTableTest, inOrderAppendsGoToTail) {
+  const tb_uid_t uid = 1001;
+
+  int64_t version = 1;
+  for (int64_t start = 1; start <= 3000; start += 300) {
+    std::vector<int64_t> keys;
+    for (int64_t ts = start; ts < start + 300; ts++) keys.push_back(ts);
+    insert(uid, keys, version++);
+  }
+
+  STbData *pTbData = tsdbGetTbDataFromMemTable(pTsdb->mem, 0, uid);
+  ASSERT_NE(pTbData, nullptr);
+  ASSERT_EQ(pTbData->sl.size, 0);
+  ASSERT_EQ(pTbData->tail.size, 3000);
+  ASSERT_EQ(tsdbGetNRowsInTbData(pTbData), 3000);
+  ASSERT_EQ(pTbData->minKey, 1);
+  ASSERT_EQ(pTbData->maxKey, 3000);
+
+  ASSERT_EQ(scan(uid, NULL, 0), sortedExpected(uid, false));
+  ASSERT_EQ(scan(uid, NULL, 1), sortedExpected(uid, true));
+
+  // open in the middle of a chunk, and across chunk boundaries
+  for (int64_t ts : {1, 8, 9, 24, 25, 1500, 2999, 3000}) {
+    STsdbRowKey from = rowKey(ts, 0);
+    std::vector<TsVer> forward = scan(uid, &from, 0);
+    ASSERT_EQ(forward.size(), 3000 - ts + 1);
+    ASSERT_EQ(forward.front().first, ts);
+
+    from = rowKey(ts, INT64_MAX);
+    std::vector<TsVer> backward = scan(uid, &from, 1);
+    ASSERT_EQ(backward.size(), ts);
+    ASSERT_EQ(backward.front().first, ts);
+    ASSERT_EQ(backward.back().first, 1);
+  }
+
+  // out of range keys
+  STsdbRowKey from = rowKey(3001, 0);
+  ASSERT_TRUE(scan(uid, &from, 0).empty());
+  from = rowKey(0, INT64_MAX);
+  ASSERT_TRUE(scan(uid, &from, 1).empty());
+}
+
+TEST_F(TsdbMemTableTest, outOfOrderAppendsMergeWithTail) {
+  const tb_uid_t uid = 1002;
+
+  // tail
+  std::vector<int64_t> keys;
+  for (int64_t ts = 1000; ts < 2000; ts += 2) keys.push_back(ts);
+  insert(uid, keys, 1);
+
+  // all before the last key, go to the skiplist and interleave with the tail
+  keys.clear();
+  for (int64_t ts = 1; ts < 2000; ts += 2) keys.push_back(ts);
+  insert(uid, keys, 2);
+
+  // a batch split into a skiplist prefix and a tail suffix
+  keys.clear();
+  for (int64_t ts = 1990; ts < 2100; ts++) keys.push_back(ts);
+  insert(uid, keys, 3);
+
+  STbData *pTbData = tsdbGetTbDataFromMemTable(pTsdb->mem, 0, uid);
+  ASSERT_NE(pTbData, nullptr);
+  ASSERT_GT(pTbData->sl.size, 0);
+  ASSERT_GT(pTbData->tail.size, 0);
+  ASSERT_EQ(tsdbGetNRowsInTbData(pTbData), (int32_t)expected[uid].size());
+  ASSERT_EQ(pTbData->minKey, 1);
+  ASSERT_EQ(pTbData->maxKey, 2099);
+
+  ASSERT_EQ(scan(uid, NULL, 0), sortedExpected(uid, false));
+  ASSERT_EQ(scan(uid, NULL, 1), sortedExpected(uid, true));
+
+  // every open position yields the suffix/prefix of the merged order
+  std::vector<TsVer> all = sortedExpected(uid, false);
+  for (int64_t ts : {1, 2, 999, 1000, 1001, 1990, 1991, 1999, 2000, 2099}) {
+    STsdbRowKey from = rowKey(ts, 0);
+    auto        it = std::lower_bound(all.begin(), all.end(), TsVer(ts, 0));
+    ASSERT_EQ(scan(uid, &from, 0), std::vector<TsVer>(it, all.end()));
+
+    from = rowKey(ts, INT64_MAX);
+    auto               rit = std::upper_bound(all.begin(), all.end(), TsVer(ts, INT64_MAX));
+    std::vector<TsVer> prefix(all.begin(), rit);
+    std::reverse(prefix.begin(), prefix.end());
+    ASSERT_EQ(scan(uid, &from, 1), prefix);
+  }
+}
+
+TEST_F(TsdbMemTableTest, duplicateKeysKeepVersionOrder) {
+  const tb_uid_t uid = 1003;
+
+  std::vector<int64_t> keys;
+  for (int64_t ts = 1; ts <= 100; ts++) keys.push_back(ts);
+  insert(uid, keys, 1);
+
+  // same keys with newer versions: the last key is larger than the existing last key by version only,
+  // so the duplicates of the tail go to the skiplist except the last one
+  insert(uid, keys, 2);
+
+  // duplicates of the middle
+  keys.clear();
+  for (int64_t ts = 40; ts <= 60; ts++) keys.push_back(ts);
+  insert(uid, keys, 3);
+
+  // a duplicate of the last key only
+  insert(uid, {100}, 4);
+
+  STbData *pTbData = tsdbGetTbDataFromMemTable(pTsdb->mem, 0, uid);
+  ASSERT_NE(pTbData, nullptr);
+  ASSERT_EQ(tsdbGetNRowsInTbData(pTbData), (int32_t)expected[uid].size());
+  ASSERT_EQ(pTbData->maxKey, 100);
+
+  std::vector<TsVer> forward = scan(uid, NULL, 0);
+  ASSERT_EQ(forward, sortedExpected(uid, false));
+  ASSERT_EQ(scan(uid, NULL, 1), sortedExpected(uid, true));
+
+  // the rows of one key are adjacent and ordered by version
+  STsdbRowKey        from = rowKey(50, 0);
+  std::vector<TsVer> rows = scan(uid, &from, 0);
+  ASSERT_GE(rows.size(), 3);
+  ASSERT_EQ(rows[0], TsVer(50, 1));
+  ASSERT_EQ(rows[1], TsVer(50, 2));
+  ASSERT_EQ(rows[2], TsVer(50, 3));
+
+  from = rowKey(100, INT64_MAX);
+  rows = scan(uid, &from, 1);
+  ASSERT_GE(rows.size(), 3);
+  ASSERT_EQ(rows[0], TsVer(100, 4));
+  ASSERT_EQ(rows[1], TsVer(100, 2));
+  ASSERT_EQ(rows[2], TsVer(100, 1));
+}
+
+TEST_F(TsdbMemTableTest, rowsAppendedAfterOpenAreVisible) {
+  const tb_uid_t uid = 1004;
+
+  std::vector<int64_t> keys;
+  for (int64_t ts = 1; ts <= 10; ts++) keys.push_back(ts);
+  insert(uid, keys, 1);
+
+  STbData    *pTbData = tsdbGetTbDataFromMemTable(pTsdb->mem, 0, uid);
+  STbDataIter iter = {0};
+  tsdbTbDataIterOpen(pTbData, NULL, 0, &iter);
+
+  // fill the current chunk and grow new ones
+  keys.clear();
+  for (int64_t ts = 11; ts <= 100; ts++) keys.push_back(ts);
+  insert(uid, keys, 2);
+
+  int64_t n = 0;
+  int64_t lastTs = 0;
+  for (TSDBROW *pRow = tsdbTbDataIterGet(&iter); pRow; pRow = nextRow(&iter)) {
+    ASSERT_GT(TSDBROW_TS(pRow), lastTs);
+    lastTs = TSDBROW_TS(pRow);
+    n++;
+  }
+  ASSERT_EQ(n, 100);
+}
+
+TEST_F(TsdbMemTableParallelTest, multiTableSubmitWithDuplicateUids) {
+  const int32_t nTable = 16;
+  const int32_t nShard = 4;
+  int64_t       nRow = 0;
+
+  for (int64_t version = 10; version <= 11; version++) {
+    SArray *aSubmitTbData = taosArrayInit(nTable + 2, sizeof(SSubmitTbData));
+
+    // each table takes 500 keys of its own range per request
+    for (tb_uid_t uid = 2001; uid < 2001 + nTable; uid++) {
+      std::vector<int64_t> keys;
+      int64_t              start = (uid - 2001) * 10000 + (version - 10) * 1000;
+      for (int64_t ts = start; ts < start + 1000; ts += 2) keys.push_back(ts);
+      addTbData(aSubmitTbData, uid, keys, version);
+    }
+
+    // the same uid again in the request, out of order with its first part and appended after it, so they must be
+    // inserted by one thread
+    std::vector<int64_t> keys;
+    int64_t              start = (version - 10) * 1000 + 1;
+    for (int64_t ts = start; ts < start + 1000; ts += 2) keys.push_back(ts);
+    addTbData(aSubmitTbData, 2001, keys, version);
+
+    keys.clear();
+    for (int64_t ts = 5000 + version * 100; ts < 5000 + version * 100 + 100; ts++) keys.push_back(ts);
+    addTbData(aSubmitTbData, 2001, keys, version);
+
+    int32_t affectedRows = 0;
+    int32_t reqRows = 0;
+    for (int32_t i = 0; i < taosArrayGetSize(aSubmitTbData); i++) {
+      reqRows += taosArrayGetSize(((SSubmitTbData *)taosArrayGet(aSubmitTbData, i))->aRowP);
+    }
+    ASSERT_EQ(vnodeInsertSubmitTbDataParallel(pTsdb, version, aSubmitTbData, nShard, &affectedRows), 0);
+    ASSERT_EQ(affectedRows, reqRows);
+    nRow += reqRows;
+    destroyTbDataArray(aSubmitTbData);
+  }
+
+  SMemTable *pMemTable = pTsdb->mem;
+  ASSERT_EQ(pMemTable->nRow, nRow);
+  ASSERT_EQ(pMemTable->minKey, 0);
+  ASSERT_EQ(pMemTable->maxKey, (nTable - 1) * 10000 + 1998);
+  ASSERT_EQ(pMemTable->minVer, 10);
+  ASSERT_EQ(pMemTable->maxVer, 11);
+  ASSERT_EQ(pMemTable->nTbData, nTable);
+
+  for (tb_uid_t uid = 2001; uid < 2001 + nTable; uid++) {
+    STbData *pTbData = tsdbGetTbDataFromMemTable(pMemTable, 0, uid);
+    ASSERT_NE(pTbData, nullptr);
+    ASSERT_EQ(tsdbGetNRowsInTbData(pTbData), (int32_t)expected[uid].size()) << "uid " << uid;
+    ASSERT_EQ(scan(uid, NULL, 0), sortedExpected(uid, false)) << "uid " << uid;
+  }
+}
+
+
+TEST_F(TsdbMemTableTest, tailKeepsRowsInColumns) {
+  const tb_uid_t uid = 1005;
+
+  std::vector<int64_t> keys;
+  for (int64_t ts = 1; ts <= 100; ts++) keys.push_back(ts);
+  insert(uid, keys, 1);
+
+  // a column format submit goes to the same chunks
+  keys.clear();
+  for (int64_t ts = 101; ts <= 200; ts++) keys.push_back(ts);
+  insert(uid, keys, 2, true);
+
+  STbData *pTbData = tsdbGetTbDataFromMemTable(pTsdb->mem, 0, uid);
+  ASSERT_NE(pTbData, nullptr);
+  ASSERT_EQ(pTbData->sl.size, 0);
+  ASSERT_EQ(pTbData->tail.size, 200);
+
+  // the chunks are full and grow, the rows are in the columns of the chunks
+  int64_t nRow = 0;
+  for (SMemTailChunk *pChunk = pTbData->tail.pHead; pChunk; pChunk = pChunk->next) {
+    ASSERT_EQ(pChunk->bData.nRow, pChunk->nRow);
+    ASSERT_EQ(pChunk->bData.nColData, 1);
+    ASSERT_EQ(pChunk->bData.aColData[0].cid, 2);
+    if (pChunk->next) {
+      ASSERT_EQ(pChunk->nRow, pChunk->capacity);
+      ASSERT_LE(pChunk->capacity, pChunk->next->capacity);
+    }
+    for (int32_t iRow = 0; iRow < pChunk->nRow; iRow++) {
+      ASSERT_EQ(pChunk->bData.aTSKEY[iRow], nRow + iRow + 1);
+    }
+    nRow += pChunk->nRow;
+  }
+  ASSERT_EQ(nRow, 200);
+
+  STbDataIter iter = {0};
+  tsdbTbDataIterOpen(pTbData, NULL, 0, &iter);
+  TSDBROW *pRow = tsdbTbDataIterGet(&iter);
+  ASSERT_NE(pRow, nullptr);
+  ASSERT_EQ(pRow->type, TSDBROW_COL_FMT);
+
+  ASSERT_EQ(scan(uid, NULL, 0), sortedExpected(uid, false));
+  ASSERT_EQ(scan(uid, NULL, 1), sortedExpected(uid, true));
+}
+
+TEST_F(TsdbMemTableTest, tailVarColumnsSealChunkWhenFull) {
+  const tb_uid_t uid = 1006;
+
+  SSchema aSchema[] = {
+      {.type = TSDB_DATA_TYPE_TIMESTAMP, .flags = 0, .colId = 1, .bytes = 8, .name = "ts"},
+      {.type = TSDB_DATA_TYPE_INT, .flags = 0, .colId = 2, .bytes = 4, .name = "i"},
+      {.type = TSDB_DATA_TYPE_VARCHAR, .flags = 0, .colId = 3, .bytes = 200 + VARSTR_HEADER_SIZE, .name = "s"},
+  };
+  STSchema *pVarSchema = tBuildTSchema(aSchema, 3, 2);
+  ASSERT_NE(pVarSchema, nullptr);
+  cacheSchema(uid, pVarSchema);
+
+  // empty strings fill the first chunk, then long values take more than the next chunk reserves
+  std::vector<std::string> values;
+  for (int32_t i = 0; i < 8; i++) values.push_back("");
+  for (int32_t i = 0; i < 40; i++) values.push_back(std::string(100, 'a' + i % 26));
+  for (int32_t i = 0; i < 40; i++) values.push_back(std::string(i % 7, 'x'));
+
+  SSubmitTbData *pSubmitTbData = (SSubmitTbData *)taosMemoryCalloc(1, sizeof(SSubmitTbData));
+  pSubmitTbData->uid = uid;
+  pSubmitTbData->sver = 2;
+  pSubmitTbData->aRowP = taosArrayInit(values.size(), sizeof(SRow *));
+  SArray *aColVal = taosArrayInit(3, sizeof(SColVal));
+  for (int32_t i = 0; i < values.size(); i++) {
+    taosArrayClear(aColVal);
+    SValue tsVal = {0};
+    tsVal.type = TSDB_DATA_TYPE_TIMESTAMP;
+    tsVal.val = i + 1;
+    SValue iVal = {0};
+    iVal.type = TSDB_DATA_TYPE_INT;
+    iVal.val = i;
+    SValue sVal = {0};
+    sVal.type = TSDB_DATA_TYPE_VARCHAR;
+    sVal.nData = values[i].size();
+    sVal.pData = (uint8_t *)values[i].data();
+
+    SColVal cv = COL_VAL_VALUE(1, tsVal);
+    taosArrayPush(aColVal, &cv);
+    // every 5th row has a null int, and every 3rd no string at all
+    cv = (i % 5 == 0) ? COL_VAL_NULL(2, TSDB_DATA_TYPE_INT) : COL_VAL_VALUE(2, iVal);
+    taosArrayPush(aColVal, &cv);
+    cv = (i % 3 == 0) ? COL_VAL_NONE(3, TSDB_DATA_TYPE_VARCHAR) : COL_VAL_VALUE(3, sVal);
+    taosArrayPush(aColVal, &cv);
+
+    SRow *pRow = NULL;
+    ASSERT_EQ(tRowBuild(aColVal, pVarSchema, &pRow), 0);
+    taosArrayPush(pSubmitTbData->aRowP, &pRow);
+  }
+  taosArrayDestroy(aColVal);
+
+  int32_t affectedRows = 0;
+  ASSERT_EQ(tsdbInsertTableData(pTsdb, 1, pSubmitTbData, &affectedRows), 0);
+  ASSERT_EQ(affectedRows, (int32_t)values.size());
+  destroySubmitTbData(pSubmitTbData);
+
+  STbData *pTbData = tsdbGetTbDataFromMemTable(pTsdb->mem, 0, uid);
+  ASSERT_NE(pTbData, nullptr);
+  ASSERT_EQ(pTbData->tail.size, (int64_t)values.size());
+
+  // a chunk is sealed before it is full once a string does not fit in
+  bool sealed = false;
+  for (SMemTailChunk *pChunk = pTbData->tail.pHead; pChunk->next; pChunk = pChunk->next) {
+    sealed = sealed || (pChunk->nRow < pChunk->capacity);
+  }
+  ASSERT_TRUE(sealed);
+
+  STbDataIter iter = {0};
+  int32_t     i = 0;
+  tsdbTbDataIterOpen(pTbData, NULL, 0, &iter);
+  for (TSDBROW *pRow = tsdbTbDataIterGet(&iter); pRow; pRow = nextRow(&iter), i++) {
+    SColVal cv;
+    ASSERT_EQ(TSDBROW_TS(pRow), i + 1);
+
+    tsdbRowGetColVal(pRow, pVarSchema, 1, &cv);
+    if (i % 5 == 0) {
+      ASSERT_TRUE(COL_VAL_IS_NULL(&cv)) << "row " << i;
+    } else {
+      ASSERT_TRUE(COL_VAL_IS_VALUE(&cv)) << "row " << i;
+      ASSERT_EQ((int32_t)cv.value.val, i);
+    }
+
+    tsdbRowGetColVal(pRow, pVarSchema, 2, &cv);
+    if (i % 3 == 0) {
+      ASSERT_TRUE(COL_VAL_IS_NONE(&cv)) << "row " << i;
+    } else {
+      ASSERT_TRUE(COL_VAL_IS_VALUE(&cv)) << "row " << i;
+      ASSERT_EQ(std::string((char *)cv.value.pData, cv.value.nData), values[i]) << "row " << i;
+    }
+  }
+  ASSERT_EQ(i, (int32_t)values.size());
+
+  tDestroyTSchema(pVarSchema);
+}
+
+TEST_F(TsdbMemTableTest, tailRowsCopiedByColumn) {
+  const tb_uid_t uid = 1007;
+
+  std::vector<int64_t> keys;
+  for (int64_t ts = 1; ts <= 40; ts++) keys.push_back(ts);
+  insert(uid, keys, 1);
+
+  STbData *pTbData = tsdbGetTbDataFromMemTable(pTsdb->mem, 0, uid);
+  ASSERT_NE(pTbData, nullptr);
+  SMemTailChunk *pChunk = pTbData->tail.pHead->next;
+  ASSERT_NE(pChunk, nullptr);
+  ASSERT_GE(pChunk->nRow, 12);
+
+  // the block of a later schema has a column the rows do not have
+  SSchema aSchema[] = {
+      {.type = TSDB_DATA_TYPE_TIMESTAMP, .flags = 0, .colId = 1, .bytes = 8, .name = "ts"},
+      {.type = TSDB_DATA_TYPE_BIGINT, .flags = 0, .colId = 2, .bytes = 8, .name = "v"},
+      {.type = TSDB_DATA_TYPE_DOUBLE, .flags = 0, .colId = 3, .bytes = 8, .name = "w"},
+  };
+  STSchema *pBlockSchema = tBuildTSchema(aSchema, 3, 2);
+  ASSERT_NE(pBlockSchema, nullptr);
+
+  TABLEID    id = {.suid = 0, .uid = 0};
+  SBlockData byColumn = {0};
+  SBlockData byRow = {0};
+  id.suid = 1;  // rows of several tables, with a uid per row
+  ASSERT_EQ(tBlockDataCreate(&byColumn), 0);
+  ASSERT_EQ(tBlockDataCreate(&byRow), 0);
+  ASSERT_EQ(tBlockDataInit(&byColumn, &id, pBlockSchema, NULL, 0), 0);
+  ASSERT_EQ(tBlockDataInit(&byRow, &id, pBlockSchema, NULL, 0), 0);
+
+  ASSERT_EQ(tBlockDataAppendBlockRows(&byColumn, &pChunk->bData, 2, 10, uid), 0);
+  for (int32_t iRow = 2; iRow < 12; iRow++) {
+    TSDBROW row = tsdbRowFromBlockData(&pChunk->bData, iRow);
+    ASSERT_EQ(tBlockDataAppendRow(&byRow, &row, NULL, uid), 0);
+  }
+
+  ASSERT_EQ(byColumn.nRow, 10);
+  ASSERT_EQ(byColumn.nRow, byRow.nRow);
+  ASSERT_EQ(byColumn.nColData, 2);
+  for (int32_t iRow = 0; iRow < byColumn.nRow; iRow++) {
+    ASSERT_EQ(byColumn.aUid[iRow], uid);
+    ASSERT_EQ(byColumn.aVersion[iRow], byRow.aVersion[iRow]);
+    ASSERT_EQ(byColumn.aTSKEY[iRow], byRow.aTSKEY[iRow]);
+    ASSERT_EQ(byColumn.aTSKEY[iRow], pChunk->bData.aTSKEY[iRow + 2]);
+
+    SColVal cv1, cv2;
+    tColDataGetValue(&byColumn.aColData[0], iRow, &cv1);
+    tColDataGetValue(&byRow.aColData[0], iRow, &cv2);
+    ASSERT_TRUE(COL_VAL_IS_VALUE(&cv1));
+    ASSERT_EQ(cv1.value.val, cv2.value.val);
+
+    tColDataGetValue(&byColumn.aColData[1], iRow, &cv1);
+    ASSERT_TRUE(COL_VAL_IS_NONE(&cv1));
+  }
+
+  // appended after the rows already in the block
+  ASSERT_EQ(tBlockDataAppendBlockRows(&byColumn, &pChunk->bData, 12, 1, uid), 0);
+  ASSERT_EQ(byColumn.nRow, 11);
+  ASSERT_EQ(byColumn.aTSKEY[10], pChunk->bData.aTSKEY[12]);
+
+  tBlockDataDestroy(&byColumn);
+  tBlockDataDestroy(&byRow);
+  tDestroyTSchema(pBlockSchema);
+}
+
+#pragma GCC diagnostic pop
@@ -0,0 +1,231 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "tglobal.h"
+#include "tsdb.h"
+#include "tsdbFS2.h"
+#include "vnd.h"
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wwrite-strings"
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#pragma GCC diagnostic ignored "-Wsign-compare"
+
+namespace {
+
+#define MB (1LL << 20)
+#define S  1000000LL
+
+// the clock is a process wide static, each test starts it over with a rate of its own
+class TsdbMergeAdmitTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    tsTsdbMergeAdmitRate = 0;
+    tsdbMergeAdmitDelay(0);
+  }
+
+  void TearDown() override { tsTsdbMergeAdmitRate = 0; }
+
+  void setRate(int32_t rate) {
+    tsTsdbMergeAdmitRate = rate;
+    tsdbMergeAdmitDelay(0);
+  }
+
+  // far from zero, so the burst allowance does not reach back to an unset clock
+  int64_t t0 = 1000 * S;
+};
+
+// a tsdb of one empty file set, merged on the merge workers
+class TsdbMergeDeferTest : public TsdbMergeAdmitTest {
+ protected:
+  void SetUp() override {
+    TsdbMergeAdmitTest::SetUp();
+    ASSERT_EQ(vnodeAsyncInit(&vnodeAsyncHandle[1], "vnode-merge"), 0);
+
+    pVnode = (SVnode *)taosMemoryCalloc(1, sizeof(SVnode));
+    pTsdb = (STsdb *)taosMemoryCalloc(1, sizeof(STsdb));
+    pFS = (STFileSystem *)taosMemoryCalloc(1, sizeof(STFileSystem));
+    ASSERT_NE(pVnode, nullptr);
+    ASSERT_NE(pTsdb, nullptr);
+    ASSERT_NE(pFS, nullptr);
+    pVnode->config.vgId = 2;
+    pVnode->config.sttTrigger = 2;
+    pTsdb->pVnode = pVnode;
+    pTsdb->pFS = pFS;
+    taosThreadMutexInit(&pTsdb->mutex, NULL);
+    pFS->tsdb = pTsdb;
+    TARRAY2_INIT(pFS->fSetArr);
+
+    ASSERT_EQ(tsdbTFileSetInit(FID, &fset), 0);
+    ASSERT_EQ(TARRAY2_APPEND(pFS->fSetArr, fset), 0);
+    ASSERT_EQ(tsdbTFileSetOpenChannel(fset), 0);
+  }
+
+  void TearDown() override {
+    vnodeAChannelDestroy(vnodeAsyncHandle[1], fset->bgTaskChannel, true);
+    vnodeAsyncDestroy(&vnodeAsyncHandle[1]);
+    TARRAY2_DESTROY(pFS->fSetArr, tsdbTFileSetClear);
+    taosThreadMutexDestroy(&pTsdb->mutex);
+    taosMemoryFree(pFS);
+    taosMemoryFree(pTsdb);
+    taosMemoryFree(pVnode);
+    TsdbMergeAdmitTest::TearDown();
+  }
+
+  // runs a merge of the file set on the calling thread, as the merge worker would
+  void merge() {
+    SMergeArg arg = {pTsdb, FID};
+    ASSERT_EQ(tsdbMerge(&arg), 0);
+  }
+
+  void getMergeState(bool *scheduled, int64_t *deferTask) {
+    taosThreadMutexLock(&pTsdb->mutex);
+    *scheduled = fset->mergeScheduled;
+    *deferTask = fset->mergeDeferTask;
+    taosThreadMutexUnlock(&pTsdb->mutex);
+  }
+
+  static constexpr int32_t FID = 1;
+
+  SVnode       *pVnode = nullptr;
+  STsdb        *pTsdb = nullptr;
+  STFileSystem *pFS = nullptr;
+  STFileSet    *fset = nullptr;
+};
+
+}  // namespace
+
+TEST_F(TsdbMergeAdmitTest, unlimitedNeverThrottles) {
+  tsdbMergeAdmitCharge(1024 * MB, t0);
+  ASSERT_EQ(tsdbMergeAdmitDelay(t0), 0);
+}
+
+TEST_F(TsdbMergeAdmitTest, throttledUntilChargeIsPaid) {
+  setRate(1);
+  tsdbMergeAdmitCharge(2 * MB, t0);
+  ASSERT_GT(tsdbMergeAdmitDelay(t0), 0);
+  ASSERT_GT(tsdbMergeAdmitDelay(t0 + S), 0);
+  ASSERT_EQ(tsdbMergeAdmitDelay(t0 + 2 * S), 0);
+
+  // charges of concurrent merges queue up behind each other
+  tsdbMergeAdmitCharge(MB, t0 + 2 * S);
+  tsdbMergeAdmitCharge(MB, t0 + 2 * S);
+  ASSERT_GT(tsdbMergeAdmitDelay(t0 + 3 * S), 0);
+  ASSERT_EQ(tsdbMergeAdmitDelay(t0 + 4 * S), 0);
+}
+
+TEST_F(TsdbMergeAdmitTest, idleTimeKeptForShortBurstOnly) {
+  setRate(1);
+  tsdbMergeAdmitCharge(MB, t0);
+
+  // after a long idle time only a short burst is free, a big charge still throttles
+  int64_t t1 = t0 + 60 * S;
+  tsdbMergeAdmitCharge(MB / 2, t1);
+  ASSERT_GT(tsdbMergeAdmitDelay(t1), 0);
+  ASSERT_EQ(tsdbMergeAdmitDelay(t1 + S / 2), 0);
+
+  // a small charge fits in the burst
+  int64_t t2 = t1 + 60 * S;
+  tsdbMergeAdmitCharge(MB / 100, t2);
+  ASSERT_EQ(tsdbMergeAdmitDelay(t2), 0);
+}
+
+TEST_F(TsdbMergeAdmitTest, rateChangeResetsClock) {
+  setRate(1);
+  tsdbMergeAdmitCharge(100 * MB, t0);
+  ASSERT_GT(tsdbMergeAdmitDelay(t0 + 10 * S), 0);
+
+  // the debt booked at the old rate is dropped
+  tsTsdbMergeAdmitRate = 100;
+  ASSERT_EQ(tsdbMergeAdmitDelay(t0 + 10 * S), 0);
+  tsdbMergeAdmitCharge(100 * MB, t0 + 10 * S);
+  ASSERT_GT(tsdbMergeAdmitDelay(t0 + 10 * S), 0);
+  ASSERT_EQ(tsdbMergeAdmitDelay(t0 + 11 * S), 0);
+
+  // nor does turning the limit off and on again keep it
+  tsdbMergeAdmitCharge(1000 * MB, t0 + 11 * S);
+  tsTsdbMergeAdmitRate = 0;
+  ASSERT_EQ(tsdbMergeAdmitDelay(t0 + 11 * S), 0);
+  tsTsdbMergeAdmitRate = 100;
+  ASSERT_EQ(tsdbMergeAdmitDelay(t0 + 11 * S), 0);
+}
+
+TEST_F(TsdbMergeDeferTest, deferredMergeRunsWithoutCommit) {
+  // the clock runs about half a second ahead of now
+  setRate(1);
+  tsdbMergeAdmitCharge(MB / 2, taosGetTimestampUs());
+
+  bool    scheduled = false;
+  int64_t deferTask = 0;
+  int64_t startMs = taosGetTimestampMs();
+  merge();
+  getMergeState(&scheduled, &deferTask);
+  ASSERT_TRUE(scheduled);
+  ASSERT_TRUE(VNODE_ASYNC_VALID_TASK_ID(deferTask));
+
+  // the requeued merge starts on its own once the clock catches up, no commit edit comes in between
+  for (int32_t i = 0; i < 500 && (scheduled || VNODE_ASYNC_VALID_TASK_ID(deferTask)); i++) {
+    taosMsleep(10);
+    getMergeState(&scheduled, &deferTask);
+  }
+  ASSERT_FALSE(scheduled);
+  ASSERT_FALSE(VNODE_ASYNC_VALID_TASK_ID(deferTask));
+  ASSERT_GE(taosGetTimestampMs() - startMs, 300);
+  ASSERT_EQ(tsdbMergeAdmitDelay(taosGetTimestampUs()), 0);
+}
+
+TEST_F(TsdbMergeDeferTest, mergeBlockingCommitsNotDeferred) {
+  setRate(1);
+  tsdbMergeAdmitCharge(100 * MB, taosGetTimestampUs());
+
+  taosThreadMutexLock(&pTsdb->mutex);
+  fset->blockCommit = true;
+  taosThreadMutexUnlock(&pTsdb->mutex);
+
+  bool    scheduled = true;
+  int64_t deferTask = 0;
+  merge();
+  getMergeState(&scheduled, &deferTask);
+  ASSERT_FALSE(scheduled);
+  ASSERT_FALSE(VNODE_ASYNC_VALID_TASK_ID(deferTask));
+
+  taosThreadMutexLock(&pTsdb->mutex);
+  fset->blockCommit = false;
+  taosThreadMutexUnlock(&pTsdb->mutex);
+}
+
+TEST_F(TsdbMergeDeferTest, deferredMergeCanceledBeforeDue) {
+  setRate(1);
+  tsdbMergeAdmitCharge(100 * MB, taosGetTimestampUs());
+
+  bool    scheduled = false;
+  int64_t deferTask = 0;
+  merge();
+  getMergeState(&scheduled, &deferTask);
+  ASSERT_TRUE(VNODE_ASYNC_VALID_TASK_ID(deferTask));
+
+  // a merge not due yet is still waiting and can be canceled
+  ASSERT_EQ(vnodeACancel(vnodeAsyncHandle[1], deferTask), 0);
+
+  // nor does one hold up the close of the channel in the tear down
+  merge();
+  getMergeState(&scheduled, &deferTask);
+  ASSERT_TRUE(VNODE_ASYNC_VALID_TASK_ID(deferTask));
+}
+
+#pragma GCC diagnostic pop
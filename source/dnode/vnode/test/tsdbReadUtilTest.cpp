@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "tsdb.h"
+#include "tsdbReadUtil.h"
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wwrite-strings"
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#pragma GCC diagnostic ignored "-Wsign-compare"
+
+namespace {
+
+const int32_t kCapacity = 4096;
+
+SFileDataBlockInfo makeBlock(int64_t firstKey, int64_t lastKey, int32_t numRow, int32_t count) {
+  SFileDataBlockInfo block;
+  memset(&block, 0, sizeof(block));
+  block.uid = 1;
+  block.firstKey = firstKey;
+  block.lastKey = lastKey;
+  block.minVer = 10;
+  block.maxVer = 20;
+  block.numRow = numRow;
+  block.count = count;
+  return block;
+}
+
+class TsdbReadAheadTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    window.skey = INT64_MIN;
+    window.ekey = INT64_MAX;
+    verRange.minVer = 0;
+    verRange.maxVer = INT64_MAX;
+  }
+
+  STimeWindow   window;
+  SVersionRange verRange;
+};
+
+}  // namespace
+
+TEST_F(TsdbReadAheadTest, cleanBlockMayUseSma) {
+  SFileDataBlockInfo block = makeBlock(100, 199, 100, 100);
+  ASSERT_TRUE(fileBlockMayUseSma(&block, NULL, &window, &verRange, kCapacity, TSDB_ORDER_ASC));
+  ASSERT_TRUE(fileBlockMayUseSma(&block, NULL, &window, &verRange, kCapacity, TSDB_ORDER_DESC));
+}
+
+TEST_F(TsdbReadAheadTest, blockWithDupTsIsLoaded) {
+  SFileDataBlockInfo block = makeBlock(100, 199, 120, 100);
+  ASSERT_FALSE(fileBlockMayUseSma(&block, NULL, &window, &verRange, kCapacity, TSDB_ORDER_ASC));
+
+  block = makeBlock(100, 199, 100, 0);
+  ASSERT_FALSE(fileBlockMayUseSma(&block, NULL, &window, &verRange, kCapacity, TSDB_ORDER_ASC));
+}
+
+TEST_F(TsdbReadAheadTest, blockExceedCapacityIsLoaded) {
+  SFileDataBlockInfo block = makeBlock(100, 199, 100, 100);
+  ASSERT_FALSE(fileBlockMayUseSma(&block, NULL, &window, &verRange, 64, TSDB_ORDER_ASC));
+}
+
+TEST_F(TsdbReadAheadTest, partiallyRequiredBlockIsLoaded) {
+  SFileDataBlockInfo block = makeBlock(100, 199, 100, 100);
+
+  window.skey = 150;
+  ASSERT_FALSE(fileBlockMayUseSma(&block, NULL, &window, &verRange, kCapacity, TSDB_ORDER_ASC));
+
+  window.skey = INT64_MIN;
+  window.ekey = 150;
+  ASSERT_FALSE(fileBlockMayUseSma(&block, NULL, &window, &verRange, kCapacity, TSDB_ORDER_ASC));
+
+  window.skey = 100;
+  window.ekey = 199;
+  ASSERT_TRUE(fileBlockMayUseSma(&block, NULL, &window, &verRange, kCapacity, TSDB_ORDER_ASC));
+
+  verRange.maxVer = 15;
+  ASSERT_FALSE(fileBlockMayUseSma(&block, NULL, &window, &verRange, kCapacity, TSDB_ORDER_ASC));
+
+  verRange.minVer = 15;
+  verRange.maxVer = INT64_MAX;
+  ASSERT_FALSE(fileBlockMayUseSma(&block, NULL, &window, &verRange, kCapacity, TSDB_ORDER_ASC));
+}
+
+TEST_F(TsdbReadAheadTest, blockOverlapNeighborIsLoaded) {
+  SFileDataBlockInfo block = makeBlock(100, 199, 100, 100);
+  SFileDataBlockInfo next = makeBlock(199, 299, 100, 100);
+  SFileDataBlockInfo prev = makeBlock(0, 100, 100, 100);
+  ASSERT_FALSE(fileBlockMayUseSma(&block, &next, &window, &verRange, kCapacity, TSDB_ORDER_ASC));
+  ASSERT_FALSE(fileBlockMayUseSma(&block, &prev, &window, &verRange, kCapacity, TSDB_ORDER_DESC));
+
+  next = makeBlock(200, 299, 100, 100);
+  prev = makeBlock(0, 99, 100, 100);
+  ASSERT_TRUE(fileBlockMayUseSma(&block, &next, &window, &verRange, kCapacity, TSDB_ORDER_ASC));
+  ASSERT_TRUE(fileBlockMayUseSma(&block, &prev, &window, &verRange, kCapacity, TSDB_ORDER_DESC));
+}
+
+#pragma GCC diagnostic pop
@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "tbloomfilter.h"
+#include "tsdb.h"
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wwrite-strings"
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#pragma GCC diagnostic ignored "-Wsign-compare"
+
+namespace {
+
+#define INT_CID 2
+#define STR_CID 3
+
+// the key the block filter probes with: the raw bytes of the value
+bool mayContain(const SBloomFilter *pBF, const void *key, uint32_t len) {
+  return tBloomFilterNoContain(pBF, HASH_FUNCTION_1((const char *)key, len), HASH_FUNCTION_2((const char *)key, len)) !=
+         TSDB_CODE_SUCCESS;
+}
+
+std::string strKey(int32_t i) { return "key-" + std::to_string(i); }
+
+// an int and a varchar column of the even numbers below 2 * numOfKeys, every value twice, with NULLs in between
+class TsdbColumnBloomTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    tColDataInit(&intCol, INT_CID, TSDB_DATA_TYPE_INT, 0);
+    tColDataInit(&strCol, STR_CID, TSDB_DATA_TYPE_VARCHAR, 0);
+    ASSERT_EQ(tBufferInit(&buffer), 0);
+  }
+
+  void TearDown() override {
+    tColDataDestroy(&intCol);
+    tColDataDestroy(&strCol);
+    tBufferDestroy(&buffer);
+  }
+
+  void fill(int32_t numOfKeys) {
+    for (int32_t n = 0; n < 2; n++) {
+      for (int32_t i = 0; i < numOfKeys; i++) {
+        SColVal cv;
+        if (i % 7 == 3) {
+          cv = COL_VAL_NULL(INT_CID, TSDB_DATA_TYPE_INT);
+          ASSERT_EQ(tColDataAppendValue(&intCol, &cv), 0);
+          cv = COL_VAL_NULL(STR_CID, TSDB_DATA_TYPE_VARCHAR);
+          ASSERT_EQ(tColDataAppendValue(&strCol, &cv), 0);
+        }
+
+        SValue intVal = {0};
+        intVal.type = TSDB_DATA_TYPE_INT;
+        intVal.val = 2 * i;
+        cv = COL_VAL_VALUE(INT_CID, intVal);
+        ASSERT_EQ(tColDataAppendValue(&intCol, &cv), 0);
+
+        std::string key = strKey(2 * i);
+        SValue      strVal = {0};
+        strVal.type = TSDB_DATA_TYPE_VARCHAR;
+        strVal.pData = (uint8_t *)key.data();
+        strVal.nData = key.size();
+        cv = COL_VAL_VALUE(STR_CID, strVal);
+        ASSERT_EQ(tColDataAppendValue(&strCol, &cv), 0);
+      }
+    }
+  }
+
+  void get(SBufferReader *br, int16_t colId, SColumnDataBloom *pBloom) {
+    ASSERT_EQ(tGetColumnDataBloom(br, pBloom), 0);
+    ASSERT_EQ(pBloom->colId, colId);
+    ASSERT_NE(pBloom->pBloom, nullptr);
+  }
+
+  SColData intCol;
+  SColData strCol;
+  SBuffer  buffer;
+};
+
+}  // namespace
+
+TEST_F(TsdbColumnBloomTest, roundTrip) {
+  const int32_t numOfKeys = 1000;
+  fill(numOfKeys);
+
+  // the filters of a block are put one after another
+  ASSERT_EQ(tPutColumnDataBloom(&buffer, &intCol), 0);
+  ASSERT_EQ(tPutColumnDataBloom(&buffer, &strCol), 0);
+
+  SBufferReader    br = BUFFER_READER_INITIALIZER(0, &buffer);
+  SColumnDataBloom intBloom = {0}, strBloom = {0};
+  get(&br, INT_CID, &intBloom);
+  get(&br, STR_CID, &strBloom);
+  ASSERT_EQ(br.offset, tBufferGetSize(&buffer));
+
+  // no false negative
+  for (int32_t i = 0; i < numOfKeys; i++) {
+    int32_t     v = 2 * i;
+    std::string key = strKey(v);
+    ASSERT_TRUE(mayContain(intBloom.pBloom, &v, sizeof(v))) << v;
+    ASSERT_TRUE(mayContain(strBloom.pBloom, key.data(), key.size())) << key;
+  }
+
+  // false positives of unknown keys stay around the error rate
+  int32_t intHits = 0, strHits = 0;
+  for (int32_t i = 0; i < numOfKeys; i++) {
+    int32_t     v = 2 * i + 1;
+    std::string key = strKey(v);
+    intHits += mayContain(intBloom.pBloom, &v, sizeof(v));
+    strHits += mayContain(strBloom.pBloom, key.data(), key.size());
+  }
+  ASSERT_LT(intHits, numOfKeys / 20);
+  ASSERT_LT(strHits, numOfKeys / 20);
+
+  // a filter cut short is refused
+  br = BUFFER_READER_INITIALIZER(0, &buffer);
+  buffer.size = 3;
+  SColumnDataBloom bad = {0};
+  ASSERT_NE(tGetColumnDataBloom(&br, &bad), 0);
+  ASSERT_EQ(bad.pBloom, nullptr);
+
+  tColumnDataBloomClear(&intBloom);
+  tColumnDataBloomClear(&strBloom);
+}
+
+TEST_F(TsdbColumnBloomTest, sizedByDistinctValues) {
+  fill(10000);
+  ASSERT_EQ(tPutColumnDataBloom(&buffer, &intCol), 0);
+  uint32_t bigSize = tBufferGetSize(&buffer);
+
+  // as many rows, of a few distinct values
+  SColData fewCol;
+  tColDataInit(&fewCol, INT_CID, TSDB_DATA_TYPE_INT, 0);
+  for (int32_t i = 0; i < 20000; i++) {
+    SValue val = {0};
+    val.type = TSDB_DATA_TYPE_INT;
+    val.val = i % 10;
+    SColVal cv = COL_VAL_VALUE(INT_CID, val);
+    ASSERT_EQ(tColDataAppendValue(&fewCol, &cv), 0);
+  }
+  tBufferClear(&buffer);
+  ASSERT_EQ(tPutColumnDataBloom(&buffer, &fewCol), 0);
+  tColDataDestroy(&fewCol);
+  ASSERT_LT(tBufferGetSize(&buffer) * 100, bigSize);
+}
+
+TEST_F(TsdbColumnBloomTest, noFilterWithoutValue) {
+  for (int32_t i = 0; i < 10; i++) {
+    SColVal cv = COL_VAL_NULL(INT_CID, TSDB_DATA_TYPE_INT);
+    ASSERT_EQ(tColDataAppendValue(&intCol, &cv), 0);
+  }
+  ASSERT_EQ(tPutColumnDataBloom(&buffer, &intCol), 0);
+  ASSERT_EQ(tBufferGetSize(&buffer), 0);
+}
+
+#pragma GCC diagnostic pop
@@ -936,6 +936,12 @@ int32_t qExplainResNodeToRowsImpl(SExplainResNode *pResNode, SExplainCtx *ctx, i
         }
 
         EXPLAIN_ROW_APPEND("  loops:%d", pExecInfo->loops);
+        if (pExecInfo->writeBytes > 0) {
+          EXPLAIN_ROW_APPEND("  write:%.2f Kb  read:%.2f Kb", pExecInfo->writeBytes / 1024.0,
+                             pExecInfo->readBytes / 1024.0);
+          EXPLAIN_ROW_APPEND("  compress ratio:%.2f  compress time:%.2f ms",
+                             pExecInfo->rawBytes / (double)pExecInfo->writeBytes, pExecInfo->cmprTime / 1000.0);
+        }
         EXPLAIN_ROW_END();
         QRY_ERR_RET(qExplainResAppendRow(ctx, tbuf, tlen, level));
       }
@@ -1293,6 +1299,12 @@ int32_t qExplainResNodeToRowsImpl(SExplainResNode *pResNode, SExplainCtx *ctx, i
           }
 
           EXPLAIN_ROW_APPEND("  loops:%d", pExecInfo->loops);
+          if (pExecInfo->writeBytes > 0) {
+            EXPLAIN_ROW_APPEND("  write:%.2f Kb  read:%.2f Kb", pExecInfo->writeBytes / 1024.0,
+                               pExecInfo->readBytes / 1024.0);
+            EXPLAIN_ROW_APPEND("  compress ratio:%.2f  compress time:%.2f ms",
+                               pExecInfo->rawBytes / (double)pExecInfo->writeBytes, pExecInfo->cmprTime / 1000.0);
+          }
           EXPLAIN_ROW_END();
           QRY_ERR_RET(qExplainResAppendRow(ctx, tbuf, tlen, level));
         }
@@ -1515,6 +1527,12 @@ int32_t qExplainResNodeToRowsImpl(SExplainResNode *pResNode, SExplainCtx *ctx, i
         }
 
         EXPLAIN_ROW_APPEND("  loops:%d", pExecInfo->loops);
+        if (pExecInfo->writeBytes > 0) {
+          EXPLAIN_ROW_APPEND("  write:%.2f Kb  read:%.2f Kb", pExecInfo->writeBytes / 1024.0,
+                             pExecInfo->readBytes / 1024.0);
+          EXPLAIN_ROW_APPEND("  compress ratio:%.2f  compress time:%.2f ms",
+                             pExecInfo->rawBytes / (double)pExecInfo->writeBytes, pExecInfo->cmprTime / 1000.0);
+        }
         EXPLAIN_ROW_END();
         QRY_ERR_RET(qExplainResAppendRow(ctx, tbuf, tlen, level));
       }
@@ -1698,6 +1716,27 @@ int32_t qExplainResNodeToRowsImpl(SExplainResNode *pResNode, SExplainCtx *ctx, i
       EXPLAIN_ROW_END();
       QRY_ERR_RET(qExplainResAppendRow(ctx, tbuf, tlen, level));
 
+      if (EXPLAIN_MODE_ANALYZE == ctx->mode && pResNode->pExecInfo) {
+        SExplainExecInfo  *execInfo = taosArrayGet(pResNode->pExecInfo, 0);
+        SHashJoinExecInfo *pExecInfo = (SHashJoinExecInfo *)execInfo->verboseInfo;
+        if (pExecInfo) {
+          EXPLAIN_ROW_NEW(level + 1, "Hash Method: ");
+          EXPLAIN_ROW_APPEND("%s", pExecInfo->spilled ? "grace" : "in memory");
+          if (pExecInfo->spilled) {
+            EXPLAIN_ROW_APPEND("  partitions:%d  levels:%d  spill rows:%" PRId64, pExecInfo->partitions,
+                               pExecInfo->levels, pExecInfo->spillRows);
+            EXPLAIN_ROW_APPEND("  write:%.2f Kb  read:%.2f Kb", pExecInfo->writeBytes / 1024.0,
+                               pExecInfo->readBytes / 1024.0);
+            if (pExecInfo->writeBytes > 0) {
+              EXPLAIN_ROW_APPEND("  compress ratio:%.2f  compress time:%.2f ms",
+                                 pExecInfo->rawBytes / (double)pExecInfo->writeBytes, pExecInfo->cmprTime / 1000.0);
+            }
+          }
+          EXPLAIN_ROW_END();
+          QRY_ERR_RET(qExplainResAppendRow(ctx, tbuf, tlen, level));
+        }
+      }
+
       if (verbose) {
         EXPLAIN_ROW_NEW(level + 1, EXPLAIN_OUTPUT_FORMAT);
         EXPLAIN_ROW_APPEND(EXPLAIN_COLUMNS_FORMAT,
@@ -846,6 +846,7 @@ void    updateLoadRemoteInfo(SLoadRemoteDataInfo* pInfo, int64_t numOfRows, int3
 
 STimeWindow getFirstQualifiedTimeWindow(int64_t ts, STimeWindow* pWindow, SInterval* pInterval, int32_t order);
 int32_t     getBufferPgSize(int32_t rowSize, uint32_t* defaultPgsz, uint32_t* defaultBufsz);
+int32_t*    setupColumnOffset(const SSDataBlock* pBlock, int32_t rowCapacity);
 
 extern void doDestroyExchangeOperatorInfo(void* param);
 
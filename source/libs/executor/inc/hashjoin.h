@@ -24,6 +24,10 @@ extern "C" {
 #define HJOIN_BLK_SIZE_LIMIT 10485760
 #define HJOIN_ROW_BITMAP_SIZE (2 * 1048576)
 #define HJOIN_BLK_THRESHOLD_RATIO 0.9
+#define HJOIN_SPILL_PAGE_SIZE (64 * 1024)
+#define HJOIN_PART_BITS 4
+#define HJOIN_PART_NUM (1 << HJOIN_PART_BITS)
+#define HJOIN_PART_MAX_LEVEL 3
 
 typedef int32_t (*hJoinImplFp)(SOperatorInfo*);
 
@@ -117,6 +121,10 @@ typedef struct SHJoinTableCtx {
   int32_t        valBufSize;
   SArray*        valVarCols;
   bool           valColExist;
+
+  SSDataBlock*   spillBlk;
+  int32_t        spillRowCap;
+  int32_t*       spillColOffset;
 } SHJoinTableCtx;
 
 typedef struct SHJoinExecInfo {
@@ -128,6 +136,29 @@ typedef struct SHJoinExecInfo {
   int64_t expectRows;
 } SHJoinExecInfo;
 
+typedef struct SHJoinPartition {
+  int32_t level;
+  SArray* buildPages;
+  SArray* probePages;
+  int64_t buildRows;
+  int64_t probeRows;
+} SHJoinPartition;
+
+// grace hash join, both sides are partitioned by key hash to disk once the build side exceeds memBudget
+typedef struct SHJoinGraceCtx {
+  int64_t           memBudget;
+  int64_t           hashRows;
+  bool              spilled;
+  bool              nmatch;
+  bool              partLoaded;
+  SDiskbasedBuf*    pBuf;
+  SArray*           pParts;
+  SArray*           pNMatchPages;
+  int32_t           partIdx;
+  int32_t           pageIdx;
+  SHashJoinExecInfo execInfo;
+} SHJoinGraceCtx;
+
 
 typedef struct SHJoinOperatorInfo {
   EJoinType        joinType;
@@ -147,6 +178,7 @@ typedef struct SHJoinOperatorInfo {
   bool             keyHashBuilt;
   SHJoinCtx        ctx;
   SHJoinExecInfo   execInfo;
+  SHJoinGraceCtx   grace;
   int32_t          blkThreshold;
   hJoinImplFp      joinFp;  
 } SHJoinOperatorInfo;
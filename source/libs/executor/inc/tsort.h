@@ -47,6 +47,8 @@ typedef struct SSortSource {
   };
   int64_t fetchUs;
   int64_t fetchNum;
+  char*   pNormKey;     // normalized keys of the rows in src.pBlock, NULL if not built
+  int32_t normKeyCap;   // capacity in rows of pNormKey
 } SSortSource;
 
 typedef struct SMsortComparParam {
@@ -61,6 +63,11 @@ typedef struct SMsortComparParam {
   int32_t tsOrder;
   __compar_fn_t cmpTsFn;
   void* pPkOrder; // SBlockOrderInfo*
+
+  // the following fields to compare the rows by memcmp on their normalized keys
+  int32_t normKeyLen;    // bytes of the normalized key of one row, 0 if disabled
+  bool    normKeyExact;  // all order columns are encoded, so equal keys mean equal rows
+  SArray* pNormKeyCols;  // SArray<SSortNormKeyCol>
 } SMsortComparParam;
 
 typedef struct SSortHandle  SSortHandle;
@@ -215,6 +222,18 @@ void tsortSetMergeLimitReachedFp(SSortHandle* pHandle, void (*mergeLimitReached)
 
 int tsortComparBlockCell(SSDataBlock* pLeftBlock, SSDataBlock* pRightBlock,
                       int32_t leftRowIndex, int32_t rightRowIndex, void* pOrder);
+
+/**
+ * start the threads sorting the runs of the external sorts, shared by all sorts. Without them, or if they fail to
+ * start, the runs are sorted in the query thread.
+ * @param numOfThreads 0 to sort in the query thread
+ */
+int32_t tsortInitRunPool(int32_t numOfThreads);
+
+/**
+ * stop the sort threads, no sort should be running.
+ */
+void tsortCleanupRunPool();
 #ifdef __cplusplus
 }
 #endif
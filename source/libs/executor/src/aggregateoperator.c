@@ -488,7 +488,7 @@ int32_t doInitAggInfoSup(SAggSupporter* pAggSup, SqlFunctionCtx* pCtx, int32_t n
     return code;
   }
 
-  code = createDiskbasedBuf(&pAggSup->pResultBuf, defaultPgsz, defaultBufsz, pKey, tsTempDir);
+  code = createDiskbasedBuf(&pAggSup->pResultBuf, defaultPgsz, defaultBufsz, pKey, tsTempDir, DBUF_COMPRESS_NONE);
   if (code != TSDB_CODE_SUCCESS) {
     qError("Create agg result buf failed since %s, %s", tstrerror(code), pKey);
     return code;
@@ -44,6 +44,8 @@ typedef struct SDataDispatchHandle {
   SDataBlockDescNode* pSchema;
   STaosQueue*         pDataBlocks;
   SDataDispatchBuf    nextOutput;
+  char*               pCompBuf;  // to compress the block for the fetcher
+  int32_t             compBufSize;
   int32_t             status;
   bool                queryEnd;
   uint64_t            useconds;
@@ -190,6 +192,30 @@ static void getDataLength(SDataSinkHandle* pHandle, int64_t* pLen, bool* pQueryE
 }
 
 
+// compress the columns of the block into the output if it gets smaller, the output has room for the raw block
+static bool compressDataCacheEntry(SDataDispatchHandle* pDispatcher, SDataCacheEntry* pEntry, SOutputData* pOutput) {
+  int32_t size = blockCompressBufSize(pEntry->dataLen, pEntry->numOfCols);
+  if (pDispatcher->compBufSize < size) {
+    char* p = taosMemoryRealloc(pDispatcher->pCompBuf, size);
+    if (p == NULL) {
+      return false;
+    }
+    pDispatcher->pCompBuf = p;
+    pDispatcher->compBufSize = size;
+  }
+
+  int32_t len = blockCompressEncoded(pEntry->data, pDispatcher->pCompBuf, pDispatcher->compBufSize);
+  if (len < 0) {
+    return false;
+  }
+
+  memcpy(pOutput->pData, pDispatcher->pCompBuf, len);
+  pOutput->dataLen = len;
+  pOutput->compressed = 1;
+  qTrace("compress block in sink, rows:%d, len:%d, compressed len:%d", pEntry->numOfRows, pEntry->dataLen, len);
+  return true;
+}
+
 static int32_t getDataBlock(SDataSinkHandle* pHandle, SOutputData* pOutput) {
   SDataDispatchHandle* pDispatcher = (SDataDispatchHandle*)pHandle;
   if (NULL == pDispatcher->nextOutput.pData) {
@@ -201,10 +227,13 @@ static int32_t getDataBlock(SDataSinkHandle* pHandle, SOutputData* pOutput) {
     return TSDB_CODE_SUCCESS;
   }
   SDataCacheEntry* pEntry = (SDataCacheEntry*)(pDispatcher->nextOutput.pData);
-  memcpy(pOutput->pData, pEntry->data, pEntry->dataLen);
+  if (!pOutput->compressReq || !compressDataCacheEntry(pDispatcher, pEntry, pOutput)) {
+    memcpy(pOutput->pData, pEntry->data, pEntry->dataLen);
+    pOutput->dataLen = pEntry->dataLen;
+    pOutput->compressed = pEntry->compressed;
+  }
   pOutput->numOfRows = pEntry->numOfRows;
   pOutput->numOfCols = pEntry->numOfCols;
-  pOutput->compressed = pEntry->compressed;
 
   atomic_sub_fetch_64(&pDispatcher->cachedSize, pEntry->dataLen);
   atomic_sub_fetch_64(&gDataSinkStat.cachedSize, pEntry->dataLen);
@@ -224,6 +253,7 @@ static int32_t destroyDataSinker(SDataSinkHandle* pHandle) {
   SDataDispatchHandle* pDispatcher = (SDataDispatchHandle*)pHandle;
   atomic_sub_fetch_64(&gDataSinkStat.cachedSize, pDispatcher->cachedSize);
   taosMemoryFreeClear(pDispatcher->nextOutput.pData);
+  taosMemoryFreeClear(pDispatcher->pCompBuf);
   while (!taosQueueEmpty(pDispatcher->pDataBlocks)) {
     SDataDispatchBuf* pBuf = NULL;
     taosReadQitem(pDispatcher->pDataBlocks, (void**)&pBuf);
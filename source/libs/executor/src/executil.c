@@ -44,6 +44,8 @@ typedef enum {
 static FilterCondType checkTagCond(SNode* cond);
 static int32_t optimizeTbnameInCond(void* metaHandle, int64_t suid, SArray* list, SNode* pTagCond, SStorageAPI* pAPI);
 static int32_t optimizeTbnameInCondImpl(void* metaHandle, SArray* list, SNode* pTagCond, SStorageAPI* pStoreAPI);
+static SSDataBlock* createTagValBlockFromStore(SArray* pColList, SArray* pUidTagList, uint64_t suid, void* pVnode,
+                                               SStorageAPI* pStorageAPI);
 
 static int32_t getTableList(void* pVnode, SScanPhysiNode* pScanNode, SNode* pTagCond, SNode* pTagIndexCond,
                             STableListInfo* pListInfo, uint8_t* digest, const char* idstr, SStorageAPI* pStorageAPI);
@@ -560,16 +562,19 @@ int32_t getColInfoResultForGroupby(void* pVnode, SNodeList* group, STableListInf
     taosArrayPush(pUidTagList, &info);
   }
 
-  code = pAPI->metaFn.getTableTags(pVnode, pTableListInfo->idInfo.suid, pUidTagList);
-  if (code != TSDB_CODE_SUCCESS) {
-    goto end;
-  }
-
-  int32_t numOfTables = taosArrayGetSize(pUidTagList);
-  pResBlock = createTagValBlockForFilter(ctx.cInfoList, numOfTables, pUidTagList, pVnode, pAPI);
+  pResBlock = createTagValBlockFromStore(ctx.cInfoList, pUidTagList, pTableListInfo->idInfo.suid, pVnode, pAPI);
   if (pResBlock == NULL) {
-    code = terrno;
-    goto end;
+    code = pAPI->metaFn.getTableTags(pVnode, pTableListInfo->idInfo.suid, pUidTagList);
+    if (code != TSDB_CODE_SUCCESS) {
+      goto end;
+    }
+
+    int32_t numOfTables = taosArrayGetSize(pUidTagList);
+    pResBlock = createTagValBlockForFilter(ctx.cInfoList, numOfTables, pUidTagList, pVnode, pAPI);
+    if (pResBlock == NULL) {
+      code = terrno;
+      goto end;
+    }
   }
 
   //  int64_t st1 = taosGetTimestampUs();
@@ -1024,6 +1029,40 @@ static void copyExistedUids(SArray* pUidTagList, const SArray* pUidList) {
   }
 }
 
+// retrieve the tag columns from the columnar tag store of meta, NULL if the tag store is not available
+static SSDataBlock* createTagValBlockFromStore(SArray* pColList, SArray* pUidTagList, uint64_t suid, void* pVnode,
+                                               SStorageAPI* pStorageAPI) {
+  if (pStorageAPI->metaFn.getTableTagCols == NULL) {
+    return NULL;
+  }
+
+  for (int32_t i = 0; i < taosArrayGetSize(pColList); ++i) {
+    if (((SColumnInfo*)taosArrayGet(pColList, i))->colId == -1) {  // tbname is not kept in the tag store
+      return NULL;
+    }
+  }
+
+  SSDataBlock* pResBlock = createDataBlock();
+  if (pResBlock == NULL) {
+    return NULL;
+  }
+
+  for (int32_t i = 0; i < taosArrayGetSize(pColList); ++i) {
+    SColumnInfoData colInfo = {0};
+    colInfo.info = *(SColumnInfo*)taosArrayGet(pColList, i);
+    blockDataAppendColInfo(pResBlock, &colInfo);
+  }
+
+  bool    acquired = false;
+  int32_t code = pStorageAPI->metaFn.getTableTagCols(pVnode, suid, pUidTagList, pResBlock, &acquired);
+  if (code != TSDB_CODE_SUCCESS || !acquired) {
+    blockDataDestroy(pResBlock);
+    return NULL;
+  }
+
+  return pResBlock;
+}
+
 static int32_t doFilterByTagCond(STableListInfo* pListInfo, SArray* pUidList, SNode* pTagCond, void* pVnode,
                                  SIdxFltStatus status, SStorageAPI* pAPI, bool addUid, bool* listAdded) {
   *listAdded = false;
@@ -1077,7 +1116,10 @@ static int32_t doFilterByTagCond(STableListInfo* pListInfo, SArray* pUidList, SN
     if ((condType == FILTER_NO_LOGIC || condType == FILTER_AND) && status != SFLT_NOT_INDEX) {
       code = pAPI->metaFn.getTableTagsByUid(pVnode, pListInfo->idInfo.suid, pUidTagList);
     } else {
-      code = pAPI->metaFn.getTableTags(pVnode, pListInfo->idInfo.suid, pUidTagList);
+      pResBlock = createTagValBlockFromStore(ctx.cInfoList, pUidTagList, pListInfo->idInfo.suid, pVnode, pAPI);
+      if (pResBlock == NULL) {
+        code = pAPI->metaFn.getTableTags(pVnode, pListInfo->idInfo.suid, pUidTagList);
+      }
     }
     if (code != TSDB_CODE_SUCCESS) {
       qError("failed to get table tags from meta, reason:%s, suid:%" PRIu64, tstrerror(code), pListInfo->idInfo.suid);
@@ -1091,10 +1133,12 @@ static int32_t doFilterByTagCond(STableListInfo* pListInfo, SArray* pUidList, SN
     goto end;
   }
 
-  pResBlock = createTagValBlockForFilter(ctx.cInfoList, numOfTables, pUidTagList, pVnode, pAPI);
   if (pResBlock == NULL) {
-    code = terrno;
-    goto end;
+    pResBlock = createTagValBlockForFilter(ctx.cInfoList, numOfTables, pUidTagList, pVnode, pAPI);
+    if (pResBlock == NULL) {
+      code = terrno;
+      goto end;
+    }
   }
 
   //  int64_t st1 = taosGetTimestampUs();
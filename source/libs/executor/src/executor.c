@@ -21,6 +21,7 @@
 #include "planner.h"
 #include "querytask.h"
 #include "tdatablock.h"
+#include "tglobal.h"
 #include "tref.h"
 #include "tudf.h"
 
@@ -39,6 +40,37 @@ static void initRefPool() {
   atexit(cleanupRefPool);
 }
 
+// the vnodes and the qnode of a dnode share the resources, which are released with the last one of them
+static TdThreadOnce  executorLockOnce = PTHREAD_ONCE_INIT;
+static TdThreadMutex executorLock;
+static int32_t       executorRef = 0;
+
+static void initExecutorLock() { taosThreadMutexInit(&executorLock, NULL); }
+
+int32_t qExecutorInit() {
+  int32_t code = TSDB_CODE_SUCCESS;
+
+  taosThreadOnce(&executorLockOnce, initExecutorLock);
+  taosThreadMutexLock(&executorLock);
+  if (executorRef == 0) {
+    code = tsortInitRunPool(tsNumOfSortThreads);
+  }
+  if (code == TSDB_CODE_SUCCESS) {
+    executorRef++;
+  }
+  taosThreadMutexUnlock(&executorLock);
+  return code;
+}
+
+void qExecutorCleanup() {
+  taosThreadOnce(&executorLockOnce, initExecutorLock);
+  taosThreadMutexLock(&executorLock);
+  if (executorRef > 0 && --executorRef == 0) {
+    tsortCleanupRunPool();
+  }
+  taosThreadMutexUnlock(&executorLock);
+}
+
 static int32_t doSetSMABlock(SOperatorInfo* pOperator, void* input, size_t numOfBlocks, int32_t type, char* id) {
   if (pOperator->operatorType != QUERY_NODE_PHYSICAL_PLAN_STREAM_SCAN) {
     if (pOperator->numOfDownstream == 0) {
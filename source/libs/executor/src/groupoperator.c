@@ -38,8 +38,19 @@ typedef struct SGroupbyOperatorInfo {
   int32_t        groupKeyLen;    // total group by column width
   SGroupResInfo  groupResInfo;
   SExprSupp      scalarSup;
+  SSHashObj*     pBlockGroups;   // group keys of current block -> group index, used by the batch aggregation
+  int32_t*       pRowGroups;     // group index of each row of current block
+  int32_t*       pGroupStart;    // start row of each group once the rows of current block are ordered by group
+  int32_t*       pRowIndex;      // rows of current block ordered by group
+  int32_t        batchCapacity;
+  int64_t        prevRows;       // rows and runs of identical group keys of the previous block
+  int64_t        prevRuns;
 } SGroupbyOperatorInfo;
 
+// the group keys of adjacent rows are regarded as rarely repeated if the average run is shorter than this
+#define GROUPBY_BATCH_RUN_LEN  4
+#define GROUPBY_BATCH_MIN_ROWS 64
+
 // The sort in partition may be needed later.
 typedef struct SPartitionOperatorInfo {
   SOptrBasicInfo binfo;
@@ -63,7 +74,6 @@ typedef struct SPartitionOperatorInfo {
 } SPartitionOperatorInfo;
 
 static void*    getCurrentDataGroupInfo(const SPartitionOperatorInfo* pInfo, SDataGroupInfo** pGroupInfo, int32_t len);
-static int32_t* setupColumnOffset(const SSDataBlock* pBlock, int32_t rowCapacity);
 static int32_t  setGroupResultOutputBuf(SOperatorInfo* pOperator, SOptrBasicInfo* binfo, int32_t numOfCols, char* pData,
                                         int32_t bytes, uint64_t groupId, SDiskbasedBuf* pBuf, SAggSupporter* pAggSup);
 static SArray*  extractColumnInfo(SNodeList* pNodeList);
@@ -87,6 +97,8 @@ static void destroyGroupOperatorInfo(void* param) {
 
   cleanupGroupResInfo(&pInfo->groupResInfo);
   cleanupAggSup(&pInfo->aggSup);
+  tSimpleHashCleanup(pInfo->pBlockGroups);
+  taosMemoryFreeClear(pInfo->pRowGroups);
   taosMemoryFreeClear(param);
 }
 
@@ -272,10 +284,131 @@ static void doAssignGroupKeys(SqlFunctionCtx* pCtx, int32_t numOfOutput, int32_t
   }
 }
 
+static int32_t ensureGroupBatchCapacity(SGroupbyOperatorInfo* pInfo, int32_t rows) {
+  if (pInfo->pBlockGroups == NULL) {
+    pInfo->pBlockGroups = tSimpleHashInit(rows, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BINARY));
+    if (pInfo->pBlockGroups == NULL) {
+      return TSDB_CODE_OUT_OF_MEMORY;
+    }
+  }
+
+  if (pInfo->batchCapacity < rows) {
+    int32_t* p = taosMemoryRealloc(pInfo->pRowGroups, sizeof(int32_t) * rows * 3);
+    if (p == NULL) {
+      return TSDB_CODE_OUT_OF_MEMORY;
+    }
+
+    pInfo->pRowGroups = p;
+    pInfo->pGroupStart = p + rows;
+    pInfo->pRowIndex = p + rows * 2;
+    pInfo->batchCapacity = rows;
+  }
+
+  return TSDB_CODE_SUCCESS;
+}
+
+// Aggregate the block group by group instead of run by run: resolve the group of every row with one hash probe,
+// move the rows of each group together, and then feed every group to the aggregate functions with one call. The
+// rows are moved by a stable counting sort, so the rows of a group keep their original order.
+static void doHashGroupbyAggBatch(SOperatorInfo* pOperator, SSDataBlock* pBlock) {
+  SExecTaskInfo*        pTaskInfo = pOperator->pTaskInfo;
+  SGroupbyOperatorInfo* pInfo = pOperator->info;
+  SqlFunctionCtx*       pCtx = pOperator->exprSupp.pCtx;
+  int32_t               rows = pBlock->info.rows;
+
+  int32_t code = ensureGroupBatchCapacity(pInfo, rows);
+  if (code != TSDB_CODE_SUCCESS) {
+    T_LONG_JMP(pTaskInfo->env, code);
+  }
+
+  int32_t* pRowGroups = pInfo->pRowGroups;
+  int32_t* pGroupStart = pInfo->pGroupStart;
+  int32_t  numOfGroups = 0;
+  int32_t  numOfRuns = 0;
+
+  terrno = TSDB_CODE_SUCCESS;
+  tSimpleHashClear(pInfo->pBlockGroups);
+
+  for (int32_t j = 0; j < rows; ++j) {
+    recordNewGroupKeys(pInfo->pGroupCols, pInfo->pGroupColVals, pBlock, j);
+    if (terrno != TSDB_CODE_SUCCESS) {  // group by json error
+      T_LONG_JMP(pTaskInfo->env, terrno);
+    }
+
+    int32_t  len = buildGroupKeys(pInfo->keyBuf, pInfo->pGroupColVals);
+    int32_t* pGroup = tSimpleHashGet(pInfo->pBlockGroups, pInfo->keyBuf, len);
+    if (pGroup == NULL) {
+      code = tSimpleHashPut(pInfo->pBlockGroups, pInfo->keyBuf, len, &numOfGroups, sizeof(int32_t));
+      if (code != TSDB_CODE_SUCCESS) {
+        T_LONG_JMP(pTaskInfo->env, code);
+      }
+
+      pGroupStart[numOfGroups] = 0;
+      pRowGroups[j] = numOfGroups++;
+    } else {
+      pRowGroups[j] = *pGroup;
+    }
+
+    pGroupStart[pRowGroups[j]] += 1;
+    if (j == 0 || pRowGroups[j] != pRowGroups[j - 1]) {
+      numOfRuns += 1;
+    }
+  }
+
+  pInfo->isInit = true;
+  pInfo->prevRows = rows;
+  pInfo->prevRuns = numOfRuns;
+
+  // counts to start positions
+  int32_t start = 0;
+  for (int32_t g = 0; g < numOfGroups; ++g) {
+    int32_t num = pGroupStart[g];
+    pGroupStart[g] = start;
+    start += num;
+  }
+
+  for (int32_t j = 0; j < rows; ++j) {
+    pInfo->pRowIndex[pGroupStart[pRowGroups[j]]++] = j;
+  }
+
+  if (numOfGroups < numOfRuns) {
+    code = blockDataReorder(pBlock, pInfo->pRowIndex);
+    if (code != TSDB_CODE_SUCCESS) {
+      T_LONG_JMP(pTaskInfo->env, code);
+    }
+  }
+
+  // pGroupStart[g] is the end row of group g now
+  start = 0;
+  for (int32_t g = 0; g < numOfGroups; ++g) {
+    int32_t num = pGroupStart[g] - start;
+
+    recordNewGroupKeys(pInfo->pGroupCols, pInfo->pGroupColVals, pBlock, start);
+    int32_t len = buildGroupKeys(pInfo->keyBuf, pInfo->pGroupColVals);
+    int32_t ret = setGroupResultOutputBuf(pOperator, &(pInfo->binfo), pOperator->exprSupp.numOfExprs, pInfo->keyBuf,
+                                          len, pBlock->info.id.groupId, pInfo->aggSup.pResultBuf, &pInfo->aggSup);
+    if (ret != TSDB_CODE_SUCCESS) {
+      T_LONG_JMP(pTaskInfo->env, TSDB_CODE_APP_ERROR);
+    }
+
+    applyAggFunctionOnPartialTuples(pTaskInfo, pCtx, NULL, start, num, rows, pOperator->exprSupp.numOfExprs);
+    doAssignGroupKeys(pCtx, pOperator->exprSupp.numOfExprs, rows, start);
+    start += num;
+  }
+}
+
 static void doHashGroupbyAgg(SOperatorInfo* pOperator, SSDataBlock* pBlock) {
   SExecTaskInfo*        pTaskInfo = pOperator->pTaskInfo;
   SGroupbyOperatorInfo* pInfo = pOperator->info;
 
+  // the group keys of the previous block seldom repeat in adjacent rows, a run-by-run aggregation pays one hash
+  // probe and one round of function calls for almost every row
+  if (tsGroupByBatchAgg && pBlock->info.rows >= GROUPBY_BATCH_MIN_ROWS &&
+      pInfo->prevRuns * GROUPBY_BATCH_RUN_LEN > pInfo->prevRows) {
+    doHashGroupbyAggBatch(pOperator, pBlock);
+    return;
+  }
+
   SqlFunctionCtx* pCtx = pOperator->exprSupp.pCtx;
   int32_t         numOfGroupCols = taosArrayGetSize(pInfo->pGroupCols);
   //  if (type == TSDB_DATA_TYPE_FLOAT || type == TSDB_DATA_TYPE_DOUBLE) {
@@ -287,6 +420,7 @@ static void doHashGroupbyAgg(SOperatorInfo* pOperator, SSDataBlock* pBlock) {
   terrno = TSDB_CODE_SUCCESS;
 
   int32_t num = 0;
+  int32_t numOfRuns = 0;
   for (int32_t j = 0; j < pBlock->info.rows; ++j) {
     // Compare with the previous row of this column, and do not set the output buffer again if they are identical.
     if (!pInfo->isInit) {
@@ -322,6 +456,7 @@ static void doHashGroupbyAgg(SOperatorInfo* pOperator, SSDataBlock* pBlock) {
       T_LONG_JMP(pTaskInfo->env, TSDB_CODE_APP_ERROR);
     }
 
+    numOfRuns += 1;
     int32_t rowIndex = j - num;
     applyAggFunctionOnPartialTuples(pTaskInfo, pCtx, NULL, rowIndex, num, pBlock->info.rows,
                                     pOperator->exprSupp.numOfExprs);
@@ -340,11 +475,15 @@ static void doHashGroupbyAgg(SOperatorInfo* pOperator, SSDataBlock* pBlock) {
       T_LONG_JMP(pTaskInfo->env, TSDB_CODE_APP_ERROR);
     }
 
+    numOfRuns += 1;
     int32_t rowIndex = pBlock->info.rows - num;
     applyAggFunctionOnPartialTuples(pTaskInfo, pCtx, NULL, rowIndex, num, pBlock->info.rows,
                                     pOperator->exprSupp.numOfExprs);
     doAssignGroupKeys(pCtx, pOperator->exprSupp.numOfExprs, pBlock->info.rows, rowIndex);
   }
+
+  pInfo->prevRows = pBlock->info.rows;
+  pInfo->prevRuns = numOfRuns;
 }
 
 static SSDataBlock* buildGroupResultDataBlock(SOperatorInfo* pOperator) {
@@ -958,7 +1097,7 @@ SOperatorInfo* createPartitionOperatorInfo(SOperatorInfo* downstream, SPartition
     goto _error;
   }
 
-  code = createDiskbasedBuf(&pInfo->pBuf, defaultPgsz, defaultBufsz, pTaskInfo->id.str, tsTempDir);
+  code = createDiskbasedBuf(&pInfo->pBuf, defaultPgsz, defaultBufsz, pTaskInfo->id.str, tsTempDir, DBUF_COMPRESS_LZ4);
   if (code != TSDB_CODE_SUCCESS) {
     terrno = code;
     pTaskInfo->code = code;
@@ -435,6 +435,8 @@ static void hJoinFreeTableInfo(SHJoinTableCtx* pTable) {
   taosMemoryFreeClear(pTable->valCols);
   taosArrayDestroy(pTable->valVarCols);
   taosMemoryFree(pTable->primCol);
+  pTable->spillBlk = blockDataDestroy(pTable->spillBlk);
+  taosMemoryFreeClear(pTable->spillColOffset);
 }
 
 static void hJoinFreeBufPage(void* param) {
@@ -790,6 +792,8 @@ static int32_t hJoinAddRowToHashImpl(SHJoinOperatorInfo* pJoin, SGroupData* pGro
     pGroup->rows = pRow;
   }
 
+  pJoin->grace.hashRows++;
+
   return TSDB_CODE_SUCCESS;
 }
 
@@ -856,11 +860,14 @@ static bool hJoinFilterTimeRange(SSDataBlock* pBlock, STimeWindow* pRange, int32
 static int32_t hJoinAddBlockRowsToHash(SSDataBlock* pBlock, SHJoinOperatorInfo* pJoin) {
   SHJoinTableCtx* pBuild = pJoin->pBuild;
   int32_t startIdx = 0, endIdx = pBlock->info.rows - 1;
-  if (pBuild->hasTimeRange && !hJoinFilterTimeRange(pBlock, &pJoin->tblTimeRange, pBuild->primCol->srcSlot, &startIdx, &endIdx)) {
-    return TSDB_CODE_SUCCESS;
-  }
+  // rows replayed from partitions were filtered and truncated before being spilled
+  if (!pJoin->grace.spilled) {
+    if (pBuild->hasTimeRange && !hJoinFilterTimeRange(pBlock, &pJoin->tblTimeRange, pBuild->primCol->srcSlot, &startIdx, &endIdx)) {
+      return TSDB_CODE_SUCCESS;
+    }
 
-  HJ_ERR_RET(hJoinLaunchPrimExpr(pBlock, pBuild, startIdx, endIdx));
+    HJ_ERR_RET(hJoinLaunchPrimExpr(pBlock, pBuild, startIdx, endIdx));
+  }
 
   int32_t code = hJoinSetKeyColsData(pBlock, pBuild);
   if (code) {
@@ -881,6 +888,455 @@ static int32_t hJoinAddBlockRowsToHash(SSDataBlock* pBlock, SHJoinOperatorInfo*
   return code;
 }
 
+static FORCE_INLINE int32_t hJoinGetPartIdx(const char* pKey, size_t keyLen, int32_t level) {
+  // use the high bits, the low bits are used by the key hash buckets
+  uint32_t hashVal = MurmurHash3_32(pKey, keyLen);
+  return (hashVal >> (32 - HJOIN_PART_BITS * (level + 1))) & (HJOIN_PART_NUM - 1);
+}
+
+static bool hJoinHashExceedBudget(SHJoinOperatorInfo* pJoin) {
+  if (pJoin->grace.memBudget <= 0) {
+    return false;
+  }
+
+  int64_t memSize = (int64_t)taosArrayGetSize(pJoin->pRowBufs) * HASH_JOIN_DEFAULT_PAGE_SIZE +
+                    pJoin->grace.hashRows * sizeof(SBufRowInfo) + tSimpleHashGetMemSize(pJoin->pKeyHash);
+  return memSize > pJoin->grace.memBudget;
+}
+
+static int32_t hJoinResetKeyHash(SHJoinOperatorInfo* pJoin, int64_t rows) {
+  hJoinDestroyKeyHash(&pJoin->pKeyHash);
+  pJoin->grace.hashRows = 0;
+
+  size_t hashCap = rows > 0 ? (rows * 1.5) : 1024;
+  pJoin->pKeyHash = tSimpleHashInit(hashCap, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BINARY));
+  if (NULL == pJoin->pKeyHash) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  int32_t pageNum = taosArrayGetSize(pJoin->pRowBufs);
+  for (int32_t i = 1; i < pageNum; ++i) {
+    hJoinFreeBufPage(taosArrayGet(pJoin->pRowBufs, i));
+  }
+  taosArrayPopTailBatch(pJoin->pRowBufs, pageNum - 1);
+  ((SBufPageInfo*)taosArrayGet(pJoin->pRowBufs, 0))->offset = 0;
+
+  return TSDB_CODE_SUCCESS;
+}
+
+static void hJoinFreePartition(void* param) {
+  SHJoinPartition* pPart = (SHJoinPartition*)param;
+  taosArrayDestroy(pPart->buildPages);
+  taosArrayDestroy(pPart->probePages);
+  pPart->buildPages = NULL;
+  pPart->probePages = NULL;
+}
+
+static int32_t hJoinAddPartitions(SHJoinGraceCtx* pGrace, int32_t level) {
+  for (int32_t i = 0; i < HJOIN_PART_NUM; ++i) {
+    SHJoinPartition part = {.level = level};
+    part.buildPages = taosArrayInit(4, sizeof(int32_t));
+    part.probePages = taosArrayInit(4, sizeof(int32_t));
+    if (NULL == part.buildPages || NULL == part.probePages || NULL == taosArrayPush(pGrace->pParts, &part)) {
+      hJoinFreePartition(&part);
+      return TSDB_CODE_OUT_OF_MEMORY;
+    }
+  }
+
+  return TSDB_CODE_SUCCESS;
+}
+
+static int32_t hJoinInitSpillTable(SHJoinTableCtx* pTable, int32_t pageSize) {
+  SSDataBlock* pBlock = pTable->spillBlk;
+  pTable->spillRowCap = blockDataGetCapacityInRow(pBlock, pageSize, blockDataGetSerialMetaSize(taosArrayGetSize(pBlock->pDataBlock)));
+  pTable->spillColOffset = setupColumnOffset(pBlock, pTable->spillRowCap);
+  if (NULL == pTable->spillColOffset) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  return blockDataEnsureCapacity(pBlock, pTable->spillRowCap);
+}
+
+// same page layout as the partition operator, so that a page can be loaded by blockDataFromBuf1
+static int32_t hJoinAppendRowToPart(SHJoinGraceCtx* pGrace, SHJoinTableCtx* pTable, SArray* pPageList, SSDataBlock* pBlock, int32_t rowIdx) {
+  void*    pPage = NULL;
+  int32_t* pCurId = taosArrayGetLast(pPageList);
+  if (pCurId) {
+    pPage = getBufPage(pGrace->pBuf, *pCurId);
+    if (NULL == pPage) {
+      qError("hash join failed to get spill page:%d, code:%s", *pCurId, tstrerror(terrno));
+      return terrno;
+    }
+    if (*(int32_t*)pPage >= pTable->spillRowCap) {
+      releaseBufPage(pGrace->pBuf, pPage);
+      pPage = NULL;
+    }
+  }
+
+  if (NULL == pPage) {
+    int32_t pageId = 0;
+    pPage = getNewBufPage(pGrace->pBuf, &pageId);
+    if (NULL == pPage) {
+      qError("hash join failed to get new spill page, code:%s", tstrerror(terrno));
+      return terrno;
+    }
+    memset(pPage, 0, getBufPageSize(pGrace->pBuf));
+    taosArrayPush(pPageList, &pageId);
+  }
+
+  int32_t* rows = (int32_t*)pPage;
+  int32_t  numOfCols = taosArrayGetSize(pTable->spillBlk->pDataBlock);
+  for (int32_t i = 0; i < numOfCols; ++i) {
+    SColumnInfoData* pCol = taosArrayGet(pBlock->pDataBlock, i);
+    char*            pStart = (char*)pPage + pTable->spillColOffset[i];
+    int32_t*         columnLen = NULL;
+
+    if (IS_VAR_DATA_TYPE(pCol->info.type)) {
+      int32_t* offset = (int32_t*)pStart;
+      columnLen = (int32_t*)(pStart + sizeof(int32_t) * pTable->spillRowCap);
+      char* data = (char*)columnLen + sizeof(int32_t);
+
+      if (colDataIsNull_s(pCol, rowIdx)) {
+        offset[*rows] = -1;
+      } else {
+        char*   src = colDataGetData(pCol, rowIdx);
+        int32_t dataLen = (TSDB_DATA_TYPE_JSON == pCol->info.type) ? getJsonValueLen(src) : varDataTLen(src);
+        offset[*rows] = (*columnLen);
+        memcpy(data + (*columnLen), src, dataLen);
+        (*columnLen) += dataLen;
+      }
+    } else {
+      char* bitmap = pStart;
+      columnLen = (int32_t*)(pStart + BitmapLen(pTable->spillRowCap));
+      char* data = (char*)columnLen + sizeof(int32_t);
+
+      if (colDataIsNull_s(pCol, rowIdx)) {
+        colDataSetNull_f(bitmap, (*rows));
+      } else {
+        memcpy(data + (*columnLen), colDataGetData(pCol, rowIdx), pCol->info.bytes);
+      }
+      (*columnLen) += pCol->info.bytes;
+    }
+  }
+
+  (*rows) += 1;
+  pGrace->execInfo.spillRows++;
+
+  setBufPageDirty(pPage, true);
+  releaseBufPage(pGrace->pBuf, pPage);
+
+  return TSDB_CODE_SUCCESS;
+}
+
+// every spilled page is read exactly once, so it is recycled right after being loaded
+static int32_t hJoinLoadPartPage(SDiskbasedBuf* pBuf, SHJoinTableCtx* pTable, int32_t pageId) {
+  void* pPage = getBufPage(pBuf, pageId);
+  if (NULL == pPage) {
+    qError("hash join failed to get spill page:%d, code:%s", pageId, tstrerror(terrno));
+    return terrno;
+  }
+
+  int32_t code = blockDataFromBuf1(pTable->spillBlk, pPage, pTable->spillRowCap);
+  dBufSetBufPageRecycled(pBuf, pPage);
+
+  return code;
+}
+
+static FORCE_INLINE int32_t hJoinSetSpillColVal(SColumnInfoData* pCol, const char* pData) {
+  if (!IS_VAR_DATA_TYPE(pCol->info.type)) {
+    colDataClearNull_f(pCol->nullbitmap, 0);
+  }
+
+  return colDataSetVal(pCol, 0, pData, false);
+}
+
+// restore one build row of the key hash to the first row of the build spill block
+static int32_t hJoinRestoreHashRow(SHJoinOperatorInfo* pJoin, const char* pKey, SBufRowInfo* pRow) {
+  SHJoinTableCtx* pBuild = pJoin->pBuild;
+  SSDataBlock*    pBlock = pBuild->spillBlk;
+  int32_t         numOfCols = taosArrayGetSize(pBlock->pDataBlock);
+
+  blockDataCleanup(pBlock);
+  for (int32_t i = 0; i < numOfCols; ++i) {
+    colDataSetNULL(taosArrayGet(pBlock->pDataBlock, i), 0);
+  }
+
+  for (int32_t i = 0; i < pBuild->keyNum; ++i) {
+    HJ_ERR_RET(hJoinSetSpillColVal(taosArrayGet(pBlock->pDataBlock, pBuild->keyCols[i].srcSlot), pKey));
+    pKey += pBuild->keyCols[i].vardata ? varDataTLen(pKey) : pBuild->keyCols[i].bytes;
+  }
+
+  char* pData = hJoinRetrieveColDataFromRowBufs(pJoin->pRowBufs, pRow);
+  if (pData) {
+    char* pValData = pData + pBuild->valBitMapSize;
+    for (int32_t i = 0, m = 0; i < pBuild->valNum; ++i) {
+      if (pBuild->valCols[i].keyCol) {
+        continue;
+      }
+      if (!colDataIsNull_f(pData, m)) {
+        HJ_ERR_RET(hJoinSetSpillColVal(taosArrayGet(pBlock->pDataBlock, pBuild->valCols[i].srcSlot), pValData));
+        pValData += pBuild->valCols[i].vardata ? varDataTLen(pValData) : pBuild->valCols[i].bytes;
+      }
+      m++;
+    }
+  }
+
+  pBlock->info.rows = 1;
+
+  return TSDB_CODE_SUCCESS;
+}
+
+static int32_t hJoinGraceStart(struct SOperatorInfo* pOperator) {
+  SHJoinOperatorInfo* pJoin = pOperator->info;
+  SHJoinGraceCtx*     pGrace = &pJoin->grace;
+
+  if (!osTempSpaceAvailable()) {
+    terrno = TSDB_CODE_NO_DISKSPACE;
+    qError("hash join spill failed since %s, tempDir:%s", terrstr(), tsTempDir);
+    return terrno;
+  }
+
+  uint32_t pageSize = 0, bufSize = 0;
+  HJ_ERR_RET(getBufferPgSize(TMAX(pJoin->pBuild->spillBlk->info.rowSize, pJoin->pProbe->spillBlk->info.rowSize), &pageSize, &bufSize));
+  pageSize = TMAX(pageSize, HJOIN_SPILL_PAGE_SIZE);
+  int64_t inMemSize = TMIN(TMAX(pGrace->memBudget, (int64_t)pageSize * 4), INT32_MAX);
+
+  HJ_ERR_RET(createDiskbasedBuf(&pGrace->pBuf, pageSize, inMemSize, GET_TASKID(pOperator->pTaskInfo), tsTempDir,
+                                DBUF_COMPRESS_LZ4));
+  HJ_ERR_RET(hJoinInitSpillTable(pJoin->pBuild, pageSize));
+  HJ_ERR_RET(hJoinInitSpillTable(pJoin->pProbe, pageSize));
+
+  pGrace->pParts = taosArrayInit(HJOIN_PART_NUM * 2, sizeof(SHJoinPartition));
+  pGrace->pNMatchPages = taosArrayInit(4, sizeof(int32_t));
+  if (NULL == pGrace->pParts || NULL == pGrace->pNMatchPages) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+  HJ_ERR_RET(hJoinAddPartitions(pGrace, 0));
+
+  SGroupData* pGroup = NULL;
+  int32_t     iter = 0;
+  while (NULL != (pGroup = tSimpleHashIterate(pJoin->pKeyHash, pGroup, &iter))) {
+    size_t           keyLen = 0;
+    char*            pKey = tSimpleHashGetKey(pGroup, &keyLen);
+    SHJoinPartition* pPart = taosArrayGet(pGrace->pParts, hJoinGetPartIdx(pKey, keyLen, 0));
+    for (SBufRowInfo* pRow = pGroup->rows; pRow; pRow = pRow->next) {
+      HJ_ERR_RET(hJoinRestoreHashRow(pJoin, pKey, pRow));
+      HJ_ERR_RET(hJoinAppendRowToPart(pGrace, pJoin->pBuild, pPart->buildPages, pJoin->pBuild->spillBlk, 0));
+      pPart->buildRows++;
+    }
+  }
+
+  HJ_ERR_RET(hJoinResetKeyHash(pJoin, 0));
+
+  pGrace->spilled = true;
+  pGrace->execInfo.spilled = 1;
+
+  qDebug("hash join build side exceeds %" PRId64 " bytes, switch to grace hash join, %s", pGrace->memBudget,
+         GET_TASKID(pOperator->pTaskInfo));
+
+  return TSDB_CODE_SUCCESS;
+}
+
+static int32_t hJoinPartitionBuildBlock(SHJoinOperatorInfo* pJoin, SSDataBlock* pBlock) {
+  SHJoinTableCtx* pBuild = pJoin->pBuild;
+  SHJoinGraceCtx* pGrace = &pJoin->grace;
+  int32_t startIdx = 0, endIdx = pBlock->info.rows - 1;
+  if (pBuild->hasTimeRange && !hJoinFilterTimeRange(pBlock, &pJoin->tblTimeRange, pBuild->primCol->srcSlot, &startIdx, &endIdx)) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  HJ_ERR_RET(hJoinLaunchPrimExpr(pBlock, pBuild, startIdx, endIdx));
+  HJ_ERR_RET(hJoinSetKeyColsData(pBlock, pBuild));
+
+  size_t bufLen = 0;
+  for (int32_t i = startIdx; i <= endIdx; ++i) {
+    if (hJoinCopyKeyColsDataToBuf(pBuild, i, &bufLen)) {
+      continue;
+    }
+    SHJoinPartition* pPart = taosArrayGet(pGrace->pParts, hJoinGetPartIdx(pBuild->keyData, bufLen, 0));
+    HJ_ERR_RET(hJoinAppendRowToPart(pGrace, pBuild, pPart->buildPages, pBlock, i));
+    pPart->buildRows++;
+  }
+
+  return TSDB_CODE_SUCCESS;
+}
+
+static int32_t hJoinPartitionProbeBlock(SHJoinOperatorInfo* pJoin, SSDataBlock* pBlock) {
+  SHJoinTableCtx* pProbe = pJoin->pProbe;
+  SHJoinGraceCtx* pGrace = &pJoin->grace;
+  int32_t startIdx = 0, endIdx = pBlock->info.rows - 1;
+  if (pProbe->hasTimeRange && !hJoinFilterTimeRange(pBlock, &pJoin->tblTimeRange, pProbe->primCol->srcSlot, &startIdx, &endIdx)) {
+    startIdx = pBlock->info.rows;
+    endIdx = pBlock->info.rows - 1;
+  }
+
+  // rows out of the time range never match, they are output directly by outer join
+  if (!IS_INNER_NONE_JOIN(pJoin->joinType, pJoin->subType)) {
+    for (int32_t i = 0; i < startIdx; ++i) {
+      HJ_ERR_RET(hJoinAppendRowToPart(pGrace, pProbe, pGrace->pNMatchPages, pBlock, i));
+    }
+    for (int32_t i = endIdx + 1; i < pBlock->info.rows; ++i) {
+      HJ_ERR_RET(hJoinAppendRowToPart(pGrace, pProbe, pGrace->pNMatchPages, pBlock, i));
+    }
+  }
+
+  if (startIdx > endIdx) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  HJ_ERR_RET(hJoinLaunchPrimExpr(pBlock, pProbe, startIdx, endIdx));
+  HJ_ERR_RET(hJoinSetKeyColsData(pBlock, pProbe));
+
+  size_t bufLen = 0;
+  for (int32_t i = startIdx; i <= endIdx; ++i) {
+    if (hJoinCopyKeyColsDataToBuf(pProbe, i, &bufLen)) {
+      continue;
+    }
+    SHJoinPartition* pPart = taosArrayGet(pGrace->pParts, hJoinGetPartIdx(pProbe->keyData, bufLen, 0));
+    HJ_ERR_RET(hJoinAppendRowToPart(pGrace, pProbe, pPart->probePages, pBlock, i));
+    pPart->probeRows++;
+  }
+
+  return TSDB_CODE_SUCCESS;
+}
+
+static int32_t hJoinPartitionProbe(struct SOperatorInfo* pOperator) {
+  SHJoinOperatorInfo* pJoin = pOperator->info;
+
+  while (true) {
+    SSDataBlock* pBlock = getNextBlockFromDownstream(pOperator, pJoin->pProbe->downStreamIdx);
+    if (NULL == pBlock) {
+      break;
+    }
+
+    pJoin->execInfo.probeBlkNum++;
+    pJoin->execInfo.probeBlkRows += pBlock->info.rows;
+
+    HJ_ERR_RET(hJoinPartitionProbeBlock(pJoin, pBlock));
+  }
+
+  pJoin->grace.partIdx = -1;
+  pJoin->grace.pageIdx = 0;
+
+  return TSDB_CODE_SUCCESS;
+}
+
+static int32_t hJoinRepartitionPages(SHJoinOperatorInfo* pJoin, SHJoinTableCtx* pTable, SArray* pPages, int32_t level, int32_t firstPart) {
+  SHJoinGraceCtx* pGrace = &pJoin->grace;
+  SSDataBlock*    pBlock = pTable->spillBlk;
+  size_t          bufLen = 0;
+  int32_t         pageNum = taosArrayGetSize(pPages);
+
+  for (int32_t p = 0; p < pageNum; ++p) {
+    HJ_ERR_RET(hJoinLoadPartPage(pGrace->pBuf, pTable, *(int32_t*)taosArrayGet(pPages, p)));
+    HJ_ERR_RET(hJoinSetKeyColsData(pBlock, pTable));
+
+    for (int32_t i = 0; i < pBlock->info.rows; ++i) {
+      hJoinCopyKeyColsDataToBuf(pTable, i, &bufLen);
+      SHJoinPartition* pPart = taosArrayGet(pGrace->pParts, firstPart + hJoinGetPartIdx(pTable->keyData, bufLen, level));
+      if (pTable == pJoin->pBuild) {
+        HJ_ERR_RET(hJoinAppendRowToPart(pGrace, pTable, pPart->buildPages, pBlock, i));
+        pPart->buildRows++;
+      } else {
+        HJ_ERR_RET(hJoinAppendRowToPart(pGrace, pTable, pPart->probePages, pBlock, i));
+        pPart->probeRows++;
+      }
+    }
+  }
+
+  return TSDB_CODE_SUCCESS;
+}
+
+// split a partition whose build side is still too large by the next bits of the key hash
+static int32_t hJoinRepartition(SHJoinOperatorInfo* pJoin, int32_t partIdx) {
+  SHJoinGraceCtx* pGrace = &pJoin->grace;
+  SHJoinPartition part = *(SHJoinPartition*)taosArrayGet(pGrace->pParts, partIdx);
+  int32_t         firstPart = taosArrayGetSize(pGrace->pParts);
+
+  HJ_ERR_RET(hJoinAddPartitions(pGrace, part.level + 1));
+  HJ_ERR_RET(hJoinRepartitionPages(pJoin, pJoin->pBuild, part.buildPages, part.level + 1, firstPart));
+  HJ_ERR_RET(hJoinRepartitionPages(pJoin, pJoin->pProbe, part.probePages, part.level + 1, firstPart));
+
+  hJoinFreePartition(taosArrayGet(pGrace->pParts, partIdx));
+  pGrace->execInfo.levels = TMAX(pGrace->execInfo.levels, part.level + 1);
+
+  qDebug("hash join partition %d repartitioned to level %d, buildRows:%" PRId64 ", probeRows:%" PRId64, partIdx,
+         part.level + 1, part.buildRows, part.probeRows);
+
+  return TSDB_CODE_SUCCESS;
+}
+
+static int32_t hJoinLoadPartition(SHJoinOperatorInfo* pJoin, bool* skipped) {
+  SHJoinGraceCtx*  pGrace = &pJoin->grace;
+  SHJoinPartition* pPart = taosArrayGet(pGrace->pParts, pGrace->partIdx);
+
+  *skipped = true;
+  if (0 == pPart->probeRows || (0 == pPart->buildRows && IS_INNER_NONE_JOIN(pJoin->joinType, pJoin->subType))) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  if (pPart->level < HJOIN_PART_MAX_LEVEL &&
+      (int64_t)taosArrayGetSize(pPart->buildPages) * getBufPageSize(pGrace->pBuf) > pGrace->memBudget) {
+    return hJoinRepartition(pJoin, pGrace->partIdx);
+  }
+
+  HJ_ERR_RET(hJoinResetKeyHash(pJoin, pPart->buildRows));
+
+  int32_t pageNum = taosArrayGetSize(pPart->buildPages);
+  for (int32_t i = 0; i < pageNum; ++i) {
+    HJ_ERR_RET(hJoinLoadPartPage(pGrace->pBuf, pJoin->pBuild, *(int32_t*)taosArrayGet(pPart->buildPages, i)));
+    HJ_ERR_RET(hJoinAddBlockRowsToHash(pJoin->pBuild->spillBlk, pJoin));
+  }
+
+  pGrace->execInfo.partitions++;
+  *skipped = false;
+
+  return TSDB_CODE_SUCCESS;
+}
+
+// the non-matched rows are replayed first, then partition pairs are joined one by one
+static int32_t hJoinGetNextPartProbeBlock(SHJoinOperatorInfo* pJoin, SSDataBlock** ppBlock) {
+  SHJoinGraceCtx* pGrace = &pJoin->grace;
+  *ppBlock = NULL;
+
+  while (true) {
+    SArray* pPages = NULL;
+    if (pGrace->partIdx < 0) {
+      pPages = pGrace->pNMatchPages;
+    } else if (pGrace->partIdx < taosArrayGetSize(pGrace->pParts)) {
+      if (!pGrace->partLoaded) {
+        bool skipped = false;
+        HJ_ERR_RET(hJoinLoadPartition(pJoin, &skipped));
+        if (skipped) {
+          hJoinFreePartition(taosArrayGet(pGrace->pParts, pGrace->partIdx));
+          pGrace->partIdx++;
+          continue;
+        }
+        pGrace->partLoaded = true;
+        pGrace->pageIdx = 0;
+      }
+      pPages = ((SHJoinPartition*)taosArrayGet(pGrace->pParts, pGrace->partIdx))->probePages;
+    } else {
+      return TSDB_CODE_SUCCESS;
+    }
+
+    if (pGrace->pageIdx < taosArrayGetSize(pPages)) {
+      HJ_ERR_RET(hJoinLoadPartPage(pGrace->pBuf, pJoin->pProbe, *(int32_t*)taosArrayGet(pPages, pGrace->pageIdx)));
+      pGrace->pageIdx++;
+      pGrace->nmatch = (pGrace->partIdx < 0);
+      *ppBlock = pJoin->pProbe->spillBlk;
+      return TSDB_CODE_SUCCESS;
+    }
+
+    if (pGrace->partIdx >= 0) {
+      hJoinFreePartition(taosArrayGet(pGrace->pParts, pGrace->partIdx));
+    }
+    pGrace->partIdx++;
+    pGrace->pageIdx = 0;
+    pGrace->partLoaded = false;
+  }
+}
+
 static int32_t hJoinBuildHash(struct SOperatorInfo* pOperator, bool* queryDone) {
   SHJoinOperatorInfo* pJoin = pOperator->info;
   SSDataBlock* pBlock = NULL;
@@ -895,12 +1351,23 @@ static int32_t hJoinBuildHash(struct SOperatorInfo* pOperator, bool* queryDone)
     pJoin->execInfo.buildBlkNum++;
     pJoin->execInfo.buildBlkRows += pBlock->info.rows;
 
-    code = hJoinAddBlockRowsToHash(pBlock, pJoin);
+    if (pJoin->grace.spilled) {
+      code = hJoinPartitionBuildBlock(pJoin, pBlock);
+    } else {
+      code = hJoinAddBlockRowsToHash(pBlock, pJoin);
+      if (TSDB_CODE_SUCCESS == code && hJoinHashExceedBudget(pJoin)) {
+        code = hJoinGraceStart(pOperator);
+      }
+    }
     if (code) {
       return code;
     }
   }
 
+  if (pJoin->grace.spilled) {
+    return hJoinPartitionProbe(pOperator);
+  }
+
   if (IS_INNER_NONE_JOIN(pJoin->joinType, pJoin->subType) && tSimpleHashGetSize(pJoin->pKeyHash) <= 0) {
     hJoinSetDone(pOperator);
     *queryDone = true;
@@ -915,7 +1382,8 @@ static int32_t hJoinPrepareStart(struct SOperatorInfo* pOperator, SSDataBlock* p
   SHJoinOperatorInfo* pJoin = pOperator->info;
   SHJoinTableCtx* pProbe = pJoin->pProbe;
   int32_t startIdx = 0, endIdx = pBlock->info.rows - 1;
-  if (pProbe->hasTimeRange && !hJoinFilterTimeRange(pBlock, &pJoin->tblTimeRange, pProbe->primCol->srcSlot, &startIdx, &endIdx)) {
+  if (pJoin->grace.nmatch ||
+      (!pJoin->grace.spilled && pProbe->hasTimeRange && !hJoinFilterTimeRange(pBlock, &pJoin->tblTimeRange, pProbe->primCol->srcSlot, &startIdx, &endIdx))) {
     if (!IS_INNER_NONE_JOIN(pJoin->joinType, pJoin->subType)) {
       pJoin->ctx.probeEndIdx = -1;
       pJoin->ctx.probePostIdx = 0;
@@ -929,7 +1397,9 @@ static int32_t hJoinPrepareStart(struct SOperatorInfo* pOperator, SSDataBlock* p
     return TSDB_CODE_SUCCESS;
   }
 
-  HJ_ERR_RET(hJoinLaunchPrimExpr(pBlock, pProbe, startIdx, endIdx));
+  if (!pJoin->grace.spilled) {
+    HJ_ERR_RET(hJoinLaunchPrimExpr(pBlock, pProbe, startIdx, endIdx));
+  }
 
   int32_t code = hJoinSetKeyColsData(pBlock, pProbe);
   if (code) {
@@ -1017,15 +1487,25 @@ static SSDataBlock* hJoinMainProcess(struct SOperatorInfo* pOperator) {
   }
 
   while (true) {
-    SSDataBlock* pBlock = getNextBlockFromDownstream(pOperator, pJoin->pProbe->downStreamIdx);
+    SSDataBlock* pBlock = NULL;
+    if (pJoin->grace.spilled) {
+      code = hJoinGetNextPartProbeBlock(pJoin, &pBlock);
+      if (code) {
+        pTaskInfo->code = code;
+        T_LONG_JMP(pTaskInfo->env, code);
+      }
+    } else {
+      pBlock = getNextBlockFromDownstream(pOperator, pJoin->pProbe->downStreamIdx);
+      if (pBlock) {
+        pJoin->execInfo.probeBlkNum++;
+        pJoin->execInfo.probeBlkRows += pBlock->info.rows;
+      }
+    }
     if (NULL == pBlock) {
       hJoinSetDone(pOperator);
       break;
     }
 
-    pJoin->execInfo.probeBlkNum++;
-    pJoin->execInfo.probeBlkRows += pBlock->info.rows;
-    
     code = hJoinPrepareStart(pOperator, pBlock);
     if (code) {
       pTaskInfo->code = code;
@@ -1060,6 +1540,10 @@ static void destroyHashJoinOperator(void* param) {
   qDebug("hashJoin exec info, buildBlk:%" PRId64 ", buildRows:%" PRId64 ", probeBlk:%" PRId64 ", probeRows:%" PRId64 ", resRows:%" PRId64, 
          pJoinOperator->execInfo.buildBlkNum, pJoinOperator->execInfo.buildBlkRows, pJoinOperator->execInfo.probeBlkNum, 
          pJoinOperator->execInfo.probeBlkRows, pJoinOperator->execInfo.resRows);
+  if (pJoinOperator->grace.spilled) {
+    qDebug("hashJoin spill info, partitions:%d, levels:%d, spillRows:%" PRId64, pJoinOperator->grace.execInfo.partitions,
+           pJoinOperator->grace.execInfo.levels, pJoinOperator->grace.execInfo.spillRows);
+  }
 
   hJoinDestroyKeyHash(&pJoinOperator->pKeyHash);
 
@@ -1068,10 +1552,56 @@ static void destroyHashJoinOperator(void* param) {
   pJoinOperator->finBlk = blockDataDestroy(pJoinOperator->finBlk);
   taosMemoryFreeClear(pJoinOperator->pResColMap);
   taosArrayDestroyEx(pJoinOperator->pRowBufs, hJoinFreeBufPage);
+  taosArrayDestroyEx(pJoinOperator->grace.pParts, hJoinFreePartition);
+  taosArrayDestroy(pJoinOperator->grace.pNMatchPages);
+  destroyDiskbasedBuf(pJoinOperator->grace.pBuf);
 
   taosMemoryFreeClear(param);
 }
 
+static int32_t hJoinGetExplainExecInfo(SOperatorInfo* pOptr, void** pOptrExplain, uint32_t* len) {
+  SHJoinOperatorInfo* pJoin = (SHJoinOperatorInfo*)pOptr->info;
+  SHashJoinExecInfo*  pInfo = taosMemoryCalloc(1, sizeof(SHashJoinExecInfo));
+  if (NULL == pInfo) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  *pInfo = pJoin->grace.execInfo;
+  if (pJoin->grace.pBuf) {
+    SDiskbasedBufStatis stat = getDBufStatis(pJoin->grace.pBuf);
+    pInfo->writeBytes = stat.flushBytes;
+    pInfo->readBytes = stat.loadBytes;
+    pInfo->rawBytes = stat.rawFlushBytes;
+    pInfo->cmprTime = stat.compressTime + stat.decompressTime;
+  }
+
+  *pOptrExplain = pInfo;
+  *len = sizeof(SHashJoinExecInfo);
+
+  return TSDB_CODE_SUCCESS;
+}
+
+static int32_t hJoinInitGraceCtx(SHJoinOperatorInfo* pJoin, SHashJoinPhysiNode* pJoinNode) {
+  SHJoinGraceCtx* pGrace = &pJoin->grace;
+  pGrace->memBudget = (tsHashJoinBufSize > 0) ? (int64_t)tsHashJoinBufSize * 1048576 : tsQueryBufferSizeBytes;
+  if (pGrace->memBudget <= 0) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  for (int32_t i = 0; i < 2; ++i) {
+    SPhysiNode* pChild = (SPhysiNode*)nodesListGetNode(pJoinNode->node.pChildren, i);
+    if (NULL == pChild) {
+      return TSDB_CODE_QRY_EXECUTOR_INTERNAL_ERROR;
+    }
+    pJoin->tbs[i].spillBlk = createDataBlockFromDescNode(pChild->pOutputDataBlockDesc);
+    if (NULL == pJoin->tbs[i].spillBlk) {
+      return TSDB_CODE_OUT_OF_MEMORY;
+    }
+  }
+
+  return TSDB_CODE_SUCCESS;
+}
+
 int32_t hJoinHandleConds(SHJoinOperatorInfo* pJoin, SHashJoinPhysiNode* pJoinNode) {
   switch (pJoin->joinType) {
     case JOIN_TYPE_INNER: {
@@ -1169,13 +1699,15 @@ SOperatorInfo* createHashJoinOperatorInfo(SOperatorInfo** pDownstream, int32_t n
 
   HJ_ERR_JRET(hJoinHandleConds(pInfo, pJoinNode));
 
+  HJ_ERR_JRET(hJoinInitGraceCtx(pInfo, pJoinNode));
+
   HJ_ERR_JRET(hJoinInitResBlocks(pInfo, pJoinNode));
 
   HJ_ERR_JRET(hJoinSetImplFp(pInfo));
 
   HJ_ERR_JRET(appendDownstream(pOperator, pDownstream, numOfDownstream));
 
-  pOperator->fpSet = createOperatorFpSet(optrDummyOpenFn, hJoinMainProcess, NULL, destroyHashJoinOperator, optrDefaultBufFn, NULL, optrDefaultGetNextExtFn, NULL);
+  pOperator->fpSet = createOperatorFpSet(optrDummyOpenFn, hJoinMainProcess, NULL, destroyHashJoinOperator, optrDefaultBufFn, hJoinGetExplainExecInfo, optrDefaultGetNextExtFn, NULL);
 
   qDebug("create hash Join operator done");
 
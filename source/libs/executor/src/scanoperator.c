@@ -328,10 +328,11 @@ static int32_t loadDataBlock(SOperatorInfo* pOperator, STableScanBase* pTableSca
     pAPI->tsdReader.tsdReaderReleaseDataBlock(pTableScanInfo->dataReader);
     return TSDB_CODE_SUCCESS;
   } else if (*status == FUNC_DATA_REQUIRED_SMA_LOAD) {
-    pCost->loadBlockStatis += 1;
     loadSMA = true;  // mark the operation of load sma;
     bool success = doLoadBlockSMA(pTableScanInfo, pBlock, pTaskInfo);
     if (success) {  // failed to load the block sma data, data block statistics does not exist, load data block instead
+      // only count the blocks answered by statistics, the ones falling back to decoding are counted in loadBlocks
+      pCost->loadBlockStatis += 1;
       qDebug("%s data block SMA loaded, brange:%" PRId64 "-%" PRId64 ", rows:%" PRId64, GET_TASKID(pTaskInfo),
              pBlockInfo->window.skey, pBlockInfo->window.ekey, pBlockInfo->rows);
       doSetTagColumnData(pTableScanInfo, pBlock, pTaskInfo, pBlock->info.rows);
@@ -364,6 +365,27 @@ static int32_t loadDataBlock(SOperatorInfo* pOperator, STableScanBase* pTableSca
     }
   }
 
+  // try to filter data block according to the column bloom filters of the block
+  if (filterBloomApplicable(pOperator->exprSupp.pFilterInfo)) {
+    SColumnDataBloom* pBlooms = NULL;
+    int32_t           numOfBlooms = 0;
+    int32_t code = pAPI->tsdReader.tsdReaderRetrieveBlockBloom(pTableScanInfo->dataReader, &pBlooms, &numOfBlooms);
+    if (code != TSDB_CODE_SUCCESS) {
+      T_LONG_JMP(pTaskInfo->env, code);
+    }
+
+    if (!filterBloomExecute(pOperator->exprSupp.pFilterInfo, pBlooms, numOfBlooms)) {
+      qDebug("%s data block filter out by block bloom filter, brange:%" PRId64 "-%" PRId64 ", rows:%" PRId64,
+             GET_TASKID(pTaskInfo), pBlockInfo->window.skey, pBlockInfo->window.ekey, pBlockInfo->rows);
+      pCost->filterOutBlocks += 1;
+      (*status) = FUNC_DATA_REQUIRED_FILTEROUT;
+      taosMemoryFreeClear(pBlock->pBlockAgg);
+
+      pAPI->tsdReader.tsdReaderReleaseDataBlock(pTableScanInfo->dataReader);
+      return TSDB_CODE_SUCCESS;
+    }
+  }
+
   // free the sma info, since it should not be involved in later computing process.
   taosMemoryFreeClear(pBlock->pBlockAgg);
 
@@ -3878,8 +3900,8 @@ static int32_t initSubTablesMergeInfo(STableMergeScanInfo* pInfo) {
   }
   int32_t bufPageSize = pInfo->bufPageSize;
   int32_t inMemSize = (pSubTblsInfo->numSubTables - pSubTblsInfo->numTableBlocksInMem) * bufPageSize;
-  int32_t code =
-      createDiskbasedBuf(&pSubTblsInfo->pBlocksBuf, pInfo->bufPageSize, inMemSize, "blocksExternalBuf", tsTempDir);
+  int32_t code = createDiskbasedBuf(&pSubTblsInfo->pBlocksBuf, pInfo->bufPageSize, inMemSize, "blocksExternalBuf",
+                                    tsTempDir, DBUF_COMPRESS_LZ4);
   if (code != TSDB_CODE_SUCCESS) {
     taosMemoryFree(pSubTblsInfo->aInputs);
     taosMemoryFree(pSubTblsInfo);
@@ -4372,6 +4394,8 @@ void stopDurationForGroupTableMergeScan(SOperatorInfo* pOperator) {
   pInfo->sortExecInfo.loops += sortExecInfo.loops;
   pInfo->sortExecInfo.readBytes += sortExecInfo.readBytes;
   pInfo->sortExecInfo.writeBytes += sortExecInfo.writeBytes;
+  pInfo->sortExecInfo.rawBytes += sortExecInfo.rawBytes;
+  pInfo->sortExecInfo.cmprTime += sortExecInfo.cmprTime;
 
   tsortDestroySortHandle(pInfo->pSortHandle);
   pInfo->pSortHandle = NULL;
@@ -539,6 +539,8 @@ int32_t finishSortGroup(SOperatorInfo* pOperator) {
   pInfo->sortExecInfo.loops += sortExecInfo.loops;
   pInfo->sortExecInfo.readBytes += sortExecInfo.readBytes;
   pInfo->sortExecInfo.writeBytes += sortExecInfo.writeBytes;
+  pInfo->sortExecInfo.rawBytes += sortExecInfo.rawBytes;
+  pInfo->sortExecInfo.cmprTime += sortExecInfo.cmprTime;
 
   tsortDestroySortHandle(pInfo->pCurrSortHandle);
   pInfo->pCurrSortHandle = NULL;
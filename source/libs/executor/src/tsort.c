@@ -22,6 +22,7 @@
 #include "theap.h"
 #include "tlosertree.h"
 #include "tpagedbuf.h"
+#include "tsched.h"
 #include "tsort.h"
 #include "tutil.h"
 #include "tsimplehash.h"
@@ -112,8 +113,34 @@ struct SSortHandle {
   bool            bSortPk;
   void (*mergeLimitReachedFn)(uint64_t tableUid, void* param);
   void* mergeLimitReachedParam;
+  SArray*         pRunTasks;  // SArray<SSortRunTask*>, runs being sorted by the sort threads, in generation order
 };
 
+#define SORT_RUN_QUEUE_SIZE      1024
+#define SORT_MAX_PENDING_RUNS    2
+#define SORT_NORM_KEY_STR_PREFIX 16
+
+typedef struct SSortRunTask {
+  SSDataBlock* pBlock;
+  SArray*      pOrderInfo;  // private copy, since blockDataSort caches the column and compare function in it
+  uint64_t     maxRows;
+  int32_t      code;
+  int64_t      elapsed;
+  tsem_t       ready;
+} SSortRunTask;
+
+typedef struct SSortNormKeyCol {
+  int32_t slotId;
+  int8_t  type;
+  int32_t bytes;  // bytes of the encoded value, following the one byte null indicator
+  bool    nullFirst;
+  bool    desc;
+} SSortNormKeyCol;
+
+static SSchedQueue sortRunQueue = {0};
+static void*       sortRunSched = NULL;
+static int32_t     sortRunThreads = 0;
+
 static int32_t destroySortMemFile(SSortHandle* pHandle);
 static int32_t getRowBufFromExtMemFile(SSortHandle* pHandle, int32_t regionId, int32_t tupleOffset, int32_t rowLen,
                                        char** ppRow, bool* pFreeRow);
@@ -127,6 +154,9 @@ void tsortSetAbortCheckFn(SSortHandle *pHandle, bool (*checkFn)(void *), void* p
 }
 
 static int32_t msortComparFn(const void* pLeft, const void* pRight, void* param);
+static int32_t msortNormKeyComparFn(const void* pLeft, const void* pRight, void* param);
+static void    tsortBuildNormKeys(SMsortComparParam* pParam, SSortSource* pSource);
+static void    tsortDestroyRunTasks(SSortHandle* pHandle);
 
 // | offset[0] | offset[1] |....| nullbitmap | data |...|
 static void* createTuple(uint32_t columnNum, uint32_t tupleLen) {
@@ -291,6 +321,7 @@ static int32_t sortComparCleanup(SMsortComparParam* cmpParam) {
     if (pSource->pageIdList) {
       taosArrayDestroy(pSource->pageIdList);
     }
+    taosMemoryFreeClear(pSource->pNormKey);
     taosMemoryFreeClear(pSource);
     cmpParam->pSources[i] = NULL;
   }
@@ -326,6 +357,7 @@ void tsortClearOrderdSource(SArray* pOrderedSource, int64_t *fetchUs, int64_t *f
       (*pSource)->src.pBlock = NULL;
     }
 
+    taosMemoryFreeClear((*pSource)->pNormKey);
     taosMemoryFreeClear(*pSource);
   }
 
@@ -337,6 +369,7 @@ void tsortDestroySortHandle(SSortHandle* pSortHandle) {
     return;
   }
   tsortClose(pSortHandle);
+  tsortDestroyRunTasks(pSortHandle);
   if (pSortHandle->pMergeTree != NULL) {
     tMergeTreeDestroy(&pSortHandle->pMergeTree);
   }
@@ -357,6 +390,7 @@ void tsortDestroySortHandle(SSortHandle* pSortHandle) {
   taosArrayDestroy(pSortHandle->pSortInfo);  
   taosArrayDestroy(pSortHandle->aExtRowsOrders);
   pSortHandle->aExtRowsOrders = NULL;
+  taosArrayDestroy(pSortHandle->cmpParam.pNormKeyCols);
   taosMemoryFreeClear(pSortHandle);
 }
 
@@ -400,7 +434,7 @@ static int32_t doAddToBuf(SSDataBlock* pDataBlock, SSortHandle* pHandle) {
     }
 
     int32_t code = createDiskbasedBuf(&pHandle->pBuf, pHandle->pageSize, pHandle->numOfPages * pHandle->pageSize,
-                                      "sortExternalBuf", tsTempDir);
+                                      "sortExternalBuf", tsTempDir, DBUF_COMPRESS_LZ4);
     dBufSetPrintInfo(pHandle->pBuf);
     if (code != TSDB_CODE_SUCCESS) {
       return code;
@@ -466,7 +500,7 @@ static int32_t sortComparInit(SMsortComparParam* pParam, SArray* pSources, int32
     }
 
     code = createDiskbasedBuf(&pHandle->pBuf, pHandle->pageSize, pHandle->numOfPages * pHandle->pageSize,
-                              "sortComparInit", tsTempDir);
+                              "sortComparInit", tsTempDir, DBUF_COMPRESS_LZ4);
     dBufSetPrintInfo(pHandle->pBuf);
     if (code != TSDB_CODE_SUCCESS) {
       terrno = code;
@@ -498,6 +532,7 @@ static int32_t sortComparInit(SMsortComparParam* pParam, SArray* pSources, int32
       }
 
       releaseBufPage(pHandle->pBuf, pPage);
+      tsortBuildNormKeys(pParam, pSource);
     }
   } else {
     qDebug("start init for the multiway merge sort, %s", pHandle->idStr);
@@ -510,6 +545,8 @@ static int32_t sortComparInit(SMsortComparParam* pParam, SArray* pSources, int32
       // set current source is done
       if (pSource->src.pBlock == NULL) {
         setCurrentSourceDone(pSource, pHandle);
+      } else {
+        tsortBuildNormKeys(pParam, pSource);
       }
     }
 
@@ -556,6 +593,8 @@ static int32_t adjustMergeTreeForNextTuple(SSortSource* pSource, SMultiwayMergeT
         pSource->src.rowIndex = -1;
         pSource->pageIndex = -1;
         pSource->src.pBlock = blockDataDestroy(pSource->src.pBlock);
+        taosMemoryFreeClear(pSource->pNormKey);
+        pSource->normKeyCap = 0;
       } else {
         if (pSource->pageIndex % 512 == 0) {
           qDebug("begin source %p page %d", pSource, pSource->pageIndex);
@@ -574,6 +613,7 @@ static int32_t adjustMergeTreeForNextTuple(SSortSource* pSource, SMultiwayMergeT
           return code;
         }
         releaseBufPage(pHandle->pBuf, pPage);
+        tsortBuildNormKeys(&pHandle->cmpParam, pSource);
       }
     } else {
       int64_t st = taosGetTimestampUs();      
@@ -584,6 +624,8 @@ static int32_t adjustMergeTreeForNextTuple(SSortSource* pSource, SMultiwayMergeT
         (*numOfCompleted) += 1;
         pSource->src.rowIndex = -1;
         qDebug("adjust merge tree. %d source completed", *numOfCompleted);
+      } else {
+        tsortBuildNormKeys(&pHandle->cmpParam, pSource);
       }
     }
   }
@@ -795,6 +837,228 @@ int32_t msortComparFn(const void* pLeft, const void* pRight, void* param) {
   return 0;
 }
 
+static void tsortEncodeNormKey(uint8_t* pKey, const SSortNormKeyCol* pKeyCol, SColumnInfoData* pCol, int32_t row) {
+  if (colDataIsNull_s(pCol, row)) {
+    pKey[0] = pKeyCol->nullFirst ? 0 : 1;
+    memset(pKey + 1, 0, pKeyCol->bytes);
+    return;
+  }
+
+  pKey[0] = pKeyCol->nullFirst ? 1 : 0;
+  uint8_t* p = pKey + 1;
+  int32_t  bytes = pKeyCol->bytes;
+
+  if (IS_VAR_DATA_TYPE(pKeyCol->type)) {
+    // strncmp stops at the first '\0', so does the prefix, the remaining bytes are zero padded
+    char*   pVal = colDataGetVarData(pCol, row);
+    int32_t len = TMIN(varDataLen(pVal), bytes);
+    int32_t i = 0;
+    for (; i < len && varDataVal(pVal)[i] != 0; ++i) {
+      p[i] = (uint8_t)varDataVal(pVal)[i];
+    }
+    memset(p + i, 0, bytes - i);
+  } else {
+    char*    pVal = colDataGetNumData(pCol, row);
+    uint64_t v = 0;
+    switch (pKeyCol->type) {
+      case TSDB_DATA_TYPE_BOOL:
+      case TSDB_DATA_TYPE_TINYINT:
+        v = (uint64_t)(int64_t)(*(int8_t*)pVal);
+        break;
+      case TSDB_DATA_TYPE_SMALLINT:
+        v = (uint64_t)(int64_t)(*(int16_t*)pVal);
+        break;
+      case TSDB_DATA_TYPE_INT:
+        v = (uint64_t)(int64_t)(*(int32_t*)pVal);
+        break;
+      case TSDB_DATA_TYPE_BIGINT:
+      case TSDB_DATA_TYPE_TIMESTAMP:
+        v = (uint64_t)(*(int64_t*)pVal);
+        break;
+      case TSDB_DATA_TYPE_UTINYINT:
+        v = *(uint8_t*)pVal;
+        break;
+      case TSDB_DATA_TYPE_USMALLINT:
+        v = *(uint16_t*)pVal;
+        break;
+      case TSDB_DATA_TYPE_UINT:
+        v = *(uint32_t*)pVal;
+        break;
+      default:
+        v = *(uint64_t*)pVal;
+        break;
+    }
+
+    // flip the sign bit of the signed integers, so that they are ordered as unsigned ones
+    if (!IS_UNSIGNED_NUMERIC_TYPE(pKeyCol->type)) {
+      v ^= (1ULL << (bytes * 8 - 1));
+    }
+
+    for (int32_t i = 0; i < bytes; ++i) {
+      p[i] = (uint8_t)(v >> ((bytes - 1 - i) * 8));
+    }
+  }
+
+  if (pKeyCol->desc) {
+    for (int32_t i = 0; i < bytes; ++i) {
+      p[i] = ~p[i];
+    }
+  }
+}
+
+/*
+ * Encode the order columns of the rows into byte-comparable keys, so that the loser tree compares two rows with one
+ * memcmp. Each column is a null indicator byte followed by the big-endian value, inverted for the descending order.
+ * Float, double and the multi-byte types are compared by msortComparFn, the encoding stops at the first such column,
+ * as well as after the fixed prefix of a binary column.
+ */
+static void tsortInitNormKey(SSortHandle* pHandle) {
+  SMsortComparParam* pParam = &pHandle->cmpParam;
+  if (pHandle->comparFn != msortComparFn || pParam->sortType == SORT_BLOCK_TS_MERGE || pHandle->pDataBlock == NULL ||
+      pParam->pNormKeyCols != NULL) {
+    return;
+  }
+
+  pParam->pNormKeyCols = taosArrayInit(taosArrayGetSize(pParam->orderInfo), sizeof(SSortNormKeyCol));
+  if (pParam->pNormKeyCols == NULL) {
+    return;
+  }
+
+  int32_t len = 0;
+  bool    exact = true;
+  for (int32_t i = 0; i < taosArrayGetSize(pParam->orderInfo) && exact; ++i) {
+    SBlockOrderInfo* pOrder = taosArrayGet(pParam->orderInfo, i);
+    SColumnInfoData* pCol = taosArrayGet(pHandle->pDataBlock->pDataBlock, pOrder->slotId);
+    if (pCol == NULL) {
+      exact = false;
+      break;
+    }
+
+    int8_t type = pCol->info.type;
+    if (pOrder->compFn != NULL && pOrder->compFn != getKeyComparFunc(type, pOrder->order)) {
+      exact = false;
+      break;
+    }
+
+    SSortNormKeyCol keyCol = {
+        .slotId = pOrder->slotId, .type = type, .nullFirst = pOrder->nullFirst, .desc = (pOrder->order == TSDB_ORDER_DESC)};
+    switch (type) {
+      case TSDB_DATA_TYPE_BOOL:
+      case TSDB_DATA_TYPE_TINYINT:
+      case TSDB_DATA_TYPE_SMALLINT:
+      case TSDB_DATA_TYPE_INT:
+      case TSDB_DATA_TYPE_BIGINT:
+      case TSDB_DATA_TYPE_TIMESTAMP:
+      case TSDB_DATA_TYPE_UTINYINT:
+      case TSDB_DATA_TYPE_USMALLINT:
+      case TSDB_DATA_TYPE_UINT:
+      case TSDB_DATA_TYPE_UBIGINT:
+        keyCol.bytes = tDataTypes[type].bytes;
+        break;
+      case TSDB_DATA_TYPE_BINARY:
+      case TSDB_DATA_TYPE_GEOMETRY:
+        keyCol.bytes = SORT_NORM_KEY_STR_PREFIX;
+        exact = false;
+        break;
+      default:
+        keyCol.bytes = 0;
+        exact = false;
+        break;
+    }
+
+    if (keyCol.bytes > 0) {
+      taosArrayPush(pParam->pNormKeyCols, &keyCol);
+      len += keyCol.bytes + 1;
+    }
+  }
+
+  if (len == 0) {
+    taosArrayDestroy(pParam->pNormKeyCols);
+    pParam->pNormKeyCols = NULL;
+    return;
+  }
+
+  pParam->normKeyLen = len;
+  pParam->normKeyExact = exact;
+  pHandle->comparFn = msortNormKeyComparFn;
+  qDebug("sort by normalized key, len:%d, exact:%d, %s", len, exact, pHandle->idStr);
+}
+
+static void tsortBuildNormKeys(SMsortComparParam* pParam, SSortSource* pSource) {
+  if (pParam->normKeyLen == 0) {
+    return;
+  }
+
+  // the null state of a block with aggregation info is decided by pBlockAgg, leave it to msortComparFn
+  SSDataBlock* pBlock = pSource->src.pBlock;
+  if (pBlock->pBlockAgg != NULL) {
+    taosMemoryFreeClear(pSource->pNormKey);
+    pSource->normKeyCap = 0;
+    return;
+  }
+
+  int32_t rows = pBlock->info.rows;
+  if (rows > pSource->normKeyCap || pSource->pNormKey == NULL) {
+    char* p = taosMemoryRealloc(pSource->pNormKey, (int64_t)TMAX(rows, 1) * pParam->normKeyLen);
+    if (p == NULL) {
+      taosMemoryFreeClear(pSource->pNormKey);
+      pSource->normKeyCap = 0;
+      return;
+    }
+    pSource->pNormKey = p;
+    pSource->normKeyCap = TMAX(rows, 1);
+  }
+
+  int32_t offset = 0;
+  for (int32_t i = 0; i < taosArrayGetSize(pParam->pNormKeyCols); ++i) {
+    SSortNormKeyCol* pKeyCol = taosArrayGet(pParam->pNormKeyCols, i);
+    SColumnInfoData* pCol = taosArrayGet(pBlock->pDataBlock, pKeyCol->slotId);
+
+    uint8_t* pKey = (uint8_t*)pSource->pNormKey + offset;
+    for (int32_t j = 0; j < rows; ++j, pKey += pParam->normKeyLen) {
+      tsortEncodeNormKey(pKey, pKeyCol, pCol, j);
+    }
+    offset += pKeyCol->bytes + 1;
+  }
+}
+
+static int32_t msortNormKeyComparFn(const void* pLeft, const void* pRight, void* param) {
+  SMsortComparParam* pParam = (SMsortComparParam*)param;
+
+  SSortSource* pLeftSource = pParam->pSources[*(int32_t*)pLeft];
+  SSortSource* pRightSource = pParam->pSources[*(int32_t*)pRight];
+
+  // this input is exhausted, set the special value to denote this
+  if (pLeftSource->src.rowIndex == -1) {
+    return 1;
+  }
+
+  if (pRightSource->src.rowIndex == -1) {
+    return -1;
+  }
+
+  if (pLeftSource->pNormKey == NULL || pRightSource->pNormKey == NULL) {
+    return msortComparFn(pLeft, pRight, param);
+  }
+
+  if (pParam->cmpGroupId) {
+    uint64_t leftGroupId = pLeftSource->src.pBlock->info.id.groupId;
+    uint64_t rightGroupId = pRightSource->src.pBlock->info.id.groupId;
+    if (leftGroupId != rightGroupId) {
+      return leftGroupId < rightGroupId ? -1 : 1;
+    }
+  }
+
+  int32_t ret = memcmp(pLeftSource->pNormKey + (int64_t)pLeftSource->src.rowIndex * pParam->normKeyLen,
+                       pRightSource->pNormKey + (int64_t)pRightSource->src.rowIndex * pParam->normKeyLen,
+                       pParam->normKeyLen);
+  if (ret != 0) {
+    return ret < 0 ? -1 : 1;
+  }
+
+  return pParam->normKeyExact ? 0 : msortComparFn(pLeft, pRight, param);
+}
+
 static int32_t doInternalMergeSort(SSortHandle* pHandle) {
   size_t numOfSources = taosArrayGetSize(pHandle->pOrderedSource);
   if (numOfSources == 0) {
@@ -923,7 +1187,7 @@ static int32_t doInternalMergeSort(SSortHandle* pHandle) {
 
     if (pHandle->type == SORT_MULTISOURCE_MERGE) {
       pHandle->type = SORT_SINGLESOURCE_SORT;
-      pHandle->comparFn = msortComparFn;
+      pHandle->comparFn = (pHandle->cmpParam.normKeyLen > 0) ? msortNormKeyComparFn : msortComparFn;
     }
   }
 
@@ -950,7 +1214,7 @@ static int32_t createPageBuf(SSortHandle* pHandle) {
     }
 
     int32_t code = createDiskbasedBuf(&pHandle->pBuf, pHandle->pageSize, pHandle->numOfPages * pHandle->pageSize,
-                                      "tableBlocksBuf", tsTempDir);
+                                      "tableBlocksBuf", tsTempDir, DBUF_COMPRESS_LZ4);
     dBufSetPrintInfo(pHandle->pBuf);
     if (code != TSDB_CODE_SUCCESS) {
       return code;
@@ -1886,9 +2150,156 @@ static void freeSSortSource(SSortSource* source) {
     blockDataDestroy(source->src.pBlock);
     source->src.pBlock = NULL;
   }
+  taosMemoryFree(source->pNormKey);
   taosMemoryFree(source);
 }
 
+int32_t tsortInitRunPool(int32_t numOfThreads) {
+  if (numOfThreads <= 0 || sortRunSched != NULL) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  sortRunSched = taosInitScheduler(SORT_RUN_QUEUE_SIZE, numOfThreads, "sort-run", &sortRunQueue);
+  if (sortRunSched == NULL) {
+    qWarn("failed to init %d sort threads, runs are sorted in the query thread", numOfThreads);
+    return TSDB_CODE_SUCCESS;
+  }
+
+  sortRunThreads = numOfThreads;
+  qInfo("%d sort threads are started", numOfThreads);
+  return TSDB_CODE_SUCCESS;
+}
+
+void tsortCleanupRunPool() {
+  if (sortRunSched == NULL) {
+    return;
+  }
+
+  taosCleanUpScheduler(sortRunSched);
+  memset(&sortRunQueue, 0, sizeof(sortRunQueue));
+  sortRunSched = NULL;
+  sortRunThreads = 0;
+}
+
+static void destroySortRunTask(SSortRunTask* pTask) {
+  tsem_destroy(&pTask->ready);
+  blockDataDestroy(pTask->pBlock);
+  taosArrayDestroy(pTask->pOrderInfo);
+  taosMemoryFree(pTask);
+}
+
+static void doSortRunTask(SSchedMsg* pMsg) {
+  SSortRunTask* pTask = pMsg->ahandle;
+
+  int64_t st = taosGetTimestampUs();
+  pTask->code = blockDataSort(pTask->pBlock, pTask->pOrderInfo);
+  if (pTask->code == TSDB_CODE_SUCCESS && pTask->maxRows > 0) {
+    blockDataKeepFirstNRows(pTask->pBlock, pTask->maxRows);
+  }
+  pTask->elapsed = taosGetTimestampUs() - st;
+
+  tsem_post(&pTask->ready);
+}
+
+// flush the sorted runs into the buffer in the generation order, until no more than maxPending runs are left
+static int32_t tsortWaitRunTasks(SSortHandle* pHandle, int32_t maxPending) {
+  int32_t code = TSDB_CODE_SUCCESS;
+
+  while (taosArrayGetSize(pHandle->pRunTasks) > maxPending) {
+    SSortRunTask* pTask = *(SSortRunTask**)taosArrayGet(pHandle->pRunTasks, 0);
+    taosArrayRemove(pHandle->pRunTasks, 0);
+
+    tsem_wait(&pTask->ready);
+    pHandle->sortElapsed += pTask->elapsed;
+
+    code = pTask->code;
+    if (code == TSDB_CODE_SUCCESS) {
+      code = doAddToBuf(pTask->pBlock, pHandle);
+    }
+
+    destroySortRunTask(pTask);
+    if (code != TSDB_CODE_SUCCESS) {
+      return code;
+    }
+  }
+
+  return code;
+}
+
+static void tsortDestroyRunTasks(SSortHandle* pHandle) {
+  for (int32_t i = 0; i < taosArrayGetSize(pHandle->pRunTasks); ++i) {
+    SSortRunTask* pTask = *(SSortRunTask**)taosArrayGet(pHandle->pRunTasks, i);
+    tsem_wait(&pTask->ready);
+    destroySortRunTask(pTask);
+  }
+
+  taosArrayDestroy(pHandle->pRunTasks);
+  pHandle->pRunTasks = NULL;
+}
+
+/*
+ * The run in pDataBlock is full, sort it and flush it into the buffer. With the sort threads, the run is handed to
+ * them and the query thread goes on collecting the next run, while the sorted ones are flushed in order, since the
+ * disk based buffer is owned by the query thread.
+ */
+static int32_t tsortFlushRun(SSortHandle* pHandle) {
+  int32_t code = TSDB_CODE_SUCCESS;
+
+  if (sortRunSched == NULL) {
+    // Perform the in-memory sort and then flush data in the buffer into disk.
+    int64_t p = taosGetTimestampUs();
+    code = blockDataSort(pHandle->pDataBlock, pHandle->pSortInfo);
+    if (code != 0) {
+      return code;
+    }
+
+    int64_t el = taosGetTimestampUs() - p;
+    pHandle->sortElapsed += el;
+    if (pHandle->pqMaxRows > 0) blockDataKeepFirstNRows(pHandle->pDataBlock, pHandle->pqMaxRows);
+    return doAddToBuf(pHandle->pDataBlock, pHandle);
+  }
+
+  if (pHandle->pRunTasks == NULL) {
+    pHandle->pRunTasks = taosArrayInit(SORT_MAX_PENDING_RUNS, POINTER_BYTES);
+    if (pHandle->pRunTasks == NULL) {
+      return TSDB_CODE_OUT_OF_MEMORY;
+    }
+  }
+
+  // each pending run holds a full sort buffer, bound the memory of one sort
+  code = tsortWaitRunTasks(pHandle, TMIN(sortRunThreads, SORT_MAX_PENDING_RUNS) - 1);
+  if (code != TSDB_CODE_SUCCESS) {
+    return code;
+  }
+
+  SSortRunTask* pTask = taosMemoryCalloc(1, sizeof(SSortRunTask));
+  if (pTask == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  pTask->pOrderInfo = taosArrayDup(pHandle->pSortInfo, NULL);
+  SSDataBlock* pNext = createOneDataBlock(pHandle->pDataBlock, false);
+  if (pTask->pOrderInfo == NULL || pNext == NULL) {
+    taosArrayDestroy(pTask->pOrderInfo);
+    blockDataDestroy(pNext);
+    taosMemoryFree(pTask);
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  tsem_init(&pTask->ready, 0, 0);
+  pTask->pBlock = pHandle->pDataBlock;
+  pTask->maxRows = pHandle->pqMaxRows;
+  pHandle->pDataBlock = pNext;
+  taosArrayPush(pHandle->pRunTasks, &pTask);
+
+  SSchedMsg msg = {.fp = doSortRunTask, .ahandle = pTask};
+  if (taosScheduleTask(sortRunSched, &msg) != 0) {
+    doSortRunTask(&msg);
+  }
+
+  return TSDB_CODE_SUCCESS;
+}
+
 static int32_t createBlocksQuickSortInitialSources(SSortHandle* pHandle) {
   int32_t code = 0;
   size_t  sortBufSize = pHandle->numOfPages * pHandle->pageSize;
@@ -1927,18 +2338,7 @@ static int32_t createBlocksQuickSortInitialSources(SSortHandle* pHandle) {
 
     size_t size = blockDataGetSize(pHandle->pDataBlock);
     if (size > sortBufSize) {
-      // Perform the in-memory sort and then flush data in the buffer into disk.
-      int64_t p = taosGetTimestampUs();
-      code = blockDataSort(pHandle->pDataBlock, pHandle->pSortInfo);
-      if (code != 0) {
-        freeSSortSource(source);
-        return code;
-      }
-
-      int64_t el = taosGetTimestampUs() - p;
-      pHandle->sortElapsed += el;
-      if (pHandle->pqMaxRows > 0) blockDataKeepFirstNRows(pHandle->pDataBlock, pHandle->pqMaxRows);
-      code = doAddToBuf(pHandle->pDataBlock, pHandle);
+      code = tsortFlushRun(pHandle);
       if (code != TSDB_CODE_SUCCESS) {
         freeSSortSource(source);
         return code;
@@ -1948,6 +2348,11 @@ static int32_t createBlocksQuickSortInitialSources(SSortHandle* pHandle) {
 
   freeSSortSource(source);
 
+  code = tsortWaitRunTasks(pHandle, 0);
+  if (code != TSDB_CODE_SUCCESS) {
+    return code;
+  }
+
   if (pHandle->pDataBlock != NULL && pHandle->pDataBlock->info.rows > 0) {
     size_t size = blockDataGetSize(pHandle->pDataBlock);
 
@@ -1997,6 +2402,8 @@ static bool tsortOpenForBufMergeSort(SSortHandle* pHandle) {
     return code;
   }
 
+  tsortInitNormKey(pHandle);
+
   // do internal sort
   code = doInternalMergeSort(pHandle);
   if (code != TSDB_CODE_SUCCESS) {
@@ -2327,6 +2734,8 @@ SSortExecInfo tsortGetSortExecInfo(SSortHandle* pHandle) {
       SDiskbasedBufStatis st = getDBufStatis(pHandle->pBuf);
       info.writeBytes = st.flushBytes;
       info.readBytes = st.loadBytes;
+      info.rawBytes = st.rawFlushBytes;
+      info.cmprTime = st.compressTime + st.decompressTime;
     }
   }
 
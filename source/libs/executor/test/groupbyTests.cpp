@@ -0,0 +1,272 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include <iostream>
+#include <map>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wwrite-strings"
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#pragma GCC diagnostic ignored "-Wsign-compare"
+
+#include "os.h"
+
+#include "executorInt.h"
+#include "functionMgt.h"
+#include "operator.h"
+#include "querytask.h"
+#include "tdatablock.h"
+#include "tglobal.h"
+
+namespace {
+
+#define GB_INPUT_BLK_ID  0
+#define GB_OUTPUT_BLK_ID 1
+#define GB_BLK_ROWS      4096
+
+typedef struct SGroupbyTestCtx {
+  SArray* pBlocks;
+  int32_t blkIdx;
+} SGroupbyTestCtx;
+
+SGroupbyTestCtx gbCtx = {0};
+
+SSDataBlock* getDummyInputBlock(SOperatorInfo* pOperator) {
+  if (gbCtx.blkIdx >= taosArrayGetSize(gbCtx.pBlocks)) {
+    return NULL;
+  }
+
+  // the group operator may reorder the rows of the input block, hand out a copy
+  SSDataBlock* pSrc = (SSDataBlock*)taosArrayGetP(gbCtx.pBlocks, gbCtx.blkIdx++);
+  SSDataBlock* pBlock = (SSDataBlock*)pOperator->info;
+  copyDataBlock(pBlock, pSrc);
+  return pBlock;
+}
+
+SSDataBlock* createInputBlock() {
+  SSDataBlock*    p = createDataBlock();
+  SColumnInfoData key = createColumnInfoData(TSDB_DATA_TYPE_INT, sizeof(int32_t), 0);
+  SColumnInfoData val = createColumnInfoData(TSDB_DATA_TYPE_BIGINT, sizeof(int64_t), 1);
+  blockDataAppendColInfo(p, &key);
+  blockDataAppendColInfo(p, &val);
+  p->info.id.blockId = GB_INPUT_BLK_ID;
+  return p;
+}
+
+// numOfGroups distinct keys, interleaved row by row when shuffle is set, otherwise in runs of runLen rows
+void createInputBlocks(int32_t numOfBlocks, int32_t numOfGroups, int32_t runLen, bool shuffle) {
+  gbCtx.pBlocks = taosArrayInit(numOfBlocks, POINTER_BYTES);
+  gbCtx.blkIdx = 0;
+
+  uint32_t seed = 100;
+  int64_t  row = 0;
+  for (int32_t i = 0; i < numOfBlocks; ++i) {
+    SSDataBlock* p = createInputBlock();
+    blockDataEnsureCapacity(p, GB_BLK_ROWS);
+
+    SColumnInfoData* pKey = (SColumnInfoData*)taosArrayGet(p->pDataBlock, 0);
+    SColumnInfoData* pVal = (SColumnInfoData*)taosArrayGet(p->pDataBlock, 1);
+    for (int32_t j = 0; j < GB_BLK_ROWS; ++j, ++row) {
+      int32_t k = shuffle ? (int32_t)(taosRandR(&seed) % numOfGroups) : (int32_t)((row / runLen) % numOfGroups);
+      int64_t v = row % 1000;
+      if (j % 97 == 0) {
+        colDataSetNULL(pKey, j);
+      } else {
+        colDataSetVal(pKey, j, (const char*)&k, false);
+      }
+      colDataSetVal(pVal, j, (const char*)&v, false);
+    }
+
+    p->info.rows = GB_BLK_ROWS;
+    taosArrayPush(gbCtx.pBlocks, &p);
+  }
+}
+
+void destroyInputBlocks() {
+  for (int32_t i = 0; i < taosArrayGetSize(gbCtx.pBlocks); ++i) {
+    blockDataDestroy((SSDataBlock*)taosArrayGetP(gbCtx.pBlocks, i));
+  }
+  taosArrayDestroy(gbCtx.pBlocks);
+  gbCtx.pBlocks = NULL;
+}
+
+SColumnNode* createColumn(int16_t slotId, int8_t type) {
+  SColumnNode* pCol = (SColumnNode*)nodesMakeNode(QUERY_NODE_COLUMN);
+  pCol->dataBlockId = GB_INPUT_BLK_ID;
+  pCol->slotId = slotId;
+  pCol->colId = slotId + 1;
+  pCol->colType = COLUMN_TYPE_COLUMN;
+  pCol->node.resType.type = type;
+  pCol->node.resType.bytes = tDataTypes[type].bytes;
+  return pCol;
+}
+
+STargetNode* createTarget(int16_t slotId, SNode* pExpr) {
+  STargetNode* pTarget = (STargetNode*)nodesMakeNode(QUERY_NODE_TARGET);
+  pTarget->dataBlockId = GB_OUTPUT_BLK_ID;
+  pTarget->slotId = slotId;
+  pTarget->pExpr = pExpr;
+  return pTarget;
+}
+
+SNode* createAggFunc(const char* name, SColumnNode* pParam) {
+  SFunctionNode* pFunc = (SFunctionNode*)nodesMakeNode(QUERY_NODE_FUNCTION);
+  strcpy(pFunc->functionName, name);
+  nodesListMakeAppend(&pFunc->pParameterList, (SNode*)pParam);
+
+  char msg[128] = {0};
+  int32_t code = fmGetFuncInfo(pFunc, msg, sizeof(msg));
+  EXPECT_EQ(code, TSDB_CODE_SUCCESS);
+  return (SNode*)pFunc;
+}
+
+// select count(val), sum(val), key from t group by key
+SAggPhysiNode* createAggPhysiNode() {
+  SAggPhysiNode* p = (SAggPhysiNode*)nodesMakeNode(QUERY_NODE_PHYSICAL_PLAN_HASH_AGG);
+
+  nodesListMakeAppend(&p->pAggFuncs,
+                      (SNode*)createTarget(0, createAggFunc("count", createColumn(1, TSDB_DATA_TYPE_BIGINT))));
+  nodesListMakeAppend(&p->pAggFuncs,
+                      (SNode*)createTarget(1, createAggFunc("sum", createColumn(1, TSDB_DATA_TYPE_BIGINT))));
+  nodesListMakeAppend(&p->pGroupKeys, (SNode*)createTarget(2, (SNode*)createColumn(0, TSDB_DATA_TYPE_INT)));
+
+  SDataBlockDescNode* pDesc = (SDataBlockDescNode*)nodesMakeNode(QUERY_NODE_DATABLOCK_DESC);
+  pDesc->dataBlockId = GB_OUTPUT_BLK_ID;
+
+  int8_t types[] = {TSDB_DATA_TYPE_BIGINT, TSDB_DATA_TYPE_BIGINT, TSDB_DATA_TYPE_INT};
+  for (int16_t i = 0; i < sizeof(types) / sizeof(types[0]); ++i) {
+    SSlotDescNode* pSlot = (SSlotDescNode*)nodesMakeNode(QUERY_NODE_SLOT_DESC);
+    pSlot->slotId = i;
+    pSlot->dataType.type = types[i];
+    pSlot->dataType.bytes = tDataTypes[types[i]].bytes;
+    pSlot->output = true;
+    nodesListMakeAppend(&pDesc->pSlots, (SNode*)pSlot);
+    pDesc->totalRowSize += pSlot->dataType.bytes;
+  }
+
+  pDesc->outputRowSize = pDesc->totalRowSize;
+  p->node.pOutputDataBlockDesc = pDesc;
+  return p;
+}
+
+#define GB_NULL_KEY INT64_MIN
+
+typedef struct SGroupbyTestRes {
+  int64_t numOfGroups;
+  int64_t count;
+  int64_t sum;
+  int64_t elapsedUs;
+  // count and sum of each group key, the null key is GB_NULL_KEY
+  std::map<int64_t, std::pair<int64_t, int64_t>> groups;
+} SGroupbyTestRes;
+
+SGroupbyTestRes runGroupby(bool batch) {
+  SGroupbyTestRes res;
+  res.numOfGroups = res.count = res.sum = res.elapsedUs = 0;
+  gbCtx.blkIdx = 0;
+
+  SExecTaskInfo* pTask = (SExecTaskInfo*)taosMemoryCalloc(1, sizeof(SExecTaskInfo));
+  pTask->id.str = (char*)"groupbyTest";
+
+  SOperatorInfo* pDownstream = (SOperatorInfo*)taosMemoryCalloc(1, sizeof(SOperatorInfo));
+  pDownstream->info = createInputBlock();
+  pDownstream->fpSet.getNextFn = getDummyInputBlock;
+
+  SAggPhysiNode* pNode = createAggPhysiNode();
+  SOperatorInfo* pOp = createGroupOperatorInfo(pDownstream, pNode, pTask);
+  EXPECT_NE(pOp, nullptr);
+
+  bool batchAgg = tsGroupByBatchAgg;
+  tsGroupByBatchAgg = batch;
+
+  int64_t st = taosGetTimestampUs();
+  while (true) {
+    SSDataBlock* pBlock = pOp->fpSet.getNextFn(pOp);
+    if (pBlock == NULL) {
+      break;
+    }
+
+    SColumnInfoData* pCount = (SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 0);
+    SColumnInfoData* pSum = (SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 1);
+    SColumnInfoData* pKey = (SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 2);
+    for (int32_t i = 0; i < pBlock->info.rows; ++i) {
+      int64_t count = *(int64_t*)colDataGetData(pCount, i);
+      int64_t sum = *(int64_t*)colDataGetData(pSum, i);
+      int64_t key = colDataIsNull_s(pKey, i) ? GB_NULL_KEY : *(int32_t*)colDataGetData(pKey, i);
+      EXPECT_EQ(res.groups.count(key), 0) << "duplicated group " << key;
+      res.groups[key] = std::make_pair(count, sum);
+      res.count += count;
+      res.sum += sum;
+    }
+    res.numOfGroups += pBlock->info.rows;
+  }
+  res.elapsedUs = TMAX(taosGetTimestampUs() - st, 1);
+
+  tsGroupByBatchAgg = batchAgg;
+
+  blockDataDestroy((SSDataBlock*)pDownstream->info);
+  pDownstream->info = NULL;
+  destroyOperator(pOp);
+  nodesDestroyNode((SNode*)pNode);
+  taosMemoryFree(pTask);
+  return res;
+}
+
+void runAndCompare(const char* name, int32_t numOfBlocks, int32_t numOfGroups, int32_t runLen, bool shuffle) {
+  createInputBlocks(numOfBlocks, numOfGroups, runLen, shuffle);
+
+  SGroupbyTestRes row = runGroupby(false);
+  SGroupbyTestRes batch = runGroupby(true);
+
+  ASSERT_EQ(row.numOfGroups, batch.numOfGroups);
+  ASSERT_EQ(row.count, batch.count);
+  ASSERT_EQ(row.sum, batch.sum);
+  ASSERT_EQ(row.count, (int64_t)numOfBlocks * GB_BLK_ROWS);
+
+  // each group gets the same aggregates from both paths
+  ASSERT_EQ(row.groups.size(), batch.groups.size());
+  for (auto it = row.groups.begin(); it != row.groups.end(); ++it) {
+    auto found = batch.groups.find(it->first);
+    ASSERT_NE(found, batch.groups.end()) << name << " group " << it->first << " missing in batch path";
+    ASSERT_EQ(it->second.first, found->second.first) << name << " count of group " << it->first;
+    ASSERT_EQ(it->second.second, found->second.second) << name << " sum of group " << it->first;
+  }
+
+  double rows = (double)numOfBlocks * GB_BLK_ROWS;
+  std::cout << name << " groups:" << row.numOfGroups << ", row path:" << rows * 1000000 / row.elapsedUs
+            << " rows/s, batch path:" << rows * 1000000 / batch.elapsedUs << " rows/s" << std::endl;
+
+  destroyInputBlocks();
+}
+
+}  // namespace
+
+TEST(groupbyTest, interleaved_keys_test) {
+  ASSERT_EQ(fmFuncMgtInit(), TSDB_CODE_SUCCESS);
+
+  runAndCompare("interleaved 1000", 256, 1000, 1, true);
+  runAndCompare("interleaved 100000", 256, 100000, 1, true);
+}
+
+TEST(groupbyTest, sorted_keys_test) {
+  ASSERT_EQ(fmFuncMgtInit(), TSDB_CODE_SUCCESS);
+
+  runAndCompare("runs of 2", 64, 1000, 2, false);
+  runAndCompare("runs of 1024", 64, 1000, 1024, false);
+}
+
+#pragma GCC diagnostic pop
@@ -15,6 +15,7 @@
 
 #include <gtest/gtest.h>
 #include <iostream>
+#include <map>
 
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wwrite-strings"
@@ -2440,27 +2441,34 @@ SSDataBlock* getDummyInputBlock(struct SOperatorInfo* pOperator, int32_t idx) {
 }
 
 
-void joinTestReplaceRetrieveFp() {
-  static Stub stub;
-  stub.set(getNextBlockFromDownstreamRemain, getDummyInputBlock);
-  {
+void joinTestReplaceRetrieveFpImpl(Stub* pStub, const char* funcName) {
 #ifdef WINDOWS
-    AddrAny                       any;
-    std::map<std::string, void *> result;
-    any.get_func_addr("getNextBlockFromDownstreamRemain", result);
-    for (const auto &f : result) {
-      stub.set(f.second, getDummyInputBlock);
-    }
+  AddrAny                       any;
+  std::map<std::string, void *> result;
+  any.get_func_addr(funcName, result);
+  for (const auto &f : result) {
+    pStub->set(f.second, getDummyInputBlock);
+  }
 #endif
 #ifdef LINUX
-    AddrAny                       any("libexecutor.so");
-    std::map<std::string, void *> result;
-    any.get_global_func_addr_dynsym("^getNextBlockFromDownstreamRemain$", result);
-    for (const auto &f : result) {
-      stub.set(f.second, getDummyInputBlock);
-    }
-#endif
+  AddrAny                       any("libexecutor.so");
+  std::map<std::string, void *> result;
+  std::string                   pattern = std::string("^") + funcName + "$";
+  any.get_global_func_addr_dynsym(pattern.c_str(), result);
+  for (const auto &f : result) {
+    pStub->set(f.second, getDummyInputBlock);
   }
+#endif
+}
+
+void joinTestReplaceRetrieveFp() {
+  static Stub stub;
+  stub.set(getNextBlockFromDownstreamRemain, getDummyInputBlock);
+  joinTestReplaceRetrieveFpImpl(&stub, "getNextBlockFromDownstreamRemain");
+
+  // the hash join operator fetches its downstream blocks by getNextBlockFromDownstream
+  stub.set(getNextBlockFromDownstream, getDummyInputBlock);
+  joinTestReplaceRetrieveFpImpl(&stub, "getNextBlockFromDownstream");
 }
 
 void printColList(char* title, bool left, int32_t* colList, bool filter, char* opStr) {
@@ -2898,6 +2906,233 @@ void handleCaseEnd() {
   jtCtx.rightFinMatchNum = 0;
 }
 
+typedef struct {
+  EJoinType joinType;
+  int32_t   leftRows;
+  int32_t   leftKeys;
+  int32_t   leftKeyBase;
+  int32_t   rightRows;
+  int32_t   rightKeys;
+  int32_t   rightKeyBase;
+  int32_t   blkRows;
+  int32_t   bufSizeMB;
+} SHashJoinSpillParam;
+
+typedef struct {
+  int64_t rows;
+  int64_t leftValSum;
+  int64_t rightValSum;
+  int64_t leftNullRows;
+  int64_t rightNullRows;
+} SHashJoinSpillRes;
+
+enum {
+  HJT_TS_SLOT = 0,
+  HJT_KEY_SLOT,
+  HJT_VAL_SLOT,
+  HJT_IN_SLOT_NUM
+};
+
+int32_t hjtInColType[HJT_IN_SLOT_NUM] = {TSDB_DATA_TYPE_TIMESTAMP, TSDB_DATA_TYPE_INT, TSDB_DATA_TYPE_BIGINT};
+
+SColumnNode* hjtCreateColNode(int32_t blkId, int32_t slotId, int32_t type) {
+  SColumnNode* pCol = (SColumnNode*)nodesMakeNode(QUERY_NODE_COLUMN);
+  pCol->dataBlockId = blkId;
+  pCol->slotId = slotId;
+  pCol->node.resType.type = type;
+  pCol->node.resType.bytes = tDataTypes[type].bytes;
+  return pCol;
+}
+
+SDataBlockDescNode* hjtCreateBlockDesc(int32_t blkId, int32_t colNum, int32_t* colTypes) {
+  SDataBlockDescNode* pDesc = (SDataBlockDescNode*)nodesMakeNode(QUERY_NODE_DATABLOCK_DESC);
+  pDesc->dataBlockId = blkId;
+  for (int32_t i = 0; i < colNum; ++i) {
+    SSlotDescNode* pSlot = (SSlotDescNode*)nodesMakeNode(QUERY_NODE_SLOT_DESC);
+    pSlot->slotId = i;
+    pSlot->dataType.type = colTypes[i];
+    pSlot->dataType.bytes = tDataTypes[colTypes[i]].bytes;
+    pDesc->totalRowSize += pSlot->dataType.bytes;
+    nodesListMakeStrictAppend(&pDesc->pSlots, (SNode*)pSlot);
+  }
+  pDesc->outputRowSize = pDesc->totalRowSize;
+
+  return pDesc;
+}
+
+// output slots: left key, left val, right key, right val
+SHashJoinPhysiNode* hjtCreateHashJoinPhysiNode(SHashJoinSpillParam* param) {
+  SHashJoinPhysiNode* p = (SHashJoinPhysiNode*)nodesMakeNode(QUERY_NODE_PHYSICAL_PLAN_HASH_JOIN);
+  p->joinType = param->joinType;
+  p->subType = (JOIN_TYPE_INNER == param->joinType) ? JOIN_STYPE_NONE : JOIN_STYPE_OUTER;
+  p->leftPrimSlotId = HJT_TS_SLOT;
+  p->rightPrimSlotId = HJT_TS_SLOT;
+  p->timeRange.skey = INT64_MIN;
+  p->timeRange.ekey = INT64_MAX;
+  p->inputStat[0].inputRowNum = param->leftRows;
+  p->inputStat[1].inputRowNum = param->rightRows;
+
+  for (int32_t i = LEFT_BLK_ID; i <= RIGHT_BLK_ID; ++i) {
+    SProjectPhysiNode* pChild = (SProjectPhysiNode*)nodesMakeNode(QUERY_NODE_PHYSICAL_PLAN_PROJECT);
+    pChild->node.pOutputDataBlockDesc = hjtCreateBlockDesc(i, HJT_IN_SLOT_NUM, hjtInColType);
+    nodesListMakeStrictAppend(&p->node.pChildren, (SNode*)pChild);
+  }
+
+  nodesListMakeStrictAppend(&p->pOnLeft, (SNode*)hjtCreateColNode(LEFT_BLK_ID, HJT_KEY_SLOT, TSDB_DATA_TYPE_INT));
+  nodesListMakeStrictAppend(&p->pOnRight, (SNode*)hjtCreateColNode(RIGHT_BLK_ID, HJT_KEY_SLOT, TSDB_DATA_TYPE_INT));
+
+  int32_t resColTypes[4] = {TSDB_DATA_TYPE_INT, TSDB_DATA_TYPE_BIGINT, TSDB_DATA_TYPE_INT, TSDB_DATA_TYPE_BIGINT};
+  for (int32_t i = 0; i < 4; ++i) {
+    STargetNode* pTarget = (STargetNode*)nodesMakeNode(QUERY_NODE_TARGET);
+    pTarget->dataBlockId = RES_BLK_ID;
+    pTarget->slotId = i;
+    pTarget->pExpr = (SNode*)hjtCreateColNode((i < 2) ? LEFT_BLK_ID : RIGHT_BLK_ID, (i % 2) ? HJT_VAL_SLOT : HJT_KEY_SLOT,
+                                              resColTypes[i]);
+    nodesListMakeStrictAppend(&p->pTargets, (SNode*)pTarget);
+  }
+  p->node.pOutputDataBlockDesc = hjtCreateBlockDesc(RES_BLK_ID, 4, resColTypes);
+
+  return p;
+}
+
+// row i of a table has key keyBase + i % keys and value i
+void hjtCreateBlkList(SArray* pList, int32_t blkId, int32_t rows, int32_t keys, int32_t keyBase, int32_t blkRows) {
+  SSDataBlock* pBlk = NULL;
+  for (int32_t i = 0; i < rows; ++i) {
+    if (NULL == pBlk || pBlk->info.rows >= blkRows) {
+      pBlk = createDataBlock();
+      pBlk->info.id.blockId = blkId;
+      for (int32_t c = 0; c < HJT_IN_SLOT_NUM; ++c) {
+        SColumnInfoData idata = createColumnInfoData(hjtInColType[c], tDataTypes[hjtInColType[c]].bytes, c);
+        blockDataAppendColInfo(pBlk, &idata);
+      }
+      blockDataEnsureCapacity(pBlk, blkRows);
+      taosArrayPush(pList, &pBlk);
+    }
+
+    int64_t ts = i;
+    int32_t key = keyBase + i % keys;
+    int64_t val = i;
+    colDataSetVal((SColumnInfoData*)taosArrayGet(pBlk->pDataBlock, HJT_TS_SLOT), pBlk->info.rows, (char*)&ts, false);
+    colDataSetVal((SColumnInfoData*)taosArrayGet(pBlk->pDataBlock, HJT_KEY_SLOT), pBlk->info.rows, (char*)&key, false);
+    colDataSetVal((SColumnInfoData*)taosArrayGet(pBlk->pDataBlock, HJT_VAL_SLOT), pBlk->info.rows, (char*)&val, false);
+    pBlk->info.rows++;
+  }
+}
+
+void hjtAddKeyStat(std::map<int32_t, std::pair<int64_t, int64_t>>& stat, int32_t rows, int32_t keys, int32_t keyBase) {
+  for (int32_t i = 0; i < rows; ++i) {
+    std::pair<int64_t, int64_t>& s = stat[keyBase + i % keys];
+    s.first++;
+    s.second += i;
+  }
+}
+
+void hjtCalcExpectedRes(SHashJoinSpillParam* param, SHashJoinSpillRes* pRes) {
+  std::map<int32_t, std::pair<int64_t, int64_t>> left, right;
+  hjtAddKeyStat(left, param->leftRows, param->leftKeys, param->leftKeyBase);
+  hjtAddKeyStat(right, param->rightRows, param->rightKeys, param->rightKeyBase);
+
+  memset(pRes, 0, sizeof(*pRes));
+  for (const auto& l : left) {
+    auto r = right.find(l.first);
+    if (r != right.end()) {
+      pRes->rows += l.second.first * r->second.first;
+      pRes->leftValSum += l.second.second * r->second.first;
+      pRes->rightValSum += r->second.second * l.second.first;
+    } else if (JOIN_TYPE_LEFT == param->joinType) {
+      pRes->rows += l.second.first;
+      pRes->leftValSum += l.second.second;
+      pRes->rightNullRows += l.second.first;
+    }
+  }
+
+  if (JOIN_TYPE_RIGHT == param->joinType) {
+    for (const auto& r : right) {
+      if (left.find(r.first) == left.end()) {
+        pRes->rows += r.second.first;
+        pRes->rightValSum += r.second.second;
+        pRes->leftNullRows += r.second.first;
+      }
+    }
+  }
+}
+
+void hjtCheckResBlock(SSDataBlock* pBlock, SHashJoinSpillRes* pRes) {
+  SColumnInfoData* pLeftKey = (SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 0);
+  SColumnInfoData* pLeftVal = (SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 1);
+  SColumnInfoData* pRightKey = (SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 2);
+  SColumnInfoData* pRightVal = (SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 3);
+
+  for (int32_t i = 0; i < pBlock->info.rows; ++i) {
+    bool leftNull = colDataIsNull_s(pLeftKey, i);
+    bool rightNull = colDataIsNull_s(pRightKey, i);
+    ASSERT_FALSE(leftNull && rightNull);
+    if (!leftNull && !rightNull) {
+      ASSERT_EQ(*(int32_t*)colDataGetData(pLeftKey, i), *(int32_t*)colDataGetData(pRightKey, i));
+    }
+    if (leftNull) {
+      pRes->leftNullRows++;
+    } else {
+      pRes->leftValSum += *(int64_t*)colDataGetData(pLeftVal, i);
+    }
+    if (rightNull) {
+      pRes->rightNullRows++;
+    } else {
+      pRes->rightValSum += *(int64_t*)colDataGetData(pRightVal, i);
+    }
+  }
+  pRes->rows += pBlock->info.rows;
+}
+
+void runHashJoinSpillTest(char* caseName, SHashJoinSpillParam* param, SHashJoinExecInfo* pExecInfo) {
+  int32_t oldBufSize = tsHashJoinBufSize;
+  tsHashJoinBufSize = param->bufSizeMB;
+  taosGetDiskSize(tsTempDir, &tsTempSpace.size);
+
+  hjtCreateBlkList(jtCtx.leftBlkList, LEFT_BLK_ID, param->leftRows, param->leftKeys, param->leftKeyBase, param->blkRows);
+  hjtCreateBlkList(jtCtx.rightBlkList, RIGHT_BLK_ID, param->rightRows, param->rightKeys, param->rightKeyBase, param->blkRows);
+  jtCtx.leftBlkReadIdx = 0;
+  jtCtx.rightBlkReadIdx = 0;
+
+  SExecTaskInfo*      pTask = createDummyTaskInfo(caseName);
+  SHashJoinPhysiNode* pNode = hjtCreateHashJoinPhysiNode(param);
+  SOperatorInfo*      pDownstreams[2];
+  createDummyDownstreamOperators(2, pDownstreams);
+  SOperatorInfo* pJoinOp = createHashJoinOperatorInfo(pDownstreams, 2, pNode, pTask);
+  ASSERT_TRUE(NULL != pJoinOp);
+
+  SHashJoinSpillRes res = {0};
+  while (true) {
+    SSDataBlock* pBlock = pJoinOp->fpSet.getNextFn(pJoinOp);
+    if (NULL == pBlock) {
+      break;
+    }
+    hjtCheckResBlock(pBlock, &res);
+  }
+
+  void*    pExplain = NULL;
+  uint32_t len = 0;
+  ASSERT_EQ(pJoinOp->fpSet.getExplainFn(pJoinOp, &pExplain, &len), TSDB_CODE_SUCCESS);
+  ASSERT_EQ(len, sizeof(SHashJoinExecInfo));
+  memcpy(pExecInfo, pExplain, sizeof(*pExecInfo));
+  taosMemoryFree(pExplain);
+
+  SHashJoinSpillRes expected = {0};
+  hjtCalcExpectedRes(param, &expected);
+  ASSERT_EQ(res.rows, expected.rows);
+  ASSERT_EQ(res.leftValSum, expected.leftValSum);
+  ASSERT_EQ(res.rightValSum, expected.rightValSum);
+  ASSERT_EQ(res.leftNullRows, expected.leftNullRows);
+  ASSERT_EQ(res.rightNullRows, expected.rightNullRows);
+
+  destroyOperator(pJoinOp);
+  nodesDestroyNode((SNode*)pNode);
+  taosMemoryFree(pTask);
+  handleTestDone();
+  tsHashJoinBufSize = oldBufSize;
+}
+
 }  // namespace
 
 #if 1
@@ -3650,6 +3885,101 @@ TEST(leftWinJoin, noCondProjectionTest) {
 #endif
 
 
+#if 1
+TEST(hashJoinSpill, innerJoinTest) {
+  SHashJoinSpillParam param = {0};
+  SHashJoinExecInfo   execInfo = {0};
+  param.joinType = JOIN_TYPE_INNER;
+  param.leftRows = 20000;
+  param.leftKeys = 2000;
+  param.leftKeyBase = 0;
+  param.rightRows = 30000;
+  param.rightKeys = 3000;
+  param.rightKeyBase = 1000;
+  param.blkRows = 4096;
+  param.bufSizeMB = 1;
+
+  runHashJoinSpillTest("hashJoinSpill:innerJoinTest", &param, &execInfo);
+  ASSERT_EQ(execInfo.spilled, 1);
+  ASSERT_GT(execInfo.partitions, 0);
+  ASSERT_GE(execInfo.spillRows, param.leftRows + param.rightRows);
+}
+
+TEST(hashJoinSpill, leftOuterJoinTest) {
+  SHashJoinSpillParam param = {0};
+  SHashJoinExecInfo   execInfo = {0};
+  param.joinType = JOIN_TYPE_LEFT;
+  param.leftRows = 30000;
+  param.leftKeys = 3000;
+  param.leftKeyBase = 0;
+  param.rightRows = 20000;
+  param.rightKeys = 2000;
+  param.rightKeyBase = 1500;
+  param.blkRows = 4096;
+  param.bufSizeMB = 1;
+
+  runHashJoinSpillTest("hashJoinSpill:leftOuterJoinTest", &param, &execInfo);
+  ASSERT_EQ(execInfo.spilled, 1);
+  ASSERT_GT(execInfo.partitions, 0);
+}
+
+TEST(hashJoinSpill, rightOuterJoinTest) {
+  SHashJoinSpillParam param = {0};
+  SHashJoinExecInfo   execInfo = {0};
+  param.joinType = JOIN_TYPE_RIGHT;
+  param.leftRows = 20000;
+  param.leftKeys = 2000;
+  param.leftKeyBase = 1500;
+  param.rightRows = 30000;
+  param.rightKeys = 3000;
+  param.rightKeyBase = 0;
+  param.blkRows = 4096;
+  param.bufSizeMB = 1;
+
+  runHashJoinSpillTest("hashJoinSpill:rightOuterJoinTest", &param, &execInfo);
+  ASSERT_EQ(execInfo.spilled, 1);
+  ASSERT_GT(execInfo.partitions, 0);
+}
+
+// two build keys with 100k rows each, a partition never fits in the budget and is split up to the max level
+TEST(hashJoinSpill, leftOuterJoinRepartitionTest) {
+  SHashJoinSpillParam param = {0};
+  SHashJoinExecInfo   execInfo = {0};
+  param.joinType = JOIN_TYPE_LEFT;
+  param.leftRows = 1000;
+  param.leftKeys = 1000;
+  param.leftKeyBase = 0;
+  param.rightRows = 200000;
+  param.rightKeys = 2;
+  param.rightKeyBase = 0;
+  param.blkRows = 4096;
+  param.bufSizeMB = 1;
+
+  runHashJoinSpillTest("hashJoinSpill:leftOuterJoinRepartitionTest", &param, &execInfo);
+  ASSERT_EQ(execInfo.spilled, 1);
+  ASSERT_GT(execInfo.levels, 0);
+}
+
+TEST(hashJoinSpill, rightOuterJoinRepartitionTest) {
+  SHashJoinSpillParam param = {0};
+  SHashJoinExecInfo   execInfo = {0};
+  param.joinType = JOIN_TYPE_RIGHT;
+  param.leftRows = 200000;
+  param.leftKeys = 2;
+  param.leftKeyBase = 998;
+  param.rightRows = 1000;
+  param.rightKeys = 1000;
+  param.rightKeyBase = 0;
+  param.blkRows = 4096;
+  param.bufSizeMB = 1;
+
+  runHashJoinSpillTest("hashJoinSpill:rightOuterJoinRepartitionTest", &param, &execInfo);
+  ASSERT_EQ(execInfo.spilled, 1);
+  ASSERT_GT(execInfo.levels, 0);
+}
+#endif
+
+
 
 int main(int argc, char** argv) {
   taosSeedRand(taosGetTimestampSec());
@@ -14,9 +14,12 @@
  */
 
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <vector>
 #include <tglobal.h>
 #include <tsort.h>
-#include <iostream>
 
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wwrite-strings"
@@ -393,4 +396,214 @@ TEST(testCase, ordered_merge_sort_Test) {
 
 #endif
 
+namespace {
+typedef struct SSortTestRow {
+  bool        intNull;
+  int32_t     intVal;
+  int64_t     bigintVal;
+  std::string binaryVal;
+} SSortTestRow;
+
+typedef struct SSortTestSource {
+  const std::vector<SSortTestRow>* pRows;
+  int32_t                          offset;
+  int32_t                          blockRows;
+  SSDataBlock*                     pBlock;
+} SSortTestSource;
+
+#define SORT_TEST_INT_SLOT    0
+#define SORT_TEST_BIGINT_SLOT 1
+#define SORT_TEST_BINARY_SLOT 2
+#define SORT_TEST_BINARY_LEN  40
+
+SSDataBlock* sortTestCreateBlock() {
+  SSDataBlock*    pBlock = createDataBlock();
+  SColumnInfoData intCol = createColumnInfoData(TSDB_DATA_TYPE_INT, sizeof(int32_t), 1);
+  SColumnInfoData bigintCol = createColumnInfoData(TSDB_DATA_TYPE_BIGINT, sizeof(int64_t), 2);
+  SColumnInfoData binaryCol =
+      createColumnInfoData(TSDB_DATA_TYPE_BINARY, SORT_TEST_BINARY_LEN + VARSTR_HEADER_SIZE, 3);
+  blockDataAppendColInfo(pBlock, &intCol);
+  blockDataAppendColInfo(pBlock, &bigintCol);
+  blockDataAppendColInfo(pBlock, &binaryCol);
+  return pBlock;
+}
+
+// the binary values share a prefix longer than the normalized key prefix, so that equal keys fall back to the comparator
+std::vector<SSortTestRow> sortTestGenRows(int32_t numOfRows) {
+  std::vector<SSortTestRow> rows(numOfRows);
+  for (int32_t i = 0; i < numOfRows; ++i) {
+    SSortTestRow& row = rows[i];
+    row.intNull = (taosRand() % 7 == 0);
+    row.intVal = row.intNull ? 0 : (int32_t)(taosRand() % 2000) - 1000;
+    row.bigintVal = ((int64_t)taosRand() << 32) - (int64_t)taosRand();
+    row.binaryVal = "a_shared_binary_prefix_" + std::to_string(taosRand() % 5000);
+  }
+  return rows;
+}
+
+SSDataBlock* sortTestFetchBlock(void* param) {
+  SSortTestSource* pSource = (SSortTestSource*)param;
+  blockDataDestroy(pSource->pBlock);
+  pSource->pBlock = NULL;
+
+  int32_t numOfRows = TMIN(pSource->blockRows, (int32_t)pSource->pRows->size() - pSource->offset);
+  if (numOfRows <= 0) {
+    return NULL;
+  }
+
+  pSource->pBlock = sortTestCreateBlock();
+  blockDataEnsureCapacity(pSource->pBlock, numOfRows);
+
+  SColumnInfoData* pIntCol = (SColumnInfoData*)taosArrayGet(pSource->pBlock->pDataBlock, SORT_TEST_INT_SLOT);
+  SColumnInfoData* pBigintCol = (SColumnInfoData*)taosArrayGet(pSource->pBlock->pDataBlock, SORT_TEST_BIGINT_SLOT);
+  SColumnInfoData* pBinaryCol = (SColumnInfoData*)taosArrayGet(pSource->pBlock->pDataBlock, SORT_TEST_BINARY_SLOT);
+  for (int32_t i = 0; i < numOfRows; ++i) {
+    const SSortTestRow& row = (*pSource->pRows)[pSource->offset + i];
+    colDataSetVal(pIntCol, i, (const char*)&row.intVal, row.intNull);
+    colDataSetVal(pBigintCol, i, (const char*)&row.bigintVal, false);
+
+    char buf[SORT_TEST_BINARY_LEN + VARSTR_HEADER_SIZE] = {0};
+    memcpy(varDataVal(buf), row.binaryVal.c_str(), row.binaryVal.size());
+    varDataSetLen(buf, row.binaryVal.size());
+    colDataSetVal(pBinaryCol, i, buf, false);
+  }
+
+  pSource->pBlock->info.rows = numOfRows;
+  pSource->pBlock->info.hasVarCol = true;
+  pSource->offset += numOfRows;
+  return pSource->pBlock;
+}
+
+int32_t sortTestCompareRow(const SSortTestRow& l, const SSortTestRow& r, int32_t slotId, const SBlockOrderInfo& order) {
+  // the null order does not follow the order of the values
+  int32_t ret = 0;
+  if (slotId == SORT_TEST_INT_SLOT) {
+    if (l.intNull || r.intNull) {
+      if (l.intNull == r.intNull) return 0;
+      return (l.intNull == order.nullFirst) ? -1 : 1;
+    }
+    ret = (l.intVal < r.intVal) ? -1 : (l.intVal > r.intVal ? 1 : 0);
+  } else if (slotId == SORT_TEST_BIGINT_SLOT) {
+    ret = (l.bigintVal < r.bigintVal) ? -1 : (l.bigintVal > r.bigintVal ? 1 : 0);
+  } else {
+    ret = l.binaryVal.compare(r.binaryVal);
+    ret = (ret < 0) ? -1 : (ret > 0 ? 1 : 0);
+  }
+  return (order.order == TSDB_ORDER_DESC) ? -ret : ret;
+}
+
+/*
+ * Sort the rows with a sort buffer of a few pages, which flushes a run for every fetched block, and check the order
+ * keys of the output against std::stable_sort.
+ */
+void runSortTest(const std::vector<SBlockOrderInfo>& orders, int32_t numOfSortThreads) {
+  taosSeedRand(1000);
+  std::vector<SSortTestRow> rows = sortTestGenRows(20000);
+
+  taosGetDiskSize(tsTempDir, &tsTempSpace.size);
+  ASSERT_EQ(tsortInitRunPool(numOfSortThreads), TSDB_CODE_SUCCESS);
+
+  SArray* pOrderInfo = taosArrayInit(orders.size(), sizeof(SBlockOrderInfo));
+  for (size_t i = 0; i < orders.size(); ++i) {
+    taosArrayPush(pOrderInfo, &orders[i]);
+  }
+
+  SSDataBlock* pSchema = sortTestCreateBlock();
+  SSortHandle* pHandle =
+      tsortCreateSortHandle(pOrderInfo, SORT_SINGLESOURCE_SORT, 4096, 8, pSchema, "sort_test", 0, 0, 0);
+  tsortSetFetchRawDataFp(pHandle, sortTestFetchBlock, NULL, NULL);
+
+  SSortTestSource src = {0};
+  src.pRows = &rows;
+  src.blockRows = 500;
+
+  SSortSource* ps = (SSortSource*)taosMemoryCalloc(1, sizeof(SSortSource));
+  ps->param = &src;
+  ps->onlyRef = true;
+  tsortAddSource(pHandle, ps);
+
+  ASSERT_EQ(tsortOpen(pHandle), TSDB_CODE_SUCCESS);
+
+  std::vector<SSortTestRow> expect(rows);
+  std::stable_sort(expect.begin(), expect.end(), [&](const SSortTestRow& l, const SSortTestRow& r) {
+    for (size_t i = 0; i < orders.size(); ++i) {
+      int32_t ret = sortTestCompareRow(l, r, orders[i].slotId, orders[i]);
+      if (ret != 0) return ret < 0;
+    }
+    return false;
+  });
+
+  size_t numOfRows = 0;
+  while (1) {
+    STupleHandle* pTuple = tsortNextTuple(pHandle);
+    if (pTuple == NULL) {
+      break;
+    }
+    ASSERT_LT(numOfRows, expect.size());
+
+    SSortTestRow row;
+    row.intNull = tsortIsNullVal(pTuple, SORT_TEST_INT_SLOT);
+    row.intVal = row.intNull ? 0 : *(int32_t*)tsortGetValue(pTuple, SORT_TEST_INT_SLOT);
+    row.bigintVal = *(int64_t*)tsortGetValue(pTuple, SORT_TEST_BIGINT_SLOT);
+    char* pBinary = (char*)tsortGetValue(pTuple, SORT_TEST_BINARY_SLOT);
+    row.binaryVal = std::string(varDataVal(pBinary), varDataLen(pBinary));
+
+    for (size_t i = 0; i < orders.size(); ++i) {
+      ASSERT_EQ(sortTestCompareRow(row, expect[numOfRows], orders[i].slotId, orders[i]), 0)
+          << "row " << numOfRows << ", order " << i;
+    }
+    ++numOfRows;
+  }
+  ASSERT_EQ(numOfRows, expect.size());
+
+  SSortExecInfo info = tsortGetSortExecInfo(pHandle);
+  ASSERT_GT(info.writeBytes, 0);
+
+  tsortDestroySortHandle(pHandle);
+  taosMemoryFree(ps);
+  blockDataDestroy(pSchema);
+  taosArrayDestroy(pOrderInfo);
+  tsortCleanupRunPool();
+}
+
+SBlockOrderInfo sortTestOrder(int32_t slotId, int32_t order, bool nullFirst) {
+  SBlockOrderInfo oi = {0};
+  oi.slotId = slotId;
+  oi.order = order;
+  oi.nullFirst = nullFirst;
+  return oi;
+}
+}  // namespace
+
+TEST(sortTest, normKeyExactSerialTest) {
+  runSortTest({sortTestOrder(SORT_TEST_INT_SLOT, TSDB_ORDER_ASC, true),
+               sortTestOrder(SORT_TEST_BIGINT_SLOT, TSDB_ORDER_DESC, false)},
+              0);
+}
+
+TEST(sortTest, normKeyExactParallelTest) {
+  runSortTest({sortTestOrder(SORT_TEST_INT_SLOT, TSDB_ORDER_ASC, true),
+               sortTestOrder(SORT_TEST_BIGINT_SLOT, TSDB_ORDER_DESC, false)},
+              2);
+}
+
+TEST(sortTest, normKeyNullLastParallelTest) {
+  runSortTest({sortTestOrder(SORT_TEST_INT_SLOT, TSDB_ORDER_DESC, false),
+               sortTestOrder(SORT_TEST_BIGINT_SLOT, TSDB_ORDER_ASC, false)},
+              2);
+}
+
+TEST(sortTest, normKeyPrefixSerialTest) {
+  runSortTest({sortTestOrder(SORT_TEST_BINARY_SLOT, TSDB_ORDER_ASC, false),
+               sortTestOrder(SORT_TEST_BIGINT_SLOT, TSDB_ORDER_ASC, false)},
+              0);
+}
+
+TEST(sortTest, normKeyPrefixParallelTest) {
+  runSortTest({sortTestOrder(SORT_TEST_BINARY_SLOT, TSDB_ORDER_DESC, false),
+               sortTestOrder(SORT_TEST_INT_SLOT, TSDB_ORDER_ASC, false),
+               sortTestOrder(SORT_TEST_BIGINT_SLOT, TSDB_ORDER_ASC, false)},
+              4);
+}
+
 #pragma GCC diagnostic pop
@@ -75,6 +75,35 @@ int32_t tMemBucketPut(tMemBucket *pBucket, const void *data, size_t size);
 
 int32_t getPercentile(tMemBucket *pMemBucket, double percent, double *result);
 
+// up to this many values are selected in memory, more are put into a tMemBucket to be split by value range
+#define PERCENTILE_SELECT_MAX_ELEMS (4 * 1024 * 1024)
+
+// Values of an exact percentile buffered in one scan, in the column type. Pages spill to disk once the buffer grows
+// beyond its memory budget.
+typedef struct tPercentileBuf {
+  int16_t        type;
+  int32_t        bytes;
+  int32_t        elemPerPage;
+  int32_t        bufPageSize;
+  int64_t        total;
+  double         minVal;
+  double         maxVal;
+  SFilePage     *pCurPage;
+  SArray        *pageIdList;
+  SDiskbasedBuf *pBuffer;
+} tPercentileBuf;
+
+tPercentileBuf *tPercentileBufCreate(int32_t nElemSize, int16_t dataType);
+
+void tPercentileBufDestroy(tPercentileBuf *pBuf);
+
+int32_t tPercentileBufPut(tPercentileBuf *pBuf, const void *data);
+
+int32_t tPercentileBufGet(tPercentileBuf *pBuf, const double *percents, int32_t num, double *results);
+
+// quickselect: move the k-th smallest of the n values to a[k], with no larger value before it and no smaller one after
+double tPercentileSelect(double *a, int64_t n, int64_t k);
+
 #endif  // TDENGINE_TPERCENTILE_H
 
 #ifdef __cplusplus
@@ -87,12 +87,9 @@ typedef struct SLeastSQRInfo {
 } SLeastSQRInfo;
 
 typedef struct SPercentileInfo {
-  double      result;
-  tMemBucket* pMemBucket;
-  int32_t     stage;
-  double      minval;
-  double      maxval;
-  int64_t     numOfElems;
+  double          result;
+  tPercentileBuf* pBuf;
+  int64_t         numOfElems;
 } SPercentileInfo;
 
 typedef struct SAPercentileInfo {
@@ -1869,10 +1866,9 @@ bool percentileFunctionSetup(SqlFunctionCtx* pCtx, SResultRowEntryInfo* pResultI
     return false;
   }
 
-  // in the first round, get the min-max value of all involved data
+  // the values are buffered on the first non-null one, so that all null input costs no buffer
   SPercentileInfo* pInfo = GET_ROWCELL_INTERBUF(pResultInfo);
-  SET_DOUBLE_VAL(&pInfo->minval, DBL_MAX);
-  SET_DOUBLE_VAL(&pInfo->maxval, -DBL_MAX);
+  pInfo->pBuf = NULL;
   pInfo->numOfElems = 0;
 
   return true;
@@ -1883,91 +1879,36 @@ int32_t percentileFunction(SqlFunctionCtx* pCtx) {
   SResultRowEntryInfo* pResInfo = GET_RES_INFO(pCtx);
 
   SInputColumnInfoData* pInput = &pCtx->input;
-  SColumnDataAgg*       pAgg = pInput->pColumnDataAgg[0];
-
-  SColumnInfoData* pCol = pInput->pData[0];
-  int32_t          type = pCol->info.type;
+  SColumnInfoData*      pCol = pInput->pData[0];
+  int32_t               type = pCol->info.type;
 
   SPercentileInfo* pInfo = GET_ROWCELL_INTERBUF(pResInfo);
-  if (pCtx->scanFlag == MAIN_SCAN && pInfo->stage == 0) {
-    pInfo->stage += 1;
 
-    // all data are null, set it completed
-    if (pInfo->numOfElems == 0) {
-      pResInfo->complete = true;
-      return TSDB_CODE_SUCCESS;
-    } else {
-      pInfo->pMemBucket = tMemBucketCreate(pCol->info.bytes, type, pInfo->minval, pInfo->maxval);
+  int32_t start = pInput->startRowIndex;
+  for (int32_t i = start; i < pInput->numOfRows + start; ++i) {
+    if (colDataIsNull_f(pCol->nullbitmap, i)) {
+      continue;
     }
-  }
-
-  // the first stage, only acquire the min/max value
-  if (pInfo->stage == 0) {
-    if (pCtx->input.colDataSMAIsSet) {
-      double tmin = 0.0, tmax = 0.0;
-      if (IS_SIGNED_NUMERIC_TYPE(type)) {
-        tmin = (double)GET_INT64_VAL(&pAgg->min);
-        tmax = (double)GET_INT64_VAL(&pAgg->max);
-      } else if (IS_FLOAT_TYPE(type)) {
-        tmin = GET_DOUBLE_VAL(&pAgg->min);
-        tmax = GET_DOUBLE_VAL(&pAgg->max);
-      } else if (IS_UNSIGNED_NUMERIC_TYPE(type)) {
-        tmin = (double)GET_UINT64_VAL(&pAgg->min);
-        tmax = (double)GET_UINT64_VAL(&pAgg->max);
-      }
-
-      if (GET_DOUBLE_VAL(&pInfo->minval) > tmin) {
-        SET_DOUBLE_VAL(&pInfo->minval, tmin);
-      }
 
-      if (GET_DOUBLE_VAL(&pInfo->maxval) < tmax) {
-        SET_DOUBLE_VAL(&pInfo->maxval, tmax);
-      }
-
-      pInfo->numOfElems += (pInput->numOfRows - pAgg->numOfNull);
-    } else {
-      // check the valid data one by one
-      int32_t start = pInput->startRowIndex;
-      for (int32_t i = start; i < pInput->numOfRows + start; ++i) {
-        if (colDataIsNull_f(pCol->nullbitmap, i)) {
-          continue;
-        }
-
-        char* data = colDataGetData(pCol, i);
-
-        double v = 0;
-        GET_TYPED_DATA(v, double, type, data);
-        if (v < GET_DOUBLE_VAL(&pInfo->minval)) {
-          SET_DOUBLE_VAL(&pInfo->minval, v);
-        }
-
-        if (v > GET_DOUBLE_VAL(&pInfo->maxval)) {
-          SET_DOUBLE_VAL(&pInfo->maxval, v);
-        }
-
-        pInfo->numOfElems += 1;
+    if (pInfo->pBuf == NULL) {
+      pInfo->pBuf = tPercentileBufCreate(pCol->info.bytes, type);
+      if (pInfo->pBuf == NULL) {
+        return terrno;
       }
     }
-  } else {
-    // the second stage, calculate the true percentile value
-    int32_t start = pInput->startRowIndex;
-    for (int32_t i = start; i < pInput->numOfRows + start; ++i) {
-      if (colDataIsNull_f(pCol->nullbitmap, i)) {
-        continue;
-      }
 
-      char* data = colDataGetData(pCol, i);
-      numOfElems += 1;
-      int32_t code = tMemBucketPut(pInfo->pMemBucket, data, 1);
-      if (code != TSDB_CODE_SUCCESS) {
-        tMemBucketDestroy(pInfo->pMemBucket);
-        return code;
-      }
+    char*   data = colDataGetData(pCol, i);
+    int32_t code = tPercentileBufPut(pInfo->pBuf, data);
+    if (code != TSDB_CODE_SUCCESS) {
+      tPercentileBufDestroy(pInfo->pBuf);
+      pInfo->pBuf = NULL;
+      return code;
     }
-
-    SET_VAL(pResInfo, numOfElems, 1);
+    numOfElems += 1;
   }
 
+  pInfo->numOfElems += numOfElems;
+  SET_VAL(pResInfo, numOfElems, 1);
   return TSDB_CODE_SUCCESS;
 }
 
@@ -1976,29 +1917,34 @@ int32_t percentileFinalize(SqlFunctionCtx* pCtx, SSDataBlock* pBlock) {
   SPercentileInfo*     ppInfo = (SPercentileInfo*)GET_ROWCELL_INTERBUF(pResInfo);
 
   int32_t code = 0;
-  double  v = 0;
+  double  percents[10] = {0};
+  double  results[10] = {0};
+
+  tPercentileBuf* pBuf = ppInfo->pBuf;
+  ppInfo->pBuf = NULL;
+  if (pBuf != NULL && pBuf->total > 0) {  // check for null
+    int32_t num = pCtx->numOfParams - 1;
+    for (int32_t i = 0; i < num; ++i) {
+      SVariant* pVal = &pCtx->param[i + 1].param;
+      GET_TYPED_DATA(percents[i], double, pVal->nType, &pVal->i);
+    }
+
+    // all the requested percentiles are selected from the same buffered values
+    code = tPercentileBufGet(pBuf, percents, num, results);
+    if (code != TSDB_CODE_SUCCESS) {
+      goto _fin_error;
+    }
 
-  tMemBucket* pMemBucket = ppInfo->pMemBucket;
-  if (pMemBucket != NULL && pMemBucket->total > 0) {  // check for null
     if (pCtx->numOfParams > 2) {
       char   buf[512] = {0};
       size_t len = 1;
 
       varDataVal(buf)[0] = '[';
-      for (int32_t i = 1; i < pCtx->numOfParams; ++i) {
-        SVariant* pVal = &pCtx->param[i].param;
-
-        GET_TYPED_DATA(v, double, pVal->nType, &pVal->i);
-
-        code = getPercentile(pMemBucket, v, &ppInfo->result);
-        if (code != TSDB_CODE_SUCCESS) {
-          goto _fin_error;
-        }
-
-        if (i == pCtx->numOfParams - 1) {
-          len += snprintf(varDataVal(buf) + len, sizeof(buf) - VARSTR_HEADER_SIZE - len, "%.6lf]", ppInfo->result);
+      for (int32_t i = 0; i < num; ++i) {
+        if (i == num - 1) {
+          len += snprintf(varDataVal(buf) + len, sizeof(buf) - VARSTR_HEADER_SIZE - len, "%.6lf]", results[i]);
         } else {
-          len += snprintf(varDataVal(buf) + len, sizeof(buf) - VARSTR_HEADER_SIZE - len, "%.6lf, ", ppInfo->result);
+          len += snprintf(varDataVal(buf) + len, sizeof(buf) - VARSTR_HEADER_SIZE - len, "%.6lf, ", results[i]);
         }
       }
 
@@ -2008,26 +1954,19 @@ int32_t percentileFinalize(SqlFunctionCtx* pCtx, SSDataBlock* pBlock) {
       varDataSetLen(buf, len);
       colDataSetVal(pCol, pBlock->info.rows, buf, false);
 
-      tMemBucketDestroy(pMemBucket);
+      tPercentileBufDestroy(pBuf);
       return pResInfo->numOfRes;
     } else {
-      SVariant* pVal = &pCtx->param[1].param;
-
-      GET_TYPED_DATA(v, double, pVal->nType, &pVal->i);
-
-      code = getPercentile(pMemBucket, v, &ppInfo->result);
-      if (code != TSDB_CODE_SUCCESS) {
-        goto _fin_error;
-      }
+      ppInfo->result = results[0];
 
-      tMemBucketDestroy(pMemBucket);
+      tPercentileBufDestroy(pBuf);
       return functionFinalize(pCtx, pBlock);
     }
   }
 
 _fin_error:
 
-  tMemBucketDestroy(pMemBucket);
+  tPercentileBufDestroy(pBuf);
   return code;
 }
 
@@ -2349,6 +2288,16 @@ static int32_t comparePkDataWithSValue(int8_t pkType, char* pkData, SValue* pVal
   return fn(pkData, blockData);
 }
 
+// first/last of the primary timestamp is the key range of the block, which is kept in the block statistics
+EFuncDataRequired firstLastDataRequired(SFunctionNode* pFunc, STimeWindow* pTimeWindow) {
+  SNode* pParam = nodesListGetNode(pFunc->pParameterList, 0);
+  if (!pFunc->hasPk && LIST_LENGTH(pFunc->pParameterList) == 1 && QUERY_NODE_COLUMN == nodeType(pParam) &&
+      PRIMARYKEY_TIMESTAMP_COL_ID == ((SColumnNode*)pParam)->colId) {
+    return FUNC_DATA_REQUIRED_SMA_LOAD;
+  }
+  return FUNC_DATA_REQUIRED_DATA_LOAD;
+}
+
 EFuncDataRequired firstDynDataReq(void* pRes, SDataBlockInfo* pBlockInfo) {
   SResultRowEntryInfo* pEntry = (SResultRowEntryInfo*)pRes;
 
@@ -2493,6 +2442,19 @@ static int32_t doSaveCurrentVal(SqlFunctionCtx* pCtx, int32_t rowIndex, int64_t
   return TSDB_CODE_SUCCESS;
 }
 
+// Only the statistics of the block are loaded, which is the case for first(ts)/last(ts) when the whole block is
+// covered by current window. The timestamp agg holds the block key range, see tsdbRetrieveDatablockSMA2.
+static bool firstLastFromBlockSMA(SqlFunctionCtx* pCtx) {
+  SInputColumnInfoData* pInput = &pCtx->input;
+  if (!pInput->colDataSMAIsSet || pCtx->pSrcBlock == NULL || pCtx->pSrcBlock->info.dataLoad) {
+    return false;
+  }
+
+  SColumnDataAgg* pAgg = pInput->pColumnDataAgg[0];
+  return pAgg != NULL && pAgg->colId == PRIMARYKEY_TIMESTAMP_COL_ID && pInput->numOfRows == pInput->totalRows &&
+         pCtx->subsidiaries.num <= 0;
+}
+
 // This ordinary first function does not care if current scan is ascending order or descending order scan
 // the OPTIMIZED version of first function will only handle the ascending order scan
 int32_t firstFunction(SqlFunctionCtx* pCtx) {
@@ -2530,6 +2492,19 @@ int32_t firstFunction(SqlFunctionCtx* pCtx) {
     return TSDB_CODE_SUCCESS;
   }
 
+  if (firstLastFromBlockSMA(pCtx)) {
+    TSKEY cts = pInput->pColumnDataAgg[0]->min;
+    if (pResInfo->numOfRes == 0 || pInfo->ts > cts) {
+      int32_t code = doSaveCurrentVal(pCtx, pInput->startRowIndex, cts, NULL, pInputCol->info.type, (char*)&cts);
+      if (code != TSDB_CODE_SUCCESS) {
+        return code;
+      }
+      pResInfo->numOfRes = 1;
+    }
+    SET_VAL(pResInfo, 1, 1);
+    return TSDB_CODE_SUCCESS;
+  }
+
   SColumnDataAgg* pColAgg = (pInput->colDataSMAIsSet) ? pInput->pColumnDataAgg[0] : NULL;
 
   TSKEY startKey = getRowPTs(pInput->pPTS, 0);
@@ -2663,6 +2638,19 @@ int32_t lastFunction(SqlFunctionCtx* pCtx) {
     return TSDB_CODE_SUCCESS;
   }
 
+  if (firstLastFromBlockSMA(pCtx)) {
+    TSKEY cts = pInput->pColumnDataAgg[0]->max;
+    if (pResInfo->numOfRes == 0 || pInfo->ts < cts) {
+      int32_t code = doSaveCurrentVal(pCtx, pInput->startRowIndex, cts, NULL, pInputCol->info.type, (char*)&cts);
+      if (code != TSDB_CODE_SUCCESS) {
+        return code;
+      }
+      pResInfo->numOfRes = 1;
+    }
+    SET_VAL(pResInfo, 1, 1);
+    return TSDB_CODE_SUCCESS;
+  }
+
   SColumnDataAgg* pColAgg = (pInput->colDataSMAIsSet) ? pInput->pColumnDataAgg[0] : NULL;
 
   TSKEY startKey = getRowPTs(pInput->pPTS, 0);
@@ -285,7 +285,8 @@ tMemBucket *tMemBucketCreate(int32_t nElemSize, int16_t dataType, double minval,
     return NULL;
   }
 
-  int32_t ret = createDiskbasedBuf(&pBucket->pBuffer, pBucket->bufPageSize, pBucket->bufPageSize * 1024, "1", tsTempDir);
+  int32_t ret = createDiskbasedBuf(&pBucket->pBuffer, pBucket->bufPageSize, pBucket->bufPageSize * 1024, "1", tsTempDir,
+                                   DBUF_COMPRESS_NONE);
   if (ret != 0) {
     tMemBucketDestroy(pBucket);
     return NULL;
@@ -606,3 +607,239 @@ bool isIdenticalData(tMemBucket *pMemBucket, int32_t index) {
     return pSeg->range.dMinVal == pSeg->range.dMaxVal;
   }
 }
+
+////////////////////////////////////////////////////////////////////////////////////////////
+tPercentileBuf *tPercentileBufCreate(int32_t nElemSize, int16_t dataType) {
+  tPercentileBuf *pBuf = (tPercentileBuf *)taosMemoryCalloc(1, sizeof(tPercentileBuf));
+  if (pBuf == NULL) {
+    terrno = TSDB_CODE_OUT_OF_MEMORY;
+    return NULL;
+  }
+
+  pBuf->type = dataType;
+  pBuf->bytes = nElemSize;
+  pBuf->bufPageSize = 16384 * 4;  // 64k per page
+  pBuf->elemPerPage = (pBuf->bufPageSize - sizeof(SFilePage)) / pBuf->bytes;
+  pBuf->minVal = DBL_MAX;
+  pBuf->maxVal = -DBL_MAX;
+
+  pBuf->pageIdList = taosArrayInit(4, sizeof(int32_t));
+  if (pBuf->pageIdList == NULL) {
+    tPercentileBufDestroy(pBuf);
+    return NULL;
+  }
+
+  if (!osTempSpaceAvailable()) {
+    terrno = TSDB_CODE_NO_DISKSPACE;
+    tPercentileBufDestroy(pBuf);
+    return NULL;
+  }
+
+  int32_t ret = createDiskbasedBuf(&pBuf->pBuffer, pBuf->bufPageSize, pBuf->bufPageSize * 1024, "1", tsTempDir,
+                                   DBUF_COMPRESS_NONE);
+  if (ret != 0) {
+    tPercentileBufDestroy(pBuf);
+    return NULL;
+  }
+
+  return pBuf;
+}
+
+void tPercentileBufDestroy(tPercentileBuf *pBuf) {
+  if (pBuf == NULL) {
+    return;
+  }
+
+  destroyDiskbasedBuf(pBuf->pBuffer);
+  taosArrayDestroy(pBuf->pageIdList);
+  taosMemoryFreeClear(pBuf);
+}
+
+int32_t tPercentileBufPut(tPercentileBuf *pBuf, const void *data) {
+  if (pBuf->pCurPage == NULL || pBuf->pCurPage->num >= pBuf->elemPerPage) {
+    if (pBuf->pCurPage != NULL) {
+      setBufPageDirty(pBuf->pCurPage, true);
+      releaseBufPage(pBuf->pBuffer, pBuf->pCurPage);
+      pBuf->pCurPage = NULL;
+    }
+
+    int32_t pageId = -1;
+    pBuf->pCurPage = getNewBufPage(pBuf->pBuffer, &pageId);
+    if (pBuf->pCurPage == NULL) {
+      return terrno;
+    }
+    pBuf->pCurPage->num = 0;
+    if (taosArrayPush(pBuf->pageIdList, &pageId) == NULL) {
+      return TSDB_CODE_OUT_OF_MEMORY;
+    }
+  }
+
+  memcpy(pBuf->pCurPage->data + pBuf->pCurPage->num * pBuf->bytes, data, pBuf->bytes);
+  pBuf->pCurPage->num += 1;
+  pBuf->total += 1;
+
+  double v = 0;
+  GET_TYPED_DATA(v, double, pBuf->type, data);
+  if (v < pBuf->minVal) {
+    pBuf->minVal = v;
+  }
+  if (v > pBuf->maxVal) {
+    pBuf->maxVal = v;
+  }
+
+  return TSDB_CODE_SUCCESS;
+}
+
+static void tPercentileBufUnpinCurPage(tPercentileBuf *pBuf) {
+  if (pBuf->pCurPage != NULL) {
+    setBufPageDirty(pBuf->pCurPage, true);
+    releaseBufPage(pBuf->pBuffer, pBuf->pCurPage);
+    pBuf->pCurPage = NULL;
+  }
+}
+
+double tPercentileSelect(double *a, int64_t n, int64_t k) {
+  int64_t lo = 0, hi = n - 1;
+  while (lo < hi) {
+    double  pivot = a[lo + (hi - lo) / 2];
+    int64_t i = lo, j = hi;
+    while (i <= j) {
+      while (a[i] < pivot) i++;
+      while (a[j] > pivot) j--;
+      if (i <= j) {
+        double t = a[i];
+        a[i++] = a[j];
+        a[j--] = t;
+      }
+    }
+
+    if (k <= j) {
+      hi = j;
+    } else if (k >= i) {
+      lo = i;
+    } else {
+      break;
+    }
+  }
+
+  return a[k];
+}
+
+static int32_t tPercentileBufSelect(tPercentileBuf *pBuf, const double *percents, int32_t num, double *results) {
+  double *a = taosMemoryMalloc(pBuf->total * sizeof(double));
+  if (a == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  int64_t n = 0;
+  for (int32_t i = 0; i < taosArrayGetSize(pBuf->pageIdList); ++i) {
+    int32_t   *pageId = taosArrayGet(pBuf->pageIdList, i);
+    SFilePage *pg = getBufPage(pBuf->pBuffer, *pageId);
+    if (pg == NULL) {
+      taosMemoryFree(a);
+      return terrno;
+    }
+
+    for (int32_t j = 0; j < pg->num; ++j) {
+      GET_TYPED_DATA(a[n], double, pBuf->type, pg->data + j * pBuf->bytes);
+      n++;
+    }
+    releaseBufPage(pBuf->pBuffer, pg);
+  }
+
+  // select in ascending order of the rank, each search only needs the values above the previous rank
+  int32_t *order = taosMemoryMalloc(num * sizeof(int32_t));
+  if (order == NULL) {
+    taosMemoryFree(a);
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+  for (int32_t i = 0; i < num; ++i) {
+    int32_t j = i;
+    for (; j > 0 && percents[order[j - 1]] > percents[i]; --j) {
+      order[j] = order[j - 1];
+    }
+    order[j] = i;
+  }
+
+  int64_t lo = 0;
+  for (int32_t i = 0; i < num; ++i) {
+    double  percent = percents[order[i]];
+    double *result = &results[order[i]];
+
+    if (percent < DBL_EPSILON) {
+      *result = pBuf->minVal;
+      continue;
+    } else if (fabs(percent - 100.0) < DBL_EPSILON) {
+      *result = pBuf->maxVal;
+      continue;
+    }
+
+    double  percentVal = (percent * (n - 1)) / ((double)100.0);
+    int64_t k = (int64_t)percentVal;
+    double  fraction = percentVal - k;
+
+    double td = tPercentileSelect(a + lo, n - lo, k - lo);
+    double nd = td;
+    for (int64_t j = k + 1; j < n; ++j) {
+      if (j == k + 1 || a[j] < nd) nd = a[j];
+    }
+
+    *result = (1 - fraction) * td + fraction * nd;
+    lo = k;
+  }
+
+  taosMemoryFree(order);
+  taosMemoryFree(a);
+  return TSDB_CODE_SUCCESS;
+}
+
+static int32_t tPercentileBufBucket(tPercentileBuf *pBuf, const double *percents, int32_t num, double *results) {
+  tMemBucket *pBucket = tMemBucketCreate(pBuf->bytes, pBuf->type, pBuf->minVal, pBuf->maxVal);
+  if (pBucket == NULL) {
+    return terrno ? terrno : TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  int32_t code = TSDB_CODE_SUCCESS;
+  for (int32_t i = 0; i < taosArrayGetSize(pBuf->pageIdList); ++i) {
+    int32_t   *pageId = taosArrayGet(pBuf->pageIdList, i);
+    SFilePage *pg = getBufPage(pBuf->pBuffer, *pageId);
+    if (pg == NULL) {
+      code = terrno;
+      goto _end;
+    }
+
+    code = tMemBucketPut(pBucket, pg->data, pg->num);
+    releaseBufPage(pBuf->pBuffer, pg);
+    if (code != TSDB_CODE_SUCCESS) {
+      goto _end;
+    }
+  }
+
+  for (int32_t i = 0; i < num; ++i) {
+    code = getPercentile(pBucket, percents[i], &results[i]);
+    if (code != TSDB_CODE_SUCCESS) {
+      goto _end;
+    }
+  }
+
+_end:
+  tMemBucketDestroy(pBucket);
+  return code;
+}
+
+int32_t tPercentileBufGet(tPercentileBuf *pBuf, const double *percents, int32_t num, double *results) {
+  tPercentileBufUnpinCurPage(pBuf);
+
+  if (pBuf->total == 0) {
+    for (int32_t i = 0; i < num; ++i) {
+      results[i] = 0.0;
+    }
+    return TSDB_CODE_SUCCESS;
+  }
+
+  if (pBuf->total <= PERCENTILE_SELECT_MAX_ELEMS) {
+    return tPercentileBufSelect(pBuf, percents, num, results);
+  } else {
+    return tPercentileBufBucket(pBuf, percents, num, results);
+  }
+}
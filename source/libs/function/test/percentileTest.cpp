@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "tdatablock.h"
+#include "tpercentile.h"
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wwrite-strings"
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#pragma GCC diagnostic ignored "-Wsign-compare"
+
+namespace {
+
+// the exact percentile of getPercentile: interpolated between the two values around the rank
+double expectedPercentile(std::vector<double> values, double percent) {
+  std::sort(values.begin(), values.end());
+  double  percentVal = percent * (values.size() - 1) / 100.0;
+  int64_t k = (int64_t)percentVal;
+  if (k + 1 >= (int64_t)values.size()) return values.back();
+  double fraction = percentVal - k;
+  return (1 - fraction) * values[k] + fraction * values[k + 1];
+}
+
+void checkSelect(std::vector<double> values, int64_t k) {
+  std::vector<double> sorted = values;
+  std::sort(sorted.begin(), sorted.end());
+
+  double v = tPercentileSelect(values.data(), values.size(), k);
+  ASSERT_EQ(v, sorted[k]) << "k " << k;
+  ASSERT_EQ(values[k], sorted[k]) << "k " << k;
+  for (int64_t i = 0; i < k; i++) {
+    ASSERT_LE(values[i], v) << "k " << k << " i " << i;
+  }
+  for (int64_t i = k + 1; i < values.size(); i++) {
+    ASSERT_GE(values[i], v) << "k " << k << " i " << i;
+  }
+}
+
+// the values are buffered in pages that spill to the temp dir
+class PercentileBufTest : public ::testing::Test {
+ protected:
+  static void SetUpTestSuite() {
+    strcpy(tsTempDir, TD_TMP_DIR_PATH);
+    taosGetDiskSize(tsTempDir, &tsTempSpace.size);
+  }
+};
+
+}  // namespace
+
+TEST(PercentileTest, selectOfRandomValues) {
+  std::mt19937                     gen(1);
+  std::uniform_real_distribution<> dist(-1000.0, 1000.0);
+  for (int32_t n : {1, 2, 3, 10, 1000}) {
+    std::vector<double> values(n);
+    for (double &v : values) v = dist(gen);
+    for (int64_t k : {(int64_t)0, (int64_t)n / 3, (int64_t)n / 2, (int64_t)n - 1}) {
+      checkSelect(values, k);
+    }
+  }
+}
+
+TEST(PercentileTest, selectOfDuplicatedAndSortedValues) {
+  std::vector<double> same(100, 7.0);
+  checkSelect(same, 0);
+  checkSelect(same, 50);
+  checkSelect(same, 99);
+
+  std::vector<double> fewDistinct;
+  for (int32_t i = 0; i < 1000; i++) fewDistinct.push_back(i % 3);
+  checkSelect(fewDistinct, 332);
+  checkSelect(fewDistinct, 333);
+  checkSelect(fewDistinct, 999);
+
+  std::vector<double> ascending, descending;
+  for (int32_t i = 0; i < 1000; i++) {
+    ascending.push_back(i);
+    descending.push_back(1000 - i);
+  }
+  checkSelect(ascending, 0);
+  checkSelect(ascending, 617);
+  checkSelect(descending, 617);
+  checkSelect(descending, 999);
+}
+
+TEST_F(PercentileBufTest, bufGetFromSelect) {
+  tPercentileBuf *pBuf = tPercentileBufCreate(sizeof(int32_t), TSDB_DATA_TYPE_INT);
+  ASSERT_NE(pBuf, nullptr);
+
+  // spans several pages, with duplicates and negatives
+  std::mt19937        gen(2);
+  std::vector<double> values;
+  for (int32_t i = 0; i < 100000; i++) {
+    int32_t v = (int32_t)(gen() % 20000) - 10000;
+    ASSERT_EQ(tPercentileBufPut(pBuf, &v), TSDB_CODE_SUCCESS);
+    values.push_back(v);
+  }
+
+  // requested out of order and repeated, the results keep the order of the request
+  double percents[] = {90, 0, 50, 33.3, 50, 100, 99.9, 0.1};
+  double results[8] = {0};
+  ASSERT_EQ(tPercentileBufGet(pBuf, percents, 8, results), TSDB_CODE_SUCCESS);
+  for (int32_t i = 0; i < 8; i++) {
+    ASSERT_NEAR(results[i], expectedPercentile(values, percents[i]), 1e-6) << "percent " << percents[i];
+  }
+
+  tPercentileBufDestroy(pBuf);
+}
+
+TEST_F(PercentileBufTest, bufGetOfEmptyAndSingleValue) {
+  tPercentileBuf *pBuf = tPercentileBufCreate(sizeof(double), TSDB_DATA_TYPE_DOUBLE);
+  ASSERT_NE(pBuf, nullptr);
+
+  double percents[] = {0, 50, 100};
+  double results[3] = {-1, -1, -1};
+  ASSERT_EQ(tPercentileBufGet(pBuf, percents, 3, results), TSDB_CODE_SUCCESS);
+  ASSERT_EQ(results[0], 0.0);
+  ASSERT_EQ(results[1], 0.0);
+  ASSERT_EQ(results[2], 0.0);
+  tPercentileBufDestroy(pBuf);
+
+  pBuf = tPercentileBufCreate(sizeof(double), TSDB_DATA_TYPE_DOUBLE);
+  ASSERT_NE(pBuf, nullptr);
+  double v = 3.5;
+  ASSERT_EQ(tPercentileBufPut(pBuf, &v), TSDB_CODE_SUCCESS);
+  ASSERT_EQ(tPercentileBufGet(pBuf, percents, 3, results), TSDB_CODE_SUCCESS);
+  ASSERT_EQ(results[0], 3.5);
+  ASSERT_EQ(results[1], 3.5);
+  ASSERT_EQ(results[2], 3.5);
+  tPercentileBufDestroy(pBuf);
+}
+
+TEST_F(PercentileBufTest, bufGetFromBucketBeyondSelectLimit) {
+  tPercentileBuf *pBuf = tPercentileBufCreate(sizeof(int64_t), TSDB_DATA_TYPE_BIGINT);
+  ASSERT_NE(pBuf, nullptr);
+
+  // a permutation of 0 .. n - 1, so the percentile is known without sorting
+  const int64_t n = PERCENTILE_SELECT_MAX_ELEMS + 1000;
+  const int64_t step = 7919;  // a prime that does not divide n
+  ASSERT_NE(n % step, 0);
+  for (int64_t i = 0; i < n; i++) {
+    int64_t v = (i * step) % n;
+    ASSERT_EQ(tPercentileBufPut(pBuf, &v), TSDB_CODE_SUCCESS);
+  }
+  ASSERT_EQ(pBuf->total, n);
+
+  double percents[] = {0, 25, 50, 99.5, 100};
+  double results[5] = {0};
+  ASSERT_EQ(tPercentileBufGet(pBuf, percents, 5, results), TSDB_CODE_SUCCESS);
+  for (int32_t i = 0; i < 5; i++) {
+    ASSERT_NEAR(results[i], percents[i] * (n - 1) / 100.0, 1e-6) << "percent " << percents[i];
+  }
+
+  tPercentileBufDestroy(pBuf);
+}
+
+#pragma GCC diagnostic pop
@@ -37,6 +37,12 @@ TEST_F(PlanOptimizeTest, scanPath) {
       "FILL(LINEAR)");
 
   run("SELECT COUNT(TBNAME) FROM t1");
+
+  run("SELECT FIRST(ts), LAST(ts) FROM t1");
+
+  run("SELECT FIRST(ts), LAST(ts), COUNT(*) FROM st1 INTERVAL(10S)");
+
+  run("SELECT FIRST(ts), LAST(c1) FROM t1");
 }
 
 TEST_F(PlanOptimizeTest, pushDownCondition) {
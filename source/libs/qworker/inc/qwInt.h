@@ -121,6 +121,7 @@ typedef struct SQWTaskCtx {
   int8_t   needFetch;
   int8_t   localExec;
   int8_t   dynamicTask;
+  int8_t   compressRes;  // compress the result blocks for the fetcher
   int32_t  queryMsgType;
   int32_t  fetchMsgType;
   int32_t  level;
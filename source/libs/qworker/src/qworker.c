@@ -345,17 +345,22 @@ int32_t qwGetQueryResFromSink(QW_FPARAMS_DEF, SQWTaskCtx *ctx, int32_t *dataLen,
     QW_ERR_RET(qwMallocFetchRsp(!ctx->localExec, *dataLen, &rsp));
 
     output.pData = rsp->data + *dataLen - len;
+    output.dataLen = len;
+    output.compressReq = ctx->compressRes;
     code = dsGetDataBlock(ctx->sinkHandle, &output);
     if (code) {
       QW_TASK_ELOG("dsGetDataBlock failed, code:%x - %s", code, tstrerror(code));
       QW_ERR_RET(code);
     }
 
+    // the block may get smaller after compressed
+    *dataLen -= len - output.dataLen;
+
     pOutput->queryEnd = output.queryEnd;
     pOutput->precision = output.precision;
     pOutput->bufStatus = output.bufStatus;
     pOutput->useconds = output.useconds;
-    pOutput->compressed = output.compressed;
+    pOutput->compressed = pOutput->compressed || output.compressed;
     pOutput->numOfCols = output.numOfCols;
     pOutput->numOfRows += output.numOfRows;
     pOutput->numOfBlocks++;
@@ -885,6 +890,7 @@ int32_t qwProcessFetch(QW_FPARAMS_DEF, SQWMsg *qwMsg) {
 
   ctx->fetchMsgType = qwMsg->msgType;
   ctx->dataConnInfo = qwMsg->connInfo;
+  ctx->compressRes = qwMsg->msgInfo.compressRes;
 
   if (qwMsg->msg) {
     code = qwStartDynamicTaskNewExec(QW_FPARAMS(), ctx, qwMsg);
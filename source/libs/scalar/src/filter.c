@@ -21,6 +21,7 @@
 #include "filterInt.h"
 #include "functionMgt.h"
 #include "sclInt.h"
+#include "tbloomfilter.h"
 #include "tcompare.h"
 #include "tdatablock.h"
 #include "tsimplehash.h"
@@ -3246,6 +3247,313 @@ bool filterExecuteImplMisc(void *pinfo, int32_t numOfRows, SColumnInfoData *pRes
   return all;
 }
 
+/*
+ * Vectorized kernels for the filters on one numeric column compared with constants, e.g. "c between 200 and 240".
+ * The column buffer is compared as a whole, branch free, into the one byte per row result, then the null rows are
+ * cleared according to the null bitmap. Float and double follow the tolerance and NaN ordering of compareFloatVal.
+ */
+typedef struct SFltVecCond {
+  uint8_t     lowerOptr;  // OP_TYPE_GREATER_THAN or OP_TYPE_GREATER_EQUAL, 0 if there is no lower bound
+  uint8_t     upperOptr;  // OP_TYPE_LOWER_THAN or OP_TYPE_LOWER_EQUAL, 0 if there is no upper bound
+  bool        negate;
+  const void *lower;
+  const void *upper;
+} SFltVecCond;
+
+typedef void (*fltVecFn)(const void *pData, int32_t numOfRows, const SFltVecCond *pCond, int8_t *p);
+
+// spread the lowest 4 bits of the mask into 4 bytes of 0/1, no carry happens since the shifted copies never overlap
+static FORCE_INLINE void fltVecMask4ToBytes(int8_t *p, uint32_t m) {
+  uint32_t v = ((m & 0xFu) * 0x00204081u) & 0x01010101u;
+  memcpy(p, &v, sizeof(v));
+}
+
+static int32_t fltVecRangeInt32AVX2(const int32_t *v, int32_t numOfRows, int32_t lower, int32_t upper, int8_t *p) {
+  int32_t i = 0;
+#if __AVX2__
+  __m256i lo = _mm256_set1_epi32(lower);
+  __m256i hi = _mm256_set1_epi32(upper);
+  for (; i + 8 <= numOfRows; i += 8) {
+    __m256i  data = _mm256_loadu_si256((const __m256i *)(v + i));
+    __m256i  out = _mm256_or_si256(_mm256_cmpgt_epi32(lo, data), _mm256_cmpgt_epi32(data, hi));
+    uint32_t m = ~(uint32_t)_mm256_movemask_ps(_mm256_castsi256_ps(out));
+    fltVecMask4ToBytes(p + i, m);
+    fltVecMask4ToBytes(p + i + 4, m >> 4);
+  }
+#endif
+  return i;
+}
+
+static int32_t fltVecRangeInt64AVX2(const int64_t *v, int32_t numOfRows, int64_t lower, int64_t upper, int8_t *p) {
+  int32_t i = 0;
+#if __AVX2__
+  __m256i lo = _mm256_set1_epi64x(lower);
+  __m256i hi = _mm256_set1_epi64x(upper);
+  for (; i + 4 <= numOfRows; i += 4) {
+    __m256i  data = _mm256_loadu_si256((const __m256i *)(v + i));
+    __m256i  out = _mm256_or_si256(_mm256_cmpgt_epi64(lo, data), _mm256_cmpgt_epi64(data, hi));
+    uint32_t m = ~(uint32_t)_mm256_movemask_pd(_mm256_castsi256_pd(out));
+    fltVecMask4ToBytes(p + i, m);
+  }
+#endif
+  return i;
+}
+
+// exclusive bounds of the integers are turned into inclusive ones, so that one loop serves all the shapes
+#define FLT_DEFINE_VEC_INT_FN(_name, _type, _min, _max, _simdFn)                                         \
+  static void _name(const void *pData, int32_t numOfRows, const SFltVecCond *pCond, int8_t *p) {        \
+    const _type *v = (const _type *)pData;                                                               \
+    _type        lower = (_min), upper = (_max);                                                         \
+    if (pCond->lowerOptr) {                                                                              \
+      lower = *(const _type *)pCond->lower;                                                              \
+      if (pCond->lowerOptr == OP_TYPE_GREATER_THAN) {                                                    \
+        if (lower == (_max)) {                                                                           \
+          memset(p, 0, numOfRows);                                                                       \
+          return;                                                                                        \
+        }                                                                                                \
+        lower += 1;                                                                                      \
+      }                                                                                                  \
+    }                                                                                                    \
+    if (pCond->upperOptr) {                                                                              \
+      upper = *(const _type *)pCond->upper;                                                              \
+      if (pCond->upperOptr == OP_TYPE_LOWER_THAN) {                                                      \
+        if (upper == (_min)) {                                                                           \
+          memset(p, 0, numOfRows);                                                                       \
+          return;                                                                                        \
+        }                                                                                                \
+        upper -= 1;                                                                                      \
+      }                                                                                                  \
+    }                                                                                                    \
+    int32_t i = 0;                                                                                       \
+    if (tsSIMDEnable && tsAVX2Enable) {                                                                  \
+      i = _simdFn;                                                                                       \
+    }                                                                                                    \
+    for (; i < numOfRows; ++i) {                                                                         \
+      p[i] = (v[i] >= lower) & (v[i] <= upper);                                                          \
+    }                                                                                                    \
+  }
+
+FLT_DEFINE_VEC_INT_FN(fltVecInt8, int8_t, INT8_MIN, INT8_MAX, 0)
+FLT_DEFINE_VEC_INT_FN(fltVecInt16, int16_t, INT16_MIN, INT16_MAX, 0)
+FLT_DEFINE_VEC_INT_FN(fltVecInt32, int32_t, INT32_MIN, INT32_MAX, fltVecRangeInt32AVX2(v, numOfRows, lower, upper, p))
+FLT_DEFINE_VEC_INT_FN(fltVecInt64, int64_t, INT64_MIN, INT64_MAX, fltVecRangeInt64AVX2(v, numOfRows, lower, upper, p))
+FLT_DEFINE_VEC_INT_FN(fltVecUint8, uint8_t, 0, UINT8_MAX, 0)
+FLT_DEFINE_VEC_INT_FN(fltVecUint16, uint16_t, 0, UINT16_MAX, 0)
+FLT_DEFINE_VEC_INT_FN(fltVecUint32, uint32_t, 0, UINT32_MAX, 0)
+FLT_DEFINE_VEC_INT_FN(fltVecUint64, uint64_t, 0, UINT64_MAX, 0)
+
+/*
+ * With d = v - bound, compareFloatVal(v, bound) is 0 if |d| <= tol, 1 if d > tol, otherwise -1, including the NaN v and
+ * inf - inf. So "v > lower" is d > tol, "v >= lower" is d >= -tol, "v < upper" is !(d >= -tol), "v <= upper" is
+ * !(d > tol), which the unordered compare of AVX2 gives for free.
+ */
+static int32_t fltVecRangeFloatAVX2(const float *v, int32_t numOfRows, const SFltVecCond *pCond, int8_t *p) {
+  int32_t i = 0;
+#if __AVX2__
+  const float tol = FLT_COMPAR_TOL_FACTOR * FLT_EPSILON;
+  __m256      lo = _mm256_set1_ps(pCond->lowerOptr ? *(const float *)pCond->lower : 0);
+  __m256      hi = _mm256_set1_ps(pCond->upperOptr ? *(const float *)pCond->upper : 0);
+  __m256      loTol = _mm256_set1_ps(pCond->lowerOptr == OP_TYPE_GREATER_THAN ? tol : -tol);
+  __m256      hiTol = _mm256_set1_ps(pCond->upperOptr == OP_TYPE_LOWER_THAN ? -tol : tol);
+  __m256      all = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+  for (; i + 8 <= numOfRows; i += 8) {
+    __m256 data = _mm256_loadu_ps(v + i);
+    __m256 out = all;
+    if (pCond->lowerOptr == OP_TYPE_GREATER_THAN) {
+      out = _mm256_cmp_ps(_mm256_sub_ps(data, lo), loTol, _CMP_GT_OQ);
+    } else if (pCond->lowerOptr) {
+      out = _mm256_cmp_ps(_mm256_sub_ps(data, lo), loTol, _CMP_GE_OQ);
+    }
+    if (pCond->upperOptr == OP_TYPE_LOWER_THAN) {
+      out = _mm256_and_ps(out, _mm256_cmp_ps(_mm256_sub_ps(data, hi), hiTol, _CMP_NGE_UQ));
+    } else if (pCond->upperOptr) {
+      out = _mm256_and_ps(out, _mm256_cmp_ps(_mm256_sub_ps(data, hi), hiTol, _CMP_NGT_UQ));
+    }
+    uint32_t m = (uint32_t)_mm256_movemask_ps(out);
+    fltVecMask4ToBytes(p + i, m);
+    fltVecMask4ToBytes(p + i + 4, m >> 4);
+  }
+#endif
+  return i;
+}
+
+static int32_t fltVecRangeDoubleAVX2(const double *v, int32_t numOfRows, const SFltVecCond *pCond, int8_t *p) {
+  int32_t i = 0;
+#if __AVX2__
+  const double tol = FLT_COMPAR_TOL_FACTOR * FLT_EPSILON;
+  __m256d      lo = _mm256_set1_pd(pCond->lowerOptr ? *(const double *)pCond->lower : 0);
+  __m256d      hi = _mm256_set1_pd(pCond->upperOptr ? *(const double *)pCond->upper : 0);
+  __m256d      loTol = _mm256_set1_pd(pCond->lowerOptr == OP_TYPE_GREATER_THAN ? tol : -tol);
+  __m256d      hiTol = _mm256_set1_pd(pCond->upperOptr == OP_TYPE_LOWER_THAN ? -tol : tol);
+  __m256d      all = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+  for (; i + 4 <= numOfRows; i += 4) {
+    __m256d data = _mm256_loadu_pd(v + i);
+    __m256d out = all;
+    if (pCond->lowerOptr == OP_TYPE_GREATER_THAN) {
+      out = _mm256_cmp_pd(_mm256_sub_pd(data, lo), loTol, _CMP_GT_OQ);
+    } else if (pCond->lowerOptr) {
+      out = _mm256_cmp_pd(_mm256_sub_pd(data, lo), loTol, _CMP_GE_OQ);
+    }
+    if (pCond->upperOptr == OP_TYPE_LOWER_THAN) {
+      out = _mm256_and_pd(out, _mm256_cmp_pd(_mm256_sub_pd(data, hi), hiTol, _CMP_NGE_UQ));
+    } else if (pCond->upperOptr) {
+      out = _mm256_and_pd(out, _mm256_cmp_pd(_mm256_sub_pd(data, hi), hiTol, _CMP_NGT_UQ));
+    }
+    fltVecMask4ToBytes(p + i, (uint32_t)_mm256_movemask_pd(out));
+  }
+#endif
+  return i;
+}
+
+#define FLT_DEFINE_VEC_FLOAT_FN(_name, _type, _simdFn)                                              \
+  static void _name(const void *pData, int32_t numOfRows, const SFltVecCond *pCond, int8_t *p) {   \
+    const _type *v = (const _type *)pData;                                                          \
+    const _type  tol = FLT_COMPAR_TOL_FACTOR * FLT_EPSILON;                                         \
+    _type        lower = pCond->lowerOptr ? *(const _type *)pCond->lower : 0;                       \
+    _type        upper = pCond->upperOptr ? *(const _type *)pCond->upper : 0;                       \
+    _type        loTol = (pCond->lowerOptr == OP_TYPE_GREATER_THAN) ? tol : -tol;                   \
+    _type        hiTol = (pCond->upperOptr == OP_TYPE_LOWER_THAN) ? -tol : tol;                     \
+    int32_t      i = 0;                                                                             \
+    if (tsSIMDEnable && tsAVX2Enable) {                                                             \
+      i = _simdFn(v, numOfRows, pCond, p);                                                          \
+    }                                                                                               \
+    if (pCond->lowerOptr == OP_TYPE_GREATER_THAN) {                                                 \
+      for (int32_t j = i; j < numOfRows; ++j) p[j] = (v[j] - lower) > loTol;                        \
+    } else if (pCond->lowerOptr) {                                                                  \
+      for (int32_t j = i; j < numOfRows; ++j) p[j] = (v[j] - lower) >= loTol;                       \
+    } else {                                                                                        \
+      memset(p + i, 1, numOfRows - i);                                                              \
+    }                                                                                               \
+    if (pCond->upperOptr == OP_TYPE_LOWER_THAN) {                                                   \
+      for (int32_t j = i; j < numOfRows; ++j) p[j] &= !((v[j] - upper) >= hiTol);                   \
+    } else if (pCond->upperOptr) {                                                                  \
+      for (int32_t j = i; j < numOfRows; ++j) p[j] &= !((v[j] - upper) > hiTol);                    \
+    }                                                                                               \
+  }
+
+FLT_DEFINE_VEC_FLOAT_FN(fltVecFloat, float, fltVecRangeFloatAVX2)
+FLT_DEFINE_VEC_FLOAT_FN(fltVecDouble, double, fltVecRangeDoubleAVX2)
+
+static fltVecFn fltGetVecFn(int32_t type) {
+  switch (type) {
+    case TSDB_DATA_TYPE_BOOL:
+    case TSDB_DATA_TYPE_TINYINT:
+      return fltVecInt8;
+    case TSDB_DATA_TYPE_SMALLINT:
+      return fltVecInt16;
+    case TSDB_DATA_TYPE_INT:
+      return fltVecInt32;
+    case TSDB_DATA_TYPE_BIGINT:
+    case TSDB_DATA_TYPE_TIMESTAMP:
+      return fltVecInt64;
+    case TSDB_DATA_TYPE_UTINYINT:
+      return fltVecUint8;
+    case TSDB_DATA_TYPE_USMALLINT:
+      return fltVecUint16;
+    case TSDB_DATA_TYPE_UINT:
+      return fltVecUint32;
+    case TSDB_DATA_TYPE_UBIGINT:
+      return fltVecUint64;
+    case TSDB_DATA_TYPE_FLOAT:
+      return fltVecFloat;
+    case TSDB_DATA_TYPE_DOUBLE:
+      return fltVecDouble;
+    default:
+      return NULL;
+  }
+}
+
+static bool fltIsNanVal(int32_t type, const void *pVal) {
+  if (type == TSDB_DATA_TYPE_FLOAT) {
+    return isnan(GET_FLOAT_VAL(pVal));
+  } else if (type == TSDB_DATA_TYPE_DOUBLE) {
+    return isnan(GET_DOUBLE_VAL(pVal));
+  }
+  return false;
+}
+
+// the range and compare units are translated into the bounds, false if the unit is not applicable
+static bool fltGetVecCond(SFilterComUnit *cunit, SFltVecCond *pCond) {
+  static const uint8_t lowerOptrs[] = {OP_TYPE_GREATER_THAN,  OP_TYPE_GREATER_THAN, OP_TYPE_GREATER_EQUAL,
+                                       OP_TYPE_GREATER_EQUAL, OP_TYPE_GREATER_THAN, OP_TYPE_GREATER_EQUAL,
+                                       0,                     0};
+  static const uint8_t upperOptrs[] = {OP_TYPE_LOWER_THAN, OP_TYPE_LOWER_EQUAL, OP_TYPE_LOWER_THAN, OP_TYPE_LOWER_EQUAL,
+                                       0,                  0,                   OP_TYPE_LOWER_THAN, OP_TYPE_LOWER_EQUAL};
+
+  if (fltGetVecFn(cunit->dataType) == NULL || cunit->valData == NULL ||
+      gDataCompare[cunit->func] != getKeyComparFunc(cunit->dataType, TSDB_ORDER_ASC)) {
+    return false;
+  }
+
+  memset(pCond, 0, sizeof(*pCond));
+  if (cunit->rfunc >= 0 && cunit->rfunc < tListLen(lowerOptrs)) {
+    pCond->lowerOptr = lowerOptrs[cunit->rfunc];
+    pCond->upperOptr = upperOptrs[cunit->rfunc];
+  } else if (cunit->optr == OP_TYPE_EQUAL || cunit->optr == OP_TYPE_NOT_EQUAL) {
+    pCond->lowerOptr = OP_TYPE_GREATER_EQUAL;
+    pCond->upperOptr = OP_TYPE_LOWER_EQUAL;
+    pCond->negate = (cunit->optr == OP_TYPE_NOT_EQUAL);
+  } else {
+    return false;
+  }
+
+  pCond->lower = cunit->valData;
+  pCond->upper = cunit->valData2;
+
+  // a NaN bound is ordered apart from all the values, leave it to the compare function
+  return !(pCond->lowerOptr && fltIsNanVal(cunit->dataType, pCond->lower)) &&
+         !(pCond->upperOptr && fltIsNanVal(cunit->dataType, pCond->upper));
+}
+
+bool filterExecuteImplVec(void *pinfo, int32_t numOfRows, SColumnInfoData *pRes, SColumnDataAgg *statis,
+                          int16_t numOfCols, int32_t *numOfQualified) {
+  SFilterInfo     *info = (SFilterInfo *)pinfo;
+  SFilterComUnit  *cunit = &info->cunits[0];
+  SColumnInfoData *pData = cunit->colData;
+  SFltVecCond      cond = {0};
+  bool             all = true;
+
+  if (pData->info.type != cunit->dataType || !fltGetVecCond(cunit, &cond)) {
+    return (cunit->rfunc >= 0) ? filterExecuteImplRange(pinfo, numOfRows, pRes, statis, numOfCols, numOfQualified)
+                               : filterExecuteImplMisc(pinfo, numOfRows, pRes, statis, numOfCols, numOfQualified);
+  }
+
+  if (filterExecuteBasedOnStatis(info, numOfRows, pRes, statis, numOfCols, &all) == 0) {
+    return all;
+  }
+
+  int8_t *p = (int8_t *)pRes->pData;
+  (*fltGetVecFn(cunit->dataType))(pData->pData, numOfRows, &cond, p);
+
+  if (cond.negate) {
+    for (int32_t i = 0; i < numOfRows; ++i) {
+      p[i] ^= 1;
+    }
+  }
+
+  if (pData->hasNull) {
+    const uint8_t *bm = (const uint8_t *)pData->nullbitmap;
+    for (int32_t k = 0; k < BitmapLen(numOfRows); ++k) {
+      if (bm[k] == 0) {
+        continue;
+      }
+      for (int32_t j = 0; j < 8 && (k << NBIT) + j < numOfRows; ++j) {
+        if (bm[k] & (1u << (7u - j))) {
+          p[(k << NBIT) + j] = 0;
+        }
+      }
+    }
+  }
+
+  int32_t num = 0;
+  for (int32_t i = 0; i < numOfRows; ++i) {
+    num += p[i];
+  }
+
+  (*numOfQualified) += num;
+  return num == numOfRows;
+}
+
 bool filterExecuteImpl(void *pinfo, int32_t numOfRows, SColumnInfoData *pRes, SColumnDataAgg *statis, int16_t numOfCols,
                        int32_t *numOfQualified) {
   SFilterInfo *info = (SFilterInfo *)pinfo;
@@ -3353,6 +3661,12 @@ int32_t filterSetExecFunc(SFilterInfo *info) {
     return TSDB_CODE_SUCCESS;
   }
 
+  SFltVecCond cond = {0};
+  if (fltGetVecCond(&info->cunits[0], &cond)) {
+    info->func = filterExecuteImplVec;
+    return TSDB_CODE_SUCCESS;
+  }
+
   if (info->cunits[0].rfunc >= 0) {
     info->func = filterExecuteImplRange;
     return TSDB_CODE_SUCCESS;
@@ -3902,6 +4216,108 @@ bool filterRangeExecute(SFilterInfo *info, SColumnDataAgg **pDataStatis, int32_t
   return ret;
 }
 
+static bool fltBloomMayContain(const SBloomFilter *pBF, int32_t type, const char *val, uint32_t len) {
+  // the bloom filter of a block is built on the raw bytes of each value, without the var-data header
+  if (IS_VAR_DATA_TYPE(type)) {
+    if (len < VARSTR_HEADER_SIZE) return true;
+    val += VARSTR_HEADER_SIZE;
+    len -= VARSTR_HEADER_SIZE;
+  }
+
+  uint64_t h1 = (uint64_t)HASH_FUNCTION_1(val, len);
+  uint64_t h2 = (uint64_t)HASH_FUNCTION_2(val, len);
+  return tBloomFilterNoContain(pBF, h1, h2) != TSDB_CODE_SUCCESS;
+}
+
+static bool fltUnitMissBloom(SFilterInfo *info, uint32_t uidx, SColumnDataBloom *pBlooms, int32_t numOfBlooms) {
+  SFilterComUnit *cunit = &info->cunits[uidx];
+  if (cunit->optr != OP_TYPE_EQUAL && cunit->optr != OP_TYPE_IN) {
+    return false;
+  }
+
+  // the value has been converted to the compare type, which must be the column type to probe with its bytes
+  SFilterUnit *unit = &info->units[uidx];
+  int32_t      type = FILTER_GET_COL_FIELD_TYPE(FILTER_UNIT_LEFT_FIELD(info, unit));
+  if (type != cunit->dataType || type == TSDB_DATA_TYPE_FLOAT || type == TSDB_DATA_TYPE_DOUBLE ||
+      type == TSDB_DATA_TYPE_JSON || type == TSDB_DATA_TYPE_GEOMETRY || cunit->valData == NULL) {
+    return false;
+  }
+
+  const SBloomFilter *pBF = NULL;
+  for (int32_t i = 0; i < numOfBlooms; ++i) {
+    if (pBlooms[i].colId == cunit->colId) {
+      pBF = pBlooms[i].pBloom;
+      break;
+    }
+  }
+  if (pBF == NULL) {
+    return false;
+  }
+
+  if (cunit->optr == OP_TYPE_EQUAL) {
+    uint32_t len = IS_VAR_DATA_TYPE(type) ? varDataTLen(cunit->valData) : tDataTypes[type].bytes;
+    return !fltBloomMayContain(pBF, type, cunit->valData, len);
+  }
+
+  SHashObj *pSet = (SHashObj *)cunit->valData;
+  void     *p = taosHashIterate(pSet, NULL);
+  while (p) {
+    size_t keyLen = 0;
+    char  *key = taosHashGetKey(p, &keyLen);
+    if (fltBloomMayContain(pBF, type, key, (uint32_t)keyLen)) {
+      taosHashCancelIterate(pSet, p);
+      return false;
+    }
+    p = taosHashIterate(pSet, p);
+  }
+
+  return true;
+}
+
+bool filterBloomExecute(SFilterInfo *info, SColumnDataBloom *pBlooms, int32_t numOfBlooms) {
+  if (info->scalarMode || numOfBlooms <= 0) {
+    return true;
+  }
+
+  if (FILTER_EMPTY_RES(info)) {
+    return false;
+  }
+
+  if (FILTER_ALL_RES(info)) {
+    return true;
+  }
+
+  // groups are or-ed and the units in a group are and-ed, a group is out once any unit misses the bloom filter
+  for (uint32_t g = 0; g < info->groupNum; ++g) {
+    SFilterGroup *group = &info->groups[g];
+    bool          miss = false;
+    for (uint32_t u = 0; u < group->unitNum && !miss; ++u) {
+      miss = fltUnitMissBloom(info, group->unitIdxs[u], pBlooms, numOfBlooms);
+    }
+
+    if (!miss) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+bool filterBloomApplicable(SFilterInfo *info) {
+  if (info == NULL || info->scalarMode || FILTER_EMPTY_RES(info) || FILTER_ALL_RES(info)) {
+    return false;
+  }
+
+  for (uint32_t i = 0; i < info->unitNum; ++i) {
+    uint8_t optr = info->cunits[i].optr;
+    if (optr == OP_TYPE_EQUAL || optr == OP_TYPE_IN) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
 int32_t filterGetTimeRangeImpl(SFilterInfo *info, STimeWindow *win, bool *isStrict) {
   SFilterRange     ra = {0};
   SFilterRangeCtx *prev = filterInitRangeCtx(TSDB_DATA_TYPE_TIMESTAMP, FLT_OPTION_TIMESTAMP);
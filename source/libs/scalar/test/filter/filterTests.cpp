@@ -38,6 +38,7 @@
 #include "scalar.h"
 #include "stub.h"
 #include "taos.h"
+#include "tbloomfilter.h"
 #include "tdatablock.h"
 #include "tdef.h"
 #include "tglobal.h"
@@ -345,6 +346,138 @@ TEST(timerangeTest, greater_and_lower_not_strict) {
   nodesDestroyNode(logicNode1);
 }
 
+TEST(bloomTest, int_column_equal_value) {
+  SNode  *pcol = NULL, *pval = NULL, *opNode = NULL;
+  int32_t value = 17;
+  flttMakeColumnNode(&pcol, NULL, TSDB_DATA_TYPE_INT, sizeof(int32_t), 0, NULL);
+  flttMakeValueNode(&pval, TSDB_DATA_TYPE_INT, &value);
+  flttMakeOpNode(&opNode, OP_TYPE_EQUAL, TSDB_DATA_TYPE_BOOL, pcol, pval);
+
+  SFilterInfo *filter = NULL;
+  int32_t      code = filterInitFromNode(opNode, &filter, 0);
+  ASSERT_EQ(code, 0);
+  ASSERT_EQ(filterBloomApplicable(filter), true);
+
+  SBloomFilter    *pBF = tBloomFilterInit(16, 0.01);
+  SColumnDataBloom bloom = {.colId = ((SColumnNode *)pcol)->colId, .pBloom = pBF};
+  for (int32_t v = 0; v < 16; v += 2) {
+    tBloomFilterPut(pBF, &v, sizeof(v));
+  }
+  ASSERT_EQ(filterBloomExecute(filter, &bloom, 1), false);
+
+  // a bloom filter of another column can not filter the block out
+  bloom.colId += 1;
+  ASSERT_EQ(filterBloomExecute(filter, &bloom, 1), true);
+
+  bloom.colId -= 1;
+  tBloomFilterPut(pBF, &value, sizeof(value));
+  ASSERT_EQ(filterBloomExecute(filter, &bloom, 1), true);
+
+  tBloomFilterDestroy(pBF);
+  filterFreeInfo(filter);
+  nodesDestroyNode(opNode);
+}
+
+TEST(columnTest, double_column_range_vec) {
+  const int32_t rowNum = 1003;
+  double       *leftv = (double *)taosMemoryCalloc(rowNum, sizeof(double));
+  for (int32_t i = 0; i < rowNum; ++i) {
+    leftv[i] = (i % 500) + 0.5 * (i % 2);
+  }
+
+  SNode       *pcol = NULL, *pval = NULL, *opNode1 = NULL, *opNode2 = NULL, *logicNode = NULL;
+  SSDataBlock *src = NULL;
+  double       lower = 200, upper = 240;
+  flttMakeColumnNode(&pcol, &src, TSDB_DATA_TYPE_DOUBLE, sizeof(double), rowNum, leftv);
+  SNode *pcol2 = nodesCloneNode(pcol);
+  flttMakeValueNode(&pval, TSDB_DATA_TYPE_DOUBLE, &lower);
+  flttMakeOpNode(&opNode1, OP_TYPE_GREATER_EQUAL, TSDB_DATA_TYPE_BOOL, pcol, pval);
+  flttMakeValueNode(&pval, TSDB_DATA_TYPE_DOUBLE, &upper);
+  flttMakeOpNode(&opNode2, OP_TYPE_LOWER_EQUAL, TSDB_DATA_TYPE_BOOL, pcol2, pval);
+  SNode *list[2] = {opNode1, opNode2};
+  flttMakeLogicNode(&logicNode, LOGIC_COND_TYPE_AND, list, 2);
+
+  SColumnInfoData *pColumn = (SColumnInfoData *)taosArrayGetLast(src->pDataBlock);
+  for (int32_t i = 0; i < rowNum; i += 7) {
+    colDataSetNULL(pColumn, i);
+  }
+
+  SFilterInfo *filter = NULL;
+  int32_t      code = filterInitFromNode(logicNode, &filter, 0);
+  ASSERT_EQ(code, 0);
+
+  SFilterColumnParam param = {(int32_t)taosArrayGetSize(src->pDataBlock), src->pDataBlock};
+  code = filterSetDataFromSlotId(filter, &param);
+  ASSERT_EQ(code, 0);
+
+  char sse42 = 0, avx = 0, fma = 0;
+  taosGetCpuInstructions(&sse42, &avx, &tsAVX2Enable, &fma, &tsAVX512Enable);
+
+  // the scalar loop and the AVX2 kernel give the same result
+  char simd = tsSIMDEnable;
+  for (int32_t k = 0; k < 2; ++k) {
+    tsSIMDEnable = k;
+
+    SColumnInfoData *rowRes = NULL;
+    int32_t          status = 0;
+    code = filterExecute(filter, src, &rowRes, NULL, (int16_t)taosArrayGetSize(src->pDataBlock), &status);
+    ASSERT_EQ(code, 0);
+    ASSERT_EQ(status, FILTER_RESULT_PARTIAL_QUALIFIED);
+
+    for (int32_t i = 0; i < rowNum; ++i) {
+      int8_t eRes = (i % 7 != 0) && leftv[i] >= lower && leftv[i] <= upper;
+      ASSERT_EQ(*((int8_t *)rowRes->pData + i), eRes);
+    }
+    colDataDestroy(rowRes);
+    taosMemoryFree(rowRes);
+  }
+  tsSIMDEnable = simd;
+
+  taosMemoryFree(leftv);
+  filterFreeInfo(filter);
+  nodesDestroyNode(logicNode);
+  blockDataDestroy(src);
+}
+
+TEST(columnTest, bigint_column_not_equal_vec) {
+  const int32_t rowNum = 517;
+  int64_t      *leftv = (int64_t *)taosMemoryCalloc(rowNum, sizeof(int64_t));
+  for (int32_t i = 0; i < rowNum; ++i) {
+    leftv[i] = (i % 3 == 0) ? INT64_MIN : i % 10;
+  }
+
+  SNode       *pcol = NULL, *pval = NULL, *opNode = NULL;
+  SSDataBlock *src = NULL;
+  int64_t      value = 5;
+  flttMakeColumnNode(&pcol, &src, TSDB_DATA_TYPE_BIGINT, sizeof(int64_t), rowNum, leftv);
+  flttMakeValueNode(&pval, TSDB_DATA_TYPE_BIGINT, &value);
+  flttMakeOpNode(&opNode, OP_TYPE_NOT_EQUAL, TSDB_DATA_TYPE_BOOL, pcol, pval);
+
+  SFilterInfo *filter = NULL;
+  int32_t      code = filterInitFromNode(opNode, &filter, 0);
+  ASSERT_EQ(code, 0);
+
+  SFilterColumnParam param = {(int32_t)taosArrayGetSize(src->pDataBlock), src->pDataBlock};
+  code = filterSetDataFromSlotId(filter, &param);
+  ASSERT_EQ(code, 0);
+
+  SColumnInfoData *rowRes = NULL;
+  int32_t          status = 0;
+  code = filterExecute(filter, src, &rowRes, NULL, (int16_t)taosArrayGetSize(src->pDataBlock), &status);
+  ASSERT_EQ(code, 0);
+  ASSERT_EQ(status, FILTER_RESULT_PARTIAL_QUALIFIED);
+  for (int32_t i = 0; i < rowNum; ++i) {
+    ASSERT_EQ(*((int8_t *)rowRes->pData + i), leftv[i] != value);
+  }
+  colDataDestroy(rowRes);
+  taosMemoryFree(rowRes);
+
+  taosMemoryFree(leftv);
+  filterFreeInfo(filter);
+  nodesDestroyNode(opNode);
+  blockDataDestroy(src);
+}
+
 #if 0
 TEST(columnTest, smallint_column_greater_double_value) {
   SNode       *pLeft = NULL, *pRight = NULL, *opNode = NULL;
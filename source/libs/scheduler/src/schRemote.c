@@ -17,6 +17,7 @@
 #include "command.h"
 #include "query.h"
 #include "schInt.h"
+#include "tglobal.h"
 #include "tmsg.h"
 #include "tref.h"
 #include "trpc.h"
@@ -1157,6 +1158,7 @@ int32_t schBuildAndSendMsg(SSchJob *pJob, SSchTask *pTask, SQueryNodeAddr *addr,
       req.queryId = pJob->queryId;
       req.taskId = pTask->taskId;
       req.execId = pTask->execId;
+      req.compressRes = tsQueryResultCompress;
 
       msgSize = tSerializeSResFetchReq(NULL, 0, &req);
       if (msgSize < 0) {
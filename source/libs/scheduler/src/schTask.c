@@ -739,6 +739,22 @@ int32_t schSetAddrsFromNodeList(SSchJob *pJob, SSchTask *pTask) {
   return TSDB_CODE_SUCCESS;
 }
 
+// With follower read on, every vnode replica can serve a scan, so spread the scan tasks over the replicas instead of
+// sending all of them to the leader the epSet points to. A replica that can't serve redirects the task back.
+static void schSpreadTaskReadAddr(SSchJob *pJob, SSchTask *pTask, SQueryNodeAddr *pAddr) {
+  if (MNODE_HANDLE == pAddr->nodeId || pAddr->epSet.numOfEps <= 1) {
+    return;
+  }
+
+  if (SCH_LOAD_SEQ == schMgmt.cfg.schPolicy) {
+    pAddr->epSet.inUse = (pAddr->epSet.inUse + pTask->taskId) % pAddr->epSet.numOfEps;
+  } else {
+    pAddr->epSet.inUse = taosRand() % pAddr->epSet.numOfEps;
+  }
+
+  SCH_TASK_DLOG("spread read task to ep %d/%d", pAddr->epSet.inUse, pAddr->epSet.numOfEps);
+}
+
 int32_t schSetTaskCandidateAddrs(SSchJob *pJob, SSchTask *pTask) {
   if (NULL != pTask->candidateAddrs) {
     return TSDB_CODE_SUCCESS;
@@ -758,6 +774,10 @@ int32_t schSetTaskCandidateAddrs(SSchJob *pJob, SSchTask *pTask) {
 
     SCH_TASK_DLOG("use execNode in plan as candidate addr, numOfEps:%d", pTask->plan->execNode.epSet.numOfEps);
 
+    if (tsQueryFollowerRead && SCH_IS_QUERY_JOB(pJob) && SCH_IS_DATA_BIND_QRY_TASK(pTask)) {
+      schSpreadTaskReadAddr(pJob, pTask, taosArrayGet(pTask->candidateAddrs, 0));
+    }
+
     return TSDB_CODE_SUCCESS;
   }
 
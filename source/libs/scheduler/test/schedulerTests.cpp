@@ -1095,6 +1095,67 @@ TEST(otherTest, otherCase) {
   ASSERT_EQ(strcmp(schGetOpStr((SCH_OP_TYPE)100), "UNKNOWN"), 0);
 }
 
+// a scan task of a vnode with three replicas, placed with follower read on
+int32_t schtSpreadReadAddr(SSchJob *pJob, uint64_t taskId, int32_t nodeId, int32_t numOfEps) {
+  SSubplan plan = {0};
+  plan.subplanType = SUBPLAN_TYPE_SCAN;
+  plan.execNode.nodeId = nodeId;
+  plan.execNode.epSet.numOfEps = numOfEps;
+  for (int32_t i = 0; i < numOfEps; ++i) {
+    snprintf(plan.execNode.epSet.eps[i].fqdn, sizeof(plan.execNode.epSet.eps[i].fqdn), "dnode%d", i);
+    plan.execNode.epSet.eps[i].port = 6030;
+  }
+
+  SSchTask task = {0};
+  task.taskId = taskId;
+  task.plan = &plan;
+  EXPECT_EQ(schSetTaskCandidateAddrs(pJob, &task), TSDB_CODE_SUCCESS);
+  EXPECT_EQ(taosArrayGetSize(task.candidateAddrs), 1);
+
+  SQueryNodeAddr *pAddr = (SQueryNodeAddr *)taosArrayGet(task.candidateAddrs, 0);
+  int32_t         inUse = pAddr->epSet.inUse;
+  EXPECT_EQ(pAddr->epSet.numOfEps, numOfEps);
+  taosArrayDestroy(task.candidateAddrs);
+  return inUse;
+}
+
+TEST(otherTest, spreadReadAddr) {
+  SSchJob job = {0};
+  job.attr.queryJob = true;
+  int32_t schPolicy = schMgmt.cfg.schPolicy;
+  bool    followerRead = tsQueryFollowerRead;
+  tsQueryFollowerRead = true;
+
+  // the tasks of a job go round the replicas one after another
+  schMgmt.cfg.schPolicy = SCH_LOAD_SEQ;
+  for (uint64_t taskId = 0; taskId < 9; ++taskId) {
+    ASSERT_EQ(schtSpreadReadAddr(&job, taskId, 2, 3), taskId % 3);
+  }
+
+  // or are placed at random, still on every replica
+  schMgmt.cfg.schPolicy = SCH_RANDOM;
+  int32_t placed[3] = {0};
+  for (uint64_t taskId = 0; taskId < 300; ++taskId) {
+    int32_t inUse = schtSpreadReadAddr(&job, taskId, 2, 3);
+    ASSERT_GE(inUse, 0);
+    ASSERT_LT(inUse, 3);
+    placed[inUse]++;
+  }
+  for (int32_t i = 0; i < 3; ++i) {
+    ASSERT_GT(placed[i], 0);
+  }
+
+  // a single replica, the mnode and a job with follower read off keep the ep of the plan
+  schMgmt.cfg.schPolicy = SCH_LOAD_SEQ;
+  ASSERT_EQ(schtSpreadReadAddr(&job, 1, 2, 1), 0);
+  ASSERT_EQ(schtSpreadReadAddr(&job, 1, MNODE_HANDLE, 3), 0);
+  tsQueryFollowerRead = false;
+  ASSERT_EQ(schtSpreadReadAddr(&job, 1, 2, 3), 0);
+
+  tsQueryFollowerRead = followerRead;
+  schMgmt.cfg.schPolicy = schPolicy;
+}
+
 int main(int argc, char **argv) {
   taosSeedRand(taosGetTimestampSec());
   testing::InitGoogleTest(&argc, argv);
@@ -51,6 +51,11 @@ typedef struct {
   void* tableOpt;
 } RocksdbCfParam;
 
+typedef struct {
+  int64_t el;    // time cost of the latest checkpoint, in ms
+  int64_t size;  // bytes written by the latest checkpoint, the sst reused from the previous one excluded
+} SChkpStat;
+
 typedef struct {
   rocksdb_t*              db;
   rocksdb_writeoptions_t* writeOpt;
@@ -79,6 +84,7 @@ typedef struct {
   int32_t        chkpCap;
   TdThreadRwlock chkpDirLock;
   int64_t        dataWritten;
+  SChkpStat      chkpStat;
 
   void* pMeta;
 
@@ -33,8 +33,11 @@ extern "C" {
 #define RETRY_LAUNCH_INTERVAL_INC_RATE 1.2
 
 #define MAX_BLOCK_NAME_NUM         1024
-#define DISPATCH_RETRY_INTERVAL_MS 300
-#define MAX_CONTINUE_RETRY_COUNT   5
+#define DISPATCH_RETRY_INTERVAL_MS     300
+#define MAX_DISPATCH_RETRY_INTERVAL_MS 3000
+#define MAX_CONTINUE_RETRY_COUNT       5
+#define MAX_DISPATCH_BATCH_NUM         32                 // max outputQ items merged into one dispatch msg
+#define MAX_DISPATCH_BATCH_SIZE        (4 * 1024 * 1024)  // max result size merged into one dispatch msg
 
 #define META_HB_CHECK_INTERVAL    200
 #define META_HB_SEND_IDLE_COUNTER 25  // send hb every 5 sec
@@ -112,6 +115,8 @@ int32_t streamDispatchStreamBlock(SStreamTask* pTask);
 void    destroyDispatchMsg(SStreamDispatchReq* pReq, int32_t numOfVgroups);
 int32_t getNumOfDispatchBranch(SStreamTask* pTask);
 void    clearBufferedDispatchMsg(SStreamTask* pTask);
+int32_t streamMergeOutputBlocks(SStreamTask* pTask, SStreamDataBlock* pBlock, int64_t* pSize);
+int64_t streamGetDispatchRetryInterval(SStreamTask* pTask);
 
 int32_t           streamProcessCheckpointBlock(SStreamTask* pTask, SStreamDataBlock* pBlock);
 SStreamDataBlock* createStreamBlockFromDispatchMsg(const SStreamDispatchReq* pReq, int32_t blockType, int32_t srcVg);
@@ -1170,11 +1170,52 @@ int64_t taskGetDBRef(void* arg) {
   return pDb->refId;
 }
 
+// Sum up the size of the files in the new checkpoint that are not in the previous one. rocksdb never reuses the name of
+// an sst, so an sst found in both dirs is the same immutable file hard linked twice and costs nothing to keep.
+static int64_t chkpGetIncrSize(char* pChkpDir, int64_t prevChkpId, char* pChkpIdDir, int32_t* pReused) {
+  int64_t size = 0;
+  int32_t reused = 0;
+  int32_t len = strlen(pChkpDir) + strlen(pChkpIdDir) + 256;
+  char*   src = taosMemoryCalloc(1, len);
+  char*   prev = taosMemoryCalloc(1, len);
+
+  TdDirPtr pDir = taosOpenDir(pChkpIdDir);
+  if (pDir != NULL) {
+    TdDirEntryPtr de = NULL;
+    while ((de = taosReadDir(pDir)) != NULL) {
+      char*  name = taosGetDirEntryName(de);
+      size_t nameLen = strlen(name);
+      if (strcmp(name, ".") == 0 || strcmp(name, "..") == 0) continue;
+
+      if (prevChkpId > 0 && nameLen > 4 && strcmp(name + nameLen - 4, ".sst") == 0) {
+        snprintf(prev, len, "%s%scheckpoint%" PRId64 "%s%s", pChkpDir, TD_DIRSEP, prevChkpId, TD_DIRSEP, name);
+        if (taosCheckExistFile(prev)) {
+          reused++;
+          continue;
+        }
+      }
+
+      int64_t fsize = 0;
+      snprintf(src, len, "%s%s%s", pChkpIdDir, TD_DIRSEP, name);
+      if (taosStatFile(src, &fsize, NULL, NULL) == 0) {
+        size += fsize;
+      }
+    }
+    taosCloseDir(&pDir);
+  }
+
+  taosMemoryFree(src);
+  taosMemoryFree(prev);
+  *pReused = reused;
+  return size;
+}
+
 int32_t taskDbDoCheckpoint(void* arg, int64_t chkpId) {
   STaskDbWrapper* pTaskDb = arg;
   int64_t         st = taosGetTimestampMs();
   int32_t         code = -1;
   int64_t         refId = pTaskDb->refId;
+  int64_t         prevChkpId = pTaskDb->chkpId;
 
   if (taosAcquireRef(taskDbWrapperId, refId) == NULL) {
     return -1;
@@ -1196,8 +1237,12 @@ int32_t taskDbDoCheckpoint(void* arg, int64_t chkpId) {
     if ((code = chkpDoDbCheckpoint(pTaskDb->db, pChkpIdDir)) != 0) {
       stError("stream backend:%p failed to do checkpoint at:%s", pTaskDb, pChkpIdDir);
     } else {
-      stDebug("stream backend:%p end to do checkpoint at:%s, time cost:%" PRId64 "ms", pTaskDb, pChkpIdDir,
-              taosGetTimestampMs() - st);
+      int32_t reused = 0;
+      pTaskDb->chkpStat.size = chkpGetIncrSize(pChkpDir, prevChkpId, pChkpIdDir, &reused);
+      pTaskDb->chkpStat.el = taosGetTimestampMs() - st;
+      stDebug("stream backend:%p end to do checkpoint at:%s, time cost:%" PRId64 "ms, written:%" PRId64
+              " bytes, reused sst:%d",
+              pTaskDb, pChkpIdDir, pTaskDb->chkpStat.el, pTaskDb->chkpStat.size, reused);
     }
   } else {
     stError("stream backend:%p failed to flush db at:%s", pTaskDb, pChkpIdDir);
@@ -4084,7 +4129,8 @@ int32_t dbChkpDumpTo(SDbChkp* p, char* dname, SArray* list) {
     sprintf(srcBuf, "%s%s%s", srcDir, TD_DIRSEP, filename);
     sprintf(dstBuf, "%s%s%s", dstDir, TD_DIRSEP, filename);
 
-    if (taosCopyFile(srcBuf, dstBuf) < 0) {
+    // the sst in the checkpoint dir is immutable, link it into the upload dir and only copy across file systems
+    if (copyFiles_hardlink(srcBuf, dstBuf, 0) != 0 && taosCopyFile(srcBuf, dstBuf) < 0) {
       stError("failed to copy file from %s to %s", srcBuf, dstBuf);
       goto _ERROR;
     }
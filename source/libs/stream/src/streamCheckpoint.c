@@ -428,6 +428,12 @@ int32_t streamTaskBuildCheckpoint(SStreamTask* pTask) {
     code = streamBackendDoCheckpoint(pTask->pBackend, ckId);
     if (code != TSDB_CODE_SUCCESS) {
       stError("s-task:%s gen checkpoint:%" PRId64 " failed, code:%s", id, ckId, tstrerror(terrno));
+    } else {
+      SChkpStat* pStat = &((STaskDbWrapper*)pTask->pBackend)->chkpStat;
+      pTask->execInfo.checkpointEl = pStat->el;
+      pTask->execInfo.checkpointSize = pStat->size;
+      stInfo("s-task:%s gen checkpoint:%" PRId64 " completed, elapsed time:%" PRId64 "ms, written:%" PRId64 " bytes",
+             id, ckId, pStat->el, pStat->size);
     }
   }
 
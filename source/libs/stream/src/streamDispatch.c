@@ -542,6 +542,49 @@ int32_t streamSearchAndAddBlock(SStreamTask* pTask, SStreamDispatchReq* pReqs, S
   return 0;
 }
 
+// Merge the data blocks already queued behind pBlock into it, so that they are sent in one dispatch msg instead of
+// waiting one round trip each. Nothing is waited for: a task keeping up still sends every result at once, while a task
+// falling behind sends fewer and larger msgs. The checkpoint-trigger and trans-state msgs are left in the outputQ.
+int32_t streamMergeOutputBlocks(SStreamTask* pTask, SStreamDataBlock* pBlock, int64_t* pSize) {
+  SStreamQueue* pQueue = pTask->outputq.queue;
+  int32_t       numOfItems = 1;
+
+  *pSize = streamQueueItemGetSize((SStreamQueueItem*)pBlock);
+  while (numOfItems < MAX_DISPATCH_BATCH_NUM && *pSize < MAX_DISPATCH_BATCH_SIZE) {
+    SStreamDataBlock* pNext = streamQueueNextItem(pQueue);
+    if (pNext == NULL) {
+      break;
+    }
+
+    if (pNext->type != STREAM_INPUT__DATA_BLOCK || pNext->srcVgId != pBlock->srcVgId) {
+      streamQueueProcessFail(pQueue);
+      break;
+    }
+
+    *pSize += streamQueueItemGetSize((SStreamQueueItem*)pNext);
+    taosArrayAddAll(pBlock->blocks, pNext->blocks);
+    taosArrayDestroy(pNext->blocks);
+    taosFreeQitem(pNext);
+    numOfItems += 1;
+  }
+
+  return numOfItems;
+}
+
+// Invoked once per dispatch round that is to be resent. When a downstream inputQ is full, resending the whole msg to it
+// at a fixed pace only adds load to it, so the interval doubles with each round in a row it is refused. A round failed
+// by the network only is resent at the fixed pace, and a successful dispatch starts the backoff over.
+int64_t streamGetDispatchRetryInterval(SStreamTask* pTask) {
+  SDispatchMsgInfo* pMsgInfo = &pTask->msgInfo;
+  if (atomic_val_compare_exchange_8(&pMsgInfo->blockedRsp, 1, 0) == 0) {
+    return DISPATCH_RETRY_INTERVAL_MS;
+  }
+
+  int64_t waitDuration = DISPATCH_RETRY_INTERVAL_MS << TMIN(pMsgInfo->blockedCount, 4);
+  pMsgInfo->blockedCount += 1;
+  return TMIN(waitDuration, MAX_DISPATCH_RETRY_INTERVAL_MS);
+}
+
 int32_t streamDispatchStreamBlock(SStreamTask* pTask) {
   ASSERT((pTask->outputInfo.type == TASK_OUTPUT__FIXED_DISPATCH ||
           pTask->outputInfo.type == TASK_OUTPUT__SHUFFLE_DISPATCH));
@@ -581,6 +624,16 @@ int32_t streamDispatchStreamBlock(SStreamTask* pTask) {
   ASSERT(pBlock->type == STREAM_INPUT__DATA_BLOCK || pBlock->type == STREAM_INPUT__CHECKPOINT_TRIGGER ||
          pBlock->type == STREAM_INPUT__TRANS_STATE);
 
+  if (pBlock->type == STREAM_INPUT__DATA_BLOCK) {
+    int64_t size = 0;
+    int32_t numOfItems = streamMergeOutputBlocks(pTask, pBlock, &size);
+    pTask->execInfo.dispatchDataSize += size;
+    if (numOfItems > 1) {
+      stDebug("s-task:%s merge %d items from outputQ into one dispatch msg, blocks:%d, size:%.2fMiB", id, numOfItems,
+              (int32_t)taosArrayGetSize(pBlock->blocks), SIZE_IN_MiB(size));
+    }
+  }
+
   pTask->execInfo.dispatch += 1;
   pTask->msgInfo.startTs = taosGetTimestampMs();
 
@@ -885,6 +938,7 @@ static int32_t handleDispatchSuccessRsp(SStreamTask* pTask, int32_t downstreamId
   clearBufferedDispatchMsg(pTask);
 
   int64_t el = taosGetTimestampMs() - pTask->msgInfo.startTs;
+  pTask->execInfo.dispatchEl += el;
 
   // put data into inputQ of current task is also allowed
   if (pTask->inputq.status == TASK_INPUT_STATUS__BLOCKED) {
@@ -954,13 +1008,14 @@ int32_t streamProcessDispatchRsp(SStreamTask* pTask, SStreamDispatchRsp* pRsp, i
   } else {  // code == 0
     if (pRsp->inputStatus == TASK_INPUT_STATUS__BLOCKED) {
       pTask->inputq.status = TASK_INPUT_STATUS__BLOCKED;
+      atomic_store_8(&pTask->msgInfo.blockedRsp, 1);
       // block the input of current task, to push pressure to upstream
       taosThreadMutexLock(&pTask->lock);
       taosArrayPush(pTask->msgInfo.pRetryList, &pRsp->downstreamNodeId);
       taosThreadMutexUnlock(&pTask->lock);
 
-      stWarn("s-task:%s inputQ of downstream task:0x%x(vgId:%d) is full, wait for %dms and retry dispatch", id,
-             pRsp->downstreamTaskId, pRsp->downstreamNodeId, DISPATCH_RETRY_INTERVAL_MS);
+      stWarn("s-task:%s inputQ of downstream task:0x%x(vgId:%d) is full, back off and retry dispatch, blocked rounds:%d",
+             id, pRsp->downstreamTaskId, pRsp->downstreamNodeId, pTask->msgInfo.blockedCount);
     } else if (pRsp->inputStatus == TASK_INPUT_STATUS__REFUSED) {
       // todo handle the agg task failure, add test case
       if (pTask->msgInfo.dispatchMsgType == STREAM_INPUT__CHECKPOINT_TRIGGER &&
@@ -1014,13 +1069,15 @@ int32_t streamProcessDispatchRsp(SStreamTask* pTask, SStreamDispatchRsp* pRsp, i
         stDebug("s-task:%s waiting rsp set to be %d", id, pTask->outputInfo.shuffleDispatcher.waitingRspCnt);
       }
 
+      int64_t waitDuration = streamGetDispatchRetryInterval(pTask);
       int32_t ref = atomic_add_fetch_32(&pTask->status.timerActive, 1);
-      stDebug("s-task:%s failed to dispatch msg to downstream, add into timer to retry in %dms, ref:%d",
-              pTask->id.idStr, DISPATCH_RETRY_INTERVAL_MS, ref);
+      stDebug("s-task:%s failed to dispatch msg to downstream, add into timer to retry in %" PRId64 "ms, ref:%d",
+              pTask->id.idStr, waitDuration, ref);
 
-      streamRetryDispatchData(pTask, DISPATCH_RETRY_INTERVAL_MS);
+      streamRetryDispatchData(pTask, waitDuration);
     } else {  // this message has been sent successfully, let's try next one.
       pTask->msgInfo.retryCount = 0;
+      pTask->msgInfo.blockedCount = 0;
 
       // trans-state msg has been sent to downstream successfully. let's transfer the fill-history task state
       if (pTask->msgInfo.dispatchMsgType == STREAM_INPUT__TRANS_STATE) {
@@ -558,6 +558,7 @@ int32_t flushSnapshot(SStreamFileState* pFileState, SStreamSnapshot* pSnapshot,
 
   int64_t    st = taosGetTimestampMs();
   int32_t    numOfElems = listNEles(pSnapshot);
+  int32_t    numOfFlushed = 0;
   SListNode* pNode = NULL;
 
   int idx = streamStateGetCfIdx(pFileState->pFileStore, pFileState->cfName);
@@ -568,10 +569,12 @@ int32_t flushSnapshot(SStreamFileState* pFileState, SStreamSnapshot* pSnapshot,
   void* batch = streamStateCreateBatch();
   while ((pNode = tdListNext(&iter)) != NULL && code == TSDB_CODE_SUCCESS) {
     SRowBuffPos* pPos = *(SRowBuffPos**)pNode->data;
+    // only the rows acquired since the last flush are written, the others are already in the backend
     if (pPos->beFlushed || !pPos->pRowBuff) {
       continue;
     }
     pPos->beFlushed = true;
+    numOfFlushed++;
     pFileState->flushMark = TMAX(pFileState->flushMark, pFileState->getTs(pPos->pKey));
 
     qDebug("===stream===flushed start:%" PRId64, pFileState->getTs(pPos->pKey));
@@ -596,8 +599,9 @@ int32_t flushSnapshot(SStreamFileState* pFileState, SStreamSnapshot* pSnapshot,
   streamStateClearBatch(batch);
 
   int64_t elapsed = taosGetTimestampMs() - st;
-  qDebug("%s flush to disk in batch model completed, rows:%d, batch size:%d, elapsed time:%" PRId64 "ms",
-         pFileState->id, numOfElems, BATCH_LIMIT, elapsed);
+  qDebug("%s flush to disk in batch model completed, rows:%d of %d, written:%" PRId64
+         " bytes, batch size:%d, elapsed time:%" PRId64 "ms",
+         pFileState->id, numOfFlushed, numOfElems, (int64_t)numOfFlushed * pFileState->rowSize, BATCH_LIMIT, elapsed);
 
   if (flushState) {
     void*   valBuf = NULL;
@@ -427,6 +427,40 @@ TEST_F(BackendEnv, checkOpen) {
 
 TEST_F(BackendEnv, backendChkp) { const char *path = "/tmp"; }
 
+TEST_F(BackendEnv, checkpointStat) {
+  streamMetaInit();
+  const char *path = "/tmp/backend_chkp_stat";
+  taosRemoveDir(path);
+  SStreamState   *p = stateCreate(path);
+  STaskDbWrapper *pTaskDb = (STaskDbWrapper *)p->pTdbState->pOwner->pBackend;
+
+  // random values do not compress, so the sst dominates the size of the first checkpoint
+  const int32_t size = 4096;
+  char          val[1024] = {0};
+  for (int32_t i = 0; i < size; i++) {
+    SWinKey key = {0};
+    key.groupId = (uint64_t)(i);
+    key.ts = 1700000000000 + i;
+    for (int32_t j = 0; j < sizeof(val); j++) {
+      val[j] = (char)taosRand();
+    }
+    streamStatePut_rocksdb(p, &key, val, sizeof(val));
+  }
+
+  ASSERT_EQ(taskDbDoCheckpoint(pTaskDb, 1), 0);
+  int64_t firstSize = pTaskDb->chkpStat.size;
+  ASSERT_GT(firstSize, (int64_t)size * sizeof(val) / 2);
+  ASSERT_GE(pTaskDb->chkpStat.el, 0);
+
+  // nothing written since the last checkpoint, its ssts are reused and only the manifest files are new
+  ASSERT_EQ(taskDbDoCheckpoint(pTaskDb, 2), 0);
+  ASSERT_GT(pTaskDb->chkpStat.size, 0);
+  ASSERT_LT(pTaskDb->chkpStat.size, firstSize / 4);
+
+  streamStateClose(p, true);
+  taosRemoveDir(path);
+}
+
 typedef struct BdKV {
   uint32_t k;
   uint32_t v;
@@ -0,0 +1,246 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "streamInt.h"
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wwrite-strings"
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#pragma GCC diagnostic ignored "-Wsign-compare"
+
+namespace {
+
+#define TEST_VGID       2
+#define TEST_STAGE      1
+#define TEST_SRC_VGID   3
+#define TEST_DOWN_VGID  4
+#define TEST_DOWN_TASK  5
+
+// a shuffle dispatch task, with one dispatch msg in flight to two downstream tasks
+class StreamDispatchTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    pMeta = (SStreamMeta *)taosMemoryCalloc(1, sizeof(SStreamMeta));
+    pTask = (SStreamTask *)taosMemoryCalloc(1, sizeof(SStreamTask));
+    ASSERT_NE(pMeta, nullptr);
+    ASSERT_NE(pTask, nullptr);
+    pMeta->vgId = TEST_VGID;
+    pMeta->stage = TEST_STAGE;
+    pMeta->role = NODE_ROLE_LEADER;
+
+    pTask->pMeta = pMeta;
+    pTask->id.idStr = "0x1-dispatch";
+    pTask->status.downstreamReady = 1;
+    pTask->execInfo.dispatch = 1;
+    pTask->outputInfo.type = TASK_OUTPUT__SHUFFLE_DISPATCH;
+    pTask->outputq.status = TASK_OUTPUT_STATUS__WAIT;
+    pTask->outputq.queue = streamQueueOpen(512 << 10);
+    pTask->msgInfo.pRetryList = taosArrayInit(4, sizeof(int32_t));
+    ASSERT_NE(pTask->outputq.queue, nullptr);
+    ASSERT_NE(pTask->msgInfo.pRetryList, nullptr);
+    taosThreadMutexInit(&pTask->lock, NULL);
+  }
+
+  void TearDown() override {
+    taosThreadMutexDestroy(&pTask->lock);
+    taosArrayDestroy(pTask->msgInfo.pRetryList);
+    streamQueueClose(pTask->outputq.queue, 1);
+    taosMemoryFree(pTask);
+    taosMemoryFree(pMeta);
+  }
+
+  void put(int8_t type, int32_t srcVgId, int64_t dataSize) {
+    SStreamDataBlock *pBlock = (SStreamDataBlock *)taosAllocateQitem(sizeof(SStreamDataBlock), DEF_QITEM, dataSize);
+    ASSERT_NE(pBlock, nullptr);
+    pBlock->type = type;
+    pBlock->srcVgId = srcVgId;
+    pBlock->blocks = taosArrayInit(1, sizeof(SSDataBlock));
+    SSDataBlock block = {0};
+    taosArrayPush(pBlock->blocks, &block);
+    ASSERT_EQ(streamTaskPutDataIntoOutputQ(pTask, pBlock), 0);
+  }
+
+  void putData(int32_t num, int64_t dataSize) {
+    for (int32_t i = 0; i < num; i++) {
+      put(STREAM_INPUT__DATA_BLOCK, TEST_SRC_VGID, dataSize);
+    }
+  }
+
+  // takes the next item off the outputQ as the dispatch does, merging the data blocks behind it
+  SStreamDataBlock *next(int32_t *numOfItems, int64_t *size) {
+    SStreamDataBlock *pBlock = (SStreamDataBlock *)streamQueueNextItem(pTask->outputq.queue);
+    *numOfItems = 0;
+    *size = 0;
+    if (pBlock != NULL && pBlock->type == STREAM_INPUT__DATA_BLOCK) {
+      *numOfItems = streamMergeOutputBlocks(pTask, pBlock, size);
+    }
+    return pBlock;
+  }
+
+  void expectNext(int8_t type, int32_t expectItems) {
+    int32_t           numOfItems = 0;
+    int64_t           size = 0;
+    SStreamDataBlock *pBlock = next(&numOfItems, &size);
+    ASSERT_NE(pBlock, nullptr);
+    ASSERT_EQ(pBlock->type, type);
+    if (type == STREAM_INPUT__DATA_BLOCK) {
+      ASSERT_EQ(numOfItems, expectItems);
+      ASSERT_EQ(taosArrayGetSize(pBlock->blocks), expectItems);
+    }
+    destroyStreamDataBlock(pBlock);
+  }
+
+  void expectEmpty() {
+    int32_t numOfItems = 0;
+    int64_t size = 0;
+    ASSERT_EQ(next(&numOfItems, &size), nullptr);
+  }
+
+  // one rsp of the round, another one is still waited for, so the round is not resent yet
+  void recvRsp(int32_t code, int8_t inputStatus) {
+    atomic_store_32(&pTask->outputInfo.shuffleDispatcher.waitingRspCnt, 2);
+    SStreamDispatchRsp rsp = {0};
+    rsp.msgId = pTask->execInfo.dispatch;
+    rsp.stage = TEST_STAGE;
+    rsp.downstreamNodeId = TEST_DOWN_VGID;
+    rsp.downstreamTaskId = TEST_DOWN_TASK;
+    rsp.inputStatus = inputStatus;
+    ASSERT_EQ(streamProcessDispatchRsp(pTask, &rsp, code), 0);
+  }
+
+  // the interval the round is resent after, once all its rsp are in
+  int64_t endRound() {
+    taosArrayClear(pTask->msgInfo.pRetryList);
+    return streamGetDispatchRetryInterval(pTask);
+  }
+
+  int64_t blockedRound() {
+    recvRsp(0, TASK_INPUT_STATUS__BLOCKED);
+    return endRound();
+  }
+
+  // the last rsp of a round all accepted by the downstream tasks
+  void recvAllAccepted() {
+    atomic_store_32(&pTask->outputInfo.shuffleDispatcher.waitingRspCnt, 1);
+    SStreamDispatchRsp rsp = {0};
+    rsp.msgId = pTask->execInfo.dispatch;
+    rsp.stage = TEST_STAGE;
+    rsp.downstreamNodeId = TEST_DOWN_VGID;
+    rsp.downstreamTaskId = TEST_DOWN_TASK;
+    rsp.inputStatus = TASK_INPUT_STATUS__NORMAL;
+    ASSERT_EQ(streamProcessDispatchRsp(pTask, &rsp, 0), 0);
+  }
+
+  SStreamMeta *pMeta = nullptr;
+  SStreamTask *pTask = nullptr;
+};
+
+}  // namespace
+
+TEST_F(StreamDispatchTest, mergeStopsAtBarriers) {
+  putData(2, 100);
+  put(STREAM_INPUT__CHECKPOINT_TRIGGER, TEST_SRC_VGID, 0);
+  putData(1, 100);
+  put(STREAM_INPUT__TRANS_STATE, TEST_SRC_VGID, 0);
+  putData(3, 100);
+
+  expectNext(STREAM_INPUT__DATA_BLOCK, 2);
+  expectNext(STREAM_INPUT__CHECKPOINT_TRIGGER, 0);
+  expectNext(STREAM_INPUT__DATA_BLOCK, 1);
+  expectNext(STREAM_INPUT__TRANS_STATE, 0);
+  expectNext(STREAM_INPUT__DATA_BLOCK, 3);
+  expectEmpty();
+}
+
+TEST_F(StreamDispatchTest, mergeStopsAtOtherSource) {
+  putData(2, 100);
+  put(STREAM_INPUT__DATA_BLOCK, TEST_SRC_VGID + 1, 100);
+  putData(1, 100);
+
+  expectNext(STREAM_INPUT__DATA_BLOCK, 2);
+  expectNext(STREAM_INPUT__DATA_BLOCK, 1);
+  expectNext(STREAM_INPUT__DATA_BLOCK, 1);
+  expectEmpty();
+}
+
+TEST_F(StreamDispatchTest, mergeKeepsBatchNum) {
+  putData(MAX_DISPATCH_BATCH_NUM + 8, 100);
+
+  expectNext(STREAM_INPUT__DATA_BLOCK, MAX_DISPATCH_BATCH_NUM);
+  expectNext(STREAM_INPUT__DATA_BLOCK, 8);
+  expectEmpty();
+}
+
+TEST_F(StreamDispatchTest, mergeKeepsBatchSize) {
+  const int64_t itemSize = MAX_DISPATCH_BATCH_SIZE / 4;
+  putData(6, itemSize);
+
+  int32_t           numOfItems = 0;
+  int64_t           size = 0;
+  SStreamDataBlock *pBlock = next(&numOfItems, &size);
+  ASSERT_NE(pBlock, nullptr);
+  ASSERT_EQ(numOfItems, 4);
+  ASSERT_EQ(size, MAX_DISPATCH_BATCH_SIZE);
+  destroyStreamDataBlock(pBlock);
+
+  expectNext(STREAM_INPUT__DATA_BLOCK, 2);
+
+  // an item bigger than the limit is sent on its own
+  put(STREAM_INPUT__DATA_BLOCK, TEST_SRC_VGID, MAX_DISPATCH_BATCH_SIZE + 1);
+  putData(1, 100);
+  expectNext(STREAM_INPUT__DATA_BLOCK, 1);
+  expectNext(STREAM_INPUT__DATA_BLOCK, 1);
+  expectEmpty();
+}
+
+TEST_F(StreamDispatchTest, retryBacksOffWhileBlocked) {
+  int64_t expect = DISPATCH_RETRY_INTERVAL_MS;
+  for (int32_t i = 0; i < 8; i++) {
+    ASSERT_EQ(blockedRound(), expect) << "round " << i;
+    expect = TMIN(expect * 2, MAX_DISPATCH_RETRY_INTERVAL_MS);
+  }
+  ASSERT_EQ(expect, MAX_DISPATCH_RETRY_INTERVAL_MS);
+
+  // a successful dispatch starts the backoff over
+  recvAllAccepted();
+  ASSERT_EQ(pTask->inputq.status, TASK_INPUT_STATUS__NORMAL);
+  ASSERT_EQ(pTask->outputq.status, TASK_OUTPUT_STATUS__NORMAL);
+  ASSERT_EQ(blockedRound(), DISPATCH_RETRY_INTERVAL_MS);
+  ASSERT_EQ(blockedRound(), DISPATCH_RETRY_INTERVAL_MS * 2);
+}
+
+TEST_F(StreamDispatchTest, retryNotBackOffOnNetworkFailure) {
+  for (int32_t i = 0; i < 4; i++) {
+    recvRsp(TSDB_CODE_RPC_NETWORK_UNAVAIL, TASK_INPUT_STATUS__NORMAL);
+    ASSERT_EQ(endRound(), DISPATCH_RETRY_INTERVAL_MS);
+  }
+
+  // still blocked from the rounds before, the inputQ of this task is no reason to back off a network failure
+  ASSERT_EQ(blockedRound(), DISPATCH_RETRY_INTERVAL_MS);
+  ASSERT_EQ(blockedRound(), DISPATCH_RETRY_INTERVAL_MS * 2);
+  ASSERT_EQ(pTask->inputq.status, TASK_INPUT_STATUS__BLOCKED);
+  recvRsp(TSDB_CODE_RPC_NETWORK_UNAVAIL, TASK_INPUT_STATUS__NORMAL);
+  ASSERT_EQ(endRound(), DISPATCH_RETRY_INTERVAL_MS);
+
+  // a round with one downstream blocked and another one failed backs off, and goes on from the last blocked round
+  recvRsp(TSDB_CODE_RPC_NETWORK_UNAVAIL, TASK_INPUT_STATUS__NORMAL);
+  recvRsp(0, TASK_INPUT_STATUS__BLOCKED);
+  ASSERT_EQ(endRound(), DISPATCH_RETRY_INTERVAL_MS * 4);
+}
+
+#pragma GCC diagnostic pop
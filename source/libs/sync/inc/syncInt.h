@@ -36,6 +36,7 @@ typedef struct SVotesGranted          SVotesGranted;
 typedef struct SVotesRespond          SVotesRespond;
 typedef struct SSyncIndexMgr          SSyncIndexMgr;
 typedef struct SSyncRespMgr           SSyncRespMgr;
+typedef struct SSyncReadIndexMgr      SSyncReadIndexMgr;
 typedef struct SSyncSnapshotSender    SSyncSnapshotSender;
 typedef struct SSyncSnapshotReceiver  SSyncSnapshotReceiver;
 typedef struct SSyncTimer             SSyncTimer;
@@ -196,11 +197,16 @@ typedef struct SSyncNode {
   TAOS_TMR_CALLBACK FpHeartbeatTimerCB;  // Timer Fp
   uint64_t          heartbeatTimerCounter;
 
+  // log flush timer, backstop of the leader for entries staged by wal group commit
+  tmr_h   pFlushLogTimer;
+  int32_t flushLogTimerArmed;
+
   // peer heartbeat timer
   SSyncTimer peerHeartbeatTimerArr[TSDB_MAX_REPLICA + TSDB_MAX_LEARNER_REPLICA];
 
   // tools
-  SSyncRespMgr* pSyncRespMgr;
+  SSyncRespMgr*      pSyncRespMgr;
+  SSyncReadIndexMgr* pReadIndexMgr;
 
   // restore state
   bool restoreFinish;
@@ -273,6 +279,8 @@ void    syncNodeResetElectTimer(SSyncNode* pSyncNode);
 int32_t syncNodeStartHeartbeatTimer(SSyncNode* pSyncNode);
 int32_t syncNodeStopHeartbeatTimer(SSyncNode* pSyncNode);
 int32_t syncNodeRestartHeartbeatTimer(SSyncNode* pSyncNode);
+void    syncNodeStartFlushLogTimer(SSyncNode* pSyncNode);
+void    syncNodeStopFlushLogTimer(SSyncNode* pSyncNode);
 
 // utils --------------
 int32_t   syncNodeSendMsgById(const SRaftId* destRaftId, SSyncNode* pSyncNode, SRpcMsg* pMsg);
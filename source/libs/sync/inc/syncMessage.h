@@ -175,6 +175,34 @@ typedef struct SyncPreSnapshotReply {
   int16_t   reserved;
 } SyncPreSnapshotReply;
 
+typedef struct SyncReadIndex {
+  uint32_t bytes;
+  int32_t  vgId;
+  uint32_t msgType;
+  SRaftId  srcId;
+  SRaftId  destId;
+
+  // private data
+  SyncTerm term;
+  int64_t  seq;
+  int16_t  reserved;
+} SyncReadIndex;
+
+typedef struct SyncReadIndexReply {
+  uint32_t bytes;
+  int32_t  vgId;
+  uint32_t msgType;
+  SRaftId  srcId;
+  SRaftId  destId;
+
+  // private data
+  SyncTerm  term;
+  int64_t   seq;
+  SyncIndex commitIndex;
+  int32_t   code;
+  int16_t   reserved;
+} SyncReadIndexReply;
+
 typedef struct SyncApplyMsg {
   uint32_t   bytes;
   int32_t    vgId;
@@ -239,6 +267,7 @@ typedef enum {
   SYNC_LOCAL_CMD_STEP_DOWN = 100,
   SYNC_LOCAL_CMD_FOLLOWER_CMT,
   SYNC_LOCAL_CMD_LEARNER_CMT,
+  SYNC_LOCAL_CMD_FLUSH_LOG,
 } ESyncLocalCmd;
 
 typedef struct SyncLocalCmd {
@@ -260,10 +289,12 @@ int32_t syncBuildRequestVote(SRpcMsg* pMsg, int32_t vgId);
 int32_t syncBuildRequestVoteReply(SRpcMsg* pMsg, int32_t vgId);
 int32_t syncBuildAppendEntries(SRpcMsg* pMsg, int32_t dataLen, int32_t vgId);
 int32_t syncBuildAppendEntriesReply(SRpcMsg* pMsg, int32_t vgId);
-int32_t syncBuildAppendEntriesFromRaftEntry(SSyncNode* pNode, SSyncRaftEntry* pEntry, SyncTerm prevLogTerm,
-                                            SRpcMsg* pRpcMsg);
+int32_t syncBuildAppendEntriesFromRaftEntries(SSyncNode* pNode, SSyncRaftEntry** aEntry, int32_t numOfEntries,
+                                              SyncTerm prevLogTerm, SRpcMsg* pRpcMsg);
 int32_t syncBuildHeartbeat(SRpcMsg* pMsg, int32_t vgId);
 int32_t syncBuildHeartbeatReply(SRpcMsg* pMsg, int32_t vgId);
+int32_t syncBuildReadIndex(SRpcMsg* pMsg, int32_t vgId);
+int32_t syncBuildReadIndexReply(SRpcMsg* pMsg, int32_t vgId);
 int32_t syncBuildPreSnapshot(SRpcMsg* pMsg, int32_t vgId);
 int32_t syncBuildPreSnapshotReply(SRpcMsg* pMsg, int32_t vgId);
 int32_t syncBuildApplyMsg(SRpcMsg* pMsg, const SRpcMsg* pOriginal, int32_t vgId, SFsmCbMeta* pMeta);
@@ -39,6 +39,8 @@ typedef struct SSyncLogReplMgr {
   int64_t       peerStartTime;
   int32_t       retryBackoff;
   int32_t       peerId;
+  SyncTerm      leaseTerm;    // term of the last heartbeat acked by the peer
+  int64_t       leaseTimeMs;  // when the leader sent that heartbeat
 } SSyncLogReplMgr;
 
 typedef struct SSyncLogBufEntry {
@@ -85,6 +87,8 @@ int32_t syncLogReplProbe(SSyncLogReplMgr* pMgr, SSyncNode* pNode, SyncIndex inde
 int32_t syncLogReplRetryOnNeed(SSyncLogReplMgr* pMgr, SSyncNode* pNode);
 int32_t syncLogReplSendTo(SSyncLogReplMgr* pMgr, SSyncNode* pNode, SyncIndex index, SyncTerm* pTerm, SRaftId* pDestId,
                           bool* pBarrier);
+int32_t syncLogReplSendBatchTo(SSyncLogReplMgr* pMgr, SSyncNode* pNode, SyncIndex index, int32_t maxNum,
+                               int32_t* pNum, SyncTerm* aTerm, SRaftId* pDestId, bool* pBarrier);
 
 int32_t syncLogReplProcessReply(SSyncLogReplMgr* pMgr, SSyncNode* pNode, SyncAppendEntriesReply* pMsg);
 int32_t syncLogReplRecover(SSyncLogReplMgr* pMgr, SSyncNode* pNode, SyncAppendEntriesReply* pMsg);
@@ -105,7 +109,10 @@ bool     syncLogBufferIsEmpty(SSyncLogBuffer* pBuf);
 
 int32_t syncLogBufferAppend(SSyncLogBuffer* pBuf, SSyncNode* pNode, SSyncRaftEntry* pEntry);
 int32_t syncLogBufferAccept(SSyncLogBuffer* pBuf, SSyncNode* pNode, SSyncRaftEntry* pEntry, SyncTerm prevTerm);
+int32_t syncLogBufferAcceptBatch(SSyncLogBuffer* pBuf, SSyncNode* pNode, SSyncRaftEntry** aEntry, int32_t numOfEntries,
+                                 SyncTerm prevTerm);
 int64_t syncLogBufferProceed(SSyncLogBuffer* pBuf, SSyncNode* pNode, SyncTerm* pMatchTerm, char *str);
+SyncIndex syncNodeFlushLog(SSyncNode* pNode);
 int32_t syncLogBufferCommit(SSyncLogBuffer* pBuf, SSyncNode* pNode, int64_t commitIndex);
 int32_t syncLogBufferReset(SSyncLogBuffer* pBuf, SSyncNode* pNode);
 
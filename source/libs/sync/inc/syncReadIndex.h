@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _TD_LIBS_SYNC_READ_INDEX_H
+#define _TD_LIBS_SYNC_READ_INDEX_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "syncInt.h"
+
+// A follower asks the leader for its commit index at most once at a time. Readers arriving while a request is in
+// flight share the next round, so one round trip serves all the queries queued behind it.
+typedef struct SSyncReadIndexMgr {
+  TdThreadMutex mutex;
+  TdThreadCond  cond;
+  int64_t       sendSeq;     // seq of the last request sent to the leader
+  int64_t       sendTimeMs;  // when the last request was sent
+  int64_t       recvSeq;     // seq of the last reply from the leader
+  int32_t       code;        // result of the last reply
+  SyncIndex     readIndex;   // commit index of the leader in the last reply
+  bool          pending;     // readers are waiting for a round after sendSeq
+} SSyncReadIndexMgr;
+
+SSyncReadIndexMgr* syncReadIndexMgrCreate();
+void               syncReadIndexMgrDestroy(SSyncReadIndexMgr* pMgr);
+
+bool    syncNodeHasLeaderLease(SSyncNode* pSyncNode);
+int32_t syncNodeReadIndex(SSyncNode* pSyncNode, int32_t timeoutMs, SyncIndex* pIndex);
+int32_t syncNodeOnReadIndex(SSyncNode* ths, const SRpcMsg* pRpcMsg);
+int32_t syncNodeOnReadIndexReply(SSyncNode* ths, const SRpcMsg* pRpcMsg);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*_TD_LIBS_SYNC_READ_INDEX_H*/
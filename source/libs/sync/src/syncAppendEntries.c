@@ -93,7 +93,8 @@ int32_t syncNodeOnAppendEntries(SSyncNode* ths, const SRpcMsg* pRpcMsg) {
   SyncAppendEntries* pMsg = pRpcMsg->pCont;
   SRpcMsg            rpcRsp = {0};
   bool               accepted = false;
-  SSyncRaftEntry*    pEntry = NULL;
+  SSyncRaftEntry*    aEntry[SYNC_LOG_REPL_BATCH_MAX_NUM] = {0};
+  int32_t            numOfEntries = 0;
   bool               resetElect = false;
 
   // if already drop replica, do not process
@@ -137,39 +138,49 @@ int32_t syncNodeOnAppendEntries(SSyncNode* ths, const SRpcMsg* pRpcMsg) {
     goto _IGNORE;
   }
 
-  pEntry = syncEntryBuildFromAppendEntries(pMsg);
-  if (pEntry == NULL) {
+  if (syncEntriesBuildFromAppendEntries(pMsg, aEntry, SYNC_LOG_REPL_BATCH_MAX_NUM, &numOfEntries) < 0 ||
+      numOfEntries == 0) {
     sError("vgId:%d, failed to get raft entry from append entries since %s", ths->vgId, terrstr());
     goto _IGNORE;
   }
 
-  if (pMsg->prevLogIndex + 1 != pEntry->index || pEntry->term < 0) {
-    sError("vgId:%d, invalid previous log index in msg. index:%" PRId64 ",  term:%" PRId64 ", prevLogIndex:%" PRId64
-           ", prevLogTerm:%" PRId64,
-           ths->vgId, pEntry->index, pEntry->term, pMsg->prevLogIndex, pMsg->prevLogTerm);
-    goto _IGNORE;
+  for (int32_t i = 0; i < numOfEntries; i++) {
+    if (pMsg->prevLogIndex + 1 + i != aEntry[i]->index || aEntry[i]->term < 0) {
+      sError("vgId:%d, invalid previous log index in msg. index:%" PRId64 ",  term:%" PRId64 ", prevLogIndex:%" PRId64
+             ", prevLogTerm:%" PRId64 ", pos:%d",
+             ths->vgId, aEntry[i]->index, aEntry[i]->term, pMsg->prevLogIndex, pMsg->prevLogTerm, i);
+      goto _IGNORE;
+    }
   }
 
+  // the reply acknowledges the whole batch
+  pReply->lastSendIndex = pMsg->prevLogIndex + numOfEntries;
+
   sTrace("vgId:%d, recv append entries msg. index:%" PRId64 ", term:%" PRId64 ", preLogIndex:%" PRId64
-         ", prevLogTerm:%" PRId64 " commitIndex:%" PRId64 " entryterm:%" PRId64,
+         ", prevLogTerm:%" PRId64 " commitIndex:%" PRId64 " entryterm:%" PRId64 ", entries:%d",
          pMsg->vgId, pMsg->prevLogIndex + 1, pMsg->term, pMsg->prevLogIndex, pMsg->prevLogTerm, pMsg->commitIndex,
-         pEntry->term);
+         aEntry[0]->term, numOfEntries);
 
   if (ths->fsmState == SYNC_FSM_STATE_INCOMPLETE) {
     pReply->fsmState = ths->fsmState;
-    sWarn("vgId:%d, unable to accept, due to incomplete fsm state. index:%" PRId64, ths->vgId, pEntry->index);
-    syncEntryDestroy(pEntry);
+    sWarn("vgId:%d, unable to accept, due to incomplete fsm state. index:%" PRId64, ths->vgId, aEntry[0]->index);
     goto _SEND_RESPONSE;
   }
 
   // accept
-  if (syncLogBufferAccept(ths->pLogBuf, ths, pEntry, pMsg->prevLogTerm) < 0) {
+  code = numOfEntries == 1 ? syncLogBufferAccept(ths->pLogBuf, ths, aEntry[0], pMsg->prevLogTerm)
+                           : syncLogBufferAcceptBatch(ths->pLogBuf, ths, aEntry, numOfEntries, pMsg->prevLogTerm);
+  numOfEntries = 0;
+  if (code < 0) {
     goto _SEND_RESPONSE;
   }
   accepted = true;
 
 _SEND_RESPONSE:
-  pEntry = NULL;
+  for (int32_t i = 0; i < numOfEntries; i++) {
+    syncEntryDestroy(aEntry[i]);
+  }
+  // the entries accepted are persisted in one pass, with one flush of the wal group commit
   pReply->matchIndex = syncLogBufferProceed(ths->pLogBuf, ths, &pReply->lastMatchTerm, "OnAppn");
   bool matched = (pReply->matchIndex >= pReply->lastSendIndex);
   if (accepted && matched) {
@@ -191,6 +202,8 @@ _SEND_RESPONSE:
 
 _IGNORE:
   rpcFreeCont(rpcRsp.pCont);
-  syncEntryDestroy(pEntry);
+  for (int32_t i = 0; i < numOfEntries; i++) {
+    syncEntryDestroy(aEntry[i]);
+  }
   return 0;
 }
@@ -73,6 +73,11 @@ int32_t syncNodeOnAppendEntriesReply(SSyncNode* ths, const SRpcMsg* pRpcMsg) {
         syncIndexMgrSetIndex(ths->pMatchIndex, &(pMsg->srcId), pMsg->matchIndex);
       }
 
+      // the quorum may be waiting on the entries the leader left staged by wal group commit
+      if (pMsg->matchIndex > syncIndexMgrGetIndex(ths->pMatchIndex, &ths->myRaftId)) {
+        (void)syncNodeFlushLog(ths);
+      }
+
       // commit if needed
       SyncIndex indexLikely = TMIN(pMsg->matchIndex, ths->pLogBuf->matchIndex);
       SyncIndex commitIndex = syncNodeCheckCommitIndex(ths, indexLikely);
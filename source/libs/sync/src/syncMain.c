@@ -27,6 +27,7 @@
 #include "syncRaftCfg.h"
 #include "syncRaftLog.h"
 #include "syncRaftStore.h"
+#include "syncReadIndex.h"
 #include "syncReplication.h"
 #include "syncRequestVote.h"
 #include "syncRequestVoteReply.h"
@@ -218,6 +219,7 @@ int32_t syncProcessMsg(int64_t rid, SRpcMsg* pMsg) {
       code = syncNodeOnRequestVoteReply(pSyncNode, pMsg);
       break;
     case TDMT_SYNC_APPEND_ENTRIES:
+    case TDMT_SYNC_APPEND_ENTRIES_BATCH:
       code = syncNodeOnAppendEntries(pSyncNode, pMsg);
       break;
     case TDMT_SYNC_APPEND_ENTRIES_REPLY:
@@ -238,6 +240,12 @@ int32_t syncProcessMsg(int64_t rid, SRpcMsg* pMsg) {
     case TDMT_SYNC_SET_ASSIGNED_LEADER:
       code = syncBecomeAssignedLeader(pSyncNode, pMsg);
       break;
+    case TDMT_SYNC_READ_INDEX:
+      code = syncNodeOnReadIndex(pSyncNode, pMsg);
+      break;
+    case TDMT_SYNC_READ_INDEX_REPLY:
+      code = syncNodeOnReadIndexReply(pSyncNode, pMsg);
+      break;
     default:
       terrno = TSDB_CODE_MSG_NOT_PROCESSED;
       code = -1;
@@ -536,6 +544,19 @@ bool syncIsReadyForRead(int64_t rid) {
   return ready;
 }
 
+int32_t syncReadIndex(int64_t rid, int32_t timeoutMs, SyncIndex* pIndex) {
+  SSyncNode* pSyncNode = syncNodeAcquire(rid);
+  if (pSyncNode == NULL) {
+    sError("sync read index error");
+    return -1;
+  }
+
+  int32_t code = syncNodeReadIndex(pSyncNode, timeoutMs, pIndex);
+
+  syncNodeRelease(pSyncNode);
+  return code;
+}
+
 #ifdef BUILD_NO_CALL
 bool syncSnapshotSending(int64_t rid) {
   SSyncNode* pSyncNode = syncNodeAcquire(rid);
@@ -1224,6 +1245,12 @@ SSyncNode* syncNodeOpen(SSyncInfo* pSyncInfo, int32_t vnodeVersion) {
     goto _error;
   }
 
+  pSyncNode->pReadIndexMgr = syncReadIndexMgrCreate();
+  if (pSyncNode->pReadIndexMgr == NULL) {
+    sError("vgId:%d, failed to create SyncReadIndexMgr", pSyncNode->vgId);
+    goto _error;
+  }
+
   // restore state
   pSyncNode->restoreFinish = false;
 
@@ -1403,6 +1430,9 @@ void syncNodePreClose(SSyncNode* pSyncNode) {
   // stop ping timer
   syncNodeStopPingTimer(pSyncNode);
 
+  // stop log flush timer
+  syncNodeStopFlushLogTimer(pSyncNode);
+
   // clean rsp
   syncRespCleanRsp(pSyncNode->pSyncRespMgr);
 }
@@ -1431,10 +1461,13 @@ void syncNodeClose(SSyncNode* pSyncNode) {
   syncNodeStopPingTimer(pSyncNode);
   syncNodeStopElectTimer(pSyncNode);
   syncNodeStopHeartbeatTimer(pSyncNode);
+  syncNodeStopFlushLogTimer(pSyncNode);
   syncNodeLogReplDestroy(pSyncNode);
 
   syncRespMgrDestroy(pSyncNode->pSyncRespMgr);
   pSyncNode->pSyncRespMgr = NULL;
+  syncReadIndexMgrDestroy(pSyncNode->pReadIndexMgr);
+  pSyncNode->pReadIndexMgr = NULL;
   voteGrantedDestroy(pSyncNode->pVotesGranted);
   pSyncNode->pVotesGranted = NULL;
   votesRespondDestory(pSyncNode->pVotesRespond);
@@ -1505,6 +1538,57 @@ int32_t syncNodeStopPingTimer(SSyncNode* pSyncNode) {
   return ret;
 }
 
+static void syncNodeEqFlushLogTimer(void* param, void* tmrId) {
+  if (!syncIsInit()) return;
+
+  int64_t    rid = (int64_t)param;
+  SSyncNode* pNode = syncNodeAcquire(rid);
+
+  if (pNode == NULL) return;
+
+  if (pNode->syncEqMsg == NULL || pNode->msgcb == NULL) {
+    atomic_store_32(&pNode->flushLogTimerArmed, 0);
+    syncNodeRelease(pNode);
+    return;
+  }
+
+  SRpcMsg rpcMsg = {0};
+  if (syncBuildLocalCmd(&rpcMsg, pNode->vgId) != 0) {
+    sError("vgId:%d, failed to build flush-log msg since %s", pNode->vgId, terrstr());
+    atomic_store_32(&pNode->flushLogTimerArmed, 0);
+    syncNodeRelease(pNode);
+    return;
+  }
+
+  SyncLocalCmd* pSyncMsg = rpcMsg.pCont;
+  pSyncMsg->cmd = SYNC_LOCAL_CMD_FLUSH_LOG;
+
+  int32_t code = pNode->syncEqMsg(pNode->msgcb, &rpcMsg);
+  if (code != 0) {
+    sError("vgId:%d, failed to enqueue flush-log msg since %s, code:%d", pNode->vgId, terrstr(), code);
+    rpcFreeCont(rpcMsg.pCont);
+    atomic_store_32(&pNode->flushLogTimerArmed, 0);
+  }
+
+  syncNodeRelease(pNode);
+}
+
+// arm a one-shot timer to write out the entries the leader left staged in wal group commit
+void syncNodeStartFlushLogTimer(SSyncNode* pSyncNode) {
+  if (!syncIsInit()) return;
+  if (atomic_val_compare_exchange_32(&pSyncNode->flushLogTimerArmed, 0, 1) != 0) return;
+
+  int32_t ms = TMAX(tsWalGroupCommitLatency, 1);
+  taosTmrReset(syncNodeEqFlushLogTimer, ms, (void*)pSyncNode->rid, syncEnv()->pTimerManager,
+               &pSyncNode->pFlushLogTimer);
+}
+
+void syncNodeStopFlushLogTimer(SSyncNode* pSyncNode) {
+  taosTmrStop(pSyncNode->pFlushLogTimer);
+  pSyncNode->pFlushLogTimer = NULL;
+  atomic_store_32(&pSyncNode->flushLogTimerArmed, 0);
+}
+
 int32_t syncNodeStartElectTimer(SSyncNode* pSyncNode, int32_t ms) {
   int32_t ret = 0;
   if (syncIsInit()) {
@@ -3262,7 +3346,7 @@ int32_t syncNodeOnHeartbeat(SSyncNode* ths, const SRpcMsg* pRpcMsg) {
   pMsgReply->term = currentTerm;
   pMsgReply->privateTerm = 8864;  // magic number
   pMsgReply->startTime = ths->startTime;
-  pMsgReply->timeStamp = tsMs;
+  pMsgReply->timeStamp = pMsg->timeStamp;  // echoed back for the leader lease
 
   sTrace("vgId:%d, heartbeat msg from dnode:%d, cluster:%d, Msgterm:%" PRId64 " currentTerm:%" PRId64, ths->vgId,
          DID(&(pMsg->srcId)), CID(&(pMsg->srcId)), pMsg->term, currentTerm);
@@ -3347,6 +3431,24 @@ int32_t syncNodeOnHeartbeatReply(SSyncNode* ths, const SRpcMsg* pRpcMsg) {
 
   syncIndexMgrSetRecvTime(ths->pMatchIndex, &pMsg->srcId, tsMs);
 
+  SyncTerm currentTerm = raftStoreGetTerm(ths);
+  if (pMsg->term > currentTerm &&
+      (ths->state == TAOS_SYNC_STATE_LEADER || ths->state == TAOS_SYNC_STATE_ASSIGNED_LEADER)) {
+    sInfo("vgId:%d, step down since heartbeat reply of higher term:%" PRId64 " from dnode:%d, current term:%" PRId64,
+          ths->vgId, pMsg->term, DID(&pMsg->srcId), currentTerm);
+    syncNodeStepDown(ths, pMsg->term);
+    return 0;
+  }
+
+  // the peer echoes the send time of the heartbeat, it can have voted for no one else before that moment
+  if (pMsg->term == currentTerm) {
+    int64_t sendTimeMs = TMIN(pMsg->timeStamp, tsMs);
+    if (pMgr->leaseTerm != currentTerm || pMgr->leaseTimeMs < sendTimeMs) {
+      pMgr->leaseTerm = currentTerm;
+      pMgr->leaseTimeMs = sendTimeMs;
+    }
+  }
+
   return syncLogReplProcessHeartbeatReply(pMgr, ths, pMsg);
 }
 
@@ -3388,6 +3490,30 @@ int32_t syncNodeOnLocalCmd(SSyncNode* ths, const SRpcMsg* pRpcMsg) {
       sError("vgId:%d, failed to commit raft log since %s. commit index:%" PRId64 "", ths->vgId, terrstr(),
              ths->commitIndex);
     }
+  } else if (pMsg->cmd == SYNC_LOCAL_CMD_FLUSH_LOG) {
+    atomic_store_32(&ths->flushLogTimerArmed, 0);
+    if (ths->state != TAOS_SYNC_STATE_LEADER && ths->state != TAOS_SYNC_STATE_ASSIGNED_LEADER) {
+      return 0;
+    }
+
+    SyncIndex flushedIndex = syncNodeFlushLog(ths);
+    if (ths->fsmState == SYNC_FSM_STATE_INCOMPLETE) {
+      return 0;
+    }
+
+    SyncIndex commitIndex = 0;
+    if (ths->state == TAOS_SYNC_STATE_ASSIGNED_LEADER) {
+      (void)syncNodeUpdateAssignedCommitIndex(ths, flushedIndex);
+      commitIndex = ths->assignedCommitIndex;
+    } else if (ths->replicaNum == 1) {
+      commitIndex = syncNodeUpdateCommitIndex(ths, flushedIndex);
+    } else {
+      commitIndex = syncNodeCheckCommitIndex(ths, flushedIndex);
+    }
+    if (syncLogBufferCommit(ths->pLogBuf, ths, commitIndex) < 0) {
+      sError("vgId:%d, failed to commit raft log since %s. commit index:%" PRId64 "", ths->vgId, terrstr(),
+             commitIndex);
+    }
   } else {
     sError("error local cmd");
   }
@@ -154,9 +154,13 @@ int32_t syncBuildAppendEntriesReply(SRpcMsg* pMsg, int32_t vgId) {
   return 0;
 }
 
-int32_t syncBuildAppendEntriesFromRaftEntry(SSyncNode* pNode, SSyncRaftEntry* pEntry, SyncTerm prevLogTerm,
-                                            SRpcMsg* pRpcMsg) {
-  uint32_t dataLen = pEntry->bytes;
+// Consecutive entries are packed back to back into data, a msg of more than one entry is typed as a batch.
+int32_t syncBuildAppendEntriesFromRaftEntries(SSyncNode* pNode, SSyncRaftEntry** aEntry, int32_t numOfEntries,
+                                              SyncTerm prevLogTerm, SRpcMsg* pRpcMsg) {
+  uint32_t dataLen = 0;
+  for (int32_t i = 0; i < numOfEntries; i++) {
+    dataLen += aEntry[i]->bytes;
+  }
   uint32_t bytes = sizeof(SyncAppendEntries) + dataLen;
   pRpcMsg->contLen = bytes;
   pRpcMsg->pCont = rpcMallocCont(pRpcMsg->contLen);
@@ -167,18 +171,23 @@ int32_t syncBuildAppendEntriesFromRaftEntry(SSyncNode* pNode, SSyncRaftEntry* pE
 
   SyncAppendEntries* pMsg = pRpcMsg->pCont;
   pMsg->bytes = pRpcMsg->contLen;
-  pMsg->msgType = pRpcMsg->msgType = TDMT_SYNC_APPEND_ENTRIES;
+  pMsg->msgType = pRpcMsg->msgType = numOfEntries > 1 ? TDMT_SYNC_APPEND_ENTRIES_BATCH : TDMT_SYNC_APPEND_ENTRIES;
   pMsg->dataLen = dataLen;
 
-  (void)memcpy(pMsg->data, pEntry, dataLen);
+  char* pData = pMsg->data;
+  for (int32_t i = 0; i < numOfEntries; i++) {
+    (void)memcpy(pData, aEntry[i], aEntry[i]->bytes);
+    pData += aEntry[i]->bytes;
+  }
 
-  pMsg->prevLogIndex = pEntry->index - 1;
+  pMsg->prevLogIndex = aEntry[0]->index - 1;
   pMsg->prevLogTerm = prevLogTerm;
   pMsg->vgId = pNode->vgId;
   pMsg->srcId = pNode->myRaftId;
   pMsg->term = raftStoreGetTerm(pNode);
   pMsg->commitIndex = pNode->commitIndex;
   pMsg->privateTerm = 0;
+  pMsg->reserved = 0;
   return 0;
 }
 
@@ -216,6 +225,40 @@ int32_t syncBuildHeartbeatReply(SRpcMsg* pMsg, int32_t vgId) {
   return 0;
 }
 
+int32_t syncBuildReadIndex(SRpcMsg* pMsg, int32_t vgId) {
+  int32_t bytes = sizeof(SyncReadIndex);
+  pMsg->pCont = rpcMallocCont(bytes);
+  pMsg->msgType = TDMT_SYNC_READ_INDEX;
+  pMsg->contLen = bytes;
+  if (pMsg->pCont == NULL) {
+    terrno = TSDB_CODE_OUT_OF_MEMORY;
+    return -1;
+  }
+
+  SyncReadIndex* pReadIndex = pMsg->pCont;
+  pReadIndex->bytes = bytes;
+  pReadIndex->msgType = TDMT_SYNC_READ_INDEX;
+  pReadIndex->vgId = vgId;
+  return 0;
+}
+
+int32_t syncBuildReadIndexReply(SRpcMsg* pMsg, int32_t vgId) {
+  int32_t bytes = sizeof(SyncReadIndexReply);
+  pMsg->pCont = rpcMallocCont(bytes);
+  pMsg->msgType = TDMT_SYNC_READ_INDEX_REPLY;
+  pMsg->contLen = bytes;
+  if (pMsg->pCont == NULL) {
+    terrno = TSDB_CODE_OUT_OF_MEMORY;
+    return -1;
+  }
+
+  SyncReadIndexReply* pReadIndexReply = pMsg->pCont;
+  pReadIndexReply->bytes = bytes;
+  pReadIndexReply->msgType = TDMT_SYNC_READ_INDEX_REPLY;
+  pReadIndexReply->vgId = vgId;
+  return 0;
+}
+
 int32_t syncBuildSnapshotSend(SRpcMsg* pMsg, int32_t dataLen, int32_t vgId) {
   int32_t bytes = sizeof(SyncSnapshotSend) + dataLen;
   pMsg->pCont = rpcMallocCont(bytes);
@@ -304,6 +347,8 @@ const char* syncLocalCmdGetStr(ESyncLocalCmd cmd) {
       return "step-down";
     case SYNC_LOCAL_CMD_FOLLOWER_CMT:
       return "follower-commit";
+    case SYNC_LOCAL_CMD_FLUSH_LOG:
+      return "flush-log";
     default:
       return "unknown-local-cmd";
   }
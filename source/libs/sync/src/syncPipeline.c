@@ -27,6 +27,7 @@
 #include "syncUtil.h"
 #include "syncRaftCfg.h"
 #include "syncVoteMgr.h"
+#include "tglobal.h"
 
 static bool syncIsMsgBlock(tmsg_t type) {
   return (type == TDMT_VND_CREATE_TABLE) || (type == TDMT_VND_ALTER_TABLE) || (type == TDMT_VND_DROP_TABLE) ||
@@ -313,9 +314,10 @@ bool syncLogBufferIsEmpty(SSyncLogBuffer* pBuf) {
   return empty;
 }
 
-int32_t syncLogBufferAccept(SSyncLogBuffer* pBuf, SSyncNode* pNode, SSyncRaftEntry* pEntry, SyncTerm prevTerm) {
-  taosThreadMutexLock(&pBuf->mutex);
-  syncLogBufferValidate(pBuf);
+// A chained entry follows one just accepted from the same msg, its prev term is checked against that entry when the
+// buffer proceeds instead of against the last match term.
+static int32_t syncLogBufferAcceptWithoutLock(SSyncLogBuffer* pBuf, SSyncNode* pNode, SSyncRaftEntry* pEntry,
+                                              SyncTerm prevTerm, bool chained) {
   int32_t         ret = -1;
   SyncIndex       index = pEntry->index;
   SyncIndex       prevIndex = pEntry->index - 1;
@@ -353,7 +355,7 @@ int32_t syncLogBufferAccept(SSyncLogBuffer* pBuf, SSyncNode* pNode, SSyncRaftEnt
     goto _out;
   }
 
-  if (index > pBuf->matchIndex && lastMatchTerm != prevTerm) {
+  if (index > pBuf->matchIndex && !chained && lastMatchTerm != prevTerm) {
     sWarn("vgId:%d, not ready to accept. index:%" PRId64 ", term:%" PRId64 ": prevterm:%" PRId64
           " != lastmatch:%" PRId64 ". log buffer: [%" PRId64 " %" PRId64 " %" PRId64 ", %" PRId64 ")",
           pNode->vgId, pEntry->index, pEntry->term, prevTerm, lastMatchTerm, pBuf->startIndex, pBuf->commitIndex,
@@ -399,6 +401,40 @@ _out:
     syncEntryDestroy(pExist);
     pExist = NULL;
   }
+  return ret;
+}
+
+int32_t syncLogBufferAccept(SSyncLogBuffer* pBuf, SSyncNode* pNode, SSyncRaftEntry* pEntry, SyncTerm prevTerm) {
+  taosThreadMutexLock(&pBuf->mutex);
+  syncLogBufferValidate(pBuf);
+  int32_t ret = syncLogBufferAcceptWithoutLock(pBuf, pNode, pEntry, prevTerm, false);
+  syncLogBufferValidate(pBuf);
+  taosThreadMutexUnlock(&pBuf->mutex);
+  return ret;
+}
+
+// Accept consecutive entries of one append entries msg, each one's prev term is the term of the one before it. Only the
+// first one is checked against the last match term, the others are chained to it, so a batch may span several terms.
+// It stops at the first entry not accepted, the entries are consumed anyway.
+int32_t syncLogBufferAcceptBatch(SSyncLogBuffer* pBuf, SSyncNode* pNode, SSyncRaftEntry** aEntry, int32_t numOfEntries,
+                                 SyncTerm prevTerm) {
+  int32_t ret = 0;
+  int32_t i = 0;
+
+  taosThreadMutexLock(&pBuf->mutex);
+  syncLogBufferValidate(pBuf);
+  for (; i < numOfEntries; i++) {
+    SyncTerm term = aEntry[i]->term;
+    if (syncLogBufferAcceptWithoutLock(pBuf, pNode, aEntry[i], prevTerm, i > 0) < 0) {
+      ret = -1;
+      i++;
+      break;
+    }
+    prevTerm = term;
+  }
+  for (; i < numOfEntries; i++) {
+    syncEntryDestroy(aEntry[i]);
+  }
   syncLogBufferValidate(pBuf);
   taosThreadMutexUnlock(&pBuf->mutex);
   return ret;
@@ -436,6 +472,7 @@ int64_t syncLogBufferProceed(SSyncLogBuffer* pBuf, SSyncNode* pNode, SyncTerm* p
 
   SSyncLogStore* pLogStore = pNode->pLogStore;
   int64_t        matchIndex = pBuf->matchIndex;
+  int64_t        retIndex = matchIndex;
 
   while (pBuf->matchIndex + 1 < pBuf->endIndex) {
     int64_t index = pBuf->matchIndex + 1;
@@ -525,13 +562,56 @@ int64_t syncLogBufferProceed(SSyncLogBuffer* pBuf, SSyncNode* pNode, SyncTerm* p
   }  // end of while
 
 _out:
+  if (pNode->state == TAOS_SYNC_STATE_LEADER || pNode->state == TAOS_SYNC_STATE_ASSIGNED_LEADER) {
+    // the leader leaves flushing to the latency and size thresholds of wal group commit, and only counts the entries
+    // written out to the quorum. the staged tail is flushed by the log flush timer or an ack of a follower.
+    retIndex = TMIN(matchIndex, pLogStore->syncLogFlushedIndex(pLogStore));
+    syncIndexMgrSetIndex(pNode->pMatchIndex, &pNode->myRaftId, retIndex);
+    if (retIndex < matchIndex) {
+      syncNodeStartFlushLogTimer(pNode);
+    }
+  } else if (pLogStore->syncLogFlush(pLogStore, false) < 0) {
+    // entries persisted above may be staged by wal group commit, make them durable before match index is reported
+    SyncIndex lastVer = pLogStore->syncLogLastIndex(pLogStore);
+    if (matchIndex > lastVer) {
+      sError("vgId:%d, failed to flush sync log entries since %s. match index:%" PRId64 ", last index:%" PRId64,
+             pNode->vgId, terrstr(), matchIndex, lastVer);
+      matchIndex = lastVer;
+      syncIndexMgrSetIndex(pNode->pMatchIndex, &pNode->myRaftId, matchIndex);
+    }
+    retIndex = matchIndex;
+  } else {
+    retIndex = matchIndex;
+  }
   pBuf->matchIndex = matchIndex;
   if (pMatchTerm) {
     *pMatchTerm = pBuf->entries[(matchIndex + pBuf->size) % pBuf->size].pItem->term;
   }
   syncLogBufferValidate(pBuf);
   taosThreadMutexUnlock(&pBuf->mutex);
-  return matchIndex;
+  return retIndex;
+}
+
+// leader only. write out the entries staged by wal group commit and count them to the quorum.
+SyncIndex syncNodeFlushLog(SSyncNode* pNode) {
+  SSyncLogStore* pLogStore = pNode->pLogStore;
+  SyncIndex      matchIndex = pNode->pLogBuf->matchIndex;
+  SyncIndex      myIndex = syncIndexMgrGetIndex(pNode->pMatchIndex, &pNode->myRaftId);
+  if (myIndex >= matchIndex) {
+    return myIndex;
+  }
+
+  if (pLogStore->syncLogFlush(pLogStore, false) < 0) {
+    sError("vgId:%d, failed to flush sync log entries since %s. match index:%" PRId64, pNode->vgId, terrstr(),
+           matchIndex);
+  }
+
+  SyncIndex flushedIndex = TMIN(matchIndex, pLogStore->syncLogFlushedIndex(pLogStore));
+  if (flushedIndex > myIndex) {
+    syncIndexMgrSetIndex(pNode->pMatchIndex, &pNode->myRaftId, flushedIndex);
+    myIndex = flushedIndex;
+  }
+  return myIndex;
 }
 
 int32_t syncFsmExecute(SSyncNode* pNode, SSyncFSM* pFsm, ESyncState role, SyncTerm term, SSyncRaftEntry* pEntry,
@@ -990,31 +1070,36 @@ int32_t syncLogReplAttempt(SSyncLogReplMgr* pMgr, SSyncNode* pNode) {
   SyncTerm  term = -1;
   SyncIndex firstIndex = -1;
 
-  for (SyncIndex index = pMgr->endIndex; index <= pNode->pLogBuf->matchIndex; index++) {
+  for (SyncIndex index = pMgr->endIndex; index <= pNode->pLogBuf->matchIndex; index = pMgr->endIndex) {
     if (batchSize < count || limit <= index - pMgr->startIndex) {
       break;
     }
     if (pMgr->startIndex + 1 < index && pMgr->states[(index - 1) % pMgr->size].barrier) {
       break;
     }
-    int64_t  pos = index % pMgr->size;
     SRaftId* pDestId = &pNode->replicasId[pMgr->peerId];
     bool     barrier = false;
-    SyncTerm term = -1;
-    if (syncLogReplSendTo(pMgr, pNode, index, &term, pDestId, &barrier) < 0) {
+    SyncTerm aTerm[SYNC_LOG_REPL_BATCH_MAX_NUM];
+    int32_t  numOfEntries = 0;
+    int32_t  maxNum = TMIN(tsSyncLogReplBatchNum, limit - (index - pMgr->startIndex));
+    if (syncLogReplSendBatchTo(pMgr, pNode, index, maxNum, &numOfEntries, aTerm, pDestId, &barrier) < 0) {
       sError("vgId:%d, failed to replicate log entry since %s. index:%" PRId64 ", dest: 0x%016" PRIx64 "", pNode->vgId,
              terrstr(), index, pDestId->addr);
       return -1;
     }
-    pMgr->states[pos].barrier = barrier;
-    pMgr->states[pos].timeMs = nowMs;
-    pMgr->states[pos].term = term;
-    pMgr->states[pos].acked = false;
+    for (int32_t i = 0; i < numOfEntries; i++) {
+      int64_t pos = (index + i) % pMgr->size;
+      pMgr->states[pos].barrier = barrier;
+      pMgr->states[pos].timeMs = nowMs;
+      pMgr->states[pos].term = aTerm[i];
+      pMgr->states[pos].acked = false;
+    }
+    term = aTerm[numOfEntries - 1];
 
     if (firstIndex == -1) firstIndex = index;
-    count++;
+    count += numOfEntries;
 
-    pMgr->endIndex = index + 1;
+    pMgr->endIndex = index + numOfEntries;
     if (barrier) {
       sInfo("vgId:%d, replicated sync barrier to dnode:%d. index:%" PRId64 ", term:%" PRId64 ", repl-mgr:[%" PRId64
             " %" PRId64 ", %" PRId64 ")",
@@ -1250,57 +1335,96 @@ SSyncRaftEntry* syncLogBufferGetOneEntry(SSyncLogBuffer* pBuf, SSyncNode* pNode,
 
 int32_t syncLogReplSendTo(SSyncLogReplMgr* pMgr, SSyncNode* pNode, SyncIndex index, SyncTerm* pTerm, SRaftId* pDestId,
                           bool* pBarrier) {
-  SSyncRaftEntry* pEntry = NULL;
+  int32_t  numOfEntries = 0;
+  SyncTerm term = -1;
+  if (syncLogReplSendBatchTo(pMgr, pNode, index, 1, &numOfEntries, &term, pDestId, pBarrier) < 0) {
+    return -1;
+  }
+  if (pTerm) *pTerm = term;
+  return 0;
+}
+
+// Send the entries from index on in one msg, at most maxNum of them and SYNC_LOG_REPL_BATCH_MAX_BYTES in total. A
+// barrier entry is always sent alone. The terms of the entries sent are returned in aTerm.
+int32_t syncLogReplSendBatchTo(SSyncLogReplMgr* pMgr, SSyncNode* pNode, SyncIndex index, int32_t maxNum,
+                               int32_t* pNum, SyncTerm* aTerm, SRaftId* pDestId, bool* pBarrier) {
+  SSyncRaftEntry* aEntry[SYNC_LOG_REPL_BATCH_MAX_NUM] = {0};
+  bool            aInBuf[SYNC_LOG_REPL_BATCH_MAX_NUM] = {0};
+  int32_t         numOfEntries = 0;
+  int64_t         bytes = 0;
   SRpcMsg         msgOut = {0};
-  bool            inBuf = false;
   SyncTerm        prevLogTerm = -1;
   SSyncLogBuffer* pBuf = pNode->pLogBuf;
+  int32_t         ret = -1;
+
+  maxNum = TMAX(1, TMIN(maxNum, SYNC_LOG_REPL_BATCH_MAX_NUM));
+  *pBarrier = false;
+
+  for (; numOfEntries < maxNum; numOfEntries++) {
+    SyncIndex       curIndex = index + numOfEntries;
+    bool            inBuf = false;
+    SSyncRaftEntry* pEntry = NULL;
+
+    if (numOfEntries > 0 && curIndex > pBuf->matchIndex) break;
 
-  pEntry = syncLogBufferGetOneEntry(pBuf, pNode, index, &inBuf);
-  if (pEntry == NULL) {
-    sWarn("vgId:%d, failed to get raft entry for index:%" PRId64 "", pNode->vgId, index);
-    if (terrno == TSDB_CODE_WAL_LOG_NOT_EXIST) {
-      SSyncLogReplMgr* pMgr = syncNodeGetLogReplMgr(pNode, pDestId);
-      if (pMgr) {
-        sInfo("vgId:%d, reset sync log repl of peer:%" PRIx64 " since %s. index:%" PRId64, pNode->vgId, pDestId->addr,
-              terrstr(), index);
-        (void)syncLogReplReset(pMgr);
+    pEntry = syncLogBufferGetOneEntry(pBuf, pNode, curIndex, &inBuf);
+    if (pEntry == NULL) {
+      if (numOfEntries > 0) break;
+
+      sWarn("vgId:%d, failed to get raft entry for index:%" PRId64 "", pNode->vgId, curIndex);
+      if (terrno == TSDB_CODE_WAL_LOG_NOT_EXIST) {
+        SSyncLogReplMgr* pMgr = syncNodeGetLogReplMgr(pNode, pDestId);
+        if (pMgr) {
+          sInfo("vgId:%d, reset sync log repl of peer:%" PRIx64 " since %s. index:%" PRId64, pNode->vgId,
+                pDestId->addr, terrstr(), curIndex);
+          (void)syncLogReplReset(pMgr);
+        }
       }
+      goto _out;
+    }
+
+    if (numOfEntries > 0 && (syncLogReplBarrier(pEntry) || bytes + pEntry->bytes > SYNC_LOG_REPL_BATCH_MAX_BYTES)) {
+      if (!inBuf) syncEntryDestroy(pEntry);
+      break;
+    }
+
+    aEntry[numOfEntries] = pEntry;
+    aInBuf[numOfEntries] = inBuf;
+    aTerm[numOfEntries] = pEntry->term;
+    bytes += pEntry->bytes;
+
+    if (syncLogReplBarrier(pEntry)) {
+      *pBarrier = true;
+      numOfEntries++;
+      break;
     }
-    goto _err;
   }
-  *pBarrier = syncLogReplBarrier(pEntry);
 
   prevLogTerm = syncLogReplGetPrevLogTerm(pMgr, pNode, index);
   if (prevLogTerm < 0) {
     sError("vgId:%d, failed to get prev log term since %s. index:%" PRId64 "", pNode->vgId, terrstr(), index);
-    goto _err;
+    goto _out;
   }
-  if (pTerm) *pTerm = pEntry->term;
 
-  int32_t code = syncBuildAppendEntriesFromRaftEntry(pNode, pEntry, prevLogTerm, &msgOut);
+  int32_t code = syncBuildAppendEntriesFromRaftEntries(pNode, aEntry, numOfEntries, prevLogTerm, &msgOut);
   if (code < 0) {
     sError("vgId:%d, failed to get append entries for index:%" PRId64 "", pNode->vgId, index);
-    goto _err;
+    goto _out;
   }
 
   (void)syncNodeSendAppendEntries(pNode, pDestId, &msgOut);
+  msgOut.pCont = NULL;
 
-  sTrace("vgId:%d, replicate one msg index:%" PRId64 " term:%" PRId64 " prevterm:%" PRId64 " to dest: 0x%016" PRIx64,
-         pNode->vgId, pEntry->index, pEntry->term, prevLogTerm, pDestId->addr);
+  sTrace("vgId:%d, replicate %d msgs index:%" PRId64 " term:%" PRId64 " prevterm:%" PRId64 " to dest: 0x%016" PRIx64,
+         pNode->vgId, numOfEntries, index, aTerm[0], prevLogTerm, pDestId->addr);
 
-  if (!inBuf) {
-    syncEntryDestroy(pEntry);
-    pEntry = NULL;
-  }
-  return 0;
+  *pNum = numOfEntries;
+  ret = 0;
 
-_err:
+_out:
   rpcFreeCont(msgOut.pCont);
-  msgOut.pCont = NULL;
-  if (!inBuf) {
-    syncEntryDestroy(pEntry);
-    pEntry = NULL;
+  for (int32_t i = 0; i < numOfEntries; i++) {
+    if (!aInBuf[i]) syncEntryDestroy(aEntry[i]);
   }
-  return -1;
+  return ret;
 }
@@ -74,6 +74,42 @@ SSyncRaftEntry* syncEntryBuildFromAppendEntries(const SyncAppendEntries* pMsg) {
   return pEntry;
 }
 
+// Decode the entries packed in an append entries msg, which may hold more than one of them if it is a batch.
+int32_t syncEntriesBuildFromAppendEntries(const SyncAppendEntries* pMsg, SSyncRaftEntry** aEntry, int32_t maxNum,
+                                          int32_t* pNum) {
+  uint32_t offset = 0;
+  int32_t  num = 0;
+
+  while (offset < pMsg->dataLen) {
+    const SSyncRaftEntry* pData = (const SSyncRaftEntry*)(pMsg->data + offset);
+    if (num >= maxNum || pMsg->dataLen - offset < sizeof(SSyncRaftEntry) || pData->bytes < sizeof(SSyncRaftEntry) ||
+        pData->bytes > pMsg->dataLen - offset) {
+      terrno = TSDB_CODE_INVALID_MSG;
+      goto _err;
+    }
+
+    SSyncRaftEntry* pEntry = taosMemoryMalloc(pData->bytes);
+    if (pEntry == NULL) {
+      terrno = TSDB_CODE_OUT_OF_MEMORY;
+      goto _err;
+    }
+    memcpy(pEntry, pData, pData->bytes);
+    aEntry[num++] = pEntry;
+    offset += pData->bytes;
+  }
+
+  *pNum = num;
+  return 0;
+
+_err:
+  for (int32_t i = 0; i < num; i++) {
+    syncEntryDestroy(aEntry[i]);
+    aEntry[i] = NULL;
+  }
+  *pNum = 0;
+  return -1;
+}
+
 SSyncRaftEntry* syncEntryBuildNoop(SyncTerm term, SyncIndex index, int32_t vgId) {
   SSyncRaftEntry* pEntry = syncEntryBuild(sizeof(SMsgHead));
   if (pEntry == NULL) return NULL;
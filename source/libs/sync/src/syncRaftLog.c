@@ -25,6 +25,8 @@
 static int32_t   raftLogRestoreFromSnapshot(struct SSyncLogStore* pLogStore, SyncIndex snapshotIndex);
 static int32_t   raftLogAppendEntry(struct SSyncLogStore* pLogStore, SSyncRaftEntry* pEntry, bool forceSync);
 static int32_t   raftLogTruncate(struct SSyncLogStore* pLogStore, SyncIndex fromIndex);
+static int32_t   raftLogFlush(struct SSyncLogStore* pLogStore, bool forceSync);
+static SyncIndex raftLogFlushedIndex(struct SSyncLogStore* pLogStore);
 static bool      raftLogExist(struct SSyncLogStore* pLogStore, SyncIndex index);
 static int32_t   raftLogUpdateCommitIndex(SSyncLogStore* pLogStore, SyncIndex index);
 static SyncIndex raftlogCommitIndex(SSyncLogStore* pLogStore);
@@ -75,6 +77,8 @@ SSyncLogStore* logStoreCreate(SSyncNode* pSyncNode) {
   pLogStore->syncLogAppendEntry = raftLogAppendEntry;
   pLogStore->syncLogGetEntry = raftLogGetEntry;
   pLogStore->syncLogTruncate = raftLogTruncate;
+  pLogStore->syncLogFlush = raftLogFlush;
+  pLogStore->syncLogFlushedIndex = raftLogFlushedIndex;
   pLogStore->syncLogWriteIndex = raftLogWriteIndex;
   pLogStore->syncLogExist = raftLogExist;
 
@@ -236,6 +240,24 @@ static int32_t raftLogAppendEntry(struct SSyncLogStore* pLogStore, SSyncRaftEntr
   return 0;
 }
 
+// write out entries staged by wal group commit
+static int32_t raftLogFlush(struct SSyncLogStore* pLogStore, bool forceSync) {
+  SSyncLogStoreData* pData = pLogStore->data;
+  SWal*              pWal = pData->pWal;
+
+  if (walGroupFlush(pWal, forceSync) < 0) {
+    sNError(pData->pSyncNode, "wal group flush error, err:0x%x, msg:%s", terrno, tstrerror(terrno));
+    return -1;
+  }
+  return 0;
+}
+
+static SyncIndex raftLogFlushedIndex(struct SSyncLogStore* pLogStore) {
+  SSyncLogStoreData* pData = pLogStore->data;
+  SWal*              pWal = pData->pWal;
+  return walGetFlushedVer(pWal);
+}
+
 // entry found, return 0
 // entry not found, return -1, terrno = TSDB_CODE_WAL_LOG_NOT_EXIST
 // other error, return -1
@@ -0,0 +1,228 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define _DEFAULT_SOURCE
+#include "syncReadIndex.h"
+#include "syncMessage.h"
+#include "syncPipeline.h"
+#include "syncRaftStore.h"
+#include "syncUtil.h"
+
+SSyncReadIndexMgr* syncReadIndexMgrCreate() {
+  SSyncReadIndexMgr* pMgr = taosMemoryCalloc(1, sizeof(SSyncReadIndexMgr));
+  if (pMgr == NULL) {
+    terrno = TSDB_CODE_OUT_OF_MEMORY;
+    return NULL;
+  }
+
+  pMgr->readIndex = SYNC_INDEX_INVALID;
+  taosThreadMutexInit(&pMgr->mutex, NULL);
+  taosThreadCondInit(&pMgr->cond, NULL);
+  return pMgr;
+}
+
+void syncReadIndexMgrDestroy(SSyncReadIndexMgr* pMgr) {
+  if (pMgr == NULL) return;
+
+  taosThreadCondDestroy(&pMgr->cond);
+  taosThreadMutexDestroy(&pMgr->mutex);
+  taosMemoryFree(pMgr);
+}
+
+// The leader holds the lease while a quorum of voters has acked heartbeats of its term sent within half of the
+// election timeout: none of them can have started an election since, so no other leader can have committed anything.
+bool syncNodeHasLeaderLease(SSyncNode* pSyncNode) {
+  if (pSyncNode->state != TAOS_SYNC_STATE_LEADER || !pSyncNode->restoreFinish) {
+    return false;
+  }
+
+  SyncTerm term = raftStoreGetTerm(pSyncNode);
+  int64_t  leaseMs = pSyncNode->electBaseLine / 2;
+  int64_t  tsNow = taosGetTimestampMs();
+  int32_t  count = 1;
+  for (int32_t i = 0; i < pSyncNode->peersNum; ++i) {
+    if (pSyncNode->peersNodeInfo[i].nodeRole == TAOS_SYNC_ROLE_LEARNER) {
+      continue;
+    }
+    SSyncLogReplMgr* pMgr = syncNodeGetLogReplMgr(pSyncNode, &(pSyncNode->peersId[i]));
+    if (pMgr != NULL && pMgr->leaseTerm == term && tsNow - pMgr->leaseTimeMs < leaseMs) {
+      count++;
+    }
+  }
+
+  return count >= pSyncNode->quorum;
+}
+
+// called with pMgr->mutex held
+static int32_t syncReadIndexMgrSend(SSyncReadIndexMgr* pMgr, SSyncNode* pSyncNode) {
+  SRaftId leaderId = pSyncNode->leaderCache;
+  if (syncUtilSameId(&leaderId, &EMPTY_RAFT_ID) || syncUtilSameId(&leaderId, &pSyncNode->myRaftId)) {
+    terrno = TSDB_CODE_SYN_NOT_LEADER;
+    return -1;
+  }
+
+  SRpcMsg rpcMsg = {0};
+  if (syncBuildReadIndex(&rpcMsg, pSyncNode->vgId) != 0) {
+    return -1;
+  }
+
+  SyncReadIndex* pMsg = rpcMsg.pCont;
+  pMsg->srcId = pSyncNode->myRaftId;
+  pMsg->destId = leaderId;
+  pMsg->term = raftStoreGetTerm(pSyncNode);
+  pMsg->seq = pMgr->sendSeq + 1;
+
+  sNTrace(pSyncNode, "send read index to dnode:%d, seq:%" PRId64, DID(&leaderId), pMsg->seq);
+  if (syncNodeSendMsgById(&leaderId, pSyncNode, &rpcMsg) != 0) {
+    return -1;
+  }
+
+  pMgr->sendSeq++;
+  pMgr->sendTimeMs = taosGetTimestampMs();
+  pMgr->pending = false;
+  return 0;
+}
+
+// A reply of the leader comes back within a heartbeat interval, a round older than that is taken as lost. A reader
+// of a lost round fails at once rather than holding its query worker till the timeout, a pending one sends the next
+// round itself.
+int32_t syncNodeReadIndex(SSyncNode* pSyncNode, int32_t timeoutMs, SyncIndex* pIndex) {
+  if (pSyncNode->state == TAOS_SYNC_STATE_LEADER || pSyncNode->state == TAOS_SYNC_STATE_ASSIGNED_LEADER) {
+    if (!syncNodeIsReadyForRead(pSyncNode)) return -1;
+    *pIndex = pSyncNode->commitIndex;
+    return 0;
+  }
+
+  if (pSyncNode->state != TAOS_SYNC_STATE_FOLLOWER && pSyncNode->state != TAOS_SYNC_STATE_LEARNER) {
+    terrno = TSDB_CODE_SYN_NOT_LEADER;
+    return -1;
+  }
+
+  SSyncReadIndexMgr* pMgr = pSyncNode->pReadIndexMgr;
+  int64_t            lostMs = TMIN(pSyncNode->hbBaseLine, timeoutMs);
+  int64_t            deadline = taosGetTimestampMs() + timeoutMs;
+  int64_t            waitSeq = 0;
+  int32_t            code = 0;
+
+  taosThreadMutexLock(&pMgr->mutex);
+
+  // join the next round if one is in flight
+  if (pMgr->recvSeq < pMgr->sendSeq && taosGetTimestampMs() - pMgr->sendTimeMs < lostMs) {
+    pMgr->pending = true;
+    waitSeq = pMgr->sendSeq + 1;
+  } else if (syncReadIndexMgrSend(pMgr, pSyncNode) == 0) {
+    waitSeq = pMgr->sendSeq;
+  } else {
+    code = -1;
+    goto _out;
+  }
+
+  while (pMgr->recvSeq < waitSeq) {
+    int64_t tsNow = taosGetTimestampMs();
+    if (tsNow >= deadline) break;
+
+    if (waitSeq <= pMgr->sendSeq) {
+      if (tsNow - pMgr->sendTimeMs >= lostMs) {
+        sNDebug(pSyncNode, "read index seq:%" PRId64 " lost, sent %" PRId64 "ms ago", pMgr->sendSeq,
+                tsNow - pMgr->sendTimeMs);
+        break;
+      }
+    } else if (pMgr->recvSeq >= pMgr->sendSeq || tsNow - pMgr->sendTimeMs >= lostMs) {
+      // the round before is answered without the next one sent, or lost
+      if (syncReadIndexMgrSend(pMgr, pSyncNode) != 0) {
+        code = -1;
+        goto _out;
+      }
+      waitSeq = pMgr->sendSeq;
+    }
+
+    int64_t         wakeTime = TMIN(deadline, pMgr->sendTimeMs + lostMs);
+    struct timespec ts = {.tv_sec = wakeTime / 1000, .tv_nsec = (wakeTime % 1000) * 1000000};
+    taosThreadCondTimedWait(&pMgr->cond, &pMgr->mutex, &ts);
+  }
+
+  if (pMgr->recvSeq < waitSeq) {
+    terrno = TSDB_CODE_SYN_TIMEOUT;
+    code = -1;
+  } else if (pMgr->code != 0) {
+    terrno = pMgr->code;
+    code = -1;
+  } else {
+    *pIndex = pMgr->readIndex;
+  }
+
+_out:
+  taosThreadMutexUnlock(&pMgr->mutex);
+  if (code != 0) {
+    sNDebug(pSyncNode, "failed to get read index since %s", terrstr());
+  }
+  return code;
+}
+
+int32_t syncNodeOnReadIndex(SSyncNode* ths, const SRpcMsg* pRpcMsg) {
+  SyncReadIndex* pMsg = pRpcMsg->pCont;
+
+  if (!syncNodeInRaftGroup(ths, &pMsg->srcId)) {
+    sWarn("vgId:%d, drop read index msg from dnode:%d, since it's not in my raft group", ths->vgId,
+          DID(&pMsg->srcId));
+    return 0;
+  }
+
+  SRpcMsg rpcMsg = {0};
+  if (syncBuildReadIndexReply(&rpcMsg, ths->vgId) != 0) {
+    return -1;
+  }
+
+  SyncReadIndexReply* pReply = rpcMsg.pCont;
+  pReply->srcId = ths->myRaftId;
+  pReply->destId = pMsg->srcId;
+  pReply->term = raftStoreGetTerm(ths);
+  pReply->seq = pMsg->seq;
+
+  if (pMsg->term <= pReply->term && syncNodeHasLeaderLease(ths)) {
+    pReply->commitIndex = ths->commitIndex;
+    pReply->code = 0;
+  } else {
+    pReply->commitIndex = SYNC_INDEX_INVALID;
+    pReply->code = TSDB_CODE_SYN_NOT_LEADER;
+  }
+
+  sNTrace(ths, "recv read index from dnode:%d, seq:%" PRId64 ", reply commit index:%" PRId64 ", code:0x%x",
+          DID(&pMsg->srcId), pMsg->seq, pReply->commitIndex, pReply->code);
+  syncNodeSendMsgById(&pReply->destId, ths, &rpcMsg);
+  return 0;
+}
+
+int32_t syncNodeOnReadIndexReply(SSyncNode* ths, const SRpcMsg* pRpcMsg) {
+  SyncReadIndexReply* pMsg = pRpcMsg->pCont;
+  SSyncReadIndexMgr*  pMgr = ths->pReadIndexMgr;
+
+  taosThreadMutexLock(&pMgr->mutex);
+  if (pMsg->seq > pMgr->recvSeq && pMsg->seq <= pMgr->sendSeq) {
+    pMgr->recvSeq = pMsg->seq;
+    pMgr->code = pMsg->code;
+    pMgr->readIndex = pMsg->commitIndex;
+
+    if (pMgr->pending && pMgr->recvSeq == pMgr->sendSeq && syncReadIndexMgrSend(pMgr, ths) != 0) {
+      sNDebug(ths, "failed to send read index for pending readers since %s", terrstr());
+    }
+    taosThreadCondBroadcast(&pMgr->cond);
+  }
+  taosThreadMutexUnlock(&pMgr->mutex);
+
+  sNTrace(ths, "recv read index reply from dnode:%d, seq:%" PRId64 ", commit index:%" PRId64 ", code:0x%x",
+          DID(&pMsg->srcId), pMsg->seq, pMsg->commitIndex, pMsg->code);
+  return 0;
+}
@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "syncPipeline.h"
+#include "syncRaftEntry.h"
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wwrite-strings"
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#pragma GCC diagnostic ignored "-Wsign-compare"
+
+namespace {
+
+SSyncRaftEntry *createEntry(SyncIndex index, SyncTerm term) {
+  SSyncRaftEntry *pEntry = syncEntryBuild(16);
+  pEntry->index = index;
+  pEntry->term = term;
+  snprintf(pEntry->data, pEntry->dataLen, "value_%" PRId64, index);
+  return pEntry;
+}
+
+// a follower whose log buffer holds the entry of index 0 of term 1, matched and committed
+class SyncLogBufferTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    pNode = (SSyncNode *)taosMemoryCalloc(1, sizeof(SSyncNode));
+    ASSERT_NE(pNode, nullptr);
+    pNode->vgId = 2;
+    pNode->raftCfg.cfg.myIndex = 0;
+    pNode->raftCfg.cfg.nodeInfo[0].nodeRole = TAOS_SYNC_ROLE_VOTER;
+
+    pBuf = syncLogBufferCreate();
+    ASSERT_NE(pBuf, nullptr);
+    pBuf->entries[0].pItem = createEntry(0, 1);
+    pBuf->entries[0].prevLogIndex = -1;
+    pBuf->entries[0].prevLogTerm = 0;
+    pBuf->startIndex = pBuf->commitIndex = pBuf->matchIndex = 0;
+    pBuf->endIndex = 1;
+    pNode->pLogBuf = pBuf;
+  }
+
+  void TearDown() override {
+    syncLogBufferDestroy(pBuf);
+    taosMemoryFree(pNode);
+  }
+
+  // entries from index 1 on, of the given terms
+  int32_t acceptBatch(const std::vector<SyncTerm> &terms, SyncTerm prevTerm) {
+    SSyncRaftEntry *aEntry[SYNC_LOG_REPL_BATCH_MAX_NUM] = {0};
+    for (int32_t i = 0; i < terms.size(); i++) {
+      aEntry[i] = createEntry(i + 1, terms[i]);
+    }
+    return syncLogBufferAcceptBatch(pBuf, pNode, aEntry, terms.size(), prevTerm);
+  }
+
+  SSyncNode      *pNode = nullptr;
+  SSyncLogBuffer *pBuf = nullptr;
+};
+
+}  // namespace
+
+TEST_F(SyncLogBufferTest, acceptBatchOfOneTerm) {
+  ASSERT_EQ(acceptBatch({1, 1, 1, 1}, 1), 0);
+  ASSERT_EQ(pBuf->endIndex, 5);
+  ASSERT_EQ(pBuf->matchIndex, 0);
+  for (SyncIndex index = 1; index < 5; index++) {
+    SSyncLogBufEntry *pBufEntry = &pBuf->entries[index % pBuf->size];
+    ASSERT_NE(pBufEntry->pItem, nullptr);
+    ASSERT_EQ(pBufEntry->pItem->index, index);
+    ASSERT_EQ(pBufEntry->prevLogIndex, index - 1);
+    ASSERT_EQ(pBufEntry->prevLogTerm, 1);
+  }
+}
+
+TEST_F(SyncLogBufferTest, acceptBatchOfSeveralTerms) {
+  // only the first entry is checked against the last match term, the rest are chained to the entry before them
+  std::vector<SyncTerm> terms = {2, 2, 3, 5, 5};
+  ASSERT_EQ(acceptBatch(terms, 1), 0);
+  ASSERT_EQ(pBuf->endIndex, 6);
+  ASSERT_EQ(pBuf->matchIndex, 0);
+
+  SyncTerm prevTerm = 1;
+  for (SyncIndex index = 1; index < 6; index++) {
+    SSyncLogBufEntry *pBufEntry = &pBuf->entries[index % pBuf->size];
+    ASSERT_NE(pBufEntry->pItem, nullptr);
+    ASSERT_EQ(pBufEntry->pItem->term, terms[index - 1]);
+    ASSERT_EQ(pBufEntry->prevLogTerm, prevTerm) << "index " << index;
+    prevTerm = pBufEntry->pItem->term;
+  }
+}
+
+TEST_F(SyncLogBufferTest, rejectBatchOfMismatchedPrevTerm) {
+  // the leader's entry before the batch is of another term, none of the batch is accepted
+  ASSERT_LT(acceptBatch({2, 2, 3}, 2), 0);
+  ASSERT_EQ(pBuf->endIndex, 1);
+  for (SyncIndex index = 1; index < 4; index++) {
+    ASSERT_EQ(pBuf->entries[index % pBuf->size].pItem, nullptr);
+  }
+}
+
+#pragma GCC diagnostic pop
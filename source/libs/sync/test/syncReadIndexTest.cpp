@@ -0,0 +1,286 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+
+#include "syncIndexMgr.h"
+#include "syncMessage.h"
+#include "syncPipeline.h"
+#include "syncReadIndex.h"
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wwrite-strings"
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#pragma GCC diagnostic ignored "-Wsign-compare"
+
+namespace {
+
+#define TEST_VGID        2
+#define TEST_TERM        3
+#define TEST_ELECT_MS    1000
+#define TEST_HB_MS       1000
+#define TEST_REPLICA_NUM 3
+
+std::atomic<int32_t> sendNum(0);
+
+int32_t countAndDropMsg(const SEpSet *pEpSet, SRpcMsg *pMsg) {
+  sendNum++;
+  rpcFreeCont(pMsg->pCont);
+  return 0;
+}
+
+// a voter of three, replica 0 is the node itself
+class SyncReadIndexTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    sendNum = 0;
+    pNode = (SSyncNode *)taosMemoryCalloc(1, sizeof(SSyncNode));
+    ASSERT_NE(pNode, nullptr);
+    pNode->vgId = TEST_VGID;
+    pNode->replicaNum = pNode->totalReplicaNum = TEST_REPLICA_NUM;
+    pNode->peersNum = TEST_REPLICA_NUM - 1;
+    pNode->quorum = TEST_REPLICA_NUM / 2 + 1;
+    pNode->electBaseLine = TEST_ELECT_MS;
+    pNode->hbBaseLine = TEST_HB_MS;
+    pNode->syncSendMSg = countAndDropMsg;
+    for (int32_t i = 0; i < TEST_REPLICA_NUM; i++) {
+      pNode->replicasId[i].addr = 100 + i;
+      pNode->replicasId[i].vgId = TEST_VGID;
+      pNode->logReplMgrs[i] = syncLogReplCreate();
+      ASSERT_NE(pNode->logReplMgrs[i], nullptr);
+      pNode->logReplMgrs[i]->peerId = i;
+    }
+    for (int32_t i = 0; i < pNode->peersNum; i++) {
+      pNode->peersId[i] = pNode->replicasId[i + 1];
+      pNode->peersNodeInfo[i].nodeRole = TAOS_SYNC_ROLE_VOTER;
+    }
+    pNode->myRaftId = pNode->replicasId[0];
+    pNode->raftStore.currentTerm = TEST_TERM;
+    taosThreadMutexInit(&pNode->raftStore.mutex, NULL);
+
+    pNode->pMatchIndex = syncIndexMgrCreate(pNode);
+    pNode->pLogBuf = syncLogBufferCreate();
+    pNode->pReadIndexMgr = syncReadIndexMgrCreate();
+    ASSERT_NE(pNode->pMatchIndex, nullptr);
+    ASSERT_NE(pNode->pLogBuf, nullptr);
+    ASSERT_NE(pNode->pReadIndexMgr, nullptr);
+  }
+
+  void TearDown() override {
+    syncReadIndexMgrDestroy(pNode->pReadIndexMgr);
+    syncLogBufferDestroy(pNode->pLogBuf);
+    syncIndexMgrDestroy(pNode->pMatchIndex);
+    for (int32_t i = 0; i < TEST_REPLICA_NUM; i++) {
+      syncLogReplDestroy(pNode->logReplMgrs[i]);
+    }
+    taosThreadMutexDestroy(&pNode->raftStore.mutex);
+    taosMemoryFree(pNode);
+  }
+
+  void becomeLeader() {
+    pNode->state = TAOS_SYNC_STATE_LEADER;
+    pNode->restoreFinish = true;
+  }
+
+  // the peer acks a heartbeat of the term sent at sendTimeMs
+  void recvHeartbeatReply(int32_t peer, SyncTerm term, int64_t sendTimeMs) {
+    SRpcMsg rpcMsg = {0};
+    ASSERT_EQ(syncBuildHeartbeatReply(&rpcMsg, TEST_VGID), 0);
+    SyncHeartbeatReply *pMsg = (SyncHeartbeatReply *)rpcMsg.pCont;
+    pMsg->srcId = pNode->peersId[peer];
+    pMsg->destId = pNode->myRaftId;
+    pMsg->term = term;
+    pMsg->timeStamp = sendTimeMs;
+    ASSERT_EQ(syncNodeOnHeartbeatReply(pNode, &rpcMsg), 0);
+    rpcFreeCont(rpcMsg.pCont);
+  }
+
+  void recvReadIndexReply(int64_t seq, SyncIndex commitIndex) {
+    SRpcMsg rpcMsg = {0};
+    ASSERT_EQ(syncBuildReadIndexReply(&rpcMsg, TEST_VGID), 0);
+    SyncReadIndexReply *pMsg = (SyncReadIndexReply *)rpcMsg.pCont;
+    pMsg->srcId = pNode->leaderCache;
+    pMsg->destId = pNode->myRaftId;
+    pMsg->term = TEST_TERM;
+    pMsg->seq = seq;
+    pMsg->commitIndex = commitIndex;
+    pMsg->code = 0;
+    ASSERT_EQ(syncNodeOnReadIndexReply(pNode, &rpcMsg), 0);
+    rpcFreeCont(rpcMsg.pCont);
+  }
+
+  // polls until a reader blocks on the read index manager in the given state
+  void waitReadIndexMgr(int64_t sendSeq, bool pending) {
+    SSyncReadIndexMgr *pMgr = pNode->pReadIndexMgr;
+    for (int32_t i = 0; i < 1000; i++) {
+      taosThreadMutexLock(&pMgr->mutex);
+      bool done = pMgr->sendSeq == sendSeq && pMgr->pending == pending;
+      taosThreadMutexUnlock(&pMgr->mutex);
+      if (done) return;
+      taosMsleep(5);
+    }
+    FAIL() << "read index manager not in state, send seq " << sendSeq;
+  }
+
+  SSyncNode *pNode = nullptr;
+};
+
+}  // namespace
+
+TEST_F(SyncReadIndexTest, leaseOfCurrentTermAcks) {
+  becomeLeader();
+  ASSERT_FALSE(syncNodeHasLeaderLease(pNode));
+
+  // one peer and the leader itself make the quorum
+  recvHeartbeatReply(0, TEST_TERM, taosGetTimestampMs());
+  ASSERT_TRUE(syncNodeHasLeaderLease(pNode));
+
+  // a learner or follower has no lease even with the acks
+  pNode->state = TAOS_SYNC_STATE_FOLLOWER;
+  ASSERT_FALSE(syncNodeHasLeaderLease(pNode));
+}
+
+TEST_F(SyncReadIndexTest, leaseIgnoresAcksOfOldTerm) {
+  becomeLeader();
+  recvHeartbeatReply(0, TEST_TERM - 1, taosGetTimestampMs());
+  recvHeartbeatReply(1, TEST_TERM - 1, taosGetTimestampMs());
+  ASSERT_FALSE(syncNodeHasLeaderLease(pNode));
+
+  // acks of the last term do not count after the term moves on
+  recvHeartbeatReply(0, TEST_TERM, taosGetTimestampMs());
+  ASSERT_TRUE(syncNodeHasLeaderLease(pNode));
+  taosThreadMutexLock(&pNode->raftStore.mutex);
+  pNode->raftStore.currentTerm = TEST_TERM + 1;
+  taosThreadMutexUnlock(&pNode->raftStore.mutex);
+  ASSERT_FALSE(syncNodeHasLeaderLease(pNode));
+}
+
+TEST_F(SyncReadIndexTest, leaseTimedFromHeartbeatSend) {
+  becomeLeader();
+
+  // acked just now, but sent longer than half of the election timeout ago
+  int64_t tsNow = taosGetTimestampMs();
+  recvHeartbeatReply(0, TEST_TERM, tsNow - TEST_ELECT_MS / 2 - 10);
+  ASSERT_FALSE(syncNodeHasLeaderLease(pNode));
+
+  // a late reply of an older heartbeat does not move the lease back
+  recvHeartbeatReply(1, TEST_TERM, tsNow);
+  recvHeartbeatReply(1, TEST_TERM, tsNow - TEST_ELECT_MS);
+  ASSERT_TRUE(syncNodeHasLeaderLease(pNode));
+
+  // a send time ahead of the local clock is taken as the receive time
+  SSyncLogReplMgr *pMgr = syncNodeGetLogReplMgr(pNode, &pNode->peersId[0]);
+  recvHeartbeatReply(0, TEST_TERM, taosGetTimestampMs() + 60 * 1000);
+  ASSERT_LE(pMgr->leaseTimeMs, taosGetTimestampMs());
+}
+
+TEST_F(SyncReadIndexTest, leaseNotCountedForLearners) {
+  becomeLeader();
+  pNode->peersNodeInfo[0].nodeRole = TAOS_SYNC_ROLE_LEARNER;
+  recvHeartbeatReply(0, TEST_TERM, taosGetTimestampMs());
+  ASSERT_FALSE(syncNodeHasLeaderLease(pNode));
+
+  recvHeartbeatReply(1, TEST_TERM, taosGetTimestampMs());
+  ASSERT_TRUE(syncNodeHasLeaderLease(pNode));
+}
+
+TEST_F(SyncReadIndexTest, readersShareOneRoundInFlight) {
+  pNode->state = TAOS_SYNC_STATE_FOLLOWER;
+  pNode->leaderCache = pNode->peersId[0];
+
+  int32_t   code[3] = {-1, -1, -1};
+  SyncIndex index[3] = {SYNC_INDEX_INVALID, SYNC_INDEX_INVALID, SYNC_INDEX_INVALID};
+  auto      reader = [&](int32_t i) { code[i] = syncNodeReadIndex(pNode, 5000, &index[i]); };
+
+  // the first reader sends round 1, the second one waits for the round after it
+  std::thread r0(reader, 0);
+  waitReadIndexMgr(1, false);
+  std::thread r1(reader, 1);
+  waitReadIndexMgr(1, true);
+  ASSERT_EQ(sendNum, 1);
+
+  // the reply of round 1 serves the first reader and sends round 2 for the pending one
+  recvReadIndexReply(1, 10);
+  r0.join();
+  ASSERT_EQ(code[0], 0);
+  ASSERT_EQ(index[0], 10);
+  ASSERT_EQ(sendNum, 2);
+
+  std::thread r2(reader, 2);
+  waitReadIndexMgr(2, true);
+
+  // stale and unknown replies are dropped
+  recvReadIndexReply(1, 15);
+  recvReadIndexReply(3, 15);
+  ASSERT_EQ(pNode->pReadIndexMgr->recvSeq, 1);
+
+  recvReadIndexReply(2, 20);
+  r1.join();
+  ASSERT_EQ(code[1], 0);
+  ASSERT_EQ(index[1], 20);
+  ASSERT_EQ(sendNum, 3);
+
+  recvReadIndexReply(3, 30);
+  r2.join();
+  ASSERT_EQ(code[2], 0);
+  ASSERT_EQ(index[2], 30);
+  ASSERT_EQ(sendNum, 3);
+}
+
+TEST_F(SyncReadIndexTest, lostRoundFailsFast) {
+  pNode->state = TAOS_SYNC_STATE_FOLLOWER;
+  pNode->leaderCache = pNode->peersId[0];
+  pNode->hbBaseLine = 100;
+
+  int32_t   code[2] = {-1, -1};
+  int32_t   err[2] = {0, 0};
+  int64_t   elapsed[2] = {0, 0};
+  SyncIndex index[2] = {SYNC_INDEX_INVALID, SYNC_INDEX_INVALID};
+  auto      reader = [&](int32_t i) {
+    int64_t startMs = taosGetTimestampMs();
+    code[i] = syncNodeReadIndex(pNode, 5000, &index[i]);
+    err[i] = terrno;
+    elapsed[i] = taosGetTimestampMs() - startMs;
+  };
+
+  std::thread r0(reader, 0);
+  waitReadIndexMgr(1, false);
+  std::thread r1(reader, 1);
+  waitReadIndexMgr(1, true);
+
+  // the reply of round 1 never comes, its reader gives up after a heartbeat interval instead of the timeout
+  r0.join();
+  ASSERT_NE(code[0], 0);
+  ASSERT_EQ(err[0], TSDB_CODE_SYN_TIMEOUT);
+  ASSERT_LT(elapsed[0], 2500);
+
+  // the pending reader sends the next round itself
+  waitReadIndexMgr(2, false);
+  ASSERT_EQ(sendNum, 2);
+  recvReadIndexReply(2, 20);
+  r1.join();
+  ASSERT_EQ(code[1], 0);
+  ASSERT_EQ(index[1], 20);
+
+  // a reader coming after a lost round sends a round of its own rather than joining it
+  SyncIndex index2 = SYNC_INDEX_INVALID;
+  ASSERT_NE(syncNodeReadIndex(pNode, 5000, &index2), 0);
+  ASSERT_EQ(sendNum, 3);
+  std::thread r2([&]() { code[0] = syncNodeReadIndex(pNode, 5000, &index2); });
+  waitReadIndexMgr(4, false);
+  recvReadIndexReply(4, 40);
+  r2.join();
+  ASSERT_EQ(code[0], 0);
+  ASSERT_EQ(index2, 40);
+}
+
+TEST_F(SyncReadIndexTest, readIndexWithoutLeaderFails) {
+  pNode->state = TAOS_SYNC_STATE_FOLLOWER;
+  SyncIndex index = SYNC_INDEX_INVALID;
+  ASSERT_NE(syncNodeReadIndex(pNode, 100, &index), 0);
+  ASSERT_EQ(terrno, TSDB_CODE_SYN_NOT_LEADER);
+  ASSERT_EQ(sendNum, 0);
+}
+
+#pragma GCC diagnostic pop
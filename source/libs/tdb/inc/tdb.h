@@ -32,6 +32,8 @@ typedef struct STBC TBC;
 typedef struct STxn TXN;
 
 // TDB
+void tdbSetPCacheShards(int32_t nShard);  // number of page cache shards of a new TDB, 0 for by the cache size
+
 int32_t tdbOpen(const char *dbname, int szPage, int pages, TDB **ppDb, int8_t rollback, int32_t encryptAlgorithm,
                 char *encryptKey);
 int32_t tdbClose(TDB *pDb);
@@ -17,10 +17,10 @@
 // #include <sys/types.h>
 // #include <unistd.h>
 
-struct SPCache {
-  int         szPage;
-  int         nPages;
-  SPage     **aPage;
+// The cache is split into nShard segments by the page id hash, each has its own lock, hash table, free list and LRU,
+// so that the readers of different pages do not serialize on one mutex. A local page never leaves the segment it
+// was assigned to when the cache is opened or altered.
+typedef struct {
   tdb_mutex_t mutex;
   int         nFree;
   SPage      *pFree;
@@ -29,25 +29,68 @@ struct SPCache {
   SPage     **pgHash;
   int         nRecyclable;
   SPage       lru;
+} SPCacheShard;
+
+struct SPCache {
+  int           szPage;
+  int           nPages;
+  SPage       **aPage;
+  int           nShard;
+  SPCacheShard *aShard;
 };
 
+#define TDB_PCACHE_MAX_SHARDS      16
+#define TDB_PCACHE_MIN_SHARD_PAGES 256
+
+static int32_t tdbPCacheShards = 0;
+
+void tdbSetPCacheShards(int32_t nShard) { tdbPCacheShards = nShard < 0 ? 0 : TMIN(nShard, TDB_PCACHE_MAX_SHARDS); }
+
 static inline uint32_t tdbPCachePageHash(const SPgid *pPgid) {
   uint32_t *t = (uint32_t *)((pPgid)->fileid);
   return (uint32_t)(t[0] + t[1] + t[2] + t[3] + t[4] + t[5] + (pPgid)->pgno);
 }
 
+static inline SPCacheShard *tdbPCacheGetShard(SPCache *pCache, const SPgid *pPgid) {
+  return &pCache->aShard[tdbPCachePageHash(pPgid) % pCache->nShard];
+}
+
+// the low bits of the hash pick the shard, use the rest for the bucket
+static inline uint32_t tdbPCacheBucket(SPCache *pCache, SPCacheShard *pShard, const SPgid *pPgid) {
+  return tdbPCachePageHash(pPgid) / pCache->nShard % pShard->nHash;
+}
+
 static int    tdbPCacheOpenImpl(SPCache *pCache);
-static SPage *tdbPCacheFetchImpl(SPCache *pCache, const SPgid *pPgid, TXN *pTxn);
-static void   tdbPCachePinPage(SPCache *pCache, SPage *pPage);
-static void   tdbPCacheRemovePageFromHash(SPCache *pCache, SPage *pPage);
-static void   tdbPCacheAddPageToHash(SPCache *pCache, SPage *pPage);
-static void   tdbPCacheUnpinPage(SPCache *pCache, SPage *pPage);
+static SPage *tdbPCacheFetchImpl(SPCache *pCache, SPCacheShard *pShard, const SPgid *pPgid, TXN *pTxn);
+static void   tdbPCachePinPage(SPCacheShard *pShard, SPage *pPage);
+static void   tdbPCacheRemovePageFromHash(SPCache *pCache, SPCacheShard *pShard, SPage *pPage);
+static void   tdbPCacheAddPageToHash(SPCache *pCache, SPCacheShard *pShard, SPage *pPage);
+static void   tdbPCacheUnpinPage(SPCache *pCache, SPCacheShard *pShard, SPage *pPage);
 static int    tdbPCacheCloseImpl(SPCache *pCache);
 
-static void tdbPCacheInitLock(SPCache *pCache) { tdbMutexInit(&(pCache->mutex), NULL); }
-static void tdbPCacheDestroyLock(SPCache *pCache) { tdbMutexDestroy(&(pCache->mutex)); }
-static void tdbPCacheLock(SPCache *pCache) { tdbMutexLock(&(pCache->mutex)); }
-static void tdbPCacheUnlock(SPCache *pCache) { tdbMutexUnlock(&(pCache->mutex)); }
+static void tdbPCacheInitLock(SPCacheShard *pShard) { tdbMutexInit(&(pShard->mutex), NULL); }
+static void tdbPCacheDestroyLock(SPCacheShard *pShard) { tdbMutexDestroy(&(pShard->mutex)); }
+static void tdbPCacheLock(SPCacheShard *pShard) { tdbMutexLock(&(pShard->mutex)); }
+static void tdbPCacheUnlock(SPCacheShard *pShard) { tdbMutexUnlock(&(pShard->mutex)); }
+
+static void tdbPCacheLockAll(SPCache *pCache) {
+  for (int32_t iShard = 0; iShard < pCache->nShard; iShard++) {
+    tdbPCacheLock(&pCache->aShard[iShard]);
+  }
+}
+
+static void tdbPCacheUnlockAll(SPCache *pCache) {
+  for (int32_t iShard = pCache->nShard - 1; iShard >= 0; iShard--) {
+    tdbPCacheUnlock(&pCache->aShard[iShard]);
+  }
+}
+
+// A page is recycled only inside its own shard, so every shard keeps enough pages for the cursors pinning it.
+static int tdbPCacheGetNumOfShards(int cacheSize) {
+  int nShard = tdbPCacheShards > 0 ? tdbPCacheShards : TDB_PCACHE_MAX_SHARDS;
+  if (nShard > cacheSize / TDB_PCACHE_MIN_SHARD_PAGES) nShard = cacheSize / TDB_PCACHE_MIN_SHARD_PAGES;
+  return nShard < 1 ? 1 : nShard;
+}
 
 int tdbPCacheOpen(int pageSize, int cacheSize, SPCache **ppCache) {
   SPCache *pCache;
@@ -67,7 +110,17 @@ int tdbPCacheOpen(int pageSize, int cacheSize, SPCache **ppCache) {
     return -1;
   }
 
+  pCache->nShard = tdbPCacheGetNumOfShards(cacheSize);
+  pCache->aShard = (SPCacheShard *)tdbOsCalloc(pCache->nShard, sizeof(SPCacheShard));
+  if (pCache->aShard == NULL) {
+    tdbOsFree(pCache->aPage);
+    tdbOsFree(pCache);
+    return -1;
+  }
+
   if (tdbPCacheOpenImpl(pCache) < 0) {
+    tdbOsFree(pCache->aShard);
+    tdbOsFree(pCache->aPage);
     tdbOsFree(pCache);
     return -1;
   }
@@ -79,6 +132,7 @@ int tdbPCacheOpen(int pageSize, int cacheSize, SPCache **ppCache) {
 int tdbPCacheClose(SPCache *pCache) {
   if (pCache) {
     tdbPCacheCloseImpl(pCache);
+    tdbOsFree(pCache->aShard);
     tdbOsFree(pCache->aPage);
     tdbOsFree(pCache);
   }
@@ -122,11 +176,13 @@ static int tdbPCacheAlterImpl(SPCache *pCache, int32_t nPage) {
       aPage[iPage]->id = iPage;
     }
 
-    // add page to free list
+    // add page to free list, spread over the shards
     for (int32_t iPage = pCache->nPages; iPage < nPage; iPage++) {
-      aPage[iPage]->pFreeNext = pCache->pFree;
-      pCache->pFree = aPage[iPage];
-      pCache->nFree++;
+      SPCacheShard *pShard = &pCache->aShard[iPage % pCache->nShard];
+
+      aPage[iPage]->pFreeNext = pShard->pFree;
+      pShard->pFree = aPage[iPage];
+      pShard->nFree++;
     }
 
     for (int32_t iPage = 0; iPage < pCache->nPages; iPage++) {
@@ -136,17 +192,21 @@ static int tdbPCacheAlterImpl(SPCache *pCache, int32_t nPage) {
     tdbOsFree(pCache->aPage);
     pCache->aPage = aPage;
   } else {
-    for (SPage **ppPage = &pCache->pFree; *ppPage;) {
-      int32_t iPage = (*ppPage)->id;
-
-      if (iPage >= nPage) {
-        SPage *pPage = *ppPage;
-        *ppPage = pPage->pFreeNext;
-        pCache->aPage[pPage->id] = NULL;
-        tdbPageDestroy(pPage, tdbDefaultFree, NULL);
-        pCache->nFree--;
-      } else {
-        ppPage = &(*ppPage)->pFreeNext;
+    for (int32_t iShard = 0; iShard < pCache->nShard; iShard++) {
+      SPCacheShard *pShard = &pCache->aShard[iShard];
+
+      for (SPage **ppPage = &pShard->pFree; *ppPage;) {
+        int32_t iPage = (*ppPage)->id;
+
+        if (iPage >= nPage) {
+          SPage *pPage = *ppPage;
+          *ppPage = pPage->pFreeNext;
+          pCache->aPage[pPage->id] = NULL;
+          tdbPageDestroy(pPage, tdbDefaultFree, NULL);
+          pShard->nFree--;
+        } else {
+          ppPage = &(*ppPage)->pFreeNext;
+        }
       }
     }
   }
@@ -158,27 +218,28 @@ static int tdbPCacheAlterImpl(SPCache *pCache, int32_t nPage) {
 int tdbPCacheAlter(SPCache *pCache, int32_t nPage) {
   int ret = 0;
 
-  tdbPCacheLock(pCache);
+  tdbPCacheLockAll(pCache);
 
   ret = tdbPCacheAlterImpl(pCache, nPage);
 
-  tdbPCacheUnlock(pCache);
+  tdbPCacheUnlockAll(pCache);
 
   return ret;
 }
 
 SPage *tdbPCacheFetch(SPCache *pCache, const SPgid *pPgid, TXN *pTxn) {
-  SPage *pPage;
-  i32    nRef = 0;
+  SPCacheShard *pShard = tdbPCacheGetShard(pCache, pPgid);
+  SPage        *pPage;
+  i32           nRef = 0;
 
-  tdbPCacheLock(pCache);
+  tdbPCacheLock(pShard);
 
-  pPage = tdbPCacheFetchImpl(pCache, pPgid, pTxn);
+  pPage = tdbPCacheFetchImpl(pCache, pShard, pPgid, pTxn);
   if (pPage) {
     nRef = tdbRefPage(pPage);
   }
 
-  tdbPCacheUnlock(pCache);
+  tdbPCacheUnlock(pShard);
 
   // printf("thread %" PRId64 " fetch page %d pgno %d pPage %p nRef %d\n", taosGetSelfPthreadId(), pPage->id,
   //        TDB_PAGE_PGNO(pPage), pPage, nRef);
@@ -193,36 +254,40 @@ SPage *tdbPCacheFetch(SPCache *pCache, const SPgid *pPgid, TXN *pTxn) {
 }
 
 void tdbPCacheMarkFree(SPCache *pCache, SPage *pPage) {
-  tdbPCacheLock(pCache);
-  tdbPCacheRemovePageFromHash(pCache, pPage);
+  SPCacheShard *pShard = tdbPCacheGetShard(pCache, &pPage->pgid);
+
+  tdbPCacheLock(pShard);
+  tdbPCacheRemovePageFromHash(pCache, pShard, pPage);
   pPage->isFree = 1;
-  tdbPCacheUnlock(pCache);
+  tdbPCacheUnlock(pShard);
 }
 
-static void tdbPCacheFreePage(SPCache *pCache, SPage *pPage) {
+static void tdbPCacheFreePage(SPCache *pCache, SPCacheShard *pShard, SPage *pPage) {
   if (pPage->id < pCache->nPages) {
-    pPage->pFreeNext = pCache->pFree;
-    pCache->pFree = pPage;
+    pPage->pFreeNext = pShard->pFree;
+    pShard->pFree = pPage;
     pPage->isFree = 0;
-    ++pCache->nFree;
+    ++pShard->nFree;
     tdbTrace("pcache/free page %p/%d, pgno:%d, ", pPage, pPage->id, TDB_PAGE_PGNO(pPage));
   } else {
     tdbTrace("pcache/free2 page: %p/%d, pgno:%d, ", pPage, pPage->id, TDB_PAGE_PGNO(pPage));
 
-    tdbPCacheRemovePageFromHash(pCache, pPage);
+    tdbPCacheRemovePageFromHash(pCache, pShard, pPage);
     tdbPageDestroy(pPage, tdbDefaultFree, NULL);
   }
 }
 
 void tdbPCacheInvalidatePage(SPCache *pCache, SPager *pPager, SPgno pgno) {
-  SPgid        pgid;
-  const SPgid *pPgid = &pgid;
-  SPage       *pPage = NULL;
+  SPgid         pgid;
+  const SPgid  *pPgid = &pgid;
+  SPage        *pPage = NULL;
+  SPCacheShard *pShard;
 
   memcpy(&pgid, pPager->fid, TDB_FILE_ID_LEN);
   pgid.pgno = pgno;
 
-  pPage = pCache->pgHash[tdbPCachePageHash(pPgid) % pCache->nHash];
+  pShard = tdbPCacheGetShard(pCache, pPgid);
+  pPage = pShard->pgHash[tdbPCacheBucket(pCache, pShard, pPgid)];
   while (pPage) {
     if (pPage->pgid.pgno == pPgid->pgno && memcmp(pPage->pgid.fileid, pPgid->fileid, TDB_FILE_ID_LEN) == 0) break;
     pPage = pPage->pHashNext;
@@ -231,25 +296,35 @@ void tdbPCacheInvalidatePage(SPCache *pCache, SPager *pPager, SPgno pgno) {
   if (pPage) {
     bool moveToFreeList = false;
     if (pPage->pLruNext) {
-      tdbPCachePinPage(pCache, pPage);
+      tdbPCachePinPage(pShard, pPage);
       moveToFreeList = true;
     }
-    tdbPCacheRemovePageFromHash(pCache, pPage);
+    tdbPCacheRemovePageFromHash(pCache, pShard, pPage);
     if (moveToFreeList) {
-      tdbPCacheFreePage(pCache, pPage);
+      tdbPCacheFreePage(pCache, pShard, pPage);
     }
   }
 }
 
 void tdbPCacheRelease(SPCache *pCache, SPage *pPage, TXN *pTxn) {
-  i32 nRef;
+  SPCacheShard *pShard;
+  i32           nRef;
 
   if (!pTxn) {
     tdbError("tdb/pcache: null ptr pTxn, release failed.");
     return;
   }
 
-  tdbPCacheLock(pCache);
+  // dropping a ref which is not the last one touches neither the hash nor the LRU, so it needs no lock
+  for (nRef = tdbGetPageRef(pPage); nRef > 1; nRef = tdbGetPageRef(pPage)) {
+    if (atomic_val_compare_exchange_32(&pPage->nRef, nRef, nRef - 1) == nRef) {
+      tdbTrace("pcache/release page %p/%d/%d/%d", pPage, TDB_PAGE_PGNO(pPage), pPage->id, nRef - 1);
+      return;
+    }
+  }
+
+  pShard = tdbPCacheGetShard(pCache, &pPage->pgid);
+  tdbPCacheLock(pShard);
   nRef = tdbUnrefPage(pPage);
   tdbTrace("pcache/release page %p/%d/%d/%d", pPage, TDB_PAGE_PGNO(pPage), pPage->id, nRef);
   if (nRef == 0) {
@@ -259,26 +334,26 @@ void tdbPCacheRelease(SPCache *pCache, SPage *pPage, TXN *pTxn) {
     // if (nRef == 0) {
     if (pPage->isLocal) {
       if (!pPage->isFree) {
-        tdbPCacheUnpinPage(pCache, pPage);
+        tdbPCacheUnpinPage(pCache, pShard, pPage);
       } else {
-        tdbPCacheFreePage(pCache, pPage);
+        tdbPCacheFreePage(pCache, pShard, pPage);
       }
     } else {
       if (TDB_TXN_IS_WRITE(pTxn)) {
         // remove from hash
-        tdbPCacheRemovePageFromHash(pCache, pPage);
+        tdbPCacheRemovePageFromHash(pCache, pShard, pPage);
       }
 
       tdbPageDestroy(pPage, pTxn->xFree, pTxn->xArg);
     }
     // }
   }
-  tdbPCacheUnlock(pCache);
+  tdbPCacheUnlock(pShard);
 }
 
 int tdbPCacheGetPageSize(SPCache *pCache) { return pCache->szPage; }
 
-static SPage *tdbPCacheFetchImpl(SPCache *pCache, const SPgid *pPgid, TXN *pTxn) {
+static SPage *tdbPCacheFetchImpl(SPCache *pCache, SPCacheShard *pShard, const SPgid *pPgid, TXN *pTxn) {
   int    ret = 0;
   SPage *pPage = NULL;
   SPage *pPageH = NULL;
@@ -289,7 +364,7 @@ static SPage *tdbPCacheFetchImpl(SPCache *pCache, const SPgid *pPgid, TXN *pTxn)
   }
 
   // 1. Search the hash table
-  pPage = pCache->pgHash[tdbPCachePageHash(pPgid) % pCache->nHash];
+  pPage = pShard->pgHash[tdbPCacheBucket(pCache, pShard, pPgid)];
   while (pPage) {
     if (pPage->pgid.pgno == pPgid->pgno && memcmp(pPage->pgid.fileid, pPgid->fileid, TDB_FILE_ID_LEN) == 0) break;
     pPage = pPage->pHashNext;
@@ -297,7 +372,7 @@ static SPage *tdbPCacheFetchImpl(SPCache *pCache, const SPgid *pPgid, TXN *pTxn)
 
   if (pPage) {
     if (pPage->isLocal || TDB_TXN_IS_WRITE(pTxn)) {
-      tdbPCachePinPage(pCache, pPage);
+      tdbPCachePinPage(pShard, pPage);
       return pPage;
     }
   }
@@ -308,18 +383,18 @@ static SPage *tdbPCacheFetchImpl(SPCache *pCache, const SPgid *pPgid, TXN *pTxn)
   pPage = NULL;
 
   // 2. Try to allocate a new page from the free list
-  if (pCache->pFree) {
-    pPage = pCache->pFree;
-    pCache->pFree = pPage->pFreeNext;
-    pCache->nFree--;
+  if (pShard->pFree) {
+    pPage = pShard->pFree;
+    pShard->pFree = pPage->pFreeNext;
+    pShard->nFree--;
     pPage->pLruNext = NULL;
   }
 
   // 3. Try to Recycle a page
-  if (!pPageH && !pPage && !pCache->lru.pLruPrev->isAnchor) {
-    pPage = pCache->lru.pLruPrev;
-    tdbPCacheRemovePageFromHash(pCache, pPage);
-    tdbPCachePinPage(pCache, pPage);
+  if (!pPageH && !pPage && !pShard->lru.pLruPrev->isAnchor) {
+    pPage = pShard->lru.pLruPrev;
+    tdbPCacheRemovePageFromHash(pCache, pShard, pPage);
+    tdbPCachePinPage(pShard, pPage);
   }
 
   // 4. Try a create new page
@@ -371,7 +446,7 @@ static SPage *tdbPCacheFetchImpl(SPCache *pCache, const SPgid *pPgid, TXN *pTxn)
       pPage->pPager = NULL;
 
       if (pPage->isLocal || TDB_TXN_IS_WRITE(pTxn)) {
-        tdbPCacheAddPageToHash(pCache, pPage);
+        tdbPCacheAddPageToHash(pCache, pShard, pPage);
       }
     }
   }
@@ -379,7 +454,7 @@ static SPage *tdbPCacheFetchImpl(SPCache *pCache, const SPgid *pPgid, TXN *pTxn)
   return pPage;
 }
 
-static void tdbPCachePinPage(SPCache *pCache, SPage *pPage) {
+static void tdbPCachePinPage(SPCacheShard *pShard, SPage *pPage) {
   if (pPage->pLruNext != NULL) {
     int32_t nRef = tdbGetPageRef(pPage);
     if (nRef != 0) {
@@ -391,13 +466,13 @@ static void tdbPCachePinPage(SPCache *pCache, SPage *pPage) {
     pPage->pLruNext->pLruPrev = pPage->pLruPrev;
     pPage->pLruNext = NULL;
 
-    pCache->nRecyclable--;
+    pShard->nRecyclable--;
 
     tdbTrace("pcache/pin page %p/%d, pgno:%d, ", pPage, pPage->id, TDB_PAGE_PGNO(pPage));
   }
 }
 
-static void tdbPCacheUnpinPage(SPCache *pCache, SPage *pPage) {
+static void tdbPCacheUnpinPage(SPCache *pCache, SPCacheShard *pShard, SPage *pPage) {
   i32 nRef = tdbGetPageRef(pPage);
   if (nRef != 0) {
     tdbError("tdb/pcache: unpin page's ref not zero: %" PRId32, nRef);
@@ -419,46 +494,46 @@ static void tdbPCacheUnpinPage(SPCache *pCache, SPage *pPage) {
   tdbTrace("pCache:%p unpin page %p/%d, nPages:%d, pgno:%d, ", pCache, pPage, pPage->id, pCache->nPages,
            TDB_PAGE_PGNO(pPage));
   if (pPage->id < pCache->nPages) {
-    pPage->pLruPrev = &(pCache->lru);
-    pPage->pLruNext = pCache->lru.pLruNext;
-    pCache->lru.pLruNext->pLruPrev = pPage;
-    pCache->lru.pLruNext = pPage;
+    pPage->pLruPrev = &(pShard->lru);
+    pPage->pLruNext = pShard->lru.pLruNext;
+    pShard->lru.pLruNext->pLruPrev = pPage;
+    pShard->lru.pLruNext = pPage;
 
-    pCache->nRecyclable++;
+    pShard->nRecyclable++;
 
     // printf("unpin page %d pgno %d pPage %p\n", pPage->id, TDB_PAGE_PGNO(pPage), pPage);
     tdbTrace("pcache/unpin page %p/%d/%d", pPage, TDB_PAGE_PGNO(pPage), pPage->id);
   } else {
     tdbTrace("pcache destroy page: %p/%d/%d", pPage, TDB_PAGE_PGNO(pPage), pPage->id);
 
-    tdbPCacheRemovePageFromHash(pCache, pPage);
+    tdbPCacheRemovePageFromHash(pCache, pShard, pPage);
     tdbPageDestroy(pPage, tdbDefaultFree, NULL);
   }
 }
 
-static void tdbPCacheRemovePageFromHash(SPCache *pCache, SPage *pPage) {
-  uint32_t h = tdbPCachePageHash(&(pPage->pgid)) % pCache->nHash;
+static void tdbPCacheRemovePageFromHash(SPCache *pCache, SPCacheShard *pShard, SPage *pPage) {
+  uint32_t h = tdbPCacheBucket(pCache, pShard, &(pPage->pgid));
 
-  SPage **ppPage = &(pCache->pgHash[h]);
+  SPage **ppPage = &(pShard->pgHash[h]);
   for (; (*ppPage) && *ppPage != pPage; ppPage = &((*ppPage)->pHashNext))
     ;
 
   if (*ppPage) {
     *ppPage = pPage->pHashNext;
-    pCache->nPage--;
+    pShard->nPage--;
     // printf("rmv page %d to hash, pgno %d, pPage %p\n", pPage->id, TDB_PAGE_PGNO(pPage), pPage);
   }
 
   tdbTrace("pcache/remove page %p/%d from hash %" PRIu32 " pgno:%d, ", pPage, pPage->id, h, TDB_PAGE_PGNO(pPage));
 }
 
-static void tdbPCacheAddPageToHash(SPCache *pCache, SPage *pPage) {
-  uint32_t h = tdbPCachePageHash(&(pPage->pgid)) % pCache->nHash;
+static void tdbPCacheAddPageToHash(SPCache *pCache, SPCacheShard *pShard, SPage *pPage) {
+  uint32_t h = tdbPCacheBucket(pCache, pShard, &(pPage->pgid));
 
-  pPage->pHashNext = pCache->pgHash[h];
-  pCache->pgHash[h] = pPage;
+  pPage->pHashNext = pShard->pgHash[h];
+  pShard->pgHash[h] = pPage;
 
-  pCache->nPage++;
+  pShard->nPage++;
 
   tdbTrace("pcache/add page %p/%d to hash %" PRIu32 " pgno:%d, ", pPage, pPage->id, h, TDB_PAGE_PGNO(pPage));
 }
@@ -469,12 +544,35 @@ static int tdbPCacheOpenImpl(SPCache *pCache) {
   int    tsize;
   int    ret;
 
-  tdbPCacheInitLock(pCache);
+  for (int32_t iShard = 0; iShard < pCache->nShard; iShard++) {
+    SPCacheShard *pShard = &pCache->aShard[iShard];
+
+    tdbPCacheInitLock(pShard);
+
+    // Open the free list
+    pShard->nFree = 0;
+    pShard->pFree = NULL;
+
+    // Open the hash table
+    pShard->nPage = 0;
+    pShard->nHash = pCache->nPages / pCache->nShard;
+    if (pShard->nHash < 8) pShard->nHash = 8;
+    pShard->pgHash = (SPage **)tdbOsCalloc(pShard->nHash, sizeof(SPage *));
+    if (pShard->pgHash == NULL) {
+      // TODO
+      return -1;
+    }
+
+    // Open LRU list
+    pShard->nRecyclable = 0;
+    pShard->lru.isAnchor = 1;
+    pShard->lru.pLruNext = &(pShard->lru);
+    pShard->lru.pLruPrev = &(pShard->lru);
+  }
 
-  // Open the free list
-  pCache->nFree = 0;
-  pCache->pFree = NULL;
   for (int i = 0; i < pCache->nPages; i++) {
+    SPCacheShard *pShard = &pCache->aShard[i % pCache->nShard];
+
     if (tdbPageCreate(pCache->szPage, &pPage, tdbDefaultMalloc, NULL) < 0) {
       // TODO: handle error
       return -1;
@@ -490,50 +588,39 @@ static int tdbPCacheOpenImpl(SPCache *pCache) {
     pPage->pDirtyNext = NULL;
 
     // add page to free list
-    pPage->pFreeNext = pCache->pFree;
-    pCache->pFree = pPage;
-    pCache->nFree++;
+    pPage->pFreeNext = pShard->pFree;
+    pShard->pFree = pPage;
+    pShard->nFree++;
 
     // add to local list
     pPage->id = i;
     pCache->aPage[i] = pPage;
   }
 
-  // Open the hash table
-  pCache->nPage = 0;
-  pCache->nHash = pCache->nPages < 8 ? 8 : pCache->nPages;
-  pCache->pgHash = (SPage **)tdbOsCalloc(pCache->nHash, sizeof(SPage *));
-  if (pCache->pgHash == NULL) {
-    // TODO
-    return -1;
-  }
-
-  // Open LRU list
-  pCache->nRecyclable = 0;
-  pCache->lru.isAnchor = 1;
-  pCache->lru.pLruNext = &(pCache->lru);
-  pCache->lru.pLruPrev = &(pCache->lru);
-
   return 0;
 }
 
 static int tdbPCacheCloseImpl(SPCache *pCache) {
-  // free free page
-  for (SPage *pPage = pCache->pFree; pPage;) {
-    SPage *pPageT = pPage->pFreeNext;
-    tdbPageDestroy(pPage, tdbDefaultFree, NULL);
-    pPage = pPageT;
-  }
+  for (int32_t iShard = 0; iShard < pCache->nShard; iShard++) {
+    SPCacheShard *pShard = &pCache->aShard[iShard];
 
-  for (int32_t iBucket = 0; iBucket < pCache->nHash; iBucket++) {
-    for (SPage *pPage = pCache->pgHash[iBucket]; pPage;) {
-      SPage *pPageT = pPage->pHashNext;
+    // free free page
+    for (SPage *pPage = pShard->pFree; pPage;) {
+      SPage *pPageT = pPage->pFreeNext;
       tdbPageDestroy(pPage, tdbDefaultFree, NULL);
       pPage = pPageT;
     }
-  }
 
-  tdbOsFree(pCache->pgHash);
-  tdbPCacheDestroyLock(pCache);
+    for (int32_t iBucket = 0; iBucket < pShard->nHash; iBucket++) {
+      for (SPage *pPage = pShard->pgHash[iBucket]; pPage;) {
+        SPage *pPageT = pPage->pHashNext;
+        tdbPageDestroy(pPage, tdbDefaultFree, NULL);
+        pPage = pPageT;
+      }
+    }
+
+    tdbOsFree(pShard->pgHash);
+    tdbPCacheDestroyLock(pShard);
+  }
   return 0;
 }
@@ -0,0 +1,183 @@
+#include <gtest/gtest.h>
+
+#define ALLOW_FORBID_FUNC
+#include "os.h"
+#include "tdb.h"
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+#include "tlog.h"
+
+typedef struct SPoolMem {
+  int64_t          size;
+  struct SPoolMem *prev;
+  struct SPoolMem *next;
+} SPoolMem;
+
+static SPoolMem *openPool() {
+  SPoolMem *pPool = (SPoolMem *)taosMemoryMalloc(sizeof(*pPool));
+
+  pPool->prev = pPool->next = pPool;
+  pPool->size = 0;
+
+  return pPool;
+}
+
+static void clearPool(SPoolMem *pPool) {
+  SPoolMem *pMem;
+
+  do {
+    pMem = pPool->next;
+
+    if (pMem == pPool) break;
+
+    pMem->next->prev = pMem->prev;
+    pMem->prev->next = pMem->next;
+    pPool->size -= pMem->size;
+
+    taosMemoryFree(pMem);
+  } while (1);
+
+  assert(pPool->size == 0);
+}
+
+static void closePool(SPoolMem *pPool) {
+  clearPool(pPool);
+  taosMemoryFree(pPool);
+}
+
+static void *poolMalloc(void *arg, size_t size) {
+  SPoolMem *pPool = (SPoolMem *)arg;
+  SPoolMem *pMem;
+
+  pMem = (SPoolMem *)taosMemoryMalloc(sizeof(*pMem) + size);
+  if (pMem == NULL) {
+    assert(0);
+  }
+
+  pMem->size = sizeof(*pMem) + size;
+  pMem->next = pPool->next;
+  pMem->prev = pPool;
+
+  pPool->next->prev = pMem;
+  pPool->next = pMem;
+  pPool->size += pMem->size;
+
+  return (void *)(&pMem[1]);
+}
+
+static void poolFree(void *arg, void *ptr) {
+  SPoolMem *pPool = (SPoolMem *)arg;
+  SPoolMem *pMem;
+
+  pMem = &(((SPoolMem *)ptr)[-1]);
+
+  pMem->next->prev = pMem->prev;
+  pMem->prev->next = pMem->next;
+  pPool->size -= pMem->size;
+
+  taosMemoryFree(pMem);
+}
+
+static void insertData(TDB *pEnv, TTB *pDb, int nData) {
+  char      key[64];
+  char      val[64];
+  int64_t   poolLimit = 4096 * 20;
+  SPoolMem *pPool = openPool();
+  TXN      *txn;
+
+  tdbBegin(pEnv, &txn, poolMalloc, poolFree, pPool, TDB_TXN_WRITE | TDB_TXN_READ_UNCOMMITTED);
+  for (int iData = 0; iData < nData; iData++) {
+    sprintf(key, "key%09d", iData);
+    sprintf(val, "value%d", iData);
+    int ret = tdbTbInsert(pDb, key, strlen(key), val, strlen(val), txn);
+    GTEST_ASSERT_EQ(ret, 0);
+
+    if (pPool->size >= poolLimit) {
+      tdbCommit(pEnv, txn);
+      tdbPostCommit(pEnv, txn);
+
+      clearPool(pPool);
+      tdbBegin(pEnv, &txn, poolMalloc, poolFree, pPool, TDB_TXN_WRITE | TDB_TXN_READ_UNCOMMITTED);
+    }
+  }
+  tdbCommit(pEnv, txn);
+  tdbPostCommit(pEnv, txn);
+
+  closePool(pPool);
+}
+
+// point lookups of random keys from nThreads threads, returns the lookups per second
+static double readBench(int32_t nShard, int nPages, int nData, int nThreads, int nRead) {
+  TDB *pEnv;
+  TTB *pDb;
+  int  ret;
+
+  taosRemoveDir("tdb");
+
+  tdbSetPCacheShards(nShard);
+  ret = tdbOpen("tdb", 4096, nPages, &pEnv, 0, 0, NULL);
+  tdbSetPCacheShards(0);
+  EXPECT_EQ(ret, 0);
+
+  ret = tdbTbOpen("db.db", -1, -1, NULL, pEnv, &pDb, 0);
+  EXPECT_EQ(ret, 0);
+
+  insertData(pEnv, pDb, nData);
+
+  std::atomic<int64_t> nFail(0);
+  auto                 f = [&](int64_t seed) {
+    char     key[64];
+    char     val[64];
+    void    *pVal = NULL;
+    int      vLen;
+    uint64_t r = seed * 2654435761ULL + 1;
+
+    for (int i = 0; i < nRead; i++) {
+      r = r * 6364136223846793005ULL + 1442695040888963407ULL;
+      int iData = (int)((r >> 33) % nData);
+
+      sprintf(key, "key%09d", iData);
+      sprintf(val, "value%d", iData);
+      if (tdbTbGet(pDb, key, strlen(key), &pVal, &vLen) < 0 || vLen != (int)strlen(val) ||
+          memcmp(val, pVal, vLen) != 0) {
+        nFail++;
+      }
+    }
+
+    tdbFree(pVal);
+  };
+
+  int64_t                  st = taosGetTimestampUs();
+  std::vector<std::thread> threads;
+  for (int i = 0; i < nThreads; i++) {
+    threads.push_back(std::thread(f, i));
+  }
+  for (auto &th : threads) {
+    th.join();
+  }
+  int64_t el = taosGetTimestampUs() - st;
+
+  EXPECT_EQ(nFail.load(), 0);
+
+  tdbTbClose(pDb);
+  ret = tdbClose(pEnv);
+  EXPECT_EQ(ret, 0);
+
+  return (double)nThreads * nRead * 1000000 / (el > 0 ? el : 1);
+}
+
+TEST(tdb_pcache_test, multi_thread_read) {
+  int nPages = 4096;
+  int nData = 200000;
+  int nThreads = 16;
+  int nRead = 50000;
+
+  double single = readBench(1, nPages, nData, nThreads, nRead);
+  double sharded = readBench(0, nPages, nData, nThreads, nRead);
+
+  std::cout << "pcache 1 shard: " << (int64_t)single << " reads/s, " << nThreads << " threads" << std::endl;
+  std::cout << "pcache sharded: " << (int64_t)sharded << " reads/s, " << nThreads << " threads" << std::endl;
+}
@@ -98,6 +98,7 @@ typedef void* queue[2];
 // #define TRANS_RETRY_INTERVAL    15    // retry interval (ms)
 #define TRANS_CONN_TIMEOUT 3000  // connect timeout (ms)
 #define TRANS_READ_TIMEOUT 3000  // read timeout  (ms)
+#define TRANS_LOCAL_RETRY_INTERVAL 60000  // retry interval of the local socket after failed to connect (ms)
 #define TRANS_PACKET_LIMIT 1024 * 1024 * 512
 
 #define TRANS_MAGIC_NUM           0x5f375a86
@@ -327,6 +328,9 @@ void transSetIpWhiteList(void* shandle, void* arg, FilteFunc* func);
 
 int transSockInfo2Str(struct sockaddr* sockname, char* dst);
 
+// the unix domain socket the server listens on for the clients on the same host
+void transLocalSockPath(uint32_t port, char* path, int32_t len);
+
 int64_t transAllocHandle();
 
 void* transInitServer(uint32_t ip, uint32_t port, char* label, int numOfThreads, void* fp, void* shandle);
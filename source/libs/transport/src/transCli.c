@@ -120,6 +120,7 @@ typedef struct SCliThrd {
 
   SHashObj* failFastCache;
   SHashObj* batchCache;
+  SHashObj* localFailCache;  // port -> the last time failed to connect to the local socket of the server
 
   SCliMsg* stopMsg;
   bool     quit;
@@ -197,6 +198,9 @@ static FORCE_INLINE uint32_t cliGetIpFromFqdnCache(SHashObj* cache, char* fqdn);
 static FORCE_INLINE void     cliUpdateFqdnCache(SHashObj* cache, char* fqdn);
 
 static FORCE_INLINE void cliMayUpdateFqdnCache(SHashObj* cache, char* dst);
+
+static bool    cliConnectLocal(SCliConn* conn, uint32_t ipaddr, uint16_t port);
+static int32_t cliConnectTcp(SCliConn* conn);
 // process data read from server, add decompress etc later
 static void cliHandleResp(SCliConn* conn);
 // handle except about conn
@@ -973,7 +977,8 @@ static void cliDestroyConn(SCliConn* conn, bool clear) {
   }
 }
 static void cliDestroy(uv_handle_t* handle) {
-  if (uv_handle_get_type(handle) != UV_TCP || handle->data == NULL) {
+  uv_handle_type type = uv_handle_get_type(handle);
+  if ((type != UV_TCP && type != UV_NAMED_PIPE) || handle->data == NULL) {
     return;
   }
   SCliConn* conn = handle->data;
@@ -1251,6 +1256,11 @@ static void cliHandleBatchReq(SCliBatch* pBatch, SCliThrd* pThrd) {
       cliHandleFastFail(conn, -1);
       return;
     }
+    if (cliConnectLocal(conn, ipaddr, pList->port)) {
+      uv_timer_start(conn->timer, cliConnTimeout, TRANS_CONN_TIMEOUT, 0);
+      return;
+    }
+
     struct sockaddr_in addr;
     addr.sin_family = AF_INET;
     addr.sin_addr.s_addr = ipaddr;
@@ -1385,7 +1395,20 @@ void cliConnCb(uv_connect_t* req, int status) {
     pConn->timer = NULL;
   }
 
+  bool local = (uv_handle_get_type((uv_handle_t*)pConn->stream) == UV_NAMED_PIPE);
   if (status != 0) {
+    if (local) {
+      // stale socket file of a stopped server, use tcp for a while
+      char*    p = strrchr(pConn->dstAddr, ':');
+      uint32_t port = (p != NULL) ? (uint32_t)atoi(p + 1) : 0;
+      int64_t  now = taosGetTimestampMs();
+      taosHashPut(pThrd->localFailCache, &port, sizeof(port), &now, sizeof(now));
+      tWarn("%s conn %p failed to connect to local socket, reason:%s", CONN_GET_INST_LABEL(pConn), pConn,
+            uv_err_name(status));
+    }
+    if (local && timeout == false && cliConnectTcp(pConn) == 0) {
+      return;
+    }
     cliMayUpdateFqdnCache(pThrd->fqdn2ipCache, pConn->dstAddr);
     if (timeout == false) {
       cliHandleFastFail(pConn, status);
@@ -1395,14 +1418,19 @@ void cliConnCb(uv_connect_t* req, int status) {
     return;
   }
 
-  struct sockaddr peername, sockname;
-  int             addrlen = sizeof(peername);
-  uv_tcp_getpeername((uv_tcp_t*)pConn->stream, &peername, &addrlen);
-  transSockInfo2Str(&peername, pConn->dst);
+  if (local) {
+    tstrncpy(pConn->dst, "local", sizeof(pConn->dst));
+    tstrncpy(pConn->src, "local", sizeof(pConn->src));
+  } else {
+    struct sockaddr peername, sockname;
+    int             addrlen = sizeof(peername);
+    uv_tcp_getpeername((uv_tcp_t*)pConn->stream, &peername, &addrlen);
+    transSockInfo2Str(&peername, pConn->dst);
 
-  addrlen = sizeof(sockname);
-  uv_tcp_getsockname((uv_tcp_t*)pConn->stream, &sockname, &addrlen);
-  transSockInfo2Str(&sockname, pConn->src);
+    addrlen = sizeof(sockname);
+    uv_tcp_getsockname((uv_tcp_t*)pConn->stream, &sockname, &addrlen);
+    transSockInfo2Str(&sockname, pConn->src);
+  }
 
   tTrace("%s conn %p connect to server successfully", CONN_GET_INST_LABEL(pConn), pConn);
   if (pConn->pBatch != NULL) {
@@ -1542,6 +1570,136 @@ FORCE_INLINE int32_t cliBuildExceptResp(SCliMsg* pMsg, STransMsg* pResp) {
 
   return 0;
 }
+static void cliFreeStreamCb(uv_handle_t* handle) { taosMemoryFree(handle); }
+
+static bool cliIsLocalAddr(SCliThrd* pThrd, uint32_t ipaddr) {
+  if ((ntohl(ipaddr) >> 24) == 127) {
+    return true;
+  }
+  if (tsLocalFqdn[0] == 0) {
+    return false;
+  }
+  uint32_t local = cliGetIpFromFqdnCache(pThrd->fqdn2ipCache, tsLocalFqdn);
+  return local != 0xffffffff && local == ipaddr;
+}
+
+// the server is on the same host, replace the tcp handle of the conn with a unix domain socket and connect to the
+// local socket of the server. Return false to connect through tcp instead.
+static bool cliConnectLocal(SCliConn* conn, uint32_t ipaddr, uint16_t port) {
+#if defined(WINDOWS)
+  return false;
+#else
+  SCliThrd* pThrd = conn->hostThrd;
+  if (!tsTransLocalEnable || !cliIsLocalAddr(pThrd, ipaddr)) {
+    return false;
+  }
+
+  uint32_t key = port;
+  int64_t* failTs = taosHashGet(pThrd->localFailCache, &key, sizeof(key));
+  if (failTs != NULL && taosGetTimestampMs() - *failTs < TRANS_LOCAL_RETRY_INTERVAL) {
+    return false;
+  }
+
+  char path[PATH_MAX] = {0};
+  transLocalSockPath(port, path, sizeof(path));
+  if (!taosCheckExistFile(path)) {
+    return false;
+  }
+
+  uv_pipe_t* pipe = taosMemoryMalloc(sizeof(uv_pipe_t));
+  if (pipe == NULL) {
+    return false;
+  }
+  if (uv_pipe_init(pThrd->loop, pipe, 0) != 0) {
+    taosMemoryFree(pipe);
+    return false;
+  }
+
+  conn->stream->data = NULL;
+  uv_close((uv_handle_t*)conn->stream, cliFreeStreamCb);
+  conn->stream = (uv_stream_t*)pipe;
+  conn->stream->data = conn;
+
+  tTrace("%s conn %p try to connect to local socket %s", CONN_GET_INST_LABEL(conn), conn, path);
+  uv_pipe_connect(&conn->connReq, pipe, path, cliConnCb);
+  return true;
+#endif
+}
+
+// the local socket of the server refused the conn, replace the unix domain socket of the conn with a tcp handle and
+// send the same request to the server through tcp
+static int32_t cliConnectTcp(SCliConn* conn) {
+  SCliThrd* pThrd = conn->hostThrd;
+
+  char  fqdn[TSDB_FQDN_LEN + 64] = {0};
+  char* p = strrchr(conn->dstAddr, ':');
+  if (p == NULL) {
+    return -1;
+  }
+  uint16_t port = (uint16_t)atoi(p + 1);
+  tstrncpy(fqdn, conn->dstAddr, TMIN((int32_t)sizeof(fqdn), (int32_t)(p - conn->dstAddr) + 1));
+
+  uint32_t ipaddr = cliGetIpFromFqdnCache(pThrd->fqdn2ipCache, fqdn);
+  if (ipaddr == 0xffffffff) {
+    return -1;
+  }
+
+  uv_tcp_t* tcp = taosMemoryMalloc(sizeof(uv_tcp_t));
+  if (tcp == NULL) {
+    return -1;
+  }
+  if (uv_tcp_init(pThrd->loop, tcp) != 0) {
+    taosMemoryFree(tcp);
+    return -1;
+  }
+  conn->stream->data = NULL;
+  uv_close((uv_handle_t*)conn->stream, cliFreeStreamCb);
+  conn->stream = (uv_stream_t*)tcp;
+  conn->stream->data = conn;
+
+  struct sockaddr_in addr;
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = ipaddr;
+  addr.sin_port = (uint16_t)htons(port);
+
+  tTrace("%s conn %p try to connect to %s through tcp", CONN_GET_INST_LABEL(conn), conn, conn->dstAddr);
+  int32_t fd = taosCreateSocketWithTimeout(TRANS_CONN_TIMEOUT * 10);
+  if (fd == -1) {
+    tError("%s conn %p failed to create socket, reason:%s", CONN_GET_INST_LABEL(conn), conn,
+           tstrerror(TAOS_SYSTEM_ERROR(errno)));
+    errno = 0;
+    return -1;
+  }
+  int ret = uv_tcp_open(tcp, fd);
+  if (ret != 0) {
+    tError("%s conn %p failed to set stream, reason:%s", CONN_GET_INST_LABEL(conn), conn, uv_err_name(ret));
+    return -1;
+  }
+  ret = transSetConnOption(tcp, tsKeepAliveIdle);
+  if (ret != 0) {
+    tError("%s conn %p failed to set socket opt, reason:%s", CONN_GET_INST_LABEL(conn), conn, uv_err_name(ret));
+    return -1;
+  }
+  ret = uv_tcp_connect(&conn->connReq, tcp, (const struct sockaddr*)&addr, cliConnCb);
+  if (ret != 0) {
+    tError("%s conn %p failed to connect to %s, reason:%s", CONN_GET_INST_LABEL(conn), conn, conn->dstAddr,
+           uv_err_name(ret));
+    return -1;
+  }
+
+  // the timer of the local connect was recycled by the conn callback
+  uv_timer_t* timer = taosArrayGetSize(pThrd->timerList) > 0 ? *(uv_timer_t**)taosArrayPop(pThrd->timerList) : NULL;
+  if (timer == NULL) {
+    timer = taosMemoryCalloc(1, sizeof(uv_timer_t));
+    tDebug("no available timer, create a timer %p", timer);
+    uv_timer_init(pThrd->loop, timer);
+  }
+  timer->data = conn;
+  conn->timer = timer;
+  uv_timer_start(conn->timer, cliConnTimeout, TRANS_CONN_TIMEOUT, 0);
+  return 0;
+}
+
 static FORCE_INLINE uint32_t cliGetIpFromFqdnCache(SHashObj* cache, char* fqdn) {
   uint32_t  addr = 0;
   size_t    len = strlen(fqdn);
@@ -1663,6 +1821,12 @@ void cliHandleReq(SCliMsg* pMsg, SCliThrd* pThrd) {
       return;
     }
 
+    if (cliConnectLocal(conn, ipaddr, port)) {
+      uv_timer_start(conn->timer, cliConnTimeout, TRANS_CONN_TIMEOUT, 0);
+      tGTrace("%s conn %p ready", pTransInst->label, conn);
+      return;
+    }
+
     struct sockaddr_in addr;
     addr.sin_family = AF_INET;
     addr.sin_addr.s_addr = ipaddr;
@@ -2099,6 +2263,7 @@ static SCliThrd* createThrdObj(void* trans) {
   pThrd->failFastCache = taosHashInit(8, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BINARY), true, HASH_NO_LOCK);
 
   pThrd->batchCache = taosHashInit(8, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BINARY), true, HASH_NO_LOCK);
+  pThrd->localFailCache = taosHashInit(8, taosGetDefaultHashFunction(TSDB_DATA_TYPE_UINT), true, HASH_NO_LOCK);
 
   pThrd->quit = false;
 
@@ -2147,6 +2312,7 @@ static void destroyThrdObj(SCliThrd* pThrd) {
     pIter = (void**)taosHashIterate(pThrd->batchCache, pIter);
   }
   taosHashCleanup(pThrd->batchCache);
+  taosHashCleanup(pThrd->localFailCache);
   taosMemoryFree(pThrd);
 }
 
@@ -98,6 +98,9 @@ int transSockInfo2Str(struct sockaddr* sockname, char* dst) {
   sprintf(dst, "%s:%d", buf, ntohs(addr.sin_port));
   return r;
 }
+void transLocalSockPath(uint32_t port, char* path, int32_t len) {
+  snprintf(path, len, "%s%staos.rpc.%u.sock", tsTempDir, TD_DIRSEP, port);
+}
 int transInitBuffer(SConnBuffer* buf) {
   buf->cap = BUFFER_CAP;
   buf->buf = taosMemoryCalloc(1, BUFFER_CAP);
@@ -135,6 +138,21 @@ int transDumpFromBuffer(SConnBuffer* connBuf, char** buf, int8_t resetBuf) {
   }
   int total = p->total;
   if (total >= HEADSIZE && !p->invalid) {
+    if (total > BUFFER_CAP && total == p->len && total == p->cap) {
+      // the read buffer has been sized from the msg head to hold exactly this msg, hand it over to the upper layer
+      // instead of copying it, and continue reading into a new buffer
+      char* pNew = taosMemoryCalloc(1, BUFFER_CAP);
+      if (pNew != NULL) {
+        *buf = p->buf;
+        p->buf = pNew;
+        p->cap = BUFFER_CAP;
+        p->left = -1;
+        p->total = 0;
+        p->len = 0;
+        return total;
+      }
+    }
+
     *buf = taosMemoryCalloc(1, total);
     memcpy(*buf, p->buf, total);
     if (transResetBuffer(connBuf, resetBuf) < 0) {
@@ -26,7 +26,7 @@ typedef struct {
 
 typedef struct SSvrConn {
   T_REF_DECLARE()
-  uv_tcp_t*  pTcp;
+  uv_stream_t* pTcp;  // uv_tcp_t, or uv_pipe_t if the client is connected through the local socket
   queue      wreqQueue;
   uv_timer_t pTimer;
 
@@ -117,6 +117,11 @@ typedef struct SServerObj {
   uint32_t    port;
   uv_async_t* pAcceptAsync;  // just to quit from from accept thread
 
+  // unix domain socket for the clients on the same host
+  uv_pipe_t localServer;
+  bool      localListen;
+  char      localPath[PATH_MAX];
+
   bool inited;
 } SServerObj;
 
@@ -135,6 +140,7 @@ static void uvOnTimeoutCb(uv_timer_t* handle);
 static void uvOnSendCb(uv_write_t* req, int status);
 static void uvOnPipeWriteCb(uv_write_t* req, int status);
 static void uvOnAcceptCb(uv_stream_t* stream, int status);
+static void uvOnLocalAcceptCb(uv_stream_t* stream, int status);
 static void uvOnConnectionCb(uv_stream_t* q, ssize_t nread, const uv_buf_t* buf);
 static void uvWorkerAsyncCb(uv_async_t* handle);
 static void uvAcceptAsyncCb(uv_async_t* handle);
@@ -857,6 +863,36 @@ static void uvWorkAfterTask(uv_work_t* req, int status) {
   taosMemoryFree(req);
 }
 
+// hand the accepted conn over to a worker thread
+static void uvDispatchConn(SServerObj* pObj, uv_stream_t* cli) {
+#if defined(WINDOWS) || defined(DARWIN)
+  if (pObj->numOfWorkerReady < pObj->numOfThreads) {
+    tError("worker-threads are not ready for all, need %d instead of %d.", pObj->numOfThreads, pObj->numOfWorkerReady);
+    uv_close((uv_handle_t*)cli, uvFreeCb);
+    return;
+  }
+#endif
+
+  uv_write_t* wr = (uv_write_t*)taosMemoryMalloc(sizeof(uv_write_t));
+  wr->data = cli;
+  uv_buf_t buf = uv_buf_init((char*)notify, strlen(notify));
+
+  pObj->workerIdx = (pObj->workerIdx + 1) % pObj->numOfThreads;
+
+  tTrace("new connection accepted by main server, dispatch to %dth worker-thread", pObj->workerIdx);
+
+  uv_write2(wr, (uv_stream_t*)&(pObj->pipe[pObj->workerIdx][0]), &buf, 1, cli, uvOnPipeWriteCb);
+}
+
+static void uvAcceptFailed(uv_handle_t* cli, int err) {
+  tError("failed to accept %s: %s", cli->type == UV_NAMED_PIPE ? "local conn" : "tcp", uv_err_name(err));
+  if (!uv_is_closing(cli)) {
+    uv_close(cli, uvFreeCb);
+  } else {
+    taosMemoryFree(cli);
+  }
+}
+
 void uvOnAcceptCb(uv_stream_t* stream, int status) {
   if (status == -1) {
     return;
@@ -874,32 +910,32 @@ void uvOnAcceptCb(uv_stream_t* stream, int status) {
   }
   err = uv_accept(stream, (uv_stream_t*)cli);
   if (err == 0) {
-#if defined(WINDOWS) || defined(DARWIN)
-    if (pObj->numOfWorkerReady < pObj->numOfThreads) {
-      tError("worker-threads are not ready for all, need %d instead of %d.", pObj->numOfThreads,
-             pObj->numOfWorkerReady);
-      uv_close((uv_handle_t*)cli, uvFreeCb);
-      return;
-    }
-#endif
-
-    uv_write_t* wr = (uv_write_t*)taosMemoryMalloc(sizeof(uv_write_t));
-    wr->data = cli;
-    uv_buf_t buf = uv_buf_init((char*)notify, strlen(notify));
+    uvDispatchConn(pObj, (uv_stream_t*)cli);
+  } else {
+    uvAcceptFailed((uv_handle_t*)cli, err);
+  }
+}
 
-    pObj->workerIdx = (pObj->workerIdx + 1) % pObj->numOfThreads;
+void uvOnLocalAcceptCb(uv_stream_t* stream, int status) {
+  if (status < 0) {
+    return;
+  }
+  SServerObj* pObj = container_of(stream, SServerObj, localServer);
 
-    tTrace("new connection accepted by main server, dispatch to %dth worker-thread", pObj->workerIdx);
+  uv_pipe_t* cli = (uv_pipe_t*)taosMemoryMalloc(sizeof(uv_pipe_t));
+  if (cli == NULL) return;
 
-    uv_write2(wr, (uv_stream_t*)&(pObj->pipe[pObj->workerIdx][0]), &buf, 1, (uv_stream_t*)cli, uvOnPipeWriteCb);
+  int err = uv_pipe_init(pObj->loop, cli, 0);
+  if (err != 0) {
+    tError("failed to create local conn: %s", uv_err_name(err));
+    taosMemoryFree(cli);
+    return;
+  }
+  err = uv_accept(stream, (uv_stream_t*)cli);
+  if (err == 0) {
+    uvDispatchConn(pObj, (uv_stream_t*)cli);
   } else {
-    if (!uv_is_closing((uv_handle_t*)cli)) {
-      tError("failed to accept tcp: %s", uv_err_name(err));
-      uv_close((uv_handle_t*)cli, uvFreeCb);
-    } else {
-      tError("failed to accept tcp: %s", uv_err_name(err));
-      taosMemoryFree(cli);
-    }
+    uvAcceptFailed((uv_handle_t*)cli, err);
   }
 }
 void uvOnConnectionCb(uv_stream_t* q, ssize_t nread, const uv_buf_t* buf) {
@@ -933,7 +969,7 @@ void uvOnConnectionCb(uv_stream_t* q, ssize_t nread, const uv_buf_t* buf) {
     return;
   }
 
-  // uv_handle_type pending = uv_pipe_pending_type(pipe);
+  uv_handle_type pending = uv_pipe_pending_type(pipe);
 
   SSvrConn* pConn = createConn(pThrd);
 
@@ -945,20 +981,35 @@ void uvOnConnectionCb(uv_stream_t* q, ssize_t nread, const uv_buf_t* buf) {
   pConn->hostThrd = pThrd;
 
   // init client handle
-  pConn->pTcp = (uv_tcp_t*)taosMemoryMalloc(sizeof(uv_tcp_t));
-  uv_tcp_init(pThrd->loop, pConn->pTcp);
+  if (pending == UV_NAMED_PIPE) {
+    pConn->pTcp = (uv_stream_t*)taosMemoryMalloc(sizeof(uv_pipe_t));
+    uv_pipe_init(pThrd->loop, (uv_pipe_t*)pConn->pTcp, 0);
+  } else {
+    pConn->pTcp = (uv_stream_t*)taosMemoryMalloc(sizeof(uv_tcp_t));
+    uv_tcp_init(pThrd->loop, (uv_tcp_t*)pConn->pTcp);
+  }
   pConn->pTcp->data = pConn;
 
   // transSetConnOption((uv_tcp_t*)pConn->pTcp);
 
-  if (uv_accept(q, (uv_stream_t*)(pConn->pTcp)) == 0) {
+  if (pending == UV_NAMED_PIPE && uv_accept(q, pConn->pTcp) == 0) {
+    // the client is on the same host, treat it as a loopback peer
+    pConn->clientIp = htonl(INADDR_LOOPBACK);
+    pConn->serverIp = htonl(INADDR_LOOPBACK);
+    pConn->port = 0;
+    tstrncpy(pConn->dst, "local", sizeof(pConn->dst));
+    tstrncpy(pConn->src, "local", sizeof(pConn->src));
+    tTrace("conn %p created through local socket", pConn);
+
+    uv_read_start(pConn->pTcp, uvAllocRecvBufferCb, uvOnRecvCb);
+  } else if (pending != UV_NAMED_PIPE && uv_accept(q, pConn->pTcp) == 0) {
     uv_os_fd_t fd;
     uv_fileno((const uv_handle_t*)pConn->pTcp, &fd);
     tTrace("conn %p created, fd:%d", pConn, fd);
 
     struct sockaddr peername, sockname;
     int             addrlen = sizeof(peername);
-    if (0 != uv_tcp_getpeername(pConn->pTcp, (struct sockaddr*)&peername, &addrlen)) {
+    if (0 != uv_tcp_getpeername((uv_tcp_t*)pConn->pTcp, (struct sockaddr*)&peername, &addrlen)) {
       tError("conn %p failed to get peer info", pConn);
       transUnrefSrvHandle(pConn);
       return;
@@ -966,7 +1017,7 @@ void uvOnConnectionCb(uv_stream_t* q, ssize_t nread, const uv_buf_t* buf) {
     transSockInfo2Str(&peername, pConn->dst);
 
     addrlen = sizeof(sockname);
-    if (0 != uv_tcp_getsockname(pConn->pTcp, (struct sockaddr*)&sockname, &addrlen)) {
+    if (0 != uv_tcp_getsockname((uv_tcp_t*)pConn->pTcp, (struct sockaddr*)&sockname, &addrlen)) {
       tError("conn %p failed to get local info", pConn);
       transUnrefSrvHandle(pConn);
       return;
@@ -1063,6 +1114,27 @@ static bool addHandleToAcceptloop(void* arg) {
     terrno = TSDB_CODE_RPC_PORT_EADDRINUSE;
     return false;
   }
+
+#if !defined(WINDOWS)
+  // the local socket is optional, clients fall back to tcp if it is not available
+  if (tsTransLocalEnable) {
+    transLocalSockPath(srv->port, srv->localPath, sizeof(srv->localPath));
+    taosRemoveFile(srv->localPath);  // left by a previous run
+
+    if ((err = uv_pipe_init(srv->loop, &srv->localServer, 0)) != 0) {
+      tWarn("failed to init local server:%s", uv_err_name(err));
+      return true;
+    }
+    if ((err = uv_pipe_bind(&srv->localServer, srv->localPath)) != 0 ||
+        (err = uv_pipe_chmod(&srv->localServer, UV_READABLE | UV_WRITABLE)) != 0 ||
+        (err = uv_listen((uv_stream_t*)&srv->localServer, 4096 * 2, uvOnLocalAcceptCb)) != 0) {
+      tWarn("failed to listen on local socket %s:%s", srv->localPath, uv_err_name(err));
+      return true;
+    }
+    srv->localListen = true;
+    tInfo("server listen on local socket %s", srv->localPath);
+  }
+#endif
   return true;
 }
 void* transWorkerThread(void* arg) {
@@ -1449,6 +1521,10 @@ void transCloseServer(void* arg) {
     uv_loop_close(srv->loop);
   }
 
+  if (srv->localListen) {
+    taosRemoveFile(srv->localPath);
+  }
+
   taosMemoryFree(srv->pThreadObj);
   taosMemoryFree(srv->pAcceptAsync);
   taosMemoryFree(srv->loop);
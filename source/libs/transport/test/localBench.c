@@ -0,0 +1,211 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// compare loopback tcp with the local socket for the clients on the same host as the server
+
+#include "os.h"
+#include "taoserror.h"
+#include "tglobal.h"
+#include "transLog.h"
+#include "trpc.h"
+#include "tutil.h"
+#include "tversion.h"
+
+typedef struct {
+  const char *name;
+  int32_t     reqSize;
+  int32_t     rspSize;
+  int32_t     numOfReqs;
+} SBenchCase;
+
+typedef struct {
+  TdThread    thread;
+  void       *pRpc;
+  SEpSet      epSet;
+  SBenchCase *pCase;
+  int32_t     failed;
+} SBenchThrd;
+
+static int32_t port = 7100;
+
+void initLogEnv() {
+  const char   *logDir = "/tmp/trans_local";
+  const char   *defaultLogFileNamePrefix = "taoslog";
+  const int32_t maxLogFileNum = 10000;
+  tsAsyncLog = 0;
+  strcpy(tsLogDir, (char *)logDir);
+  taosRemoveDir(tsLogDir);
+  taosMkDir(tsLogDir);
+
+  if (taosInitLog(defaultLogFileNamePrefix, maxLogFileNum) < 0) {
+    printf("failed to open log file in directory:%s\n", tsLogDir);
+  }
+}
+
+// the response size is carried in the first 4 bytes of the request
+static void processRequest(void *parent, SRpcMsg *pMsg, SEpSet *pEpSet) {
+  int32_t rspSize = (pMsg->contLen >= sizeof(int32_t)) ? *(int32_t *)pMsg->pCont : 0;
+
+  SRpcMsg rsp = {.info = pMsg->info, .code = 0};
+  rsp.pCont = rpcMallocCont(rspSize);
+  rsp.contLen = rspSize;
+  rpcFreeCont(pMsg->pCont);
+  rpcSendResponse(&rsp);
+}
+
+static void processResponse(void *parent, SRpcMsg *pMsg, SEpSet *pEpSet) { rpcFreeCont(pMsg->pCont); }
+
+static void *openServer(int32_t numOfThreads) {
+  SRpcInit rpcInit = {0};
+  rpcInit.localPort = port;
+  memcpy(rpcInit.localFqdn, "localhost", strlen("localhost"));
+  rpcInit.label = "SER";
+  rpcInit.numOfThreads = numOfThreads;
+  rpcInit.cfp = processRequest;
+  rpcInit.idleTime = 2 * 1500;
+  rpcInit.connType = TAOS_CONN_SERVER;
+  taosVersionStrToInt(version, &(rpcInit.compatibilityVer));
+  return rpcOpen(&rpcInit);
+}
+
+static void *openClient(int32_t numOfThreads) {
+  SRpcInit rpcInit = {0};
+  rpcInit.localPort = 0;
+  rpcInit.label = "APP";
+  rpcInit.numOfThreads = numOfThreads;
+  rpcInit.cfp = processResponse;
+  rpcInit.sessions = 100;
+  rpcInit.idleTime = tsShellActivityTimer * 1000;
+  rpcInit.user = "michael";
+  rpcInit.connType = TAOS_CONN_CLIENT;
+  taosVersionStrToInt(version, &(rpcInit.compatibilityVer));
+  return rpcOpen(&rpcInit);
+}
+
+static void *sendRequest(void *param) {
+  SBenchThrd *pThrd = param;
+  for (int32_t i = 0; i < pThrd->pCase->numOfReqs; ++i) {
+    SRpcMsg req = {.msgType = 1};
+    req.pCont = rpcMallocCont(pThrd->pCase->reqSize);
+    req.contLen = pThrd->pCase->reqSize;
+    *(int32_t *)req.pCont = pThrd->pCase->rspSize;
+
+    SRpcMsg rsp = {0};
+    rpcSendRecv(pThrd->pRpc, &pThrd->epSet, &req, &rsp);
+    if (rsp.code != 0 || rsp.contLen != pThrd->pCase->rspSize) {
+      pThrd->failed++;
+    }
+    rpcFreeCont(rsp.pCont);
+  }
+  return NULL;
+}
+
+// return the number of requests per second
+static double runCase(SBenchCase *pCase, bool local, int32_t appThreads) {
+  tsTransLocalEnable = local;
+  void *pRpc = openClient(1);
+  if (pRpc == NULL) {
+    printf("failed to open rpc client\n");
+    return 0;
+  }
+
+  SEpSet epSet = {.numOfEps = 1, .inUse = 0};
+  epSet.eps[0].port = port;
+  strcpy(epSet.eps[0].fqdn, "127.0.0.1");
+
+  // warm up, the conn is established here
+  SBenchCase warm = *pCase;
+  warm.numOfReqs = 10;
+  SBenchThrd warmThrd = {.pRpc = pRpc, .epSet = epSet, .pCase = &warm};
+  sendRequest(&warmThrd);
+
+  SBenchThrd *pThrds = taosMemoryCalloc(appThreads, sizeof(SBenchThrd));
+  int64_t     st = taosGetTimestampUs();
+  for (int32_t i = 0; i < appThreads; ++i) {
+    pThrds[i] = (SBenchThrd){.pRpc = pRpc, .epSet = epSet, .pCase = pCase};
+    taosThreadCreate(&pThrds[i].thread, NULL, sendRequest, &pThrds[i]);
+  }
+
+  int32_t failed = warmThrd.failed;
+  for (int32_t i = 0; i < appThreads; ++i) {
+    taosThreadJoin(pThrds[i].thread, NULL);
+    failed += pThrds[i].failed;
+  }
+  int64_t el = TMAX(taosGetTimestampUs() - st, 1);
+
+  if (failed > 0) {
+    printf("%s %s: %d requests failed\n", pCase->name, local ? "local" : "tcp", failed);
+  }
+
+  taosMemoryFree(pThrds);
+  rpcClose(pRpc);
+  return 1000000.0 * pCase->numOfReqs * appThreads / el;
+}
+
+int main(int argc, char *argv[]) {
+  int32_t numOfReqs = 20000;
+  int32_t appThreads = 4;
+  int32_t svrThreads = 2;
+
+  rpcDebugFlag = 131;
+  for (int i = 1; i < argc; ++i) {
+    if (strcmp(argv[i], "-p") == 0 && i < argc - 1) {
+      port = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "-n") == 0 && i < argc - 1) {
+      numOfReqs = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "-a") == 0 && i < argc - 1) {
+      appThreads = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "-t") == 0 && i < argc - 1) {
+      svrThreads = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "-d") == 0 && i < argc - 1) {
+      rpcDebugFlag = atoi(argv[++i]);
+    } else {
+      printf("\nusage: %s [options] \n", argv[0]);
+      printf("  [-p port]: server port number, default is:%d\n", port);
+      printf("  [-n requests]: number of small requests per thread, default is:%d\n", numOfReqs);
+      printf("  [-a threads]: number of app threads, default is:%d\n", appThreads);
+      printf("  [-t threads]: number of server threads, default is:%d\n", svrThreads);
+      printf("  [-d debugFlag]: debug flag, default:%d\n", rpcDebugFlag);
+      printf("  [-h help]: print out this help\n\n");
+      exit(0);
+    }
+  }
+
+  initLogEnv();
+  taosBlockSIGPIPE();
+
+  tsTransLocalEnable = true;
+  void *pServer = openServer(svrThreads);
+  if (pServer == NULL) {
+    printf("failed to start rpc server on port %d\n", port);
+    return -1;
+  }
+
+  SBenchCase cases[] = {
+      {"small submit", 512, 64, numOfReqs},
+      {"large fetch", 128, 4 * 1024 * 1024, TMAX(numOfReqs / 200, 10)},
+  };
+
+  for (int32_t i = 0; i < sizeof(cases) / sizeof(cases[0]); ++i) {
+    double tcp = runCase(&cases[i], false, appThreads);
+    double local = runCase(&cases[i], true, appThreads);
+    printf("%s, req:%d bytes, rsp:%d bytes, tcp:%.1f req/s, local:%.1f req/s\n", cases[i].name, cases[i].reqSize,
+           cases[i].rspSize, tcp, local);
+  }
+
+  rpcClose(pServer);
+  taosCloseLog();
+  return 0;
+}
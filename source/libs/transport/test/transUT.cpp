@@ -22,6 +22,7 @@
 #include "transLog.h"
 #include "trpc.h"
 #include "tversion.h"
+#include "transComm.h"
 using namespace std;
 
 const char *label = "APP";
@@ -300,6 +301,29 @@ TEST_F(TransEnv, 01sendAndRec) {
   }
 }
 
+TEST_F(TransEnv, localSockFallbackToTcp) {
+  if (!tsTransLocalEnable) {
+    return;
+  }
+  // the socket file left by a stopped server refuses the conn, the client retries the same req through tcp
+  char path[PATH_MAX] = {0};
+  transLocalSockPath(7000, path, sizeof(path));
+  taosRemoveFile(path);
+  TdFilePtr pFile = taosOpenFile(path, TD_FILE_CREATE | TD_FILE_WRITE | TD_FILE_TRUNC);
+  ASSERT_NE(pFile, nullptr);
+  taosCloseFile(&pFile);
+
+  for (int i = 0; i < 2; i++) {
+    SRpcMsg req = {0}, resp = {0};
+    req.msgType = 0;
+    req.pCont = rpcMallocCont(10);
+    req.contLen = 10;
+    tr->cliSendAndRecv(&req, &resp);
+    EXPECT_EQ(resp.code, 0);
+  }
+  taosRemoveFile(path);
+}
+
 TEST_F(TransEnv, 02StopServer) {
   for (int i = 0; i < 1; i++) {
     SRpcMsg req = {0}, resp = {0};
@@ -232,4 +232,64 @@ int32_t cloneVal(void *src, void **dst) {
 //  skey = (char *)transCtxDumpVal(ctx, 2);
 //  EXPECT_EQ(0, strcmp(skey, val.c_str()));
 //}
+
+class TransBufferEnv : public ::testing::Test {
+ protected:
+  virtual void SetUp() { transInitBuffer(&buf); }
+  virtual void TearDown() { transDestroyBuffer(&buf); }
+
+  // simulate the socket: read the stream into the conn buffer and dump every complete msg
+  void Recv(const std::string &stream, std::vector<std::string> &msgs, std::vector<bool> &handover) {
+    size_t off = 0;
+    while (off < stream.size()) {
+      uv_buf_t uvBuf;
+      transAllocBuffer(&buf, &uvBuf);
+      size_t n = std::min(std::min((size_t)uvBuf.len, stream.size() - off), (size_t)65536);
+      memcpy(uvBuf.base, stream.data() + off, n);
+      off += n;
+      buf.len += n;
+
+      while (transReadComplete(&buf)) {
+        ASSERT_EQ(buf.invalid, 0);
+        char *pOld = buf.buf;
+        char *pMsg = NULL;
+        int   len = transDumpFromBuffer(&buf, &pMsg, 1);
+        ASSERT_GT(len, 0);
+        msgs.push_back(std::string(pMsg, len));
+        handover.push_back(pMsg == pOld);
+        taosMemoryFree(pMsg);
+      }
+    }
+  }
+  SConnBuffer buf;
+};
+
+TEST_F(TransBufferEnv, zeroCopyTest) {
+  int                      sizes[] = {100, 200000, 300, 5000, 4096, 1 << 22, 64};
+  std::string              stream;
+  std::vector<std::string> expect;
+  for (int i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+    std::string msg(sizes[i] + sizeof(STransMsgHead), (char)('a' + i));
+
+    STransMsgHead *pHead = (STransMsgHead *)&msg[0];
+    memset(pHead, 0, sizeof(STransMsgHead));
+    pHead->version = TRANS_VER;
+    pHead->magicNum = htonl(TRANS_MAGIC_NUM);
+    pHead->msgLen = (int32_t)htonl((uint32_t)msg.size());
+
+    expect.push_back(msg);
+    stream += msg;
+  }
+
+  std::vector<std::string> msgs;
+  std::vector<bool>        handover;
+  Recv(stream, msgs, handover);
+
+  ASSERT_EQ(msgs.size(), expect.size());
+  for (int i = 0; i < expect.size(); i++) {
+    EXPECT_TRUE(msgs[i] == expect[i]);
+    // large msgs are handed over without copy, small ones are copied out of the shared read buffer
+    EXPECT_EQ(handover[i], expect[i].size() > 4096);
+  }
+}
 #endif
@@ -166,6 +166,21 @@ int64_t walGetSeq();
 int     walSeekWriteVer(SWal* pWal, int64_t ver);
 int32_t walRollImpl(SWal* pWal);
 
+// group commit section
+#define WAL_GROUP_MAX_ENTRIES 4096
+
+int32_t walGroupInit(SWal* pWal);
+void    walGroupCleanup(SWal* pWal);
+void    walGroupReset(SWal* pWal);
+int32_t walGroupFlushImpl(SWal* pWal, bool forceFsync);
+bool    walGroupExpired(SWal* pWal);
+
+static inline bool walGroupStaged(SWal* pWal, int64_t ver) {
+  int64_t startVer = atomic_load_64(&pWal->group.startVer);
+  return pWal->group.enable && startVer >= 0 && ver >= startVer;
+}
+// group commit section end
+
 #ifdef __cplusplus
 }
 #endif
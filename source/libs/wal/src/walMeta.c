@@ -879,6 +879,12 @@ int walSaveMeta(SWal* pWal) {
   char tmpFnameStr[WAL_FILE_LEN];
   int  n;
 
+  // write out the staged group, so that meta never covers bytes not in the files
+  if (walGroupFlushImpl(pWal, false) < 0) {
+    wError("vgId:%d, failed to flush wal group since %s", pWal->cfg.vgId, terrstr());
+    return -1;
+  }
+
   // fsync the idx and log file at first to ensure validity of meta
   if (taosFsyncFile(pWal->pIdxFile) < 0) {
     wError("vgId:%d, failed to sync idx file due to %s", pWal->cfg.vgId, strerror(errno));
@@ -143,6 +143,12 @@ SWal *walOpen(const char *path, SWalCfg *pCfg) {
   pWal->writeHead.head.protoVer = WAL_PROTO_VER;
   pWal->writeHead.magic = WAL_MAGIC;
 
+  // init group commit
+  if (walGroupInit(pWal) < 0) {
+    wError("vgId:%d, failed to init wal group commit since %s", pWal->cfg.vgId, terrstr());
+    goto _err;
+  }
+
   // load meta
   (void)walLoadMeta(pWal);
 
@@ -163,11 +169,12 @@ SWal *walOpen(const char *path, SWalCfg *pCfg) {
     goto _err;
   }
 
-  wDebug("vgId:%d, wal:%p is opened, level:%d fsyncPeriod:%d", pWal->cfg.vgId, pWal, pWal->cfg.level,
-         pWal->cfg.fsyncPeriod);
+  wDebug("vgId:%d, wal:%p is opened, level:%d fsyncPeriod:%d groupCommit:%d", pWal->cfg.vgId, pWal, pWal->cfg.level,
+         pWal->cfg.fsyncPeriod, pWal->group.enable);
   return pWal;
 
 _err:
+  walGroupCleanup(pWal);
   taosArrayDestroy(pWal->fileInfoSet);
   taosHashCleanup(pWal->pRefHash);
   taosThreadMutexDestroy(&pWal->mutex);
@@ -212,6 +219,7 @@ int32_t walPersist(SWal *pWal) {
 void walClose(SWal *pWal) {
   taosThreadMutexLock(&pWal->mutex);
   (void)walSaveMeta(pWal);
+  walGroupCleanup(pWal);
   taosCloseFile(&pWal->pLogFile);
   pWal->pLogFile = NULL;
   taosCloseFile(&pWal->pIdxFile);
@@ -263,6 +271,14 @@ static void walUpdateSeq() {
 static void walFsyncAll() {
   SWal *pWal = taosIterateRef(tsWal.refSetId, 0);
   while (pWal) {
+    if (pWal->group.enable) {
+      // backstop for groups no more appends arrive to
+      taosThreadMutexLock(&pWal->mutex);
+      if (walGroupExpired(pWal)) {
+        (void)walGroupFlushImpl(pWal, false);
+      }
+      taosThreadMutexUnlock(&pWal->mutex);
+    }
     if (walNeedFsync(pWal)) {
       wTrace("vgId:%d, do fsync, level:%d seq:%d rseq:%d", pWal->cfg.vgId, pWal->cfg.level, pWal->fsyncSeq,
              atomic_load_32(&tsWal.seq));
@@ -202,6 +202,16 @@ static int32_t walReadChangeFile(SWalReader *pReader, int64_t fileFirstVer) {
 int32_t walReadSeekVerImpl(SWalReader *pReader, int64_t ver) {
   SWal *pWal = pReader->pWal;
 
+  // entries still staged by group commit are not in the files yet, they are read from the group buffer and the files
+  // are positioned once read from again
+  if (walGroupStaged(pWal, ver)) {
+    wDebug("vgId:%d, wal version reset from %" PRId64 " to %" PRId64 " in group", pReader->pWal->cfg.vgId,
+           pReader->curVersion, ver);
+    pReader->inGroup = 1;
+    pReader->curVersion = ver;
+    return 0;
+  }
+
   // bsearch in fileSet
   SWalFileInfo tmpInfo;
   tmpInfo.firstVer = ver;
@@ -227,10 +237,95 @@ int32_t walReadSeekVerImpl(SWalReader *pReader, int64_t ver) {
   wDebug("vgId:%d, wal version reset from %" PRId64 " to %" PRId64, pReader->pWal->cfg.vgId,
          pReader->curVersion, ver);
 
+  pReader->inGroup = 0;
   pReader->curVersion = ver;
   return 0;
 }
 
+// Copy the entry of ver, head and body, out of the group buffer into pReader->pHead. Returns 1 if copied, 0 if ver is
+// not staged anymore and is to be read from the files.
+static int32_t walReadGroupEntry(SWalReader *pReader, int64_t ver) {
+  SWal      *pWal = pReader->pWal;
+  SWalGroup *pGroup = &pWal->group;
+  int32_t    code = 0;
+
+  taosThreadMutexLock(&pWal->mutex);
+  if (!walGroupStaged(pWal, ver) || ver - pGroup->startVer >= pGroup->numOfEntries) {
+    goto _out;
+  }
+
+  // the staged entries are contiguous in the log file, from the offset of the first one on
+  SWalIdxEntry first, entry;
+  memcpy(&first, pGroup->pIdxBuf, sizeof(SWalIdxEntry));
+  memcpy(&entry, pGroup->pIdxBuf + (ver - pGroup->startVer) * sizeof(SWalIdxEntry), sizeof(SWalIdxEntry));
+  const char *pEntry = pGroup->pLogBuf + (entry.offset - first.offset);
+  memcpy(pReader->pHead, pEntry, sizeof(SWalCkHead));
+
+  int32_t cryptedBodyLen = pReader->pHead->head.bodyLen;
+  //TODO: dmchen emun
+  if (pWal->cfg.encryptAlgorithm == 1) {
+    cryptedBodyLen = ENCRYPTED_LEN(cryptedBodyLen);
+  }
+
+  if (pReader->capacity < cryptedBodyLen) {
+    SWalCkHead *ptr = (SWalCkHead *)taosMemoryRealloc(pReader->pHead, sizeof(SWalCkHead) + cryptedBodyLen);
+    if (ptr == NULL) {
+      terrno = TSDB_CODE_OUT_OF_MEMORY;
+      code = -1;
+      goto _out;
+    }
+    pReader->pHead = ptr;
+    pReader->capacity = cryptedBodyLen;
+  }
+
+  memcpy(pReader->pHead->head.body, pEntry + sizeof(SWalCkHead), cryptedBodyLen);
+  pReader->inGroup = 1;
+  code = 1;
+
+_out:
+  taosThreadMutexUnlock(&pWal->mutex);
+  return code;
+}
+
+// Read the head of ver into pReader->pHead, from the group buffer if it is still staged, then with the body as well
+static int32_t walReadHead(SWalReader *pReader, int64_t ver, bool seeked) {
+  while (1) {
+    if (walGroupStaged(pReader->pWal, ver)) {
+      int32_t code = walReadGroupEntry(pReader, ver);
+      if (code != 0) {
+        return code < 0 ? -1 : 0;
+      }
+    }
+
+    // flushed since the seek into the group
+    if (pReader->inGroup) {
+      if (walReadSeekVerImpl(pReader, ver) < 0) {
+        return -1;
+      }
+      seeked = true;
+      continue;
+    }
+
+    int64_t contLen = taosReadFile(pReader->pLogFile, pReader->pHead, sizeof(SWalCkHead));
+    if (contLen == sizeof(SWalCkHead)) {
+      return 0;
+    } else if (contLen == 0 && !seeked) {
+      if (walReadSeekVerImpl(pReader, ver) < 0) {
+        return -1;
+      }
+      seeked = true;
+      continue;
+    } else {
+      if (contLen < 0) {
+        terrno = TAOS_SYSTEM_ERROR(errno);
+      } else {
+        terrno = TSDB_CODE_WAL_FILE_CORRUPTED;
+      }
+      return -1;
+    }
+  }
+}
+
 int32_t walReaderSeekVer(SWalReader *pReader, int64_t ver) {
   SWal *pWal = pReader->pWal;
   if (ver == pReader->curVersion) {
@@ -255,7 +350,6 @@ int32_t walReaderSeekVer(SWalReader *pReader, int64_t ver) {
 
 int32_t walFetchHead(SWalReader *pRead, int64_t ver) {
   int64_t code;
-  int64_t contLen;
   bool    seeked = false;
 
   // TODO: valid ver
@@ -271,24 +365,8 @@ int32_t walFetchHead(SWalReader *pRead, int64_t ver) {
     seeked = true;
   }
 
-  while (1) {
-    contLen = taosReadFile(pRead->pLogFile, pRead->pHead, sizeof(SWalCkHead));
-    if (contLen == sizeof(SWalCkHead)) {
-      break;
-    } else if (contLen == 0 && !seeked) {
-      if(walReadSeekVerImpl(pRead, ver) < 0){
-        return -1;
-      }
-      seeked = true;
-      continue;
-    } else {
-      if (contLen < 0) {
-        terrno = TAOS_SYSTEM_ERROR(errno);
-      } else {
-        terrno = TSDB_CODE_WAL_FILE_CORRUPTED;
-      }
-      return -1;
-    }
+  if (walReadHead(pRead, ver, seeked) < 0) {
+    return -1;
   }
 
   code = walValidHeadCksum(pRead->pHead);
@@ -315,10 +393,12 @@ int32_t walSkipFetchBody(SWalReader *pRead) {
   if(pRead->pWal->cfg.encryptAlgorithm == 1){
     cryptedBodyLen = ENCRYPTED_LEN(cryptedBodyLen);
   }
-  int64_t code = taosLSeekFile(pRead->pLogFile, cryptedBodyLen, SEEK_CUR);
-  if (code < 0) {
-    terrno = TAOS_SYSTEM_ERROR(errno);
-    return -1;
+  if (!pRead->inGroup) {
+    int64_t code = taosLSeekFile(pRead->pLogFile, cryptedBodyLen, SEEK_CUR);
+    if (code < 0) {
+      terrno = TAOS_SYSTEM_ERROR(errno);
+      return -1;
+    }
   }
 
   pRead->curVersion++;
@@ -355,7 +435,7 @@ int32_t walFetchBody(SWalReader *pRead) {
     pRead->capacity = cryptedBodyLen;
   }
 
-  if (cryptedBodyLen != taosReadFile(pRead->pLogFile, pReadHead->body, cryptedBodyLen)) {
+  if (!pRead->inGroup && cryptedBodyLen != taosReadFile(pRead->pLogFile, pReadHead->body, cryptedBodyLen)) {
     if (plainBodyLen < 0) {
       terrno = TAOS_SYSTEM_ERROR(errno);
       wError("vgId:%d, wal fetch body error:%" PRId64 ", read request index:%" PRId64 ", since %s, 0x%"PRIx64,
@@ -416,28 +496,11 @@ int32_t walReadVer(SWalReader *pReader, int64_t ver) {
     seeked = true;
   }
 
-  while (1) {
-    contLen = taosReadFile(pReader->pLogFile, pReader->pHead, sizeof(SWalCkHead));
-    if (contLen == sizeof(SWalCkHead)) {
-      break;
-    } else if (contLen == 0 && !seeked) {
-      if(walReadSeekVerImpl(pReader, ver) < 0){
-        taosThreadMutexUnlock(&pReader->mutex);
-        return -1;
-      }
-      seeked = true;
-      continue;
-    } else {
-      if (contLen < 0) {
-        terrno = TAOS_SYSTEM_ERROR(errno);
-      } else {
-        terrno = TSDB_CODE_WAL_FILE_CORRUPTED;
-      }
-      wError("vgId:%d, failed to read WAL record head, index:%" PRId64 ", from log file since %s",
-             pReader->pWal->cfg.vgId, ver, terrstr());
-      taosThreadMutexUnlock(&pReader->mutex);
-      return -1;
-    }
+  if (walReadHead(pReader, ver, seeked) < 0) {
+    wError("vgId:%d, failed to read WAL record head, index:%" PRId64 ", from log file since %s",
+           pReader->pWal->cfg.vgId, ver, terrstr());
+    taosThreadMutexUnlock(&pReader->mutex);
+    return -1;
   }
 
   code = walValidHeadCksum(pReader->pHead);
@@ -469,8 +532,8 @@ int32_t walReadVer(SWalReader *pReader, int64_t ver) {
     pReader->capacity = cryptedBodyLen;
   }
 
-  if ((contLen = taosReadFile(pReader->pLogFile, pReader->pHead->head.body, cryptedBodyLen)) !=
-      cryptedBodyLen) {
+  if (!pReader->inGroup &&
+      (contLen = taosReadFile(pReader->pLogFile, pReader->pHead->head.body, cryptedBodyLen)) != cryptedBodyLen) {
     if (contLen < 0)
       terrno = TAOS_SYSTEM_ERROR(errno);
     else {
@@ -541,5 +604,6 @@ void walReadReset(SWalReader *pReader) {
   taosCloseFile(&pReader->pLogFile);
   pReader->curFileFirstVer = -1;
   pReader->curVersion = -1;
+  pReader->inGroup = 0;
   taosThreadMutexUnlock(&pReader->mutex);
 }
@@ -37,6 +37,7 @@ int32_t walRestoreFromSnapshot(SWal *pWal, int64_t ver) {
     }
   }
 
+  walGroupReset(pWal);
   taosCloseFile(&pWal->pLogFile);
   taosCloseFile(&pWal->pIdxFile);
 
@@ -110,6 +111,11 @@ int32_t walRollback(SWal *pWal, int64_t ver) {
     return -1;
   }
 
+  if (walGroupFlushImpl(pWal, false) < 0) {
+    taosThreadMutexUnlock(&pWal->mutex);
+    return -1;
+  }
+
   // find correct file
   if (ver < walGetLastFileFirstVer(pWal)) {
     // change current files
@@ -395,6 +401,12 @@ END:
 int32_t walRollImpl(SWal *pWal) {
   int32_t code = 0;
 
+  // staged entries belong to the files being closed
+  code = walGroupFlushImpl(pWal, false);
+  if (code != 0) {
+    goto END;
+  }
+
   if (pWal->pIdxFile != NULL) {
     code = taosFsyncFile(pWal->pIdxFile);
     if (code != 0) {
@@ -489,6 +501,209 @@ static int32_t walWriteIndex(SWal *pWal, int64_t ver, int64_t offset) {
   return 0;
 }
 
+static int32_t walWriteEntry(SWal *pWal, int64_t index, int64_t offset, const char *body, int32_t bodyLen) {
+  if (walWriteIndex(pWal, index, offset) < 0) {
+    return -1;
+  }
+
+  if (taosWriteFile(pWal->pLogFile, &pWal->writeHead, sizeof(SWalCkHead)) != sizeof(SWalCkHead)) {
+    terrno = TAOS_SYSTEM_ERROR(errno);
+    wError("vgId:%d, file:%" PRId64 ".log, failed to write since %s", pWal->cfg.vgId, walGetLastFileFirstVer(pWal),
+           strerror(errno));
+    return -1;
+  }
+
+  if (taosWriteFile(pWal->pLogFile, body, bodyLen) != bodyLen) {
+    terrno = TAOS_SYSTEM_ERROR(errno);
+    wError("vgId:%d, file:%" PRId64 ".log, failed to write since %s", pWal->cfg.vgId, walGetLastFileFirstVer(pWal),
+           strerror(errno));
+    return -1;
+  }
+
+  return 0;
+}
+
+static void walTruncateEntry(SWal *pWal, int64_t index, int64_t offset) {
+  SWalFileInfo *pFileInfo = walGetCurFileInfo(pWal);
+
+  // recover in a reverse order
+  if (taosFtruncateFile(pWal->pLogFile, offset) < 0) {
+    terrno = TAOS_SYSTEM_ERROR(errno);
+    wFatal("vgId:%d, failed to recover WAL logfile from write error since %s, offset:%" PRId64, pWal->cfg.vgId,
+           terrstr(), offset);
+    taosMsleep(100);
+    exit(EXIT_FAILURE);
+  }
+
+  int64_t idxOffset = (index - pFileInfo->firstVer) * sizeof(SWalIdxEntry);
+  if (taosFtruncateFile(pWal->pIdxFile, idxOffset) < 0) {
+    terrno = TAOS_SYSTEM_ERROR(errno);
+    wFatal("vgId:%d, failed to recover WAL idxfile from write error since %s, offset:%" PRId64, pWal->cfg.vgId,
+           terrstr(), idxOffset);
+    taosMsleep(100);
+    exit(EXIT_FAILURE);
+  }
+}
+
+int32_t walGroupInit(SWal *pWal) {
+  SWalGroup *pGroup = &pWal->group;
+
+  memset(pGroup, 0, sizeof(SWalGroup));
+  pGroup->startVer = -1;
+  if (!tsWalGroupCommit) {
+    return 0;
+  }
+
+  pGroup->latencyMs = tsWalGroupCommitLatency;
+  pGroup->logCap = (int64_t)tsWalGroupCommitBufSize * 1024;
+  pGroup->idxCap = WAL_GROUP_MAX_ENTRIES;
+  pGroup->pLogBuf = taosMemoryMalloc(pGroup->logCap);
+  pGroup->pIdxBuf = taosMemoryMalloc(pGroup->idxCap * sizeof(SWalIdxEntry));
+  if (pGroup->pLogBuf == NULL || pGroup->pIdxBuf == NULL) {
+    walGroupCleanup(pWal);
+    terrno = TSDB_CODE_OUT_OF_MEMORY;
+    return -1;
+  }
+
+  pGroup->enable = 1;
+  return 0;
+}
+
+void walGroupCleanup(SWal *pWal) {
+  SWalGroup *pGroup = &pWal->group;
+
+  if (pGroup->stat.groups > 0) {
+    wInfo("vgId:%d, wal group commit stat, groups:%" PRId64 ", entries:%" PRId64 ", max entries:%" PRId64
+          ", bytes:%" PRId64 ", fsyncs:%" PRId64 ", flush:%" PRId64 "us, max flush:%" PRId64 "us",
+          pWal->cfg.vgId, pGroup->stat.groups, pGroup->stat.entries, pGroup->stat.maxEntries, pGroup->stat.bytes,
+          pGroup->stat.fsyncs, pGroup->stat.flushUs, pGroup->stat.maxFlushUs);
+  }
+
+  taosMemoryFreeClear(pGroup->pLogBuf);
+  taosMemoryFreeClear(pGroup->pIdxBuf);
+  pGroup->enable = 0;
+}
+
+void walGroupReset(SWal *pWal) {
+  SWalGroup *pGroup = &pWal->group;
+
+  pGroup->numOfEntries = 0;
+  pGroup->logSize = 0;
+  pGroup->startUs = 0;
+  pGroup->needFsync = 0;
+  atomic_store_64(&pGroup->startVer, -1);
+}
+
+bool walGroupExpired(SWal *pWal) {
+  SWalGroup *pGroup = &pWal->group;
+  if (pGroup->numOfEntries == 0) return false;
+  return taosGetTimestampUs() - pGroup->startUs >= pGroup->latencyMs * 1000L;
+}
+
+int32_t walGroupFlushImpl(SWal *pWal, bool forceFsync) {
+  SWalGroup *pGroup = &pWal->group;
+  if (!pGroup->enable) return 0;
+
+  bool doFsync = forceFsync || pGroup->needFsync;
+  if (pGroup->numOfEntries == 0) {
+    if (doFsync && pWal->pLogFile != NULL && taosFsyncFile(pWal->pLogFile) < 0) {
+      wError("vgId:%d, file:%" PRId64 ".log, fsync failed since %s", pWal->cfg.vgId, walGetCurFileFirstVer(pWal),
+             strerror(errno));
+    }
+    pGroup->needFsync = 0;
+    return 0;
+  }
+
+  int64_t       tsStart = taosGetTimestampUs();
+  SWalFileInfo *pFileInfo = walGetCurFileInfo(pWal);
+  int64_t       startVer = pGroup->startVer;
+  int64_t       logOffset = pFileInfo->fileSize - pGroup->logSize;
+  int64_t       idxOffset = (startVer - pFileInfo->firstVer) * sizeof(SWalIdxEntry);
+  int64_t       idxSize = pGroup->numOfEntries * sizeof(SWalIdxEntry);
+
+  if (taosWriteFile(pWal->pIdxFile, pGroup->pIdxBuf, idxSize) != idxSize) {
+    terrno = TAOS_SYSTEM_ERROR(errno);
+    wError("vgId:%d, file:%" PRId64 ".idx, failed to write group since %s, ver:%" PRId64, pWal->cfg.vgId,
+           walGetLastFileFirstVer(pWal), strerror(errno), startVer);
+    goto _err;
+  }
+
+  if (taosWriteFile(pWal->pLogFile, pGroup->pLogBuf, pGroup->logSize) != pGroup->logSize) {
+    terrno = TAOS_SYSTEM_ERROR(errno);
+    wError("vgId:%d, file:%" PRId64 ".log, failed to write group since %s, ver:%" PRId64, pWal->cfg.vgId,
+           walGetLastFileFirstVer(pWal), strerror(errno), startVer);
+    goto _err;
+  }
+
+  if (doFsync) {
+    if (taosFsyncFile(pWal->pLogFile) < 0) {
+      wError("vgId:%d, file:%" PRId64 ".log, fsync failed since %s", pWal->cfg.vgId, walGetCurFileFirstVer(pWal),
+             strerror(errno));
+    }
+    pGroup->stat.fsyncs++;
+  }
+
+  int64_t elapsed = taosGetTimestampUs() - tsStart;
+  pGroup->stat.groups++;
+  pGroup->stat.entries += pGroup->numOfEntries;
+  pGroup->stat.maxEntries = TMAX(pGroup->stat.maxEntries, pGroup->numOfEntries);
+  pGroup->stat.bytes += pGroup->logSize;
+  pGroup->stat.flushUs += elapsed;
+  pGroup->stat.maxFlushUs = TMAX(pGroup->stat.maxFlushUs, elapsed);
+
+  wDebug("vgId:%d, wal group flushed, ver:[%" PRId64 ", %" PRId64 "], entries:%d, size:%" PRId64
+         ", fsync:%d, elapsed:%" PRId64 "us",
+         pWal->cfg.vgId, startVer, pWal->vers.lastVer, pGroup->numOfEntries, pGroup->logSize, doFsync, elapsed);
+
+  walGroupReset(pWal);
+  return 0;
+
+_err:
+  // the staged entries are dropped as a whole
+  walTruncateEntry(pWal, startVer, logOffset);
+
+  pWal->vers.lastVer = startVer - 1;
+  pWal->totSize -= pGroup->logSize;
+  pFileInfo->lastVer = startVer - 1;
+  pFileInfo->fileSize = logOffset;
+
+  walGroupReset(pWal);
+  return -1;
+}
+
+static int32_t walGroupStage(SWal *pWal, int64_t index, int64_t offset, const char *body, int32_t bodyLen) {
+  SWalGroup *pGroup = &pWal->group;
+  int64_t    entryLen = sizeof(SWalCkHead) + bodyLen;
+
+  if (pGroup->logSize + entryLen > pGroup->logCap || pGroup->numOfEntries >= pGroup->idxCap) {
+    if (walGroupFlushImpl(pWal, false) < 0) {
+      return -1;
+    }
+  }
+
+  // too large to be staged, write it through
+  if (entryLen > pGroup->logCap) {
+    if (walWriteEntry(pWal, index, offset, body, bodyLen) < 0) {
+      walTruncateEntry(pWal, index, offset);
+      return -1;
+    }
+    return 0;
+  }
+
+  SWalIdxEntry entry = {.ver = index, .offset = offset};
+  memcpy(pGroup->pIdxBuf + pGroup->numOfEntries * sizeof(SWalIdxEntry), &entry, sizeof(SWalIdxEntry));
+  memcpy(pGroup->pLogBuf + pGroup->logSize, &pWal->writeHead, sizeof(SWalCkHead));
+  memcpy(pGroup->pLogBuf + pGroup->logSize + sizeof(SWalCkHead), body, bodyLen);
+
+  if (pGroup->numOfEntries == 0) {
+    pGroup->startUs = taosGetTimestampUs();
+    atomic_store_64(&pGroup->startVer, index);
+  }
+  pGroup->numOfEntries++;
+  pGroup->logSize += entryLen;
+  return 0;
+}
+
 static FORCE_INLINE int32_t walWriteImpl(SWal *pWal, int64_t index, tmsg_t msgType, SWalSyncInfo syncMeta,
                                          const void *body, int32_t bodyLen) {
   int64_t code = 0;
@@ -510,19 +725,6 @@ static FORCE_INLINE int32_t walWriteImpl(SWal *pWal, int64_t index, tmsg_t msgTy
   wDebug("vgId:%d, wal write log %" PRId64 ", msgType: %s, cksum head %u cksum body %u", pWal->cfg.vgId, index,
          TMSG_INFO(msgType), pWal->writeHead.cksumHead, pWal->writeHead.cksumBody);
 
-  code = walWriteIndex(pWal, index, offset);
-  if (code < 0) {
-    goto END;
-  }
-
-  if (taosWriteFile(pWal->pLogFile, &pWal->writeHead, sizeof(SWalCkHead)) != sizeof(SWalCkHead)) {
-    terrno = TAOS_SYSTEM_ERROR(errno);
-    wError("vgId:%d, file:%" PRId64 ".log, failed to write since %s", pWal->cfg.vgId, walGetLastFileFirstVer(pWal),
-           strerror(errno));
-    code = -1;
-    goto END;
-  }
-
   int32_t cyptedBodyLen = plainBodyLen;
   char* buf = (char*)body;
   char* newBody = NULL;
@@ -535,8 +737,7 @@ static FORCE_INLINE int32_t walWriteImpl(SWal *pWal, int64_t index, tmsg_t msgTy
     if(newBody == NULL){
       wError("vgId:%d, file:%" PRId64 ".log, failed to malloc since %s", pWal->cfg.vgId, walGetLastFileFirstVer(pWal),
             strerror(errno));
-      code = -1;
-      goto END;
+      return -1;
     }
     memset(newBody, 0, cyptedBodyLen);
     memcpy(newBody, body, plainBodyLen);
@@ -545,9 +746,8 @@ static FORCE_INLINE int32_t walWriteImpl(SWal *pWal, int64_t index, tmsg_t msgTy
     if(newBodyEncrypted == NULL){
       wError("vgId:%d, file:%" PRId64 ".log, failed to malloc since %s", pWal->cfg.vgId, walGetLastFileFirstVer(pWal),
             strerror(errno));
-      code = -1;
-      if(newBody != NULL) taosMemoryFreeClear(newBody);
-      goto END;
+      taosMemoryFreeClear(newBody);
+      return -1;
     }
 
     SCryptOpts opts;
@@ -564,17 +764,15 @@ static FORCE_INLINE int32_t walWriteImpl(SWal *pWal, int64_t index, tmsg_t msgTy
 
     buf = newBodyEncrypted;
   }
-  
-  if (taosWriteFile(pWal->pLogFile, (char *)buf, cyptedBodyLen) != cyptedBodyLen) {
-    terrno = TAOS_SYSTEM_ERROR(errno);
-    wError("vgId:%d, file:%" PRId64 ".log, failed to write since %s", pWal->cfg.vgId, walGetLastFileFirstVer(pWal),
-           strerror(errno));
-    code = -1;
-    if(pWal->cfg.encryptAlgorithm == DND_CA_SM4){
-      taosMemoryFreeClear(newBody);
-      taosMemoryFreeClear(newBodyEncrypted);
+
+  if (pWal->group.enable) {
+    // error recovery is done inside
+    code = walGroupStage(pWal, index, offset, buf, cyptedBodyLen);
+  } else {
+    code = walWriteEntry(pWal, index, offset, buf, cyptedBodyLen);
+    if (code < 0) {
+      walTruncateEntry(pWal, index, offset);
     }
-    goto END;
   }
 
   if(pWal->cfg.encryptAlgorithm == DND_CA_SM4){
@@ -584,6 +782,10 @@ static FORCE_INLINE int32_t walWriteImpl(SWal *pWal, int64_t index, tmsg_t msgTy
     //      pWal->cfg.vgId, __FUNCTION__);   
   }
 
+  if (code < 0) {
+    return -1;
+  }
+
   // set status
   if (pWal->vers.firstVer == -1) {
     pWal->vers.firstVer = 0;
@@ -593,27 +795,12 @@ static FORCE_INLINE int32_t walWriteImpl(SWal *pWal, int64_t index, tmsg_t msgTy
   pFileInfo->lastVer = index;
   pFileInfo->fileSize += sizeof(SWalCkHead) + cyptedBodyLen;
 
-  return 0;
-
-END:
-  // recover in a reverse order
-  if (taosFtruncateFile(pWal->pLogFile, offset) < 0) {
-    terrno = TAOS_SYSTEM_ERROR(errno);
-    wFatal("vgId:%d, failed to recover WAL logfile from write error since %s, offset:%" PRId64, pWal->cfg.vgId,
-           terrstr(), offset);
-    taosMsleep(100);
-    exit(EXIT_FAILURE);
+  // keep the latency budget of group commit
+  if (pWal->group.enable && walGroupExpired(pWal)) {
+    return walGroupFlushImpl(pWal, false);
   }
 
-  int64_t idxOffset = (index - pFileInfo->firstVer) * sizeof(SWalIdxEntry);
-  if (taosFtruncateFile(pWal->pIdxFile, idxOffset) < 0) {
-    terrno = TAOS_SYSTEM_ERROR(errno);
-    wFatal("vgId:%d, failed to recover WAL idxfile from write error since %s, offset:%" PRId64, pWal->cfg.vgId,
-           terrstr(), idxOffset);
-    taosMsleep(100);
-    exit(EXIT_FAILURE);
-  }
-  return -1;
+  return 0;
 }
 
 int64_t walAppendLog(SWal *pWal, int64_t index, tmsg_t msgType, SWalSyncInfo syncMeta, const void *body,
@@ -694,6 +881,18 @@ int32_t walWrite(SWal *pWal, int64_t index, tmsg_t msgType, const void *body, in
 
 void walFsync(SWal *pWal, bool forceFsync) {
   taosThreadMutexLock(&pWal->mutex);
+  if (pWal->group.enable) {
+    // fsync is deferred to the flush of current group
+    if (forceFsync || (pWal->cfg.level == TAOS_WAL_FSYNC && pWal->cfg.fsyncPeriod == 0)) {
+      pWal->group.needFsync = 1;
+    }
+    if (forceFsync || walGroupExpired(pWal)) {
+      (void)walGroupFlushImpl(pWal, forceFsync);
+    }
+    taosThreadMutexUnlock(&pWal->mutex);
+    return;
+  }
+
   if (forceFsync || (pWal->cfg.level == TAOS_WAL_FSYNC && pWal->cfg.fsyncPeriod == 0)) {
     wTrace("vgId:%d, fileId:%" PRId64 ".log, do fsync", pWal->cfg.vgId, walGetCurFileFirstVer(pWal));
     if (taosFsyncFile(pWal->pLogFile) < 0) {
@@ -703,3 +902,26 @@ void walFsync(SWal *pWal, bool forceFsync) {
   }
   taosThreadMutexUnlock(&pWal->mutex);
 }
+
+int32_t walGroupFlush(SWal *pWal, bool forceFsync) {
+  if (!pWal->group.enable) return 0;
+
+  taosThreadMutexLock(&pWal->mutex);
+  int32_t code = walGroupFlushImpl(pWal, forceFsync);
+  taosThreadMutexUnlock(&pWal->mutex);
+  return code;
+}
+
+int64_t walGetFlushedVer(SWal *pWal) {
+  int64_t startVer = atomic_load_64(&pWal->group.startVer);
+  if (pWal->group.enable && startVer >= 0) {
+    return startVer - 1;
+  }
+  return pWal->vers.lastVer;
+}
+
+void walGetGroupStat(SWal *pWal, SWalGroupStat *pStat) {
+  taosThreadMutexLock(&pWal->mutex);
+  *pStat = pWal->group.stat;
+  taosThreadMutexUnlock(&pWal->mutex);
+}
@@ -3,6 +3,7 @@
 #include <iostream>
 #include <queue>
 
+#include "tglobal.h"
 #include "walInt.h"
 
 const char* ranStr = "tvapq02tcp";
@@ -144,6 +145,42 @@ class WalRetentionEnv : public ::testing::Test {
   const char* pathName = TD_TMP_DIR_PATH "wal_test";
 };
 
+class WalGroupEnv : public ::testing::Test {
+ protected:
+  static void SetUpTestCase() {
+    int code = walInit();
+    ASSERT(code == 0);
+  }
+
+  static void TearDownTestCase() { walCleanUp(); }
+
+  void SetUp() override {
+    taosRemoveDir(pathName);
+    SWalCfg* pCfg = (SWalCfg*)taosMemoryMalloc(sizeof(SWalCfg));
+    memset(pCfg, 0, sizeof(SWalCfg));
+    pCfg->rollPeriod = -1;
+    pCfg->segSize = -1;
+    pCfg->retentionPeriod = 0;
+    pCfg->retentionSize = 0;
+    pCfg->level = TAOS_WAL_FSYNC;
+    tsWalGroupCommit = true;
+    tsWalGroupCommitLatency = 1000;
+    tsWalGroupCommitBufSize = 64;
+    pWal = walOpen(pathName, pCfg);
+    tsWalGroupCommit = false;
+    taosMemoryFree(pCfg);
+    ASSERT(pWal != NULL);
+  }
+
+  void TearDown() override {
+    walClose(pWal);
+    pWal = NULL;
+  }
+
+  SWal*       pWal = NULL;
+  const char* pathName = TD_TMP_DIR_PATH "wal_test";
+};
+
 TEST_F(WalCleanEnv, createNew) {
   walRollFileInfo(pWal);
   ASSERT(pWal->fileInfoSet != NULL);
@@ -443,3 +480,135 @@ TEST_F(WalRetentionEnv, repairMeta1) {
   }
   walCloseReader(pRead);
 }
+
+TEST_F(WalGroupEnv, groupWrite) {
+  int code;
+  ASSERT_EQ(pWal->group.enable, 1);
+
+  for (int i = 0; i < 100; i++) {
+    char newStr[100];
+    sprintf(newStr, "%s-%d", ranStr, i);
+    int len = strlen(newStr);
+    code = walWrite(pWal, i, 0, newStr, len);
+    ASSERT_EQ(code, 0);
+    ASSERT_EQ(pWal->vers.lastVer, i);
+    walFsync(pWal, false);
+  }
+  ASSERT_EQ(pWal->group.numOfEntries, 100);
+  ASSERT_EQ(walGetFlushedVer(pWal), -1);
+
+  code = walGroupFlush(pWal, false);
+  ASSERT_EQ(code, 0);
+  ASSERT_EQ(pWal->group.numOfEntries, 0);
+  ASSERT_EQ(walGetFlushedVer(pWal), 99);
+
+  SWalGroupStat stat = {0};
+  walGetGroupStat(pWal, &stat);
+  ASSERT_EQ(stat.groups, 1);
+  ASSERT_EQ(stat.entries, 100);
+  ASSERT_EQ(stat.fsyncs, 1);
+  ASSERT_EQ(stat.bytes, walGetLastFileSize(pWal));
+
+  // staged entries are read from the group buffer, without a flush
+  for (int i = 100; i < 200; i++) {
+    char newStr[100];
+    sprintf(newStr, "%s-%d", ranStr, i);
+    int len = strlen(newStr);
+    code = walWrite(pWal, i, 0, newStr, len);
+    ASSERT_EQ(code, 0);
+  }
+
+  SWalReader* pRead = walOpenReader(pWal, NULL, 0);
+  ASSERT(pRead != NULL);
+  for (int i = 0; i < 1000; i++) {
+    int ver = taosRand() % 200;
+    code = walReadVer(pRead, ver);
+    ASSERT_EQ(code, 0);
+    ASSERT_EQ(pRead->pHead->head.version, ver);
+    char newStr[100];
+    sprintf(newStr, "%s-%d", ranStr, ver);
+    int len = strlen(newStr);
+    ASSERT_EQ(pRead->pHead->head.bodyLen, len);
+    for (int j = 0; j < len; j++) {
+      EXPECT_EQ(newStr[j], pRead->pHead->head.body[j]);
+    }
+  }
+  walCloseReader(pRead);
+  ASSERT_EQ(pWal->group.numOfEntries, 100);
+  walGetGroupStat(pWal, &stat);
+  ASSERT_EQ(stat.groups, 1);
+
+  code = walRollback(pWal, 150);
+  ASSERT_EQ(code, 0);
+  ASSERT_EQ(pWal->vers.lastVer, 149);
+}
+
+TEST_F(WalGroupEnv, groupReadAcrossFlush) {
+  int code;
+  for (int i = 0; i < 100; i++) {
+    char newStr[100];
+    sprintf(newStr, "%s-%d", ranStr, i);
+    code = walWrite(pWal, i, 0, newStr, strlen(newStr));
+    ASSERT_EQ(code, 0);
+    if (i == 49) {
+      ASSERT_EQ(walGroupFlush(pWal, false), 0);
+    }
+  }
+  ASSERT_EQ(walCommit(pWal, 99), 0);
+
+  // a reader going on in sequence from the files into the group, and back to the files once the group is flushed
+  SWalReader* pRead = walOpenReader(pWal, NULL, 0);
+  ASSERT(pRead != NULL);
+  ASSERT_EQ(walReaderSeekVer(pRead, 40), 0);
+  for (int ver = 40; ver < 100; ver++) {
+    if (ver == 70) {
+      ASSERT_EQ(walGroupFlush(pWal, false), 0);
+      ASSERT_EQ(walGetFlushedVer(pWal), 99);
+    }
+    ASSERT_EQ(walFetchHead(pRead, ver), 0);
+    if (ver % 2 == 0) {
+      ASSERT_EQ(walSkipFetchBody(pRead), 0);
+      continue;
+    }
+    ASSERT_EQ(walFetchBody(pRead), 0);
+    char newStr[100];
+    sprintf(newStr, "%s-%d", ranStr, ver);
+    int len = strlen(newStr);
+    ASSERT_EQ(pRead->pHead->head.version, ver);
+    ASSERT_EQ(pRead->pHead->head.bodyLen, len);
+    ASSERT_EQ(memcmp(newStr, pRead->pHead->head.body, len), 0);
+  }
+  ASSERT_EQ(walReaderGetCurrentVer(pRead), 100);
+  walCloseReader(pRead);
+
+  SWalGroupStat stat = {0};
+  walGetGroupStat(pWal, &stat);
+  ASSERT_EQ(stat.groups, 2);
+}
+
+TEST_F(WalGroupEnv, groupBufferFull) {
+  int  code;
+  char body[1024];
+  memset(body, 'a', sizeof(body));
+
+  // 64KB staging buffer, groups are flushed when it is full
+  for (int i = 0; i < 200; i++) {
+    code = walWrite(pWal, i, 0, body, sizeof(body));
+    ASSERT_EQ(code, 0);
+  }
+  // entries larger than the buffer are written through
+  char* pLarge = (char*)taosMemoryCalloc(1, 128 * 1024);
+  code = walWrite(pWal, 200, 0, pLarge, 128 * 1024);
+  taosMemoryFree(pLarge);
+  ASSERT_EQ(code, 0);
+  ASSERT_EQ(pWal->group.numOfEntries, 0);
+
+  SWalGroupStat stat = {0};
+  walGetGroupStat(pWal, &stat);
+  ASSERT_GT(stat.groups, 1);
+  ASSERT_EQ(stat.entries, 200);
+
+  code = walSaveMeta(pWal);
+  ASSERT_EQ(code, 0);
+  ASSERT_EQ(pWal->vers.lastVer, 200);
+}
@@ -316,7 +316,6 @@ int8_t tsGetCompressL2Level(uint8_t alg, uint8_t lvl) {
 
 static const int32_t TEST_NUMBER = 1;
 #define is_bigendian()     ((*(char *)&TEST_NUMBER) == 0)
-#define SIMPLE8B_MAX_INT64 ((uint64_t)1152921504606846974LL)
 
 #define safeInt64Add(a, b) (((a >= 0) && (b <= INT64_MAX - a)) || ((a < 0) && (b >= INT64_MIN - a)))
 
@@ -350,6 +349,10 @@ int32_t tsCompressINTImp(const char *const input, const int32_t nelements, char
                                14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
                                15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15};
 
+  if (tsSIMDEnable && (tsAVX512Enable || tsAVX2Enable)) {
+    return tsCompressIntImpl_Hw(input, nelements, output, type);
+  }
+
   // get the byte limit.
   int32_t word_length = getWordLength(type);
 
@@ -722,6 +725,10 @@ int32_t tsCompressTimestampImp(const char *const input, const int32_t nelements,
 
   if (nelements == 0) return 0;
 
+  if (tsSIMDEnable && (tsAVX512Enable || tsAVX2Enable)) {
+    return tsCompressTimestampImpl_Hw(input, nelements, output);
+  }
+
   int64_t *istream = (int64_t *)input;
 
   int64_t prev_value = istream[0];
@@ -924,6 +931,10 @@ void encodeDoubleValue(uint64_t diff, uint8_t flag, char *const output, int32_t
 }
 
 int32_t tsCompressDoubleImp(const char *const input, const int32_t nelements, char *const output) {
+  if (tsSIMDEnable && (tsAVX512Enable || tsAVX2Enable)) {
+    return tsCompressDoubleImpl_Hw(input, nelements, output);
+  }
+
   int32_t byte_limit = nelements * DOUBLE_BYTES + 1;
   int32_t opos = 1;
 
@@ -1070,6 +1081,10 @@ void encodeFloatValue(uint32_t diff, uint8_t flag, char *const output, int32_t *
 }
 
 int32_t tsCompressFloatImp(const char *const input, const int32_t nelements, char *const output) {
+  if (tsSIMDEnable && (tsAVX512Enable || tsAVX2Enable)) {
+    return tsCompressFloatImpl_Hw(input, nelements, output);
+  }
+
   float  *istream = (float *)input;
   int32_t byte_limit = nelements * FLOAT_BYTES + 1;
   int32_t opos = 1;
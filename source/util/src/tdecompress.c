@@ -590,3 +590,521 @@ int32_t tsDecompressTimestampAvx512(const char *const input, const int32_t nelem
 #endif
   return 0;
 }
+
+/* --------------------------------------------SIMD Compression ---------------------------------------------- */
+// Only the delta/xor transform of each batch is vectorized, the variable length packing stays scalar and follows the
+// encoders in tcompression.c step by step, so the output is byte-identical to theirs.
+#define SIMD_CMPR_BATCH_SIZE 1024
+
+// same as !safeInt64Add(a, -b), with -b wrapped around just like the scalar encoders do
+static FORCE_INLINE bool tsCmprSubOverflow(int64_t a, int64_t b) {
+  int64_t nb = (int64_t)(0 - (uint64_t)b);
+  int64_t sum = (int64_t)((uint64_t)a + (uint64_t)nb);
+  return ((a ^ sum) & (nb ^ sum)) < 0;
+}
+
+static FORCE_INLINE int64_t tsCmprGetIntValue(const char *const input, char type, int32_t k) {
+  switch (type) {
+    case TSDB_DATA_TYPE_TINYINT:
+      return (int64_t)(*((int8_t *)input + k));
+    case TSDB_DATA_TYPE_SMALLINT:
+      return (int64_t)(*((int16_t *)input + k));
+    case TSDB_DATA_TYPE_INT:
+      return (int64_t)(*((int32_t *)input + k));
+    default:
+      return *((int64_t *)input + k);
+  }
+}
+
+#if __AVX2__
+static FORCE_INLINE __m256i tsCmprLoadIntAvx2(const char *const input, char type, int32_t k) {
+  switch (type) {
+    case TSDB_DATA_TYPE_TINYINT: {
+      int32_t v = 0;
+      memcpy(&v, input + k, sizeof(v));
+      return _mm256_cvtepi8_epi64(_mm_cvtsi32_si128(v));
+    }
+    case TSDB_DATA_TYPE_SMALLINT:
+      return _mm256_cvtepi16_epi64(_mm_loadl_epi64((const __m128i *)(input + k * SHORT_BYTES)));
+    case TSDB_DATA_TYPE_INT:
+      return _mm256_cvtepi32_epi64(_mm_loadu_si128((const __m128i *)(input + k * INT_BYTES)));
+    default:
+      return _mm256_loadu_si256((const __m256i *)(input + k * LONG_BYTES));
+  }
+}
+
+// lanes with the sign bit set in the result have overflowed in a - b
+static FORCE_INLINE __m256i tsCmprSubOverflowAvx2(__m256i a, __m256i b, __m256i diff) {
+  __m256i nb = _mm256_sub_epi64(_mm256_setzero_si256(), b);
+  return _mm256_and_si256(_mm256_xor_si256(a, diff), _mm256_xor_si256(nb, diff));
+}
+
+static FORCE_INLINE __m256i tsCmprZigzagAvx2(__m256i v) {
+  __m256i sign = _mm256_cmpgt_epi64(_mm256_setzero_si256(), v);
+  return _mm256_xor_si256(_mm256_slli_epi64(v, 1), sign);
+}
+#endif
+
+#if __AVX512F__
+static FORCE_INLINE __m512i tsCmprLoadIntAvx512(const char *const input, char type, int32_t k) {
+  switch (type) {
+    case TSDB_DATA_TYPE_TINYINT:
+      return _mm512_cvtepi8_epi64(_mm_loadl_epi64((const __m128i *)(input + k)));
+    case TSDB_DATA_TYPE_SMALLINT:
+      return _mm512_cvtepi16_epi64(_mm_loadu_si128((const __m128i *)(input + k * SHORT_BYTES)));
+    case TSDB_DATA_TYPE_INT:
+      return _mm512_cvtepi32_epi64(_mm256_loadu_si256((const __m256i *)(input + k * INT_BYTES)));
+    default:
+      return _mm512_loadu_si512((const void *)(input + k * LONG_BYTES));
+  }
+}
+
+static FORCE_INLINE __mmask8 tsCmprSubOverflowAvx512(__m512i a, __m512i b, __m512i diff) {
+  __m512i nb = _mm512_sub_epi64(_mm512_setzero_si512(), b);
+  __m512i ovf = _mm512_and_si512(_mm512_xor_si512(a, diff), _mm512_xor_si512(nb, diff));
+  return _mm512_cmplt_epi64_mask(ovf, _mm512_setzero_si512());
+}
+
+static FORCE_INLINE __m512i tsCmprZigzagAvx512(__m512i v) {
+  return _mm512_xor_si512(_mm512_slli_epi64(v, 1), _mm512_srai_epi64(v, 63));
+}
+#endif
+
+// zigzag encoded deltas of input[start, start + num), false if any of them overflows or is out of simple8b range
+static bool tsCmprIntZigzagDelta(const char *const input, char type, int32_t start, int32_t num, uint64_t *zz) {
+  int32_t k = start;
+  int32_t end = start + num;
+
+  if (k == 0 && k < end) {
+    int64_t  curr = tsCmprGetIntValue(input, type, 0);
+    uint64_t v = ZIGZAG_ENCODE(int64_t, curr);
+    if (v >= SIMPLE8B_MAX_INT64) return false;
+    zz[k++ - start] = v;
+  }
+
+  if (tsSIMDEnable && tsAVX512Enable) {
+#if __AVX512F__
+    __m512i  limit = _mm512_set1_epi64(SIMPLE8B_MAX_INT64);
+    __mmask8 bad = 0;
+    for (; k + 8 <= end; k += 8) {
+      __m512i curr = tsCmprLoadIntAvx512(input, type, k);
+      __m512i prev = tsCmprLoadIntAvx512(input, type, k - 1);
+      __m512i diff = _mm512_sub_epi64(curr, prev);
+      __m512i v = tsCmprZigzagAvx512(diff);
+
+      bad |= tsCmprSubOverflowAvx512(curr, prev, diff) | _mm512_cmpge_epu64_mask(v, limit);
+      _mm512_storeu_si512((void *)(zz + k - start), v);
+    }
+    if (bad) return false;
+#endif
+  } else if (tsSIMDEnable && tsAVX2Enable) {
+#if __AVX2__
+    // unsigned compare of v >= SIMPLE8B_MAX_INT64 by flipping the sign bit of both sides
+    __m256i signBit = _mm256_set1_epi64x(INT64_MIN);
+    __m256i limit = _mm256_set1_epi64x((int64_t)((SIMPLE8B_MAX_INT64 - 1) ^ (uint64_t)INT64_MIN));
+    __m256i bad = _mm256_setzero_si256();
+    for (; k + 4 <= end; k += 4) {
+      __m256i curr = tsCmprLoadIntAvx2(input, type, k);
+      __m256i prev = tsCmprLoadIntAvx2(input, type, k - 1);
+      __m256i diff = _mm256_sub_epi64(curr, prev);
+      __m256i v = tsCmprZigzagAvx2(diff);
+
+      bad = _mm256_or_si256(bad, tsCmprSubOverflowAvx2(curr, prev, diff));
+      bad = _mm256_or_si256(bad, _mm256_cmpgt_epi64(_mm256_xor_si256(v, signBit), limit));
+      _mm256_storeu_si256((__m256i *)(zz + k - start), v);
+    }
+    if (_mm256_movemask_pd(_mm256_castsi256_pd(bad))) return false;
+#endif
+  }
+
+  for (; k < end; k++) {
+    int64_t curr = tsCmprGetIntValue(input, type, k);
+    int64_t prev = tsCmprGetIntValue(input, type, k - 1);
+    if (tsCmprSubOverflow(curr, prev)) return false;
+
+    uint64_t v = ZIGZAG_ENCODE(int64_t, (int64_t)((uint64_t)curr - (uint64_t)prev));
+    if (v >= SIMPLE8B_MAX_INT64) return false;
+    zz[k - start] = v;
+  }
+
+  return true;
+}
+
+int32_t tsCompressIntImpl_Hw(const char *const input, const int32_t nelements, char *const output, const char type) {
+  // Selector value:              0    1   2   3   4   5   6   7   8  9  10  11
+  // 12  13  14  15
+  char    bit_per_integer[] = {0, 0, 1, 2, 3, 4, 5, 6, 7, 8, 10, 12, 15, 20, 30, 60};
+  int32_t selector_to_elems[] = {240, 120, 60, 30, 20, 15, 12, 10, 8, 7, 6, 5, 4, 3, 2, 1};
+  char    bit_to_selector[] = {0,  2,  3,  4,  5,  6,  7,  8,  9,  10, 10, 11, 11, 12, 12, 12, 13, 13, 13, 13, 13,
+                               14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+                               15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15};
+
+  int32_t word_length = getWordLength(type);
+  int32_t byte_limit = nelements * word_length + 1;
+  int32_t opos = 1;
+
+  // zigzag values and their bit width of input[base, end)
+  uint64_t zz[SIMD_CMPR_BATCH_SIZE];
+  char     bits[SIMD_CMPR_BATCH_SIZE];
+  int32_t  base = 0;
+  int32_t  end = 0;
+
+  for (int32_t i = 0; i < nelements;) {
+    // one word looks ahead at most 241 values, so keep them all in the batch
+    if (end < nelements && end - i <= selector_to_elems[0]) {
+      int32_t left = end - i;
+      memmove(zz, zz + (i - base), left * sizeof(uint64_t));
+      memmove(bits, bits + (i - base), left);
+
+      int32_t num = TMIN(nelements - end, SIMD_CMPR_BATCH_SIZE - left);
+      if (!tsCmprIntZigzagDelta(input, type, end, num, zz + left)) goto _copy_and_exit;
+      for (int32_t k = left; k < left + num; k++) {
+        bits[k] = (zz[k] == 0) ? 0 : (char)((LONG_BYTES * BITS_PER_BYTE) - BUILDIN_CLZL(zz[k]));
+      }
+
+      base = i;
+      end += num;
+    }
+
+    char    selector = 0;
+    char    bit = 0;
+    int32_t elems = 0;
+
+    for (int32_t j = i; j < nelements; j++) {
+      int32_t tmp_bit = bits[j - base];
+      if (elems + 1 <= selector_to_elems[(int32_t)selector] &&
+          elems + 1 <= selector_to_elems[(int32_t)(bit_to_selector[tmp_bit])]) {
+        // If can hold another one.
+        selector = selector > bit_to_selector[tmp_bit] ? selector : bit_to_selector[tmp_bit];
+        elems++;
+        bit = bit_per_integer[(int32_t)selector];
+      } else {
+        // if cannot hold another one.
+        while (elems < selector_to_elems[(int32_t)selector]) selector++;
+        elems = selector_to_elems[(int32_t)selector];
+        bit = bit_per_integer[(int32_t)selector];
+        break;
+      }
+    }
+
+    uint64_t buffer = 0;
+    buffer |= (uint64_t)selector;
+    for (int32_t k = 0; k < elems; k++) {
+      buffer |= ((zz[i - base] & INT64MASK(bit)) << (bit * k + 4));
+      i++;
+    }
+
+    // Output the encoded value to the output.
+    if (opos + sizeof(buffer) <= byte_limit) {
+      memcpy(output + opos, &buffer, sizeof(buffer));
+      opos += sizeof(buffer);
+    } else {
+      goto _copy_and_exit;
+    }
+  }
+
+  // set the indicator.
+  output[0] = 0;
+  return opos;
+
+_copy_and_exit:
+  output[0] = 1;
+  memcpy(output + 1, input, byte_limit - 1);
+  return byte_limit;
+}
+
+// zigzag encoded delta of deltas of input[start, start + num), false if any of them overflows
+static bool tsCmprTimestampZigzagDod(const int64_t *const input, int32_t start, int32_t num, uint64_t *zz) {
+  int32_t k = start;
+  int32_t end = start + num;
+
+  // the delta of the first value is 0 and the one before it is -input[0]
+  for (; k < end && k < 2; k++) {
+    int64_t dod = (k == 0) ? input[0] : input[1] - input[0];
+    if (k == 1 && tsCmprSubOverflow(input[1], input[0])) return false;
+    zz[k - start] = ZIGZAG_ENCODE(int64_t, dod);
+  }
+
+  if (tsSIMDEnable && tsAVX512Enable) {
+#if __AVX512F__
+    __mmask8 bad = 0;
+    for (; k + 8 <= end; k += 8) {
+      __m512i curr = _mm512_loadu_si512((const void *)(input + k));
+      __m512i prev = _mm512_loadu_si512((const void *)(input + k - 1));
+      __m512i prev2 = _mm512_loadu_si512((const void *)(input + k - 2));
+      __m512i delta = _mm512_sub_epi64(curr, prev);
+      __m512i prevDelta = _mm512_sub_epi64(prev, prev2);
+      __m512i dod = _mm512_sub_epi64(delta, prevDelta);
+
+      bad |= tsCmprSubOverflowAvx512(curr, prev, delta) | tsCmprSubOverflowAvx512(delta, prevDelta, dod);
+      _mm512_storeu_si512((void *)(zz + k - start), tsCmprZigzagAvx512(dod));
+    }
+    if (bad) return false;
+#endif
+  } else if (tsSIMDEnable && tsAVX2Enable) {
+#if __AVX2__
+    __m256i bad = _mm256_setzero_si256();
+    for (; k + 4 <= end; k += 4) {
+      __m256i curr = _mm256_loadu_si256((const __m256i *)(input + k));
+      __m256i prev = _mm256_loadu_si256((const __m256i *)(input + k - 1));
+      __m256i prev2 = _mm256_loadu_si256((const __m256i *)(input + k - 2));
+      __m256i delta = _mm256_sub_epi64(curr, prev);
+      __m256i prevDelta = _mm256_sub_epi64(prev, prev2);
+      __m256i dod = _mm256_sub_epi64(delta, prevDelta);
+
+      bad = _mm256_or_si256(bad, tsCmprSubOverflowAvx2(curr, prev, delta));
+      bad = _mm256_or_si256(bad, tsCmprSubOverflowAvx2(delta, prevDelta, dod));
+      _mm256_storeu_si256((__m256i *)(zz + k - start), tsCmprZigzagAvx2(dod));
+    }
+    if (_mm256_movemask_pd(_mm256_castsi256_pd(bad))) return false;
+#endif
+  }
+
+  for (; k < end; k++) {
+    if (tsCmprSubOverflow(input[k], input[k - 1])) return false;
+    int64_t delta = (int64_t)((uint64_t)input[k] - (uint64_t)input[k - 1]);
+    int64_t prevDelta = (int64_t)((uint64_t)input[k - 1] - (uint64_t)input[k - 2]);
+    if (tsCmprSubOverflow(delta, prevDelta)) return false;
+    zz[k - start] = ZIGZAG_ENCODE(int64_t, (int64_t)((uint64_t)delta - (uint64_t)prevDelta));
+  }
+
+  return true;
+}
+
+int32_t tsCompressTimestampImpl_Hw(const char *const input, const int32_t nelements, char *const output) {
+  int32_t  _pos = 1;
+  int32_t  longBytes = LONG_BYTES;
+  int64_t *istream = (int64_t *)input;
+  uint64_t zz[SIMD_CMPR_BATCH_SIZE];
+
+  if (nelements == 0) return 0;
+
+  if (istream[0] < 0) {
+    uWarn("compression timestamp is over signed long long range. ts = 0x%" PRIx64 " \n", istream[0]);
+    goto _exit_over;
+  }
+
+  // the batch size is even, so a pair of values never crosses two batches
+  for (int32_t start = 0; start < nelements; start += SIMD_CMPR_BATCH_SIZE) {
+    int32_t num = TMIN(nelements - start, SIMD_CMPR_BATCH_SIZE);
+    if (!tsCmprTimestampZigzagDod(istream, start, num, zz)) goto _exit_over;
+
+    for (int32_t k = 0; k < num; k += 2) {
+      uint64_t dd1 = zz[k];
+      uint64_t dd2 = (k + 1 < num) ? zz[k + 1] : 0;
+      uint8_t  flag1 = (dd1 == 0) ? 0 : (uint8_t)(LONG_BYTES - BUILDIN_CLZL(dd1) / BITS_PER_BYTE);
+      uint8_t  flag2 = (dd2 == 0) ? 0 : (uint8_t)(LONG_BYTES - BUILDIN_CLZL(dd2) / BITS_PER_BYTE);
+
+      // Encode the flag.
+      if ((_pos + CHAR_BYTES - 1) >= nelements * longBytes) goto _exit_over;
+      output[_pos] = (char)(flag1 | (flag2 << 4));
+      _pos += CHAR_BYTES;
+
+      // Encode dd1, little endian is assumed since it only runs on x86.
+      if ((_pos + flag1 - 1) >= nelements * longBytes) goto _exit_over;
+      memcpy(output + _pos, (char *)(&dd1), flag1);
+      _pos += flag1;
+
+      if (k + 1 < num) {
+        if ((_pos + flag2 - 1) >= nelements * longBytes) goto _exit_over;
+        memcpy(output + _pos, (char *)(&dd2), flag2);
+        _pos += flag2;
+      }
+    }
+  }
+
+  output[0] = 1;  // Means the string is compressed
+  return _pos;
+
+_exit_over:
+  output[0] = 0;  // Means the string is not compressed
+  memcpy(output + 1, input, nelements * longBytes);
+  return nelements * longBytes + 1;
+}
+
+// xor of input[start, start + num) with their previous values
+static void tsCmprDoubleXor(const uint64_t *const input, int32_t start, int32_t num, uint64_t *diff) {
+  int32_t k = start;
+  int32_t end = start + num;
+
+  if (k == 0 && k < end) {
+    diff[k++ - start] = input[0];
+  }
+
+  if (tsSIMDEnable && tsAVX512Enable) {
+#if __AVX512F__
+    for (; k + 8 <= end; k += 8) {
+      __m512i curr = _mm512_loadu_si512((const void *)(input + k));
+      __m512i prev = _mm512_loadu_si512((const void *)(input + k - 1));
+      _mm512_storeu_si512((void *)(diff + k - start), _mm512_xor_si512(curr, prev));
+    }
+#endif
+  } else if (tsSIMDEnable && tsAVX2Enable) {
+#if __AVX2__
+    for (; k + 4 <= end; k += 4) {
+      __m256i curr = _mm256_loadu_si256((const __m256i *)(input + k));
+      __m256i prev = _mm256_loadu_si256((const __m256i *)(input + k - 1));
+      _mm256_storeu_si256((__m256i *)(diff + k - start), _mm256_xor_si256(curr, prev));
+    }
+#endif
+  }
+
+  for (; k < end; k++) {
+    diff[k - start] = input[k] ^ input[k - 1];
+  }
+}
+
+// little endian is assumed since it only runs on x86, see encodeDoubleValue
+static FORCE_INLINE void tsCmprEncodeDoubleValue(uint64_t diff, uint8_t flag, char *const output, int32_t *const pos) {
+  int32_t nbytes = (flag & INT8MASK(3)) + 1;
+  diff >>= (LONG_BYTES * BITS_PER_BYTE - nbytes * BITS_PER_BYTE) * (flag >> 3);
+  memcpy(output + *pos, &diff, nbytes);
+  *pos += nbytes;
+}
+
+static FORCE_INLINE uint8_t tsCmprDoubleFlag(uint64_t diff) {
+  int32_t leading_zeros = LONG_BYTES * BITS_PER_BYTE;
+  int32_t trailing_zeros = leading_zeros;
+
+  if (diff) {
+    trailing_zeros = BUILDIN_CTZL(diff);
+    leading_zeros = BUILDIN_CLZL(diff);
+  }
+
+  uint8_t nbytes = 0;
+  if (trailing_zeros > leading_zeros) {
+    nbytes = (uint8_t)(LONG_BYTES - trailing_zeros / BITS_PER_BYTE);
+    if (nbytes > 0) nbytes--;
+    return ((uint8_t)1 << 3) | nbytes;
+  } else {
+    nbytes = (uint8_t)(LONG_BYTES - leading_zeros / BITS_PER_BYTE);
+    if (nbytes > 0) nbytes--;
+    return nbytes;
+  }
+}
+
+int32_t tsCompressDoubleImpl_Hw(const char *const input, const int32_t nelements, char *const output) {
+  int32_t  byte_limit = nelements * DOUBLE_BYTES + 1;
+  int32_t  opos = 1;
+  uint64_t diff[SIMD_CMPR_BATCH_SIZE];
+
+  // the batch size is even, so a pair of values never crosses two batches
+  for (int32_t start = 0; start < nelements; start += SIMD_CMPR_BATCH_SIZE) {
+    int32_t num = TMIN(nelements - start, SIMD_CMPR_BATCH_SIZE);
+    tsCmprDoubleXor((const uint64_t *)input, start, num, diff);
+
+    for (int32_t k = 0; k < num; k += 2) {
+      uint64_t diff1 = diff[k];
+      uint64_t diff2 = (k + 1 < num) ? diff[k + 1] : 0;
+      uint8_t  flag1 = tsCmprDoubleFlag(diff1);
+      uint8_t  flag2 = (k + 1 < num) ? tsCmprDoubleFlag(diff2) : 0;
+      int32_t  nbyte1 = (flag1 & INT8MASK(3)) + 1;
+      int32_t  nbyte2 = (flag2 & INT8MASK(3)) + 1;
+
+      if (opos + 1 + nbyte1 + nbyte2 > byte_limit) {
+        output[0] = 1;
+        memcpy(output + 1, input, byte_limit - 1);
+        return byte_limit;
+      }
+
+      output[opos++] = flag1 | (flag2 << 4);
+      tsCmprEncodeDoubleValue(diff1, flag1, output, &opos);
+      tsCmprEncodeDoubleValue(diff2, flag2, output, &opos);
+    }
+  }
+
+  output[0] = 0;
+  return opos;
+}
+
+static void tsCmprFloatXor(const uint32_t *const input, int32_t start, int32_t num, uint32_t *diff) {
+  int32_t k = start;
+  int32_t end = start + num;
+
+  if (k == 0 && k < end) {
+    diff[k++ - start] = input[0];
+  }
+
+  if (tsSIMDEnable && tsAVX512Enable) {
+#if __AVX512F__
+    for (; k + 16 <= end; k += 16) {
+      __m512i curr = _mm512_loadu_si512((const void *)(input + k));
+      __m512i prev = _mm512_loadu_si512((const void *)(input + k - 1));
+      _mm512_storeu_si512((void *)(diff + k - start), _mm512_xor_si512(curr, prev));
+    }
+#endif
+  } else if (tsSIMDEnable && tsAVX2Enable) {
+#if __AVX2__
+    for (; k + 8 <= end; k += 8) {
+      __m256i curr = _mm256_loadu_si256((const __m256i *)(input + k));
+      __m256i prev = _mm256_loadu_si256((const __m256i *)(input + k - 1));
+      _mm256_storeu_si256((__m256i *)(diff + k - start), _mm256_xor_si256(curr, prev));
+    }
+#endif
+  }
+
+  for (; k < end; k++) {
+    diff[k - start] = input[k] ^ input[k - 1];
+  }
+}
+
+static FORCE_INLINE void tsCmprEncodeFloatValue(uint32_t diff, uint8_t flag, char *const output, int32_t *const pos) {
+  int32_t nbytes = (flag & INT8MASK(3)) + 1;
+  diff >>= (FLOAT_BYTES * BITS_PER_BYTE - nbytes * BITS_PER_BYTE) * (flag >> 3);
+  memcpy(output + *pos, &diff, nbytes);
+  *pos += nbytes;
+}
+
+static FORCE_INLINE uint8_t tsCmprFloatFlag(uint32_t diff) {
+  int32_t clz = FLOAT_BYTES * BITS_PER_BYTE;
+  int32_t ctz = clz;
+
+  if (diff) {
+    ctz = BUILDIN_CTZ(diff);
+    clz = BUILDIN_CLZ(diff);
+  }
+
+  uint8_t nbytes = 0;
+  if (ctz > clz) {
+    nbytes = (uint8_t)(FLOAT_BYTES - ctz / BITS_PER_BYTE);
+    if (nbytes > 0) nbytes--;
+    return ((uint8_t)1 << 3) | nbytes;
+  } else {
+    nbytes = (uint8_t)(FLOAT_BYTES - clz / BITS_PER_BYTE);
+    if (nbytes > 0) nbytes--;
+    return nbytes;
+  }
+}
+
+int32_t tsCompressFloatImpl_Hw(const char *const input, const int32_t nelements, char *const output) {
+  int32_t  byte_limit = nelements * FLOAT_BYTES + 1;
+  int32_t  opos = 1;
+  uint32_t diff[SIMD_CMPR_BATCH_SIZE];
+
+  for (int32_t start = 0; start < nelements; start += SIMD_CMPR_BATCH_SIZE) {
+    int32_t num = TMIN(nelements - start, SIMD_CMPR_BATCH_SIZE);
+    tsCmprFloatXor((const uint32_t *)input, start, num, diff);
+
+    for (int32_t k = 0; k < num; k += 2) {
+      uint32_t diff1 = diff[k];
+      uint32_t diff2 = (k + 1 < num) ? diff[k + 1] : 0;
+      uint8_t  flag1 = tsCmprFloatFlag(diff1);
+      uint8_t  flag2 = (k + 1 < num) ? tsCmprFloatFlag(diff2) : 0;
+      int32_t  nbyte1 = (flag1 & INT8MASK(3)) + 1;
+      int32_t  nbyte2 = (flag2 & INT8MASK(3)) + 1;
+
+      if (opos + 1 + nbyte1 + nbyte2 > byte_limit) {
+        output[0] = 1;
+        memcpy(output + 1, input, byte_limit - 1);
+        return byte_limit;
+      }
+
+      output[opos++] = flag1 | (flag2 << 4);
+      tsCmprEncodeFloatValue(diff1, flag1, output, &opos);
+      tsCmprEncodeFloatValue(diff2, flag2, output, &opos);
+    }
+  }
+
+  output[0] = 0;
+  return opos;
+}
@@ -1,15 +1,24 @@
 #define _DEFAULT_SOURCE
 #include "tpagedbuf.h"
+#include "lz4.h"
 #include "taoserror.h"
 #include "tcompression.h"
 #include "tsimplehash.h"
 #include "tlog.h"
 
+#if defined(WINDOWS) || defined(_TD_DARWIN_64)
+#else
+#include "zstd.h"
+#endif
+
 #define GET_PAYLOAD_DATA(_p)           ((char*)(_p)->pData + POINTER_BYTES)
 #define BUF_PAGE_IN_MEM(_p)            ((_p)->pData != NULL)
 #define CLEAR_BUF_PAGE_IN_MEM_FLAG(_p) ((_p)->pData = NULL)
 #define HAS_DATA_IN_DISK(_p)           ((_p)->offset >= 0)
 #define NO_IN_MEM_AVAILABLE_PAGES(_b)  (listNEles((_b)->lruList) >= (_b)->inMemPages)
+#define GET_RAW_PAGE_SIZE(_b)          ((_b)->pageSize + (int32_t)sizeof(SFilePage))
+
+#define DBUF_ZSTD_COMPRESS_LEVEL 1
 
 typedef struct SPageDiskInfo {
   int64_t offset;
@@ -22,8 +31,9 @@ struct SPageInfo {
   int64_t    offset;
   int32_t    pageId;
   int32_t    length : 29;
-  bool       used : 1;   // set current page is in used
-  bool       dirty : 1;  // set current buffer page is dirty or not
+  bool       used : 1;        // set current page is in used
+  bool       dirty : 1;       // set current buffer page is dirty or not
+  bool       compressed : 1;  // the on disk data of current page is compressed or not
 };
 
 struct SDiskbasedBuf {
@@ -44,6 +54,7 @@ struct SDiskbasedBuf {
   void*     assistBuf;         // assistant buffer for compress/decompress data
   SArray*   pFree;             // free area in file
   bool      comp;              // compressed before flushed to disk
+  int8_t    compAlg;           // EDBufCompressAlg, also used to decompress the pages flushed before comp is reset
   uint64_t  nextPos;           // next page flush position
 
   char*               id;           // for debug purpose
@@ -70,52 +81,102 @@ static int32_t createDiskFile(SDiskbasedBuf* pBuf) {
   return TSDB_CODE_SUCCESS;
 }
 
-static char* doCompressData(void* data, int32_t srcSize, int32_t* dst, SDiskbasedBuf* pBuf) {  // do nothing
+// compress the page into assistBuf, the raw page is kept if it can not be shrunk.
+static char* doCompressData(SDiskbasedBuf* pBuf, char* data, int32_t srcSize, int32_t* dst, bool* compressed) {
+  *dst = srcSize;
+  *compressed = false;
   if (!pBuf->comp) {
-    *dst = srcSize;
     return data;
   }
 
-  *dst = tsCompressString(data, srcSize, 1, pBuf->assistBuf, srcSize, ONE_STAGE_COMP, NULL, 0);
+  int64_t st = taosGetTimestampUs();
+  int32_t len = 0;
+  switch (pBuf->compAlg) {
+    case DBUF_COMPRESS_LZ4:
+      len = LZ4_compress_default(data, pBuf->assistBuf, srcSize, srcSize - 1);
+      break;
+#if defined(WINDOWS) || defined(_TD_DARWIN_64)
+#else
+    case DBUF_COMPRESS_ZSTD: {
+      size_t n = ZSTD_compress(pBuf->assistBuf, srcSize - 1, data, srcSize, DBUF_ZSTD_COMPRESS_LEVEL);
+      len = ZSTD_isError(n) ? 0 : (int32_t)n;
+      break;
+    }
+#endif
+    default:
+      break;
+  }
+  pBuf->statis.compressTime += taosGetTimestampUs() - st;
+
+  if (len <= 0) {
+    return data;
+  }
 
-  memcpy(data, pBuf->assistBuf, *dst);
-  return data;
+  *dst = len;
+  *compressed = true;
+  return pBuf->assistBuf;
 }
 
-static char* doDecompressData(void* data, int32_t srcSize, int32_t* dst, SDiskbasedBuf* pBuf) {  // do nothing
-  if (!pBuf->comp) {
-    *dst = srcSize;
-    return data;
+static int32_t doDecompressData(SDiskbasedBuf* pBuf, const char* data, int32_t srcSize, char* dst, int32_t dstSize) {
+  int64_t st = taosGetTimestampUs();
+  int32_t len = -1;
+  switch (pBuf->compAlg) {
+    case DBUF_COMPRESS_LZ4:
+      len = LZ4_decompress_safe(data, dst, srcSize, dstSize);
+      break;
+#if defined(WINDOWS) || defined(_TD_DARWIN_64)
+#else
+    case DBUF_COMPRESS_ZSTD: {
+      size_t n = ZSTD_decompress(dst, dstSize, data, srcSize);
+      len = ZSTD_isError(n) ? -1 : (int32_t)n;
+      break;
+    }
+#endif
+    default:
+      break;
   }
+  pBuf->statis.decompressTime += taosGetTimestampUs() - st;
 
-  *dst = tsDecompressString(data, srcSize, 1, pBuf->assistBuf, pBuf->pageSize, ONE_STAGE_COMP, NULL, 0);
-  if (*dst > 0) {
-    memcpy(data, pBuf->assistBuf, *dst);
+  if (len != dstSize) {
+    uError("failed to decompress buf page, alg:%d, compressed size:%d, decompressed size:%d, expected:%d, %s",
+           pBuf->compAlg, srcSize, len, dstSize, pBuf->id);
+    return TSDB_CODE_COMPRESS_ERROR;
   }
-  return data;
+
+  return TSDB_CODE_SUCCESS;
 }
 
 static uint64_t allocateNewPositionInFile(SDiskbasedBuf* pBuf, size_t size) {
-  if (pBuf->pFree == NULL) {
-    return pBuf->nextPos;
-  } else {
-    int32_t offset = -1;
-
+  if (pBuf->pFree != NULL) {
     size_t num = taosArrayGetSize(pBuf->pFree);
     for (int32_t i = 0; i < num; ++i) {
       SFreeListItem* pi = taosArrayGet(pBuf->pFree, i);
       if (pi->length >= size) {
-        offset = pi->offset;
+        int64_t offset = pi->offset;
         pi->offset += (int32_t)size;
         pi->length -= (int32_t)size;
+        if (pi->length == 0) {
+          taosArrayRemove(pBuf->pFree, i);
+        }
 
         return offset;
       }
     }
+  }
+
+  // no available recycle space, allocate new area in file
+  uint64_t offset = pBuf->nextPos;
+  pBuf->nextPos += size;
+  return offset;
+}
 
-    // no available recycle space, allocate new area in file
-    return pBuf->nextPos;
+static void recycleSpaceInFile(SDiskbasedBuf* pBuf, int64_t offset, int32_t length) {
+  if (length <= 0) {
+    return;
   }
+
+  SFreeListItem item = {.offset = offset, .length = length};
+  taosArrayPush(pBuf->pFree, &item);
 }
 
 /**
@@ -162,11 +223,12 @@ static char* doFlushBufPage(SDiskbasedBuf* pBuf, SPageInfo* pg) {
 
   int32_t size = pBuf->pageSize;
   int64_t offset = pg->offset;
+  bool    compressed = pg->compressed;
 
   char* t = NULL;
-  if ((!HAS_DATA_IN_DISK(pg)) || pg->dirty) {
-    void* payload = GET_PAYLOAD_DATA(pg);
-    t = doCompressData(payload, pBuf->pageSize + sizeof(SFilePage), &size, pBuf);
+  if (pg->dirty) {
+    char* payload = GET_PAYLOAD_DATA(pg);
+    t = doCompressData(pBuf, payload, GET_RAW_PAGE_SIZE(pBuf), &size, &compressed);
     if (size < 0) {
       uError("failed to compress data when flushing data to disk, %s", pBuf->id);
       terrno = TSDB_CODE_INVALID_PARA;
@@ -178,22 +240,20 @@ static char* doFlushBufPage(SDiskbasedBuf* pBuf, SPageInfo* pg) {
   if (pg->dirty) {
     if (!HAS_DATA_IN_DISK(pg)) {
       offset = allocateNewPositionInFile(pBuf, size);
-      pBuf->nextPos += size;
 
       int32_t code = doFlushBufPageImpl(pBuf, offset, t, size);
       if (code != TSDB_CODE_SUCCESS) {
         return NULL;
       }
     } else {
-      // length becomes greater, current space is not enough, allocate new place, otherwise, do nothing
+      // the on disk size of a compressed page varies with each flush
       if (pg->length < size) {
-        // 1. add current space to free list
-        SPageDiskInfo dinfo = {.length = pg->length, .offset = offset};
-        taosArrayPush(pBuf->pFree, &dinfo);
-
-        // 2. allocate new position, and update the info
+        // length becomes greater, current space is not enough, add it to free list and allocate new place
+        recycleSpaceInFile(pBuf, offset, pg->length);
         offset = allocateNewPositionInFile(pBuf, size);
-        pBuf->nextPos += size;
+      } else {
+        // length becomes smaller, recycle the tail of current space
+        recycleSpaceInFile(pBuf, offset + size, pg->length - size);
       }
 
       int32_t code = doFlushBufPageImpl(pBuf, offset, t, size);
@@ -201,6 +261,11 @@ static char* doFlushBufPage(SDiskbasedBuf* pBuf, SPageInfo* pg) {
         return NULL;
       }
     }
+
+    pBuf->statis.rawFlushBytes += GET_RAW_PAGE_SIZE(pBuf);
+    if (compressed) {
+      pBuf->statis.compPages += 1;
+    }
   } else {  // NOTE: the size may be -1, the this recycle page has not been flushed to disk yet.
     size = pg->length;
   }
@@ -214,6 +279,7 @@ static char* doFlushBufPage(SDiskbasedBuf* pBuf, SPageInfo* pg) {
 
   pg->offset = offset;
   pg->length = size;  // on disk size
+  pg->compressed = compressed;
   return pDataBuf;
 }
 
@@ -247,8 +313,10 @@ static int32_t loadPageFromDisk(SDiskbasedBuf* pBuf, SPageInfo* pg) {
     return ret;
   }
 
-  void* pPage = (void*)GET_PAYLOAD_DATA(pg);
-  ret = (int32_t)taosReadFile(pBuf->pFile, pPage, pg->length);
+  // the compressed page is read into assistBuf, and then decompressed into the page directly
+  char* pPage = GET_PAYLOAD_DATA(pg);
+  char* pRead = pg->compressed ? pBuf->assistBuf : pPage;
+  ret = (int32_t)taosReadFile(pBuf->pFile, pRead, pg->length);
   if (ret != pg->length) {
     ret = TAOS_SYSTEM_ERROR(errno);
     return ret;
@@ -257,9 +325,10 @@ static int32_t loadPageFromDisk(SDiskbasedBuf* pBuf, SPageInfo* pg) {
   pBuf->statis.loadBytes += pg->length;
   pBuf->statis.loadPages += 1;
 
-  int32_t fullSize = 0;
-  doDecompressData(pPage, pg->length, &fullSize, pBuf);
-  return 0;
+  if (pg->compressed) {
+    return doDecompressData(pBuf, pRead, pg->length, pPage, GET_RAW_PAGE_SIZE(pBuf));
+  }
+  return TSDB_CODE_SUCCESS;
 }
 
 static SPageInfo* registerNewPageInfo(SDiskbasedBuf* pBuf, int32_t pageId) {
@@ -278,6 +347,7 @@ static SPageInfo* registerNewPageInfo(SDiskbasedBuf* pBuf, int32_t pageId) {
   ppi->used = true;
   ppi->pn = NULL;
   ppi->dirty = false;
+  ppi->compressed = false;
 
   return *(SPageInfo**)taosArrayPush(pBuf->pIdList, &ppi);
 }
@@ -338,7 +408,7 @@ static SPageInfo* getPageInfoFromPayload(void* page) {
 }
 
 int32_t createDiskbasedBuf(SDiskbasedBuf** pBuf, int32_t pagesize, int32_t inMemBufSize, const char* id,
-                           const char* dir) {
+                           const char* dir, EDBufCompressAlg compAlg) {
   *pBuf = taosMemoryCalloc(1, sizeof(SDiskbasedBuf));
 
   SDiskbasedBuf* pPBuf = *pBuf;
@@ -382,6 +452,22 @@ int32_t createDiskbasedBuf(SDiskbasedBuf** pBuf, int32_t pagesize, int32_t inMem
   pPBuf->prefix = (char*)dir;
   pPBuf->emptyDummyIdList = taosArrayInit(1, sizeof(int32_t));
 
+#if defined(WINDOWS) || defined(_TD_DARWIN_64)
+  // zstd is not available on these platforms
+  if (compAlg == DBUF_COMPRESS_ZSTD) {
+    compAlg = DBUF_COMPRESS_LZ4;
+  }
+#endif
+
+  pPBuf->compAlg = compAlg;
+  pPBuf->comp = (compAlg != DBUF_COMPRESS_NONE);
+  if (pPBuf->comp) {
+    pPBuf->assistBuf = taosMemoryMalloc(GET_RAW_PAGE_SIZE(pPBuf));
+    if (pPBuf->assistBuf == NULL) {
+      goto _error;
+    }
+  }
+
   //  qDebug("QInfo:0x%"PRIx64" create resBuf for output, page size:%d, inmem buf pages:%d, file:%s", qId,
   //  pPBuf->pageSize, pPBuf->inMemPages, pPBuf->path);
 
@@ -595,6 +681,12 @@ void destroyDiskbasedBuf(SDiskbasedBuf* pBuf) {
           ps->getPages, ps->releasePages, ps->flushBytes / 1024.0f, ps->flushPages, ps->loadBytes / 1024.0f,
           ps->loadPages, ps->loadBytes / (1024.0 * ps->loadPages));
     }
+
+    if (ps->compPages > 0) {
+      uDebug("Compressed pages:%d, alg:%d, ratio:%.2f, compress:%.2f ms, decompress:%.2f ms, %s", ps->compPages,
+             pBuf->compAlg, ps->rawFlushBytes / (double)ps->flushBytes, ps->compressTime / 1000.0,
+             ps->decompressTime / 1000.0, pBuf->id);
+    }
   }
 
   if (needRemoveFile) {
@@ -648,10 +740,17 @@ void setBufPageDirty(void* pPage, bool dirty) {
 }
 
 void setBufPageCompressOnDisk(SDiskbasedBuf* pBuf, bool comp) {
-  pBuf->comp = comp;
-  if (comp  && (pBuf->assistBuf == NULL)) {
-    pBuf->assistBuf = taosMemoryMalloc(pBuf->pageSize + 2);  // EXTRA BYTES
+  if (comp && (pBuf->assistBuf == NULL)) {
+    pBuf->assistBuf = taosMemoryMalloc(GET_RAW_PAGE_SIZE(pBuf));
+    if (pBuf->assistBuf == NULL) {
+      return;
+    }
   }
+
+  if (comp && (pBuf->compAlg == DBUF_COMPRESS_NONE)) {
+    pBuf->compAlg = DBUF_COMPRESS_LZ4;
+  }
+  pBuf->comp = comp;
 }
 
 void dBufSetBufPageRecycled(SDiskbasedBuf* pBuf, void* pPage) {
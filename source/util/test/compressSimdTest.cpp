@@ -0,0 +1,160 @@
+#include <gtest/gtest.h>
+#include <stdlib.h>
+#include <iostream>
+#include <tcompression.h>
+#include "ttypes.h"
+
+namespace {
+
+typedef int32_t (*compressFp)(void *pIn, int32_t nIn, int32_t nEle, void *pOut, int32_t nOut, uint8_t cmprAlg,
+                              void *pBuf, int32_t nBuf);
+
+const int32_t numOfRows = 4096;
+
+void initSimdFlags() {
+  char sse42 = 0, avx = 0, fma = 0;
+  taosGetCpuInstructions(&sse42, &avx, &tsAVX2Enable, &fma, &tsAVX512Enable);
+}
+
+void genInt64(int64_t *pList, int32_t num, int32_t mode, uint32_t *seed) {
+  int64_t val = 1700000000000;
+  for (int32_t i = 0; i < num; ++i) {
+    switch (mode) {
+      case 0:  // regular timestamps
+        val += 1000;
+        break;
+      case 1:  // jitter
+        val += 1000 + taosRandR(seed) % 17;
+        break;
+      case 2:  // random
+        val = ((int64_t)taosRandR(seed) << 32) | taosRandR(seed);
+        break;
+      default:  // overflow the deltas
+        val = (i % 2) ? INT64_MAX : INT64_MIN + taosRandR(seed) % 3;
+        break;
+    }
+    pList[i] = val;
+  }
+}
+
+// compress with the scalar encoder and the SIMD one, the output must be byte-identical
+void checkIdentical(compressFp fp, void *pIn, int32_t bytes, int32_t num) {
+  int32_t outBytes = bytes + 1024;
+  char   *pScalar = static_cast<char *>(taosMemoryMalloc(outBytes));
+  char   *pSimd = static_cast<char *>(taosMemoryMalloc(outBytes));
+
+  char simd = tsSIMDEnable;
+  tsSIMDEnable = 0;
+  int32_t len1 = fp(pIn, bytes, num, pScalar, outBytes, ONE_STAGE_COMP, NULL, 0);
+  tsSIMDEnable = 1;
+  int32_t len2 = fp(pIn, bytes, num, pSimd, outBytes, ONE_STAGE_COMP, NULL, 0);
+  tsSIMDEnable = simd;
+
+  ASSERT_EQ(len1, len2);
+  ASSERT_EQ(memcmp(pScalar, pSimd, len1), 0);
+
+  taosMemoryFree(pScalar);
+  taosMemoryFree(pSimd);
+}
+
+double perfMBps(compressFp fp, void *pIn, int32_t bytes, int32_t num, int32_t loops) {
+  char   *pOut = static_cast<char *>(taosMemoryMalloc(bytes + 1024));
+  int64_t st = taosGetTimestampUs();
+  for (int32_t k = 0; k < loops; ++k) {
+    fp(pIn, bytes, num, pOut, bytes + 1024, ONE_STAGE_COMP, NULL, 0);
+  }
+  int64_t el = TMAX(taosGetTimestampUs() - st, 1);
+  taosMemoryFree(pOut);
+  return (double)bytes * loops / el;
+}
+
+}  // namespace
+
+TEST(compressSimdTest, identical_test) {
+  initSimdFlags();
+
+  uint32_t seed = 100;
+  int64_t *pList = static_cast<int64_t *>(taosMemoryCalloc(numOfRows, sizeof(int64_t)));
+  int32_t *pInt = static_cast<int32_t *>(taosMemoryCalloc(numOfRows, sizeof(int32_t)));
+  int16_t *pSmall = static_cast<int16_t *>(taosMemoryCalloc(numOfRows, sizeof(int16_t)));
+  int8_t  *pTiny = static_cast<int8_t *>(taosMemoryCalloc(numOfRows, sizeof(int8_t)));
+  double  *pDouble = static_cast<double *>(taosMemoryCalloc(numOfRows, sizeof(double)));
+  float   *pFloat = static_cast<float *>(taosMemoryCalloc(numOfRows, sizeof(float)));
+
+  int32_t sizes[] = {0, 1, 2, 3, 7, 240, 241, 1023, 1025, numOfRows};
+  for (int32_t mode = 0; mode < 4; ++mode) {
+    for (int32_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+      int32_t num = sizes[s];
+      genInt64(pList, num, mode, &seed);
+      for (int32_t i = 0; i < num; ++i) {
+        pInt[i] = (int32_t)pList[i];
+        pSmall[i] = (int16_t)pList[i];
+        pTiny[i] = (int8_t)pList[i];
+        pDouble[i] = (mode == 2) ? (double)pList[i] : 20.0 + (pList[i] % 1000) / 100.0;
+        pFloat[i] = (float)pDouble[i];
+      }
+
+      checkIdentical(tsCompressTimestamp, pList, num * sizeof(int64_t), num);
+      checkIdentical(tsCompressBigint, pList, num * sizeof(int64_t), num);
+      checkIdentical(tsCompressInt, pInt, num * sizeof(int32_t), num);
+      checkIdentical(tsCompressSmallint, pSmall, num * sizeof(int16_t), num);
+      checkIdentical(tsCompressTinyint, pTiny, num * sizeof(int8_t), num);
+      checkIdentical(tsCompressDouble, pDouble, num * sizeof(double), num);
+      checkIdentical(tsCompressFloat, pFloat, num * sizeof(float), num);
+    }
+  }
+
+  taosMemoryFree(pList);
+  taosMemoryFree(pInt);
+  taosMemoryFree(pSmall);
+  taosMemoryFree(pTiny);
+  taosMemoryFree(pDouble);
+  taosMemoryFree(pFloat);
+}
+
+TEST(compressSimdTest, compress_perf_test) {
+  initSimdFlags();
+
+  uint32_t seed = 100;
+  int32_t  loops = 2000;
+  int64_t *pList = static_cast<int64_t *>(taosMemoryCalloc(numOfRows, sizeof(int64_t)));
+  int32_t *pInt = static_cast<int32_t *>(taosMemoryCalloc(numOfRows, sizeof(int32_t)));
+  double  *pDouble = static_cast<double *>(taosMemoryCalloc(numOfRows, sizeof(double)));
+  float   *pFloat = static_cast<float *>(taosMemoryCalloc(numOfRows, sizeof(float)));
+
+  genInt64(pList, numOfRows, 1, &seed);
+  for (int32_t i = 0; i < numOfRows; ++i) {
+    pInt[i] = taosRandR(&seed) % 1000;
+    pDouble[i] = 20.0 + (taosRandR(&seed) % 1000) / 100.0;
+    pFloat[i] = (float)pDouble[i];
+  }
+
+  struct {
+    const char *name;
+    compressFp  fp;
+    void       *pIn;
+    int32_t     bytes;
+  } cases[] = {
+      {"timestamp", tsCompressTimestamp, pList, numOfRows * (int32_t)sizeof(int64_t)},
+      {"bigint", tsCompressBigint, pList, numOfRows * (int32_t)sizeof(int64_t)},
+      {"int", tsCompressInt, pInt, numOfRows * (int32_t)sizeof(int32_t)},
+      {"double", tsCompressDouble, pDouble, numOfRows * (int32_t)sizeof(double)},
+      {"float", tsCompressFloat, pFloat, numOfRows * (int32_t)sizeof(float)},
+  };
+
+  char simd = tsSIMDEnable;
+  for (int32_t i = 0; i < sizeof(cases) / sizeof(cases[0]); ++i) {
+    tsSIMDEnable = 0;
+    double soft = perfMBps(cases[i].fp, cases[i].pIn, cases[i].bytes, numOfRows, loops);
+    tsSIMDEnable = 1;
+    double hard = perfMBps(cases[i].fp, cases[i].pIn, cases[i].bytes, numOfRows, loops);
+    std::cout << cases[i].name << " soft compress:" << soft << " MB/s, SIMD compress:" << hard << " MB/s"
+              << std::endl;
+  }
+  tsSIMDEnable = simd;
+
+  taosMemoryFree(pList);
+  taosMemoryFree(pInt);
+  taosMemoryFree(pDouble);
+  taosMemoryFree(pFloat);
+}
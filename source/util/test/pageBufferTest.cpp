@@ -13,7 +13,7 @@ namespace {
 // simple test
 void simpleTest() {
   SDiskbasedBuf* pBuf = NULL;
-  int32_t        ret = createDiskbasedBuf(&pBuf, 1024, 4096, "", TD_TMP_DIR_PATH);
+  int32_t        ret = createDiskbasedBuf(&pBuf, 1024, 4096, "", TD_TMP_DIR_PATH, DBUF_COMPRESS_NONE);
 
   int32_t pageId = 0;
   int32_t groupId = 0;
@@ -57,7 +57,7 @@ void simpleTest() {
 
 void writeDownTest() {
   SDiskbasedBuf* pBuf = NULL;
-  int32_t        ret = createDiskbasedBuf(&pBuf, 1024, 4 * 1024, "1", TD_TMP_DIR_PATH);
+  int32_t        ret = createDiskbasedBuf(&pBuf, 1024, 4 * 1024, "1", TD_TMP_DIR_PATH, DBUF_COMPRESS_NONE);
 
   int32_t pageId = 0;
   int32_t writePageId = 0;
@@ -106,7 +106,7 @@ void writeDownTest() {
 
 void recyclePageTest() {
   SDiskbasedBuf* pBuf = NULL;
-  int32_t        ret = createDiskbasedBuf(&pBuf, 1024, 4 * 1024, "1", TD_TMP_DIR_PATH);
+  int32_t        ret = createDiskbasedBuf(&pBuf, 1024, 4 * 1024, "1", TD_TMP_DIR_PATH, DBUF_COMPRESS_NONE);
 
   int32_t pageId = 0;
   int32_t writePageId = 0;
@@ -182,10 +182,10 @@ bool checkBufVarData(SFilePage* pPg, const char* varData, uint32_t varLen) {
 //                                           ^
 //                                           |
 //                                       SFilePage: flush to disk from here
-void testFlushAndReadBackBuffer() {
+void testFlushAndReadBackBuffer(EDBufCompressAlg compAlg = DBUF_COMPRESS_NONE) {
   SDiskbasedBuf* pBuf = NULL;
   uint32_t       totalLen = 4096;
-  auto           code = createDiskbasedBuf(&pBuf, totalLen, totalLen * 2, "1", TD_TMP_DIR_PATH);
+  auto           code = createDiskbasedBuf(&pBuf, totalLen, totalLen * 2, "1", TD_TMP_DIR_PATH, compAlg);
   int32_t        pageId = -1;
   auto*          pPg = (SFilePage*)getNewBufPage(pBuf, &pageId);
   ASSERT_TRUE(pPg != nullptr);
@@ -216,6 +216,15 @@ void testFlushAndReadBackBuffer() {
   // reload it from disk
   pPg = (SFilePage*)getBufPage(pBuf, pageId);
   ASSERT_TRUE(checkBufVarData(pPg, rowData + 3, len));
+
+  SDiskbasedBufStatis st = getDBufStatis(pBuf);
+  if (compAlg == DBUF_COMPRESS_NONE) {
+    ASSERT_EQ(st.compPages, 0);
+    ASSERT_EQ(st.flushBytes, st.rawFlushBytes);
+  } else {
+    ASSERT_GT(st.compPages, 0);
+    ASSERT_LT(st.flushBytes, st.rawFlushBytes);
+  }
   destroyDiskbasedBuf(pBuf);
   taosMemoryFree(rowData);
 }
@@ -230,4 +239,9 @@ TEST(testCase, resultBufferTest) {
   testFlushAndReadBackBuffer();
 }
 
+TEST(testCase, compressedBufferTest) {
+  testFlushAndReadBackBuffer(DBUF_COMPRESS_LZ4);
+  testFlushAndReadBackBuffer(DBUF_COMPRESS_ZSTD);
+}
+
 #pragma GCC diagnostic pop
@@ -3,6 +3,7 @@ from util.log import *
 from util.cases import *
 from util.sql import *
 import numpy as np
+import re
 
 
 class TDTestCase:
@@ -138,6 +139,67 @@ class TDTestCase:
         tdSql.checkData(0, 7, 1)
         tdSql.checkData(0, 8, 10000)
 
+        self.first_last_ts_from_sma(dbname)
+
+    def explain_sma_blocks(self, sql):
+        tdSql.query(f"explain analyze verbose true {sql}")
+        sma_blocks = 0
+        for row in tdSql.queryResult:
+            m = re.search(r"load_block_SMAs=([0-9.]+)", str(row[0]))
+            if m:
+                sma_blocks += float(m.group(1))
+        return sma_blocks
+
+    def first_last_ts_from_sma(self, dbname):
+        # first(ts)/last(ts) of the clean file blocks are answered by the block SMA
+        tdSql.execute(f"create table {dbname}.ntb_ts(ts timestamp, c1 int)")
+        for i in range(0, self.rowNum, 500):
+            values = " ".join(
+                "(%d, %s)" % (self.ts + j, "null" if j % 3 == 0 else str(j)) for j in range(i, i + 500))
+            tdSql.execute(f"insert into {dbname}.ntb_ts values {values}")
+        tdSql.execute(f"flush database {dbname}")
+
+        sql = f"select first(ts), last(ts) from {dbname}.ntb_ts"
+        tdSql.query(sql)
+        tdSql.checkData(0, 0, self.ts)
+        tdSql.checkData(0, 1, self.ts + self.rowNum - 1)
+        if self.explain_sma_blocks(sql) <= 0:
+            tdLog.exit("first(ts)/last(ts) of clean blocks not answered by block SMA")
+
+        # the windows covering part of a block fall back to decoding the block
+        tdSql.query(f"select first(ts), last(ts), count(*) from {dbname}.ntb_ts interval(3s)")
+        tdSql.checkRows(4)
+        tdSql.checkData(0, 0, self.ts)
+        tdSql.checkData(0, 1, self.ts + 2999)
+        tdSql.checkData(0, 2, 3000)
+        tdSql.checkData(3, 0, self.ts + 9000)
+        tdSql.checkData(3, 1, self.ts + self.rowNum - 1)
+        tdSql.checkData(3, 2, 1000)
+
+        # first/last of the other columns skip the null values, which the block SMA cannot tell
+        tdSql.query(f"select first(c1), last(c1) from {dbname}.ntb_ts")
+        tdSql.checkData(0, 0, 1)
+        tdSql.checkData(0, 1, self.rowNum - 2)
+
+        # the rows in memory overlap with the file blocks, which are merged row by row
+        tdSql.execute(f"insert into {dbname}.ntb_ts values({self.ts - 10}, null)({self.ts + 5000}, 1)({self.ts + 20000}, null)")
+        tdSql.query(sql)
+        tdSql.checkData(0, 0, self.ts - 10)
+        tdSql.checkData(0, 1, self.ts + 20000)
+        tdSql.query(f"select first(c1), last(c1), count(*) from {dbname}.ntb_ts")
+        tdSql.checkData(0, 0, 1)
+        tdSql.checkData(0, 1, self.rowNum - 2)
+        tdSql.checkData(0, 2, self.rowNum + 2)
+
+        # the overlapping rows are in the stt/data files after flush
+        tdSql.execute(f"flush database {dbname}")
+        tdSql.query(sql)
+        tdSql.checkData(0, 0, self.ts - 10)
+        tdSql.checkData(0, 1, self.ts + 20000)
+        tdSql.query(f"select first(ts), last(ts) from {dbname}.ntb_ts where ts >= {self.ts + 1} and ts <= {self.ts + 8000}")
+        tdSql.checkData(0, 0, self.ts + 1)
+        tdSql.checkData(0, 1, self.ts + 8000)
+
     def stop(self):
         tdSql.close()
         tdLog.success("%s successfully executed" % __file__)
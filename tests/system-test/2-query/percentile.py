@@ -173,10 +173,46 @@ class TDTestCase:
         tdSql.error(f'select percentile(1, col1) from {self.stbname}_0')
         tdSql.error(f'select percentile(col1, 10, 20, 30, 40, 50, 60, 70, 80, 90, 100, 101) from {self.stbname}_0')
 
+        tdSql.execute(f'drop database {self.dbname}')
+    def function_check_stb(self):
+        tdSql.execute(f'create database {self.dbname}')
+        tdSql.execute(self.setsql.set_create_stable_sql(self.stbname,self.column_dict,self.tag_dict))
+        for i in range(self.tbnum):
+            tdSql.execute(f"create table {self.stbname}_{i} using {self.stbname} tags({self.tag_values[0]})")
+            intData,floatData = self.insert_data(self.column_dict,f'{self.stbname}_{i}',self.rowNum)
+        allIntData = intData * self.tbnum
+        allFloatData = floatData * self.tbnum
+        for param in self.param:
+            tdSql.query(f'select percentile(col3, {param}) from {self.stbname}')
+            tdSql.checkRows(1)
+            tdSql.checkData(0, 0, np.percentile(allIntData, param))
+            tdSql.query(f'select percentile(col10, {param}) from {self.stbname}')
+            tdSql.checkData(0, 0, np.percentile(allFloatData, param))
+
+            # every partition has the values of one child table
+            tdSql.query(f'select percentile(col3, {param}) from {self.stbname} partition by tbname')
+            tdSql.checkRows(self.tbnum)
+            for i in range(self.tbnum):
+                tdSql.checkData(i, 0, np.percentile(intData, param))
+
+            # the subquery no longer has to be a single table scan
+            tdSql.query(f'select percentile(col3, {param}) from (select col3 from {self.stbname})')
+            tdSql.checkRows(1)
+            tdSql.checkData(0, 0, np.percentile(allIntData, param))
+
+        tdSql.query(f'select percentile(col1, 10, 50, 90) from {self.stbname}')
+        tdSql.checkData(0, 0, f'[{np.percentile(allIntData, 10):.6f}, {np.percentile(allIntData, 50):.6f}, {np.percentile(allIntData, 90):.6f}]')
+
+        tdSql.query(f'select _wstart, percentile(col3, 50) from {self.stbname} partition by tbname interval(1d)')
+        tdSql.checkRows(self.tbnum)
+        for i in range(self.tbnum):
+            tdSql.checkData(i, 1, np.percentile(intData, 50))
+
         tdSql.execute(f'drop database {self.dbname}')
     def run(self):
         self.function_check_ntb()
         self.function_check_ctb()
+        self.function_check_stb()
 
     def stop(self):
         tdSql.close()